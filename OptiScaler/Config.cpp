@@ -2,6 +2,9 @@
 #include "Config.h"
 #include "Util.h"
 #include "nvapi/fakenvapi.h"
+#include "misc/GameProfile.h"
+#include "misc/IniWatcher.h"
+#include "misc/StartupProfiler.h"
 
 static inline int64_t GetTicks()
 {
@@ -13,19 +16,300 @@ static inline int64_t GetTicks()
     return ticks.QuadPart;
 }
 
-static inline bool isInteger(const std::string& str, int& value) {
-    std::istringstream iss(str);
-    return (iss >> value) && iss.eof();
+// Bool & number settings, their loading, saving, validation and reset are generated from configSettings
+// Settings which need custom parsing are still handled in Reload & SaveIni
+struct ConfigSetting
+{
+    const char* Section;
+    const char* Key;
+    IniChangeKind Kind;
+    double Min;
+    double Max;
+    void (*Load)(Config*, const ConfigSetting&, const char*);
+    std::string (*Save)(Config*);
+    void (*Reset)(Config*);
+
+    constexpr bool HasRange() const { return Min <= Max; }
+};
+
+template <auto Field>
+static void LoadSetting(Config* InConfig, const ConfigSetting& InSetting, const char* InValue)
+{
+    auto& field = InConfig->*Field;
+    using T = typename std::remove_reference_t<decltype(field)>::value_type;
+
+    // set_from_config doesn't change a set value, no need to parse
+    if (field.has_value())
+        return;
+
+    auto value = IniDiff::ParseValue<T>(InValue);
+
+    if (!value.has_value())
+    {
+        if (InValue != nullptr && InValue[0] != '\0' && _stricmp(InValue, "auto") != 0)
+            LOG_WARN("[{0}] {1}: invalid value '{2}', using default", InSetting.Section, InSetting.Key, InValue);
+
+        return;
+    }
+
+    if constexpr (!std::is_same_v<T, bool>)
+    {
+        if (InSetting.HasRange())
+        {
+            auto clamped = std::clamp(value.value(), (T)InSetting.Min, (T)InSetting.Max);
+
+            if (clamped != value.value())
+                LOG_WARN("[{0}] {1}: {2} is out of range, using {3}", InSetting.Section, InSetting.Key, value.value(), clamped);
+
+            value = clamped;
+        }
+    }
+
+    field.set_from_config(value);
+}
+
+template <auto Field>
+static std::string SaveSetting(Config* InConfig)
+{
+    auto value = (InConfig->*Field).value_for_config();
+
+    if (!value.has_value())
+        return "auto";
+
+    if constexpr (std::is_same_v<std::remove_cvref_t<decltype(value.value())>, bool>)
+        return value.value() ? "true" : "false";
+    else
+        return std::to_string(value.value());
 }
 
-static inline bool isUInt(const std::string& str, uint32_t& value) {
-    std::istringstream iss(str);
-    return (iss >> value) && iss.eof();
+template <auto Field>
+static void ResetSetting(Config* InConfig)
+{
+    (InConfig->*Field).reset();
 }
 
-static inline bool isFloat(const std::string& str, float& value) {
-    std::istringstream iss(str);
-    return (iss >> value) && iss.eof();
+template <auto Field>
+static constexpr ConfigSetting MakeSetting(const char* InSection, const char* InKey, IniChangeKind InKind, double InMin = 1.0, double InMax = 0.0)
+{
+    return { InSection, InKey, InKind, InMin, InMax, LoadSetting<Field>, SaveSetting<Field>, ResetSetting<Field> };
+}
+
+#define SETTING(section, key, field, kind) MakeSetting<&Config::field>(section, key, IniChangeKind::kind)
+#define SETTING_RANGE(section, key, field, kind, min, max) MakeSetting<&Config::field>(section, key, IniChangeKind::kind, min, max)
+
+// Kind tells what is needed for a changed value to take effect while game is running
+static constexpr ConfigSetting configSettings[] =
+{
+    // Upscalers
+    SETTING("Upscalers", "AsyncBackendSwitch", AsyncBackendSwitch, Restart),
+    SETTING_RANGE("Upscalers", "ContextCacheSize", ContextCacheSize, Restart, 0, 8),
+    SETTING_RANGE("Upscalers", "ContextCacheBudget", ContextCacheBudget, Restart, 0, 8192),
+
+    // OptiFG
+    SETTING("OptiFG", "Enabled", FGEnabled, Restart),
+    SETTING("OptiFG", "DebugView", FGDebugView, Immediate),
+    SETTING("OptiFG", "AllowAsync", FGAsync, Restart),
+    SETTING("OptiFG", "HighPriority", FGHighPriority, Restart),
+    SETTING("OptiFG", "HUDFix", FGHUDFix, Immediate),
+    SETTING("OptiFG", "HUDLimit", FGHUDLimit, Immediate),
+    SETTING("OptiFG", "HUDFixExtended", FGHUDFixExtended, Immediate),
+    SETTING("OptiFG", "HUDFixImmadiate", FGImmediateCapture, Immediate),
+    SETTING("OptiFG", "RectLeft", FGRectLeft, Immediate),
+    SETTING("OptiFG", "RectTop", FGRectTop, Immediate),
+    SETTING("OptiFG", "RectWidth", FGRectWidth, Immediate),
+    SETTING("OptiFG", "RectHeight", FGRectHeight, Immediate),
+    SETTING("OptiFG", "DisableOverlays", FGDisableOverlays, Restart),
+    SETTING("OptiFG", "AlwaysTrackHeaps", FGAlwaysTrackHeaps, Immediate),
+    SETTING("OptiFG", "MakeDepthCopy", FGMakeDepthCopy, Restart),
+    SETTING("OptiFG", "MakeMVCopy", FGMakeMVCopy, Restart),
+    SETTING("OptiFG", "HudFixCloseAfterCallback", FGHudFixCloseAfterCallback, Immediate),
+    SETTING("OptiFG", "UseMutexForSwaphain", FGUseMutexForSwaphain, Restart),
+    SETTING("OptiFG", "EnableDepthScale", FGEnableDepthScale, Immediate),
+    SETTING("OptiFG", "DepthScaleMax", FGDepthScaleMax, Immediate),
+    SETTING("OptiFG", "DepthScaleAuto", FGDepthScaleAuto, Restart),
+    SETTING_RANGE("OptiFG", "DepthScaleAutoInterval", FGDepthScaleAutoInterval, Restart, 1, 600),
+    SETTING("OptiFG", "FramePacingTuning", FGFramePacingTuning, Immediate),
+    SETTING("OptiFG", "FPTSafetyMarginInMs", FGFPTSafetyMarginInMs, Immediate),
+    SETTING("OptiFG", "FPTVarianceFactor", FGFPTVarianceFactor, Immediate),
+    SETTING("OptiFG", "FPTHybridSpin", FGFPTAllowHybridSpin, Immediate),
+    SETTING("OptiFG", "FPTHybridSpinTime", FGFPTHybridSpinTime, Immediate),
+    SETTING("OptiFG", "FPTWaitForSingleObjectOnFence", FGFPTAllowWaitForSingleObjectOnFence, Immediate),
+
+    // Framerate
+    SETTING("Framerate", "FramerateLimit", FramerateLimit, Immediate),
+
+    // FSR
+    SETTING("FSR", "VerticalFov", FsrVerticalFov, Immediate),
+    SETTING("FSR", "HorizontalFov", FsrHorizontalFov, Immediate),
+    SETTING("FSR", "CameraNear", FsrCameraNear, Immediate),
+    SETTING("FSR", "CameraFar", FsrCameraFar, Immediate),
+    SETTING("FSR", "UseFsrInputValues", FsrUseFsrInputValues, Immediate),
+    SETTING("FSR", "VelocityFactor", FsrVelocity, Immediate),
+    SETTING("FSR", "DebugView", FsrDebugView, Immediate),
+    SETTING("FSR", "UpscalerIndex", Fsr3xIndex, RecreateFeature),
+    SETTING("FSR", "UseReactiveMaskForTransparency", FsrUseMaskForTransparency, Immediate),
+    SETTING("FSR", "DlssReactiveMaskBias", DlssReactiveMaskBias, Immediate),
+    SETTING("FSR", "Fsr4Update", Fsr4Update, Restart),
+    SETTING("FSR", "FsrNonLinearPQ", FsrNonLinearPQ, RecreateFeature),
+    SETTING("FSR", "FsrNonLinearSRGB", FsrNonLinearSRGB, RecreateFeature),
+    SETTING("FSR", "FsrAgilitySDKUpgrade", FsrAgilitySDKUpgrade, Restart),
+    SETTING("FSR", "VulkanPipelineCache", VulkanPipelineCache, Restart),
+
+    // XeSS
+    SETTING("XeSS", "BuildPipelines", BuildPipelines, Restart),
+    SETTING("XeSS", "PipelineCache", XeSSUsePipelineCache, Restart),
+    SETTING("XeSS", "NetworkModel", NetworkModel, RecreateFeature),
+    SETTING("XeSS", "CreateHeaps", CreateHeaps, Restart),
+
+    // DLSS
+    // Don't enable again if set false because of no nvngx found
+    SETTING("DLSS", "Enabled", DLSSEnabled, Restart),
+    SETTING("DLSS", "RenderPresetOverride", RenderPresetOverride, RecreateFeature),
+
+    // Nukems
+    SETTING("Nukems", "MakeDepthCopy", MakeDepthCopy, Restart),
+
+    // Log
+    SETTING("Log", "LogLevel", LogLevel, Restart),
+    SETTING("Log", "LogToConsole", LogToConsole, Restart),
+    SETTING("Log", "LogToFile", LogToFile, Restart),
+    SETTING("Log", "LogToNGX", LogToNGX, Restart),
+    SETTING("Log", "OpenConsole", OpenConsole, Restart),
+    SETTING("Log", "SingleFile", LogSingleFile, Restart),
+    SETTING("Log", "LogAsync", LogAsync, Restart),
+    SETTING("Log", "LogAsyncThreads", LogAsyncThreads, Restart),
+    SETTING("Log", "LogBinary", LogBinary, Restart),
+    SETTING_RANGE("Log", "TraceFrames", TraceFrames, Restart, 10, 3000),
+
+    // Sharpness
+    SETTING("Sharpness", "OverrideSharpness", OverrideSharpness, Immediate),
+    SETTING_RANGE("Sharpness", "Sharpness", Sharpness, Immediate, 0.0, 1.3),
+
+    // Menu
+    SETTING_RANGE("Menu", "Scale", MenuScale, Restart, 0.5, 2.0),
+    // Don't enable again if set false because of Linux issue
+    SETTING("Menu", "OverlayMenu", OverlayMenu, Restart),
+    SETTING("Menu", "ShortcutKey", ShortcutKey, Immediate),
+    SETTING("Menu", "ExtendedLimits", ExtendedLimits, Immediate),
+    SETTING("Menu", "ShowFps", ShowFps, Immediate),
+    SETTING("Menu", "UseHQFont", UseHQFont, Restart),
+    SETTING("Menu", "UseFontCache", UseFontCache, Restart),
+    SETTING("Menu", "IniHotReload", IniHotReload, Restart),
+    SETTING_RANGE("Menu", "FpsOverlayPos", FpsOverlayPos, Immediate, 0, 3),
+    SETTING_RANGE("Menu", "FpsOverlayType", FpsOverlayType, Immediate, 0, 4),
+    SETTING("Menu", "FpsOverlayHorizontal", FpsOverlayHorizontal, Immediate),
+    SETTING_RANGE("Menu", "FpsOverlayAlpha", FpsOverlayAlpha, Immediate, 0.0, 1.0),
+    SETTING_RANGE("Menu", "FpsOverlayRefreshRate", FpsOverlayRefreshRate, Immediate, 0, 60),
+
+    // Hooks
+    SETTING("Hooks", "HookOriginalNvngxOnly", HookOriginalNvngxOnly, Restart),
+
+    // CAS
+    SETTING("CAS", "Enabled", RcasEnabled, Immediate),
+    SETTING("CAS", "MotionSharpnessEnabled", MotionSharpnessEnabled, Immediate),
+    SETTING("CAS", "MotionSharpnessDebug", MotionSharpnessDebug, Immediate),
+    SETTING_RANGE("CAS", "MotionSharpness", MotionSharpness, Immediate, -1.3, 1.3),
+    SETTING_RANGE("CAS", "MotionThreshold", MotionThreshold, Immediate, 0.0, 100.0),
+    SETTING_RANGE("CAS", "MotionScaleLimit", MotionScaleLimit, Immediate, 0.01, 100.0),
+
+    // OutputScaling
+    SETTING("OutputScaling", "Enabled", OutputScalingEnabled, RecreateFeature),
+    SETTING("OutputScaling", "UseFsr", OutputScalingUseFsr, Immediate),
+    SETTING_RANGE("OutputScaling", "Multiplier", OutputScalingMultiplier, RecreateFeature, 0.5, 3.0),
+
+    // InitFlags
+    SETTING("InitFlags", "AutoExposure", AutoExposure, RecreateFeature),
+    SETTING("InitFlags", "HDR", HDR, RecreateFeature),
+    SETTING("InitFlags", "DepthInverted", DepthInverted, RecreateFeature),
+    SETTING("InitFlags", "JitterCancellation", JitterCancellation, RecreateFeature),
+    SETTING("InitFlags", "DisplayResolution", DisplayResolution, RecreateFeature),
+    SETTING("InitFlags", "DisableReactiveMask", DisableReactiveMask, RecreateFeature),
+
+    // DRS
+    SETTING("DRS", "DrsMinOverrideEnabled", DrsMinOverrideEnabled, Immediate),
+    SETTING("DRS", "DrsMaxOverrideEnabled", DrsMaxOverrideEnabled, Immediate),
+    SETTING("DRS", "GovernorEnabled", DrsGovernorEnabled, Immediate),
+    SETTING_RANGE("DRS", "TargetFrameTime", DrsTargetFrameTime, Immediate, 2.0, 100.0),
+
+    // UpscaleRatio
+    SETTING("UpscaleRatio", "UpscaleRatioOverrideEnabled", UpscaleRatioOverrideEnabled, RecreateFeature),
+    SETTING("UpscaleRatio", "UpscaleRatioOverrideValue", UpscaleRatioOverrideValue, RecreateFeature),
+
+    // QualityOverrides
+    SETTING("QualityOverrides", "QualityRatioOverrideEnabled", QualityRatioOverrideEnabled, RecreateFeature),
+    SETTING("QualityOverrides", "QualityRatioDLAA", QualityRatio_DLAA, RecreateFeature),
+    SETTING("QualityOverrides", "QualityRatioUltraQuality", QualityRatio_UltraQuality, RecreateFeature),
+    SETTING("QualityOverrides", "QualityRatioQuality", QualityRatio_Quality, RecreateFeature),
+    SETTING("QualityOverrides", "QualityRatioBalanced", QualityRatio_Balanced, RecreateFeature),
+    SETTING("QualityOverrides", "QualityRatioPerformance", QualityRatio_Performance, RecreateFeature),
+    SETTING("QualityOverrides", "QualityRatioUltraPerformance", QualityRatio_UltraPerformance, RecreateFeature),
+
+    // Hotfix
+    SETTING("Hotfix", "RoundInternalResolution", RoundInternalResolution, RecreateFeature),
+    SETTING("Hotfix", "MipmapBiasFixedOverride", MipmapBiasFixedOverride, Immediate),
+    SETTING("Hotfix", "MipmapBiasScaleOverride", MipmapBiasScaleOverride, Immediate),
+    SETTING("Hotfix", "MipmapBiasOverrideAll", MipmapBiasOverrideAll, Immediate),
+    SETTING("Hotfix", "MipmapBiasAuto", MipmapBiasAuto, Immediate),
+    SETTING_RANGE("Hotfix", "MipmapBiasAutoOffset", MipmapBiasAutoOffset, Immediate, -15.0, 15.0),
+    SETTING("Hotfix", "OverrideShaderSampler", OverrideShaderSampler, Restart),
+    SETTING("Hotfix", "RestoreComputeSignature", RestoreComputeSignature, Restart),
+    SETTING("Hotfix", "RestoreGraphicSignature", RestoreGraphicSignature, Restart),
+    SETTING("Hotfix", "PreferDedicatedGpu", PreferDedicatedGpu, Restart),
+    SETTING("Hotfix", "PreferFirstDedicatedGpu", PreferFirstDedicatedGpu, Restart),
+    SETTING("Hotfix", "SkipFirstFrames", SkipFirstFrames, Restart),
+    SETTING("Hotfix", "UsePrecompiledShaders", UsePrecompiledShaders, Restart),
+    SETTING("Hotfix", "UseGenericAppIdWithDlss", UseGenericAppIdWithDlss, Restart),
+    SETTING("Hotfix", "UseStartupCache", UseStartupCache, Restart),
+    SETTING("Hotfix", "ColorResourceBarrier", ColorResourceBarrier, Immediate),
+    SETTING("Hotfix", "MotionVectorResourceBarrier", MVResourceBarrier, Immediate),
+    SETTING("Hotfix", "DepthResourceBarrier", DepthResourceBarrier, Immediate),
+    SETTING("Hotfix", "ColorMaskResourceBarrier", MaskResourceBarrier, Immediate),
+    SETTING("Hotfix", "ExposureResourceBarrier", ExposureResourceBarrier, Immediate),
+    SETTING("Hotfix", "OutputResourceBarrier", OutputResourceBarrier, Immediate),
+
+    // Dx11withDx12
+    SETTING("Dx11withDx12", "TextureSyncMethod", TextureSyncMethod, Restart),
+    SETTING("Dx11withDx12", "CopyBackSyncMethod", CopyBackSyncMethod, Restart),
+    SETTING("Dx11withDx12", "UseDelayedInit", Dx11DelayedInit, Restart),
+    SETTING("Dx11withDx12", "SyncAfterDx12", SyncAfterDx12, Restart),
+
+    // NvApi
+    SETTING("NvApi", "OverrideNvapiDll", OverrideNvapiDll, Restart),
+
+    // Spoofing
+    SETTING("Spoofing", "Dxgi", DxgiSpoofing, Restart),
+    SETTING("Spoofing", "DxgiVRAM", DxgiVRAM, Restart),
+    SETTING("Spoofing", "Vulkan", VulkanSpoofing, Restart),
+    SETTING("Spoofing", "VulkanExtensionSpoofing", VulkanExtensionSpoofing, Restart),
+    SETTING("Spoofing", "VulkanVRAM", VulkanVRAM, Restart),
+    SETTING("Spoofing", "SpoofHAGS", SpoofHAGS, Restart),
+    SETTING("Spoofing", "D3DFeatureLevel", SpoofFeatureLevel, Restart),
+
+    // Inputs
+    SETTING("Inputs", "Dlss", DlssInputs, Restart),
+    SETTING("Inputs", "XeSS", XeSSInputs, Restart),
+    SETTING("Inputs", "Fsr2", Fsr2Inputs, Restart),
+    SETTING("Inputs", "Fsr2Pattern", Fsr2Pattern, Restart),
+    SETTING("Inputs", "Fsr3", Fsr3Inputs, Restart),
+    SETTING("Inputs", "Fsr3Pattern", Fsr3Pattern, Restart),
+    SETTING("Inputs", "Ffx", FfxInputs, Restart),
+
+    // Plugins
+    SETTING("Plugins", "LoadSpecialK", LoadSpecialK, Restart),
+};
+
+#undef SETTING
+#undef SETTING_RANGE
+
+static const ConfigSetting* FindSetting(const std::string& InSection, const std::string& InKey)
+{
+    for (auto& setting : configSettings)
+    {
+        if (lstrcmpiA(setting.Section, InSection.c_str()) == 0 && lstrcmpiA(setting.Key, InKey.c_str()) == 0)
+            return &setting;
+    }
+
+    return nullptr;
 }
 
 Config::Config()
@@ -36,6 +320,8 @@ Config::Config()
 
 bool Config::Reload(std::filesystem::path iniPath)
 {
+    STARTUP_ZONE(StartupPhase::ConfigLoad);
+
     auto pathWStr = iniPath.wstring();
 
     LOG_INFO("Trying to load ini from: {0}", wstring_to_string(pathWStr));
@@ -43,6 +329,13 @@ bool Config::Reload(std::filesystem::path iniPath)
     {
         State::Instance().nvngxIniDetected = exists(iniPath.parent_path() / "nvngx.ini");
 
+        // Game profile values replace global ones before anything is read
+        if (auto profile = GameProfile::Find(iniPath.parent_path()); profile.has_value())
+            GameProfile::Merge(profile.value(), &ini);
+
+        for (auto& setting : configSettings)
+            setting.Load(this, setting, ini.GetValue(setting.Section, setting.Key, "auto"));
+
         // Upscalers
         {
             Dx11Upscaler.set_from_config(readString("Upscalers", "Dx11Upscaler", true));
@@ -63,64 +356,8 @@ bool Config::Reload(std::filesystem::path iniPath)
             }
         }
 
-        // OptiFG
-        {
-            FGEnabled.set_from_config(readBool("OptiFG", "Enabled"));
-            FGDebugView.set_from_config(readBool("OptiFG", "DebugView"));
-            FGAsync.set_from_config(readBool("OptiFG", "AllowAsync"));
-            FGHighPriority.set_from_config(readBool("OptiFG", "HighPriority"));
-            FGHUDFix.set_from_config(readBool("OptiFG", "HUDFix"));
-            FGHUDLimit.set_from_config(readInt("OptiFG", "HUDLimit"));
-            FGHUDFixExtended.set_from_config(readBool("OptiFG", "HUDFixExtended"));
-            FGImmediateCapture.set_from_config(readBool("OptiFG", "HUDFixImmadiate"));
-            FGRectLeft.set_from_config(readInt("OptiFG", "RectLeft"));
-            FGRectTop.set_from_config(readInt("OptiFG", "RectTop"));
-            FGRectWidth.set_from_config(readInt("OptiFG", "RectWidth"));
-            FGRectHeight.set_from_config(readInt("OptiFG", "RectHeight"));
-            FGDisableOverlays.set_from_config(readBool("OptiFG", "DisableOverlays"));
-            FGAlwaysTrackHeaps.set_from_config(readBool("OptiFG", "AlwaysTrackHeaps"));
-            FGMakeDepthCopy.set_from_config(readBool("OptiFG", "MakeDepthCopy"));
-            FGMakeMVCopy.set_from_config(readBool("OptiFG", "MakeMVCopy"));
-            FGHudFixCloseAfterCallback.set_from_config(readBool("OptiFG", "HudFixCloseAfterCallback"));
-            FGUseMutexForSwaphain.set_from_config(readBool("OptiFG", "UseMutexForSwaphain"));
-            
-            FGEnableDepthScale.set_from_config(readBool("OptiFG", "EnableDepthScale"));
-            FGDepthScaleMax.set_from_config(readFloat("OptiFG", "DepthScaleMax"));
-
-            FGFramePacingTuning.set_from_config(readBool("OptiFG", "FramePacingTuning"));
-            FGFPTSafetyMarginInMs.set_from_config(readFloat("OptiFG", "FPTSafetyMarginInMs"));
-            FGFPTVarianceFactor.set_from_config(readFloat("OptiFG", "FPTVarianceFactor"));
-            FGFPTAllowHybridSpin.set_from_config(readBool("OptiFG", "FPTHybridSpin"));
-            FGFPTHybridSpinTime.set_from_config(readInt("OptiFG", "FPTHybridSpinTime"));
-            FGFPTAllowWaitForSingleObjectOnFence.set_from_config(readInt("OptiFG", "FPTWaitForSingleObjectOnFence"));
-        }
-
-        // Framerate
-        {
-            FramerateLimit.set_from_config(readFloat("Framerate", "FramerateLimit"));
-        }
-
-        // FSR Common
-        {
-            FsrVerticalFov.set_from_config(readFloat("FSR", "VerticalFov"));
-            FsrHorizontalFov.set_from_config(readFloat("FSR", "HorizontalFov"));
-            FsrCameraNear.set_from_config(readFloat("FSR", "CameraNear"));
-            FsrCameraFar.set_from_config(readFloat("FSR", "CameraFar"));
-            FsrUseFsrInputValues.set_from_config(readBool("FSR", "UseFsrInputValues"));
-        }
-
         // FSR
         {
-            FsrVelocity.set_from_config(readFloat("FSR", "VelocityFactor"));
-            FsrDebugView.set_from_config(readBool("FSR", "DebugView"));
-            Fsr3xIndex.set_from_config(readInt("FSR", "UpscalerIndex"));
-            FsrUseMaskForTransparency.set_from_config(readBool("FSR", "UseReactiveMaskForTransparency"));
-            DlssReactiveMaskBias.set_from_config(readFloat("FSR", "DlssReactiveMaskBias"));
-            Fsr4Update.set_from_config(readBool("FSR", "Fsr4Update"));
-            FsrNonLinearPQ.set_from_config(readBool("FSR", "FsrNonLinearPQ"));
-            FsrNonLinearSRGB.set_from_config(readBool("FSR", "FsrNonLinearSRGB"));
-            FsrAgilitySDKUpgrade.set_from_config(readBool("FSR", "FsrAgilitySDKUpgrade"));
-
             // Only sRGB or PQ should be enabled
             if (FsrNonLinearPQ.has_value() && FsrNonLinearPQ.value())
                 FsrNonLinearSRGB = false;
@@ -130,22 +367,15 @@ bool Config::Reload(std::filesystem::path iniPath)
 
         // XeSS
         {
-            BuildPipelines.set_from_config(readBool("XeSS", "BuildPipelines"));
-            NetworkModel.set_from_config(readInt("XeSS", "NetworkModel"));
-            CreateHeaps.set_from_config(readBool("XeSS", "CreateHeaps"));
             XeSSLibrary.set_from_config(readWString("XeSS", "LibraryPath"));
         }
 
         // DLSS
         {
-            // Don't enable again if set false because of no nvngx found
-            DLSSEnabled.set_from_config(readBool("DLSS", "Enabled"));
             NvngxPath.set_from_config(readWString("DLSS", "LibraryPath"));
             DLSSFeaturePath.set_from_config(readWString("DLSS", "FeaturePath"));
             NVNGX_DLSS_Library.set_from_config(readWString("DLSS", "NVNGX_DLSS_Path"));
 
-            RenderPresetOverride.set_from_config(readBool("DLSS", "RenderPresetOverride"));
-
             constexpr size_t presetCount = 17;
 
             if (auto setting = readInt("DLSS", "RenderPresetForAll"); setting.has_value() && setting >= 0 && (setting < presetCount || setting == 0x00FFFFFF))
@@ -170,22 +400,9 @@ bool Config::Reload(std::filesystem::path iniPath)
                 RenderPresetUltraPerformance.set_from_config(setting);
         }
 
-        // Nukems
-        {
-            MakeDepthCopy.set_from_config(readBool("Nukems", "MakeDepthCopy"));
-        }
-
         // Logging
         {
-            LogLevel.set_from_config(readInt("Log", "LogLevel"));
-            LogToConsole.set_from_config(readBool("Log", "LogToConsole"));
-            LogToFile.set_from_config(readBool("Log", "LogToFile"));
-            LogToNGX.set_from_config(readBool("Log", "LogToNGX"));
-            OpenConsole.set_from_config(readBool("Log", "OpenConsole"));
             DebugWait.set_from_config(readBool("Log", "DebugWait"));
-            LogSingleFile.set_from_config(readBool("Log", "SingleFile"));
-            LogAsync.set_from_config(readBool("Log", "LogAsync"));
-            LogAsyncThreads.set_from_config(readInt("Log", "LogAsyncThreads"));
 
             {
                 auto setting = readString("Log", "LogFile", false);
@@ -206,109 +423,19 @@ bool Config::Reload(std::filesystem::path iniPath)
             }
         }
 
-        // Sharpness
-        {
-            OverrideSharpness.set_from_config(readBool("Sharpness", "OverrideSharpness"));
-
-            if (auto setting = readFloat("Sharpness", "Sharpness"); setting.has_value())
-                Sharpness.set_from_config(std::clamp(setting.value(), 0.0f, 1.3f));
-        }
-
         // Menu
         {
-            if (auto setting = readFloat("Menu", "Scale"); setting.has_value())
-                MenuScale.set_from_config(std::clamp(setting.value(), 0.5f, 2.0f));
-
-            // Don't enable again if set false because of Linux issue
-            OverlayMenu.set_from_config(readBool("Menu", "OverlayMenu"));
-            ShortcutKey.set_from_config(readInt("Menu", "ShortcutKey"));
-            ExtendedLimits.set_from_config(readBool("Menu", "ExtendedLimits"));
-            ShowFps.set_from_config(readBool("Menu", "ShowFps"));
-            UseHQFont.set_from_config(readBool("Menu", "UseHQFont"));
-
-            if (auto setting = readInt("Menu", "FpsOverlayPos"); setting.has_value())
-                FpsOverlayPos.set_from_config(std::clamp(setting.value(), 0, 3));
-
-            if (auto setting = readInt("Menu", "FpsOverlayType"); setting.has_value())
-                FpsOverlayType.set_from_config(std::clamp(setting.value(), 0, 4));
-
             FpsShortcutKey.set_from_config(readInt("Menu", "FpsShortcutKey"));
             FpsCycleShortcutKey.set_from_config(readInt("Menu", "FpsCycleShortcutKey"));
-            FpsOverlayHorizontal.set_from_config(readBool("Menu", "FpsOverlayHorizontal"));
-
-            if (auto setting = readFloat("Menu", "FpsOverlayAlpha"); setting.has_value())
-                FpsOverlayAlpha.set_from_config(std::clamp(setting.value(), 0.0f, 1.0f));
-        }
-
-        // Hooks
-        {
-            HookOriginalNvngxOnly.set_from_config(readBool("Hooks", "HookOriginalNvngxOnly"));
-        }
-
-        // RCAS
-        {
-            RcasEnabled.set_from_config(readBool("CAS", "Enabled"));
-            MotionSharpnessEnabled.set_from_config(readBool("CAS", "MotionSharpnessEnabled"));
-            MotionSharpnessDebug.set_from_config(readBool("CAS", "MotionSharpnessDebug"));
-
-            if (auto setting = readFloat("CAS", "MotionSharpness"); setting.has_value())
-                MotionSharpness.set_from_config(std::clamp(setting.value(), -1.3f, 1.3f));
-
-            if (auto setting = readFloat("CAS", "MotionThreshold"); setting.has_value())
-                MotionThreshold.set_from_config(std::clamp(setting.value(), 0.0f, 100.0f));
-
-            if (auto setting = readFloat("CAS", "MotionScaleLimit"); setting.has_value())
-                MotionScaleLimit.set_from_config(std::clamp(setting.value(), 0.01f, 100.0f));
         }
 
         // Output Scaling
         {
-            OutputScalingEnabled.set_from_config(readBool("OutputScaling", "Enabled"));
-            OutputScalingUseFsr.set_from_config(readBool("OutputScaling", "UseFsr"));
             OutputScalingDownscaler.set_from_config(readInt("OutputScaling", "Downscaler"));
-
-            if (auto setting = readFloat("OutputScaling", "Multiplier"); setting.has_value())
-                OutputScalingMultiplier.set_from_config(std::clamp(setting.value(), 0.5f, 3.0f));
-        }
-
-        // Init Flags
-        {
-            AutoExposure.set_from_config(readBool("InitFlags", "AutoExposure"));
-            HDR.set_from_config(readBool("InitFlags", "HDR"));
-            DepthInverted.set_from_config(readBool("InitFlags", "DepthInverted"));
-            JitterCancellation.set_from_config(readBool("InitFlags", "JitterCancellation"));
-            DisplayResolution.set_from_config(readBool("InitFlags", "DisplayResolution"));
-            DisableReactiveMask.set_from_config(readBool("InitFlags", "DisableReactiveMask"));
-        }
-
-
-        // DRS
-        {
-            DrsMinOverrideEnabled.set_from_config(readBool("DRS", "DrsMinOverrideEnabled"));
-            DrsMaxOverrideEnabled.set_from_config(readBool("DRS", "DrsMaxOverrideEnabled"));
-        }
-
-        //Upscale Ratio Override
-        {
-            UpscaleRatioOverrideEnabled.set_from_config(readBool("UpscaleRatio", "UpscaleRatioOverrideEnabled"));
-            UpscaleRatioOverrideValue.set_from_config(readFloat("UpscaleRatio", "UpscaleRatioOverrideValue"));
-        }
-
-        // Quality Overrides
-        {
-            QualityRatioOverrideEnabled.set_from_config(readBool("QualityOverrides", "QualityRatioOverrideEnabled"));
-            QualityRatio_DLAA.set_from_config(readFloat("QualityOverrides", "QualityRatioDLAA"));
-            QualityRatio_UltraQuality.set_from_config(readFloat("QualityOverrides", "QualityRatioUltraQuality"));
-            QualityRatio_Quality.set_from_config(readFloat("QualityOverrides", "QualityRatioQuality"));
-            QualityRatio_Balanced.set_from_config(readFloat("QualityOverrides", "QualityRatioBalanced"));
-            QualityRatio_Performance.set_from_config(readFloat("QualityOverrides", "QualityRatioPerformance"));
-            QualityRatio_UltraPerformance.set_from_config(readFloat("QualityOverrides", "QualityRatioUltraPerformance"));
         }
 
         // Hotfixes
         {
-            RoundInternalResolution.set_from_config(readInt("Hotfix", "RoundInternalResolution"));
-
             if (auto setting = readFloat("Hotfix", "MipmapBiasOverride"); setting.has_value() && setting.value() <= 15.0 && setting.value() >= -15.0)
                 MipmapBiasOverride.set_from_config(setting);
 
@@ -317,69 +444,22 @@ bool Config::Reload(std::filesystem::path iniPath)
             if (MipmapBiasOverride.has_value() && (MipmapBiasOverride.value() > 15.0 || MipmapBiasOverride.value() < -15.0))
                 MipmapBiasOverride.reset();
 
-            MipmapBiasFixedOverride.set_from_config(readBool("Hotfix", "MipmapBiasFixedOverride"));
-            MipmapBiasScaleOverride.set_from_config(readBool("Hotfix", "MipmapBiasScaleOverride"));
-            MipmapBiasOverrideAll.set_from_config(readBool("Hotfix", "MipmapBiasOverrideAll"));
-            
             if (auto setting = readInt("Hotfix", "AnisotropyOverride"); setting.has_value() && setting.value() <= 16 && setting.value() >= 1)
                 AnisotropyOverride.set_from_config(setting);
 
             if (AnisotropyOverride.has_value() && (AnisotropyOverride.value() > 16 || AnisotropyOverride.value() < 1))
                 AnisotropyOverride.reset();
-
-            OverrideShaderSampler.set_from_config(readBool("Hotfix", "OverrideShaderSampler"));
-
-            RestoreComputeSignature.set_from_config(readBool("Hotfix", "RestoreComputeSignature"));
-            RestoreGraphicSignature.set_from_config(readBool("Hotfix", "RestoreGraphicSignature"));
-            PreferDedicatedGpu.set_from_config(readBool("Hotfix", "PreferDedicatedGpu"));
-            PreferFirstDedicatedGpu.set_from_config(readBool("Hotfix", "PreferFirstDedicatedGpu"));
-            SkipFirstFrames.set_from_config(readInt("Hotfix", "SkipFirstFrames"));
-            UsePrecompiledShaders.set_from_config(readBool("Hotfix", "UsePrecompiledShaders"));
-            UseGenericAppIdWithDlss.set_from_config(readBool("Hotfix", "UseGenericAppIdWithDlss"));
-            ColorResourceBarrier.set_from_config(readInt("Hotfix", "ColorResourceBarrier"));
-            MVResourceBarrier.set_from_config(readInt("Hotfix", "MotionVectorResourceBarrier"));
-            DepthResourceBarrier.set_from_config(readInt("Hotfix", "DepthResourceBarrier"));
-            MaskResourceBarrier.set_from_config(readInt("Hotfix", "ColorMaskResourceBarrier"));
-            ExposureResourceBarrier.set_from_config(readInt("Hotfix", "ExposureResourceBarrier"));
-            OutputResourceBarrier.set_from_config(readInt("Hotfix", "OutputResourceBarrier"));
-        }
-
-        // Dx11 with Dx12
-        {
-            TextureSyncMethod.set_from_config(readInt("Dx11withDx12", "TextureSyncMethod"));
-            CopyBackSyncMethod.set_from_config(readInt("Dx11withDx12", "CopyBackSyncMethod"));
-            Dx11DelayedInit.set_from_config(readInt("Dx11withDx12", "UseDelayedInit"));
-            SyncAfterDx12.set_from_config(readInt("Dx11withDx12", "SyncAfterDx12"));
         }
 
         // NvApi
         {
-            OverrideNvapiDll.set_from_config(readBool("NvApi", "OverrideNvapiDll"));
             NvapiDllPath.set_from_config(readWString("NvApi", "NvapiDllPath", true));
         }
 
         // Spoofing
         {
-            DxgiSpoofing.set_from_config(readBool("Spoofing", "Dxgi"));
             DxgiBlacklist.set_from_config(readString("Spoofing", "DxgiBlacklist"));
-            DxgiVRAM.set_from_config(readInt("Spoofing", "DxgiVRAM"));
-            VulkanSpoofing.set_from_config(readBool("Spoofing", "Vulkan"));
-            VulkanExtensionSpoofing.set_from_config(readBool("Spoofing", "VulkanExtensionSpoofing"));
-            VulkanVRAM.set_from_config(readInt("Spoofing", "VulkanVRAM"));
             SpoofedGPUName.set_from_config(readWString("Spoofing", "SpoofedGPUName"));
-            SpoofHAGS.set_from_config(readBool("Spoofing", "SpoofHAGS"));
-            SpoofFeatureLevel.set_from_config(readBool("Spoofing", "D3DFeatureLevel"));
-        }
-
-        // Inputs
-        {
-            DlssInputs.set_from_config(readBool("Inputs", "Dlss"));
-            XeSSInputs.set_from_config(readBool("Inputs", "XeSS"));
-            Fsr2Inputs.set_from_config(readBool("Inputs", "Fsr2"));
-            Fsr2Pattern.set_from_config(readBool("Inputs", "Fsr2Pattern"));
-            Fsr3Inputs.set_from_config(readBool("Inputs", "Fsr3"));
-            Fsr3Pattern.set_from_config(readBool("Inputs", "Fsr3Pattern"));
-            FfxInputs.set_from_config(readBool("Inputs", "Ffx"));
         }
 
         // Plugins
@@ -394,14 +474,12 @@ bool Config::Reload(std::filesystem::path iniPath)
                     PluginPath.set_from_config((Util::DllPath().parent_path() / path).wstring());
             }
 
-            LoadSpecialK.set_from_config(readBool("Plugins", "LoadSpecialK"));
             LoadReShade.set_from_config(readBool("Plugins", "LoadReShade"));
         }
 
         // DLSS Enabler
         {
             std::optional<std::string> buffer;
-            int value = 0;
 
             if (!DE_Generator.has_value())
                 DE_Generator = readString("FrameGeneration", "Generator", true);
@@ -419,9 +497,9 @@ bool Config::Reload(std::filesystem::path iniPath)
                         DE_FramerateLimit = 0;
                         DE_FramerateLimitVsync = true;
                     }
-                    else if (isInteger(buffer.value(), value))
+                    else if (auto limit = IniDiff::ParseValue<int>(buffer.value().c_str()); limit.has_value())
                     {
-                        DE_FramerateLimit = value;
+                        DE_FramerateLimit = limit.value();
                         DE_FramerateLimitVsync = false;
                     }
                     else
@@ -462,15 +540,187 @@ bool Config::Reload(std::filesystem::path iniPath)
                 UseHDR10.set_from_config(readBool("HDR", "UseHDR10"));
         }
 
+        PublishSnapshot();
+
         if (fakenvapi::isUsingFakenvapi())
             return ReloadFakenvapi();
 
         return true;
     }
 
+    PublishSnapshot();
+
     return false;
 }
 
+void Config::PublishSnapshot()
+{
+    ConfigSnapshot snapshot{};
+
+    snapshot.FGEnabled = FGEnabled.value_or_default();
+    snapshot.FGHUDFix = FGHUDFix.value_or_default();
+    snapshot.FGHUDFixExtended = FGHUDFixExtended.value_or_default();
+    snapshot.FGImmediateCapture = FGImmediateCapture.value_or_default();
+    snapshot.FGAlwaysTrackHeaps = FGAlwaysTrackHeaps.value_or_default();
+    snapshot.FGHUDLimit = FGHUDLimit.value_or_default();
+
+    snapshot.ForceHDR = ForceHDR.value_or_default();
+    snapshot.UseHDR10 = UseHDR10.value_or_default();
+
+    snapshot.HasAnisotropyOverride = AnisotropyOverride.has_value();
+    snapshot.AnisotropyOverride = AnisotropyOverride.value_or(0);
+    snapshot.HasMipmapBiasOverride = MipmapBiasOverride.has_value();
+    snapshot.MipmapBiasOverride = MipmapBiasOverride.value_or(0.0f);
+    snapshot.MipmapBiasFixedOverride = MipmapBiasFixedOverride.value_or_default();
+    snapshot.MipmapBiasScaleOverride = MipmapBiasScaleOverride.value_or_default();
+    snapshot.MipmapBiasOverrideAll = MipmapBiasOverrideAll.value_or_default();
+    snapshot.MipmapBiasAuto = MipmapBiasAuto.value_or_default();
+    snapshot.MipmapBiasAutoOffset = MipmapBiasAutoOffset.value_or_default();
+
+    snapshot.DxgiSpoofing = DxgiSpoofing.value_or_default();
+    snapshot.HasDxgiVRAM = DxgiVRAM.has_value();
+    snapshot.DxgiVRAM = DxgiVRAM.value_or(0);
+    snapshot.SpoofedGPUName = SpoofedGPUName.value_or_default();
+
+    std::scoped_lock lock(_snapshotMutex);
+
+    auto current = _snapshot.load(std::memory_order_relaxed);
+
+    if (current != nullptr && *current == snapshot)
+        return;
+
+    auto now = Util::MillisecondsNow();
+
+    // Readers which loaded an old snapshot are long done with it
+    std::erase_if(_retiredSnapshots, [now](const RetiredSnapshot& retired)
+                  {
+                      if (now - retired.RetiredMs < SnapshotGracePeriodMs)
+                          return false;
+
+                      delete retired.Snapshot;
+                      return true;
+                  });
+
+    if (current != nullptr)
+        _retiredSnapshots.push_back({ current, now });
+
+    _snapshot.store(new ConfigSnapshot(snapshot), std::memory_order_release);
+    _snapshotVersion.fetch_add(1, std::memory_order_release);
+
+    LOG_DEBUG("Published new config snapshot, retired: {0}", _retiredSnapshots.size());
+}
+
+// Hand parsed keys which are read while game is running, live settings of configSettings are tagged there
+struct LiveIniKey
+{
+    const char* Section;
+    const char* Key;
+    IniChangeKind Kind;
+    void (*Reset)(Config*);
+};
+
+#define LIVE_KEY(section, key, kind, field) { section, key, IniChangeKind::kind, [](Config* c) { c->field.reset(); } }
+
+static const LiveIniKey liveIniKeys[] =
+{
+    // Upscalers
+    LIVE_KEY("Upscalers", "Dx11Upscaler", RecreateFeature, Dx11Upscaler),
+    LIVE_KEY("Upscalers", "Dx12Upscaler", RecreateFeature, Dx12Upscaler),
+    LIVE_KEY("Upscalers", "VulkanUpscaler", RecreateFeature, VulkanUpscaler),
+
+    // DLSS
+    LIVE_KEY("DLSS", "RenderPresetForAll", RecreateFeature, RenderPresetForAll),
+    LIVE_KEY("DLSS", "RenderPresetDLAA", RecreateFeature, RenderPresetDLAA),
+    LIVE_KEY("DLSS", "RenderPresetUltraQuality", RecreateFeature, RenderPresetUltraQuality),
+    LIVE_KEY("DLSS", "RenderPresetQuality", RecreateFeature, RenderPresetQuality),
+    LIVE_KEY("DLSS", "RenderPresetBalanced", RecreateFeature, RenderPresetBalanced),
+    LIVE_KEY("DLSS", "RenderPresetPerformance", RecreateFeature, RenderPresetPerformance),
+    LIVE_KEY("DLSS", "RenderPresetUltraPerformance", RecreateFeature, RenderPresetUltraPerformance),
+
+    // Output scaling
+    LIVE_KEY("OutputScaling", "Downscaler", Immediate, OutputScalingDownscaler),
+
+    // Menu
+    LIVE_KEY("Menu", "FpsShortcutKey", Immediate, FpsShortcutKey),
+    LIVE_KEY("Menu", "FpsCycleShortcutKey", Immediate, FpsCycleShortcutKey),
+
+    // Hotfix, sampler overrides only affect samplers created after the change
+    LIVE_KEY("Hotfix", "MipmapBiasOverride", Immediate, MipmapBiasOverride),
+    LIVE_KEY("Hotfix", "AnisotropyOverride", Immediate, AnisotropyOverride),
+};
+
+#undef LIVE_KEY
+
+static const LiveIniKey* FindLiveIniKey(const std::string& InSection, const std::string& InKey)
+{
+    for (auto& liveKey : liveIniKeys)
+    {
+        if (lstrcmpiA(liveKey.Section, InSection.c_str()) == 0 && lstrcmpiA(liveKey.Key, InKey.c_str()) == 0)
+            return &liveKey;
+    }
+
+    return nullptr;
+}
+
+IniChangeKind Config::IniChangeKindOf(const std::string& InSection, const std::string& InKey)
+{
+    if (auto setting = FindSetting(InSection, InKey); setting != nullptr)
+        return setting->Kind;
+
+    auto liveKey = FindLiveIniKey(InSection, InKey);
+    return liveKey != nullptr ? liveKey->Kind : IniChangeKind::Restart;
+}
+
+void Config::ApplyIniChanges(const std::vector<IniChange>& InChanges)
+{
+    bool reload = false;
+    bool recreate = false;
+
+    for (auto& change : InChanges)
+    {
+        LOG_INFO("[{0}] {1}: '{2}' -> '{3}', {4}", change.Section, change.Key, change.OldValue, change.NewValue, IniChangeKindName(change.Kind));
+
+        auto kind = IniChangeKind::Restart;
+
+        if (auto setting = FindSetting(change.Section, change.Key); setting != nullptr && setting->Kind != IniChangeKind::Restart)
+        {
+            setting->Reset(this);
+            kind = setting->Kind;
+        }
+        else if (auto liveKey = FindLiveIniKey(change.Section, change.Key); liveKey != nullptr)
+        {
+            liveKey->Reset(this);
+            kind = liveKey->Kind;
+        }
+
+        if (kind == IniChangeKind::Restart)
+            continue;
+
+        reload = true;
+        recreate |= kind == IniChangeKind::RecreateFeature;
+    }
+
+    if (!reload)
+        return;
+
+    // Only values which were reset are read again
+    Reload(absoluteFileName);
+
+    if (recreate && State::Instance().currentFeature != nullptr)
+    {
+        LOG_INFO("Recreating {0} for changed settings", State::Instance().currentFeature->Name());
+
+        // Empty backend recreates the configured upscaler
+        if (State::Instance().currentFeature->Name() == "DLSSD")
+            State::Instance().newBackend = "dlssd";
+        else
+            State::Instance().newBackend = "";
+
+        for (auto& singleChangeBackend : State::Instance().changeBackend)
+            singleChangeBackend.second = true;
+    }
+}
+
 bool Config::LoadFromPath(const wchar_t* InPath)
 {
     std::filesystem::path iniPath(InPath);
@@ -531,6 +781,9 @@ bool Config::SaveIni()
             ini.SetValue("FrameGeneration", "FrameGenerationMode", "auto");
     }
 
+    for (auto& setting : configSettings)
+        ini.SetValue(setting.Section, setting.Key, setting.Save(this).c_str());
+
     // Upscalers 
     {
         ini.SetValue("Upscalers", "Dx11Upscaler", Instance()->Dx11Upscaler.value_for_config_or("auto").c_str());
@@ -553,88 +806,21 @@ bool Config::SaveIni()
         ini.SetValue("FrameGen", "FGType", FGTypeString.c_str());
     }
 
-    // OptiFG 
-    {
-        ini.SetValue("OptiFG", "Enabled", GetBoolValue(Instance()->FGEnabled.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "DebugView", GetBoolValue(Instance()->FGDebugView.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "AllowAsync", GetBoolValue(Instance()->FGAsync.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "HighPriority", GetBoolValue(Instance()->FGHighPriority.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "HUDFix", GetBoolValue(Instance()->FGHUDFix.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "HUDLimit", GetIntValue(Instance()->FGHUDLimit.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "HUDFixExtended", GetBoolValue(Instance()->FGHUDFixExtended.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "HUDFixImmadiate", GetBoolValue(Instance()->FGImmediateCapture.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "RectLeft", GetIntValue(Instance()->FGRectLeft.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "RectTop", GetIntValue(Instance()->FGRectTop.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "RectWidth", GetIntValue(Instance()->FGRectWidth.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "RectHeight", GetIntValue(Instance()->FGRectHeight.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "DisableOverlays", GetBoolValue(Instance()->FGDisableOverlays.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "AlwaysTrackHeaps", GetBoolValue(Instance()->FGAlwaysTrackHeaps.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "MakeDepthCopy", GetBoolValue(Instance()->FGMakeDepthCopy.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "MakeMVCopy", GetBoolValue(Instance()->FGMakeMVCopy.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "HudFixCloseAfterCallback", GetBoolValue(Instance()->FGHudFixCloseAfterCallback.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "UseMutexForSwaphain", GetBoolValue(Instance()->FGUseMutexForSwaphain.value_for_config()).c_str());
-        
-        ini.SetValue("OptiFG", "EnableDepthScale", GetBoolValue(Instance()->FGEnableDepthScale.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "DepthScaleMax", GetFloatValue(Instance()->FGDepthScaleMax.value_for_config()).c_str());
-
-        ini.SetValue("OptiFG", "FramePacingTuning", GetBoolValue(Instance()->FGFramePacingTuning.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "FPTSafetyMarginInMs", GetFloatValue(Instance()->FGFPTSafetyMarginInMs.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "FPTVarianceFactor", GetFloatValue(Instance()->FGFPTVarianceFactor.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "FPTHybridSpin", GetBoolValue(Instance()->FGFPTAllowHybridSpin.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "FPTHybridSpinTime", GetIntValue(Instance()->FGFPTHybridSpinTime.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "FPTWaitForSingleObjectOnFence", GetBoolValue(Instance()->FGFPTAllowWaitForSingleObjectOnFence.value_for_config()).c_str());
-    }
-
-    // Framerate 
-    {
-        ini.SetValue("Framerate", "FramerateLimit", GetFloatValue(Instance()->FramerateLimit.value_for_config()).c_str());
-    }
-
     // Output Scaling
     {
-        ini.SetValue("OutputScaling", "Enabled", GetBoolValue(Instance()->OutputScalingEnabled.value_for_config()).c_str());
-        ini.SetValue("OutputScaling", "Multiplier", GetFloatValue(Instance()->OutputScalingMultiplier.value_for_config()).c_str());
-        ini.SetValue("OutputScaling", "UseFsr", GetBoolValue(Instance()->OutputScalingUseFsr.value_for_config()).c_str());
         ini.SetValue("OutputScaling", "Downscaler", GetBoolValue(Instance()->OutputScalingDownscaler).c_str());
     }
 
-    // FSR common
-    {
-        ini.SetValue("FSR", "VerticalFov", GetFloatValue(Instance()->FsrVerticalFov.value_for_config()).c_str());
-        ini.SetValue("FSR", "HorizontalFov", GetFloatValue(Instance()->FsrHorizontalFov.value_for_config()).c_str());
-        ini.SetValue("FSR", "CameraNear", GetFloatValue(Instance()->FsrCameraNear.value_for_config()).c_str());
-        ini.SetValue("FSR", "CameraFar", GetFloatValue(Instance()->FsrCameraFar.value_for_config()).c_str());
-        ini.SetValue("FSR", "UseFsrInputValues", GetBoolValue(Instance()->FsrUseFsrInputValues.value_for_config()).c_str());
-    }
-
-    // FSR 
-    {
-        ini.SetValue("FSR", "VelocityFactor", GetFloatValue(Instance()->FsrVelocity.value_for_config()).c_str());
-        ini.SetValue("FSR", "DebugView", GetBoolValue(Instance()->FsrDebugView.value_for_config()).c_str());
-        ini.SetValue("FSR", "UpscalerIndex", GetIntValue(Instance()->Fsr3xIndex.value_for_config()).c_str());
-        ini.SetValue("FSR", "UseReactiveMaskForTransparency", GetBoolValue(Instance()->FsrUseMaskForTransparency.value_for_config()).c_str());
-        ini.SetValue("FSR", "DlssReactiveMaskBias", GetFloatValue(Instance()->DlssReactiveMaskBias.value_for_config()).c_str());
-        ini.SetValue("FSR", "Fsr4Update", GetBoolValue(Instance()->Fsr4Update.value_for_config()).c_str());
-        ini.SetValue("FSR", "FsrNonLinearPQ", GetBoolValue(Instance()->FsrNonLinearPQ.value_for_config()).c_str());
-        ini.SetValue("FSR", "FsrNonLinearSRGB", GetBoolValue(Instance()->FsrNonLinearSRGB.value_for_config()).c_str());
-        ini.SetValue("FSR", "FsrAgilitySDKUpgrade", GetBoolValue(Instance()->FsrAgilitySDKUpgrade.value_for_config()).c_str());
-    }
-
     // XeSS
     {
-        ini.SetValue("XeSS", "BuildPipelines", GetBoolValue(Instance()->BuildPipelines.value_for_config()).c_str());
-        ini.SetValue("XeSS", "CreateHeaps", GetBoolValue(Instance()->CreateHeaps.value_for_config()).c_str());
-        ini.SetValue("XeSS", "NetworkModel", GetIntValue(Instance()->NetworkModel.value_for_config()).c_str());
         ini.SetValue("XeSS", "LibraryPath",  wstring_to_string(Instance()->XeSSLibrary.value_for_config_or(L"auto")).c_str());
     }
 
     // DLSS
     {
-        ini.SetValue("DLSS", "Enabled", GetBoolValue(Instance()->DLSSEnabled.value_for_config()).c_str());
         ini.SetValue("DLSS", "LibraryPath", wstring_to_string(Instance()->NvngxPath.value_for_config_or(L"auto")).c_str());
         ini.SetValue("DLSS", "FeaturePath", wstring_to_string(Instance()->DLSSFeaturePath.value_for_config_or(L"auto")).c_str());
         ini.SetValue("DLSS", "NVNGX_DLSS_Library", wstring_to_string(Instance()->NVNGX_DLSS_Library.value_for_config_or(L"auto")).c_str());
-        ini.SetValue("DLSS", "RenderPresetOverride", GetBoolValue(Instance()->RenderPresetOverride.value_for_config()).c_str());
         ini.SetValue("DLSS", "RenderPresetForAll", GetIntValue(Instance()->RenderPresetForAll.value_for_config()).c_str());
         ini.SetValue("DLSS", "RenderPresetDLAA", GetIntValue(Instance()->RenderPresetDLAA.value_for_config()).c_str());
         ini.SetValue("DLSS", "RenderPresetUltraQuality", GetIntValue(Instance()->RenderPresetUltraQuality.value_for_config()).c_str());
@@ -644,173 +830,60 @@ bool Config::SaveIni()
         ini.SetValue("DLSS", "RenderPresetUltraPerformance", GetIntValue(Instance()->RenderPresetUltraPerformance.value_for_config()).c_str());
     }
 
-    // Nukems
-    {
-        ini.SetValue("Nukems", "MakeDepthCopy", GetBoolValue(Instance()->MakeDepthCopy.value_for_config()).c_str());
-    }
-
-    // Sharpness
-    {
-        ini.SetValue("Sharpness", "OverrideSharpness", GetBoolValue(Instance()->OverrideSharpness.value_for_config()).c_str());
-        ini.SetValue("Sharpness", "Sharpness", GetFloatValue(Instance()->Sharpness.value_for_config()).c_str());
-    }
-
-    // Menu
-    {
-        ini.SetValue("Menu", "Scale", GetFloatValue(Instance()->MenuScale.value_for_config()).c_str());
-        ini.SetValue("Menu", "OverlayMenu", GetBoolValue(Instance()->OverlayMenu.value_for_config()).c_str());
-        ini.SetValue("Menu", "ShortcutKey", GetIntValue(Instance()->ShortcutKey.value_for_config()).c_str());
-        ini.SetValue("Menu", "ExtendedLimits", GetBoolValue(Instance()->ExtendedLimits.value_for_config()).c_str());
-        ini.SetValue("Menu", "ShowFps", GetBoolValue(Instance()->ShowFps.value_for_config()).c_str());
-        ini.SetValue("Menu", "UseHQFont", GetBoolValue(Instance()->UseHQFont.value_for_config()).c_str());
-        ini.SetValue("Menu", "FpsOverlayPos", GetIntValue(Instance()->FpsOverlayPos.value_for_config()).c_str());
-        ini.SetValue("Menu", "FpsOverlayType", GetIntValue(Instance()->FpsOverlayType.value_for_config()).c_str());
-        ini.SetValue("Menu", "FpsOverlayHorizontal", GetBoolValue(Instance()->FpsOverlayHorizontal.value_for_config()).c_str());
-        ini.SetValue("Menu", "FpsOverlayAlpha", GetFloatValue(Instance()->FpsOverlayAlpha.value_for_config()).c_str());
-    }
-
-    // Hooks
-    {
-        ini.SetValue("Hooks", "HookOriginalNvngxOnly", GetBoolValue(Instance()->HookOriginalNvngxOnly.value_for_config()).c_str());
-    }
-
-    // CAS
-    {
-        ini.SetValue("CAS", "Enabled", GetBoolValue(Instance()->RcasEnabled.value_for_config()).c_str());
-        ini.SetValue("CAS", "MotionSharpnessEnabled", GetBoolValue(Instance()->MotionSharpnessEnabled.value_for_config()).c_str());
-        ini.SetValue("CAS", "MotionSharpnessDebug", GetBoolValue(Instance()->MotionSharpnessDebug.value_for_config()).c_str());
-        ini.SetValue("CAS", "MotionSharpness", GetFloatValue(Instance()->MotionSharpness.value_for_config()).c_str());
-        ini.SetValue("CAS", "MotionThreshold", GetFloatValue(Instance()->MotionThreshold.value_for_config()).c_str());
-        ini.SetValue("CAS", "MotionScaleLimit", GetFloatValue(Instance()->MotionScaleLimit.value_for_config()).c_str());
-    }
-
-    // InitFlags
-    {
-        ini.SetValue("InitFlags", "AutoExposure", GetBoolValue(Instance()->AutoExposure.value_for_config()).c_str());
-        ini.SetValue("InitFlags", "HDR", GetBoolValue(Instance()->HDR.value_for_config()).c_str());
-        ini.SetValue("InitFlags", "DepthInverted", GetBoolValue(Instance()->DepthInverted.value_for_config()).c_str());
-        ini.SetValue("InitFlags", "JitterCancellation", GetBoolValue(Instance()->JitterCancellation.value_for_config()).c_str());
-        ini.SetValue("InitFlags", "DisplayResolution", GetBoolValue(Instance()->DisplayResolution.value_for_config()).c_str());
-        ini.SetValue("InitFlags", "DisableReactiveMask", GetBoolValue(Instance()->DisableReactiveMask.value_for_config()).c_str());
-    }
-
-    // Upscale Ratio Override
-    {
-        ini.SetValue("UpscaleRatio", "UpscaleRatioOverrideEnabled", GetBoolValue(Instance()->UpscaleRatioOverrideEnabled.value_for_config()).c_str());
-        ini.SetValue("UpscaleRatio", "UpscaleRatioOverrideValue", GetFloatValue(Instance()->UpscaleRatioOverrideValue.value_for_config()).c_str());
-    }
-
-    // Quality Overrides
-    {
-        ini.SetValue("QualityOverrides", "QualityRatioOverrideEnabled", GetBoolValue(Instance()->QualityRatioOverrideEnabled.value_for_config()).c_str());
-        ini.SetValue("QualityOverrides", "QualityRatioDLAA", GetFloatValue(Instance()->QualityRatio_DLAA.value_for_config()).c_str());
-        ini.SetValue("QualityOverrides", "QualityRatioUltraQuality", GetFloatValue(Instance()->QualityRatio_UltraQuality.value_for_config()).c_str());
-        ini.SetValue("QualityOverrides", "QualityRatioQuality", GetFloatValue(Instance()->QualityRatio_Quality.value_for_config()).c_str());
-        ini.SetValue("QualityOverrides", "QualityRatioBalanced", GetFloatValue(Instance()->QualityRatio_Balanced.value_for_config()).c_str());
-        ini.SetValue("QualityOverrides", "QualityRatioPerformance", GetFloatValue(Instance()->QualityRatio_Performance.value_for_config()).c_str());
-        ini.SetValue("QualityOverrides", "QualityRatioUltraPerformance", GetFloatValue(Instance()->QualityRatio_UltraPerformance.value_for_config()).c_str());
-    }
-
     // Hotfixes
     {
         ini.SetValue("Hotfix", "MipmapBiasOverride", GetFloatValue(Instance()->MipmapBiasOverride.value_for_config()).c_str());
-        ini.SetValue("Hotfix", "MipmapBiasOverrideAll", GetBoolValue(Instance()->MipmapBiasOverrideAll.value_for_config()).c_str());
-        ini.SetValue("Hotfix", "MipmapBiasFixedOverride", GetBoolValue(Instance()->MipmapBiasFixedOverride.value_for_config()).c_str());
-        ini.SetValue("Hotfix", "MipmapBiasScaleOverride", GetBoolValue(Instance()->MipmapBiasScaleOverride.value_for_config()).c_str());
 
         ini.SetValue("Hotfix", "AnisotropyOverride", GetIntValue(Instance()->AnisotropyOverride.value_for_config()).c_str());
-        ini.SetValue("Hotfix", "RoundInternalResolution", GetIntValue(Instance()->RoundInternalResolution.value_for_config()).c_str());
-        
-        ini.SetValue("Hotfix", "OverrideShaderSampler", GetBoolValue(Instance()->OverrideShaderSampler.value_for_config()).c_str());
-
-        ini.SetValue("Hotfix", "RestoreComputeSignature", GetBoolValue(Instance()->RestoreComputeSignature.value_for_config()).c_str());
-        ini.SetValue("Hotfix", "RestoreGraphicSignature", GetBoolValue(Instance()->RestoreGraphicSignature.value_for_config()).c_str());
-        ini.SetValue("Hotfix", "SkipFirstFrames", GetIntValue(Instance()->SkipFirstFrames.value_for_config()).c_str());
-
-        ini.SetValue("Hotfix", "UsePrecompiledShaders", GetBoolValue(Instance()->UsePrecompiledShaders.value_for_config()).c_str());
-        ini.SetValue("Hotfix", "PreferDedicatedGpu", GetBoolValue(Instance()->PreferDedicatedGpu.value_for_config()).c_str());
-        ini.SetValue("Hotfix", "PreferFirstDedicatedGpu", GetBoolValue(Instance()->PreferFirstDedicatedGpu.value_for_config()).c_str());
-
-        ini.SetValue("Hotfix", "UseGenericAppIdWithDlss", GetBoolValue(Instance()->UseGenericAppIdWithDlss.value_for_config()).c_str());
-
-        ini.SetValue("Hotfix", "ColorResourceBarrier", GetIntValue(Instance()->ColorResourceBarrier.value_for_config()).c_str());
-        ini.SetValue("Hotfix", "MotionVectorResourceBarrier", GetIntValue(Instance()->MVResourceBarrier.value_for_config()).c_str());
-        ini.SetValue("Hotfix", "DepthResourceBarrier", GetIntValue(Instance()->DepthResourceBarrier.value_for_config()).c_str());
-        ini.SetValue("Hotfix", "ColorMaskResourceBarrier", GetIntValue(Instance()->MaskResourceBarrier.value_for_config()).c_str());
-        ini.SetValue("Hotfix", "ExposureResourceBarrier", GetIntValue(Instance()->ExposureResourceBarrier.value_for_config()).c_str());
-        ini.SetValue("Hotfix", "OutputResourceBarrier", GetIntValue(Instance()->OutputResourceBarrier.value_for_config()).c_str());
     }
 
     // Dx11 with Dx12
     {
-        ini.SetValue("Dx11withDx12", "TextureSyncMethod", GetIntValue(Instance()->TextureSyncMethod.value_for_config()).c_str());
-        ini.SetValue("Dx11withDx12", "CopyBackSyncMethod", GetIntValue(Instance()->CopyBackSyncMethod.value_for_config()).c_str());
-        ini.SetValue("Dx11withDx12", "SyncAfterDx12", GetBoolValue(Instance()->SyncAfterDx12.value_for_config()).c_str());
-        ini.SetValue("Dx11withDx12", "UseDelayedInit", GetBoolValue(Instance()->Dx11DelayedInit.value_for_config()).c_str());
         ini.SetValue("Dx11withDx12", "DontUseNTShared", GetBoolValue(Instance()->DontUseNTShared.value_for_config()).c_str());
     }
 
     // Logging
     {
-        ini.SetValue("Log", "LogLevel", GetIntValue(Instance()->LogLevel.value_for_config()).c_str());
-        ini.SetValue("Log", "LogToConsole", GetBoolValue(Instance()->LogToConsole.value_for_config()).c_str());
-        ini.SetValue("Log", "LogToFile", GetBoolValue(Instance()->LogToFile.value_for_config()).c_str());
-        ini.SetValue("Log", "LogToNGX", GetBoolValue(Instance()->LogToNGX.value_for_config()).c_str());
-        ini.SetValue("Log", "OpenConsole", GetBoolValue(Instance()->OpenConsole.value_for_config()).c_str());
         ini.SetValue("Log", "LogFile", wstring_to_string(Instance()->LogFileName.value_for_config_or(L"auto")).c_str());
-        ini.SetValue("Log", "SingleFile", GetBoolValue(Instance()->LogSingleFile.value_for_config()).c_str());
-        ini.SetValue("Log", "LogAsync", GetBoolValue(Instance()->LogAsync.value_for_config()).c_str());
-        ini.SetValue("Log", "LogAsyncThreads", GetIntValue(Instance()->LogAsyncThreads.value_for_config()).c_str());
     }
 
     // NvApi
     {
-        ini.SetValue("NvApi", "OverrideNvapiDll", GetBoolValue(Instance()->OverrideNvapiDll.value_for_config()).c_str());
         ini.SetValue("NvApi", "NvapiDllPath", wstring_to_string(Instance()->NvapiDllPath.value_for_config_or(L"auto")).c_str());
     }
 
-    // DRS
-    {
-        ini.SetValue("DRS", "DrsMinOverrideEnabled", GetBoolValue(Instance()->DrsMinOverrideEnabled.value_for_config()).c_str());
-        ini.SetValue("DRS", "DrsMaxOverrideEnabled", GetBoolValue(Instance()->DrsMaxOverrideEnabled.value_for_config()).c_str());
-    }
-
     // Spoofing
     {
-        ini.SetValue("Spoofing", "Dxgi", GetBoolValue(Instance()->DxgiSpoofing.value_for_config()).c_str());
         ini.SetValue("Spoofing", "DxgiBlacklist", Instance()->DxgiBlacklist.value_for_config_or("auto").c_str());
-        ini.SetValue("Spoofing", "Vulkan", GetBoolValue(Instance()->VulkanSpoofing.value_for_config()).c_str());
-        ini.SetValue("Spoofing", "VulkanExtensionSpoofing", GetBoolValue(Instance()->VulkanExtensionSpoofing.value_for_config()).c_str());
-        ini.SetValue("Spoofing", "VulkanVRAM", GetIntValue(Instance()->VulkanVRAM.value_for_config()).c_str());
-        ini.SetValue("Spoofing", "DxgiVRAM", GetIntValue(Instance()->DxgiVRAM.value_for_config()).c_str());
         ini.SetValue("Spoofing", "SpoofedGPUName", wstring_to_string(Instance()->SpoofedGPUName.value_for_config_or(L"auto")).c_str());
-        ini.SetValue("Spoofing", "SpoofHAGS", GetBoolValue(Instance()->SpoofHAGS.value_for_config()).c_str());
-        ini.SetValue("Spoofing", "D3DFeatureLevel", GetBoolValue(Instance()->SpoofFeatureLevel.value_for_config()).c_str());
     }
 
     // Plugins
     {
-        
         ini.SetValue("Plugins", "Path", wstring_to_string(Instance()->PluginPath.value_for_config_or(L"auto")).c_str());
-        ini.SetValue("Plugins", "LoadSpecialK", GetBoolValue(Instance()->LoadSpecialK.value_for_config()).c_str());
     }
 
-    // inputs
+    bool result = false;
+
+    // Changes are kept in game profile when there is one, global ini stays untouched
+    if (auto profile = GameProfile::Find(absoluteFileName.parent_path()); profile.has_value())
     {
-        ini.SetValue("Inputs", "Dlss", GetBoolValue(Instance()->DlssInputs.value_for_config()).c_str());
-        ini.SetValue("Inputs", "XeSS", GetBoolValue(Instance()->XeSSInputs.value_for_config()).c_str());
-        ini.SetValue("Inputs", "Fsr2", GetBoolValue(Instance()->Fsr2Inputs.value_for_config()).c_str());
-        ini.SetValue("Inputs", "Fsr2Pattern", GetBoolValue(Instance()->Fsr2Pattern.value_for_config()).c_str());
-        ini.SetValue("Inputs", "Fsr3", GetBoolValue(Instance()->Fsr3Inputs.value_for_config()).c_str());
-        ini.SetValue("Inputs", "Fsr3Pattern", GetBoolValue(Instance()->Fsr3Pattern.value_for_config()).c_str());
-        ini.SetValue("Inputs", "Ffx", GetBoolValue(Instance()->FfxInputs.value_for_config()).c_str());
+        result = GameProfile::Save(profile.value(), absoluteFileName, ini);
     }
+    else
+    {
+        auto pathWStr = absoluteFileName.wstring();
+
+        LOG_INFO("Trying to save ini to: {0}", wstring_to_string(pathWStr));
 
-    auto pathWStr = absoluteFileName.wstring();
+        result = ini.SaveFile(absoluteFileName.wstring().c_str()) >= 0;
+    }
 
-    LOG_INFO("Trying to save ini to: {0}", wstring_to_string(pathWStr));
+    // Our own save shouldn't be reported as a change
+    if (result)
+        IniWatcher::Rebase();
 
-    return ini.SaveFile(absoluteFileName.wstring().c_str()) >= 0;
+    return result;
 }
 
 bool Config::ReloadFakenvapi() {
@@ -925,96 +998,22 @@ std::optional<std::wstring> Config::readWString(std::string section, std::string
 
 std::optional<float> Config::readFloat(std::string section, std::string key)
 {
-    auto value = readString(section, key);
-
-    try
-    {
-        float result;
-
-        if (value.has_value() && isFloat(value.value(), result))
-            return result;
-
-        return std::nullopt;
-    }
-    catch (const std::bad_optional_access&) // missing or auto value
-    {
-        return std::nullopt;
-    }
-    catch (const std::invalid_argument&) // invalid float string for std::stof
-    {
-        return std::nullopt;
-    }
-    catch (const std::out_of_range&) // out of range for 32 bit float
-    {
-        return std::nullopt;
-    }
+    return IniDiff::ParseValue<float>(ini.GetValue(section.c_str(), key.c_str(), "auto"));
 }
 
 std::optional<int> Config::readInt(std::string section, std::string key)
 {
-    auto value = readString(section, key);
-    try
-    {
-        int result;
-
-        if (value.has_value() && isInteger(value.value(), result))
-            return result;
-
-        return std::nullopt;
-    }
-    catch (const std::bad_optional_access&) // missing or auto value
-    {
-        return std::nullopt;
-    }
-    catch (const std::invalid_argument&) // invalid float string for std::stof
-    {
-        return std::nullopt;
-    }
-    catch (const std::out_of_range&) // out// out of range for 32 bit float
-    {
-        return std::nullopt;
-    }
+    return IniDiff::ParseValue<int>(ini.GetValue(section.c_str(), key.c_str(), "auto"));
 }
 
 std::optional<uint32_t> Config::readUInt(std::string section, std::string key)
 {
-    auto value = readString(section, key);
-    try
-    {
-        uint32_t result;
-
-        if (value.has_value() && isUInt(value.value(), result))
-            return result;
-
-        return std::nullopt;
-    }
-    catch (const std::bad_optional_access&) // missing or auto value
-    {
-        return std::nullopt;
-    }
-    catch (const std::invalid_argument&) // invalid float string for std::stof
-    {
-        return std::nullopt;
-    }
-    catch (const std::out_of_range&) // out// out of range for 32 bit float
-    {
-        return std::nullopt;
-    }
+    return IniDiff::ParseValue<uint32_t>(ini.GetValue(section.c_str(), key.c_str(), "auto"));
 }
 
 std::optional<bool> Config::readBool(std::string section, std::string key)
 {
-    auto value = readString(section, key, true);
-    if (value == "true")
-    {
-        return true;
-    }
-    else if (value == "false")
-    {
-        return false;
-    }
-
-    return std::nullopt;
+    return IniDiff::ParseValue<bool>(ini.GetValue(section.c_str(), key.c_str(), "auto"));
 }
 
 Config* Config::Instance()
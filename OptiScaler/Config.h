@@ -2,9 +2,13 @@
 #include "pch.h"
 #include "State.h"
 #include <optional>
+#include <atomic>
+#include <mutex>
 #include <filesystem>
 #include <SimpleIni.h>
 
+#include "misc/IniDiff.h"
+
 enum HasDefaultValue
 {
 	WithDefault,
@@ -119,6 +123,42 @@ public:
 	}
 };
 
+// Plain copy of settings read by per draw & per frame hooks
+// Published by Config::PublishSnapshot after ini loads & menu changes
+struct ConfigSnapshot
+{
+	// Frame generation
+	bool FGEnabled = false;
+	bool FGHUDFix = false;
+	bool FGHUDFixExtended = false;
+	bool FGImmediateCapture = false;
+	bool FGAlwaysTrackHeaps = false;
+	int FGHUDLimit = 1;
+
+	// HDR
+	bool ForceHDR = false;
+	bool UseHDR10 = false;
+
+	// Sampler overrides
+	bool HasAnisotropyOverride = false;
+	int AnisotropyOverride = 0;
+	bool HasMipmapBiasOverride = false;
+	float MipmapBiasOverride = 0.0f;
+	bool MipmapBiasFixedOverride = false;
+	bool MipmapBiasScaleOverride = false;
+	bool MipmapBiasOverrideAll = false;
+	bool MipmapBiasAuto = false;
+	float MipmapBiasAutoOffset = 0.0f;
+
+	// DXGI spoofing, read by GetDesc hooks through AdapterTable
+	bool DxgiSpoofing = false;
+	bool HasDxgiVRAM = false;
+	int DxgiVRAM = 0;
+	std::wstring SpoofedGPUName;
+
+	bool operator==(const ConfigSnapshot&) const = default;
+};
+
 class Config
 {
 public:
@@ -144,9 +184,12 @@ public:
 	CustomOptional<bool> LogSingleFile{ true };
 	CustomOptional<bool> LogAsync{ false };
 	CustomOptional<int> LogAsyncThreads{ 4 };
+	CustomOptional<bool> LogBinary{ false }; // Trace & debug logs are written to .blog file
+	CustomOptional<int> TraceFrames{ 300 };
 
 	// XeSS
 	CustomOptional<bool> BuildPipelines{ true };
+	CustomOptional<bool> XeSSUsePipelineCache{ true };
 	CustomOptional<int32_t> NetworkModel{ 0 };
 	CustomOptional<bool> CreateHeaps{ true };
 	CustomOptional<std::wstring, NoDefault> XeSSLibrary;
@@ -192,7 +235,10 @@ public:
 	CustomOptional<int> FpsCycleShortcutKey{ VK_NEXT };
 	CustomOptional<bool> FpsOverlayHorizontal{ false };
 	CustomOptional<float> FpsOverlayAlpha{ 0.4f };
+	CustomOptional<int> FpsOverlayRefreshRate{ 10 }; // Overlay rebuilds per second, 0 every frame
 	CustomOptional<bool> UseHQFont{ true };
+	CustomOptional<bool> UseFontCache{ true };
+	CustomOptional<bool> IniHotReload{ false };
 
 	// Hooks
 	CustomOptional<bool> HookOriginalNvngxOnly{ false };
@@ -204,6 +250,8 @@ public:
 	// DRS
 	CustomOptional<bool> DrsMinOverrideEnabled{ false };
 	CustomOptional<bool> DrsMaxOverrideEnabled{ false };
+	CustomOptional<bool> DrsGovernorEnabled{ false };
+	CustomOptional<float> DrsTargetFrameTime{ 16.6f };
 
 	// Quality Overrides
 	CustomOptional<bool> QualityRatioOverrideEnabled{ false };
@@ -219,6 +267,8 @@ public:
 	CustomOptional<bool> MipmapBiasFixedOverride{ false };
 	CustomOptional<bool> MipmapBiasScaleOverride{ false };
 	CustomOptional<bool> MipmapBiasOverrideAll{ false };
+	CustomOptional<bool> MipmapBiasAuto{ false }; // log2(render / display) + MipmapBiasAutoOffset
+	CustomOptional<float> MipmapBiasAutoOffset{ 0.0f };
 	CustomOptional<int, NoDefault> AnisotropyOverride; // disabled by default
 	CustomOptional<bool> OverrideShaderSampler{ false };
 	CustomOptional<int, NoDefault> RoundInternalResolution; // disabled by default
@@ -232,6 +282,7 @@ public:
 	CustomOptional<bool> UseGenericAppIdWithDlss{ false };
 	CustomOptional<bool> PreferDedicatedGpu{ false };
 	CustomOptional<bool> PreferFirstDedicatedGpu{ false };
+	CustomOptional<bool> UseStartupCache{ true };
 
 	CustomOptional<int32_t, NoDefault> ColorResourceBarrier; // disabled by default
 	CustomOptional<int32_t, NoDefault> MVResourceBarrier; // disabled by default
@@ -244,6 +295,9 @@ public:
 	CustomOptional<std::string, SoftDefault> Dx11Upscaler{ "fsr22" };
 	CustomOptional<std::string, SoftDefault> Dx12Upscaler{ "xess" };
 	CustomOptional<std::string, SoftDefault> VulkanUpscaler{ "fsr21" };
+	CustomOptional<bool> AsyncBackendSwitch{ true };
+	CustomOptional<int> ContextCacheSize{ 2 };
+	CustomOptional<int> ContextCacheBudget{ 512 }; // MB
 
 	// Output Scaling
 	CustomOptional<bool> OutputScalingEnabled{ false };
@@ -260,6 +314,7 @@ public:
 	CustomOptional<bool> FsrNonLinearSRGB{ false };
 	CustomOptional<bool> FsrNonLinearPQ{ false };
 	CustomOptional<bool> FsrAgilitySDKUpgrade{ false };
+	CustomOptional<bool> VulkanPipelineCache{ true };
 
 	// FSR Common
 	CustomOptional<float> FsrVerticalFov{ 60.0f };
@@ -323,6 +378,8 @@ public:
 	CustomOptional<bool> FGMakeDepthCopy{ true };
 	CustomOptional<bool> FGEnableDepthScale{ false };
 	CustomOptional<float> FGDepthScaleMax{ 10000.0f };
+	CustomOptional<bool> FGDepthScaleAuto{ false };
+	CustomOptional<int> FGDepthScaleAutoInterval{ 30 };
 	CustomOptional<bool> FGMakeMVCopy{ true };
 	CustomOptional<bool> FGHudFixCloseAfterCallback{ true };
 	CustomOptional<bool> FGUseMutexForSwaphain{ true };
@@ -375,9 +432,52 @@ public:
 
 	static Config* Instance();
 
+	// Lock free read of hot path settings, hooks load it once per call and pass it down
+	// Pointer is only valid during that call, replaced snapshots are freed after SnapshotGracePeriodMs
+	static const ConfigSnapshot* Snapshot()
+	{
+		auto snapshot = _snapshot.load(std::memory_order_acquire);
+
+		if (snapshot == nullptr)
+		{
+			Instance();
+			snapshot = _snapshot.load(std::memory_order_acquire);
+		}
+
+		return snapshot;
+	}
+
+	// Rebuilds snapshot from current values, swaps it only when something changed
+	void PublishSnapshot();
+
+	// Increased every time a changed snapshot is published, caches built from a snapshot compare it
+	static uint32_t SnapshotVersion() { return _snapshotVersion.load(std::memory_order_acquire); }
+
+	std::filesystem::path IniPath() const { return absoluteFileName; }
+
+	// Tag of a changed ini key, keys without live support need a restart
+	static IniChangeKind IniChangeKindOf(const std::string& InSection, const std::string& InKey);
+
+	// Resets values of changed live keys & reads them again from ini, should be called from render thread
+	void ApplyIniChanges(const std::vector<IniChange>& InChanges);
+
 private:
 	inline static Config* _config;
 
+	// Much longer than any hook call, readers never see a freed snapshot
+	static constexpr double SnapshotGracePeriodMs = 1000.0;
+
+	struct RetiredSnapshot
+	{
+		const ConfigSnapshot* Snapshot = nullptr;
+		double RetiredMs = 0.0;
+	};
+
+	inline static std::atomic<const ConfigSnapshot*> _snapshot = nullptr;
+	inline static std::vector<RetiredSnapshot> _retiredSnapshots;
+	inline static std::mutex _snapshotMutex;
+	inline static std::atomic<uint32_t> _snapshotVersion = 0;
+
 	CSimpleIniA ini;
 	CSimpleIniA fakenvapiIni;
 	std::filesystem::path absoluteFileName;
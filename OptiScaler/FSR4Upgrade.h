@@ -4,6 +4,9 @@
 #include <Unknwn.h>
 #include <Windows.h>
 
+#include "misc/StartupCache.h"
+#include "misc/StartupProfiler.h"
+
 //#include <d3dkmthk.h>
 
 // Manually define structures
@@ -46,6 +49,11 @@ typedef UINT(*PFN_D3DKMTCloseAdapter)(D3DKMT_CLOSEADAPTER_L*);
 
 inline static std::vector<std::filesystem::path> GetDriverStore()
 {
+    STARTUP_ZONE(StartupPhase::DriverStore);
+
+    if (auto cached = StartupCache::DriverStore(); cached.has_value())
+        return cached.value();
+
     std::vector<std::filesystem::path> result;
 
     // Load D3DKMT functions dynamically
@@ -126,6 +134,8 @@ inline static std::vector<std::filesystem::path> GetDriverStore()
     if (libraryLoaded)
         FreeLibrary(hGdi32);
 
+    StartupCache::SetDriverStore(result);
+
     return result;
 }
 
@@ -1,6 +1,7 @@
 #include "Logger.h"
 #include "Config.h"
 #include <iostream>
+#include <filesystem>
 
 #include "spdlog/async.h"
 #include "spdlog/sinks/basic_file_sink.h"
@@ -8,6 +9,7 @@
 #include "spdlog/sinks/callback_sink.h"
 
 #include "Util.h"
+#include "misc/StartupProfiler.h"
 
 static bool InitializeConsole()
 {
@@ -60,11 +62,16 @@ static bool InitializeConsole()
 
 void PrepareLogger()
 {
+    STARTUP_ZONE(StartupPhase::PrepareLogger);
+
     try
     {
         if (spdlog::default_logger() != nullptr)
             spdlog::default_logger().reset();
 
+        if (!Config::Instance()->LogToFile.value_or_default() || !Config::Instance()->LogBinary.value_or_default())
+            BinaryLog::Stop();
+
         if (Config::Instance()->LogToConsole.value_or_default() || Config::Instance()->LogToFile.value_or_default() || Config::Instance()->LogToNGX.value_or_default())
         {
             if (Config::Instance()->OpenConsole.value_or_default())
@@ -130,9 +137,14 @@ void PrepareLogger()
             }
 
             shared_logger->set_level((spdlog::level::level_enum)Config::Instance()->LogLevel.value_or_default());
-            shared_logger->flush_on(spdlog::level::trace);
+            // Binary logs are flushed by their writer thread
+            auto binary = Config::Instance()->LogToFile.value_or_default() && Config::Instance()->LogBinary.value_or_default();
+            shared_logger->flush_on(binary ? spdlog::level::info : spdlog::level::trace);
 
             spdlog::set_default_logger(shared_logger);
+
+            if (binary)
+                BinaryLog::Start(std::filesystem::path(Config::Instance()->LogFileName.value_or_default()).replace_extension(L".blog").wstring());
         }
     }
     catch (const spdlog::spdlog_ex& ex)
@@ -148,6 +160,8 @@ void PrepareLogger()
 
 void CloseLogger()
 {
+    BinaryLog::Stop();
+
     spdlog::default_logger()->flush();
     spdlog::shutdown();
 }
@@ -2,6 +2,7 @@
 #include "pch.h"
 #include "Config.h"
 #include "DLSSG_Mod.h"
+#include "misc/DrsGovernor.h"
 
 #include <ankerl/unordered_dense.h>
 
@@ -83,6 +84,41 @@ inline static std::optional<float> GetQualityOverrideRatio(const NVSDK_NGX_PerfQ
     return output;
 }
 
+// Replaces render size with the governed one, DRS max is lowered to it too so games with their own DRS follow it
+inline static void ApplyDrsGovernor(NVSDK_NGX_Parameter* InParams, unsigned int Width, unsigned int Height, unsigned int* OutWidth, unsigned int* OutHeight, float* OutScalingRatio)
+{
+    if (!DrsGovernor::IsActive() || Width == 0 || Height == 0)
+        return;
+
+    unsigned int minWidth = *OutWidth;
+    unsigned int maxWidth = *OutWidth;
+
+    InParams->Get(NVSDK_NGX_Parameter_DLSS_Get_Dynamic_Min_Render_Width, &minWidth);
+    InParams->Get(NVSDK_NGX_Parameter_DLSS_Get_Dynamic_Max_Render_Width, &maxWidth);
+
+    auto scale = DrsGovernor::Scale(*OutScalingRatio, (float)minWidth / (float)Width, (float)maxWidth / (float)Width);
+
+    *OutWidth = (unsigned int)((float)Width * scale);
+    *OutHeight = (unsigned int)((float)Height * scale);
+
+    if (Config::Instance()->RoundInternalResolution.has_value())
+    {
+        *OutHeight -= *OutHeight % Config::Instance()->RoundInternalResolution.value();
+        *OutWidth -= *OutWidth % Config::Instance()->RoundInternalResolution.value();
+    }
+
+    *OutScalingRatio = (float)*OutWidth / (float)Width;
+
+    InParams->Set(NVSDK_NGX_Parameter_Scale, *OutScalingRatio);
+    InParams->Set(NVSDK_NGX_Parameter_SuperSampling_ScaleFactor, *OutScalingRatio);
+    InParams->Set(NVSDK_NGX_Parameter_OutWidth, *OutWidth);
+    InParams->Set(NVSDK_NGX_Parameter_OutHeight, *OutHeight);
+    InParams->Set(NVSDK_NGX_Parameter_DLSS_Get_Dynamic_Max_Render_Width, *OutWidth);
+    InParams->Set(NVSDK_NGX_Parameter_DLSS_Get_Dynamic_Max_Render_Height, *OutHeight);
+
+    LOG_DEBUG("DRS governor render resolution: {0}x{1}", *OutWidth, *OutHeight);
+}
+
 inline static NVSDK_NGX_Result NVSDK_CONV NVSDK_NGX_DLSS_GetOptimalSettingsCallback(NVSDK_NGX_Parameter* InParams)
 {
     unsigned int Width;
@@ -225,6 +261,8 @@ inline static NVSDK_NGX_Result NVSDK_CONV NVSDK_NGX_DLSS_GetOptimalSettingsCallb
         }
     }
 
+    ApplyDrsGovernor(InParams, Width, Height, &OutWidth, &OutHeight, &scalingRatio);
+
     InParams->Set(NVSDK_NGX_Parameter_SizeInBytes, Width * Height * 31);
     InParams->Set(NVSDK_NGX_Parameter_DLSSMode, NVSDK_NGX_DLSS_Mode_DLSS_DLISP);
 
@@ -367,6 +405,8 @@ inline static NVSDK_NGX_Result NVSDK_CONV NVSDK_NGX_DLSSD_GetOptimalSettingsCall
         InParams->Set(NVSDK_NGX_Parameter_DLSS_Get_Dynamic_Max_Render_Height, Height);
     }
 
+    ApplyDrsGovernor(InParams, Width, Height, &OutWidth, &OutHeight, &scalingRatio);
+
     InParams->Set(NVSDK_NGX_Parameter_SizeInBytes, Width * Height * 31);
     InParams->Set(NVSDK_NGX_Parameter_DLSSMode, NVSDK_NGX_DLSS_Mode_DLSS_DLISP);
 
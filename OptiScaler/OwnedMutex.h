@@ -1,21 +1,42 @@
 #pragma once
 
 #include "pch.h"
+#include "misc/Trace.h"
 
 class OwnedMutex {
 private:
     std::mutex mtx;
     uint32_t owner{}; // don't use 0
+    const char* name = "OwnedMutex";
+    int64_t lockedAt = 0;
 
 public:
+    OwnedMutex() = default;
+    OwnedMutex(const char* _name) : name(_name) {}
+
     void lock(uint32_t _owner) {
+        auto requested = Trace::IsCapturing() ? Trace::Now() : 0;
+
         mtx.lock();
         owner = _owner;
+
+        if (requested != 0) {
+            lockedAt = Trace::Now();
+
+            if (Trace::IsContended(requested, lockedAt))
+                Trace::AddEvent(name, Trace::Track::LockWait, requested, lockedAt);
+        }
+        else {
+            lockedAt = 0;
+        }
     }
 
     // Only unlocks if owner matches
     void unlockThis(uint32_t _owner) {
         if (owner == _owner) {
+            if (lockedAt != 0 && Trace::IsCapturing())
+                Trace::AddEvent(name, Trace::Track::LockHold, lockedAt, Trace::Now());
+
             mtx.unlock();
             owner = 0;
         }
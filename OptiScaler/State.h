@@ -2,6 +2,7 @@
 #include "pch.h"
 
 #include "upscalers/IFeature.h"
+#include "misc/TimeWindow.h"
 
 #include <deque>
 #include <vulkan/vulkan.h>
@@ -70,6 +71,9 @@ public:
 	bool FGresetCapturedResources = false;
 	bool FGonlyUseCapturedResources = false;
 
+	// Depth scale derived from min/max reduction, 0 when not available
+	float FGautoDepthScale = 0.0f;
+
 	// NVNGX init parameters
 	uint64_t NVNGX_ApplicationId = 1337;
 	std::wstring NVNGX_ApplicationDataPath;
@@ -132,8 +136,12 @@ public:
 	VkInstance VulkanInstance = nullptr;
 
 	// Framegraph
-	std::deque<double> upscaleTimes;
-	std::deque<double> frameTimes;
+	// Filled with 300 zeros at startup
+	TimeWindow upscaleTimes;
+	TimeWindow frameTimes{ 100 };
+
+	void AddUpscaleTime(double InTime) { upscaleTimes.Add(InTime); }
+	void AddFrameTime(double InTime) { frameTimes.Add(InTime); }
 
 	// Swapchain info
 	float screenWidth = 800.0;
@@ -160,7 +168,6 @@ public:
 
 	std::vector<ID3D12Device*> d3d12Devices;
 	std::vector<ID3D11Device*> d3d11Devices;
-	std::map<UINT64, std::string> adapterDescs;
 
 private:
     State() = default;
@@ -1,6 +1,7 @@
 #include "pch.h"
 #include "Util.h"
 #include "Config.h"
+#include "misc/StartupCache.h"
 
 #include <shlobj.h>
 
@@ -141,6 +142,16 @@ inline std::string LogLastError()
 }
 
 bool Util::GetDLLVersion(std::wstring dllPath, version_t* versionOut) {
+	// Reading version resource loads the file, result is cached until file changes
+	version_t cachedVersion{};
+	if (auto cached = StartupCache::DllVersion(dllPath, &cachedVersion); cached.has_value() && versionOut != nullptr)
+	{
+		if (cached.value())
+			*versionOut = cachedVersion;
+
+		return cached.value();
+	}
+
 	// Step 1: Get the size of the version information
 	DWORD handle = 0;
 	DWORD versionSize = GetFileVersionInfoSizeW(dllPath.c_str(), &handle);
@@ -148,6 +159,7 @@ bool Util::GetDLLVersion(std::wstring dllPath, version_t* versionOut) {
 	if (versionSize == 0)
 	{
 		//LOG_ERROR("Failed to get version info size: {0:X}", LogLastError());
+		StartupCache::SetDllVersion(dllPath, false, {});
 		return false;
 	}
 
@@ -176,6 +188,8 @@ bool Util::GetDLLVersion(std::wstring dllPath, version_t* versionOut) {
 		versionOut->minor = (fileVersionMS >> 0) & 0xffff;
 		versionOut->patch = (fileVersionLS >> 16) & 0xffff;
 		versionOut->reserved = (fileVersionLS >> 0) & 0xffff;
+
+		StartupCache::SetDllVersion(dllPath, true, *versionOut);
 	}
 	else
 	{
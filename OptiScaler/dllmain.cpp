@@ -6,6 +6,13 @@
 
 #include "FSR4Upgrade.h"
 
+#include "misc/AdapterTable.h"
+#include "misc/IniWatcher.h"
+#include "misc/GameProfile.h"
+#include "misc/ModuleNames.h"
+#include "misc/StartupCache.h"
+#include "misc/StartupProfiler.h"
+
 #include "proxies/NVNGX_Proxy.h"
 #include "proxies/XeSS_Proxy.h"
 #include "proxies/FfxApi_Proxy.h"
@@ -17,6 +24,7 @@
 
 #include "hooks/HooksDx.h"
 #include "hooks/HooksVk.h"
+#include "hooks/HookRegistry.h"
 
 #include <vulkan/vulkan_core.h>
 
@@ -92,37 +100,6 @@ static uint32_t vkEnumerateDeviceExtensionPropertiesCount = 0;
 static AmdExtFfxApi* _amdExtFfxApi = nullptr;
 static PFN_AmdExtD3DCreateInterface o_AmdExtD3DCreateInterface = nullptr;
 
-#define DEFINE_NAME_VECTORS(varName, libName) \
-    inline std::vector<std::string> varName##Names = { libName ".dll", libName }; \
-    inline std::vector<std::wstring> varName##NamesW = { L##libName L".dll", L##libName };
-
-inline std::vector<std::string> dllNames;
-inline std::vector<std::wstring> dllNamesW;
-
-inline std::vector<std::string> overlayNames = { "eosovh-win32-shipping.dll", "eosovh-win32-shipping", "eosovh-win64-shipping.dll", "eosovh-win64-shipping",
-                                                 "gameoverlayrenderer64", "gameoverlayrenderer64.dll", "gameoverlayrenderer", "gameoverlayrenderer.dll", };
-inline std::vector<std::wstring> overlayNamesW = { L"eosovh-win32-shipping.dll", L"eosovh-win32-shipping", L"eosovh-win64-shipping.dll", L"eosovh-win64-shipping",
-                                                   L"gameoverlayrenderer64", L"gameoverlayrenderer64.dll", L"gameoverlayrenderer", L"gameoverlayrenderer.dll", };
-
-DEFINE_NAME_VECTORS(nvngx, "nvngx");
-DEFINE_NAME_VECTORS(xess, "libxess");
-DEFINE_NAME_VECTORS(nvngxDlss, "nvngx_dlss");
-DEFINE_NAME_VECTORS(nvapi, "nvapi64");
-DEFINE_NAME_VECTORS(dx11, "d3d11");
-DEFINE_NAME_VECTORS(dx12, "d3d12");
-DEFINE_NAME_VECTORS(dxgi, "dxgi");
-DEFINE_NAME_VECTORS(vk, "vulkan-1");
-DEFINE_NAME_VECTORS(streamline, "sl.interposer");
-
-DEFINE_NAME_VECTORS(fsr2, "ffx_fsr2_api_x64");
-DEFINE_NAME_VECTORS(fsr2BE, "ffx_fsr2_api_dx12_x64");
-
-DEFINE_NAME_VECTORS(fsr3, "ffx_fsr3upscaler_x64");
-DEFINE_NAME_VECTORS(fsr3BE, "ffx_backend_dx12_x64");
-
-DEFINE_NAME_VECTORS(ffxDx12, "amd_fidelityfx_dx12");
-DEFINE_NAME_VECTORS(ffxVk, "amd_fidelityfx_vk");
-
 static int loadCount = 0;
 static bool skipLoadChecks = false;
 static bool dontCount = false;
@@ -134,45 +111,16 @@ void AttachHooks();
 void DetachHooks();
 HMODULE LoadNvApi();
 HMODULE LoadNvngxDlss(std::wstring originalPath);
-void HookForDxgiSpoofing(HMODULE dxgiModule);
-void HookForVulkanSpoofing(HMODULE vulkanModule);
-void HookForVulkanExtensionSpoofing(HMODULE vulkanModule);
-void HookForVulkanVRAMSpoofing(HMODULE vulkanModule);
+void InstallModuleHooks(ModuleKind moduleKind, HMODULE module);
 
-inline static bool CheckDllName(std::string* dllName, std::vector<std::string>* namesList)
+inline static HMODULE LoadLibraryCheck(ModuleKind moduleKind, std::string lcaseLibName, LPCSTR lpLibFullPath)
 {
-    for (size_t i = 0; i < namesList->size(); i++)
-    {
-        auto name = namesList->at(i);
-        auto pos = dllName->rfind(name);
-
-        if (pos != std::string::npos && pos == (dllName->size() - name.size()))
-            return true;
-    }
-
-    return false;
-}
-
-inline static bool CheckDllNameW(std::wstring* dllName, std::vector<std::wstring>* namesList)
-{
-    for (size_t i = 0; i < namesList->size(); i++)
-    {
-        auto name = namesList->at(i);
-        auto pos = dllName->rfind(name);
-
-        if (pos != std::string::npos && pos == (dllName->size() - name.size()))
-            return true;
-    }
+    STARTUP_ZONE(StartupPhase::LoadHooks);
 
-    return false;
-}
-
-inline static HMODULE LoadLibraryCheck(std::string lcaseLibName, LPCSTR lpLibFullPath)
-{
     LOG_TRACE("{}", lcaseLibName);
 
     // If Opti is not loading as nvngx.dll
-    if (!isWorkingWithEnabler && !isNvngxMode)
+    if (!isWorkingWithEnabler && !isNvngxMode && moduleKind == ModuleKind::Nvngx)
     {
         // exe path
         auto exePath = Util::ExePath().parent_path().wstring();
@@ -182,7 +130,7 @@ inline static HMODULE LoadLibraryCheck(std::string lcaseLibName, LPCSTR lpLibFul
 
         auto pos = lcaseLibName.rfind(wstring_to_string(exePath));
 
-        if (Config::Instance()->DlssInputs.value_or_default() && CheckDllName(&lcaseLibName, &nvngxNames) &&
+        if (Config::Instance()->DlssInputs.value_or_default() &&
             (!Config::Instance()->HookOriginalNvngxOnly.value_or_default() || pos == std::string::npos))
         {
             LOG_INFO("nvngx call: {0}, returning this dll!", lcaseLibName);
@@ -192,7 +140,7 @@ inline static HMODULE LoadLibraryCheck(std::string lcaseLibName, LPCSTR lpLibFul
         }
     }
 
-    if (lcaseLibName.ends_with(".optidll"))
+    if (moduleKind == ModuleKind::OptiDll)
     {
         const std::string from = ".optidll";
         const std::string to = ".dll";
@@ -205,7 +153,7 @@ inline static HMODULE LoadLibraryCheck(std::string lcaseLibName, LPCSTR lpLibFul
         return result;
     }
 
-    if (!isNvngxMode && (!State::Instance().isDxgiMode || !State::Instance().skipDxgiLoadChecks) && CheckDllName(&lcaseLibName, &dllNames))
+    if (!isNvngxMode && (!State::Instance().isDxgiMode || !State::Instance().skipDxgiLoadChecks) && ModuleNames::IsSelf(moduleKind))
     {
         LOG_INFO("{0} call returning this dll!", lcaseLibName);
         loadCount++;
@@ -214,7 +162,7 @@ inline static HMODULE LoadLibraryCheck(std::string lcaseLibName, LPCSTR lpLibFul
     }
 
     // NvApi64.dll
-    if (CheckDllName(&lcaseLibName, &nvapiNames)) {
+    if (moduleKind == ModuleKind::NvApi) {
         if (!isWorkingWithEnabler && Config::Instance()->OverrideNvapiDll.value_or_default())
         {
             LOG_INFO("{0} call!", lcaseLibName);
@@ -249,7 +197,7 @@ inline static HMODULE LoadLibraryCheck(std::string lcaseLibName, LPCSTR lpLibFul
     }
 
     // sl.interposer.dll
-    if (Config::Instance()->FGType.value_or_default() == FGType::Nukems && CheckDllName(&lcaseLibName, &streamlineNames))
+    if (Config::Instance()->FGType.value_or_default() == FGType::Nukems && moduleKind == ModuleKind::Streamline)
     {
         skipLoadChecks = true;
         auto streamlineModule = o_LoadLibraryA(lpLibFullPath);
@@ -270,7 +218,7 @@ inline static HMODULE LoadLibraryCheck(std::string lcaseLibName, LPCSTR lpLibFul
     }
 
     // nvngx_dlss
-    if (Config::Instance()->DLSSEnabled.value_or_default() && Config::Instance()->NVNGX_DLSS_Library.has_value() && CheckDllName(&lcaseLibName, &nvngxDlssNames))
+    if (Config::Instance()->DLSSEnabled.value_or_default() && Config::Instance()->NVNGX_DLSS_Library.has_value() && moduleKind == ModuleKind::NvngxDlss)
     {
         skipLoadChecks = true;
         auto nvngxDlss = LoadNvngxDlss(string_to_wstring(lcaseLibName));
@@ -284,7 +232,7 @@ inline static HMODULE LoadLibraryCheck(std::string lcaseLibName, LPCSTR lpLibFul
 
     // NGX OTA
     // Try to catch something like this: c:\programdata/nvidia/ngx/models//dlss/versions/20316673/files/160_e658700.bin
-    if (lcaseLibName.ends_with(".bin"))
+    if (moduleKind == ModuleKind::NgxBin)
     {
         skipLoadChecks = true;
         auto loadedBin = o_LoadLibraryA(lpLibFullPath);
@@ -305,7 +253,7 @@ inline static HMODULE LoadLibraryCheck(std::string lcaseLibName, LPCSTR lpLibFul
 
     if (Config::Instance()->FGType.value_or_default() == FGType::OptiFG)
     {
-        if (Config::Instance()->FGDisableOverlays.value_or_default() && CheckDllName(&lcaseLibName, &overlayNames))
+        if (Config::Instance()->FGDisableOverlays.value_or_default() && moduleKind == ModuleKind::Overlay)
         {
             LOG_DEBUG("Trying to load overlay dll: {}", lcaseLibName);
             return (HMODULE)1;
@@ -313,83 +261,63 @@ inline static HMODULE LoadLibraryCheck(std::string lcaseLibName, LPCSTR lpLibFul
     }
 
     // Hooks
-    if (CheckDllName(&lcaseLibName, &dx11Names) && Config::Instance()->OverlayMenu.value_or_default())
+    if (moduleKind == ModuleKind::Dx11 && Config::Instance()->OverlayMenu.value_or_default())
     {
         skipLoadChecks = true;
         auto module = o_LoadLibraryA(lcaseLibName.c_str());
         skipLoadChecks = false;
 
         if (module != nullptr)
-            HooksDx::HookDx11(module);
+            InstallModuleHooks(ModuleKind::Dx11, module);
         else
             LOG_ERROR("Trying to load dll: {}", lcaseLibName);
 
         return module;
     }
 
-    if (CheckDllName(&lcaseLibName, &dx12Names) && Config::Instance()->OverlayMenu.value_or_default())
+    if (moduleKind == ModuleKind::Dx12 && Config::Instance()->OverlayMenu.value_or_default())
     {
         skipLoadChecks = true;
         auto module = o_LoadLibraryA(lcaseLibName.c_str());
         skipLoadChecks = false;
 
         if (module != nullptr)
-            HooksDx::HookDx12(module);
+            InstallModuleHooks(ModuleKind::Dx12, module);
         else
             LOG_ERROR("Trying to load dll: {}", lcaseLibName);
 
         return module;
     }
 
-    if (CheckDllName(&lcaseLibName, &vkNames))
+    if (moduleKind == ModuleKind::Vulkan)
     {
         skipLoadChecks = true;
         auto module = o_LoadLibraryA(lcaseLibName.c_str());
         skipLoadChecks = false;
 
         if (module != nullptr)
-        {
-            if (!isWorkingWithEnabler)
-            {
-                HookForVulkanSpoofing(module);
-                HookForVulkanExtensionSpoofing(module);
-                HookForVulkanVRAMSpoofing(module);
-            }
-
-            if (Config::Instance()->OverlayMenu.value_or_default())
-                HooksVk::HookVk(module);
-        }
+            InstallModuleHooks(ModuleKind::Vulkan, module);
         else
-        {
             LOG_ERROR("Trying to load dll: {}", lcaseLibName);
-        }
 
         return module;
     }
 
-    if (!State::Instance().skipDxgiLoadChecks && CheckDllName(&lcaseLibName, &dxgiNames))
+    if (!State::Instance().skipDxgiLoadChecks && moduleKind == ModuleKind::Dxgi)
     {
         skipLoadChecks = true;
         auto module = o_LoadLibraryA(lcaseLibName.c_str());
         skipLoadChecks = false;
 
         if (module != nullptr)
-        {
-            if (!isWorkingWithEnabler)
-                HookForDxgiSpoofing(module);
-
-            if (Config::Instance()->OverlayMenu.value_or_default())
-                HooksDx::HookDxgi(module);
-        }
+            InstallModuleHooks(ModuleKind::Dxgi, module);
         else
-        {
             LOG_ERROR("Trying to load dll: {}", lcaseLibName);
-        }
 
         return module;
     }
 
-    if (CheckDllName(&lcaseLibName, &fsr2Names))
+    if (moduleKind == ModuleKind::Fsr2)
     {
         skipLoadChecks = true;
         auto module = o_LoadLibraryA(lcaseLibName.c_str());
@@ -403,7 +331,7 @@ inline static HMODULE LoadLibraryCheck(std::string lcaseLibName, LPCSTR lpLibFul
         return module;
     }
 
-    if (CheckDllName(&lcaseLibName, &fsr2BENames))
+    if (moduleKind == ModuleKind::Fsr2Dx12)
     {
         skipLoadChecks = true;
         auto module = o_LoadLibraryA(lcaseLibName.c_str());
@@ -417,7 +345,7 @@ inline static HMODULE LoadLibraryCheck(std::string lcaseLibName, LPCSTR lpLibFul
         return module;
     }
 
-    if (CheckDllName(&lcaseLibName, &fsr3Names))
+    if (moduleKind == ModuleKind::Fsr3)
     {
         skipLoadChecks = true;
         auto module = o_LoadLibraryA(lcaseLibName.c_str());
@@ -429,7 +357,7 @@ inline static HMODULE LoadLibraryCheck(std::string lcaseLibName, LPCSTR lpLibFul
         return module;
     }
 
-    if (CheckDllName(&lcaseLibName, &fsr3BENames))
+    if (moduleKind == ModuleKind::Fsr3Dx12)
     {
         skipLoadChecks = true;
         auto module = o_LoadLibraryA(lcaseLibName.c_str());
@@ -443,7 +371,7 @@ inline static HMODULE LoadLibraryCheck(std::string lcaseLibName, LPCSTR lpLibFul
         return module;
     }
 
-    if (CheckDllName(&lcaseLibName, &xessNames))
+    if (moduleKind == ModuleKind::XeSS)
     {
         skipLoadChecks = true;
         auto module = o_LoadLibraryA(lcaseLibName.c_str());
@@ -457,7 +385,7 @@ inline static HMODULE LoadLibraryCheck(std::string lcaseLibName, LPCSTR lpLibFul
         return module;
     }
 
-    if (CheckDllName(&lcaseLibName, &ffxDx12Names))
+    if (moduleKind == ModuleKind::FfxDx12)
     {
         skipLoadChecks = true;
         auto module = o_LoadLibraryA(lcaseLibName.c_str());
@@ -471,7 +399,7 @@ inline static HMODULE LoadLibraryCheck(std::string lcaseLibName, LPCSTR lpLibFul
         return module;
     }
 
-    if (CheckDllName(&lcaseLibName, &ffxVkNames))
+    if (moduleKind == ModuleKind::FfxVk)
     {
         skipLoadChecks = true;
         auto module = o_LoadLibraryA(lcaseLibName.c_str());
@@ -488,13 +416,15 @@ inline static HMODULE LoadLibraryCheck(std::string lcaseLibName, LPCSTR lpLibFul
     return nullptr;
 }
 
-inline static HMODULE LoadLibraryCheckW(std::wstring lcaseLibName, LPCWSTR lpLibFullPath)
+inline static HMODULE LoadLibraryCheckW(ModuleKind moduleKind, std::wstring lcaseLibName, LPCWSTR lpLibFullPath)
 {
+    STARTUP_ZONE(StartupPhase::LoadHooks);
+
     auto lcaseLibNameA = wstring_to_string(lcaseLibName);
     LOG_TRACE("{}", lcaseLibNameA);
 
     // If Opti is not loading as nvngx.dll
-    if (!isWorkingWithEnabler && !isNvngxMode)
+    if (!isWorkingWithEnabler && !isNvngxMode && moduleKind == ModuleKind::Nvngx)
     {
         // exe path
         auto exePath = Util::ExePath().parent_path().wstring();
@@ -504,7 +434,7 @@ inline static HMODULE LoadLibraryCheckW(std::wstring lcaseLibName, LPCWSTR lpLib
 
         auto pos = lcaseLibName.rfind(exePath);
 
-        if (Config::Instance()->DlssInputs.value_or_default() && CheckDllNameW(&lcaseLibName, &nvngxNamesW) &&
+        if (Config::Instance()->DlssInputs.value_or_default() &&
             (!Config::Instance()->HookOriginalNvngxOnly.value_or_default() || pos == std::string::npos))
         {
             LOG_INFO("nvngx call: {0}, returning this dll!", lcaseLibNameA);
@@ -516,7 +446,7 @@ inline static HMODULE LoadLibraryCheckW(std::wstring lcaseLibName, LPCWSTR lpLib
         }
     }
 
-    if (lcaseLibName.ends_with(L".optidll"))
+    if (moduleKind == ModuleKind::OptiDll)
     {
         const std::wstring from = L".optidll";
         const std::wstring to = L".dll";
@@ -530,7 +460,7 @@ inline static HMODULE LoadLibraryCheckW(std::wstring lcaseLibName, LPCWSTR lpLib
         return result;
     }
 
-    if (!isNvngxMode && (!State::Instance().isDxgiMode || !State::Instance().skipDxgiLoadChecks) && CheckDllNameW(&lcaseLibName, &dllNamesW))
+    if (!isNvngxMode && (!State::Instance().isDxgiMode || !State::Instance().skipDxgiLoadChecks) && ModuleNames::IsSelf(moduleKind))
     {
         LOG_INFO("{0} call returning this dll!", lcaseLibNameA);
 
@@ -541,7 +471,7 @@ inline static HMODULE LoadLibraryCheckW(std::wstring lcaseLibName, LPCWSTR lpLib
     }
 
     // nvngx_dlss
-    if (Config::Instance()->DLSSEnabled.value_or_default() && Config::Instance()->NVNGX_DLSS_Library.has_value() && CheckDllNameW(&lcaseLibName, &nvngxDlssNamesW))
+    if (Config::Instance()->DLSSEnabled.value_or_default() && Config::Instance()->NVNGX_DLSS_Library.has_value() && moduleKind == ModuleKind::NvngxDlss)
     {
         skipLoadChecks = true;
         auto nvngxDlss = LoadNvngxDlss(lcaseLibName);
@@ -555,7 +485,7 @@ inline static HMODULE LoadLibraryCheckW(std::wstring lcaseLibName, LPCWSTR lpLib
 
     // NGX OTA
     // Try to catch something like this: c:\programdata/nvidia/ngx/models//dlss/versions/20316673/files/160_e658700.bin
-    if (lcaseLibName.ends_with(L".bin"))
+    if (moduleKind == ModuleKind::NgxBin)
     {
         skipLoadChecks = true;
         auto loadedBin = o_LoadLibraryW(lpLibFullPath);
@@ -575,7 +505,7 @@ inline static HMODULE LoadLibraryCheckW(std::wstring lcaseLibName, LPCWSTR lpLib
     }
 
     // NvApi64.dll
-    if (CheckDllNameW(&lcaseLibName, &nvapiNamesW)) {
+    if (moduleKind == ModuleKind::NvApi) {
         if (!isWorkingWithEnabler && Config::Instance()->OverrideNvapiDll.value_or_default())
         {
             LOG_INFO("{0} call!", lcaseLibNameA);
@@ -610,7 +540,7 @@ inline static HMODULE LoadLibraryCheckW(std::wstring lcaseLibName, LPCWSTR lpLib
     }
 
     // sl.interposer.dll
-    if (Config::Instance()->FGType.value_or_default() == FGType::Nukems && CheckDllNameW(&lcaseLibName, &streamlineNamesW))
+    if (Config::Instance()->FGType.value_or_default() == FGType::Nukems && moduleKind == ModuleKind::Streamline)
     {
         skipLoadChecks = true;
         auto streamlineModule = o_LoadLibraryW(lpLibFullPath);
@@ -632,7 +562,7 @@ inline static HMODULE LoadLibraryCheckW(std::wstring lcaseLibName, LPCWSTR lpLib
 
     if (Config::Instance()->FGType.value_or_default() == FGType::OptiFG)
     {
-        if (Config::Instance()->FGDisableOverlays.value_or_default() && CheckDllNameW(&lcaseLibName, &overlayNamesW))
+        if (Config::Instance()->FGDisableOverlays.value_or_default() && moduleKind == ModuleKind::Overlay)
         {
             LOG_DEBUG("Trying to load overlay dll: {}", lcaseLibNameA);
             return (HMODULE)1;
@@ -640,69 +570,53 @@ inline static HMODULE LoadLibraryCheckW(std::wstring lcaseLibName, LPCWSTR lpLib
     }
 
     // Hooks
-    if (CheckDllNameW(&lcaseLibName, &dx11NamesW) && Config::Instance()->OverlayMenu.value_or_default())
+    if (moduleKind == ModuleKind::Dx11 && Config::Instance()->OverlayMenu.value_or_default())
     {
         skipLoadChecks = true;
         auto module = o_LoadLibraryW(lcaseLibName.c_str());
         skipLoadChecks = false;
 
         if (module != nullptr)
-            HooksDx::HookDx11(module);
+            InstallModuleHooks(ModuleKind::Dx11, module);
 
         return module;
     }
 
-    if (CheckDllNameW(&lcaseLibName, &dx12NamesW) && Config::Instance()->OverlayMenu.value_or_default())
+    if (moduleKind == ModuleKind::Dx12 && Config::Instance()->OverlayMenu.value_or_default())
     {
         skipLoadChecks = true;
         auto module = o_LoadLibraryW(lcaseLibName.c_str());
         skipLoadChecks = false;
 
         if (module != nullptr)
-            HooksDx::HookDx12(module);
+            InstallModuleHooks(ModuleKind::Dx12, module);
 
         return module;
     }
 
-    if (CheckDllNameW(&lcaseLibName, &vkNamesW))
+    if (moduleKind == ModuleKind::Vulkan)
     {
         skipLoadChecks = true;
         auto module = o_LoadLibraryW(lcaseLibName.c_str());
         skipLoadChecks = false;
 
         if (module != nullptr)
-        {
-            if (!isWorkingWithEnabler)
-            {
-                HookForVulkanSpoofing(module);
-                HookForVulkanExtensionSpoofing(module);
-                HookForVulkanVRAMSpoofing(module);
-            }
-
-            if (Config::Instance()->OverlayMenu.value_or_default())
-                HooksVk::HookVk(module);
-        }
+            InstallModuleHooks(ModuleKind::Vulkan, module);
 
         return module;
     }
 
-    if (!State::Instance().skipDxgiLoadChecks && CheckDllNameW(&lcaseLibName, &dxgiNamesW))
+    if (!State::Instance().skipDxgiLoadChecks && moduleKind == ModuleKind::Dxgi)
     {
         skipLoadChecks = true;
         auto module = o_LoadLibraryW(lcaseLibName.c_str());
         skipLoadChecks = false;
 
         if (module != nullptr)
-        {
-            if (!isWorkingWithEnabler)
-                HookForDxgiSpoofing(module);
-
-            if (Config::Instance()->OverlayMenu.value_or_default()/* && !State::Instance().isRunningOnLinux*/)
-                HooksDx::HookDxgi(module);
-        }
+            InstallModuleHooks(ModuleKind::Dxgi, module);
     }
 
-    if (CheckDllNameW(&lcaseLibName, &fsr2NamesW))
+    if (moduleKind == ModuleKind::Fsr2)
     {
         skipLoadChecks = true;
         auto module = o_LoadLibraryW(lcaseLibName.c_str());
@@ -714,7 +628,7 @@ inline static HMODULE LoadLibraryCheckW(std::wstring lcaseLibName, LPCWSTR lpLib
         return module;
     }
 
-    if (CheckDllNameW(&lcaseLibName, &fsr2BENamesW))
+    if (moduleKind == ModuleKind::Fsr2Dx12)
     {
         skipLoadChecks = true;
         auto module = o_LoadLibraryW(lcaseLibName.c_str());
@@ -726,7 +640,7 @@ inline static HMODULE LoadLibraryCheckW(std::wstring lcaseLibName, LPCWSTR lpLib
         return module;
     }
 
-    if (CheckDllNameW(&lcaseLibName, &fsr3NamesW))
+    if (moduleKind == ModuleKind::Fsr3)
     {
         skipLoadChecks = true;
         auto module = o_LoadLibraryW(lcaseLibName.c_str());
@@ -738,7 +652,7 @@ inline static HMODULE LoadLibraryCheckW(std::wstring lcaseLibName, LPCWSTR lpLib
         return module;
     }
 
-    if (CheckDllNameW(&lcaseLibName, &fsr3BENamesW))
+    if (moduleKind == ModuleKind::Fsr3Dx12)
     {
         skipLoadChecks = true;
         auto module = o_LoadLibraryW(lcaseLibName.c_str());
@@ -750,7 +664,7 @@ inline static HMODULE LoadLibraryCheckW(std::wstring lcaseLibName, LPCWSTR lpLib
         return module;
     }
 
-    if (CheckDllNameW(&lcaseLibName, &xessNamesW))
+    if (moduleKind == ModuleKind::XeSS)
     {
         skipLoadChecks = true;
         auto module = o_LoadLibraryW(lcaseLibName.c_str());
@@ -762,7 +676,7 @@ inline static HMODULE LoadLibraryCheckW(std::wstring lcaseLibName, LPCWSTR lpLib
         return module;
     }
 
-    if (CheckDllNameW(&lcaseLibName, &ffxDx12NamesW))
+    if (moduleKind == ModuleKind::FfxDx12)
     {
         skipLoadChecks = true;
         auto module = o_LoadLibraryW(lcaseLibName.c_str());
@@ -774,7 +688,7 @@ inline static HMODULE LoadLibraryCheckW(std::wstring lcaseLibName, LPCWSTR lpLib
         return module;
     }
 
-    if (CheckDllNameW(&lcaseLibName, &ffxVkNamesW))
+    if (moduleKind == ModuleKind::FfxVk)
     {
         skipLoadChecks = true;
         auto module = o_LoadLibraryW(lcaseLibName.c_str());
@@ -867,9 +781,18 @@ static HMODULE LoadNvngxDlss(std::wstring originalPath)
 
 static void CheckForGPU()
 {
+    STARTUP_ZONE(StartupPhase::GpuDetection);
+
     if (Config::Instance()->Fsr4Update.has_value())
         return;
 
+    if (auto cached = StartupCache::Fsr4Update(); cached.has_value())
+    {
+        Config::Instance()->Fsr4Update = cached.value();
+        LOG_INFO("Fsr4Update: {} (cached)", cached.value());
+        return;
+    }
+
     bool loaded = false;
 
     HMODULE dxgiModule = nullptr;
@@ -926,24 +849,10 @@ static void CheckForGPU()
         result = adapter->GetDesc(&adapterDesc);
         State::Instance().skipSpoofing = false;
 
-        if (result == S_OK && adapterDesc.VendorId != 0x00001414)
-        {
-            std::wstring szName(adapterDesc.Description);
-            std::string descStr = std::format("Adapter: {}, VRAM: {} MB", wstring_to_string(szName), adapterDesc.DedicatedVideoMemory / (1024 * 1024));
-            LOG_INFO("{}", descStr);
-
-            // If GPU is AMD
-            if (adapterDesc.VendorId == 0x1002)
-            {
-                // If GPU Name contains 90XX always set it to true
-                if (szName.find(L" 90") != std::wstring::npos || szName.find(L" GFX12") != std::wstring::npos)
-                    Config::Instance()->Fsr4Update = true;
-            }
-        }
+        if (result == S_OK)
+            AdapterTable::Register(&adapterDesc);
         else
-        {
             LOG_DEBUG("Can't get description of adapter: {}", adapterIndex);
-        }
 
         adapter->Release();
         adapter = nullptr;
@@ -961,9 +870,22 @@ static void CheckForGPU()
             FreeLibrary(dxgiModule);
     }
 
+    for (auto& adapter : AdapterTable::Adapters())
+    {
+        // If GPU is AMD
+        if (adapter.VendorId == 0x1002)
+        {
+            // If GPU Name contains 90XX always set it to true
+            if (adapter.Description.find(L" 90") != std::wstring::npos || adapter.Description.find(L" GFX12") != std::wstring::npos)
+                Config::Instance()->Fsr4Update = true;
+        }
+    }
+
     if (!Config::Instance()->Fsr4Update.has_value())
         Config::Instance()->Fsr4Update = false;
 
+    StartupCache::SetFsr4Update(Config::Instance()->Fsr4Update.value_or_default());
+
     LOG_INFO("Fsr4Update: {}", Config::Instance()->Fsr4Update.value_or_default());
 }
 
@@ -1073,7 +995,7 @@ static HMODULE hkGetModuleHandleA(LPCSTR lpModuleName)
 #ifdef GET_MODULE_DLL
 
         // Opti 
-        if (CheckDllName(&lcaseLibName, &dllNames))
+        if (ModuleNames::IsSelf(ModuleNames::Classify(lpModuleName)))
         {
             LOG_INFO("{0} call, returning this dll!", libName);
             return dllModule;
@@ -1123,7 +1045,7 @@ static HMODULE hkGetModuleHandleW(LPCWSTR lpModuleName)
 #ifdef GET_MODULE_DLL
 
         // Opti 
-        if (CheckDllNameW(&lcaseLibName, &dllNamesW))
+        if (ModuleNames::IsSelf(ModuleNames::Classify(lpModuleName)))
         {
             LOG_INFO("{0} call, returning this dll!", lcaseLibNameA);
             return dllModule;
@@ -1174,7 +1096,7 @@ static BOOL hkGetModuleHandleExA(DWORD dwFlags, LPCSTR lpModuleName, HMODULE* ph
 #ifdef GET_MODULE_DLL
 
         // Opti 
-        if (CheckDllName(&lcaseLibName, &dllNames))
+        if (ModuleNames::IsSelf(ModuleNames::Classify(lpModuleName)))
         {
             LOG_INFO("{0} call, returning this dll!", libName);
             *phModule = dllModule;
@@ -1230,7 +1152,7 @@ static BOOL hkGetModuleHandleExW(DWORD dwFlags, LPCWSTR lpModuleName, HMODULE* p
 #ifdef GET_MODULE_DLL
 
         // Opti 
-        if (CheckDllNameW(&lcaseLibName, &dllNamesW))
+        if (ModuleNames::IsSelf(ModuleNames::Classify(lpModuleName)))
         {
             LOG_INFO("{0} call, returning this dll!", lcaseLibNameA);
             *phModule = dllModule;
@@ -1274,27 +1196,32 @@ static HMODULE hkLoadLibraryA(LPCSTR lpLibFileName)
 
     if (!skipLoadChecks)
     {
-        std::string libName(lpLibFileName);
-        std::string lcaseLibName(libName);
-
-        for (size_t i = 0; i < lcaseLibName.size(); i++)
-            lcaseLibName[i] = std::tolower(lcaseLibName[i]);
-
 #ifdef _DEBUG
-        LOG_TRACE("call: {0}", lcaseLibName);
+        LOG_TRACE("call: {0}", lpLibFileName);
 #endif // DEBUG
 
-        auto moduleHandle = LoadLibraryCheck(lcaseLibName, lpLibFileName);
+        auto moduleKind = ModuleNames::Classify(lpLibFileName);
 
-        // skip loading of dll
-        if (moduleHandle == (HMODULE)1)
+        // Most calls are for unrelated dlls, only known ones need a lower case copy
+        if (moduleKind != ModuleKind::Unknown)
         {
-            SetLastError(ERROR_ACCESS_DENIED);
-            return NULL;
-        }
+            std::string lcaseLibName(lpLibFileName);
+
+            for (size_t i = 0; i < lcaseLibName.size(); i++)
+                lcaseLibName[i] = std::tolower(lcaseLibName[i]);
+
+            auto moduleHandle = LoadLibraryCheck(moduleKind, lcaseLibName, lpLibFileName);
+
+            // skip loading of dll
+            if (moduleHandle == (HMODULE)1)
+            {
+                SetLastError(ERROR_ACCESS_DENIED);
+                return NULL;
+            }
 
-        if (moduleHandle != nullptr)
-            return moduleHandle;
+            if (moduleHandle != nullptr)
+                return moduleHandle;
+        }
     }
 
     dontCount = true;
@@ -1311,27 +1238,32 @@ static HMODULE hkLoadLibraryW(LPCWSTR lpLibFileName)
 
     if (!skipLoadChecks)
     {
-        std::wstring libName(lpLibFileName);
-        std::wstring lcaseLibName(libName);
-
-        for (size_t i = 0; i < lcaseLibName.size(); i++)
-            lcaseLibName[i] = std::tolower(lcaseLibName[i]);
-
 #ifdef _DEBUG
-        LOG_TRACE("call: {0}", wstring_to_string(lcaseLibName));
+        LOG_TRACE("call: {0}", wstring_to_string(lpLibFileName));
 #endif // DEBUG
 
-        auto moduleHandle = LoadLibraryCheckW(lcaseLibName, lpLibFileName);
+        auto moduleKind = ModuleNames::Classify(lpLibFileName);
 
-        // skip loading of dll
-        if (moduleHandle == (HMODULE)1)
+        // Most calls are for unrelated dlls, only known ones need a lower case copy
+        if (moduleKind != ModuleKind::Unknown)
         {
-            SetLastError(ERROR_ACCESS_DENIED);
-            return NULL;
-        }
+            std::wstring lcaseLibName(lpLibFileName);
+
+            for (size_t i = 0; i < lcaseLibName.size(); i++)
+                lcaseLibName[i] = std::tolower(lcaseLibName[i]);
 
-        if (moduleHandle != nullptr)
-            return moduleHandle;
+            auto moduleHandle = LoadLibraryCheckW(moduleKind, lcaseLibName, lpLibFileName);
+
+            // skip loading of dll
+            if (moduleHandle == (HMODULE)1)
+            {
+                SetLastError(ERROR_ACCESS_DENIED);
+                return NULL;
+            }
+
+            if (moduleHandle != nullptr)
+                return moduleHandle;
+        }
     }
 
     dontCount = true;
@@ -1348,27 +1280,32 @@ static HMODULE hkLoadLibraryExA(LPCSTR lpLibFileName, HANDLE hFile, DWORD dwFlag
 
     if (!skipLoadChecks)
     {
-        std::string libName(lpLibFileName);
-        std::string lcaseLibName(libName);
-
-        for (size_t i = 0; i < lcaseLibName.size(); i++)
-            lcaseLibName[i] = std::tolower(lcaseLibName[i]);
-
 #ifdef _DEBUG
-        LOG_TRACE("call: {0}", lcaseLibName);
+        LOG_TRACE("call: {0}", lpLibFileName);
 #endif
 
-        auto moduleHandle = LoadLibraryCheck(lcaseLibName, lpLibFileName);
+        auto moduleKind = ModuleNames::Classify(lpLibFileName);
 
-        // skip loading of dll
-        if (moduleHandle == (HMODULE)1)
+        // Most calls are for unrelated dlls, only known ones need a lower case copy
+        if (moduleKind != ModuleKind::Unknown)
         {
-            SetLastError(ERROR_ACCESS_DENIED);
-            return NULL;
-        }
+            std::string lcaseLibName(lpLibFileName);
 
-        if (moduleHandle != nullptr)
-            return moduleHandle;
+            for (size_t i = 0; i < lcaseLibName.size(); i++)
+                lcaseLibName[i] = std::tolower(lcaseLibName[i]);
+
+            auto moduleHandle = LoadLibraryCheck(moduleKind, lcaseLibName, lpLibFileName);
+
+            // skip loading of dll
+            if (moduleHandle == (HMODULE)1)
+            {
+                SetLastError(ERROR_ACCESS_DENIED);
+                return NULL;
+            }
+
+            if (moduleHandle != nullptr)
+                return moduleHandle;
+        }
     }
 
     dontCount = true;
@@ -1385,27 +1322,32 @@ static HMODULE hkLoadLibraryExW(LPCWSTR lpLibFileName, HANDLE hFile, DWORD dwFla
 
     if (!skipLoadChecks)
     {
-        std::wstring libName(lpLibFileName);
-        std::wstring lcaseLibName(libName);
-
-        for (size_t i = 0; i < lcaseLibName.size(); i++)
-            lcaseLibName[i] = std::tolower(lcaseLibName[i]);
-
 #ifdef _DEBUG
-        LOG_TRACE("call: {0}", wstring_to_string(lcaseLibName));
+        LOG_TRACE("call: {0}", wstring_to_string(lpLibFileName));
 #endif
 
-        auto moduleHandle = LoadLibraryCheckW(lcaseLibName, lpLibFileName);
+        auto moduleKind = ModuleNames::Classify(lpLibFileName);
 
-        // skip loading of dll
-        if (moduleHandle == (HMODULE)1)
+        // Most calls are for unrelated dlls, only known ones need a lower case copy
+        if (moduleKind != ModuleKind::Unknown)
         {
-            SetLastError(ERROR_ACCESS_DENIED);
-            return NULL;
-        }
+            std::wstring lcaseLibName(lpLibFileName);
+
+            for (size_t i = 0; i < lcaseLibName.size(); i++)
+                lcaseLibName[i] = std::tolower(lcaseLibName[i]);
+
+            auto moduleHandle = LoadLibraryCheckW(moduleKind, lcaseLibName, lpLibFileName);
 
-        if (moduleHandle != nullptr)
-            return moduleHandle;
+            // skip loading of dll
+            if (moduleHandle == (HMODULE)1)
+            {
+                SetLastError(ERROR_ACCESS_DENIED);
+                return NULL;
+            }
+
+            if (moduleHandle != nullptr)
+                return moduleHandle;
+        }
     }
 
     dontCount = true;
@@ -1422,27 +1364,32 @@ static HMODULE hkKernelBase_LoadLibraryA(LPCSTR lpLibFileName)
 
     if (!skipLoadChecks)
     {
-        std::string libName(lpLibFileName);
-        std::string lcaseLibName(libName);
-
-        for (size_t i = 0; i < lcaseLibName.size(); i++)
-            lcaseLibName[i] = std::tolower(lcaseLibName[i]);
-
 #ifdef _DEBUG
-        LOG_TRACE("call: {0}", lcaseLibName);
+        LOG_TRACE("call: {0}", lpLibFileName);
 #endif // DEBUG
 
-        auto moduleHandle = LoadLibraryCheck(lcaseLibName, lpLibFileName);
+        auto moduleKind = ModuleNames::Classify(lpLibFileName);
 
-        // skip loading of dll
-        if (moduleHandle == (HMODULE)1)
+        // Most calls are for unrelated dlls, only known ones need a lower case copy
+        if (moduleKind != ModuleKind::Unknown)
         {
-            SetLastError(ERROR_ACCESS_DENIED);
-            return NULL;
-        }
+            std::string lcaseLibName(lpLibFileName);
+
+            for (size_t i = 0; i < lcaseLibName.size(); i++)
+                lcaseLibName[i] = std::tolower(lcaseLibName[i]);
+
+            auto moduleHandle = LoadLibraryCheck(moduleKind, lcaseLibName, lpLibFileName);
+
+            // skip loading of dll
+            if (moduleHandle == (HMODULE)1)
+            {
+                SetLastError(ERROR_ACCESS_DENIED);
+                return NULL;
+            }
 
-        if (moduleHandle != nullptr)
-            return moduleHandle;
+            if (moduleHandle != nullptr)
+                return moduleHandle;
+        }
     }
 
     dontCount = true;
@@ -1459,27 +1406,32 @@ static HMODULE hkKernelBase_LoadLibraryW(LPCWSTR lpLibFileName)
 
     if (!skipLoadChecks)
     {
-        std::wstring libName(lpLibFileName);
-        std::wstring lcaseLibName(libName);
-
-        for (size_t i = 0; i < lcaseLibName.size(); i++)
-            lcaseLibName[i] = std::tolower(lcaseLibName[i]);
-
 #ifdef _DEBUG
-        LOG_TRACE("call: {0}", wstring_to_string(lcaseLibName));
+        LOG_TRACE("call: {0}", wstring_to_string(lpLibFileName));
 #endif // DEBUG
 
-        auto moduleHandle = LoadLibraryCheckW(lcaseLibName, lpLibFileName);
+        auto moduleKind = ModuleNames::Classify(lpLibFileName);
 
-        // skip loading of dll
-        if (moduleHandle == (HMODULE)1)
+        // Most calls are for unrelated dlls, only known ones need a lower case copy
+        if (moduleKind != ModuleKind::Unknown)
         {
-            SetLastError(ERROR_ACCESS_DENIED);
-            return NULL;
-        }
+            std::wstring lcaseLibName(lpLibFileName);
 
-        if (moduleHandle != nullptr)
-            return moduleHandle;
+            for (size_t i = 0; i < lcaseLibName.size(); i++)
+                lcaseLibName[i] = std::tolower(lcaseLibName[i]);
+
+            auto moduleHandle = LoadLibraryCheckW(moduleKind, lcaseLibName, lpLibFileName);
+
+            // skip loading of dll
+            if (moduleHandle == (HMODULE)1)
+            {
+                SetLastError(ERROR_ACCESS_DENIED);
+                return NULL;
+            }
+
+            if (moduleHandle != nullptr)
+                return moduleHandle;
+        }
     }
 
     dontCount = true;
@@ -1496,27 +1448,32 @@ static HMODULE hkKernelBase_LoadLibraryExA(LPCSTR lpLibFileName, HANDLE hFile, D
 
     if (!skipLoadChecks)
     {
-        std::string libName(lpLibFileName);
-        std::string lcaseLibName(libName);
-
-        for (size_t i = 0; i < lcaseLibName.size(); i++)
-            lcaseLibName[i] = std::tolower(lcaseLibName[i]);
-
 #ifdef _DEBUG
-        LOG_TRACE("call: {0}", lcaseLibName);
+        LOG_TRACE("call: {0}", lpLibFileName);
 #endif
 
-        auto moduleHandle = LoadLibraryCheck(lcaseLibName, lpLibFileName);
+        auto moduleKind = ModuleNames::Classify(lpLibFileName);
 
-        // skip loading of dll
-        if (moduleHandle == (HMODULE)1)
+        // Most calls are for unrelated dlls, only known ones need a lower case copy
+        if (moduleKind != ModuleKind::Unknown)
         {
-            SetLastError(ERROR_ACCESS_DENIED);
-            return NULL;
-        }
+            std::string lcaseLibName(lpLibFileName);
+
+            for (size_t i = 0; i < lcaseLibName.size(); i++)
+                lcaseLibName[i] = std::tolower(lcaseLibName[i]);
+
+            auto moduleHandle = LoadLibraryCheck(moduleKind, lcaseLibName, lpLibFileName);
 
-        if (moduleHandle != nullptr)
-            return moduleHandle;
+            // skip loading of dll
+            if (moduleHandle == (HMODULE)1)
+            {
+                SetLastError(ERROR_ACCESS_DENIED);
+                return NULL;
+            }
+
+            if (moduleHandle != nullptr)
+                return moduleHandle;
+        }
     }
 
     dontCount = true;
@@ -1533,27 +1490,32 @@ static HMODULE hkKernelBase_LoadLibraryExW(LPCWSTR lpLibFileName, HANDLE hFile,
 
     if (!skipLoadChecks)
     {
-        std::wstring libName(lpLibFileName);
-        std::wstring lcaseLibName(libName);
-
-        for (size_t i = 0; i < lcaseLibName.size(); i++)
-            lcaseLibName[i] = std::tolower(lcaseLibName[i]);
-
 #ifdef _DEBUG
-        LOG_TRACE("call: {0}", wstring_to_string(lcaseLibName));
+        LOG_TRACE("call: {0}", wstring_to_string(lpLibFileName));
 #endif
 
-        auto moduleHandle = LoadLibraryCheckW(lcaseLibName, lpLibFileName);
+        auto moduleKind = ModuleNames::Classify(lpLibFileName);
 
-        // skip loading of dll
-        if (moduleHandle == (HMODULE)1)
+        // Most calls are for unrelated dlls, only known ones need a lower case copy
+        if (moduleKind != ModuleKind::Unknown)
         {
-            SetLastError(ERROR_ACCESS_DENIED);
-            return NULL;
-        }
+            std::wstring lcaseLibName(lpLibFileName);
+
+            for (size_t i = 0; i < lcaseLibName.size(); i++)
+                lcaseLibName[i] = std::tolower(lcaseLibName[i]);
+
+            auto moduleHandle = LoadLibraryCheckW(moduleKind, lcaseLibName, lpLibFileName);
 
-        if (moduleHandle != nullptr)
-            return moduleHandle;
+            // skip loading of dll
+            if (moduleHandle == (HMODULE)1)
+            {
+                SetLastError(ERROR_ACCESS_DENIED);
+                return NULL;
+            }
+
+            if (moduleHandle != nullptr)
+                return moduleHandle;
+        }
     }
 
     dontCount = true;
@@ -1921,127 +1883,41 @@ static VkResult hkvkEnumerateInstanceExtensionProperties(const char* pLayerName,
 
 #pragma endregion
 
-inline static void HookForDxgiSpoofing(HMODULE dxgiModule)
+// Spoofing hooks are declared before overlay menu hooks, when both hook same export menu's detour is called first
+static void DeclareSpoofingHooks()
 {
     // hook dxgi when not working as dxgi.dll
-    if (dxgi.CreateDxgiFactory == nullptr && !isWorkingWithEnabler && !State::Instance().isDxgiMode && Config::Instance()->DxgiSpoofing.value_or_default())
-    {
-        LOG_INFO("DxgiSpoofing is enabled loading dxgi.dll");
+    auto dxgiSpoofing = []() { return !isWorkingWithEnabler && !State::Instance().isDxgiMode && Config::Instance()->DxgiSpoofing.value_or_default(); };
 
-        dxgi.CreateDxgiFactory = (PFN_CREATE_DXGI_FACTORY)GetProcAddress(dxgiModule, "CreateDXGIFactory");
-        dxgi.CreateDxgiFactory1 = (PFN_CREATE_DXGI_FACTORY_1)GetProcAddress(dxgiModule, "CreateDXGIFactory1");
-        dxgi.CreateDxgiFactory2 = (PFN_CREATE_DXGI_FACTORY_2)GetProcAddress(dxgiModule, "CreateDXGIFactory2");
+    DECLARE_HOOK(ModuleKind::Dxgi, "CreateDXGIFactory", dxgi.CreateDxgiFactory, _CreateDXGIFactory, dxgiSpoofing);
+    DECLARE_HOOK(ModuleKind::Dxgi, "CreateDXGIFactory1", dxgi.CreateDxgiFactory1, _CreateDXGIFactory1, dxgiSpoofing);
+    DECLARE_HOOK(ModuleKind::Dxgi, "CreateDXGIFactory2", dxgi.CreateDxgiFactory2, _CreateDXGIFactory2, dxgiSpoofing);
 
-        if (dxgi.CreateDxgiFactory != nullptr || dxgi.CreateDxgiFactory1 != nullptr || dxgi.CreateDxgiFactory2 != nullptr)
-        {
-            LOG_INFO("dxgi.dll found, hooking CreateDxgiFactory methods");
+    auto vulkanSpoofing = []() { return !isNvngxMode && !isWorkingWithEnabler && Config::Instance()->VulkanSpoofing.value_or_default(); };
 
-            DetourTransactionBegin();
-            DetourUpdateThread(GetCurrentThread());
+    DECLARE_HOOK(ModuleKind::Vulkan, "vkGetPhysicalDeviceProperties", o_vkGetPhysicalDeviceProperties, hkvkGetPhysicalDeviceProperties, vulkanSpoofing);
+    DECLARE_HOOK(ModuleKind::Vulkan, "vkGetPhysicalDeviceProperties2", o_vkGetPhysicalDeviceProperties2, hkvkGetPhysicalDeviceProperties2, vulkanSpoofing);
+    DECLARE_HOOK(ModuleKind::Vulkan, "vkGetPhysicalDeviceProperties2KHR", o_vkGetPhysicalDeviceProperties2KHR, hkvkGetPhysicalDeviceProperties2KHR, vulkanSpoofing);
 
-            if (dxgi.CreateDxgiFactory != nullptr)
-                DetourAttach(&(PVOID&)dxgi.CreateDxgiFactory, _CreateDXGIFactory);
+    auto extensionSpoofing = []() { return !isNvngxMode && !isWorkingWithEnabler && Config::Instance()->VulkanExtensionSpoofing.value_or_default(); };
 
-            if (dxgi.CreateDxgiFactory1 != nullptr)
-                DetourAttach(&(PVOID&)dxgi.CreateDxgiFactory1, _CreateDXGIFactory1);
+    DECLARE_HOOK(ModuleKind::Vulkan, "vkEnumerateInstanceExtensionProperties", o_vkEnumerateInstanceExtensionProperties, hkvkEnumerateInstanceExtensionProperties, extensionSpoofing);
+    DECLARE_HOOK(ModuleKind::Vulkan, "vkEnumerateDeviceExtensionProperties", o_vkEnumerateDeviceExtensionProperties, hkvkEnumerateDeviceExtensionProperties, extensionSpoofing);
+    DECLARE_HOOK(ModuleKind::Vulkan, "vkCreateDevice", o_vkCreateDevice, hkvkCreateDevice, extensionSpoofing);
+    DECLARE_HOOK(ModuleKind::Vulkan, "vkCreateInstance", o_vkCreateInstance, hkvkCreateInstance, extensionSpoofing);
 
-            if (dxgi.CreateDxgiFactory2 != nullptr)
-                DetourAttach(&(PVOID&)dxgi.CreateDxgiFactory2, _CreateDXGIFactory2);
+    auto vramSpoofing = []() { return !isNvngxMode && !isWorkingWithEnabler && Config::Instance()->VulkanVRAM.has_value(); };
 
-            DetourTransactionCommit();
-        }
-    }
+    DECLARE_HOOK(ModuleKind::Vulkan, "vkGetPhysicalDeviceMemoryProperties", o_vkGetPhysicalDeviceMemoryProperties, hkvkGetPhysicalDeviceMemoryProperties, vramSpoofing);
+    DECLARE_HOOK(ModuleKind::Vulkan, "vkGetPhysicalDeviceMemoryProperties2", o_vkGetPhysicalDeviceMemoryProperties2, hkvkGetPhysicalDeviceMemoryProperties2, vramSpoofing);
+    DECLARE_HOOK(ModuleKind::Vulkan, "vkGetPhysicalDeviceMemoryProperties2KHR", o_vkGetPhysicalDeviceMemoryProperties2KHR, hkvkGetPhysicalDeviceMemoryProperties2KHR, vramSpoofing);
 }
 
-inline static void HookForVulkanSpoofing(HMODULE vulkanModule)
+inline static void InstallModuleHooks(ModuleKind moduleKind, HMODULE module)
 {
-    if (!isNvngxMode && Config::Instance()->VulkanSpoofing.value_or_default() && o_vkGetPhysicalDeviceProperties == nullptr)
-    {
-        o_vkGetPhysicalDeviceProperties = reinterpret_cast<PFN_vkGetPhysicalDeviceProperties>(GetProcAddress(vulkanModule, "vkGetPhysicalDeviceProperties"));
-        o_vkGetPhysicalDeviceProperties2 = reinterpret_cast<PFN_vkGetPhysicalDeviceProperties2>(GetProcAddress(vulkanModule, "vkGetPhysicalDeviceProperties2"));
-        o_vkGetPhysicalDeviceProperties2KHR = reinterpret_cast<PFN_vkGetPhysicalDeviceProperties2KHR>(GetProcAddress(vulkanModule, "vkGetPhysicalDeviceProperties2KHR"));
-
-        if (o_vkGetPhysicalDeviceProperties != nullptr)
-        {
-            LOG_INFO("Attaching Vulkan device spoofing hooks");
+    STARTUP_ZONE(StartupPhase::ModuleHooks);
 
-            DetourTransactionBegin();
-            DetourUpdateThread(GetCurrentThread());
-
-            if (o_vkGetPhysicalDeviceProperties)
-                DetourAttach(&(PVOID&)o_vkGetPhysicalDeviceProperties, hkvkGetPhysicalDeviceProperties);
-
-            if (o_vkGetPhysicalDeviceProperties2)
-                DetourAttach(&(PVOID&)o_vkGetPhysicalDeviceProperties2, hkvkGetPhysicalDeviceProperties2);
-
-            if (o_vkGetPhysicalDeviceProperties2KHR)
-                DetourAttach(&(PVOID&)o_vkGetPhysicalDeviceProperties2KHR, hkvkGetPhysicalDeviceProperties2KHR);
-
-            DetourTransactionCommit();
-        }
-    }
-}
-
-inline static void HookForVulkanExtensionSpoofing(HMODULE vulkanModule)
-{
-    if (!isNvngxMode && Config::Instance()->VulkanExtensionSpoofing.value_or_default() && o_vkEnumerateInstanceExtensionProperties == nullptr)
-    {
-        o_vkCreateDevice = reinterpret_cast<PFN_vkCreateDevice>(GetProcAddress(vulkanModule, "vkCreateDevice"));
-        o_vkCreateInstance = reinterpret_cast<PFN_vkCreateInstance>(GetProcAddress(vulkanModule, "vkCreateInstance"));
-        o_vkEnumerateInstanceExtensionProperties = reinterpret_cast<PFN_vkEnumerateInstanceExtensionProperties>(GetProcAddress(vulkanModule, "vkEnumerateInstanceExtensionProperties"));
-        o_vkEnumerateDeviceExtensionProperties = reinterpret_cast<PFN_vkEnumerateDeviceExtensionProperties>(GetProcAddress(vulkanModule, "vkEnumerateDeviceExtensionProperties"));
-
-        if (o_vkEnumerateInstanceExtensionProperties != nullptr || o_vkEnumerateDeviceExtensionProperties != nullptr)
-        {
-            LOG_INFO("Attaching Vulkan extensions spoofing hooks");
-
-            DetourTransactionBegin();
-            DetourUpdateThread(GetCurrentThread());
-
-            if (o_vkEnumerateInstanceExtensionProperties)
-                DetourAttach(&(PVOID&)o_vkEnumerateInstanceExtensionProperties, hkvkEnumerateInstanceExtensionProperties);
-
-            if (o_vkEnumerateDeviceExtensionProperties)
-                DetourAttach(&(PVOID&)o_vkEnumerateDeviceExtensionProperties, hkvkEnumerateDeviceExtensionProperties);
-
-            if (o_vkCreateDevice)
-                DetourAttach(&(PVOID&)o_vkCreateDevice, hkvkCreateDevice);
-
-            if (o_vkCreateInstance)
-                DetourAttach(&(PVOID&)o_vkCreateInstance, hkvkCreateInstance);
-
-            DetourTransactionCommit();
-        }
-    }
-}
-
-inline static void HookForVulkanVRAMSpoofing(HMODULE vulkanModule)
-{
-    if (!isNvngxMode && Config::Instance()->VulkanVRAM.has_value() && o_vkGetPhysicalDeviceMemoryProperties == nullptr)
-    {
-        o_vkGetPhysicalDeviceMemoryProperties = reinterpret_cast<PFN_vkGetPhysicalDeviceMemoryProperties>(GetProcAddress(vulkanModule, "vkGetPhysicalDeviceMemoryProperties"));
-        o_vkGetPhysicalDeviceMemoryProperties2 = reinterpret_cast<PFN_vkGetPhysicalDeviceMemoryProperties2>(GetProcAddress(vulkanModule, "vkGetPhysicalDeviceMemoryProperties2"));
-        o_vkGetPhysicalDeviceMemoryProperties2KHR = reinterpret_cast<PFN_vkGetPhysicalDeviceMemoryProperties2KHR>(GetProcAddress(vulkanModule, "vkGetPhysicalDeviceMemoryProperties2KHR"));
-
-        if (o_vkGetPhysicalDeviceMemoryProperties != nullptr || o_vkGetPhysicalDeviceMemoryProperties2 != nullptr || o_vkGetPhysicalDeviceMemoryProperties2KHR != nullptr)
-        {
-            LOG_INFO("Attaching Vulkan VRAM spoofing hooks");
-
-            DetourTransactionBegin();
-            DetourUpdateThread(GetCurrentThread());
-
-            if (o_vkGetPhysicalDeviceMemoryProperties)
-                DetourAttach(&(PVOID&)o_vkGetPhysicalDeviceMemoryProperties, hkvkGetPhysicalDeviceMemoryProperties);
-
-            if (o_vkGetPhysicalDeviceMemoryProperties2)
-                DetourAttach(&(PVOID&)o_vkGetPhysicalDeviceMemoryProperties2, hkvkGetPhysicalDeviceMemoryProperties2);
-
-            if (o_vkGetPhysicalDeviceMemoryProperties2KHR)
-                DetourAttach(&(PVOID&)o_vkGetPhysicalDeviceMemoryProperties2KHR, hkvkGetPhysicalDeviceMemoryProperties2KHR);
-
-            DetourTransactionCommit();
-        }
-    }
+    HookRegistry::Install(moduleKind, module);
 }
 
 static void DetachHooks()
@@ -2052,210 +1928,51 @@ static void DetachHooks()
         HooksVk::UnHookVk();
     }
 
-    if (o_LoadLibraryA != nullptr || o_LoadLibraryW != nullptr || o_LoadLibraryExA != nullptr || o_LoadLibraryExW != nullptr)
-    {
-        DetourTransactionBegin();
-
-        DetourUpdateThread(GetCurrentThread());
-
-        if (o_FreeLibrary)
-        {
-            DetourDetach(&(PVOID&)o_FreeLibrary, hkFreeLibrary);
-            o_FreeLibrary = nullptr;
-        }
-
-        if (o_LoadLibraryA)
-        {
-            DetourDetach(&(PVOID&)o_LoadLibraryA, hkLoadLibraryA);
-            o_LoadLibraryA = nullptr;
-        }
-
-        if (o_LoadLibraryW)
-        {
-            DetourDetach(&(PVOID&)o_LoadLibraryW, hkLoadLibraryW);
-            o_LoadLibraryW = nullptr;
-        }
-
-        if (o_LoadLibraryExA)
-        {
-            DetourDetach(&(PVOID&)o_LoadLibraryExA, hkLoadLibraryExA);
-            o_LoadLibraryExA = nullptr;
-        }
+    bool loadLibraryHooked = o_LoadLibraryA != nullptr || o_LoadLibraryW != nullptr || o_LoadLibraryExA != nullptr || o_LoadLibraryExW != nullptr;
 
-        if (o_LoadLibraryExW)
-        {
-            DetourDetach(&(PVOID&)o_LoadLibraryExW, hkLoadLibraryExW);
-            o_LoadLibraryExW = nullptr;
-        }
-
-        if (o_GetProcAddress)
-        {
-            DetourDetach(&(PVOID&)o_GetProcAddress, hkGetProcAddress);
-            o_GetProcAddress = nullptr;
-        }
-
-        if (o_KernelBase_GetProcAddress)
-        {
-            DetourDetach(&(PVOID&)o_KernelBase_GetProcAddress, hkGetProcAddress);
-            o_KernelBase_GetProcAddress = nullptr;
-        }
-
-        if (o_vkGetPhysicalDeviceProperties)
-        {
-            DetourDetach(&(PVOID&)o_vkGetPhysicalDeviceProperties, hkvkGetPhysicalDeviceProperties);
-            o_vkGetPhysicalDeviceProperties = nullptr;
-        }
-
-        if (o_vkGetPhysicalDeviceProperties2)
-        {
-            DetourDetach(&(PVOID&)o_vkGetPhysicalDeviceProperties2, hkvkGetPhysicalDeviceProperties2);
-            o_vkGetPhysicalDeviceProperties2 = nullptr;
-        }
-
-        if (o_vkGetPhysicalDeviceProperties2KHR)
-        {
-            DetourDetach(&(PVOID&)o_vkGetPhysicalDeviceProperties2KHR, hkvkGetPhysicalDeviceProperties2KHR);
-            o_vkGetPhysicalDeviceProperties2KHR = nullptr;
-        }
-
-        if (o_vkEnumerateInstanceExtensionProperties)
-        {
-            DetourDetach(&(PVOID&)o_vkEnumerateInstanceExtensionProperties, hkvkEnumerateInstanceExtensionProperties);
-            o_vkEnumerateInstanceExtensionProperties = nullptr;
-        }
-
-        if (o_vkEnumerateDeviceExtensionProperties)
-        {
-            DetourDetach(&(PVOID&)o_vkEnumerateDeviceExtensionProperties, hkvkEnumerateDeviceExtensionProperties);
-            o_vkEnumerateDeviceExtensionProperties = nullptr;
-        }
-
-        if (o_vkCreateDevice)
-        {
-            DetourDetach(&(PVOID&)o_vkCreateDevice, hkvkCreateDevice);
-            o_vkCreateDevice = nullptr;
-        }
-
-        if (o_vkCreateInstance)
-        {
-            DetourDetach(&(PVOID&)o_vkCreateInstance, hkvkCreateInstance);
-            o_vkCreateInstance = nullptr;
-        }
-
-        if (!State::Instance().isDxgiMode && Config::Instance()->DxgiSpoofing.value_or_default())
-        {
-            if (dxgi.CreateDxgiFactory != nullptr)
-            {
-                DetourDetach(&(PVOID&)dxgi.CreateDxgiFactory, _CreateDXGIFactory);
-                dxgi.CreateDxgiFactory = nullptr;
-            }
-
-            if (dxgi.CreateDxgiFactory1 != nullptr)
-            {
-                DetourDetach(&(PVOID&)dxgi.CreateDxgiFactory1, _CreateDXGIFactory1);
-                dxgi.CreateDxgiFactory1 = nullptr;
-            }
-
-            if (dxgi.CreateDxgiFactory2 != nullptr)
-            {
-                DetourDetach(&(PVOID&)dxgi.CreateDxgiFactory2, _CreateDXGIFactory2);
-                dxgi.CreateDxgiFactory2 = nullptr;
-            }
-        }
-
-        DetourTransactionCommit();
+    // LoadLibrary, spoofing & module hooks
+    HookRegistry::DetachAll();
 
+    if (loadLibraryHooked)
         FreeLibrary(shared.dll);
-    }
 }
 
 static void AttachHooks()
 {
+    STARTUP_ZONE(StartupPhase::AttachHooks);
+
     LOG_FUNC();
 
     if (o_LoadLibraryA == nullptr || o_LoadLibraryW == nullptr)
     {
-        // Detour the functions
-        o_FreeLibrary = reinterpret_cast<PFN_FreeLibrary>(DetourFindFunction("kernel32.dll", "FreeLibrary"));
-
-        o_LoadLibraryA = reinterpret_cast<PFN_LoadLibraryA>(DetourFindFunction("kernel32.dll", "LoadLibraryA"));
-        o_LoadLibraryW = reinterpret_cast<PFN_LoadLibraryW>(DetourFindFunction("kernel32.dll", "LoadLibraryW"));
-        o_LoadLibraryExA = reinterpret_cast<PFN_LoadLibraryExA>(DetourFindFunction("kernel32.dll", "LoadLibraryExA"));
-        o_LoadLibraryExW = reinterpret_cast<PFN_LoadLibraryExW>(DetourFindFunction("kernel32.dll", "LoadLibraryExW"));
+        DECLARE_HOOK(ModuleKind::Kernel32, "FreeLibrary", o_FreeLibrary, hkFreeLibrary, nullptr);
+        DECLARE_HOOK(ModuleKind::Kernel32, "LoadLibraryA", o_LoadLibraryA, hkLoadLibraryA, nullptr);
+        DECLARE_HOOK(ModuleKind::Kernel32, "LoadLibraryW", o_LoadLibraryW, hkLoadLibraryW, nullptr);
+        DECLARE_HOOK(ModuleKind::Kernel32, "LoadLibraryExA", o_LoadLibraryExA, hkLoadLibraryExA, nullptr);
+        DECLARE_HOOK(ModuleKind::Kernel32, "LoadLibraryExW", o_LoadLibraryExW, hkLoadLibraryExW, nullptr);
 
 #ifdef HOOK_GET_MODULE
-        o_GetModuleHandleA = reinterpret_cast<PFN_GetModuleHandleA>(DetourFindFunction("kernel32.dll", "GetModuleHandleA"));
-        o_GetModuleHandleW = reinterpret_cast<PFN_GetModuleHandleW>(DetourFindFunction("kernel32.dll", "GetModuleHandleW"));
-        o_GetModuleHandleExA = reinterpret_cast<PFN_GetModuleHandleExA>(DetourFindFunction("kernel32.dll", "GetModuleHandleExA"));
-        o_GetModuleHandleExW = reinterpret_cast<PFN_GetModuleHandleExW>(DetourFindFunction("kernel32.dll", "GetModuleHandleExW"));
+        DECLARE_HOOK(ModuleKind::Kernel32, "GetModuleHandleA", o_GetModuleHandleA, hkGetModuleHandleA, nullptr);
+        DECLARE_HOOK(ModuleKind::Kernel32, "GetModuleHandleW", o_GetModuleHandleW, hkGetModuleHandleW, nullptr);
+        DECLARE_HOOK(ModuleKind::Kernel32, "GetModuleHandleExA", o_GetModuleHandleExA, hkGetModuleHandleExA, nullptr);
+        DECLARE_HOOK(ModuleKind::Kernel32, "GetModuleHandleExW", o_GetModuleHandleExW, hkGetModuleHandleExW, nullptr);
 #endif
-        o_GetProcAddress = reinterpret_cast<PFN_GetProcAddress>(DetourFindFunction("kernel32.dll", "GetProcAddress"));
-
-        o_KernelBase_LoadLibraryA = reinterpret_cast<PFN_LoadLibraryA>(DetourFindFunction("kernelbase.dll", "LoadLibraryA"));
-        o_KernelBase_LoadLibraryW = reinterpret_cast<PFN_LoadLibraryW>(DetourFindFunction("kernelbase.dll", "LoadLibraryW"));
-        o_KernelBase_LoadLibraryExA = reinterpret_cast<PFN_LoadLibraryExA>(DetourFindFunction("kerkernelbasenel32.dll", "LoadLibraryExA"));
-        o_KernelBase_LoadLibraryExW = reinterpret_cast<PFN_LoadLibraryExW>(DetourFindFunction("kernelbase.dll", "LoadLibraryExW"));
-        o_KernelBase_GetProcAddress = reinterpret_cast<PFN_GetProcAddress>(DetourFindFunction("kernelbase.dll", "GetProcAddress"));
-
-        if (o_LoadLibraryA != nullptr || o_LoadLibraryW != nullptr || o_LoadLibraryExA != nullptr || o_LoadLibraryExW != nullptr)
-        {
-            LOG_INFO("Attaching LoadLibrary hooks");
-
-            DetourTransactionBegin();
-            DetourUpdateThread(GetCurrentThread());
-
-            if (o_FreeLibrary)
-                DetourAttach(&(PVOID&)o_FreeLibrary, hkFreeLibrary);
-
-            if (o_LoadLibraryA)
-                DetourAttach(&(PVOID&)o_LoadLibraryA, hkLoadLibraryA);
-
-            if (o_LoadLibraryW)
-                DetourAttach(&(PVOID&)o_LoadLibraryW, hkLoadLibraryW);
-
-            if (o_LoadLibraryExA)
-                DetourAttach(&(PVOID&)o_LoadLibraryExA, hkLoadLibraryExA);
-
-            if (o_LoadLibraryExW)
-                DetourAttach(&(PVOID&)o_LoadLibraryExW, hkLoadLibraryExW);
-
-            if (o_KernelBase_LoadLibraryA)
-                DetourAttach(&(PVOID&)o_KernelBase_LoadLibraryA, hkKernelBase_LoadLibraryA);
-
-            if (o_KernelBase_LoadLibraryW)
-                DetourAttach(&(PVOID&)o_KernelBase_LoadLibraryW, hkKernelBase_LoadLibraryW);
-
-            if (o_KernelBase_LoadLibraryExA)
-                DetourAttach(&(PVOID&)o_KernelBase_LoadLibraryExA, hkKernelBase_LoadLibraryExA);
-
-            if (o_KernelBase_LoadLibraryExW)
-                DetourAttach(&(PVOID&)o_KernelBase_LoadLibraryExW, hkKernelBase_LoadLibraryExW);
-
-#ifdef  HOOK_GET_MODULE
-
-            if (o_GetModuleHandleA)
-                DetourAttach(&(PVOID&)o_GetModuleHandleA, hkGetModuleHandleA);
-
-            if (o_GetModuleHandleW)
-                DetourAttach(&(PVOID&)o_GetModuleHandleW, hkGetModuleHandleW);
-
-            if (o_GetModuleHandleExA)
-                DetourAttach(&(PVOID&)o_GetModuleHandleExA, hkGetModuleHandleExA);
+        DECLARE_HOOK(ModuleKind::Kernel32, "GetProcAddress", o_GetProcAddress, hkGetProcAddress, nullptr);
 
-            if (o_GetModuleHandleExW)
-                DetourAttach(&(PVOID&)o_GetModuleHandleExW, hkGetModuleHandleExW);
+        DECLARE_HOOK(ModuleKind::KernelBase, "LoadLibraryA", o_KernelBase_LoadLibraryA, hkKernelBase_LoadLibraryA, nullptr);
+        DECLARE_HOOK(ModuleKind::KernelBase, "LoadLibraryW", o_KernelBase_LoadLibraryW, hkKernelBase_LoadLibraryW, nullptr);
+        DECLARE_HOOK(ModuleKind::KernelBase, "LoadLibraryExA", o_KernelBase_LoadLibraryExA, hkKernelBase_LoadLibraryExA, nullptr);
+        DECLARE_HOOK(ModuleKind::KernelBase, "LoadLibraryExW", o_KernelBase_LoadLibraryExW, hkKernelBase_LoadLibraryExW, nullptr);
+        DECLARE_HOOK(ModuleKind::KernelBase, "GetProcAddress", o_KernelBase_GetProcAddress, hkGetProcAddress, nullptr);
 
-#endif //  HOOK_GET_MODULE
-
-            if (o_GetProcAddress)
-                DetourAttach(&(PVOID&)o_GetProcAddress, hkGetProcAddress);
-
-            if (o_KernelBase_GetProcAddress)
-                DetourAttach(&(PVOID&)o_KernelBase_GetProcAddress, hkGetProcAddress);
-
-            DetourTransactionCommit();
-        }
+        LOG_INFO("Attaching LoadLibrary hooks");
+        HookRegistry::Install({ { ModuleKind::Kernel32, GetModuleHandle(L"kernel32.dll") }, { ModuleKind::KernelBase, GetModuleHandle(L"kernelbase.dll") } });
     }
+
+    // Only declared here, attached when their dll is loaded
+    DeclareSpoofingHooks();
+    HooksDx::DeclareHooks();
+    HooksVk::DeclareHooks();
 }
 
 static bool IsRunningOnWine()
@@ -2284,6 +2001,8 @@ static bool IsRunningOnWine()
 
 static void CheckWorkingMode()
 {
+    STARTUP_ZONE(StartupPhase::WorkingMode);
+
     LOG_FUNC();
 
     bool modeFound = false;
@@ -2305,11 +2024,6 @@ static void CheckWorkingMode()
         {
             LOG_INFO("OptiScaler working as native upscaler: {0}", filename);
 
-            dllNames.push_back("OptiScaler_DontLoad.dll");
-            dllNames.push_back("OptiScaler_DontLoad");
-            dllNamesW.push_back(L"OptiScaler_DontLoad.dll");
-            dllNamesW.push_back(L"OptiScaler_DontLoad");
-
             isNvngxMode = true;
             isWorkingWithEnabler = lCaseFilename == "dlss-enabler-upscaler.dll";
 
@@ -2357,10 +2071,7 @@ static void CheckWorkingMode()
 
             if (dll != nullptr)
             {
-                dllNames.push_back("version.dll");
-                dllNames.push_back("version");
-                dllNamesW.push_back(L"version.dll");
-                dllNamesW.push_back(L"version");
+                ModuleNames::SetSelf(ModuleKind::Version);
 
                 shared.LoadOriginalLibrary(dll);
                 version.LoadOriginalLibrary(dll);
@@ -2409,10 +2120,7 @@ static void CheckWorkingMode()
 
             if (dll != nullptr)
             {
-                dllNames.push_back("winmm.dll");
-                dllNames.push_back("winmm");
-                dllNamesW.push_back(L"winmm.dll");
-                dllNamesW.push_back(L"winmm");
+                ModuleNames::SetSelf(ModuleKind::Winmm);
 
                 shared.LoadOriginalLibrary(dll);
                 winmm.LoadOriginalLibrary(dll);
@@ -2460,10 +2168,7 @@ static void CheckWorkingMode()
 
             if (dll != nullptr)
             {
-                dllNames.push_back("wininet.dll");
-                dllNames.push_back("wininet");
-                dllNamesW.push_back(L"wininet.dll");
-                dllNamesW.push_back(L"wininet");
+                ModuleNames::SetSelf(ModuleKind::Wininet);
 
                 shared.LoadOriginalLibrary(dll);
                 wininet.LoadOriginalLibrary(dll);
@@ -2511,10 +2216,7 @@ static void CheckWorkingMode()
 
             if (dll != nullptr)
             {
-                dllNames.push_back("dbghelp.dll");
-                dllNames.push_back("dbghelp");
-                dllNamesW.push_back(L"dbghelp.dll");
-                dllNamesW.push_back(L"dbghelp");
+                ModuleNames::SetSelf(ModuleKind::Dbghelp);
 
                 shared.LoadOriginalLibrary(dll);
                 dbghelp.LoadOriginalLibrary(dll);
@@ -2536,10 +2238,7 @@ static void CheckWorkingMode()
             // quick hack for testing
             dll = dllModule;
 
-            dllNames.push_back("optiscaler.asi");
-            dllNames.push_back("optiscaler");
-            dllNamesW.push_back(L"optiscaler.asi");
-            dllNamesW.push_back(L"optiscaler");
+            ModuleNames::SetSelf(ModuleKind::OptiScaler);
 
             modeFound = true;
             break;
@@ -2580,10 +2279,7 @@ static void CheckWorkingMode()
 
             if (dll != nullptr)
             {
-                dllNames.push_back("winhttp.dll");
-                dllNames.push_back("winhttp");
-                dllNamesW.push_back(L"winhttp.dll");
-                dllNamesW.push_back(L"winhttp");
+                ModuleNames::SetSelf(ModuleKind::Winhttp);
 
                 shared.LoadOriginalLibrary(dll);
                 winhttp.LoadOriginalLibrary(dll);
@@ -2631,10 +2327,7 @@ static void CheckWorkingMode()
 
             if (dll != nullptr)
             {
-                dllNames.push_back("dxgi.dll");
-                dllNames.push_back("dxgi");
-                dllNamesW.push_back(L"dxgi.dll");
-                dllNamesW.push_back(L"dxgi");
+                ModuleNames::SetSelf(ModuleKind::Dxgi);
 
                 dxgi.LoadOriginalLibrary(dll);
 
@@ -2683,10 +2376,7 @@ static void CheckWorkingMode()
 
             if (dll != nullptr)
             {
-                dllNames.push_back("d3d12.dll");
-                dllNames.push_back("d3d12");
-                dllNamesW.push_back(L"d3d12.dll");
-                dllNamesW.push_back(L"d3d12");
+                ModuleNames::SetSelf(ModuleKind::Dx12);
 
                 d3d12.LoadOriginalLibrary(dll);
 
@@ -2718,12 +2408,7 @@ static void CheckWorkingMode()
             if (dxgiModule != nullptr)
             {
                 LOG_DEBUG("dxgi.dll already in memory");
-
-                if (!isWorkingWithEnabler)
-                    HookForDxgiSpoofing(dxgiModule);
-
-                if (Config::Instance()->OverlayMenu.value())
-                    HooksDx::HookDxgi(dxgiModule);
+                InstallModuleHooks(ModuleKind::Dxgi, dxgiModule);
             }
 
             // Vulkan
@@ -2736,18 +2421,9 @@ static void CheckWorkingMode()
             if (vulkanModule != nullptr)
             {
                 LOG_DEBUG("vulkan-1.dll already in memory");
-
-                if (!isWorkingWithEnabler)
-                {
-                    HookForVulkanSpoofing(vulkanModule);
-                    HookForVulkanExtensionSpoofing(vulkanModule);
-                    HookForVulkanVRAMSpoofing(vulkanModule);
-                }
+                InstallModuleHooks(ModuleKind::Vulkan, vulkanModule);
             }
 
-            if (Config::Instance()->OverlayMenu.value() && (vulkanModule != nullptr || State::Instance().isRunningOnLinux))
-                HooksVk::HookVk(vulkanModule);
-
             // NVAPI
             HMODULE nvapi64 = nullptr;
             nvapi64 = GetModuleHandle(L"nvapi64.dll");
@@ -2817,7 +2493,7 @@ static void CheckWorkingMode()
             if (Config::Instance()->OverlayMenu.value() && d3d11Module != nullptr)
             {
                 LOG_DEBUG("d3d11.dll already in memory");
-                HooksDx::HookDx11(d3d11Module);
+                InstallModuleHooks(ModuleKind::Dx11, d3d11Module);
             }
 
             // DirectX 12
@@ -2826,7 +2502,7 @@ static void CheckWorkingMode()
             if (Config::Instance()->OverlayMenu.value() && d3d12Module != nullptr)
             {
                 LOG_DEBUG("d3d12.dll already in memory");
-                HooksDx::HookDx12(d3d12Module);
+                InstallModuleHooks(ModuleKind::Dx12, d3d12Module);
             }
 
             // SpecialK
@@ -2927,6 +2603,8 @@ static void CheckQuirks() {
 
 bool isNvidia()
 {
+    STARTUP_ZONE(StartupPhase::GpuDetection);
+
     bool nvidiaDetected = false;
     bool loadedHere = false;
     auto nvapiModule = GetModuleHandleW(L"nvapi64.dll");
@@ -3007,6 +2685,8 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
                 return TRUE;
             }
 
+            StartupProfiler::Begin();
+
             dllModule = hModule;
             processId = GetCurrentProcessId();
 
@@ -3092,12 +2772,15 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
                 Config::Instance()->DxgiSpoofing.set_volatile_value(false);
             }
 
+            // Spoofing defaults above are read from snapshot by GetDesc hooks
+            Config::Instance()->PublishSnapshot();
+
             spdlog::info("");
-            handle = GetModuleHandle(fsr2NamesW[0].c_str());
+            handle = GetModuleHandle(L"ffx_fsr2_api_x64.dll");
             if (handle != nullptr)
                 HookFSR2Inputs(handle);
 
-            handle = GetModuleHandle(fsr2BENamesW[0].c_str());
+            handle = GetModuleHandle(L"ffx_fsr2_api_dx12_x64.dll");
             if (handle != nullptr)
                 HookFSR2Dx12Inputs(handle);
 
@@ -3105,11 +2788,11 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
 
             HookFSR2ExeInputs();
 
-            handle = GetModuleHandle(fsr3NamesW[0].c_str());
+            handle = GetModuleHandle(L"ffx_fsr3upscaler_x64.dll");
             if (handle != nullptr)
                 HookFSR3Inputs(handle);
 
-            handle = GetModuleHandle(fsr3BENamesW[0].c_str());
+            handle = GetModuleHandle(L"ffx_backend_dx12_x64.dll");
             if (handle != nullptr)
                 HookFSR3Dx12Inputs(handle);
 
@@ -3120,12 +2803,18 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
             // Initial state of FSR-FG
             State::Instance().activeFgType = Config::Instance()->FGType.value_or_default();
 
-            for (size_t i = 0; i < 300; i++)
+            State::Instance().frameTimes.Reset(300);
+            State::Instance().upscaleTimes.Reset(300);
+
+            if (Config::Instance()->IniHotReload.value_or_default())
             {
-                State::Instance().frameTimes.push_back(0.0f);
-                State::Instance().upscaleTimes.push_back(0.0f);
+                auto profile = GameProfile::Find(Config::Instance()->IniPath().parent_path());
+                IniWatcher::Start(Config::Instance()->IniPath(), profile.value_or(std::filesystem::path()));
             }
 
+            StartupCache::Flush();
+            StartupProfiler::EndAttach();
+
             spdlog::info("");
             spdlog::info("Init done");
             spdlog::info("---------------------------------------------");
@@ -3136,6 +2825,8 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
         case DLL_PROCESS_DETACH:
             // Unhooking and cleaning stuff causing issues during shutdown. 
             // Disabled for now to check if it cause any issues
+            IniWatcher::Stop();
+            StartupCache::Flush();
             UnhookApis();
             unhookStreamline();
             unhookGdi32();
@@ -1,6 +1,7 @@
 #pragma once
 #include "pch.h"
 #include "Config.h"
+#include "misc/AdapterTable.h"
 
 #include "detours/detours.h"
 
@@ -2015,33 +2016,9 @@ bool SkipSpoofing()
 HRESULT WINAPI detGetDesc3(IDXGIAdapter4* This, DXGI_ADAPTER_DESC3* pDesc)
 {
     auto result = ptrGetDesc3(This, pDesc);
-    if (result == S_OK)
-    {
-        if (pDesc->VendorId != 0x1414 && !State::Instance().adapterDescs.contains(pDesc->AdapterLuid.HighPart | pDesc->AdapterLuid.LowPart))
-        {
-            std::wstring szName(pDesc->Description);
-            std::string descStr = std::format("Adapter: {}, VRAM: {} MB", wstring_to_string(szName), pDesc->DedicatedVideoMemory / (1024 * 1024));
-            LOG_INFO("{}", descStr);
-            State::Instance().adapterDescs.insert_or_assign(pDesc->AdapterLuid.HighPart | pDesc->AdapterLuid.LowPart, descStr);
-        }
-
-        if (Config::Instance()->DxgiVRAM.has_value())
-            pDesc->DedicatedVideoMemory = (UINT64)Config::Instance()->DxgiVRAM.value() * 1024 * 1024 * 1024;
-
-        if (!SkipSpoofing() && pDesc->VendorId != 0x1414 && Config::Instance()->DxgiSpoofing.value_or_default())
-        {
-            pDesc->VendorId = 0x10de;
-            pDesc->DeviceId = 0x2684;
-
-            auto szName = Config::Instance()->SpoofedGPUName.value_or_default();
-            std::memset(pDesc->Description, 0, sizeof(pDesc->Description));
-            std::wcscpy(pDesc->Description, szName.c_str());
 
-#ifdef _DEBUG
-            LOG_DEBUG("spoofing");
-#endif 
-        }
-    }
+    if (result == S_OK)
+        AdapterTable::Apply(pDesc, SkipSpoofing);
 
     AttachToAdapter(This);
 
@@ -2051,33 +2028,9 @@ HRESULT WINAPI detGetDesc3(IDXGIAdapter4* This, DXGI_ADAPTER_DESC3* pDesc)
 HRESULT WINAPI detGetDesc2(IDXGIAdapter2* This, DXGI_ADAPTER_DESC2* pDesc)
 {
     auto result = ptrGetDesc2(This, pDesc);
-    if (result == S_OK)
-    {
-        if (pDesc->VendorId != 0x1414 && !State::Instance().adapterDescs.contains(pDesc->AdapterLuid.HighPart | pDesc->AdapterLuid.LowPart))
-        {
-            std::wstring szName(pDesc->Description);
-            std::string descStr = std::format("Adapter: {}, VRAM: {} MB", wstring_to_string(szName), pDesc->DedicatedVideoMemory / (1024 * 1024));
-            LOG_INFO("{}", descStr);
-            State::Instance().adapterDescs.insert_or_assign(pDesc->AdapterLuid.HighPart | pDesc->AdapterLuid.LowPart, descStr);
-        }
-
-        if (Config::Instance()->DxgiVRAM.has_value())
-            pDesc->DedicatedVideoMemory = (UINT64)Config::Instance()->DxgiVRAM.value() * 1024 * 1024 * 1024;
-
-        if (!SkipSpoofing() && pDesc->VendorId != 0x1414 && Config::Instance()->DxgiSpoofing.value_or_default())
-        {
-            pDesc->VendorId = 0x10de;
-            pDesc->DeviceId = 0x2684;
 
-            auto szName = Config::Instance()->SpoofedGPUName.value_or_default();
-            std::memset(pDesc->Description, 0, sizeof(pDesc->Description));
-            std::wcscpy(pDesc->Description, szName.c_str());
-
-#ifdef _DEBUG
-            LOG_DEBUG("spoofing");
-#endif 
-        }
-    }
+    if (result == S_OK)
+        AdapterTable::Apply(pDesc, SkipSpoofing);
 
     AttachToAdapter(This);
 
@@ -2087,33 +2040,9 @@ HRESULT WINAPI detGetDesc2(IDXGIAdapter2* This, DXGI_ADAPTER_DESC2* pDesc)
 HRESULT WINAPI detGetDesc1(IDXGIAdapter1* This, DXGI_ADAPTER_DESC1* pDesc)
 {
     auto result = ptrGetDesc1(This, pDesc);
-    if (result == S_OK)
-    {
-        if (pDesc->VendorId != 0x1414 && !State::Instance().adapterDescs.contains(pDesc->AdapterLuid.HighPart | pDesc->AdapterLuid.LowPart))
-        {
-            std::wstring szName(pDesc->Description);
-            std::string descStr = std::format("Adapter: {}, VRAM: {} MB", wstring_to_string(szName), pDesc->DedicatedVideoMemory / (1024 * 1024));
-            LOG_INFO("{}", descStr);
-            State::Instance().adapterDescs.insert_or_assign(pDesc->AdapterLuid.HighPart | pDesc->AdapterLuid.LowPart, descStr);
-        }
-
-        if (Config::Instance()->DxgiVRAM.has_value())
-            pDesc->DedicatedVideoMemory = (UINT64)Config::Instance()->DxgiVRAM.value() * 1024 * 1024 * 1024;
-
-        if (!SkipSpoofing() && pDesc->VendorId != 0x1414 && Config::Instance()->DxgiSpoofing.value_or_default())
-        {
-            pDesc->VendorId = 0x10de;
-            pDesc->DeviceId = 0x2684;
-
-            auto szName = Config::Instance()->SpoofedGPUName.value_or_default();
-            std::memset(pDesc->Description, 0, sizeof(pDesc->Description));
-            std::wcscpy(pDesc->Description, szName.c_str());
 
-#ifdef _DEBUG
-            LOG_DEBUG("spoofing");
-#endif
-        }
-    }
+    if (result == S_OK)
+        AdapterTable::Apply(pDesc, SkipSpoofing);
 
     AttachToAdapter(This);
 
@@ -2123,33 +2052,9 @@ HRESULT WINAPI detGetDesc1(IDXGIAdapter1* This, DXGI_ADAPTER_DESC1* pDesc)
 HRESULT WINAPI detGetDesc(IDXGIAdapter* This, DXGI_ADAPTER_DESC* pDesc)
 {
     auto result = ptrGetDesc(This, pDesc);
-    if (result == S_OK)
-    {
-        if (pDesc->VendorId != 0x1414 && !State::Instance().adapterDescs.contains(pDesc->AdapterLuid.HighPart | pDesc->AdapterLuid.LowPart))
-        {
-            std::wstring szName(pDesc->Description);
-            std::string descStr = std::format("Adapter: {}, VRAM: {} MB", wstring_to_string(szName), pDesc->DedicatedVideoMemory / (1024 * 1024));
-            LOG_INFO("{}", descStr);
-            State::Instance().adapterDescs.insert_or_assign(pDesc->AdapterLuid.HighPart | pDesc->AdapterLuid.LowPart, descStr);
-        }
-
-        if (Config::Instance()->DxgiVRAM.has_value())
-            pDesc->DedicatedVideoMemory = (UINT64)Config::Instance()->DxgiVRAM.value() * 1024 * 1024 * 1024;
-
-        if (!SkipSpoofing() && pDesc->VendorId != 0x1414 && Config::Instance()->DxgiSpoofing.value_or_default())
-        {
-            pDesc->VendorId = 0x10de;
-            pDesc->DeviceId = 0x2684;
-
-            auto szName = Config::Instance()->SpoofedGPUName.value_or_default();
-            std::memset(pDesc->Description, 0, sizeof(pDesc->Description));
-            std::wcscpy(pDesc->Description, szName.c_str());
 
-#ifdef _DEBUG
-            LOG_DEBUG("spoofing");
-#endif
-        }
-    }
+    if (result == S_OK)
+        AdapterTable::Apply(pDesc, SkipSpoofing);
 
     AttachToAdapter(This);
 
@@ -2579,6 +2484,8 @@ void AttachToFactory(IUnknown* unkFactory)
 {
     PVOID* pVTable = *(PVOID**)unkFactory;
 
+    AdapterTable::WatchFactory(unkFactory);
+
     IDXGIFactory* factory;
     if (ptrEnumAdapters == nullptr && unkFactory->QueryInterface(__uuidof(IDXGIFactory), (void**)&factory) == S_OK)
     {
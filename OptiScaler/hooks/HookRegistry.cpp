@@ -0,0 +1,225 @@
+#include "HookRegistry.h"
+
+#include <detours/detours.h>
+
+#include <algorithm>
+
+void HookRegistry::Declare(ModuleKind InModule, const char* InName, PVOID* InOriginal, PVOID InDetour, bool (*InEnabled)())
+{
+    if (InName == nullptr || InOriginal == nullptr || InDetour == nullptr)
+        return;
+
+    std::scoped_lock lock(_mutex);
+
+    for (auto& entry : _entries)
+    {
+        if (entry.Original == InOriginal)
+            return;
+    }
+
+    Entry entry{};
+    entry.Module = InModule;
+    entry.Name = InName;
+    entry.Original = InOriginal;
+    entry.Detour = InDetour;
+    entry.Enabled = InEnabled;
+
+    _entries.push_back(entry);
+}
+
+uint32_t HookRegistry::Install(std::initializer_list<std::pair<ModuleKind, HMODULE>> InModules)
+{
+    std::scoped_lock lock(_mutex);
+
+    std::vector<Entry*> pending;
+
+    for (auto& entry : _entries)
+    {
+        if (entry.Attached || entry.Failed)
+            continue;
+
+        auto module = std::find_if(InModules.begin(), InModules.end(), [&entry](const auto& m) { return m.first == entry.Module; });
+
+        if (module == InModules.end() || module->second == nullptr)
+            continue;
+
+        // Already set by a proxy or an older hook, not ours to replace
+        if (*entry.Original != nullptr)
+            continue;
+
+        if (entry.Enabled != nullptr && !entry.Enabled())
+            continue;
+
+        entry.Target = (PVOID)GetProcAddress(module->second, entry.Name);
+
+        if (entry.Target == nullptr)
+        {
+            LOG_DEBUG("{0} not found", entry.Name);
+            continue;
+        }
+
+        pending.push_back(&entry);
+    }
+
+    uint32_t attached = 0;
+    uint32_t transactions = 0;
+
+    while (!pending.empty())
+    {
+        std::vector<Entry*> batch;
+        std::vector<Entry*> deferred;
+        std::vector<PVOID> targets;
+        Entry* failed = nullptr;
+
+        DetourTransactionBegin();
+        DetourUpdateThread(GetCurrentThread());
+
+        for (auto entry : pending)
+        {
+            // Detours can't attach two detours to same function in one transaction
+            if (std::find(targets.begin(), targets.end(), entry->Target) != targets.end())
+            {
+                deferred.push_back(entry);
+                continue;
+            }
+
+            *entry->Original = entry->Target;
+            auto result = DetourAttach(entry->Original, entry->Detour);
+
+            if (result != NO_ERROR)
+            {
+                LOG_ERROR("DetourAttach {0} error: {1}", entry->Name, result);
+                failed = entry;
+                break;
+            }
+
+            LOG_DEBUG("Hooking {0}", entry->Name);
+            targets.push_back(entry->Target);
+            batch.push_back(entry);
+        }
+
+        // Commit would fail for every hook of transaction, retry same set without failed one
+        if (failed != nullptr)
+        {
+            DetourTransactionAbort();
+
+            for (auto entry : batch)
+                *entry->Original = nullptr;
+
+            *failed->Original = nullptr;
+            failed->Failed = true;
+            std::erase(pending, failed);
+            continue;
+        }
+
+        auto result = DetourTransactionCommit();
+        transactions++;
+
+        for (auto entry : batch)
+        {
+            if (result == NO_ERROR)
+            {
+                entry->Attached = true;
+                entry->Order = ++_attachCounter;
+                attached++;
+            }
+            else
+            {
+                *entry->Original = nullptr;
+            }
+        }
+
+        if (result != NO_ERROR)
+            LOG_ERROR("DetourTransactionCommit error: {0}", result);
+
+        pending = std::move(deferred);
+    }
+
+    if (attached > 0)
+        LOG_INFO("Attached {0} hooks in {1} transaction(s)", attached, transactions);
+
+    return attached;
+}
+
+void HookRegistry::DetachAll()
+{
+    std::scoped_lock lock(_mutex);
+
+    std::vector<Entry*> pending;
+
+    for (auto& entry : _entries)
+    {
+        if (entry.Attached)
+            pending.push_back(&entry);
+    }
+
+    // Last attached detour is the first one called, it should go first
+    std::sort(pending.begin(), pending.end(), [](const Entry* a, const Entry* b) { return a->Order > b->Order; });
+
+    uint32_t detached = 0;
+    uint32_t transactions = 0;
+
+    while (!pending.empty())
+    {
+        std::vector<Entry*> batch;
+        std::vector<Entry*> deferred;
+        std::vector<PVOID> targets;
+        Entry* failed = nullptr;
+
+        DetourTransactionBegin();
+        DetourUpdateThread(GetCurrentThread());
+
+        for (auto entry : pending)
+        {
+            if (std::find(targets.begin(), targets.end(), entry->Target) != targets.end())
+            {
+                deferred.push_back(entry);
+                continue;
+            }
+
+            auto result = DetourDetach(entry->Original, entry->Detour);
+
+            if (result != NO_ERROR)
+            {
+                LOG_ERROR("DetourDetach {0} error: {1}", entry->Name, result);
+                failed = entry;
+                break;
+            }
+
+            targets.push_back(entry->Target);
+            batch.push_back(entry);
+        }
+
+        // Failed hook stays attached & keeps its original, others are detached without it
+        if (failed != nullptr)
+        {
+            DetourTransactionAbort();
+
+            failed->Failed = true;
+            std::erase(pending, failed);
+            continue;
+        }
+
+        auto result = DetourTransactionCommit();
+        transactions++;
+
+        if (result == NO_ERROR)
+        {
+            for (auto entry : batch)
+            {
+                *entry->Original = nullptr;
+                entry->Attached = false;
+                detached++;
+            }
+        }
+        else
+        {
+            LOG_ERROR("DetourTransactionCommit error: {0}", result);
+        }
+
+        pending = std::move(deferred);
+    }
+
+    if (detached > 0)
+        LOG_INFO("Detached {0} hooks in {1} transaction(s)", detached, transactions);
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <pch.h>
+
+#include <misc/ModuleNames.h>
+
+#include <initializer_list>
+#include <mutex>
+#include <vector>
+
+// Export hooks are declared once at attach and installed when their module is loaded
+// All pending hooks of a module are attached in one Detours transaction, a second hook
+// of an already hooked export (spoofing + menu) is attached in a following transaction
+// A hook which Detours rejects fails its whole transaction, it's aborted & retried without that hook
+class HookRegistry
+{
+    struct Entry
+    {
+        ModuleKind Module = ModuleKind::Unknown;
+        const char* Name = nullptr;
+        PVOID* Original = nullptr;
+        PVOID Detour = nullptr;
+        bool (*Enabled)() = nullptr;
+
+        PVOID Target = nullptr;     // Export address, used to detect hooks of same function
+        uint32_t Order = 0;         // Attach order, detached in reverse
+        bool Attached = false;
+        bool Failed = false;        // Detours rejected it, not attached again
+    };
+
+    static inline std::vector<Entry> _entries;
+    static inline std::recursive_mutex _mutex;
+    static inline uint32_t _attachCounter = 0;
+
+public:
+    // InOriginal is the trampoline pointer of hook, it's filled from InModule's export on install
+    // InEnabled is checked during install, hook stays pending when it returns false
+    // Declaring same InOriginal again is ignored
+    static void Declare(ModuleKind InModule, const char* InName, PVOID* InOriginal, PVOID InDetour, bool (*InEnabled)() = nullptr);
+
+    // Attaches pending & enabled hooks of InModules together, returns number of attached hooks
+    static uint32_t Install(std::initializer_list<std::pair<ModuleKind, HMODULE>> InModules);
+
+    static uint32_t Install(ModuleKind InModule, HMODULE InHandle) { return Install({ { InModule, InHandle } }); }
+
+    // Detaches every attached hook in reverse order & clears their originals
+    static void DetachAll();
+};
+
+#define DECLARE_HOOK(module, name, original, detour, enabled) HookRegistry::Declare(module, name, (PVOID*)&(original), (PVOID)(detour), enabled)
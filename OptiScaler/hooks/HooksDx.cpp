@@ -1,10 +1,19 @@
 #include "HooksDx.h"
 #include "wrapped_swapchain.h"
+#include "HookRegistry.h"
 
 #include <Util.h>
 #include <Config.h>
 
 #include <menu/menu_overlay_dx.h>
+#include <misc/DrsGovernor.h>
+#include <misc/GpuProfiler_Dx12.h>
+#include <misc/IniWatcher.h>
+#include <misc/RootSignatureCache.h>
+#include <misc/SamplerTracker.h>
+#include <misc/StartupProfiler.h>
+#include <misc/Trace.h>
+#include <upscalers/FeatureBuilder_Dx12.h>
 #include <detours/detours.h>
 #include <dx12/ffx_api_dx12.h>
 #include <ffx_framegeneration.h>
@@ -511,7 +520,7 @@ static void ResourceBarrier(ID3D12GraphicsCommandList* InCommandList, ID3D12Reso
 
 static SIZE_T GetGPUHandle(ID3D12Device* This, SIZE_T cpuHandle, D3D12_DESCRIPTOR_HEAP_TYPE type)
 {
-    std::shared_lock<std::shared_mutex> lock(heapMutex);
+    TracedLock<std::shared_lock<std::shared_mutex>> lock(heapMutex, "heapMutex");
     for (auto& val : fgHeaps)
     {
         if (val.cpuStart <= cpuHandle && val.cpuEnd >= cpuHandle && val.gpuStart != 0)
@@ -530,7 +539,7 @@ static SIZE_T GetGPUHandle(ID3D12Device* This, SIZE_T cpuHandle, D3D12_DESCRIPTO
 
 static SIZE_T GetCPUHandle(ID3D12Device* This, SIZE_T gpuHandle, D3D12_DESCRIPTOR_HEAP_TYPE type)
 {
-    std::shared_lock<std::shared_mutex> lock(heapMutex);
+    TracedLock<std::shared_lock<std::shared_mutex>> lock(heapMutex, "heapMutex");
     for (auto& val : fgHeaps)
     {
         if (val.gpuStart <= gpuHandle && val.gpuEnd >= gpuHandle && val.cpuStart != 0)
@@ -549,7 +558,7 @@ static SIZE_T GetCPUHandle(ID3D12Device* This, SIZE_T gpuHandle, D3D12_DESCRIPTO
 
 static HeapInfo* GetHeapByCpuHandle(SIZE_T cpuHandle)
 {
-    std::shared_lock<std::shared_mutex> lock(heapMutex);
+    TracedLock<std::shared_lock<std::shared_mutex>> lock(heapMutex, "heapMutex");
     for (size_t i = 0; i < fgHeaps.size(); i++)
     {
         if (fgHeaps[i].cpuStart <= cpuHandle && fgHeaps[i].cpuEnd >= cpuHandle)
@@ -561,7 +570,7 @@ static HeapInfo* GetHeapByCpuHandle(SIZE_T cpuHandle)
 
 static HeapInfo* GetHeapByGpuHandle(SIZE_T gpuHandle)
 {
-    std::shared_lock<std::shared_mutex> lock(heapMutex);
+    TracedLock<std::shared_lock<std::shared_mutex>> lock(heapMutex, "heapMutex");
     for (size_t i = 0; i < fgHeaps.size(); i++)
     {
         if (fgHeaps[i].gpuStart <= gpuHandle && fgHeaps[i].gpuEnd >= gpuHandle)
@@ -585,9 +594,9 @@ static void FillResourceInfo(ID3D12Resource* resource, ResourceInfo* info)
     info->flags = desc.Flags;
 }
 
-static bool IsHudFixActive()
+static bool IsHudFixActive(const ConfigSnapshot* config)
 {
-    if (!Config::Instance()->FGEnabled.value_or_default() || !Config::Instance()->FGHUDFix.value_or_default())
+    if (!config->FGEnabled || !config->FGHUDFix)
         return false;
 
     if (HooksDx::fgSkipHudlessChecks || !HooksDx::upscaleRan)
@@ -615,6 +624,8 @@ static bool IsFGCommandList(IUnknown* cmdList)
 
 static void GetHudless(ID3D12GraphicsCommandList* This, int fIndex)
 {
+    TRACE_ZONE("GetHudless");
+
     if ((This == nullptr || This != MenuOverlayDx::MenuCommandList()) && State::Instance().currentFeature != nullptr && !State::Instance().FGchanged &&
         fgHudlessFrame != State::Instance().currentFeature->FrameCount() && FrameGen_Dx12::fgTarget < State::Instance().currentFeature->FrameCount() &&
         FrameGen_Dx12::fgContext != nullptr && FrameGen_Dx12::fgIsActive && HooksDx::currentSwapchain != nullptr)
@@ -836,7 +847,7 @@ static void GetHudless(ID3D12GraphicsCommandList* This, int fIndex)
     }
 }
 
-static bool CheckCapture(std::string callerName)
+static bool CheckCapture(std::string_view callerName, const ConfigSnapshot* config)
 {
     auto fIndex = GetFrameIndex(true);
 
@@ -844,9 +855,9 @@ static bool CheckCapture(std::string callerName)
         std::unique_lock<std::shared_mutex> lock(counterMutex[fIndex]);
         HooksDx::fgHUDlessCaptureCounter[fIndex]++;
 
-        LOG_TRACE("{} -> frameCounter: {}, fgHUDlessCaptureCounter: {}, Limit: {}", callerName, State::Instance().currentFeature->FrameCount(), HooksDx::fgHUDlessCaptureCounter[fIndex], Config::Instance()->FGHUDLimit.value_or_default());
+        LOG_TRACE("{} -> frameCounter: {}, fgHUDlessCaptureCounter: {}, Limit: {}", callerName, State::Instance().currentFeature->FrameCount(), HooksDx::fgHUDlessCaptureCounter[fIndex], config->FGHUDLimit);
 
-        if (HooksDx::fgHUDlessCaptureCounter[fIndex] != Config::Instance()->FGHUDLimit.value_or_default())
+        if (HooksDx::fgHUDlessCaptureCounter[fIndex] != config->FGHUDLimit)
             return false;
 
         HooksDx::fgHUDlessCaptureCounter[fIndex] = -999999999;
@@ -867,7 +878,7 @@ static void CaptureHudless(ID3D12GraphicsCommandList* cmdList, ResourceInfo* res
     // needs conversion?
     if (resource->format != fgScDesc.BufferDesc.Format)
     {
-        if (FrameGen_Dx12::fgFormatTransfer != nullptr && FrameGen_Dx12::fgFormatTransfer->CreateBufferResource(g_pd3dDeviceParam, resource->buffer, D3D12_RESOURCE_STATE_UNORDERED_ACCESS) &&
+        if (FrameGen_Dx12::fgFormatTransfer != nullptr && FrameGen_Dx12::fgFormatTransfer->CreateBufferResource(g_pd3dDeviceParam, resource->buffer, fgScDesc.BufferDesc.Format, D3D12_RESOURCE_STATE_UNORDERED_ACCESS) &&
             CreateBufferResource(g_pd3dDeviceParam, resource, D3D12_RESOURCE_STATE_COPY_SOURCE, &fgHudlessBuffer[fIndex]))
         {
 #ifdef USE_RESOURCE_BARRIRER
@@ -875,7 +886,9 @@ static void CaptureHudless(ID3D12GraphicsCommandList* cmdList, ResourceInfo* res
             ResourceBarrier(cmdList, fgHudlessBuffer[fIndex], D3D12_RESOURCE_STATE_COPY_SOURCE, D3D12_RESOURCE_STATE_COPY_DEST);
 #endif
 
+            GpuProfiler_Dx12::Begin(g_pd3dDeviceParam, cmdList, GpuPass::HudlessCopy);
             cmdList->CopyResource(fgHudlessBuffer[fIndex], resource->buffer);
+            GpuProfiler_Dx12::End(cmdList, GpuPass::HudlessCopy);
 
 #ifdef USE_RESOURCE_BARRIRER
             ResourceBarrier(cmdList, fgHudlessBuffer[fIndex], D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
@@ -903,7 +916,9 @@ static void CaptureHudless(ID3D12GraphicsCommandList* cmdList, ResourceInfo* res
             ResourceBarrier(cmdList, resource->buffer, state, D3D12_RESOURCE_STATE_COPY_SOURCE);
 #endif
 
+            GpuProfiler_Dx12::Begin(g_pd3dDeviceParam, cmdList, GpuPass::HudlessCopy);
             cmdList->CopyResource(fgHudless[fIndex], resource->buffer);
+            GpuProfiler_Dx12::End(cmdList, GpuPass::HudlessCopy);
 
 #ifdef USE_RESOURCE_BARRIRER
             ResourceBarrier(cmdList, resource->buffer, D3D12_RESOURCE_STATE_COPY_SOURCE, state);
@@ -926,7 +941,7 @@ static void CaptureHudless(ID3D12GraphicsCommandList* cmdList, ResourceInfo* res
     GetHudless(cmdList, fIndex);
 }
 
-static bool CheckForHudless(std::string callerName, ResourceInfo* resource)
+static bool CheckForHudless(std::string_view callerName, ResourceInfo* resource, const ConfigSnapshot* config)
 {
     if (HooksDx::currentSwapchain == nullptr)
         return false;
@@ -939,7 +954,7 @@ static bool CheckForHudless(std::string callerName, ResourceInfo* resource)
 
     auto currentMs = Util::MillisecondsNow();
 
-    if (!Config::Instance()->FGAlwaysTrackHeaps.value_or_default() &&
+    if (!config->FGAlwaysTrackHeaps &&
         resource->lastUsedFrame != 0 && (currentMs - resource->lastUsedFrame) > 400)
     {
         LOG_DEBUG("Resource {:X}, last used frame ({}) is too small ({}) from current one ({}) skipping resource!",
@@ -956,16 +971,13 @@ static bool CheckForHudless(std::string callerName, ResourceInfo* resource)
         return false;
     }
 
-    if (FrameGen_Dx12::fgFormatTransfer == nullptr || !FrameGen_Dx12::fgFormatTransfer->IsFormatCompatible(scDesc.BufferDesc.Format))
+    // FormatTransfer holds pipelines for all swapchain formats, only create it once
+    if (FrameGen_Dx12::fgFormatTransfer == nullptr)
     {
-        LOG_DEBUG("Format change, recreate the FormatTransfer");
-
-        if (FrameGen_Dx12::fgFormatTransfer != nullptr)
-            delete FrameGen_Dx12::fgFormatTransfer;
+        LOG_DEBUG("Create the FormatTransfer");
 
-        FrameGen_Dx12::fgFormatTransfer = nullptr;
         State::Instance().skipHeapCapture = true;
-        FrameGen_Dx12::fgFormatTransfer = new FT_Dx12("FormatTransfer", g_pd3dDeviceParam, scDesc.BufferDesc.Format);
+        FrameGen_Dx12::fgFormatTransfer = new FT_Dx12("FormatTransfer", g_pd3dDeviceParam);
         State::Instance().skipHeapCapture = false;
     }
 
@@ -979,7 +991,7 @@ static bool CheckForHudless(std::string callerName, ResourceInfo* resource)
     {
         if (callerName.length() > 0)
             LOG_TRACE("{} -> Width: {}/{}, Height: {}/{}, Format: {}/{}, Resource: {:X}, convertFormat: {} -> FALSE",
-                      callerName, resource->width, fgScDesc.BufferDesc.Width, resource->height, fgScDesc.BufferDesc.Height, (UINT)resource->format, (UINT)fgScDesc.BufferDesc.Format, (size_t)resource->buffer, Config::Instance()->FGHUDFixExtended.value_or_default());
+                      callerName, resource->width, fgScDesc.BufferDesc.Width, resource->height, fgScDesc.BufferDesc.Height, (UINT)resource->format, (UINT)fgScDesc.BufferDesc.Format, (size_t)resource->buffer, config->FGHUDFixExtended);
 
         return false;
     }
@@ -996,7 +1008,7 @@ static bool CheckForHudless(std::string callerName, ResourceInfo* resource)
     {
         if (callerName.length() > 0)
             LOG_DEBUG("{} -> Width: {}/{}, Height: {}/{}, Format: {}/{}, Resource: {:X}, convertFormat: {} -> TRUE",
-                      callerName, resource->width, fgScDesc.BufferDesc.Width, resource->height, fgScDesc.BufferDesc.Height, (UINT)resource->format, (UINT)fgScDesc.BufferDesc.Format, (size_t)resource->buffer, Config::Instance()->FGHUDFixExtended.value_or_default());
+                      callerName, resource->width, fgScDesc.BufferDesc.Width, resource->height, fgScDesc.BufferDesc.Height, (UINT)resource->format, (UINT)fgScDesc.BufferDesc.Format, (size_t)resource->buffer, config->FGHUDFixExtended);
 
         resource->lastUsedFrame = currentMs;
 
@@ -1004,34 +1016,21 @@ static bool CheckForHudless(std::string callerName, ResourceInfo* resource)
     }
 
     // extended not active or no converter
-    if ((!Config::Instance()->FGHUDFixExtended.value_or_default() || FrameGen_Dx12::fgFormatTransfer == nullptr))
+    if ((!config->FGHUDFixExtended || FrameGen_Dx12::fgFormatTransfer == nullptr))
     {
         if (callerName.length() > 0)
             LOG_TRACE("{} -> Width: {}/{}, Height: {}/{}, Format: {}/{}, Resource: {:X}, convertFormat: {} -> FALSE",
-                      callerName, resource->width, fgScDesc.BufferDesc.Width, resource->height, fgScDesc.BufferDesc.Height, (UINT)resource->format, (UINT)fgScDesc.BufferDesc.Format, (size_t)resource->buffer, Config::Instance()->FGHUDFixExtended.value_or_default());
+                      callerName, resource->width, fgScDesc.BufferDesc.Width, resource->height, fgScDesc.BufferDesc.Height, (UINT)resource->format, (UINT)fgScDesc.BufferDesc.Format, (size_t)resource->buffer, config->FGHUDFixExtended);
 
         return false;
     }
 
     // resource and target formats are supported by converter
-    if ((resource->format == DXGI_FORMAT_R10G10B10A2_UNORM || resource->format == DXGI_FORMAT_R10G10B10A2_TYPELESS ||
-        resource->format == DXGI_FORMAT_R16G16B16A16_FLOAT || resource->format == DXGI_FORMAT_R16G16B16A16_TYPELESS ||
-        resource->format == DXGI_FORMAT_R11G11B10_FLOAT ||
-        resource->format == DXGI_FORMAT_R32G32B32A32_FLOAT || resource->format == DXGI_FORMAT_R32G32B32A32_TYPELESS ||
-        resource->format == DXGI_FORMAT_R32G32B32_FLOAT || resource->format == DXGI_FORMAT_R32G32B32_TYPELESS ||
-        resource->format == DXGI_FORMAT_R8G8B8A8_TYPELESS || resource->format == DXGI_FORMAT_R8G8B8A8_UNORM || resource->format == DXGI_FORMAT_R8G8B8A8_UNORM_SRGB ||
-        resource->format == DXGI_FORMAT_B8G8R8A8_TYPELESS || resource->format == DXGI_FORMAT_B8G8R8A8_UNORM || resource->format == DXGI_FORMAT_B8G8R8A8_UNORM_SRGB) &&
-        (fgScDesc.BufferDesc.Format == DXGI_FORMAT_R10G10B10A2_UNORM || fgScDesc.BufferDesc.Format == DXGI_FORMAT_R10G10B10A2_TYPELESS ||
-        fgScDesc.BufferDesc.Format == DXGI_FORMAT_R16G16B16A16_FLOAT || fgScDesc.BufferDesc.Format == DXGI_FORMAT_R16G16B16A16_TYPELESS ||
-        fgScDesc.BufferDesc.Format == DXGI_FORMAT_R11G11B10_FLOAT ||
-        fgScDesc.BufferDesc.Format == DXGI_FORMAT_R32G32B32A32_FLOAT || fgScDesc.BufferDesc.Format == DXGI_FORMAT_R32G32B32A32_TYPELESS ||
-        fgScDesc.BufferDesc.Format == DXGI_FORMAT_R32G32B32_FLOAT || fgScDesc.BufferDesc.Format == DXGI_FORMAT_R32G32B32_TYPELESS ||
-        fgScDesc.BufferDesc.Format == DXGI_FORMAT_R8G8B8A8_TYPELESS || fgScDesc.BufferDesc.Format == DXGI_FORMAT_R8G8B8A8_UNORM || fgScDesc.BufferDesc.Format == DXGI_FORMAT_R8G8B8A8_UNORM_SRGB ||
-        fgScDesc.BufferDesc.Format == DXGI_FORMAT_B8G8R8A8_TYPELESS || fgScDesc.BufferDesc.Format == DXGI_FORMAT_B8G8R8A8_UNORM || fgScDesc.BufferDesc.Format == DXGI_FORMAT_B8G8R8A8_UNORM_SRGB))
+    if (FT_Dx12::IsSourceSupported(resource->format) && FT_Dx12::IsDestinationSupported(fgScDesc.BufferDesc.Format))
     {
         if (callerName.length() > 0)
             LOG_DEBUG("{} -> Width: {}/{}, Height: {}/{}, Format: {}/{}, Resource: {:X}, convertFormat: {} -> TRUE",
-                      callerName, resource->width, fgScDesc.BufferDesc.Width, resource->height, fgScDesc.BufferDesc.Height, (UINT)resource->format, (UINT)fgScDesc.BufferDesc.Format, (size_t)resource->buffer, Config::Instance()->FGHUDFixExtended.value_or_default());
+                      callerName, resource->width, fgScDesc.BufferDesc.Width, resource->height, fgScDesc.BufferDesc.Height, (UINT)resource->format, (UINT)fgScDesc.BufferDesc.Format, (size_t)resource->buffer, config->FGHUDFixExtended);
 
         resource->lastUsedFrame = currentMs;
 
@@ -1040,7 +1039,7 @@ static bool CheckForHudless(std::string callerName, ResourceInfo* resource)
 
     if (callerName.length() > 0)
         LOG_DEBUG_ONLY("{} -> Width: {}/{}, Height: {}/{}, Format: {}/{}, Resource: {:X}, convertFormat: {} -> FALSE",
-                       callerName, resource->width, fgScDesc.BufferDesc.Width, resource->height, fgScDesc.BufferDesc.Height, (UINT)resource->format, (UINT)fgScDesc.BufferDesc.Format, (size_t)resource->buffer, Config::Instance()->FGHUDFixExtended.value_or_default());
+                       callerName, resource->width, fgScDesc.BufferDesc.Width, resource->height, fgScDesc.BufferDesc.Height, (UINT)resource->format, (UINT)fgScDesc.BufferDesc.Format, (size_t)resource->buffer, config->FGHUDFixExtended);
 
     return false;
 }
@@ -1080,14 +1079,16 @@ static void hkDiscardResource(ID3D12GraphicsCommandList* This, ID3D12Resource* p
 
 static void hkCreateRenderTargetView(ID3D12Device* This, ID3D12Resource* pResource, D3D12_RENDER_TARGET_VIEW_DESC* pDesc, D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptor)
 {
+    auto config = Config::Snapshot();
+
     // force hdr for swapchain buffer
-    if (pResource != nullptr && pDesc != nullptr && Config::Instance()->ForceHDR.value_or_default())
+    if (pResource != nullptr && pDesc != nullptr && config->ForceHDR)
     {
         for (size_t i = 0; i < State::Instance().SCbuffers.size(); i++)
         {
             if (State::Instance().SCbuffers[i] == pResource)
             {
-                if (Config::Instance()->UseHDR10.value_or_default())
+                if (config->UseHDR10)
                     pDesc->Format = DXGI_FORMAT_R10G10B10A2_UNORM;
                 else
                     pDesc->Format = DXGI_FORMAT_R16G16B16A16_FLOAT;
@@ -1121,7 +1122,7 @@ static void hkCreateRenderTargetView(ID3D12Device* This, ID3D12Resource* pResour
 
 #ifdef DETAILED_DEBUG_LOGS
 
-    if (CheckForHudless("", &resInfo))
+    if (CheckForHudless("", &resInfo, config))
         LOG_TRACE("<------ pResource: {0:X}, CpuHandle: {1}, GpuHandle: {2}", (UINT64)pResource, DestDescriptor.ptr, GetGPUHandle(This, DestDescriptor.ptr, D3D12_DESCRIPTOR_HEAP_TYPE_RTV));
 
 #endif //  _DEBUG
@@ -1133,14 +1134,16 @@ static void hkCreateRenderTargetView(ID3D12Device* This, ID3D12Resource* pResour
 
 static void hkCreateShaderResourceView(ID3D12Device* This, ID3D12Resource* pResource, D3D12_SHADER_RESOURCE_VIEW_DESC* pDesc, D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptor)
 {
+    auto config = Config::Snapshot();
+
     // force hdr for swapchain buffer
-    if (pResource != nullptr && pDesc != nullptr && Config::Instance()->ForceHDR.value_or_default())
+    if (pResource != nullptr && pDesc != nullptr && config->ForceHDR)
     {
         for (size_t i = 0; i < State::Instance().SCbuffers.size(); i++)
         {
             if (State::Instance().SCbuffers[i] == pResource)
             {
-                if (Config::Instance()->UseHDR10.value_or_default())
+                if (config->UseHDR10)
                     pDesc->Format = DXGI_FORMAT_R10G10B10A2_UNORM;
                 else
                     pDesc->Format = DXGI_FORMAT_R16G16B16A16_FLOAT;
@@ -1174,7 +1177,7 @@ static void hkCreateShaderResourceView(ID3D12Device* This, ID3D12Resource* pReso
 
 #ifdef DETAILED_DEBUG_LOGS
 
-    if (CheckForHudless("", &resInfo))
+    if (CheckForHudless("", &resInfo, config))
         LOG_TRACE("<------ pResource: {0:X}, CpuHandle: {1}, GpuHandle: {2}", (UINT64)pResource, DestDescriptor.ptr, GetGPUHandle(This, DestDescriptor.ptr, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV));
 
 #endif //  _DEBUG
@@ -1186,13 +1189,15 @@ static void hkCreateShaderResourceView(ID3D12Device* This, ID3D12Resource* pReso
 
 static void hkCreateUnorderedAccessView(ID3D12Device* This, ID3D12Resource* pResource, ID3D12Resource* pCounterResource, D3D12_UNORDERED_ACCESS_VIEW_DESC* pDesc, D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptor)
 {
-    if (pResource != nullptr && pDesc != nullptr && Config::Instance()->ForceHDR.value_or_default())
+    auto config = Config::Snapshot();
+
+    if (pResource != nullptr && pDesc != nullptr && config->ForceHDR)
     {
         for (size_t i = 0; i < State::Instance().SCbuffers.size(); i++)
         {
             if (State::Instance().SCbuffers[i] == pResource)
             {
-                if (Config::Instance()->UseHDR10.value_or_default())
+                if (config->UseHDR10)
                     pDesc->Format = DXGI_FORMAT_R10G10B10A2_UNORM;
                 else
                     pDesc->Format = DXGI_FORMAT_R16G16B16A16_FLOAT;
@@ -1226,7 +1231,7 @@ static void hkCreateUnorderedAccessView(ID3D12Device* This, ID3D12Resource* pRes
 
 #ifdef DETAILED_DEBUG_LOGS
 
-    if (CheckForHudless("", &resInfo))
+    if (CheckForHudless("", &resInfo, config))
         LOG_TRACE("<------ pResource: {0:X}, CpuHandle: {1}, GpuHandle: {2}", (UINT64)pResource, DestDescriptor.ptr, GetGPUHandle(This, DestDescriptor.ptr, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV));
 
 #endif //  _DEBUG
@@ -1251,13 +1256,15 @@ static void hkCopyResource(ID3D12GraphicsCommandList* This, ID3D12Resource* Dest
     if (This == MenuOverlayDx::MenuCommandList() || FrameGen_Dx12::fgCommandList[fIndex] == This)
         return;
 
-    if (!IsHudFixActive())
+    auto config = Config::Snapshot();
+
+    if (!IsHudFixActive(config))
         return;
 
     ResourceInfo srcInfo{};
     FillResourceInfo(Source, &srcInfo);
 
-    if (CheckForHudless(__FUNCTION__, &srcInfo) && CheckCapture(__FUNCTION__))
+    if (CheckForHudless(__FUNCTION__, &srcInfo, config) && CheckCapture(__FUNCTION__, config))
     {
         CaptureHudless(This, &srcInfo, D3D12_RESOURCE_STATE_COPY_SOURCE);
         return;
@@ -1266,7 +1273,7 @@ static void hkCopyResource(ID3D12GraphicsCommandList* This, ID3D12Resource* Dest
     ResourceInfo dstInfo{};
     FillResourceInfo(Dest, &dstInfo);
 
-    if (CheckForHudless(__FUNCTION__, &dstInfo) && CheckCapture(__FUNCTION__))
+    if (CheckForHudless(__FUNCTION__, &dstInfo, config) && CheckCapture(__FUNCTION__, config))
         CaptureHudless(This, &dstInfo, D3D12_RESOURCE_STATE_COPY_DEST);
 }
 
@@ -1279,13 +1286,15 @@ static void hkCopyTextureRegion(ID3D12GraphicsCommandList* This, D3D12_TEXTURE_C
     if (This == MenuOverlayDx::MenuCommandList() || FrameGen_Dx12::fgCommandList[fIndex] == This)
         return;
 
-    if (!IsHudFixActive())
+    auto config = Config::Snapshot();
+
+    if (!IsHudFixActive(config))
         return;
 
     ResourceInfo srcInfo{};
     FillResourceInfo(pSrc->pResource, &srcInfo);
 
-    if (CheckForHudless(__FUNCTION__, &srcInfo) && CheckCapture(__FUNCTION__))
+    if (CheckForHudless(__FUNCTION__, &srcInfo, config) && CheckCapture(__FUNCTION__, config))
     {
         CaptureHudless(This, &srcInfo, D3D12_RESOURCE_STATE_COPY_SOURCE);
         return;
@@ -1294,7 +1303,7 @@ static void hkCopyTextureRegion(ID3D12GraphicsCommandList* This, D3D12_TEXTURE_C
     ResourceInfo dstInfo{};
     FillResourceInfo(pDst->pResource, &dstInfo);
 
-    if (CheckForHudless(__FUNCTION__, &dstInfo) && CheckCapture(__FUNCTION__))
+    if (CheckForHudless(__FUNCTION__, &dstInfo, config) && CheckCapture(__FUNCTION__, config))
         CaptureHudless(This, &dstInfo, D3D12_RESOURCE_STATE_COPY_DEST);
 }
 
@@ -1311,6 +1320,9 @@ static HRESULT hkCreateDescriptorHeap(ID3D12Device* This, D3D12_DESCRIPTOR_HEAP_
     if (State::Instance().skipHeapCapture)
         return result;
 
+    if (result == S_OK && pDescriptorHeapDesc->Type == D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER)
+        SamplerTracker::RegisterHeap(This, (ID3D12DescriptorHeap*)(*ppvHeap), pDescriptorHeapDesc);
+
     // try to calculate handle ranges for heap
     if (result == S_OK && (pDescriptorHeapDesc->Type == D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV || pDescriptorHeapDesc->Type == D3D12_DESCRIPTOR_HEAP_TYPE_RTV))
     {
@@ -1326,7 +1338,7 @@ static HRESULT hkCreateDescriptorHeap(ID3D12Device* This, D3D12_DESCRIPTOR_HEAP_
 
         LOG_TRACE("Heap type: {}, Cpu: {}-{}, Gpu: {}-{}, Desc count: {}", info.type, info.cpuStart, info.cpuEnd, info.gpuStart, info.gpuEnd, info.numDescriptors);
         {
-            std::unique_lock<std::shared_mutex> lock(heapMutex);
+            TracedLock<std::unique_lock<std::shared_mutex>> lock(heapMutex, "heapMutex");
             fgHeaps.push_back(info);
         }
     }
@@ -1348,12 +1360,23 @@ static void hkCopyDescriptors(ID3D12Device* This,
                               UINT NumSrcDescriptorRanges, D3D12_CPU_DESCRIPTOR_HANDLE* pSrcDescriptorRangeStarts, UINT* pSrcDescriptorRangeSizes,
                               D3D12_DESCRIPTOR_HEAP_TYPE DescriptorHeapsType)
 {
+    auto config = Config::Snapshot();
+
+    TRACE_ZONE("hkCopyDescriptors");
+
+    if (DescriptorHeapsType == D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER && SamplerTracker::IsTracking())
+    {
+        SamplerTracker::CopyDescriptors(o_CopyDescriptors, This, NumDestDescriptorRanges, pDestDescriptorRangeStarts, pDestDescriptorRangeSizes,
+                                        NumSrcDescriptorRanges, pSrcDescriptorRangeStarts, pSrcDescriptorRangeSizes);
+        return;
+    }
+
     o_CopyDescriptors(This, NumDestDescriptorRanges, pDestDescriptorRangeStarts, pDestDescriptorRangeSizes, NumSrcDescriptorRanges, pSrcDescriptorRangeStarts, pSrcDescriptorRangeSizes, DescriptorHeapsType);
 
     if (DescriptorHeapsType != D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV && DescriptorHeapsType != D3D12_DESCRIPTOR_HEAP_TYPE_RTV)
         return;
 
-    if (!Config::Instance()->FGAlwaysTrackHeaps.value_or_default() && !IsHudFixActive())
+    if (!config->FGAlwaysTrackHeaps && !IsHudFixActive(config))
         return;
 
     // make copies, just in case
@@ -1480,12 +1503,22 @@ static void hkCopyDescriptors(ID3D12Device* This,
 static void hkCopyDescriptorsSimple(ID3D12Device* This, UINT NumDescriptors, D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptorRangeStart,
                                     D3D12_CPU_DESCRIPTOR_HANDLE SrcDescriptorRangeStart, D3D12_DESCRIPTOR_HEAP_TYPE DescriptorHeapsType)
 {
+    auto config = Config::Snapshot();
+
+    TRACE_ZONE("hkCopyDescriptorsSimple");
+
+    if (DescriptorHeapsType == D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER && SamplerTracker::IsTracking())
+    {
+        SamplerTracker::CopyDescriptorsSimple(o_CopyDescriptorsSimple, This, NumDescriptors, DestDescriptorRangeStart, SrcDescriptorRangeStart);
+        return;
+    }
+
     o_CopyDescriptorsSimple(This, NumDescriptors, DestDescriptorRangeStart, SrcDescriptorRangeStart, DescriptorHeapsType);
 
     if (DescriptorHeapsType != D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV && DescriptorHeapsType != D3D12_DESCRIPTOR_HEAP_TYPE_RTV)
         return;
 
-    if (!Config::Instance()->FGAlwaysTrackHeaps.value_or_default() && !IsHudFixActive())
+    if (!config->FGAlwaysTrackHeaps && !IsHudFixActive(config))
         return;
 
     if (State::Instance().useThreadingForHeaps)
@@ -1552,7 +1585,9 @@ static void hkCopyDescriptorsSimple(ID3D12Device* This, UINT NumDescriptors, D3D
 
 static void hkSetGraphicsRootDescriptorTable(ID3D12GraphicsCommandList* This, UINT RootParameterIndex, D3D12_GPU_DESCRIPTOR_HANDLE BaseDescriptor)
 {
-    if (BaseDescriptor.ptr == 0 || !IsHudFixActive())
+    auto config = Config::Snapshot();
+
+    if (BaseDescriptor.ptr == 0 || !IsHudFixActive(config))
     {
         o_SetGraphicsRootDescriptorTable(This, RootParameterIndex, BaseDescriptor);
         return;
@@ -1583,7 +1618,7 @@ static void hkSetGraphicsRootDescriptorTable(ID3D12GraphicsCommandList* This, UI
         return;
     }
 
-    if (!CheckForHudless(__FUNCTION__, capturedBuffer))
+    if (!CheckForHudless(__FUNCTION__, capturedBuffer, config))
     {
         o_SetGraphicsRootDescriptorTable(This, RootParameterIndex, BaseDescriptor);
         return;
@@ -1597,14 +1632,14 @@ static void hkSetGraphicsRootDescriptorTable(ID3D12GraphicsCommandList* This, UI
 
     do
     {
-        if (Config::Instance()->FGImmediateCapture.value_or_default() && CheckCapture(__FUNCTION__))
+        if (config->FGImmediateCapture && CheckCapture(__FUNCTION__, config))
         {
             CaptureHudless(This, capturedBuffer, capturedBuffer->state);
             break;
         }
 
         {
-            std::unique_lock<std::shared_mutex> lock(hudlessMutex[fIndex]);
+            TracedLock<std::unique_lock<std::shared_mutex>> lock(hudlessMutex[fIndex], "hudlessMutex");
 
             if (!fgPossibleHudless[fIndex].contains(This))
             {
@@ -1626,7 +1661,9 @@ static void hkSetGraphicsRootDescriptorTable(ID3D12GraphicsCommandList* This, UI
 static void hkOMSetRenderTargets(ID3D12GraphicsCommandList* This, UINT NumRenderTargetDescriptors, D3D12_CPU_DESCRIPTOR_HANDLE* pRenderTargetDescriptors,
                                  BOOL RTsSingleHandleToDescriptorRange, D3D12_CPU_DESCRIPTOR_HANDLE* pDepthStencilDescriptor)
 {
-    if (NumRenderTargetDescriptors == 0 || pRenderTargetDescriptors == nullptr || !IsHudFixActive())
+    auto config = Config::Snapshot();
+
+    if (NumRenderTargetDescriptors == 0 || pRenderTargetDescriptors == nullptr || !IsHudFixActive(config))
     {
         o_OMSetRenderTargets(This, NumRenderTargetDescriptors, pRenderTargetDescriptors, RTsSingleHandleToDescriptorRange, pDepthStencilDescriptor);
         return;
@@ -1679,20 +1716,20 @@ static void hkOMSetRenderTargets(ID3D12GraphicsCommandList* This, UINT NumRender
                 continue;
             }
 
-            if (!CheckForHudless(__FUNCTION__, resource))
+            if (!CheckForHudless(__FUNCTION__, resource, config))
                 continue;
 
             LOG_DEBUG_ONLY("CommandList: {:X}", (size_t)This);
             resource->state = D3D12_RESOURCE_STATE_RENDER_TARGET;
 
-            if (Config::Instance()->FGImmediateCapture.value_or_default() && CheckCapture(__FUNCTION__))
+            if (config->FGImmediateCapture && CheckCapture(__FUNCTION__, config))
             {
                 CaptureHudless(This, resource, resource->state);
                 break;
             }
 
             {
-                std::unique_lock<std::shared_mutex> lock(hudlessMutex[fIndex]);
+                TracedLock<std::unique_lock<std::shared_mutex>> lock(hudlessMutex[fIndex], "hudlessMutex");
 
                 // check for command list
                 if (!fgPossibleHudless[fIndex].contains(This))
@@ -1716,7 +1753,9 @@ static void hkOMSetRenderTargets(ID3D12GraphicsCommandList* This, UINT NumRender
 
 static void hkSetComputeRootDescriptorTable(ID3D12GraphicsCommandList* This, UINT RootParameterIndex, D3D12_GPU_DESCRIPTOR_HANDLE BaseDescriptor)
 {
-    if (BaseDescriptor.ptr == 0 || !IsHudFixActive())
+    auto config = Config::Snapshot();
+
+    if (BaseDescriptor.ptr == 0 || !IsHudFixActive(config))
     {
         o_SetComputeRootDescriptorTable(This, RootParameterIndex, BaseDescriptor);
         return;
@@ -1747,7 +1786,7 @@ static void hkSetComputeRootDescriptorTable(ID3D12GraphicsCommandList* This, UIN
         return;
     }
 
-    if (!CheckForHudless(__FUNCTION__, capturedBuffer))
+    if (!CheckForHudless(__FUNCTION__, capturedBuffer, config))
     {
         o_SetComputeRootDescriptorTable(This, RootParameterIndex, BaseDescriptor);
         return;
@@ -1764,14 +1803,14 @@ static void hkSetComputeRootDescriptorTable(ID3D12GraphicsCommandList* This, UIN
 
     do
     {
-        if (Config::Instance()->FGImmediateCapture.value_or_default() && CheckForHudless(__FUNCTION__, capturedBuffer) && CheckCapture(__FUNCTION__))
+        if (config->FGImmediateCapture && CheckForHudless(__FUNCTION__, capturedBuffer, config) && CheckCapture(__FUNCTION__, config))
         {
             CaptureHudless(This, capturedBuffer, capturedBuffer->state);
             break;
         }
 
         {
-            std::unique_lock<std::shared_mutex> lock(hudlessMutex[fIndex]);
+            TracedLock<std::unique_lock<std::shared_mutex>> lock(hudlessMutex[fIndex], "hudlessMutex");
 
             if (!fgPossibleHudless[fIndex].contains(This))
             {
@@ -1795,7 +1834,9 @@ static void hkDrawInstanced(ID3D12GraphicsCommandList* This, UINT VertexCountPer
 {
     o_DrawInstanced(This, VertexCountPerInstance, InstanceCount, StartVertexLocation, StartInstanceLocation);
 
-    if (!IsHudFixActive())
+    auto config = Config::Snapshot();
+
+    if (!IsHudFixActive(config))
         return;
 
     if (This == MenuOverlayDx::MenuCommandList() || IsFGCommandList(This))
@@ -1809,7 +1850,7 @@ static void hkDrawInstanced(ID3D12GraphicsCommandList* This, UINT VertexCountPer
         ankerl::unordered_dense::map<ID3D12Resource*, ResourceInfo> val0;
 
         {
-            std::shared_lock<std::shared_mutex> lock(hudlessMutex[fIndex]);
+            TracedLock<std::shared_lock<std::shared_mutex>> lock(hudlessMutex[fIndex], "hudlessMutex");
 
             // if can't find output skip
             if (fgPossibleHudless[fIndex].size() == 0 || !fgPossibleHudless[fIndex].contains(This))
@@ -1828,7 +1869,7 @@ static void hkDrawInstanced(ID3D12GraphicsCommandList* This, UINT VertexCountPer
 
                 for (auto& [key, val] : val0)
                 {
-                    if (CheckCapture(__FUNCTION__))
+                    if (CheckCapture(__FUNCTION__, config))
                     {
                         CaptureHudless(This, &val, val.state);
                         break;
@@ -1839,7 +1880,7 @@ static void hkDrawInstanced(ID3D12GraphicsCommandList* This, UINT VertexCountPer
         }
 
         {
-            std::unique_lock<std::shared_mutex> lock(hudlessMutex[fIndex]);
+            TracedLock<std::unique_lock<std::shared_mutex>> lock(hudlessMutex[fIndex], "hudlessMutex");
             val0.clear();
         }
 
@@ -1851,7 +1892,9 @@ static void hkDrawIndexedInstanced(ID3D12GraphicsCommandList* This, UINT IndexCo
 {
     o_DrawIndexedInstanced(This, IndexCountPerInstance, InstanceCount, StartIndexLocation, BaseVertexLocation, StartInstanceLocation);
 
-    if (!IsHudFixActive())
+    auto config = Config::Snapshot();
+
+    if (!IsHudFixActive(config))
         return;
 
     if (This == MenuOverlayDx::MenuCommandList() || IsFGCommandList(This))
@@ -1865,7 +1908,7 @@ static void hkDrawIndexedInstanced(ID3D12GraphicsCommandList* This, UINT IndexCo
         ankerl::unordered_dense::map<ID3D12Resource*, ResourceInfo> val0;
 
         {
-            std::shared_lock<std::shared_mutex> lock(hudlessMutex[fIndex]);
+            TracedLock<std::shared_lock<std::shared_mutex>> lock(hudlessMutex[fIndex], "hudlessMutex");
 
             // if can't find output skip
             if (fgPossibleHudless[fIndex].size() == 0 || !fgPossibleHudless[fIndex].contains(This))
@@ -1886,7 +1929,7 @@ static void hkDrawIndexedInstanced(ID3D12GraphicsCommandList* This, UINT IndexCo
                 {
                     LOG_DEBUG_ONLY("Found matching final image");
 
-                    if (CheckCapture(__FUNCTION__))
+                    if (CheckCapture(__FUNCTION__, config))
                     {
                         CaptureHudless(This, &val, val.state);
                         break;
@@ -1897,7 +1940,7 @@ static void hkDrawIndexedInstanced(ID3D12GraphicsCommandList* This, UINT IndexCo
         }
 
         {
-            std::unique_lock<std::shared_mutex> lock(hudlessMutex[fIndex]);
+            TracedLock<std::unique_lock<std::shared_mutex>> lock(hudlessMutex[fIndex], "hudlessMutex");
             val0.clear();
         }
 
@@ -1907,9 +1950,13 @@ static void hkDrawIndexedInstanced(ID3D12GraphicsCommandList* This, UINT IndexCo
 
 static void hkDispatch(ID3D12GraphicsCommandList* This, UINT ThreadGroupCountX, UINT ThreadGroupCountY, UINT ThreadGroupCountZ)
 {
+    TRACE_ZONE("hkDispatch");
+
     o_Dispatch(This, ThreadGroupCountX, ThreadGroupCountY, ThreadGroupCountZ);
 
-    if (!IsHudFixActive())
+    auto config = Config::Snapshot();
+
+    if (!IsHudFixActive(config))
         return;
 
     if (This == MenuOverlayDx::MenuCommandList() || IsFGCommandList(This))
@@ -1923,7 +1970,7 @@ static void hkDispatch(ID3D12GraphicsCommandList* This, UINT ThreadGroupCountX,
         ankerl::unordered_dense::map<ID3D12Resource*, ResourceInfo> val0;
 
         {
-            std::shared_lock<std::shared_mutex> lock(hudlessMutex[fIndex]);
+            TracedLock<std::shared_lock<std::shared_mutex>> lock(hudlessMutex[fIndex], "hudlessMutex");
 
             // if can't find output skip
             if (fgPossibleHudless[fIndex].size() == 0 || !fgPossibleHudless[fIndex].contains(This))
@@ -1944,7 +1991,7 @@ static void hkDispatch(ID3D12GraphicsCommandList* This, UINT ThreadGroupCountX,
                 {
                     LOG_DEBUG_ONLY("Found matching final image");
 
-                    if (CheckCapture(__FUNCTION__))
+                    if (CheckCapture(__FUNCTION__, config))
                     {
                         CaptureHudless(This, &val, val.state);
                         break;
@@ -1955,7 +2002,7 @@ static void hkDispatch(ID3D12GraphicsCommandList* This, UINT ThreadGroupCountX,
         }
 
         {
-            std::unique_lock<std::shared_mutex> lock(hudlessMutex[fIndex]);
+            TracedLock<std::unique_lock<std::shared_mutex>> lock(hudlessMutex[fIndex], "hudlessMutex");
             val0.clear();
         }
 
@@ -1969,6 +2016,8 @@ static void hkDispatch(ID3D12GraphicsCommandList* This, UINT ThreadGroupCountX,
 
 static HRESULT hkFGPresent(void* This, UINT SyncInterval, UINT Flags)
 {
+    TRACE_ZONE("hkFGPresent");
+
     // Disabled, was causing freezes at games launch & state changes
     // std::unique_lock<std::shared_mutex> lock(FrameGen_Dx12::ffxMutex);
     //LOG_TRACE("Waiting ffxMutex");
@@ -2057,6 +2106,8 @@ static HRESULT hkFGPresent(void* This, UINT SyncInterval, UINT Flags)
 
 static HRESULT Present(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT Flags, const DXGI_PRESENT_PARAMETERS* pPresentParameters, IUnknown* pDevice, HWND hWnd)
 {
+    TRACE_ZONE("Present");
+
     // Probably not needed anymore
     //std::unique_lock<std::shared_mutex> lock(presentMutex);
 
@@ -2139,39 +2190,14 @@ static HRESULT Present(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT Flags
 
     ReflexHooks::update(FrameGen_Dx12::fgIsActive);
 
+    Trace::NewFrame();
+
     // Upscaler GPU time computation
-    if (HooksDx::dx12UpscaleTrig && HooksDx::readbackBuffer != nullptr && HooksDx::queryHeap != nullptr && cq != nullptr)
+    if (cq != nullptr)
     {
-        UINT64* timestampData;
-        HooksDx::readbackBuffer->Map(0, nullptr, reinterpret_cast<void**>(&timestampData));
-
-        if (timestampData != nullptr)
-        {
-            // Get the GPU timestamp frequency (ticks per second)
-            UINT64 gpuFrequency;
-            cq->GetTimestampFrequency(&gpuFrequency);
-
-            // Calculate elapsed time in milliseconds
-            UINT64 startTime = timestampData[0];
-            UINT64 endTime = timestampData[1];
-            double elapsedTimeMs = (endTime - startTime) / static_cast<double>(gpuFrequency) * 1000.0;
-
-            // filter out possibly wrong measured high values
-            if (elapsedTimeMs < 100.0)
-            {
-                State::Instance().upscaleTimes.push_back(elapsedTimeMs);
-                State::Instance().upscaleTimes.pop_front();
-            }
-        }
-        else
-        {
-            LOG_WARN("timestampData is null!");
-        }
-
-        // Unmap the buffer
-        HooksDx::readbackBuffer->Unmap(0, nullptr);
-
-        HooksDx::dx12UpscaleTrig = false;
+        // Results of older frames are collected without waiting
+        GpuProfiler_Dx12::EndFrame(cq);
+        FeatureBuilder_Dx12::ReleaseRetired(cq);
     }
     else if (HooksDx::dx11UpscaleTrig[HooksDx::currentFrameIndex] && device != nullptr && HooksDx::disjointQueries[0] != nullptr &&
              HooksDx::startQueries[0] != nullptr && HooksDx::endQueries[0] != nullptr)
@@ -2194,8 +2220,7 @@ static HRESULT Present(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT Flags
                     // filter out posibly wrong measured high values
                     if (elapsedTimeMs < 100.0)
                     {
-                        State::Instance().upscaleTimes.push_back(elapsedTimeMs);
-                        State::Instance().upscaleTimes.pop_front();
+                        State::Instance().AddUpscaleTime(elapsedTimeMs);
                     }
                 }
             }
@@ -2206,6 +2231,11 @@ static HRESULT Present(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT Flags
         HooksDx::currentFrameIndex = (HooksDx::currentFrameIndex + 1) % HooksDx::QUERY_BUFFER_COUNT;
     }
 
+    IniWatcher::ApplyPending();
+    DrsGovernor::Update();
+    SamplerTracker::Update();
+    StartupProfiler::NewFrame();
+
     // DXVK check, it's here because of upscaler time calculations
     if (State::Instance().isRunningOnDXVK)
     {
@@ -2266,6 +2296,9 @@ static HRESULT Present(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT Flags
     if (State::Instance().currentFeature != nullptr)
         fgPresentedFrame = State::Instance().currentFeature->FrameCount();
 
+    // Present blocked until GPU & vsync allowed, next frame's GPU work starts after here
+    GpuProfiler_Dx12::StartFrame(cq);
+
     // release used objects
     if (cq != nullptr)
         cq->Release();
@@ -3296,6 +3329,10 @@ static void HookToDevice(ID3D12Device* InDevice)
     // Apply the detour
     if (o_CreateSampler != nullptr || o_CreateRenderTargetView != nullptr)
     {
+        // Samplers are only tracked when bias overrides are active at start, copies are hot for most games
+        SamplerTracker::SetTracking(SamplerTracker::ShouldTrack(Config::Snapshot()));
+        bool trackHeaps = Config::Instance()->FGType.value_or_default() == FGType::OptiFG && Config::Instance()->OverlayMenu.value_or_default();
+
         DetourTransactionBegin();
         DetourUpdateThread(GetCurrentThread());
 
@@ -3305,7 +3342,17 @@ static void HookToDevice(ID3D12Device* InDevice)
         if (o_CreateSampler != nullptr)
             DetourAttach(&(PVOID&)o_CreateSampler, hkCreateSampler);
 
-        if (Config::Instance()->FGType.value_or_default() == FGType::OptiFG && Config::Instance()->OverlayMenu.value_or_default())
+        // Sampler tracker & hudfix follow descriptor copies
+        if (SamplerTracker::IsTracking() || trackHeaps)
+        {
+            if (o_CopyDescriptors != nullptr)
+                DetourAttach(&(PVOID&)o_CopyDescriptors, hkCopyDescriptors);
+
+            if (o_CopyDescriptorsSimple != nullptr)
+                DetourAttach(&(PVOID&)o_CopyDescriptorsSimple, hkCopyDescriptorsSimple);
+        }
+
+        if (trackHeaps)
         {
             if (o_CreateRenderTargetView != nullptr)
                 DetourAttach(&(PVOID&)o_CreateRenderTargetView, hkCreateRenderTargetView);
@@ -3315,15 +3362,11 @@ static void HookToDevice(ID3D12Device* InDevice)
 
             if (o_CreateUnorderedAccessView != nullptr)
                 DetourAttach(&(PVOID&)o_CreateUnorderedAccessView, hkCreateUnorderedAccessView);
-
-            if (o_CopyDescriptors != nullptr)
-                DetourAttach(&(PVOID&)o_CopyDescriptors, hkCopyDescriptors);
-
-            if (o_CopyDescriptorsSimple != nullptr)
-                DetourAttach(&(PVOID&)o_CopyDescriptorsSimple, hkCopyDescriptorsSimple);
         }
 
         DetourTransactionCommit();
+
+        SamplerTracker::SetCreateSampler(o_CreateSampler);
     }
 
     if (Config::Instance()->FGType.value_or_default() == FGType::OptiFG && Config::Instance()->OverlayMenu.value_or_default())
@@ -3678,112 +3721,69 @@ static HRESULT hkD3D12CreateDevice(IDXGIAdapter* pAdapter, D3D_FEATURE_LEVEL Min
 
 static HRESULT hkD3D12SerializeRootSignature(D3D12_ROOT_SIGNATURE_DESC_L* pRootSignature, D3D_ROOT_SIGNATURE_VERSION Version, ID3DBlob** ppBlob, ID3DBlob** ppErrorBlob)
 {
-    if (Config::Instance()->OverrideShaderSampler.value_or_default() && pRootSignature != nullptr)
-    {
-        for (size_t i = 0; i < pRootSignature->NumStaticSamplers; i++)
-        {
-            if (Config::Instance()->MipmapBiasOverride.has_value())
-            {
-                if (pRootSignature->pStaticSamplers[i].MipLODBias < 0.0f || Config::Instance()->MipmapBiasOverrideAll.value_or_default())
-                {
-                    if (Config::Instance()->MipmapBiasOverride.has_value())
-                    {
-                        LOG_DEBUG("Overriding mipmap bias {0} -> {1}", pRootSignature->pStaticSamplers[i].MipLODBias, Config::Instance()->MipmapBiasOverride.value());
+    if (!Config::Instance()->OverrideShaderSampler.value_or_default() || pRootSignature == nullptr || ppBlob == nullptr)
+        return o_D3D12SerializeRootSignature(pRootSignature, Version, ppBlob, ppErrorBlob);
 
-                        if (Config::Instance()->MipmapBiasFixedOverride.value_or_default())
-                            pRootSignature->pStaticSamplers[i].MipLODBias = Config::Instance()->MipmapBiasOverride.value();
-                        else if (Config::Instance()->MipmapBiasScaleOverride.value_or_default())
-                            pRootSignature->pStaticSamplers[i].MipLODBias = pRootSignature->pStaticSamplers[i].MipLODBias * Config::Instance()->MipmapBiasOverride.value();
-                        else
-                            pRootSignature->pStaticSamplers[i].MipLODBias = pRootSignature->pStaticSamplers[i].MipLODBias + Config::Instance()->MipmapBiasOverride.value();
-                    }
+    // Static samplers are baked into root signature, current render scale is used for auto bias
+    auto config = Config::Snapshot();
 
-                    if (State::Instance().lastMipBiasMax < pRootSignature->pStaticSamplers[i].MipLODBias)
-                        State::Instance().lastMipBiasMax = pRootSignature->pStaticSamplers[i].MipLODBias;
+    // Content of game's desc, it's never modified
+    auto content = RootSignatureCache::Content((const D3D12_ROOT_SIGNATURE_DESC*)pRootSignature, Version, config);
 
-                    if (State::Instance().lastMipBias > pRootSignature->pStaticSamplers[i].MipLODBias)
-                        State::Instance().lastMipBias = pRootSignature->pStaticSamplers[i].MipLODBias;
-                }
-            }
+    if (auto blob = RootSignatureCache::Find(content); blob != nullptr)
+    {
+        *ppBlob = blob;
 
-            if (Config::Instance()->AnisotropyOverride.has_value())
-            {
-                if (pRootSignature->pStaticSamplers[i].Filter == D3D12_FILTER_MIN_MAG_MIP_LINEAR || pRootSignature->pStaticSamplers[i].Filter == D3D12_FILTER_MIN_MAG_LINEAR_MIP_POINT || 
-                    pRootSignature->pStaticSamplers[i].Filter == D3D12_FILTER_ANISOTROPIC) 
-                {
-                    pRootSignature->pStaticSamplers[i].Filter = D3D12_FILTER_ANISOTROPIC;
-                    LOG_DEBUG("Overriding {2:X} to anisotropic filtering {0} -> {1}",
-                              pRootSignature->pStaticSamplers[i].MaxAnisotropy, Config::Instance()->AnisotropyOverride.value(), (UINT)pRootSignature->pStaticSamplers[i].Filter);
-                    pRootSignature->pStaticSamplers[i].MaxAnisotropy = Config::Instance()->AnisotropyOverride.value();
-                }
-            }
-        }
+        if (ppErrorBlob != nullptr)
+            *ppErrorBlob = nullptr;
+
+        return S_OK;
     }
 
-    return o_D3D12SerializeRootSignature(pRootSignature, Version, ppBlob, ppErrorBlob);
-}
+    auto start = Util::MillisecondsNow();
 
-static void hkCreateSampler(ID3D12Device* device, const D3D12_SAMPLER_DESC* pDesc, D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptor)
-{
-    if (pDesc == nullptr || device == nullptr)
-        return;
+    // Samplers are patched on a copy, desc & its samplers belong to caller
+    std::vector<D3D12_STATIC_SAMPLER_DESC> samplers;
 
-    D3D12_SAMPLER_DESC newDesc{};
+    if (pRootSignature->NumStaticSamplers > 0 && pRootSignature->pStaticSamplers != nullptr)
+        samplers.assign(pRootSignature->pStaticSamplers, pRootSignature->pStaticSamplers + pRootSignature->NumStaticSamplers);
 
-    newDesc.AddressU = pDesc->AddressU;
-    newDesc.AddressV = pDesc->AddressV;
-    newDesc.AddressW = pDesc->AddressW;
-    newDesc.BorderColor[0] = pDesc->BorderColor[0];
-    newDesc.BorderColor[1] = pDesc->BorderColor[1];
-    newDesc.BorderColor[2] = pDesc->BorderColor[2];
-    newDesc.BorderColor[3] = pDesc->BorderColor[3];
-    newDesc.ComparisonFunc = pDesc->ComparisonFunc;
+    for (auto& sampler : samplers)
+        SamplerTracker::PatchDesc(config, &sampler);
 
-    if (Config::Instance()->AnisotropyOverride.has_value())
-    {
-        if (pDesc->Filter == D3D12_FILTER_MIN_MAG_MIP_LINEAR || pDesc->Filter == D3D12_FILTER_MIN_MAG_LINEAR_MIP_POINT || pDesc->Filter == D3D12_FILTER_ANISOTROPIC)
-        {
-            newDesc.Filter = D3D12_FILTER_ANISOTROPIC;
-            LOG_DEBUG("Overriding {2:X} to anisotropic filtering {0} -> {1}", pDesc->MaxAnisotropy, Config::Instance()->AnisotropyOverride.value(), (UINT)pDesc->Filter);
-            newDesc.MaxAnisotropy = Config::Instance()->AnisotropyOverride.value();
-        }
-    }
-    else
-    {
-        newDesc.Filter = pDesc->Filter;
-        newDesc.MaxAnisotropy = pDesc->MaxAnisotropy;
-    }
+    auto desc = *pRootSignature;
 
-    newDesc.MaxLOD = pDesc->MaxLOD;
-    newDesc.MinLOD = pDesc->MinLOD;
-    newDesc.MipLODBias = pDesc->MipLODBias;
+    if (!samplers.empty())
+        desc.pStaticSamplers = samplers.data();
 
-    if (newDesc.MipLODBias < 0.0f || Config::Instance()->MipmapBiasOverrideAll.value_or_default())
-    {
-        if (Config::Instance()->MipmapBiasOverride.has_value())
-        {
-            LOG_DEBUG("Overriding mipmap bias {0} -> {1}", pDesc->MipLODBias, Config::Instance()->MipmapBiasOverride.value());
+    auto result = o_D3D12SerializeRootSignature(&desc, Version, ppBlob, ppErrorBlob);
 
-            if (Config::Instance()->MipmapBiasFixedOverride.value_or_default())
-                newDesc.MipLODBias = Config::Instance()->MipmapBiasOverride.value();
-            else if (Config::Instance()->MipmapBiasScaleOverride.value_or_default())
-                newDesc.MipLODBias = newDesc.MipLODBias * Config::Instance()->MipmapBiasOverride.value();
-            else
-                newDesc.MipLODBias = newDesc.MipLODBias + Config::Instance()->MipmapBiasOverride.value();
-        }
+    if (result == S_OK)
+        RootSignatureCache::Add(std::move(content), *ppBlob, Util::MillisecondsNow() - start);
 
-        if (State::Instance().lastMipBiasMax < newDesc.MipLODBias)
-            State::Instance().lastMipBiasMax = newDesc.MipLODBias;
+    return result;
+}
 
-        if (State::Instance().lastMipBias > newDesc.MipLODBias)
-            State::Instance().lastMipBias = newDesc.MipLODBias;
-    }
+static void hkCreateSampler(ID3D12Device* device, const D3D12_SAMPLER_DESC* pDesc, D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptor)
+{
+    auto config = Config::Snapshot();
+
+    if (pDesc == nullptr || device == nullptr)
+        return;
+
+    // Original desc is kept to recreate sampler when bias changes
+    SamplerTracker::Track(pDesc, DestDescriptor);
+
+    D3D12_SAMPLER_DESC newDesc{};
+    SamplerTracker::PatchDesc(config, pDesc, &newDesc);
 
     return o_CreateSampler(device, &newDesc, DestDescriptor);
 }
 
 static HRESULT hkCreateSamplerState(ID3D11Device* This, const D3D11_SAMPLER_DESC* pSamplerDesc, ID3D11SamplerState** ppSamplerState)
 {
+    auto config = Config::Snapshot();
+
     if (pSamplerDesc == nullptr || This == nullptr)
         return E_INVALIDARG;
 
@@ -3792,74 +3792,9 @@ static HRESULT hkCreateSamplerState(ID3D11Device* This, const D3D11_SAMPLER_DESC
 
     LOG_FUNC();
 
+    // Sampler states are immutable, bias is only applied at creation
     D3D11_SAMPLER_DESC newDesc{};
-
-    newDesc.AddressU = pSamplerDesc->AddressU;
-    newDesc.AddressV = pSamplerDesc->AddressV;
-    newDesc.AddressW = pSamplerDesc->AddressW;
-    newDesc.ComparisonFunc = pSamplerDesc->ComparisonFunc;
-    newDesc.BorderColor[0] = pSamplerDesc->BorderColor[0];
-    newDesc.BorderColor[1] = pSamplerDesc->BorderColor[1];
-    newDesc.BorderColor[2] = pSamplerDesc->BorderColor[2];
-    newDesc.BorderColor[3] = pSamplerDesc->BorderColor[3];
-    newDesc.MinLOD = pSamplerDesc->MinLOD;
-    newDesc.MaxLOD = pSamplerDesc->MaxLOD;
-
-    if (Config::Instance()->AnisotropyOverride.has_value())
-    {
-        if (pSamplerDesc->Filter <= D3D11_FILTER_ANISOTROPIC)
-        {
-            newDesc.Filter = D3D11_FILTER_ANISOTROPIC;
-            LOG_DEBUG("Overriding {2:X} to anisotropic filtering {0} -> {1}", pSamplerDesc->MaxAnisotropy, Config::Instance()->AnisotropyOverride.value(), (UINT)pSamplerDesc->Filter);
-            newDesc.MaxAnisotropy = Config::Instance()->AnisotropyOverride.value();
-        }
-        else if (pSamplerDesc->Filter > D3D11_FILTER_ANISOTROPIC && pSamplerDesc->Filter <= D3D11_FILTER_COMPARISON_ANISOTROPIC)
-        {
-            newDesc.Filter = D3D11_FILTER_COMPARISON_ANISOTROPIC;
-            LOG_DEBUG("Overriding {2:X} to anisotropic filtering {0} -> {1}", pSamplerDesc->MaxAnisotropy, Config::Instance()->AnisotropyOverride.value(), (UINT)pSamplerDesc->Filter);
-            newDesc.MaxAnisotropy = Config::Instance()->AnisotropyOverride.value();
-        }
-        else if (pSamplerDesc->Filter > D3D11_FILTER_COMPARISON_ANISOTROPIC && pSamplerDesc->Filter <= D3D11_FILTER_MINIMUM_ANISOTROPIC)
-        {
-            newDesc.Filter = D3D11_FILTER_MINIMUM_ANISOTROPIC;
-            LOG_DEBUG("Overriding {2:X} to anisotropic filtering {0} -> {1}", pSamplerDesc->MaxAnisotropy, Config::Instance()->AnisotropyOverride.value(), (UINT)pSamplerDesc->Filter);
-            newDesc.MaxAnisotropy = Config::Instance()->AnisotropyOverride.value();
-        }
-        else if (pSamplerDesc->Filter > D3D11_FILTER_MINIMUM_ANISOTROPIC && pSamplerDesc->Filter <= D3D11_FILTER_MAXIMUM_ANISOTROPIC)
-        {
-            newDesc.Filter = D3D11_FILTER_MAXIMUM_ANISOTROPIC;
-            LOG_DEBUG("Overriding {2:X} to anisotropic filtering {0} -> {1}", pSamplerDesc->MaxAnisotropy, Config::Instance()->AnisotropyOverride.value(), (UINT)pSamplerDesc->Filter);
-            newDesc.MaxAnisotropy = Config::Instance()->AnisotropyOverride.value();
-        }
-    }
-    else
-    {
-        newDesc.Filter = pSamplerDesc->Filter;
-        newDesc.MaxAnisotropy = pSamplerDesc->MaxAnisotropy;
-    }
-
-    newDesc.MipLODBias = pSamplerDesc->MipLODBias;
-
-    if (newDesc.MipLODBias < 0.0f || Config::Instance()->MipmapBiasOverrideAll.value_or_default())
-    {
-        if (Config::Instance()->MipmapBiasOverride.has_value())
-        {
-            LOG_DEBUG("Overriding mipmap bias {0} -> {1}", pSamplerDesc->MipLODBias, Config::Instance()->MipmapBiasOverride.value());
-
-            if (Config::Instance()->MipmapBiasFixedOverride.value_or_default())
-                newDesc.MipLODBias = Config::Instance()->MipmapBiasOverride.value();
-            else if (Config::Instance()->MipmapBiasScaleOverride.value_or_default())
-                newDesc.MipLODBias = newDesc.MipLODBias * Config::Instance()->MipmapBiasOverride.value();
-            else
-                newDesc.MipLODBias = newDesc.MipLODBias + Config::Instance()->MipmapBiasOverride.value();
-        }
-
-        if (State::Instance().lastMipBiasMax < newDesc.MipLODBias)
-            State::Instance().lastMipBiasMax = newDesc.MipLODBias;
-
-        if (State::Instance().lastMipBias > newDesc.MipLODBias)
-            State::Instance().lastMipBias = newDesc.MipLODBias;
-    }
+    SamplerTracker::PatchDesc(config, pSamplerDesc, &newDesc);
 
     return o_CreateSamplerState(This, &newDesc, ppSamplerState);
 }
@@ -3868,94 +3803,20 @@ static HRESULT hkCreateSamplerState(ID3D11Device* This, const D3D11_SAMPLER_DESC
 
 #pragma region Public hook methods
 
-void HooksDx::HookDx12(HMODULE dx12Module)
+void HooksDx::DeclareHooks()
 {
-    if (o_D3D12CreateDevice != nullptr)
-        return;
+    auto overlayMenu = []() { return Config::Instance()->OverlayMenu.value_or_default(); };
 
-    LOG_DEBUG("");
+    DECLARE_HOOK(ModuleKind::Dx12, "D3D12CreateDevice", o_D3D12CreateDevice, hkD3D12CreateDevice, overlayMenu);
+    DECLARE_HOOK(ModuleKind::Dx12, "D3D12SerializeRootSignature", o_D3D12SerializeRootSignature, hkD3D12SerializeRootSignature, overlayMenu);
 
-    o_D3D12CreateDevice = (PFN_D3D12_CREATE_DEVICE)GetProcAddress(dx12Module, "D3D12CreateDevice");
-    o_D3D12SerializeRootSignature = (PFN_D3D12SerializeRootSignature)GetProcAddress(dx12Module, "D3D12SerializeRootSignature");
+    DECLARE_HOOK(ModuleKind::Dx11, "D3D11CreateDevice", o_D3D11CreateDevice, hkD3D11CreateDevice, overlayMenu);
+    DECLARE_HOOK(ModuleKind::Dx11, "D3D11On12CreateDevice", o_D3D11On12CreateDevice, hkD3D11On12CreateDevice, overlayMenu);
+    DECLARE_HOOK(ModuleKind::Dx11, "D3D11CreateDeviceAndSwapChain", o_D3D11CreateDeviceAndSwapChain, hkD3D11CreateDeviceAndSwapChain, overlayMenu);
 
-    if (o_D3D12CreateDevice != nullptr)
-    {
-        DetourTransactionBegin();
-        DetourUpdateThread(GetCurrentThread());
-
-        LOG_DEBUG("Hooking D3D12CreateDevice method");
-        DetourAttach(&(PVOID&)o_D3D12CreateDevice, hkD3D12CreateDevice);
-
-        if (o_D3D12SerializeRootSignature != nullptr)
-        {
-            LOG_DEBUG("Hooking D3D12SerializeRootSignature method");
-            DetourAttach(&(PVOID&)o_D3D12SerializeRootSignature, hkD3D12SerializeRootSignature);
-        }
-
-        DetourTransactionCommit();
-    }
-}
-
-void HooksDx::HookDx11(HMODULE dx11Module)
-{
-    if (o_D3D11CreateDevice != nullptr)
-        return;
-
-    LOG_DEBUG("");
-
-    o_D3D11CreateDevice = (PFN_D3D11_CREATE_DEVICE)GetProcAddress(dx11Module, "D3D11CreateDevice");
-    o_D3D11CreateDeviceAndSwapChain = (PFN_D3D11_CREATE_DEVICE_AND_SWAP_CHAIN)GetProcAddress(dx11Module, "D3D11CreateDeviceAndSwapChain");
-    o_D3D11On12CreateDevice = (PFN_D3D11ON12_CREATE_DEVICE)GetProcAddress(dx11Module, "D3D11On12CreateDevice");
-
-    if (o_D3D11CreateDevice != nullptr || o_D3D11On12CreateDevice != nullptr || o_D3D11CreateDeviceAndSwapChain != nullptr)
-    {
-        LOG_DEBUG("Hooking D3D11CreateDevice methods");
-
-        DetourTransactionBegin();
-        DetourUpdateThread(GetCurrentThread());
-
-        if (o_D3D11CreateDevice != nullptr)
-            DetourAttach(&(PVOID&)o_D3D11CreateDevice, hkD3D11CreateDevice);
-
-        if (o_D3D11On12CreateDevice != nullptr)
-            DetourAttach(&(PVOID&)o_D3D11On12CreateDevice, hkD3D11On12CreateDevice);
-
-        if (o_D3D11CreateDeviceAndSwapChain != nullptr)
-            DetourAttach(&(PVOID&)o_D3D11CreateDeviceAndSwapChain, hkD3D11CreateDeviceAndSwapChain);
-
-        DetourTransactionCommit();
-    }
-}
-
-void HooksDx::HookDxgi(HMODULE dxgiModule)
-{
-    if (o_CreateDXGIFactory != nullptr)
-        return;
-
-    LOG_DEBUG("");
-
-    o_CreateDXGIFactory = (PFN_CreateDXGIFactory)GetProcAddress(dxgiModule, "CreateDXGIFactory");
-    o_CreateDXGIFactory1 = (PFN_CreateDXGIFactory1)GetProcAddress(dxgiModule, "CreateDXGIFactory1");
-    o_CreateDXGIFactory2 = (PFN_CreateDXGIFactory2)GetProcAddress(dxgiModule, "CreateDXGIFactory2");
-
-    if (o_CreateDXGIFactory != nullptr)
-    {
-        LOG_DEBUG("Hooking CreateDXGIFactory methods");
-
-        DetourTransactionBegin();
-        DetourUpdateThread(GetCurrentThread());
-
-        if (o_CreateDXGIFactory != nullptr)
-            DetourAttach(&(PVOID&)o_CreateDXGIFactory, hkCreateDXGIFactory);
-
-        if (o_CreateDXGIFactory1 != nullptr)
-            DetourAttach(&(PVOID&)o_CreateDXGIFactory1, hkCreateDXGIFactory1);
-
-        if (o_CreateDXGIFactory2 != nullptr)
-            DetourAttach(&(PVOID&)o_CreateDXGIFactory2, hkCreateDXGIFactory2);
-
-        DetourTransactionCommit();
-    }
+    DECLARE_HOOK(ModuleKind::Dxgi, "CreateDXGIFactory", o_CreateDXGIFactory, hkCreateDXGIFactory, overlayMenu);
+    DECLARE_HOOK(ModuleKind::Dxgi, "CreateDXGIFactory1", o_CreateDXGIFactory1, hkCreateDXGIFactory1, overlayMenu);
+    DECLARE_HOOK(ModuleKind::Dxgi, "CreateDXGIFactory2", o_CreateDXGIFactory2, hkCreateDXGIFactory2, overlayMenu);
 }
 
 DXGI_FORMAT HooksDx::CurrentSwapchainFormat()
@@ -3975,36 +3836,6 @@ void HooksDx::UnHookDx()
     DetourTransactionBegin();
     DetourUpdateThread(GetCurrentThread());
 
-    if (o_D3D11CreateDevice != nullptr)
-    {
-        DetourDetach(&(PVOID&)o_D3D11CreateDevice, hkD3D11CreateDevice);
-        o_D3D11CreateDevice = nullptr;
-    }
-
-    if (o_D3D11On12CreateDevice != nullptr)
-    {
-        DetourDetach(&(PVOID&)o_D3D11On12CreateDevice, hkD3D11On12CreateDevice);
-        o_D3D11On12CreateDevice = nullptr;
-    }
-
-    if (o_D3D12CreateDevice != nullptr)
-    {
-        DetourDetach(&(PVOID&)o_D3D12CreateDevice, hkD3D12CreateDevice);
-        o_D3D12CreateDevice = nullptr;
-    }
-
-    if (o_CreateDXGIFactory1 != nullptr)
-    {
-        DetourDetach(&(PVOID&)o_CreateDXGIFactory1, hkCreateDXGIFactory1);
-        o_CreateDXGIFactory1 = nullptr;
-    }
-
-    if (o_CreateDXGIFactory2 != nullptr)
-    {
-        DetourDetach(&(PVOID&)o_CreateDXGIFactory2, hkCreateDXGIFactory2);
-        o_CreateDXGIFactory2 = nullptr;
-    }
-
     if (oCreateSwapChain != nullptr)
     {
         DetourDetach(&(PVOID&)oCreateSwapChain, hkCreateSwapChain);
@@ -4021,6 +3852,7 @@ void HooksDx::UnHookDx()
     {
         DetourDetach(&(PVOID&)o_CreateSampler, hkCreateSampler);
         o_CreateSampler = nullptr;
+        SamplerTracker::SetCreateSampler(nullptr);
     }
 
     DetourTransactionCommit();
@@ -4038,7 +3870,7 @@ static void ClearNextFrame()
 
     if (fgPossibleHudless[newIndex].size() != 0)
     {
-        std::unique_lock<std::shared_mutex> lock(hudlessMutex[newIndex]);
+        TracedLock<std::unique_lock<std::shared_mutex>> lock(hudlessMutex[newIndex], "hudlessMutex");
         fgPossibleHudless[newIndex].clear();
     }
 
@@ -4331,7 +4163,7 @@ void FrameGen_Dx12::CreateFGObjects(ID3D12Device* InDevice)
         }
 
         State::Instance().skipHeapCapture = true;
-        FrameGen_Dx12::fgFormatTransfer = new FT_Dx12("FormatTransfer", InDevice, HooksDx::CurrentSwapchainFormat());
+        FrameGen_Dx12::fgFormatTransfer = new FT_Dx12("FormatTransfer", InDevice);
         State::Instance().skipHeapCapture = false;
 
     } while (false);
@@ -4471,11 +4303,13 @@ void FrameGen_Dx12::StopAndDestroyFGContext(bool destroy, bool shutDown, bool us
 
 void FrameGen_Dx12::CheckUpscaledFrame(ID3D12GraphicsCommandList* InCmdList, ID3D12Resource* InUpscaled)
 {
+    auto config = Config::Snapshot();
+
     ResourceInfo upscaledInfo{};
     FillResourceInfo(InUpscaled, &upscaledInfo);
     upscaledInfo.state = D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
 
-    if (CheckForHudless(__FUNCTION__, &upscaledInfo) && CheckCapture(__FUNCTION__))
+    if (CheckForHudless(__FUNCTION__, &upscaledInfo, config) && CheckCapture(__FUNCTION__, config))
         CaptureHudless(InCmdList, &upscaledInfo, upscaledInfo.state);
 }
 
@@ -32,10 +32,6 @@
 
 namespace HooksDx
 {
-    inline ID3D12QueryHeap* queryHeap = nullptr;
-    inline ID3D12Resource* readbackBuffer = nullptr;
-    inline bool dx12UpscaleTrig = false;
-
     inline const int QUERY_BUFFER_COUNT = 3;
     inline ID3D11Query* disjointQueries[QUERY_BUFFER_COUNT] = { nullptr, nullptr, nullptr };
     inline ID3D11Query* startQueries[QUERY_BUFFER_COUNT] = { nullptr, nullptr, nullptr };
@@ -61,9 +57,9 @@ namespace HooksDx
     inline ID3D12CommandQueue* gameCommandQueue = nullptr;
 
     void UnHookDx();
-    void HookDx11(HMODULE dx11Module);
-    void HookDx12(HMODULE dx12Module);
-    void HookDxgi(HMODULE dxgiModule);
+
+    // Declares d3d11, d3d12 & dxgi export hooks of overlay menu to HookRegistry
+    void DeclareHooks();
     DXGI_FORMAT CurrentSwapchainFormat();
 }
 
@@ -107,7 +103,7 @@ namespace FrameGen_Dx12
     // 1: Framegen
     // 2: Swapchain Present <---
     // 3: Wrapped swapchain
-    inline OwnedMutex ffxMutex;
+    inline OwnedMutex ffxMutex{ "ffxMutex" };
 
     UINT NewFrame();
     UINT GetFrame();
@@ -1,9 +1,16 @@
 #include "HooksVk.h"
+#include "HookRegistry.h"
 
 #include <Util.h>
 #include <Config.h>
 
 #include <menu/menu_overlay_vk.h>
+#include <misc/Trace.h>
+#include <misc/DrsGovernor.h>
+#include <misc/GpuProfiler_Vk.h>
+#include <misc/IniWatcher.h>
+#include <misc/PipelineCache_Vk.h>
+#include <misc/StartupProfiler.h>
 #include <detours/detours.h>
 
 typedef struct VkWin32SurfaceCreateInfoKHR {
@@ -30,6 +37,7 @@ typedef VkResult(*PFN_CreateSwapchainKHR)(VkDevice, const VkSwapchainCreateInfoK
 typedef VkResult(*PFN_vkCreateWin32SurfaceKHR)(VkInstance, const VkWin32SurfaceCreateInfoKHR*, const VkAllocationCallbacks*, VkSurfaceKHR*);
 
 PFN_vkCreateDevice o_vkCreateDevice = nullptr;
+PFN_vkDestroyDevice o_vkDestroyDevice = nullptr;
 PFN_vkCreateInstance o_vkCreateInstance = nullptr;
 PFN_vkCreateWin32SurfaceKHR o_vkCreateWin32SurfaceKHR = nullptr;
 PFN_QueuePresentKHR o_QueuePresentKHR = nullptr;
@@ -132,28 +140,27 @@ static VkResult hkvkCreateDevice(VkPhysicalDevice physicalDevice, const VkDevice
     return result;
 }
 
-static VkResult hkvkQueuePresentKHR(VkQueue queue, VkPresentInfoKHR* pPresentInfo)
+static void hkvkDestroyDevice(VkDevice device, const VkAllocationCallbacks* pAllocator)
 {
     LOG_FUNC();
 
-    // get upscaler time
-    if (HooksVk::vkUpscaleTrig && HooksVk::queryPool != VK_NULL_HANDLE)
-    {
-        // Retrieve timestamps
-        uint64_t timestamps[2];
-        vkGetQueryPoolResults(_device, HooksVk::queryPool, 0, 2, sizeof(timestamps), timestamps, sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+    // Pipeline cache must be saved & destroyed while device is still valid
+    PipelineCache_Vk::DeviceDestroyed(device);
 
-        // Calculate elapsed time in milliseconds
-        double elapsedTimeMs = (timestamps[1] - timestamps[0]) * HooksVk::timeStampPeriod / 1e6;
+    o_vkDestroyDevice(device, pAllocator);
+}
 
-        if (elapsedTimeMs > 0.0 && elapsedTimeMs < 5000.0)
-        {
-            State::Instance().upscaleTimes.push_back(elapsedTimeMs);
-            State::Instance().upscaleTimes.pop_front();
-        }
+static VkResult hkvkQueuePresentKHR(VkQueue queue, VkPresentInfoKHR* pPresentInfo)
+{
+    LOG_FUNC();
 
-        HooksVk::vkUpscaleTrig = false;
-    }
+    Trace::NewFrame();
+
+    // Results of older frames are collected without waiting
+    GpuProfiler_Vk::EndFrame();
+    IniWatcher::ApplyPending();
+    DrsGovernor::Update();
+    StartupProfiler::NewFrame();
 
     State::Instance().swapchainApi = Vulkan;
 
@@ -169,6 +176,9 @@ static VkResult hkvkQueuePresentKHR(VkQueue queue, VkPresentInfoKHR* pPresentInf
     auto result = o_QueuePresentKHR(queue, pPresentInfo);
     State::Instance().vulkanCreatingSC = false;
 
+    // Present blocked until GPU & vsync allowed, next frame's GPU work starts after here
+    GpuProfiler_Vk::StartFrame(queue);
+
     LOG_FUNC_RESULT(result);
     return result;
 }
@@ -198,28 +208,15 @@ static VkResult hkvkCreateSwapchainKHR(VkDevice device, const VkSwapchainCreateI
     return result;
 }
 
-void HooksVk::HookVk(HMODULE vulkan1)
+void HooksVk::DeclareHooks()
 {
-    if (o_vkCreateDevice != nullptr)
-        return;
-
-    o_vkCreateDevice = (PFN_vkCreateDevice)GetProcAddress(vulkan1, "vkCreateDevice");
-    o_vkCreateInstance = (PFN_vkCreateInstance)GetProcAddress(vulkan1, "vkCreateInstance");
-    o_vkCreateWin32SurfaceKHR = (PFN_vkCreateWin32SurfaceKHR)GetProcAddress(vulkan1, "vkCreateWin32SurfaceKHR");
-
-    DetourTransactionBegin();
-    DetourUpdateThread(GetCurrentThread());
-
-    if (o_vkCreateDevice != nullptr)
-        DetourAttach(&(PVOID&)o_vkCreateDevice, hkvkCreateDevice);
-
-    if (o_vkCreateInstance != nullptr)
-        DetourAttach(&(PVOID&)o_vkCreateInstance, hkvkCreateInstance);
+    auto overlayMenu = []() { return Config::Instance()->OverlayMenu.value_or_default(); };
+    auto pipelineCache = []() { return Config::Instance()->VulkanPipelineCache.value_or_default(); };
 
-    if (o_vkCreateWin32SurfaceKHR != nullptr)
-        DetourAttach(&(PVOID&)o_vkCreateWin32SurfaceKHR, hkvkCreateWin32SurfaceKHR);
-
-    DetourTransactionCommit();
+    DECLARE_HOOK(ModuleKind::Vulkan, "vkCreateDevice", o_vkCreateDevice, hkvkCreateDevice, overlayMenu);
+    DECLARE_HOOK(ModuleKind::Vulkan, "vkCreateInstance", o_vkCreateInstance, hkvkCreateInstance, overlayMenu);
+    DECLARE_HOOK(ModuleKind::Vulkan, "vkCreateWin32SurfaceKHR", o_vkCreateWin32SurfaceKHR, hkvkCreateWin32SurfaceKHR, overlayMenu);
+    DECLARE_HOOK(ModuleKind::Vulkan, "vkDestroyDevice", o_vkDestroyDevice, hkvkDestroyDevice, pipelineCache);
 }
 
 void HooksVk::UnHookVk()
@@ -235,15 +232,6 @@ void HooksVk::UnHookVk()
         if (o_CreateSwapchainKHR != nullptr)
             DetourDetach(&(PVOID&)o_CreateSwapchainKHR, hkvkCreateSwapchainKHR);
 
-        if (o_vkCreateDevice != nullptr)
-            DetourDetach(&(PVOID&)o_vkCreateDevice, hkvkCreateDevice);
-
-        if (o_vkCreateInstance != nullptr)
-            DetourDetach(&(PVOID&)o_vkCreateInstance, hkvkCreateInstance);
-
-        if (o_vkCreateWin32SurfaceKHR != nullptr)
-            DetourDetach(&(PVOID&)o_vkCreateWin32SurfaceKHR, hkvkCreateWin32SurfaceKHR);
-
         DetourTransactionCommit();
     }
 
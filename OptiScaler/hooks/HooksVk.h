@@ -5,10 +5,7 @@
 
 namespace HooksVk
 {
-	inline VkQueryPool queryPool = VK_NULL_HANDLE;
-	inline double timeStampPeriod = 1.0;
-	inline bool vkUpscaleTrig = false;
-
-	void HookVk(HMODULE vulkan1);
+	// Declares vulkan-1 export hooks of overlay menu to HookRegistry
+	void DeclareHooks();
 	void UnHookVk();
 }
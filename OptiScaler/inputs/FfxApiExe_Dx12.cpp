@@ -99,6 +99,10 @@ static std::optional<float> GetQualityOverrideRatioFfx(const uint32_t input)
 {
     std::optional<float> output;
 
+    // DRS governor replaces quality ratios when it's active
+    if (auto drsRatio = DrsGovernor::UpscaleRatio(); drsRatio.has_value())
+        return drsRatio;
+
     auto sliderLimit = Config::Instance()->ExtendedLimits.value_or_default() ? 0.1f : 1.0f;
 
     if (Config::Instance()->UpscaleRatioOverrideEnabled.value_or_default() &&
@@ -1,8 +1,15 @@
 #pragma once
 
+#include "upscalers/FeatureCache.h"
+
 template <typename FeatureType>
 struct ContextData {
     std::unique_ptr<FeatureType> feature;
     NVSDK_NGX_Parameter* createParams = nullptr;
     int changeBackendCounter = 0;
-};
\ No newline at end of file
+
+    // Feature cache
+    FeatureCacheKey cacheKey;
+    bool outputResized = false;
+    bool resetHistory = false;
+};
@@ -12,8 +12,13 @@
 #include "upscalers/fsr2_212/FSR2Feature_Dx12_212.h"
 #include "upscalers/fsr31/FSR31Feature_Dx12.h"
 #include "upscalers/xess/XeSSFeature_Dx12.h"
+#include "upscalers/xess/XeSSPipelineCache.h"
+#include "upscalers/FeatureBuilder_Dx12.h"
 
 #include "hooks/HooksDx.h"
+#include "misc/GpuProfiler_Dx12.h"
+#include "misc/Trace.h"
+#include "misc/StartupProfiler.h"
 #include "proxies/FfxApi_Proxy.h"
 
 #include "shaders/depth_scale/DS_Dx12.h"
@@ -44,6 +49,219 @@ static bool inited = false;
 
 static DS_Dx12* DepthScale = nullptr;
 
+static std::unique_ptr<FeatureBuilder_Dx12> FeatureBuilder;
+static bool forceSyncBackendChange = false;
+
+static FeatureCache<IFeature_Dx12> CachedContexts;
+
+// backend selection
+// 0 : XeSS
+// 1 : FSR2.2
+// 2 : FSR2.1
+// 3 : DLSS
+// 4 : FSR3.1
+static const char* UpscalerNames[] = { "xess", "fsr22", "fsr21", "dlss", "fsr31" };
+
+static int UpscalerChoice(const std::string& InBackend)
+{
+    // DLSSD is not selectable
+    if (InBackend == "dlssd")
+        return -1;
+
+    for (int i = 1; i < std::size(UpscalerNames); i++)
+    {
+        if (InBackend == UpscalerNames[i])
+            return i;
+    }
+
+    return 0;
+}
+
+static std::unique_ptr<IFeature_Dx12> CreateUpscaler(const std::string& InBackend, unsigned int InHandleId, NVSDK_NGX_Parameter* InParameters)
+{
+    if (InBackend == "fsr22")
+    {
+        LOG_INFO("creating new FSR 2.2.1 feature");
+        return std::make_unique<FSR2FeatureDx12>(InHandleId, InParameters);
+    }
+
+    if (InBackend == "fsr21")
+    {
+        LOG_INFO("creating new FSR 2.1.2 feature");
+        return std::make_unique<FSR2FeatureDx12_212>(InHandleId, InParameters);
+    }
+
+    if (InBackend == "dlss")
+    {
+        LOG_INFO("creating new DLSS feature");
+        return std::make_unique<DLSSFeatureDx12>(InHandleId, InParameters);
+    }
+
+    if (InBackend == "dlssd")
+    {
+        LOG_INFO("creating new DLSSD feature");
+        return std::make_unique<DLSSDFeatureDx12>(InHandleId, InParameters);
+    }
+
+    if (InBackend == "fsr31")
+    {
+        LOG_INFO("creating new FSR 3.X feature");
+        return std::make_unique<FSR31FeatureDx12>(InHandleId, InParameters);
+    }
+
+    LOG_INFO("creating new XeSS feature");
+    return std::make_unique<XeSSFeatureDx12>(InHandleId, InParameters);
+}
+
+// DLSS/DLSSD contexts are owned by NGX and can't be cached
+static bool IsCacheable(const std::string& InBackend)
+{
+    return InBackend == "xess" || InBackend == "fsr21" || InBackend == "fsr22" || InBackend == "fsr31";
+}
+
+// Moves an inited feature to cache instead of destroying it
+static void ParkFeature(ContextData<IFeature_Dx12>* deviceContext)
+{
+    auto feature = deviceContext->feature.get();
+
+    if (feature == nullptr)
+        return;
+
+    if (shutdown || !feature->IsInited() || !IsCacheable(deviceContext->cacheKey.Backend))
+    {
+        deviceContext->feature.reset();
+        return;
+    }
+
+    feature->RestoreCreateResolution();
+
+    CachedContexts.Put(deviceContext->cacheKey, std::move(deviceContext->feature),
+                       Config::Instance()->ContextCacheSize.value_or_default(),
+                       (uint64_t)Config::Instance()->ContextCacheBudget.value_or_default() << 20);
+}
+
+// Takes a cached feature which was created with same parameters, checked before creating a new feature
+// Returns false when there is none and a new feature should be created
+static bool ReviveFeature(ContextData<IFeature_Dx12>* deviceContext, const std::string& InBackend, unsigned int InHandleId, NVSDK_NGX_Parameter* InParameters)
+{
+    if (!IsCacheable(InBackend))
+        return false;
+
+    auto cached = CachedContexts.Take(FeatureCacheKey::From(InBackend, InParameters));
+
+    if (cached == nullptr)
+        return false;
+
+    cached->ChangeHandle(InHandleId);
+    deviceContext->feature = std::move(cached);
+    deviceContext->resetHistory = true;
+
+    return true;
+}
+
+// Builds the new upscaler on a worker thread while current feature keeps rendering
+// Returns false when backend change should be done by the synchronous path
+static bool ChangeBackendAsync(unsigned int handleId, ContextData<IFeature_Dx12>* deviceContext, NVSDK_NGX_Parameter* InParameters)
+{
+    if (FeatureBuilder == nullptr)
+        FeatureBuilder = std::make_unique<FeatureBuilder_Dx12>();
+
+    if (!FeatureBuilder->IsBusy())
+    {
+        // Resolution changes (empty newBackend) and DLSS/DLSSD which need game's parameters stay synchronous
+        auto& newBackend = State::Instance().newBackend;
+        if (forceSyncBackendChange || !Config::Instance()->AsyncBackendSwitch.value_or_default() || deviceContext->changeBackendCounter != 0 ||
+            newBackend == "" || newBackend == "dlss" || newBackend == "dlssd" || deviceContext->feature == nullptr || !deviceContext->feature->IsInited())
+        {
+            forceSyncBackendChange = false;
+            return false;
+        }
+
+        auto dc = deviceContext->feature.get();
+        auto createParams = GetNGXParameters("OptiDx12");
+
+        createParams->Set(NVSDK_NGX_Parameter_DLSS_Feature_Create_Flags, dc->GetFeatureFlags());
+        createParams->Set(NVSDK_NGX_Parameter_Width, dc->RenderWidth());
+        createParams->Set(NVSDK_NGX_Parameter_Height, dc->RenderHeight());
+        createParams->Set(NVSDK_NGX_Parameter_OutWidth, dc->DisplayWidth());
+        createParams->Set(NVSDK_NGX_Parameter_OutHeight, dc->DisplayHeight());
+        createParams->Set(NVSDK_NGX_Parameter_PerfQualityValue, dc->PerfQualityValue());
+
+        std::string backend = newBackend;
+        auto factory = [backend, handleId, createParams]() { return CreateUpscaler(backend, handleId, createParams); };
+
+        if (!FeatureBuilder->Start(D3D12Device, handleId, backend, factory, createParams))
+        {
+            free(createParams);
+            return false;
+        }
+
+        LOG_INFO("changing backend to {0} asynchronously", backend);
+
+        // Config might be changed, cached features can't be trusted
+        CachedContexts.Clear();
+        deviceContext->createParams = createParams;
+        return true;
+    }
+
+    // Only one build at a time, other handles wait for it
+    if (FeatureBuilder->HandleId() != handleId)
+        return true;
+
+    auto status = FeatureBuilder->Poll();
+
+    if (status == FeatureBuilder_Dx12::Status::Building || status == FeatureBuilder_Dx12::Status::Executing)
+        return true;
+
+    if (status == FeatureBuilder_Dx12::Status::Failed)
+    {
+        LOG_ERROR("async build failed for {0}, retrying synchronously", FeatureBuilder->Backend());
+
+        FeatureBuilder->Reset();
+
+        if (deviceContext->createParams != nullptr)
+        {
+            free(deviceContext->createParams);
+            deviceContext->createParams = nullptr;
+        }
+
+        forceSyncBackendChange = true;
+        return false;
+    }
+
+    // Ready, swap features
+    if (FrameGen_Dx12::fgIsActive)
+    {
+        FrameGen_Dx12::StopAndDestroyFGContext(false, false);
+        State::Instance().FGchanged = true;
+    }
+
+    // Frames still in flight might use the old feature, it's destroyed after present queue passes them
+    FeatureBuilder_Dx12::Retire(std::move(deviceContext->feature));
+    deviceContext->feature = FeatureBuilder->Take();
+    deviceContext->cacheKey = FeatureCacheKey::From(FeatureBuilder->Backend(), deviceContext->feature.get());
+
+    int upscalerChoice = UpscalerChoice(FeatureBuilder->Backend());
+    Config::Instance()->Dx12Upscaler = UpscalerNames[upscalerChoice];
+    InParameters->Set("DLSSEnabler.Dx12Backend", upscalerChoice);
+
+    LOG_INFO("async init successful for {0}, upscaler changed", FeatureBuilder->Backend());
+
+    State::Instance().newBackend = "";
+    State::Instance().changeBackend[handleId] = false;
+    State::Instance().currentFeature = deviceContext->feature.get();
+    FrameGen_Dx12::fgTarget = 20;
+    evalCounter = 0;
+
+    if (deviceContext->createParams != nullptr)
+    {
+        free(deviceContext->createParams);
+        deviceContext->createParams = nullptr;
+    }
+
+    return true;
+}
+
 static void ResourceBarrier(ID3D12GraphicsCommandList* InCommandList, ID3D12Resource* InResource, D3D12_RESOURCE_STATES InBeforeState, D3D12_RESOURCE_STATES InAfterState)
 {
     D3D12_RESOURCE_BARRIER barrier = {};
@@ -267,23 +485,14 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_Init_Ext(unsigned long long InApp
 
     D3D12Device = InDevice;
 
+    // Read XeSS pipeline cache while game is loading
+    if (Config::Instance()->BuildPipelines.value_or_default() && Config::Instance()->XeSSUsePipelineCache.value_or_default())
+        XeSSPipelineCache::Preload();
+
     State::Instance().api = DX12;
 
     if (!State::Instance().isWorkingAsNvngx)
-    {
-        // Create query heap for timestamp queries
-        D3D12_QUERY_HEAP_DESC queryHeapDesc = {};
-        queryHeapDesc.Count = 2; // Start and End timestamps
-        queryHeapDesc.NodeMask = 0;
-        queryHeapDesc.Type = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
-        auto result = InDevice->CreateQueryHeap(&queryHeapDesc, IID_PPV_ARGS(&HooksDx::queryHeap));
-
-        // Create a readback buffer to retrieve timestamp data
-        D3D12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(2 * sizeof(UINT64));
-        D3D12_HEAP_PROPERTIES heapProps = {};
-        heapProps.Type = D3D12_HEAP_TYPE_READBACK;
-        result = InDevice->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &bufferDesc, D3D12_RESOURCE_STATE_COPY_DEST, nullptr, IID_PPV_ARGS(&HooksDx::readbackBuffer));
-    }
+        GpuProfiler_Dx12::Init(InDevice);
 
     // early hooking for signatures
     if (orgSetComputeRootSignature == nullptr)
@@ -433,6 +642,10 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_Shutdown(void)
             NVSDK_NGX_D3D12_ReleaseFeature(val.feature->Handle());
     }
 
+    FeatureBuilder.reset();
+    CachedContexts.Clear();
+    XeSSPipelineCache::Release();
+
     Dx12Contexts.clear();
     D3D12Device = nullptr;
 
@@ -586,6 +799,7 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_DestroyParameters(NVSDK_NGX_Param
 
 NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_CreateFeature(ID3D12GraphicsCommandList* InCmdList, NVSDK_NGX_Feature InFeatureID, NVSDK_NGX_Parameter* InParameters, NVSDK_NGX_Handle** OutHandle)
 {
+    STARTUP_ZONE(StartupPhase::FirstCreateFeature);
     LOG_FUNC();
 
     if (InCmdList != nullptr)
@@ -688,7 +902,14 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_CreateFeature(ID3D12GraphicsComma
             LOG_INFO("DLSS Enabler upscalerChoice: {0}", upscalerChoice);
         }
 
-        if (upscalerChoice == 3)
+        // Released context with same parameters might be still alive
+        bool revived = upscalerChoice >= 0 && upscalerChoice < std::size(UpscalerNames) &&
+                       ReviveFeature(&Dx12Contexts[handleId], UpscalerNames[upscalerChoice], handleId, InParameters);
+
+        if (revived)
+            Config::Instance()->Dx12Upscaler = UpscalerNames[upscalerChoice];
+
+        if (!revived && upscalerChoice == 3)
         {
             Dx12Contexts[handleId].feature = std::make_unique<DLSSFeatureDx12>(handleId, InParameters);
 
@@ -710,7 +931,7 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_CreateFeature(ID3D12GraphicsComma
             }
         }
 
-        if (upscalerChoice == 0)
+        if (!revived && upscalerChoice == 0)
         {
             Dx12Contexts[handleId].feature = std::make_unique<XeSSFeatureDx12>(handleId, InParameters);
 
@@ -732,7 +953,7 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_CreateFeature(ID3D12GraphicsComma
             }
         }
 
-        if (upscalerChoice == 4)
+        if (!revived && upscalerChoice == 4)
         {
             Dx12Contexts[handleId].feature = std::make_unique<FSR31FeatureDx12>(handleId, InParameters);
 
@@ -753,13 +974,13 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_CreateFeature(ID3D12GraphicsComma
             }
         }
 
-        if (upscalerChoice == 1)
+        if (!revived && upscalerChoice == 1)
         {
             Config::Instance()->Dx12Upscaler = "fsr22";
             LOG_INFO("creating new FSR 2.2.1 feature");
             Dx12Contexts[handleId].feature = std::make_unique<FSR2FeatureDx12>(handleId, InParameters);
         }
-        else if (upscalerChoice == 2)
+        else if (!revived && upscalerChoice == 2)
         {
             Config::Instance()->Dx12Upscaler = "fsr21";
             LOG_INFO("creating new FSR 2.1.2 feature");
@@ -775,6 +996,9 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_CreateFeature(ID3D12GraphicsComma
         Dx12Contexts[handleId].feature = std::make_unique<DLSSDFeatureDx12>(handleId, InParameters);
     }
 
+    Dx12Contexts[handleId].cacheKey = FeatureCacheKey::From(InFeatureID == NVSDK_NGX_Feature_SuperSampling ? Config::Instance()->Dx12Upscaler.value_or_default() : "dlssd",
+                                                            Dx12Contexts[handleId].feature.get());
+
     auto deviceContext = Dx12Contexts[handleId].feature.get();
 
     if (*OutHandle == nullptr)
@@ -798,20 +1022,30 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_CreateFeature(ID3D12GraphicsComma
 
 #pragma endregion
 
-    State::Instance().AutoExposure.reset();
-    State::Instance().DisplaySizeMV.reset();
-
-    if (deviceContext->Init(D3D12Device, InCmdList, InParameters))
+    if (deviceContext->IsInited())
     {
+        LOG_INFO("using cached {0} feature", deviceContext->Name());
         State::Instance().currentFeature = deviceContext;
         evalCounter = 0;
         FrameGen_Dx12::fgTarget = 10;
     }
     else
     {
-        LOG_ERROR("CreateFeature failed, returning to FSR 2.1.2 upscaler");
-        State::Instance().newBackend = "fsr21";
-        State::Instance().changeBackend[handleId] = true;
+        State::Instance().AutoExposure.reset();
+        State::Instance().DisplaySizeMV.reset();
+
+        if (deviceContext->Init(D3D12Device, InCmdList, InParameters))
+        {
+            State::Instance().currentFeature = deviceContext;
+            evalCounter = 0;
+            FrameGen_Dx12::fgTarget = 10;
+        }
+        else
+        {
+            LOG_ERROR("CreateFeature failed, returning to FSR 2.1.2 upscaler");
+            State::Instance().newBackend = "fsr21";
+            State::Instance().changeBackend[handleId] = true;
+        }
     }
 
     if (Config::Instance()->RestoreComputeSignature.value_or_default() || Config::Instance()->RestoreGraphicSignature.value_or_default())
@@ -887,6 +1121,18 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_ReleaseFeature(NVSDK_NGX_Handle*
         return DLSSGMod::D3D12_ReleaseFeature(InHandle);
     }
 
+    if (FeatureBuilder != nullptr && FeatureBuilder->IsBusy() && FeatureBuilder->HandleId() == handleId)
+    {
+        // Worker is joined by Reset, parameters of async build are not used anymore
+        FeatureBuilder->Reset();
+
+        if (auto& context = Dx12Contexts[handleId]; context.createParams != nullptr)
+        {
+            free(context.createParams);
+            context.createParams = nullptr;
+        }
+    }
+
     if (auto deviceContext = Dx12Contexts[handleId].feature.get(); deviceContext != nullptr)
     {
         if (deviceContext == State::Instance().currentFeature)
@@ -895,7 +1141,7 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_ReleaseFeature(NVSDK_NGX_Handle*
             deviceContext->Shutdown();
         }
 
-        Dx12Contexts[handleId].feature.reset();
+        ParkFeature(&Dx12Contexts[handleId]);
         auto it = std::find_if(Dx12Contexts.begin(), Dx12Contexts.end(), [&handleId](const auto& p) { return p.first == handleId; });
         Dx12Contexts.erase(it);
     }
@@ -948,6 +1194,9 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_GetFeatureRequirements(IDXGIAdapt
 
 NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCommandList* InCmdList, const NVSDK_NGX_Handle* InFeatureHandle, NVSDK_NGX_Parameter* InParameters, PFN_NVSDK_NGX_ProgressCallback InCallback)
 {
+    TRACE_ZONE("EvaluateFeature");
+    STARTUP_ZONE(StartupPhase::FirstEvaluate);
+
     if (InFeatureHandle == nullptr)
     {
         LOG_DEBUG("InFeatureHandle is null");
@@ -1160,12 +1409,19 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
 
         // FSR 3.1 supports upscaleSize that doesn't need reinit to change output resolution
         if (!std::string(feature->Name()).starts_with("FSR 3.1") && feature->Name() != "FSR3 w/Dx12" && feature->UpdateOutputResolution(InParameters))
+        {
             State::Instance().changeBackend[handleId] = true;
+            deviceContext->outputResized = true;
+        }
     }
 
-    // Change backend
-    if (State::Instance().changeBackend[handleId])
+    // Change backend, async path keeps rendering with current feature until new one is ready
+    if (State::Instance().changeBackend[handleId] && !ChangeBackendAsync(handleId, deviceContext, InParameters))
     {
+        // Only output resolution changes keep current feature in cache, other reinits might be caused by config changes
+        bool parkFeature = deviceContext->outputResized && State::Instance().newBackend == "";
+        deviceContext->outputResized = false;
+
         if (State::Instance().newBackend == "" || (!Config::Instance()->DLSSEnabled.value_or_default() && State::Instance().newBackend == "dlss"))
             State::Instance().newBackend = Config::Instance()->Dx12Upscaler.value_or_default();
 
@@ -1202,17 +1458,28 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
 
                 dc = nullptr;
 
-                if (State::Instance().gameQuirk == SplitFiction) {
-                    LOG_DEBUG("sleeping before reset of current feature for 100ms (Split Fiction)");
-                    std::this_thread::sleep_for(std::chrono::milliseconds(100)); 
+                if (parkFeature)
+                {
+                    // Feature is not destroyed, no need to wait for GPU
+                    ParkFeature(deviceContext);
                 }
-                else 
+                else
                 {
-                    LOG_DEBUG("sleeping before reset of current feature for 1000ms");
-                    std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+                    CachedContexts.Clear();
+
+                    if (State::Instance().gameQuirk == SplitFiction) {
+                        LOG_DEBUG("sleeping before reset of current feature for 100ms (Split Fiction)");
+                        std::this_thread::sleep_for(std::chrono::milliseconds(100)); 
+                    }
+                    else 
+                    {
+                        LOG_DEBUG("sleeping before reset of current feature for 1000ms");
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+                    }
+
+                    deviceContext->feature.reset();
                 }
 
-                deviceContext->feature.reset();
                 deviceContext->feature = nullptr;
                 //auto it = std::find_if(Dx12Contexts.begin(), Dx12Contexts.end(), [&handleId](const auto& p) { return p.first == handleId; });
                 //Dx12Contexts.erase(it);
@@ -1243,55 +1510,16 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
         // create new feature
         if (deviceContext->changeBackendCounter == 2)
         {
-            // backend selection
-            // 0 : XeSS
-            // 1 : FSR2.2
-            // 2 : FSR2.1
-            // 3 : DLSS
-            // 4 : FSR3.1
-            int upscalerChoice = -1;
-
             // prepare new upscaler
-            if (State::Instance().newBackend == "fsr22")
-            {
-                Config::Instance()->Dx12Upscaler = "fsr22";
-                LOG_INFO("creating new FSR 2.2.1 feature");
-                deviceContext->feature = std::make_unique<FSR2FeatureDx12>(handleId, deviceContext->createParams);
-                upscalerChoice = 1;
-            }
-            else if (State::Instance().newBackend == "fsr21")
-            {
-                Config::Instance()->Dx12Upscaler = "fsr21";
-                LOG_INFO("creating new FSR 2.1.2 feature");
-                deviceContext->feature = std::make_unique<FSR2FeatureDx12_212>(handleId, deviceContext->createParams);
-                upscalerChoice = 2;
-            }
-            else if (State::Instance().newBackend == "dlss")
-            {
-                Config::Instance()->Dx12Upscaler = "dlss";
-                LOG_INFO("creating new DLSS feature");
-                deviceContext->feature = std::make_unique<DLSSFeatureDx12>(handleId, deviceContext->createParams);
-                upscalerChoice = 3;
-            }
-            else if (State::Instance().newBackend == "dlssd")
-            {
-                LOG_INFO("creating new DLSSD feature");
-                deviceContext->feature = std::make_unique<DLSSDFeatureDx12>(handleId, deviceContext->createParams);
-            }
-            else if (State::Instance().newBackend == "fsr31")
-            {
-                Config::Instance()->Dx12Upscaler = "fsr31";
-                LOG_INFO("creating new FSR 3.X feature");
-                deviceContext->feature = std::make_unique<FSR31FeatureDx12>(handleId, deviceContext->createParams);
-                upscalerChoice = 4;
-            }
-            else
-            {
-                Config::Instance()->Dx12Upscaler = "xess";
-                LOG_INFO("creating new XeSS feature");
-                deviceContext->feature = std::make_unique<XeSSFeatureDx12>(handleId, deviceContext->createParams);
-                upscalerChoice = 0;
-            }
+            int upscalerChoice = UpscalerChoice(State::Instance().newBackend);
+
+            if (upscalerChoice >= 0)
+                Config::Instance()->Dx12Upscaler = UpscalerNames[upscalerChoice];
+
+            if (!ReviveFeature(deviceContext, State::Instance().newBackend, handleId, deviceContext->createParams))
+                deviceContext->feature = CreateUpscaler(State::Instance().newBackend, handleId, deviceContext->createParams);
+
+            deviceContext->cacheKey = FeatureCacheKey::From(State::Instance().newBackend, deviceContext->feature.get());
 
             if (upscalerChoice >= 0)
                 InParameters->Set("DLSSEnabler.Dx12Backend", upscalerChoice);
@@ -1302,7 +1530,7 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
         // init feature
         if (deviceContext->changeBackendCounter == 3)
         {
-            auto initResult = deviceContext->feature->Init(D3D12Device, InCmdList, deviceContext->createParams);
+            auto initResult = deviceContext->feature->IsInited() || deviceContext->feature->Init(D3D12Device, InCmdList, deviceContext->createParams);
 
             deviceContext->changeBackendCounter = 0;
 
@@ -1533,6 +1761,8 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
 
         LOG_DEBUG("(FG) copy buffers for fgUpscaledImage[{}], frame: {}", frameIndex, deviceContext->feature->FrameCount());
 
+        GpuProfiler_Dx12::Begin(D3D12Device, commandList, GpuPass::FGCopy);
+
         InParameters->Get(NVSDK_NGX_Parameter_Jitter_Offset_X, &FrameGen_Dx12::jitterX);
         InParameters->Get(NVSDK_NGX_Parameter_Jitter_Offset_Y, &FrameGen_Dx12::jitterY);
 
@@ -1608,6 +1838,8 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
             }
         }
 
+        GpuProfiler_Dx12::End(commandList, GpuPass::FGCopy);
+
 #ifdef USE_COPY_QUEUE_FOR_FG
         auto result = FrameGen_Dx12::fgCopyCommandList[frameIndex]->Close();
         ID3D12CommandList* cl[] = { nullptr };
@@ -1627,29 +1859,30 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
         LOG_DEBUG("(FG) copy buffers done, frame: {0}", deviceContext->feature->FrameCount());
     }
 
-    // Record the first timestamp
     if (!State::Instance().isWorkingAsNvngx)
-        InCmdList->EndQuery(HooksDx::queryHeap, D3D12_QUERY_TYPE_TIMESTAMP, 0);
+        GpuProfiler_Dx12::Begin(D3D12Device, InCmdList, GpuPass::Upscale);
+
+    // Revived features have history of another resolution
+    if (deviceContext->resetHistory)
+    {
+        InParameters->Set(NVSDK_NGX_Parameter_Reset, 1);
+        deviceContext->resetHistory = false;
+    }
 
     // Run upscaler
     auto evalResult = deviceContext->feature->Evaluate(InCmdList, InParameters);
 
-    // Record the second timestamp 
-    if (!State::Instance().isWorkingAsNvngx)
-    {
-        InCmdList->EndQuery(HooksDx::queryHeap, D3D12_QUERY_TYPE_TIMESTAMP, 1);
+    // Feature is only destroyed after GPU is done with this command list
+    FeatureBuilder_Dx12::MarkEvaluated(deviceContext->feature.get(), InCmdList);
 
-        // Resolve the queries to the readback buffer
-        InCmdList->ResolveQueryData(HooksDx::queryHeap, D3D12_QUERY_TYPE_TIMESTAMP, 0, 2, HooksDx::readbackBuffer, 0);
-    }
+    if (!State::Instance().isWorkingAsNvngx)
+        GpuProfiler_Dx12::End(InCmdList, GpuPass::Upscale);
 
     NVSDK_NGX_Result methodResult = NVSDK_NGX_Result_Fail;
 
     // FG Dispatch
     if (evalResult)
     {
-        HooksDx::dx12UpscaleTrig = true;
-
         // FG Dispatch
         if (FrameGen_Dx12::fgIsActive && Config::Instance()->FGType.value_or_default() == FGType::OptiFG && Config::Instance()->OverlayMenu.value_or_default() &&
             Config::Instance()->FGEnabled.value_or_default() && FrameGen_Dx12::fgTarget < deviceContext->feature->FrameCount() &&
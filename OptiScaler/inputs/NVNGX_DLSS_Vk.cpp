@@ -16,6 +16,8 @@
 #include "upscalers/xess/XeSSFeature_Vk.h"
 
 #include "hooks/HooksVk.h"
+#include "misc/GpuProfiler_Vk.h"
+#include "misc/StartupProfiler.h"
 
 #include <ankerl/unordered_dense.h>
 #include <vulkan/vulkan.hpp>
@@ -165,16 +167,7 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_VULKAN_Init_Ext2(unsigned long long InA
 
     State::Instance().api = Vulkan;
 
-    VkQueryPoolCreateInfo queryPoolInfo = {};
-    queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
-    queryPoolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
-    queryPoolInfo.queryCount = 2; // Start and End timestamps
-
-    vkCreateQueryPool(InDevice, &queryPoolInfo, nullptr, &HooksVk::queryPool);
-
-    VkPhysicalDeviceProperties deviceProperties;
-    vkGetPhysicalDeviceProperties(InPD, &deviceProperties);
-    HooksVk::timeStampPeriod = deviceProperties.limits.timestampPeriod;
+    GpuProfiler_Vk::Init(InDevice, InPD);
 
     return NVSDK_NGX_Result_Success;
 }
@@ -471,6 +464,8 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_VULKAN_GetScratchBufferSize(NVSDK_NGX_F
 
 NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_VULKAN_CreateFeature1(VkDevice InDevice, VkCommandBuffer InCmdList, NVSDK_NGX_Feature InFeatureID, NVSDK_NGX_Parameter* InParameters, NVSDK_NGX_Handle** OutHandle)
 {
+    STARTUP_ZONE(StartupPhase::FirstCreateFeature);
+
     if (DLSSGMod::isVulkanAvailable() && InFeatureID == NVSDK_NGX_Feature_FrameGeneration)
     {
         auto result = DLSSGMod::VULKAN_CreateFeature1(InDevice, InCmdList, InFeatureID, InParameters, OutHandle);
@@ -721,6 +716,8 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_VULKAN_ReleaseFeature(NVSDK_NGX_Handle*
 
 NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_VULKAN_EvaluateFeature(VkCommandBuffer InCmdList, const NVSDK_NGX_Handle* InFeatureHandle, NVSDK_NGX_Parameter* InParameters, PFN_NVSDK_NGX_ProgressCallback InCallback)
 {
+    STARTUP_ZONE(StartupPhase::FirstEvaluate);
+
     if (InFeatureHandle == nullptr)
     {
         LOG_DEBUG("InFeatureHandle is null");
@@ -1016,14 +1013,11 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_VULKAN_EvaluateFeature(VkCommandBuffer
 
     State::Instance().renderMenu = true;
 
-    // Record the first timestamp (before FSR2)
-    vkCmdWriteTimestamp(InCmdList, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, HooksVk::queryPool, 0);
+    GpuProfiler_Vk::Begin(vkDevice, InCmdList, GpuPass::Upscale);
 
     auto upscaleResult = deviceContext->Evaluate(InCmdList, InParameters);
 
-    // Record the second timestamp (after FSR2)
-    vkCmdWriteTimestamp(InCmdList, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, HooksVk::queryPool, 1);
-    HooksVk::vkUpscaleTrig = true;
+    GpuProfiler_Vk::End(InCmdList, GpuPass::Upscale);
 
     return upscaleResult ? NVSDK_NGX_Result_Success : NVSDK_NGX_Result_Fail;
 }
@@ -2,6 +2,7 @@
 
 #include "XeSS_Base.h"
 
+#include <misc/DrsGovernor.h>
 #include <proxies/XeSS_Proxy.h>
 #include <nvsdk_ngx_vk.h>
 
@@ -9,6 +10,10 @@ static std::optional<float> GetQualityOverrideRatio(const xess_quality_settings_
 {
     std::optional<float> output;
 
+    // DRS governor replaces quality ratios when it's active
+    if (auto drsRatio = DrsGovernor::UpscaleRatio(); drsRatio.has_value())
+        return drsRatio;
+
     auto sliderLimit = Config::Instance()->ExtendedLimits.value_or_default() ? 0.1f : 1.0f;
 
     if (Config::Instance()->UpscaleRatioOverrideEnabled.value_or_default() &&
@@ -3,47 +3,113 @@
 #include "imgui/misc/freetype/imgui_freetype.h"
 #include "menu_base.h"
 #include <Config.h>
+#include <misc/FontAtlasCache.h>
+
+#include <mutex>
+
+// Decompressed once, atlases copy it while adding fonts
+static const std::vector<unsigned char>& HackFontData()
+{
+    static std::vector<unsigned char> data;
+    static std::once_flag once;
+
+    std::call_once(once, []()
+                   {
+                       ImFontAtlas atlas;
+                       ImFontConfig fontConfig;
+
+                       if (atlas.AddFontFromMemoryCompressedBase85TTF(hack_compressed_compressed_data_base85, 14.0f, &fontConfig) != nullptr)
+                       {
+                           auto& config = atlas.ConfigData[0];
+                           data.assign((unsigned char*)config.FontData, (unsigned char*)config.FontData + config.FontDataSize);
+                       }
+                   });
+
+    return data;
+}
 
 // TODO: maybe a vector of fonts?
-void MenuBase::LoadCustomFonts(ImGuiIO& io, float menuScale)
+bool MenuBase::AddFonts(ImFontAtlas* atlas, float menuScale)
 {
-    LOG_INFO("Loading fonts with scale of: {}", menuScale);
-    ImFontAtlas* atlas = io.Fonts;
-    atlas->Clear();
     constexpr float fontSize = 14.0f; // just changing this doesn't make other elements scale ideally
 
+    auto& fontData = HackFontData();
+
+    if (fontData.empty())
+        return false;
+
     // This automatically becomes the next default font
     ImFontConfig fontConfig;
+    fontConfig.FontDataOwnedByAtlas = false;
     //fontConfig.FontBuilderFlags |= ImGuiFreeTypeBuilderFlags_LightHinting;
-    font = atlas->AddFontFromMemoryCompressedBase85TTF(hack_compressed_compressed_data_base85, std::round(menuScale * fontSize), &fontConfig);
-    if (!font)
+    if (!atlas->AddFontFromMemoryTTF((void*)fontData.data(), (int)fontData.size(), std::round(menuScale * fontSize), &fontConfig))
     {
         LOG_ERROR("Couldn't create font");
-        return;
+        return false;
     }
 
     ImFontConfig scaledFontConfig;
+    scaledFontConfig.FontDataOwnedByAtlas = false;
     constexpr auto scaledFontScale = 3.0f;
     //fontConfig.FontBuilderFlags |= ImGuiFreeTypeBuilderFlags_LightHinting;
-    scaledFont = atlas->AddFontFromMemoryCompressedBase85TTF(hack_compressed_compressed_data_base85, std::round(scaledFontScale * menuScale * fontSize), &scaledFontConfig);
-    if (!scaledFont)
+    if (!atlas->AddFontFromMemoryTTF((void*)fontData.data(), (int)fontData.size(), std::round(scaledFontScale * menuScale * fontSize), &scaledFontConfig))
     {
         LOG_ERROR("Couldn't create scaled font");
-        return;
+        return false;
     }
 
+    return true;
+}
+
+void MenuBase::LoadCustomFonts(ImGuiIO& io, float menuScale)
+{
+    LOG_INFO("Loading fonts with scale of: {}", menuScale);
+    ImFontAtlas* atlas = io.Fonts;
+    atlas->Clear();
+    atlas->FontBuilderIO = Config::Instance()->UseFontCache.value_or_default() ? FontAtlasCache::BuilderIO() : nullptr;
+
+    font = nullptr;
+    scaledFont = nullptr;
+
+    if (!AddFonts(atlas, menuScale))
+        return;
+
+    font = atlas->Fonts[0];
+    scaledFont = atlas->Fonts[1];
+
     io.Fonts->Build();
 }
 
 void MenuBase::UpdateFonts(ImGuiIO& io, float rasterizerDensity)
 {
     static float lastDensity = 0.0f;
+    static float asyncDensity = 0.0f;
 
     if (lastDensity != rasterizerDensity || io.Fonts->Fonts.empty())
     {
         if (Config::Instance()->UseHQFont.value_or_default())
+        {
+            // Current fonts are used while atlas of the new scale is rasterized on a worker thread
+            if (!io.Fonts->Fonts.empty() && Config::Instance()->UseFontCache.value_or_default())
+            {
+                if (FontAtlasCache::IsBuilding())
+                    return;
+
+                auto setup = [rasterizerDensity](ImFontAtlas* atlas) { return AddFonts(atlas, rasterizerDensity); };
+
+                // If the worker couldn't cache it, fonts are built here
+                if (asyncDensity != rasterizerDensity && !FontAtlasCache::IsCached(setup))
+                {
+                    asyncDensity = rasterizerDensity;
+                    FontAtlasCache::BuildAsync(setup);
+                    return;
+                }
+            }
+
             LoadCustomFonts(io, rasterizerDensity);
+        }
         
         lastDensity = rasterizerDensity;
+        asyncDensity = 0.0f;
     }
 }
\ No newline at end of file
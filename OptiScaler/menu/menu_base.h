@@ -4,6 +4,7 @@
 
 class MenuBase
 {
+	static bool AddFonts(ImFontAtlas* atlas, float menuScale);
 	static void LoadCustomFonts(ImGuiIO& io, float menuScale);
 public:
     static void UpdateFonts(ImGuiIO& io, float rasterizerDensity);
@@ -7,6 +7,12 @@
 #include <nvapi/ReflexHooks.h>
 #include <proxies/FfxApi_Proxy.h>
 #include <hooks/HooksDx.h>
+#include <misc/DrsGovernor.h>
+#include <misc/GpuProfiler_Dx12.h>
+#include <misc/GpuProfiler_Vk.h>
+#include <misc/RootSignatureCache.h>
+#include <misc/StartupProfiler.h>
+#include <misc/Trace.h>
 
 #include <imgui/imgui_internal.h>
 
@@ -896,11 +902,59 @@ static void MenuSizeCheck(ImGuiIO io)
 
 static double lastTime = 0.0;
 
+void MenuCommon::CacheOverlay(ImDrawData* InDrawData)
+{
+    ClearOverlayCache();
+
+    if (InDrawData == nullptr || !InDrawData->Valid)
+        return;
+
+    // Draw lists are owned by ImGui context and reused next frame, keep copies
+    _overlayDrawData = *InDrawData;
+
+    for (int i = 0; i < _overlayDrawData.CmdLists.Size; i++)
+        _overlayDrawData.CmdLists[i] = InDrawData->CmdLists[i]->CloneOutput();
+
+    _overlayFontTexture = ImGui::GetIO().Fonts->GetTexID();
+    _overlayCached = true;
+}
+
+void MenuCommon::ClearOverlayCache()
+{
+    for (int i = 0; i < _overlayDrawData.CmdLists.Size; i++)
+        IM_DELETE(_overlayDrawData.CmdLists[i]);
+
+    _overlayDrawData.Clear();
+    _overlayCached = false;
+}
+
+void MenuCommon::Render()
+{
+    if (_overlayFromCache)
+        return;
+
+    ImGui::Render();
+
+    if (_overlayCacheable)
+        CacheOverlay(ImGui::GetDrawData());
+}
+
+ImDrawData* MenuCommon::DrawData()
+{
+    if (_overlayFromCache)
+        return &_overlayDrawData;
+
+    return ImGui::GetDrawData();
+}
+
 bool MenuCommon::RenderMenu()
 {
     if (!_isInited)
         return false;
 
+    _overlayFromCache = false;
+    _overlayCacheable = false;
+
     // FPS & frame time calculation
     auto now = Util::MillisecondsNow();
     double frameTime = 0.0;
@@ -914,8 +968,8 @@ bool MenuCommon::RenderMenu()
 
     lastTime = now;
 
-    State::Instance().frameTimes.pop_front();
-    State::Instance().frameTimes.push_back(frameTime);
+    State::Instance().AddFrameTime(frameTime);
+
 
     ImGuiIO& io = ImGui::GetIO(); (void)io;
     auto currentFeature = State::Instance().currentFeature;
@@ -926,16 +980,21 @@ bool MenuCommon::RenderMenu()
         {
             Config::Instance()->ShowFps = !Config::Instance()->ShowFps.value_or_default();
             inputFps = false;
+            ClearOverlayCache();
             return false;
         }
 
         if (inputFpsCycle && Config::Instance()->ShowFps.value_or_default())
+        {
             Config::Instance()->FpsOverlayType = (Config::Instance()->FpsOverlayType.value_or_default() + 1) % 5;
+            ClearOverlayCache();
+        }
 
         if (inputMenu)
         {
             inputMenu = false;
             _isVisible = !_isVisible;
+            ClearOverlayCache();
 
             LOG_DEBUG("Menu key pressed, {0}", _isVisible ? "opening ImGui" : "closing ImGui");
 
@@ -990,36 +1049,39 @@ bool MenuCommon::RenderMenu()
     // If Fps overlay is visible
     if (Config::Instance()->ShowFps.value_or_default())
     {
-        float frameCnt = 0;
-        for (size_t i = 299; i > 199; i--)
+        // When menu is closed, redraw last overlay until it's time to rebuild it
+        auto refreshRate = Config::Instance()->FpsOverlayRefreshRate.value_or_default();
+        _overlayCacheable = !_isVisible && refreshRate > 0;
+
+        if (_overlayCacheable && _overlayCached && (now - _overlayBuildTime) < (1000.0 / refreshRate) &&
+            _overlayScreenWidth == State::Instance().screenWidth && _overlayScreenHeight == State::Instance().screenHeight &&
+            _overlayHdr == State::Instance().isHdrActive && _overlayFontTexture == io.Fonts->GetTexID() && !io.Fonts->IsDirty())
         {
-            if (State::Instance().frameTimes[i] > 0.0)
-            {
-                frameTime += State::Instance().frameTimes[i];
-                frameCnt++;
-            }
+            _overlayFromCache = true;
+            return true;
         }
 
-        frameTime /= frameCnt;
-        frameRate = 1000.0 / frameTime;
+        if (_overlayCacheable)
+        {
+            _overlayBuildTime = now;
+            _overlayScreenWidth = State::Instance().screenWidth;
+            _overlayScreenHeight = State::Instance().screenHeight;
+            _overlayHdr = State::Instance().isHdrActive;
+        }
+
+        if (State::Instance().frameTimes.RecentCount > 0)
+        {
+            frameTime = State::Instance().frameTimes.RecentAverage();
+            frameRate = 1000.0 / frameTime;
+        }
 
         ImGui_ImplWin32_NewFrame();
         MenuHdrCheck(io);
         MenuSizeCheck(io);
         ImGui::NewFrame();
 
-        std::vector<float> frameTimeArray(State::Instance().frameTimes.begin(), State::Instance().frameTimes.end());
-        std::vector<float> upscalerFrameTimeArray(State::Instance().upscaleTimes.begin(), State::Instance().upscaleTimes.end());
-        float averageFrameTime = 0.0f;
-        float averageUpscalerFT = 0.0f;
-
-        for (size_t i = 0; i < frameTimeArray.size(); i++)
-        {
-            averageFrameTime += frameTimeArray[i];
-            averageUpscalerFT += upscalerFrameTimeArray[i];
-        }
-        averageFrameTime /= frameTimeArray.size();
-        averageUpscalerFT /= frameTimeArray.size();
+        float averageFrameTime = (float)State::Instance().frameTimes.Average();
+        float averageUpscalerFT = (float)State::Instance().upscaleTimes.Average();
 
         // Set overlay position
         ImGui::SetNextWindowPos(overlayPosition, ImGuiCond_Always);
@@ -1114,7 +1176,7 @@ bool MenuCommon::RenderMenu()
                     ImGui::Spacing();
                 }
 
-                ImGui::Text("Frame Time: %5.2f ms, Avg: %5.2f ms", State::Instance().frameTimes.back(), averageFrameTime);
+                ImGui::Text("Frame Time: %5.2f ms, Avg: %5.2f ms", State::Instance().frameTimes.Last(), averageFrameTime);
             }
 
             ImVec2 plotSize;
@@ -1130,8 +1192,10 @@ bool MenuCommon::RenderMenu()
                     ImGui::SameLine(0.0f, 0.0f);
 
                 // Graph of frame times
-                ImGui::PlotLines("##FrameTimeGraph", frameTimeArray.data(), static_cast<int>(frameTimeArray.size()), 0, nullptr,
-                                 *std::min_element(frameTimeArray.begin(), frameTimeArray.end()) * 0.9f, *std::max_element(frameTimeArray.begin(), frameTimeArray.end()) * 1.1f, plotSize);
+                _frameTimePlot.assign(State::Instance().frameTimes.Values.begin(), State::Instance().frameTimes.Values.end());
+                auto [minFrameTime, maxFrameTime] = std::minmax_element(_frameTimePlot.begin(), _frameTimePlot.end());
+                ImGui::PlotLines("##FrameTimeGraph", _frameTimePlot.data(), static_cast<int>(_frameTimePlot.size()), 0, nullptr,
+                                 *minFrameTime * 0.9f, *maxFrameTime * 1.1f, plotSize);
             }
 
             if (Config::Instance()->FpsOverlayType.value_or_default() > 2)
@@ -1147,7 +1211,7 @@ bool MenuCommon::RenderMenu()
                     ImGui::Spacing();
                 }
 
-                ImGui::Text("Upscaler Time: %5.2f ms, Avg: %5.2f ms", State::Instance().upscaleTimes.back(), averageUpscalerFT);
+                ImGui::Text("Upscaler Time: %5.2f ms, Avg: %5.2f ms", State::Instance().upscaleTimes.Last(), averageUpscalerFT);
             }
 
             if (Config::Instance()->FpsOverlayType.value_or_default() > 3)
@@ -1156,8 +1220,10 @@ bool MenuCommon::RenderMenu()
                     ImGui::SameLine(0.0f, 0.0f);
 
                 // Graph of upscaler times
-                ImGui::PlotLines("##UpscalerFrameTimeGraph", upscalerFrameTimeArray.data(), static_cast<int>(upscalerFrameTimeArray.size()), 0, nullptr,
-                                 *std::min_element(upscalerFrameTimeArray.begin(), upscalerFrameTimeArray.end()) * 0.9f, *std::max_element(upscalerFrameTimeArray.begin(), upscalerFrameTimeArray.end()) * 1.1f, plotSize);
+                _upscaleTimePlot.assign(State::Instance().upscaleTimes.Values.begin(), State::Instance().upscaleTimes.Values.end());
+                auto [minUpscaleTime, maxUpscaleTime] = std::minmax_element(_upscaleTimePlot.begin(), _upscaleTimePlot.end());
+                ImGui::PlotLines("##UpscalerFrameTimeGraph", _upscaleTimePlot.data(), static_cast<int>(_upscaleTimePlot.size()), 0, nullptr,
+                                 *minUpscaleTime * 0.9f, *maxUpscaleTime * 1.1f, plotSize);
             }
 
             ImGui::PopStyleColor(3); // Restore the style
@@ -1194,19 +1260,12 @@ bool MenuCommon::RenderMenu()
         // If overlay is not visible frame needs to be inited
         if (!Config::Instance()->ShowFps.value_or_default())
         {
-            float frameCnt = 0;
-            for (size_t i = 299; i > 199; i--)
+            if (State::Instance().frameTimes.RecentCount > 0)
             {
-                if (State::Instance().frameTimes[i] > 0.0)
-                {
-                    frameTime += State::Instance().frameTimes[i];
-                    frameCnt++;
-                }
+                frameTime = State::Instance().frameTimes.RecentAverage();
+                frameRate = 1000.0 / frameTime;
             }
 
-            frameTime /= frameCnt;
-            frameRate = 1000.0 / frameTime;
-
             ImGui_ImplWin32_NewFrame();
             MenuHdrCheck(io);
             MenuSizeCheck(io);
@@ -1536,6 +1595,21 @@ bool MenuCommon::RenderMenu()
                             Config::Instance()->FGEnableDepthScale = depthScale;
                         ShowHelpMarker("Fix for DLSS-D wrong depth inputs");
 
+                        if (Config::Instance()->FGEnableDepthScale.value_or_default())
+                        {
+                            bool depthScaleAuto = Config::Instance()->FGDepthScaleAuto.value_or_default();
+                            if (ImGui::Checkbox("FG Auto Depth Scale", &depthScaleAuto))
+                                Config::Instance()->FGDepthScaleAuto = depthScaleAuto;
+                            ShowHelpMarker("Derive depth scale from the min/max of depth buffer\n"
+                                           "instead of using FG Scale Depth Max value");
+
+                            if (depthScaleAuto && State::Instance().FGautoDepthScale > 0.0f)
+                            {
+                                ImGui::SameLine(0.0f, 6.0f);
+                                ImGui::Text("Scale: %.1f", State::Instance().FGautoDepthScale);
+                            }
+                        }
+
                         ImGui::Spacing();
                         if (ImGui::CollapsingHeader("Advanced OptiFG Settings"))
                         {
@@ -1621,6 +1695,12 @@ bool MenuCommon::RenderMenu()
                                 if (ImGui::InputFloat("FG Scale Depth Max", &depthScaleMax, 10.0f, 100.0f, "%.1f"))
                                     Config::Instance()->FGDepthScaleMax = depthScaleMax;
                                 ShowHelpMarker("Depth values will be divided to this value");
+
+                                int depthScaleInterval = Config::Instance()->FGDepthScaleAutoInterval.value_or_default();
+                                if (ImGui::InputInt("FG Auto Depth Scale Interval", &depthScaleInterval, 1, 10))
+                                    Config::Instance()->FGDepthScaleAutoInterval = std::clamp(depthScaleInterval, 1, 600);
+                                ShowHelpMarker("Frames between depth min/max reductions\n"
+                                               "when FG Auto Depth Scale is enabled");
                                 ImGui::PopItemWidth();
 
                                 ImGui::TreePop();
@@ -2205,7 +2285,8 @@ bool MenuCommon::RenderMenu()
                     }
 
                     // RCAS -----------------
-                    if (State::Instance().api == DX12 || State::Instance().api == DX11)
+                    if (State::Instance().api == DX12 || State::Instance().api == DX11 ||
+                        (State::Instance().api == Vulkan && (currentBackend == "fsr22" || currentBackend == "fsr31" || currentBackend == "xess")))
                     {
                         ImGui::SeparatorText("RCAS Settings");
 
@@ -2402,7 +2483,8 @@ bool MenuCommon::RenderMenu()
 
                 if (currentFeature != nullptr) {
                     // OUTPUT SCALING -----------------------------
-                    if (State::Instance().api == DX12 || State::Instance().api == DX11)
+                    if (State::Instance().api == DX12 || State::Instance().api == DX11 ||
+                        (State::Instance().api == Vulkan && (currentBackend == "fsr22" || currentBackend == "fsr31" || currentBackend == "xess")))
                     {
                         // if motion vectors are not display size
                         ImGui::BeginDisabled(!Config::Instance()->DisplayResolution.value_or(false) && !State::Instance().DisplaySizeMV.value_or(false) &&
@@ -2597,6 +2679,24 @@ bool MenuCommon::RenderMenu()
                         ImGui::EndTable();
                     }
 
+                    if (bool drsGovernor = Config::Instance()->DrsGovernorEnabled.value_or_default(); ImGui::Checkbox("Frame Time Governor", &drsGovernor))
+                        Config::Instance()->DrsGovernorEnabled = drsGovernor;
+
+                    ShowHelpMarker("Adjusts render resolution between DRS limits to reach target GPU frame time\n"
+                                   "Also used as upscale ratio of FSR & XeSS inputs\n"
+                                   "Game needs to query render resolution again or use its own DRS to pick up changes");
+
+                    ImGui::BeginDisabled(!Config::Instance()->DrsGovernorEnabled.value_or_default());
+
+                    float drsTarget = Config::Instance()->DrsTargetFrameTime.value_or_default();
+                    if (ImGui::SliderFloat("Target Frame Time", &drsTarget, 2.0f, 100.0f, "%.1f ms", ImGuiSliderFlags_NoRoundToFormat))
+                        Config::Instance()->DrsTargetFrameTime = drsTarget;
+
+                    if (Config::Instance()->DrsGovernorEnabled.value_or_default() && DrsGovernor::CurrentScale() > 0.0f)
+                        ImGui::Text("Render Scale: %.2f, GPU Frame Time: %5.2f ms", DrsGovernor::CurrentScale(), DrsGovernor::SmoothedFrameTime());
+
+                    ImGui::EndDisabled();
+
                     // INIT -----------------------------
                     ImGui::SeparatorText("Init Flags");
                     if (ImGui::BeginTable("init", 2, ImGuiTableFlags_SizingStretchSame))
@@ -2857,6 +2957,33 @@ bool MenuCommon::RenderMenu()
 
                         ImGui::EndCombo();
                     }
+
+                    ImGui::Spacing();
+
+                    int traceFrames = Config::Instance()->TraceFrames.value_or_default();
+                    ImGui::PushItemWidth(115.0f * Config::Instance()->MenuScale.value_or_default());
+                    if (ImGui::SliderInt("Trace Frames", &traceFrames, 10, 3000))
+                        Config::Instance()->TraceFrames = traceFrames;
+                    ImGui::PopItemWidth();
+
+                    ImGui::SameLine(0.0f, 6.0f);
+
+                    ImGui::BeginDisabled(Trace::IsCapturing() || Trace::IsWriting());
+
+                    if (ImGui::Button("Capture Trace"))
+                        Trace::Start(traceFrames);
+
+                    ImGui::EndDisabled();
+
+                    ShowHelpMarker("Records hook timings, lock waits and GPU passes\n"
+                                   "for given number of frames\n\n"
+                                   "Trace is saved next to OptiScaler as json,\n"
+                                   "it can be opened with Perfetto or chrome://tracing");
+
+                    if (Trace::IsCapturing())
+                        ImGui::Text("Capturing, %d frames left", Trace::FramesLeft());
+                    else if (Trace::IsWriting())
+                        ImGui::Text("Writing trace file...");
                 }
 
                 // FPS OVERLAY -----------------------------
@@ -2998,6 +3125,14 @@ bool MenuCommon::RenderMenu()
                         }
                         ImGui::EndDisabled();
 
+                        bool mbAuto = Config::Instance()->MipmapBiasAuto.value_or_default();
+                        if (ImGui::Checkbox("MB Auto", &mbAuto))
+                            Config::Instance()->MipmapBiasAuto = mbAuto;
+
+                        ShowHelpMarker("Use log2(render width / display width)\n"
+                                       "as mipmap bias, follows render scale changes\n"
+                                       "Overrides the value above when enabled");
+
                         ImGui::BeginDisabled(Config::Instance()->MipmapBiasOverride.has_value() && Config::Instance()->MipmapBiasOverride.value() == _mipBias);
                         {
                             if (ImGui::Button("Set"))
@@ -3055,6 +3190,13 @@ bool MenuCommon::RenderMenu()
                         }
 
                         ImGui::Text("Will be applied after RESOLUTION/PRESET change !!!");
+
+                        auto rsStats = RootSignatureCache::GetStats();
+                        if (rsStats.Hits + rsStats.Misses > 0)
+                        {
+                            ImGui::Text("Root signature cache: %llu / %llu (%.1f%%), %.2f ms saved",
+                                        rsStats.Hits, rsStats.Hits + rsStats.Misses, rsStats.HitRate * 100.0, rsStats.SavedMs);
+                        }
                     }
 
                     ImGui::Spacing();
@@ -3141,8 +3283,8 @@ bool MenuCommon::RenderMenu()
                 {
                     ImGui::TableNextColumn();
                     ImGui::Text("FrameTime");
-                    auto ft = std::format("{:5.2f} ms / {:5.1f} fps", State::Instance().frameTimes.back(), frameRate);
-                    std::vector<float> frameTimeArray(State::Instance().frameTimes.begin(), State::Instance().frameTimes.end());
+                    auto ft = std::format("{:5.2f} ms / {:5.1f} fps", State::Instance().frameTimes.Last(), frameRate);
+                    std::vector<float> frameTimeArray(State::Instance().frameTimes.Values.begin(), State::Instance().frameTimes.Values.end());
                     ImGui::PlotLines(ft.c_str(), frameTimeArray.data(), (int)frameTimeArray.size());
 
 
@@ -3150,14 +3292,108 @@ bool MenuCommon::RenderMenu()
                     {
                         ImGui::TableNextColumn();
                         ImGui::Text("Upscaler");
-                        auto ups = std::format("{:7.4f} ms", State::Instance().upscaleTimes.back());
-                        std::vector<float> upscaleTimeArray(State::Instance().upscaleTimes.begin(), State::Instance().upscaleTimes.end());
+                        auto ups = std::format("{:7.4f} ms", State::Instance().upscaleTimes.Last());
+                        std::vector<float> upscaleTimeArray(State::Instance().upscaleTimes.Values.begin(), State::Instance().upscaleTimes.Values.end());
                         ImGui::PlotLines(ups.c_str(), upscaleTimeArray.data(), (int)upscaleTimeArray.size());
                     }
 
                     ImGui::EndTable();
                 }
 
+                if ((GpuProfiler_Dx12::IsInited() || GpuProfiler_Vk::IsInited()) && ImGui::CollapsingHeader("GPU Pass Timings"))
+                {
+                    ScopedIndent indent{};
+                    ImGui::Spacing();
+
+                    if (ImGui::BeginTable("gpuPasses", 6, ImGuiTableFlags_SizingStretchProp | ImGuiTableFlags_RowBg))
+                    {
+                        ImGui::TableSetupColumn("Pass");
+                        ImGui::TableSetupColumn("Last");
+                        ImGui::TableSetupColumn("Avg");
+                        ImGui::TableSetupColumn("P50");
+                        ImGui::TableSetupColumn("P95");
+                        ImGui::TableSetupColumn("P99");
+                        ImGui::TableHeadersRow();
+
+                        for (uint32_t i = 0; i < (uint32_t)GpuPass::Count; i++)
+                        {
+                            GpuPassStats stats{};
+
+                            auto hasStats = GpuProfiler_Dx12::IsInited() ? GpuProfiler_Dx12::GetStats((GpuPass)i, &stats) : GpuProfiler_Vk::GetStats((GpuPass)i, &stats);
+
+                            if (!hasStats)
+                                continue;
+
+                            ImGui::TableNextColumn();
+                            ImGui::Text("%s", GpuPassName((GpuPass)i));
+                            ImGui::TableNextColumn();
+                            ImGui::Text("%6.3f", stats.Last);
+                            ImGui::TableNextColumn();
+                            ImGui::Text("%6.3f", stats.Average);
+                            ImGui::TableNextColumn();
+                            ImGui::Text("%6.3f", stats.P50);
+                            ImGui::TableNextColumn();
+                            ImGui::Text("%6.3f", stats.P95);
+                            ImGui::TableNextColumn();
+                            ImGui::Text("%6.3f", stats.P99);
+                        }
+
+                        ImGui::EndTable();
+                    }
+
+                    ShowHelpMarker("GPU time of OptiScaler passes in ms\n"
+                                   "Upscale includes Bias, Output Scaling and RCAS\n\n"
+                                   "Only first occurrence of a pass in a frame is measured");
+                }
+
+                if (ImGui::CollapsingHeader("Startup Timeline"))
+                {
+                    ScopedIndent indent{};
+                    ImGui::Spacing();
+
+                    ImGui::Text("Process was running for %.1f ms before attach", StartupProfiler::ProcessAgeMs());
+
+                    if (ImGui::BeginTable("startupPhases", 5, ImGuiTableFlags_SizingStretchProp | ImGuiTableFlags_RowBg))
+                    {
+                        ImGui::TableSetupColumn("Phase");
+                        ImGui::TableSetupColumn("Start");
+                        ImGui::TableSetupColumn("Duration");
+                        ImGui::TableSetupColumn("Self");
+                        ImGui::TableSetupColumn("Calls");
+                        ImGui::TableHeadersRow();
+
+                        for (uint32_t i = 0; i < (uint32_t)StartupPhase::Count; i++)
+                        {
+                            StartupPhaseStats stats{};
+
+                            if (!StartupProfiler::GetStats((StartupPhase)i, &stats))
+                                continue;
+
+                            ImGui::TableNextColumn();
+                            ImGui::Text("%s", StartupPhaseName((StartupPhase)i));
+                            ImGui::TableNextColumn();
+                            ImGui::Text("%8.2f", stats.StartMs);
+                            ImGui::TableNextColumn();
+                            ImGui::Text("%8.2f", stats.DurationMs);
+                            ImGui::TableNextColumn();
+                            ImGui::Text("%8.2f", stats.SelfMs);
+                            ImGui::TableNextColumn();
+                            ImGui::Text("%u", stats.Calls);
+                        }
+
+                        ImGui::EndTable();
+                    }
+
+                    if (ImGui::Button("Save Startup Trace"))
+                        StartupProfiler::WriteTrace();
+
+                    ShowHelpMarker("Time spent in OptiScaler from dll attach until first upscaled frame, in ms\n"
+                                   "Start is relative to dll attach, duration is total of all calls\n"
+                                   "Self is duration without phases nested in it\n\n"
+                                   "Trace is saved next to OptiScaler as json,\n"
+                                   "it can be opened with Perfetto or chrome://tracing");
+                }
+
                 // BOTTOM LINE ---------------
                 ImGui::Spacing();
                 ImGui::Separator();
@@ -3413,6 +3649,11 @@ bool MenuCommon::RenderMenu()
             }
         }
 
+        // Hooks read changed settings from snapshot, menu widgets only change settings
+        // while they are active or at the frame they are released
+        if (GImGui->ActiveId != 0 || GImGui->ActiveIdPreviousFrame != 0)
+            Config::Instance()->PublishSnapshot();
+
         return true;
     }
 }
@@ -3477,6 +3718,8 @@ void MenuCommon::Shutdown()
     if (pfn_SetCursorPos_hooked)
         DetachHooks();
 
+    ClearOverlayCache();
+
     ImGui_ImplWin32_Shutdown();
     ImGui::DestroyContext();
 
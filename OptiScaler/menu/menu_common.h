@@ -72,6 +72,23 @@ private:
     inline static bool _dx12Ready = false;
     inline static bool _vulkanReady = false;
 
+    // fps overlay cache, when only fps overlay is visible it's rebuilt
+    // FpsOverlayRefreshRate times per second and last draw data is redrawn between
+    inline static ImDrawData _overlayDrawData = {};
+    inline static bool _overlayCached = false;      // _overlayDrawData has a copy of last built overlay
+    inline static bool _overlayFromCache = false;   // Current frame redraws _overlayDrawData
+    inline static bool _overlayCacheable = false;   // Current frame is built and should be copied
+    inline static double _overlayBuildTime = 0.0;
+    inline static float _overlayScreenWidth = 0.0f;
+    inline static float _overlayScreenHeight = 0.0f;
+    inline static bool _overlayHdr = false;
+    inline static ImTextureID _overlayFontTexture = nullptr;
+    inline static std::vector<float> _frameTimePlot;
+    inline static std::vector<float> _upscaleTimePlot;
+
+    static void CacheOverlay(ImDrawData* InDrawData);
+    static void ClearOverlayCache();
+
     inline static void ShowTooltip(const char* tip);
 
     inline static void ShowHelpMarker(const char* tip);
@@ -149,6 +166,9 @@ public:
     static HWND Handle() { return _handle; }
 
     static bool RenderMenu();
+    // Use instead of ImGui::Render() & ImGui::GetDrawData(), cached fps overlay skips ImGui frame
+    static void Render();
+    static ImDrawData* DrawData();
     static void Init(HWND InHwnd);
     static void Shutdown();
     static void HideMenu();
@@ -107,7 +107,7 @@ bool Menu_Dx11::Render(ID3D11DeviceContext* pCmdList, ID3D11Resource* outTexture
 		if (_renderTargetTexture == nullptr)
 		{
 			// Render
-			ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
+			ImGui_ImplDX11_RenderDrawData(MenuCommon::DrawData());
 			return true;
 		}
 
@@ -115,7 +115,7 @@ bool Menu_Dx11::Render(ID3D11DeviceContext* pCmdList, ID3D11Resource* outTexture
 		pCmdList->CopyResource(_renderTargetTexture, outTexture);
 
 		// Render
-		ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
+		ImGui_ImplDX11_RenderDrawData(MenuCommon::DrawData());
 
 		// Copy result
 		pCmdList->CopyResource(outTexture, _renderTargetTexture);
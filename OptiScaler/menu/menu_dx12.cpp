@@ -4,6 +4,7 @@
 
 #include "Config.h"
 #include "menu_common.h"
+#include "misc/GpuProfiler_Dx12.h"
 #include "imgui/imgui_impl_dx12.h"
 #include "imgui/imgui_impl_win32.h"
 
@@ -73,10 +74,12 @@ bool Menu_Dx12::Render(ID3D12GraphicsCommandList* pCmdList, ID3D12Resource* outT
         // Render
         MenuDxBase::RenderMenu();
 
-        if (!ImGui::GetDrawData())
+        if (!MenuCommon::DrawData())
             return false;
 
-        ImGui_ImplDX12_RenderDrawData(ImGui::GetDrawData(), pCmdList);
+        GpuProfiler_Dx12::Begin(_device, pCmdList, GpuPass::Menu);
+        ImGui_ImplDX12_RenderDrawData(MenuCommon::DrawData(), pCmdList);
+        GpuProfiler_Dx12::End(pCmdList, GpuPass::Menu);
 
         outBarrier.Transition.StateBefore = D3D12_RESOURCE_STATE_RENDER_TARGET;
         outBarrier.Transition.StateAfter = D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
@@ -127,7 +130,9 @@ bool Menu_Dx12::Render(ID3D12GraphicsCommandList* pCmdList, ID3D12Resource* outT
     // Render to buffer
     if (MenuDxBase::RenderMenu())
     {
-        ImGui_ImplDX12_RenderDrawData(ImGui::GetDrawData(), pCmdList);
+        GpuProfiler_Dx12::Begin(_device, pCmdList, GpuPass::Menu);
+        ImGui_ImplDX12_RenderDrawData(MenuCommon::DrawData(), pCmdList);
+        GpuProfiler_Dx12::End(pCmdList, GpuPass::Menu);
 
         outBarrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_SOURCE;
         outBarrier.Transition.StateAfter = D3D12_RESOURCE_STATE_COPY_DEST;
@@ -1,9 +1,11 @@
 #include "menu_overlay_base.h"
+#include "menu_common.h"
 #include "menu_overlay_dx.h"
 
 #include <Util.h>
 #include <Logger.h>
 #include <Config.h>
+#include <misc/GpuProfiler_Dx12.h>
 
 #include "imgui/imgui_impl_dx11.h"
 #include "imgui/imgui_impl_dx12.h"
@@ -286,10 +288,10 @@ static void RenderImGui_DX11(IDXGISwapChain* pSwapChain)
 
             if (MenuOverlayBase::RenderMenu())
             {
-                ImGui::Render();
+                MenuCommon::Render();
 
                 g_pd3dDeviceContext->OMSetRenderTargets(1, &g_pd3dRenderTarget, NULL);
-                ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
+                ImGui_ImplDX11_RenderDrawData(MenuCommon::DrawData());
             }
         }
     }
@@ -453,7 +455,7 @@ static void RenderImGui_DX12(IDXGISwapChain* pSwapChainPlain)
 
             if (MenuOverlayBase::RenderMenu())
             {
-                ImGui::Render();
+                MenuCommon::Render();
 
                 UINT backBufferIdx = pSwapChain->GetCurrentBackBufferIndex();
                 ID3D12CommandAllocator* commandAllocator = g_commandAllocators[backBufferIdx];
@@ -487,7 +489,9 @@ static void RenderImGui_DX12(IDXGISwapChain* pSwapChainPlain)
                 g_pd3dCommandList->OMSetRenderTargets(1, &g_mainRenderTargetDescriptor[backBufferIdx], FALSE, NULL);
                 g_pd3dCommandList->SetDescriptorHeaps(1, &g_pd3dSrvDescHeap);
 
-                ImGui_ImplDX12_RenderDrawData(ImGui::GetDrawData(), g_pd3dCommandList);
+                GpuProfiler_Dx12::Begin(device, g_pd3dCommandList, GpuPass::Menu);
+                ImGui_ImplDX12_RenderDrawData(MenuCommon::DrawData(), g_pd3dCommandList);
+                GpuProfiler_Dx12::End(g_pd3dCommandList, GpuPass::Menu);
 
                 barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_RENDER_TARGET;
                 barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_PRESENT;
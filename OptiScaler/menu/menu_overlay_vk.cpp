@@ -1,194 +1,262 @@
 #include "menu_overlay_base.h"
+#include "menu_common.h"
 #include "menu_overlay_vk.h"
 
 #include <Util.h>
 #include <Config.h>
+#include <misc/GpuProfiler_Vk.h>
+#include <misc/PipelineCache_Vk.h>
 
 #include "imgui/imgui_impl_vulkan.h"
 #include "imgui/imgui_impl_win32.h"
 
+#include <deque>
+
 // Vulkan overlay code adopted from here:
 // https://gist.github.com/mem99/0ec31ca302927457f86b1d6756aaa8c4
 // Need to check resize & recreate fixes
 
+// Overlay never idles the device, objects which might still be used by GPU are retired
+// and destroyed when the overlay submissions using them are completed
+
+// Command buffer, fence & signal semaphore of one overlay submission
+struct OverlayFrame
+{
+    VkCommandPool CommandPool = VK_NULL_HANDLE;
+    VkCommandBuffer CommandBuffer = VK_NULL_HANDLE;
+    VkFence Fence = VK_NULL_HANDLE;
+    VkSemaphore Semaphore = VK_NULL_HANDLE;
+    uint64_t Serial = 0;
+    bool Pending = false;
+};
+
+// Objects waiting for GPU to finish with them
+struct RetiredObjects
+{
+    VkDevice Device = VK_NULL_HANDLE;
+
+    // Live frame ring submissions up to this serial might use the objects
+    uint64_t Serial = 0;
+
+    // Fences of retired frame rings which might use the objects
+    std::vector<VkFence> WaitFences;
+
+    std::vector<OverlayFrame> Frames;
+    std::vector<VkFramebuffer> Framebuffers;
+    std::vector<VkImageView> ImageViews;
+    VkRenderPass RenderPass = VK_NULL_HANDLE;
+    VkDescriptorPool DescriptorPool = VK_NULL_HANDLE;
+};
+
 static bool _isInited = false;
 
 static bool _vulkanObjectsCreated = false;
+static bool _backendInited = false;
 static std::mutex _vkCleanMutex;
-static std::mutex _vkPresentMutex;
 
 // imgui stuff
 struct ImGui_ImplVulkan_InitInfo _ImVulkan_Info = {};
-struct ImGui_ImplVulkanH_Frame* _ImVulkan_Frames = VK_NULL_HANDLE;
-static VkSemaphore* _ImVulkan_Semaphores = VK_NULL_HANDLE;
 static VkRenderPass _vkRenderPass = VK_NULL_HANDLE;
+static VkFormat _scFormat = VK_FORMAT_UNDEFINED;
 static uint32_t _scImageCount;
-static ULONG64 _frameCount;
 
+// Framebuffers are per swapchain image, frame ring is used in submission order
+static std::vector<VkImageView> _imageViews;
+static std::vector<VkFramebuffer> _framebuffers;
+static std::vector<OverlayFrame> _frames;
+static uint32_t _frameIndex = 0;
+static uint64_t _submitSerial = 0;
 
-static void CreateVulkanObjects(VkDevice device, VkPhysicalDevice pd, VkInstance instance, HWND hwnd, const VkSwapchainCreateInfoKHR* pCreateInfo, VkSwapchainKHR* pSwapchain)
-{
-    LOG_FUNC();
+static std::deque<RetiredObjects> _retired;
 
-    if (device == VK_NULL_HANDLE || pCreateInfo == nullptr || *pSwapchain == VK_NULL_HANDLE)
-    {
-        LOG_WARN("device({0:X}) == VK_NULL_HANDLE || pCreateInfo({1:X}) == nullptr || *pSwapchain({2:X}) == VK_NULL_HANDLE", (UINT64)device, (UINT64)pCreateInfo, (UINT64)*pSwapchain);
-        return;
-    }
+// Waits are bounded, a stuck GPU can't block present or swapchain recreation forever
+static const uint64_t FrameWaitTimeout = 20000000;       // 20 ms
+static const uint64_t RetireWaitTimeout = 1000000000;    // 1 s
 
-    if (_vulkanObjectsCreated)
-    {
-        LOG_DEBUG("_vulkanObjectsCreated, releaseing objects");
+// Frame ring slots on top of swapchain image count, GPU can be that many presents behind before present waits
+static const uint32_t FrameRingExtraSlots = 2;
 
-        if (ImGui::GetIO().BackendRendererUserData != nullptr)
-            ImGui_ImplVulkan_Shutdown();
+static void DestroyFrame(VkDevice device, OverlayFrame& frame)
+{
+    if (frame.Fence != VK_NULL_HANDLE)
+        vkDestroyFence(device, frame.Fence, VK_NULL_HANDLE);
 
-        MenuOverlayVk::DestroyVulkanObjects(false);
+    if (frame.Semaphore != VK_NULL_HANDLE)
+        vkDestroySemaphore(device, frame.Semaphore, VK_NULL_HANDLE);
 
-        _vulkanObjectsCreated = false;
-    }
+    // Command buffer is freed with its pool
+    if (frame.CommandPool != VK_NULL_HANDLE)
+        vkDestroyCommandPool(device, frame.CommandPool, VK_NULL_HANDLE);
 
-    // Initialize ImGui 
-    if (!MenuOverlayBase::IsInited() || MenuOverlayBase::Handle() != hwnd)
-    {
-        if (MenuOverlayBase::IsInited())
-            MenuOverlayBase::Shutdown();
+    frame = {};
+}
 
-        LOG_DEBUG("MenuOverlayBase::Init");
-        MenuOverlayBase::Init(hwnd);
-    }
+static void DestroyRetired(RetiredObjects& objects)
+{
+    for (auto& frame : objects.Frames)
+        DestroyFrame(objects.Device, frame);
 
-    ImGuiIO& io = ImGui::GetIO();
-    io.DisplaySize.x = pCreateInfo->imageExtent.width;
-    io.DisplaySize.y = pCreateInfo->imageExtent.height;
+    for (auto framebuffer : objects.Framebuffers)
+        vkDestroyFramebuffer(objects.Device, framebuffer, VK_NULL_HANDLE);
 
-    VkResult result;
+    for (auto view : objects.ImageViews)
+        vkDestroyImageView(objects.Device, view, VK_NULL_HANDLE);
 
-    // Get swapchain image count.
-    result = vkGetSwapchainImagesKHR(device, *pSwapchain, &_scImageCount, NULL);
-    if (result != VK_SUCCESS)
-    {
-        LOG_ERROR("vkGetSwapchainImagesKHR error: {0:X}", (UINT)result);
-        return;
-    }
+    if (objects.RenderPass != VK_NULL_HANDLE)
+        vkDestroyRenderPass(objects.Device, objects.RenderPass, VK_NULL_HANDLE);
 
-    VkImage images[8];
-    result = vkGetSwapchainImagesKHR(device, *pSwapchain, &_scImageCount, images);
-    if (result != VK_SUCCESS)
+    if (objects.DescriptorPool != VK_NULL_HANDLE)
+        vkDestroyDescriptorPool(objects.Device, objects.DescriptorPool, VK_NULL_HANDLE);
+}
+
+// Refreshes pending state of live frames without waiting
+static void UpdateFrames()
+{
+    for (auto& frame : _frames)
     {
-        LOG_ERROR("vkGetSwapchainImagesKHR error: {0:X}", (UINT)result);
-        return;
+        if (frame.Pending && vkGetFenceStatus(_ImVulkan_Info.Device, frame.Fence) != VK_NOT_READY)
+            frame.Pending = false;
     }
+}
 
-    // Alloc ImGui frame structure/semaphores for every image.
-    // For convenience, I am using ImGui_ImplVulkanH_Frame in imgui_impl_vulkan.h
-    if (!_vulkanObjectsCreated)
+static void CollectPendingFences(uint64_t serial, std::vector<VkFence>& fences)
+{
+    for (auto& frame : _frames)
     {
-        _ImVulkan_Frames = (ImGui_ImplVulkanH_Frame*)IM_ALLOC(sizeof(ImGui_ImplVulkanH_Frame) * _scImageCount);
-        _ImVulkan_Semaphores = (VkSemaphore*)IM_ALLOC(sizeof(VkSemaphore) * _scImageCount);
+        if (frame.Pending && frame.Serial <= serial)
+            fences.push_back(frame.Fence);
     }
+}
 
-    // Select queue family.
-    uint32_t queueFamily = 0;
+// Retired objects are destroyed in order, stops at first entry GPU might still be using
+static void ProcessRetired(bool wait)
+{
+    if (_ImVulkan_Info.Device != VK_NULL_HANDLE)
+        UpdateFrames();
+
+    while (!_retired.empty())
     {
-        // get count
-        uint32_t count = 0;
-        vkGetPhysicalDeviceQueueFamilyProperties(pd, &count, NULL);
+        auto& objects = _retired.front();
+        std::vector<VkFence> fences = objects.WaitFences;
 
-        // get queues
-        if (count > 0)
-        {
-            VkQueueFamilyProperties queues[8];
-            vkGetPhysicalDeviceQueueFamilyProperties(pd, &count, queues);
+        if (objects.Device == _ImVulkan_Info.Device)
+            CollectPendingFences(objects.Serial, fences);
 
+        if (!fences.empty())
+        {
+            auto result = vkWaitForFences(objects.Device, (uint32_t)fences.size(), fences.data(), VK_TRUE, wait ? RetireWaitTimeout : 0);
 
-            // find graphic queue
-            for (uint32_t i = 0; i < count; i++)
+            if (result == VK_TIMEOUT)
             {
-                if (queues[i].queueFlags & VK_QUEUE_GRAPHICS_BIT)
-                {
-                    queueFamily = i;
-                    break;
-                }
+                if (wait)
+                    LOG_WARN("Retired objects are still in use after {0} ms", RetireWaitTimeout / 1000000);
+
+                return;
             }
         }
-        else
-        {
-            LOG_WARN("PD Queue property count is 0!");
-            return;
-        }
+
+        DestroyRetired(objects);
+        _retired.pop_front();
     }
+}
 
-    // Get device queue
-    VkQueue queue;
-    vkGetDeviceQueue(device, queueFamily, 0, &queue);
+// Per image objects are retired on every swapchain recreation, rest is kept if device & format are same
+static void RetireSwapchainObjects()
+{
+    if (_imageViews.empty() && _framebuffers.empty())
+        return;
 
-    // Create the render pool
-    VkDescriptorPool pool = VK_NULL_HANDLE;
+    RetiredObjects objects;
+    objects.Device = _ImVulkan_Info.Device;
+    objects.Serial = _submitSerial;
+    objects.Framebuffers = std::move(_framebuffers);
+    objects.ImageViews = std::move(_imageViews);
+
+    _framebuffers.clear();
+    _imageViews.clear();
+
+    _retired.push_back(std::move(objects));
+}
+
+static void RetireAllObjects()
+{
+    if (_ImVulkan_Info.Device == VK_NULL_HANDLE)
+        return;
+
+    UpdateFrames();
+
+    // Older entries were tracked by live frame ring, they wait for its fences after this point
+    for (auto& older : _retired)
     {
-        VkDescriptorPoolSize sampler_pool_size = { };
-        sampler_pool_size.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-        sampler_pool_size.descriptorCount = 1;
-        VkDescriptorPoolCreateInfo desc_pool_info = { };
-        desc_pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-        desc_pool_info.maxSets = 1;
-        desc_pool_info.poolSizeCount = 1;
-        desc_pool_info.pPoolSizes = &sampler_pool_size;
-        result = vkCreateDescriptorPool(device, &desc_pool_info, NULL, &pool);
-        if (result != VK_SUCCESS)
-        {
-            LOG_ERROR("vkCreateDescriptorPool error: {0:X}", (UINT)result);
-            return;
-        }
+        if (older.Device == _ImVulkan_Info.Device)
+            CollectPendingFences(older.Serial, older.WaitFences);
     }
 
-    // Create the render pass
-    {
-        VkAttachmentDescription attachment_desc = { };
+    RetiredObjects objects;
+    objects.Device = _ImVulkan_Info.Device;
+    objects.Serial = _submitSerial;
+    CollectPendingFences(_submitSerial, objects.WaitFences);
+    objects.Frames = std::move(_frames);
+    objects.Framebuffers = std::move(_framebuffers);
+    objects.ImageViews = std::move(_imageViews);
+    objects.RenderPass = _vkRenderPass;
+    objects.DescriptorPool = _ImVulkan_Info.DescriptorPool;
+
+    _frames.clear();
+    _framebuffers.clear();
+    _imageViews.clear();
+    _vkRenderPass = VK_NULL_HANDLE;
+    _frameIndex = 0;
+
+    _retired.push_back(std::move(objects));
+}
 
-        attachment_desc.format = pCreateInfo->imageFormat;
-        attachment_desc.samples = VK_SAMPLE_COUNT_1_BIT;
-        attachment_desc.loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-        attachment_desc.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-        attachment_desc.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-        attachment_desc.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-        attachment_desc.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-        attachment_desc.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+// ImGui backend destroys its pipeline, buffers & font texture immediately,
+// only overlay's own in flight submissions are waited (with a timeout) before it
+static void ShutdownBackend()
+{
+    if (!_backendInited)
+        return;
 
-        VkAttachmentReference color_attachment = { };
-        color_attachment.attachment = 0;
-        color_attachment.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    _backendInited = false;
 
-        VkSubpassDescription subpass = { };
-        subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
-        subpass.colorAttachmentCount = 1;
-        subpass.pColorAttachments = &color_attachment;
+    // Context might be recreated by menu for a new window
+    if (ImGui::GetCurrentContext() == nullptr || ImGui::GetIO().BackendRendererUserData == nullptr)
+        return;
 
-        VkSubpassDependency dependency = { };
-        dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
-        dependency.dstSubpass = 0;
-        dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-        dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-        dependency.srcAccessMask = 0;
-        dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    if (_ImVulkan_Info.Device != VK_NULL_HANDLE)
+    {
+        UpdateFrames();
 
-        VkRenderPassCreateInfo render_pass_info = { };
-        render_pass_info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-        render_pass_info.attachmentCount = 1;
-        render_pass_info.pAttachments = &attachment_desc;
-        render_pass_info.subpassCount = 1;
-        render_pass_info.pSubpasses = &subpass;
-        render_pass_info.dependencyCount = 1;
-        render_pass_info.pDependencies = &dependency;
+        std::vector<VkFence> fences;
+        CollectPendingFences(_submitSerial, fences);
 
-        result = vkCreateRenderPass(device, &render_pass_info, NULL, &_vkRenderPass);
-        if (result != VK_SUCCESS)
+        if (!fences.empty())
         {
-            LOG_ERROR("vkCreateRenderPass error: {0:X}", (UINT)result);
-            return;
+            auto result = vkWaitForFences(_ImVulkan_Info.Device, (uint32_t)fences.size(), fences.data(), VK_TRUE, RetireWaitTimeout);
+
+            if (result != VK_SUCCESS)
+                LOG_WARN("vkWaitForFences error: {0:X}", (UINT)result);
         }
     }
 
+    ImGui_ImplVulkan_Shutdown();
+}
+
+static void DestroyObjects()
+{
+    ShutdownBackend();
+    RetireAllObjects();
+
+    _ImVulkan_Info = {};
+    _scFormat = VK_FORMAT_UNDEFINED;
+    _vulkanObjectsCreated = false;
+}
+
+static bool CreateSwapchainObjects(VkDevice device, const std::vector<VkImage>& images, const VkSwapchainCreateInfoKHR* pCreateInfo)
+{
+    VkResult result;
+
     // Create The Image Views
     {
         VkImageViewCreateInfo info = { };
@@ -204,18 +272,19 @@ static void CreateVulkanObjects(VkDevice device, VkPhysicalDevice pd, VkInstance
         VkImageSubresourceRange image_range = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
         info.subresourceRange = image_range;
 
-        for (uint32_t i = 0; i < _scImageCount; i++)
+        for (auto image : images)
         {
-            ImGui_ImplVulkanH_Frame* fd = &_ImVulkan_Frames[i];
-            fd->Backbuffer = images[i];
-            info.image = fd->Backbuffer;
+            info.image = image;
 
-            result = vkCreateImageView(device, &info, NULL, &fd->BackbufferView);
+            VkImageView view = VK_NULL_HANDLE;
+            result = vkCreateImageView(device, &info, NULL, &view);
             if (result != VK_SUCCESS)
             {
                 LOG_ERROR("vkCreateImageView error: {0:X}", (UINT)result);
-                return;
+                return false;
             }
+
+            _imageViews.push_back(view);
         }
     }
 
@@ -233,34 +302,45 @@ static void CreateVulkanObjects(VkDevice device, VkPhysicalDevice pd, VkInstance
 
         info.layers = 1;
 
-        for (uint32_t i = 0; i < _scImageCount; i++)
+        for (auto view : _imageViews)
         {
-            ImGui_ImplVulkanH_Frame* fd = &_ImVulkan_Frames[i];
-            attachment[0] = fd->BackbufferView;
-            result = vkCreateFramebuffer(device, &info, NULL, &fd->Framebuffer);
+            attachment[0] = view;
+
+            VkFramebuffer framebuffer = VK_NULL_HANDLE;
+            result = vkCreateFramebuffer(device, &info, NULL, &framebuffer);
             if (result != VK_SUCCESS)
             {
                 LOG_ERROR("vkCreateFramebuffer error: {0:X}", (UINT)result);
-                return;
+                return false;
             }
+
+            _framebuffers.push_back(framebuffer);
         }
     }
 
-    // Create command pools, command buffers, fences, and semaphores for every image
-    for (uint32_t i = 0; i < _scImageCount; i++)
+    return true;
+}
+
+// Ring has FrameRingExtraSlots more frames than swapchain images so recording never has to wait for the GPU in normal cases
+static bool CreateFrames(VkDevice device, uint32_t queueFamily, uint32_t count)
+{
+    VkResult result;
+
+    for (uint32_t i = 0; i < count; i++)
     {
-        ImGui_ImplVulkanH_Frame* fd = &_ImVulkan_Frames[i];
-        VkSemaphore* fsd = &_ImVulkan_Semaphores[i];
+        _frames.push_back({});
+        OverlayFrame* fd = &_frames.back();
+
         {
             VkCommandPoolCreateInfo info = { };
             info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
-            info.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+            info.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
             info.queueFamilyIndex = queueFamily;
             result = vkCreateCommandPool(device, &info, NULL, &fd->CommandPool);
             if (result != VK_SUCCESS)
             {
                 LOG_ERROR("vkCreateCommandPool error: {0:X}", (UINT)result);
-                return;
+                return false;
             }
         }
 
@@ -274,106 +354,259 @@ static void CreateVulkanObjects(VkDevice device, VkPhysicalDevice pd, VkInstance
             if (result != VK_SUCCESS)
             {
                 LOG_ERROR("vkAllocateCommandBuffers error: {0:X}", (UINT)result);
-                return;
+                return false;
             }
         }
 
+        // Fences start unsignaled, pending flag tells if they were submitted
         {
             VkFenceCreateInfo info = { };
             info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-            info.flags = VK_FENCE_CREATE_SIGNALED_BIT;
             result = vkCreateFence(device, &info, NULL, &fd->Fence);
             if (result != VK_SUCCESS)
             {
                 LOG_ERROR("vkCreateFence error: {0:X}", (UINT)result);
-                return;
+                return false;
             }
         }
 
         {
             VkSemaphoreCreateInfo info = { };
             info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
-            result = vkCreateSemaphore(device, &info, NULL, fsd);
+            result = vkCreateSemaphore(device, &info, NULL, &fd->Semaphore);
             if (result != VK_SUCCESS)
             {
                 LOG_ERROR("vkCreateSemaphore error: {0:X}", (UINT)result);
-                return;
+                return false;
             }
         }
     }
 
+    return true;
+}
 
-    // Initialize ImGui and upload fonts
+static void CreateVulkanObjects(VkDevice device, VkPhysicalDevice pd, VkInstance instance, HWND hwnd, const VkSwapchainCreateInfoKHR* pCreateInfo, VkSwapchainKHR* pSwapchain)
+{
+    LOG_FUNC();
+
+    if (device == VK_NULL_HANDLE || pCreateInfo == nullptr || *pSwapchain == VK_NULL_HANDLE)
     {
-        _ImVulkan_Info.Instance = instance;
-        _ImVulkan_Info.PhysicalDevice = pd;
-        _ImVulkan_Info.Device = device;
-        _ImVulkan_Info.QueueFamily = queueFamily;
-        _ImVulkan_Info.Queue = queue;
-        _ImVulkan_Info.DescriptorPool = pool;
-        _ImVulkan_Info.Subpass = 0;
-        _ImVulkan_Info.MinImageCount = pCreateInfo->minImageCount;
-        _ImVulkan_Info.ImageCount = _scImageCount;
-        _ImVulkan_Info.Allocator = NULL;
-        _ImVulkan_Info.RenderPass = _vkRenderPass;
+        LOG_WARN("device({0:X}) == VK_NULL_HANDLE || pCreateInfo({1:X}) == nullptr || *pSwapchain({2:X}) == VK_NULL_HANDLE", (UINT64)device, (UINT64)pCreateInfo, (UINT64)*pSwapchain);
+        return;
+    }
 
-        bool initResult = ImGui_ImplVulkan_Init(&_ImVulkan_Info);
-        LOG_DEBUG("ImGui_ImplVulkan_Init result: {}", initResult);
+    std::lock_guard<std::mutex> lock(_vkCleanMutex);
 
-        if (!initResult)
-            return;
+    ProcessRetired(false);
 
-        // Upload Fonts
-        // Use any command queue
-        VkCommandPool command_pool = _ImVulkan_Frames[0].CommandPool;
-        VkCommandBuffer command_buffer = _ImVulkan_Frames[0].CommandBuffer;
-        result = vkResetCommandPool(device, command_pool, 0);
-        if (result != VK_SUCCESS)
+    VkResult result;
+
+    // Get swapchain image count.
+    uint32_t imageCount = 0;
+    result = vkGetSwapchainImagesKHR(device, *pSwapchain, &imageCount, NULL);
+    if (result != VK_SUCCESS)
+    {
+        LOG_ERROR("vkGetSwapchainImagesKHR error: {0:X}", (UINT)result);
+        return;
+    }
+
+    std::vector<VkImage> images(imageCount);
+    result = vkGetSwapchainImagesKHR(device, *pSwapchain, &imageCount, images.data());
+    if (result != VK_SUCCESS)
+    {
+        LOG_ERROR("vkGetSwapchainImagesKHR error: {0:X}", (UINT)result);
+        return;
+    }
+
+    images.resize(imageCount);
+
+    // Resizes & other recreations of the same swapchain keep render pass, frame ring & ImGui backend
+    bool keepObjects = _vulkanObjectsCreated && _backendInited && _ImVulkan_Info.Device == device &&
+                       _scFormat == pCreateInfo->imageFormat && _frames.size() > imageCount &&
+                       MenuOverlayBase::IsInited() && MenuOverlayBase::Handle() == hwnd;
+
+    if (!keepObjects && (_vulkanObjectsCreated || _ImVulkan_Info.Device != VK_NULL_HANDLE))
+    {
+        LOG_DEBUG("_vulkanObjectsCreated, releaseing objects");
+        DestroyObjects();
+    }
+
+    // Initialize ImGui
+    if (!MenuOverlayBase::IsInited() || MenuOverlayBase::Handle() != hwnd)
+    {
+        if (MenuOverlayBase::IsInited())
+            MenuOverlayBase::Shutdown();
+
+        LOG_DEBUG("MenuOverlayBase::Init");
+        MenuOverlayBase::Init(hwnd);
+    }
+
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize.x = pCreateInfo->imageExtent.width;
+    io.DisplaySize.y = pCreateInfo->imageExtent.height;
+
+    if (keepObjects)
+    {
+        LOG_DEBUG("Same device & format, recreating only image views & framebuffers");
+
+        RetireSwapchainObjects();
+        _scImageCount = imageCount;
+
+        if (!CreateSwapchainObjects(device, images, pCreateInfo))
+            DestroyObjects();
+
+        LOG_FUNC_RESULT(_vulkanObjectsCreated);
+        return;
+    }
+
+    // From here on every created object is tracked, a failure retires them with the rest
+    _ImVulkan_Info.Device = device;
+    _scImageCount = imageCount;
+
+    // Select queue family.
+    uint32_t queueFamily = 0;
+    {
+        // get count
+        uint32_t count = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(pd, &count, NULL);
+
+        // get queues
+        if (count > 0)
         {
-            LOG_ERROR("vkBeginCommandBuffer error: {0:X}", (UINT)result);
-            return;
-        }
+            std::vector<VkQueueFamilyProperties> queues(count);
+            vkGetPhysicalDeviceQueueFamilyProperties(pd, &count, queues.data());
 
-        VkCommandBufferBeginInfo begin_info = { };
-        begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-        begin_info.flags |= VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-        result = vkBeginCommandBuffer(command_buffer, &begin_info);
-        if (result != VK_SUCCESS)
+
+            // find graphic queue
+            for (uint32_t i = 0; i < count; i++)
+            {
+                if (queues[i].queueFlags & VK_QUEUE_GRAPHICS_BIT)
+                {
+                    queueFamily = i;
+                    break;
+                }
+            }
+        }
+        else
         {
-            LOG_ERROR("vkBeginCommandBuffer error: {0:X}", (UINT)result);
+            LOG_WARN("PD Queue property count is 0!");
+            DestroyObjects();
             return;
         }
+    }
 
-        initResult = ImGui_ImplVulkan_UpdateFontsTexture();
-        LOG_DEBUG("ImGui_ImplVulkan_UpdateFontsTexture result: {}", initResult);
-
-        VkSubmitInfo end_info = { };
-        end_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-        end_info.commandBufferCount = 1;
-        end_info.pCommandBuffers = &command_buffer;
+    // Get device queue
+    VkQueue queue;
+    vkGetDeviceQueue(device, queueFamily, 0, &queue);
 
-        result = vkEndCommandBuffer(command_buffer);
+    // Create the render pool
+    {
+        VkDescriptorPoolSize sampler_pool_size = { };
+        sampler_pool_size.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        sampler_pool_size.descriptorCount = 1;
+        VkDescriptorPoolCreateInfo desc_pool_info = { };
+        desc_pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        desc_pool_info.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+        desc_pool_info.maxSets = 1;
+        desc_pool_info.poolSizeCount = 1;
+        desc_pool_info.pPoolSizes = &sampler_pool_size;
+        result = vkCreateDescriptorPool(device, &desc_pool_info, NULL, &_ImVulkan_Info.DescriptorPool);
         if (result != VK_SUCCESS)
         {
-            LOG_ERROR("vkEndCommandBuffer error: {0:X}", (UINT)result);
+            LOG_ERROR("vkCreateDescriptorPool error: {0:X}", (UINT)result);
+            DestroyObjects();
             return;
         }
+    }
+
+    // Create the render pass
+    {
+        VkAttachmentDescription attachment_desc = { };
+
+        attachment_desc.format = pCreateInfo->imageFormat;
+        attachment_desc.samples = VK_SAMPLE_COUNT_1_BIT;
+        attachment_desc.loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        attachment_desc.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+        attachment_desc.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        attachment_desc.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        attachment_desc.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        attachment_desc.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+
+        VkAttachmentReference color_attachment = { };
+        color_attachment.attachment = 0;
+        color_attachment.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+        VkSubpassDescription subpass = { };
+        subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        subpass.colorAttachmentCount = 1;
+        subpass.pColorAttachments = &color_attachment;
+
+        VkSubpassDependency dependency = { };
+        dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
+        dependency.dstSubpass = 0;
+        dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        dependency.srcAccessMask = 0;
+        dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
 
-        result = vkQueueSubmit(queue, 1, &end_info, VK_NULL_HANDLE);
+        VkRenderPassCreateInfo render_pass_info = { };
+        render_pass_info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+        render_pass_info.attachmentCount = 1;
+        render_pass_info.pAttachments = &attachment_desc;
+        render_pass_info.subpassCount = 1;
+        render_pass_info.pSubpasses = &subpass;
+        render_pass_info.dependencyCount = 1;
+        render_pass_info.pDependencies = &dependency;
+
+        result = vkCreateRenderPass(device, &render_pass_info, NULL, &_vkRenderPass);
         if (result != VK_SUCCESS)
         {
-            LOG_ERROR("vkQueueSubmit error: {0:X}", (UINT)result);
+            LOG_ERROR("vkCreateRenderPass error: {0:X}", (UINT)result);
+            DestroyObjects();
             return;
         }
+    }
 
-        result = vkDeviceWaitIdle(device);
-        if (result != VK_SUCCESS)
+    if (!CreateSwapchainObjects(device, images, pCreateInfo) || !CreateFrames(device, queueFamily, imageCount + FrameRingExtraSlots))
+    {
+        DestroyObjects();
+        return;
+    }
+
+    // Initialize ImGui and upload fonts
+    {
+        _ImVulkan_Info.Instance = instance;
+        _ImVulkan_Info.PhysicalDevice = pd;
+        _ImVulkan_Info.QueueFamily = queueFamily;
+        _ImVulkan_Info.Queue = queue;
+        _ImVulkan_Info.Subpass = 0;
+        _ImVulkan_Info.MinImageCount = pCreateInfo->minImageCount < 2 ? 2 : pCreateInfo->minImageCount;
+        _ImVulkan_Info.Allocator = NULL;
+        _ImVulkan_Info.RenderPass = _vkRenderPass;
+        _ImVulkan_Info.PipelineCache = PipelineCache_Vk::Get(device, pd);
+
+        // ImGui cycles its vertex & index buffers with this count, matching frame ring
+        // makes sure a buffer is only rewritten after its frame's fence is signaled
+        _ImVulkan_Info.ImageCount = (uint32_t)_frames.size();
+
+        bool initResult = ImGui_ImplVulkan_Init(&_ImVulkan_Info);
+        LOG_DEBUG("ImGui_ImplVulkan_Init result: {}", initResult);
+
+        if (!initResult)
         {
-            LOG_ERROR("vkDeviceWaitIdle error: {0:X}", (UINT)result);
+            DestroyObjects();
             return;
         }
+
+        _backendInited = true;
+        PipelineCache_Vk::Save();
+
+        // Backend records & submits the upload with its own command buffer
+        initResult = ImGui_ImplVulkan_UpdateFontsTexture();
+        LOG_DEBUG("ImGui_ImplVulkan_UpdateFontsTexture result: {}", initResult);
     }
 
+    _scFormat = pCreateInfo->imageFormat;
     _vulkanObjectsCreated = true;
     LOG_FUNC_RESULT(_vulkanObjectsCreated);
 }
@@ -386,65 +619,22 @@ void MenuOverlayVk::DestroyVulkanObjects(bool shutdown)
     if (!shutdown)
         LOG_FUNC();
 
-    _vkCleanMutex.lock();
+    std::lock_guard<std::mutex> lock(_vkCleanMutex);
 
-    auto result = vkDeviceWaitIdle(_ImVulkan_Info.Device);
-    if (result != VK_SUCCESS && !shutdown)
-        LOG_WARN("vkDeviceWaitIdle error: {0:X}", (UINT)result);
+    DestroyObjects();
 
     if (shutdown)
     {
-        if (_vkRenderPass)
-            vkDestroyRenderPass(_ImVulkan_Info.Device, _vkRenderPass, VK_NULL_HANDLE);
+        // There won't be another present to release them
+        for (auto& objects : _retired)
+            DestroyRetired(objects);
 
-        if (_ImVulkan_Info.DescriptorPool)
-            vkDestroyDescriptorPool(_ImVulkan_Info.Device, _ImVulkan_Info.DescriptorPool, VK_NULL_HANDLE);
+        _retired.clear();
     }
-
-    for (uint32_t i = 0; i < _ImVulkan_Info.ImageCount; i++)
+    else
     {
-        ImGui_ImplVulkanH_Frame* fd = &_ImVulkan_Frames[i];
-
-        if (fd->Fence != VK_NULL_HANDLE)
-        {
-            vkDestroyFence(_ImVulkan_Info.Device, fd->Fence, VK_NULL_HANDLE);
-            fd->Fence = VK_NULL_HANDLE;
-        }
-
-        if (fd->CommandBuffer != VK_NULL_HANDLE)
-        {
-            vkFreeCommandBuffers(_ImVulkan_Info.Device, fd->CommandPool, 1, &fd->CommandBuffer);
-            fd->CommandBuffer = VK_NULL_HANDLE;
-        }
-
-        if (fd->CommandPool != VK_NULL_HANDLE)
-        {
-            vkDestroyCommandPool(_ImVulkan_Info.Device, fd->CommandPool, VK_NULL_HANDLE);
-            fd->CommandPool = VK_NULL_HANDLE;
-        }
-
-        if (fd->BackbufferView != VK_NULL_HANDLE)
-        {
-            vkDestroyImageView(_ImVulkan_Info.Device, fd->BackbufferView, VK_NULL_HANDLE);
-            fd->BackbufferView = VK_NULL_HANDLE;
-        }
-
-        if (fd->BackbufferView != VK_NULL_HANDLE)
-        {
-            vkDestroyFramebuffer(_ImVulkan_Info.Device, fd->Framebuffer, VK_NULL_HANDLE);
-            fd->Framebuffer = VK_NULL_HANDLE;
-        }
-
-        if (_ImVulkan_Semaphores[i] != VK_NULL_HANDLE)
-        {
-            vkDestroySemaphore(_ImVulkan_Info.Device, _ImVulkan_Semaphores[i], VK_NULL_HANDLE);
-            _ImVulkan_Semaphores[i] = VK_NULL_HANDLE;
-        }
+        ProcessRetired(false);
     }
-
-    _ImVulkan_Info = {};
-
-    _vkCleanMutex.unlock();
 }
 
 bool MenuOverlayVk::QueuePresent(VkQueue queue, VkPresentInfoKHR* pPresentInfo)
@@ -460,18 +650,44 @@ bool MenuOverlayVk::QueuePresent(VkQueue queue, VkPresentInfoKHR* pPresentInfo)
     if (pPresentInfo->swapchainCount == 0)
         return false;
 
-    //std::lock_guard<std::mutex> lock(_vkPresentMutex);
+    std::lock_guard<std::mutex> lock(_vkCleanMutex);
+
+    // Objects might be destroyed by another thread before lock
+    if (!_vulkanObjectsCreated || _frames.empty())
+        return true;
+
+    ProcessRetired(false);
+
     LOG_DEBUG("rendering menu, swapchain count: {0}", pPresentInfo->swapchainCount);
 
+    // Frame was submitted a full ring ago, it's normally completed long before
+    // When GPU is that far behind present waits shortly for it, menu is only skipped when GPU is stuck
+    // Slots can't be used out of order, ImGui cycles its buffers in the same order
+    OverlayFrame* fd = &_frames[_frameIndex];
+    if (fd->Pending)
+    {
+        auto fenceResult = vkGetFenceStatus(_ImVulkan_Info.Device, fd->Fence);
+
+        if (fenceResult == VK_NOT_READY)
+        {
+            LOG_DEBUG("Overlay frame is still in use, waiting for it");
+            fenceResult = vkWaitForFences(_ImVulkan_Info.Device, 1, &fd->Fence, VK_TRUE, FrameWaitTimeout);
+        }
+
+        if (fenceResult != VK_SUCCESS)
+        {
+            LOG_WARN("Overlay frame is still in use ({0:X}), skipping menu", (UINT)fenceResult);
+            return true;
+        }
+
+        fd->Pending = false;
+    }
+
     ImGuiIO& io = ImGui::GetIO(); (void)io;
     io.BackendFlags |= ImGuiBackendFlags_RendererHasTexReload;
     MenuOverlayBase::UpdateFonts(io, Config::Instance()->MenuScale.value_or_default());
 
-    _frameCount++;
-
     {
-        auto semaphoreIndex = _frameCount % _scImageCount;
-
         ImGui_ImplVulkan_NewFrame();
 
         if (io.Fonts->IsDirty())
@@ -480,10 +696,15 @@ bool MenuOverlayVk::QueuePresent(VkQueue queue, VkPresentInfoKHR* pPresentInfo)
         if (MenuOverlayBase::RenderMenu())
         {
             uint32_t idx = pPresentInfo->pImageIndices[0];
-            ImGui_ImplVulkanH_Frame* fd = &_ImVulkan_Frames[idx];
 
-            vkWaitForFences(_ImVulkan_Info.Device, 1, &fd->Fence, VK_TRUE, UINT64_MAX);
-            vkResetFences(_ImVulkan_Info.Device, 1, &fd->Fence);
+            if (idx >= _framebuffers.size())
+            {
+                LOG_ERROR("Image index {0} is out of range, framebuffer count: {1}", idx, _framebuffers.size());
+
+                // Closes the frame, when cached overlay is used there is no ImGui frame to end
+                MenuCommon::Render();
+                return true;
+            }
 
             {
                 vkResetCommandPool(_ImVulkan_Info.Device, fd->CommandPool, 0);
@@ -493,21 +714,25 @@ bool MenuOverlayVk::QueuePresent(VkQueue queue, VkPresentInfoKHR* pPresentInfo)
                 vkBeginCommandBuffer(fd->CommandBuffer, &info);
             }
 
+            GpuProfiler_Vk::Begin(_ImVulkan_Info.Device, fd->CommandBuffer, GpuPass::Menu);
+
             {
                 VkRenderPassBeginInfo info = { };
                 info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
                 info.renderPass = _vkRenderPass;
-                info.framebuffer = fd->Framebuffer;
+                info.framebuffer = _framebuffers[idx];
                 info.renderArea.extent.width = ImGui::GetIO().DisplaySize.x;
                 info.renderArea.extent.height = ImGui::GetIO().DisplaySize.y;
                 vkCmdBeginRenderPass(fd->CommandBuffer, &info, VK_SUBPASS_CONTENTS_INLINE);
             }
 
-            ImGui::Render();
-            ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), fd->CommandBuffer);
+            MenuCommon::Render();
+            ImGui_ImplVulkan_RenderDrawData(MenuCommon::DrawData(), fd->CommandBuffer);
 
             // Submit command buffer
             vkCmdEndRenderPass(fd->CommandBuffer);
+            GpuProfiler_Vk::End(fd->CommandBuffer, GpuPass::Menu);
+
             auto ecbResult = vkEndCommandBuffer(fd->CommandBuffer);
             if (ecbResult != VK_SUCCESS)
             {
@@ -527,7 +752,10 @@ bool MenuOverlayVk::QueuePresent(VkQueue queue, VkPresentInfoKHR* pPresentInfo)
             submit_info.waitSemaphoreCount = pPresentInfo->waitSemaphoreCount;
             submit_info.pWaitSemaphores = pPresentInfo->pWaitSemaphores;
             submit_info.signalSemaphoreCount = 1;
-            submit_info.pSignalSemaphores = &_ImVulkan_Semaphores[semaphoreIndex];
+            submit_info.pSignalSemaphores = &fd->Semaphore;
+
+            // Fence is signaled from its previous submission or never submitted
+            vkResetFences(_ImVulkan_Info.Device, 1, &fd->Fence);
 
             auto qResult = vkQueueSubmit(_ImVulkan_Info.Queue, 1, &submit_info, fd->Fence);
             if (qResult != VK_SUCCESS)
@@ -536,8 +764,12 @@ bool MenuOverlayVk::QueuePresent(VkQueue queue, VkPresentInfoKHR* pPresentInfo)
                 return false;
             }
 
-            pPresentInfo->waitSemaphoreCount = pPresentInfo->swapchainCount;
-            pPresentInfo->pWaitSemaphores = &_ImVulkan_Semaphores[semaphoreIndex];
+            fd->Serial = ++_submitSerial;
+            fd->Pending = true;
+            _frameIndex = (_frameIndex + 1) % (uint32_t)_frames.size();
+
+            pPresentInfo->waitSemaphoreCount = 1;
+            pPresentInfo->pWaitSemaphores = &fd->Semaphore;
         }
     }
 
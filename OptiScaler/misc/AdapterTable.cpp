@@ -0,0 +1,215 @@
+#include "AdapterTable.h"
+
+#include <Config.h>
+#include <Util.h>
+
+void AdapterTable::CheckForChanges()
+{
+    auto changedEvent = _changedEvent.load(std::memory_order_acquire);
+
+    // Auto reset event, only first caller after a change clears the table
+    if (changedEvent != nullptr && WaitForSingleObject(changedEvent, 0) == WAIT_OBJECT_0)
+    {
+        LOG_INFO("Adapters changed, clearing adapter table");
+        Invalidate();
+    }
+}
+
+void AdapterTable::Build(Entry* InOutEntry, const ConfigSnapshot* InConfig)
+{
+    auto& original = InOutEntry->Original;
+
+    InOutEntry->DedicatedVideoMemory = original.DedicatedVideoMemory;
+
+    if (InConfig->HasDxgiVRAM)
+        InOutEntry->DedicatedVideoMemory = (SIZE_T)InConfig->DxgiVRAM * 1024 * 1024 * 1024;
+
+    // Microsoft Basic Render Driver is never spoofed
+    InOutEntry->Spoof = InConfig->DxgiSpoofing && original.VendorId != 0x1414;
+
+    std::memset(InOutEntry->Description, 0, sizeof(InOutEntry->Description));
+
+    if (InOutEntry->Spoof)
+    {
+        InOutEntry->VendorId = 0x10de;
+        InOutEntry->DeviceId = 0x2684;
+        wcsncpy_s(InOutEntry->Description, 128, InConfig->SpoofedGPUName.c_str(), _TRUNCATE);
+    }
+    else
+    {
+        InOutEntry->VendorId = original.VendorId;
+        InOutEntry->DeviceId = original.DeviceId;
+        wcsncpy_s(InOutEntry->Description, 128, original.Description.c_str(), _TRUNCATE);
+    }
+}
+
+void AdapterTable::Publish(Table* InTable)
+{
+    auto now = Util::MillisecondsNow();
+
+    // Readers which loaded an old table are long done with it
+    std::erase_if(_retiredTables, [now](const RetiredTable& retired)
+                  {
+                      if (now - retired.RetiredMs < TableGracePeriodMs)
+                          return false;
+
+                      delete retired.Retired;
+                      return true;
+                  });
+
+    auto current = _table.exchange(InTable, std::memory_order_acq_rel);
+
+    if (current != nullptr)
+        _retiredTables.push_back({ current, now });
+}
+
+const AdapterTable::Entry* AdapterTable::Find(const LUID& InLuid, UINT InVendorId, UINT InDeviceId, const WCHAR* InDescription,
+                                              SIZE_T InVideoMemory)
+{
+    CheckForChanges();
+
+    auto key = Key(InLuid);
+
+    // Version is read before snapshot, a snapshot published in between is picked up at next call
+    auto version = Config::SnapshotVersion();
+    auto table = _table.load(std::memory_order_acquire);
+
+    if (table != nullptr && table->ConfigVersion == version)
+    {
+        auto it = table->Entries.find(key);
+
+        if (it != table->Entries.end())
+            return &it->second;
+    }
+
+    std::scoped_lock lock(_mutex);
+
+    // Another thread might have updated it
+    version = Config::SnapshotVersion();
+    table = _table.load(std::memory_order_acquire);
+
+    if (table != nullptr && table->ConfigVersion == version)
+    {
+        auto it = table->Entries.find(key);
+
+        if (it != table->Entries.end())
+            return &it->second;
+    }
+
+    auto config = Config::Snapshot();
+    auto newTable = new Table();
+    newTable->ConfigVersion = version;
+
+    if (table != nullptr)
+    {
+        newTable->Entries = table->Entries;
+
+        if (table->ConfigVersion != version)
+        {
+            for (auto& [entryKey, entry] : newTable->Entries)
+                Build(&entry, config);
+        }
+    }
+
+    if (!newTable->Entries.contains(key))
+    {
+        Entry entry{};
+        entry.Original.Luid = InLuid;
+        entry.Original.VendorId = InVendorId;
+        entry.Original.DeviceId = InDeviceId;
+        entry.Original.DedicatedVideoMemory = InVideoMemory;
+        entry.Original.Description = std::wstring(InDescription, wcsnlen(InDescription, 128));
+        Build(&entry, config);
+
+        if (InVendorId != 0x1414)
+            LOG_INFO("Adapter: {}, VRAM: {} MB", wstring_to_string(entry.Original.Description), InVideoMemory / (1024 * 1024));
+
+        newTable->Entries.try_emplace(key, entry);
+    }
+
+    Publish(newTable);
+
+    return &newTable->Entries.find(key)->second;
+}
+
+void AdapterTable::Apply(const LUID& InLuid, UINT* InOutVendorId, UINT* InOutDeviceId, WCHAR* InOutDescription, SIZE_T* InOutVideoMemory,
+                         bool(*InSkipSpoofing)())
+{
+    auto entry = Find(InLuid, *InOutVendorId, *InOutDeviceId, InOutDescription, *InOutVideoMemory);
+
+    *InOutVideoMemory = entry->DedicatedVideoMemory;
+
+    if (!entry->Spoof || InSkipSpoofing())
+        return;
+
+    *InOutVendorId = entry->VendorId;
+    *InOutDeviceId = entry->DeviceId;
+    std::memcpy(InOutDescription, entry->Description, sizeof(entry->Description));
+
+#ifdef _DEBUG
+    LOG_DEBUG("spoofing");
+#endif
+}
+
+std::vector<AdapterTable::Adapter> AdapterTable::Adapters()
+{
+    CheckForChanges();
+
+    std::vector<Adapter> result;
+
+    auto table = _table.load(std::memory_order_acquire);
+
+    if (table == nullptr)
+        return result;
+
+    result.reserve(table->Entries.size());
+
+    for (auto& [key, entry] : table->Entries)
+        result.push_back(entry.Original);
+
+    return result;
+}
+
+void AdapterTable::WatchFactory(IUnknown* InFactory)
+{
+    if (_factory.load(std::memory_order_acquire) != nullptr || InFactory == nullptr)
+        return;
+
+    std::scoped_lock lock(_factoryMutex);
+
+    if (_factory.load(std::memory_order_relaxed) != nullptr)
+        return;
+
+    IDXGIFactory7* factory7 = nullptr;
+    if (InFactory->QueryInterface(IID_PPV_ARGS(&factory7)) != S_OK || factory7 == nullptr)
+        return;
+
+    auto changedEvent = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+
+    if (changedEvent == nullptr || factory7->RegisterAdaptersChangedEvent(changedEvent, &_changedCookie) != S_OK)
+    {
+        LOG_WARN("Can't register for adapter changes");
+
+        if (changedEvent != nullptr)
+            CloseHandle(changedEvent);
+
+        factory7->Release();
+        return;
+    }
+
+    // Factory is kept alive for notifications
+    _changedEvent.store(changedEvent, std::memory_order_release);
+    _factory.store(factory7, std::memory_order_release);
+
+    LOG_DEBUG("Registered for adapter changes");
+}
+
+void AdapterTable::Invalidate()
+{
+    std::scoped_lock lock(_mutex);
+
+    auto newTable = new Table();
+    newTable->ConfigVersion = Config::SnapshotVersion();
+
+    Publish(newTable);
+}
@@ -0,0 +1,105 @@
+#pragma once
+#include <pch.h>
+
+#include <dxgi1_6.h>
+#include <ankerl/unordered_dense.h>
+
+#include <mutex>
+
+struct ConfigSnapshot;
+
+// Adapters seen by GetDesc hooks & GPU detection, keyed by LUID
+// Each entry keeps original desc of adapter and desc with VRAM override & spoofed values of config snapshot
+// Spoofed descs are rebuilt when a changed config snapshot is published, GetDesc hooks only copy them
+// Table is immutable once published, readers don't lock. Replaced tables are freed after a grace period like config snapshots
+// Table is cleared when DXGI signals an adapter change (added/removed)
+class AdapterTable
+{
+public:
+    struct Adapter
+    {
+        LUID Luid{};
+        UINT VendorId = 0;
+        UINT DeviceId = 0;
+        SIZE_T DedicatedVideoMemory = 0;
+        std::wstring Description;
+    };
+
+private:
+    struct Entry
+    {
+        Adapter Original;
+
+        // Values returned by GetDesc hooks
+        bool Spoof = false;
+        UINT VendorId = 0;
+        UINT DeviceId = 0;
+        SIZE_T DedicatedVideoMemory = 0;
+        WCHAR Description[128]{};
+    };
+
+    struct Table
+    {
+        uint32_t ConfigVersion = 0;
+        ankerl::unordered_dense::map<UINT64, Entry> Entries;
+    };
+
+    // Much longer than any GetDesc call
+    static constexpr double TableGracePeriodMs = 1000.0;
+
+    struct RetiredTable
+    {
+        const Table* Retired = nullptr;
+        double RetiredMs = 0.0;
+    };
+
+    // Only taken by writers
+    static inline std::mutex _mutex;
+    static inline std::atomic<const Table*> _table = nullptr;
+    static inline std::vector<RetiredTable> _retiredTables;
+
+    static inline std::mutex _factoryMutex;
+    static inline std::atomic<IDXGIFactory7*> _factory = nullptr;
+    static inline std::atomic<HANDLE> _changedEvent = nullptr;
+    static inline DWORD _changedCookie = 0;
+
+    static UINT64 Key(const LUID& InLuid) { return ((UINT64)(UINT)InLuid.HighPart << 32) | InLuid.LowPart; }
+
+    static void CheckForChanges();
+
+    // Fills spoofed values of InOutEntry from InConfig
+    static void Build(Entry* InOutEntry, const ConfigSnapshot* InConfig);
+
+    // Swaps current table with InTable, must be called with _mutex held
+    static void Publish(Table* InTable);
+
+    // Returns entry of adapter from current table, adds adapter & rebuilds table when needed
+    static const Entry* Find(const LUID& InLuid, UINT InVendorId, UINT InDeviceId, const WCHAR* InDescription, SIZE_T InVideoMemory);
+
+    static void Apply(const LUID& InLuid, UINT* InOutVendorId, UINT* InOutDeviceId, WCHAR* InOutDescription, SIZE_T* InOutVideoMemory,
+                      bool(*InSkipSpoofing)());
+
+public:
+    // Adds adapter of InDesc (any DXGI_ADAPTER_DESC version) if it's not in table
+    template <typename T>
+    static void Register(const T* InDesc)
+    {
+        Find(InDesc->AdapterLuid, InDesc->VendorId, InDesc->DeviceId, InDesc->Description, InDesc->DedicatedVideoMemory);
+    }
+
+    // Registers & patches InOutDesc with prebuilt VRAM override & spoofed values
+    // InSkipSpoofing is only called for adapters which would be spoofed
+    template <typename T>
+    static void Apply(T* InOutDesc, bool(*InSkipSpoofing)())
+    {
+        Apply(InOutDesc->AdapterLuid, &InOutDesc->VendorId, &InOutDesc->DeviceId, InOutDesc->Description, &InOutDesc->DedicatedVideoMemory, InSkipSpoofing);
+    }
+
+    // Copy of every adapter in table
+    static std::vector<Adapter> Adapters();
+
+    // Registers for adapter change notifications with first IDXGIFactory7
+    static void WatchFactory(IUnknown* InFactory);
+
+    static void Invalidate();
+};
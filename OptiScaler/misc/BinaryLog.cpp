@@ -0,0 +1,385 @@
+#include <pch.h>
+#include "BinaryLog.h"
+
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace BinaryLogFormat;
+
+// Single producer (owner thread) single consumer (writer thread) ring of encoded records
+// Head & Tail only grow, positions in ring are taken modulo Capacity
+struct BinaryLogThreadBuffer
+{
+    static const uint32_t Capacity = 256 * 1024;
+
+    uint32_t ThreadId = 0;
+    std::atomic<uint64_t> Head = 0;
+    std::atomic<uint64_t> Tail = 0;
+    std::atomic<uint32_t> Dropped = 0;
+    uint32_t ReportedDropped = 0;
+    std::atomic<bool> Exited = false;    // Owner thread is gone, ring is recycled once drained
+    std::unique_ptr<uint8_t[]> Data;
+};
+
+// Set when owner of thread's buffer is destroyed, it's trivially destructible so it can be read after that
+static thread_local bool threadExiting = false;
+
+// Marks buffer of an exiting thread, thread_local destructors run on thread exit
+struct BinaryLogThreadOwner
+{
+    BinaryLogThreadBuffer* Buffer = nullptr;
+
+    ~BinaryLogThreadOwner()
+    {
+        threadExiting = true;
+
+        if (Buffer != nullptr)
+            Buffer->Exited.store(true, std::memory_order_release);
+
+        Buffer = nullptr;
+    }
+};
+
+// Dropped count of a thread, written after events drained with it
+struct BinaryLogDropped
+{
+    uint32_t ThreadId;
+    uint32_t Count;
+};
+
+struct BinaryLogFormatInfo
+{
+    const char* Format;
+    spdlog::level::level_enum Level;
+};
+
+// Buffers of exited threads are moved to freeBuffers by writer after they are drained, new threads reuse them
+static const size_t MaxFreeBuffers = 8;
+static std::mutex buffersMutex;
+static std::vector<std::unique_ptr<BinaryLogThreadBuffer>> buffers;
+static std::vector<std::unique_ptr<BinaryLogThreadBuffer>> freeBuffers;
+static thread_local BinaryLogThreadOwner threadBuffer;
+
+// Logs of threads whose buffer owner is already destroyed (later thread_local destructors), producers are serialized by
+// sharedBufferMutex. It's never marked exited so it stays in buffers
+static std::mutex sharedBufferMutex;
+static BinaryLogThreadBuffer* sharedBuffer = nullptr;
+
+static std::mutex formatsMutex;
+static std::vector<BinaryLogFormatInfo> formats;
+static size_t writtenFormats = 0;
+
+// Timed so final drain can't hang when writer thread is killed during process exit
+static std::timed_mutex writeMutex;
+static std::ofstream file;
+
+// Writer thread exits when it's changed by Stop
+static std::atomic<uint32_t> writerGeneration = 0;
+
+static int64_t Now()
+{
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return counter.QuadPart;
+}
+
+static BinaryLogThreadBuffer* GetSharedBuffer()
+{
+    std::lock_guard<std::mutex> lock(buffersMutex);
+
+    if (sharedBuffer == nullptr)
+    {
+        auto buffer = std::make_unique<BinaryLogThreadBuffer>();
+        buffer->Data = std::make_unique<uint8_t[]>(BinaryLogThreadBuffer::Capacity);
+
+        sharedBuffer = buffer.get();
+        buffers.push_back(std::move(buffer));
+    }
+
+    return sharedBuffer;
+}
+
+static BinaryLogThreadBuffer* GetThreadBuffer()
+{
+    if (threadBuffer.Buffer != nullptr)
+        return threadBuffer.Buffer;
+
+    std::lock_guard<std::mutex> lock(buffersMutex);
+
+    std::unique_ptr<BinaryLogThreadBuffer> buffer;
+
+    // Recycled buffers are drained, Head & Tail keep growing from where they are
+    if (!freeBuffers.empty())
+    {
+        buffer = std::move(freeBuffers.back());
+        freeBuffers.pop_back();
+
+        buffer->Dropped.store(0, std::memory_order_relaxed);
+        buffer->ReportedDropped = 0;
+        buffer->Exited.store(false, std::memory_order_relaxed);
+    }
+    else
+    {
+        buffer = std::make_unique<BinaryLogThreadBuffer>();
+        buffer->Data = std::make_unique<uint8_t[]>(BinaryLogThreadBuffer::Capacity);
+    }
+
+    buffer->ThreadId = GetCurrentThreadId();
+    threadBuffer.Buffer = buffer.get();
+    buffers.push_back(std::move(buffer));
+
+    return threadBuffer.Buffer;
+}
+
+static void WriteRecord(RecordType InType, uint8_t InLevel, uint32_t InId, uint32_t InThreadId, const void* InPayload, uint16_t InSize)
+{
+    RecordHeader header{};
+    header.Type = (uint8_t)InType;
+    header.Level = InLevel;
+    header.Size = InSize;
+    header.Id = InId;
+    header.ThreadId = InThreadId;
+    header.Counter = Now();
+
+    file.write((const char*)&header, sizeof(header));
+
+    if (InSize > 0)
+        file.write((const char*)InPayload, InSize);
+}
+
+// Caller must hold writeMutex
+// Rings & formats are copied under their locks, file is written after releasing them so logging threads never wait for disk
+static void Drain()
+{
+    if (!file.is_open())
+        return;
+
+    // Only used by Drain, kept to avoid allocating on every drain
+    static std::vector<uint8_t> events;
+    static std::vector<BinaryLogFormatInfo> newFormats;
+    static std::vector<BinaryLogDropped> dropped;
+
+    size_t firstFormat = 0;
+
+    events.clear();
+    newFormats.clear();
+    dropped.clear();
+
+    {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+
+        // Heads are read before formats, so formats of every drained event are already registered
+        std::vector<uint64_t> heads(buffers.size());
+
+        for (size_t i = 0; i < buffers.size(); i++)
+            heads[i] = buffers[i]->Head.load(std::memory_order_acquire);
+
+        {
+            std::lock_guard<std::mutex> formatLock(formatsMutex);
+
+            firstFormat = writtenFormats;
+            newFormats.assign(formats.begin() + writtenFormats, formats.end());
+            writtenFormats = formats.size();
+        }
+
+        for (size_t i = 0; i < buffers.size(); i++)
+        {
+            auto& buffer = buffers[i];
+            auto tail = buffer->Tail.load(std::memory_order_relaxed);
+            auto size = heads[i] - tail;
+
+            if (size > 0)
+            {
+                auto start = (uint32_t)(tail % BinaryLogThreadBuffer::Capacity);
+                auto first = std::min<uint64_t>(size, BinaryLogThreadBuffer::Capacity - start);
+
+                events.insert(events.end(), buffer->Data.get() + start, buffer->Data.get() + start + first);
+
+                if (size > first)
+                    events.insert(events.end(), buffer->Data.get(), buffer->Data.get() + (size - first));
+
+                // Space can be reused by owner thread after this
+                buffer->Tail.store(heads[i], std::memory_order_release);
+            }
+
+            auto droppedCount = buffer->Dropped.load(std::memory_order_relaxed);
+
+            if (droppedCount != buffer->ReportedDropped)
+            {
+                dropped.push_back({ buffer->ThreadId, droppedCount - buffer->ReportedDropped });
+                buffer->ReportedDropped = droppedCount;
+            }
+        }
+
+        // Exited threads don't push anymore, their rings are empty after the copy above
+        for (size_t i = 0; i < buffers.size();)
+        {
+            auto& buffer = buffers[i];
+
+            if (!buffer->Exited.load(std::memory_order_acquire) ||
+                buffer->Head.load(std::memory_order_acquire) != buffer->Tail.load(std::memory_order_relaxed))
+            {
+                i++;
+                continue;
+            }
+
+            if (freeBuffers.size() < MaxFreeBuffers)
+                freeBuffers.push_back(std::move(buffer));
+
+            buffers.erase(buffers.begin() + i);
+        }
+    }
+
+    for (size_t i = 0; i < newFormats.size(); i++)
+    {
+        auto& format = newFormats[i];
+        auto length = strnlen(format.Format, UINT16_MAX);
+        WriteRecord(RecordType::Format, (uint8_t)format.Level, (uint32_t)(firstFormat + i), 0, format.Format, (uint16_t)length);
+    }
+
+    if (!events.empty())
+        file.write((const char*)events.data(), events.size());
+
+    for (auto& entry : dropped)
+        WriteRecord(RecordType::Dropped, 0, entry.Count, entry.ThreadId, nullptr, 0);
+
+    file.flush();
+}
+
+// Caller must be the only producer of InBuffer
+static void PushTo(BinaryLogThreadBuffer* InBuffer, uint32_t InThreadId, uint32_t InId, const uint8_t* InPayload, uint32_t InSize)
+{
+    RecordHeader header{};
+    header.Type = (uint8_t)RecordType::Event;
+    header.Size = (uint16_t)InSize;
+    header.Id = InId;
+    header.ThreadId = InThreadId;
+    header.Counter = Now();
+
+    auto recordSize = sizeof(header) + InSize;
+    auto head = InBuffer->Head.load(std::memory_order_relaxed);
+
+    if (head - InBuffer->Tail.load(std::memory_order_acquire) + recordSize > BinaryLogThreadBuffer::Capacity)
+    {
+        InBuffer->Dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    auto copy = [InBuffer](uint64_t InPosition, const void* InData, size_t InSize)
+    {
+        auto start = (uint32_t)(InPosition % BinaryLogThreadBuffer::Capacity);
+        auto first = std::min<size_t>(InSize, BinaryLogThreadBuffer::Capacity - start);
+
+        memcpy(InBuffer->Data.get() + start, InData, first);
+
+        if (InSize > first)
+            memcpy(InBuffer->Data.get(), (const uint8_t*)InData + first, InSize - first);
+    };
+
+    copy(head, &header, sizeof(header));
+    copy(head + sizeof(header), InPayload, InSize);
+
+    InBuffer->Head.store(head + recordSize, std::memory_order_release);
+}
+
+void BinaryLog::Push(uint32_t InId, const uint8_t* InPayload, uint32_t InSize)
+{
+    // A new ring of an exiting thread would never be marked exited & recycled
+    if (threadExiting)
+    {
+        auto buffer = GetSharedBuffer();
+
+        std::lock_guard<std::mutex> lock(sharedBufferMutex);
+        PushTo(buffer, GetCurrentThreadId(), InId, InPayload, InSize);
+
+        return;
+    }
+
+    auto buffer = GetThreadBuffer();
+    PushTo(buffer, buffer->ThreadId, InId, InPayload, InSize);
+}
+
+uint32_t BinaryLog::Register(spdlog::level::level_enum InLevel, const char* InFormat)
+{
+    std::lock_guard<std::mutex> lock(formatsMutex);
+
+    formats.push_back({ InFormat, InLevel });
+    return (uint32_t)formats.size() - 1;
+}
+
+void BinaryLog::Start(const std::wstring& InPath)
+{
+    std::lock_guard<std::timed_mutex> lock(writeMutex);
+
+    if (_active || file.is_open())
+        return;
+
+    file.open(InPath, std::ios::binary | std::ios::trunc);
+
+    if (!file.is_open())
+    {
+        spdlog::error("BinaryLog::Start Can't open {}", wstring_to_string(InPath));
+        return;
+    }
+
+    LARGE_INTEGER frequency;
+    QueryPerformanceFrequency(&frequency);
+
+    SYSTEMTIME time;
+    GetLocalTime(&time);
+
+    FileHeader header{};
+    header.Magic = Magic;
+    header.Version = Version;
+    header.Frequency = frequency.QuadPart;
+    header.StartCounter = Now();
+    header.StartTimeOfDayUs = (((time.wHour * 60ll + time.wMinute) * 60ll + time.wSecond) * 1000ll + time.wMilliseconds) * 1000ll;
+
+    file.write((const char*)&header, sizeof(header));
+
+    // Every format is written again to new file
+    {
+        std::lock_guard<std::mutex> formatLock(formatsMutex);
+        writtenFormats = 0;
+    }
+
+    auto generation = ++writerGeneration;
+    _active = true;
+
+    // Detached, joining from DLL_PROCESS_DETACH would deadlock
+    std::thread([generation]()
+                {
+                    while (writerGeneration == generation)
+                    {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+                        std::lock_guard<std::timed_mutex> lock(writeMutex);
+
+                        if (writerGeneration != generation)
+                            break;
+
+                        Drain();
+                    }
+                }).detach();
+
+    spdlog::info("BinaryLog::Start Trace & debug logs are written to {}", wstring_to_string(InPath));
+}
+
+void BinaryLog::Stop()
+{
+    if (!_active)
+        return;
+
+    _active = false;
+    writerGeneration++;
+
+    if (!writeMutex.try_lock_for(std::chrono::milliseconds(100)))
+        return;
+
+    Drain();
+    file.close();
+
+    writeMutex.unlock();
+}
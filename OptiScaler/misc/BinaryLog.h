@@ -0,0 +1,144 @@
+#pragma once
+
+// Included by pch.h after spdlog, doesn't include pch.h itself
+#include "BinaryLogFormat.h"
+
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// Binary mode of trace & debug logs (Log.LogBinary)
+// Call sites register their format string once and store only its id, a timestamp & raw arguments
+// into a lock free per thread buffer, a background thread appends them to a .blog file next to log file
+// Files are converted to text with tools/BinaryLogDecoder
+class BinaryLog
+{
+    static inline std::atomic<bool> _active = false;
+
+    template <typename T>
+    static constexpr bool Encodable = std::is_arithmetic_v<T> || std::is_pointer_v<T> ||
+                                      std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>;
+
+    static void Put(uint8_t* OutPayload, uint32_t* InOutSize, BinaryLogFormat::ArgType InType, const void* InData, uint32_t InDataSize)
+    {
+        // Arguments which don't fit are dropped, decoder shows them as missing
+        if (*InOutSize + 1 + InDataSize > BinaryLogFormat::MaxPayload)
+            return;
+
+        OutPayload[*InOutSize] = (uint8_t)InType;
+        memcpy(OutPayload + *InOutSize + 1, InData, InDataSize);
+        *InOutSize += 1 + InDataSize;
+    }
+
+    static void PutString(uint8_t* OutPayload, uint32_t* InOutSize, const char* InData, size_t InLength)
+    {
+        auto length = (uint16_t)(InLength < BinaryLogFormat::MaxString ? InLength : BinaryLogFormat::MaxString);
+
+        if (*InOutSize + 3 + length > BinaryLogFormat::MaxPayload)
+            return;
+
+        OutPayload[*InOutSize] = (uint8_t)BinaryLogFormat::ArgType::String;
+        memcpy(OutPayload + *InOutSize + 1, &length, sizeof(length));
+        memcpy(OutPayload + *InOutSize + 3, InData, length);
+        *InOutSize += 3 + length;
+    }
+
+    template <typename T>
+    static void Encode(uint8_t* OutPayload, uint32_t* InOutSize, const T& InValue)
+    {
+        using Type = std::decay_t<T>;
+        using enum BinaryLogFormat::ArgType;
+
+        if constexpr (std::is_same_v<Type, bool>)
+        {
+            uint8_t value = InValue ? 1 : 0;
+            Put(OutPayload, InOutSize, Bool, &value, 1);
+        }
+        else if constexpr (std::is_same_v<Type, char>)
+        {
+            Put(OutPayload, InOutSize, Char, &InValue, 1);
+        }
+        else if constexpr (std::is_integral_v<Type> && std::is_signed_v<Type>)
+        {
+            int64_t value = InValue;
+            Put(OutPayload, InOutSize, Int, &value, 8);
+        }
+        else if constexpr (std::is_integral_v<Type>)
+        {
+            uint64_t value = InValue;
+            Put(OutPayload, InOutSize, UInt, &value, 8);
+        }
+        else if constexpr (std::is_floating_point_v<Type>)
+        {
+            double value = InValue;
+            Put(OutPayload, InOutSize, Double, &value, 8);
+        }
+        else if constexpr (std::is_same_v<Type, const char*> || std::is_same_v<Type, char*>)
+        {
+            if (InValue == nullptr)
+                PutString(OutPayload, InOutSize, "", 0);
+            else
+                PutString(OutPayload, InOutSize, InValue, strnlen(InValue, BinaryLogFormat::MaxString));
+        }
+        else if constexpr (std::is_same_v<Type, std::string> || std::is_same_v<Type, std::string_view>)
+        {
+            PutString(OutPayload, InOutSize, InValue.data(), InValue.size());
+        }
+        else if constexpr (std::is_pointer_v<Type>)
+        {
+            uint64_t value = (uint64_t)(uintptr_t)InValue;
+            Put(OutPayload, InOutSize, Pointer, &value, 8);
+        }
+
+        // Other types are never written, CanEncode is false for them
+    }
+
+    static void Push(uint32_t InId, const uint8_t* InPayload, uint32_t InSize);
+
+public:
+    // Opens InPath & starts writer thread, does nothing if already running
+    static void Start(const std::wstring& InPath);
+
+    // Writes remaining events & closes file
+    static void Stop();
+
+    // Used in decltype of log macros, arguments are not evaluated
+    template <typename... Args>
+    static std::bool_constant<(Encodable<std::decay_t<Args>> && ...)> CanEncode(const Args&...);
+
+    static bool Accepts(spdlog::level::level_enum InLevel, bool InEncodable)
+    {
+        return InEncodable && _active.load(std::memory_order_relaxed) && spdlog::default_logger_raw()->should_log(InLevel);
+    }
+
+    // Called once per call site, InFormat must be a string literal
+    static uint32_t Register(spdlog::level::level_enum InLevel, const char* InFormat);
+
+    template <typename... Args>
+    static void Write(uint32_t InId, const Args&... InArgs)
+    {
+        uint8_t payload[BinaryLogFormat::MaxPayload];
+        uint32_t size = 0;
+
+        (Encode(payload, &size, InArgs), ...);
+
+        Push(InId, payload, size);
+    }
+};
+
+// Trace & debug macros of pch.h, falls back to spdlog when binary mode is off or an argument can't be stored raw
+#define BINARY_LOG_OR_SPDLOG(level, func, msg, ...) \
+    do \
+    { \
+        if (BinaryLog::Accepts(level, decltype(BinaryLog::CanEncode(__VA_ARGS__))::value)) \
+        { \
+            static const uint32_t _binaryLogId = BinaryLog::Register(level, msg); \
+            BinaryLog::Write(_binaryLogId, ##__VA_ARGS__); \
+        } \
+        else \
+        { \
+            func(msg, ##__VA_ARGS__); \
+        } \
+    } while (0)
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <stdint.h>
+
+// File layout of binary logs, shared with tools/BinaryLogDecoder
+// Only depends on standard headers so decoder can be built without Windows SDK
+//
+// FileHeader, then records which start with RecordHeader:
+//   Format : Id = format id, Level = spdlog level, payload = format string (not terminated)
+//   Event  : Id = format id, payload = arguments, each one is an ArgType byte followed by its value
+//   Dropped: Id = count of events dropped because thread buffer was full
+namespace BinaryLogFormat
+{
+    constexpr uint32_t Magic = 0x4C42534F; // OSBL
+    constexpr uint32_t Version = 1;
+
+    constexpr uint32_t MaxPayload = 1024;
+    constexpr uint32_t MaxString = 256;
+
+    enum class RecordType : uint8_t
+    {
+        Format = 1,
+        Event = 2,
+        Dropped = 3
+    };
+
+    // Int, UInt, Double & Pointer are 8 bytes, Bool & Char 1 byte
+    // String is uint16_t length followed by characters
+    enum class ArgType : uint8_t
+    {
+        Int = 1,
+        UInt = 2,
+        Double = 3,
+        Bool = 4,
+        Char = 5,
+        Pointer = 6,
+        String = 7
+    };
+
+#pragma pack(push, 1)
+    struct FileHeader
+    {
+        uint32_t Magic;
+        uint32_t Version;
+        int64_t Frequency;         // Counter ticks per second
+        int64_t StartCounter;      // Counter value at StartTimeOfDayUs
+        int64_t StartTimeOfDayUs;  // Local time since midnight
+    };
+
+    struct RecordHeader
+    {
+        uint8_t Type;
+        uint8_t Level;
+        uint16_t Size;   // Payload size after header
+        uint32_t Id;
+        uint32_t ThreadId;
+        int64_t Counter;
+    };
+#pragma pack(pop)
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <stdint.h>
+
+// Render scale controller of DrsGovernor, shared with tools/DrsGovernorTest
+// Only depends on standard headers so it can be tested without Windows SDK
+//
+// Samples are GPU busy times of frames: from the frame start timestamp written after previous present
+// to end of the frame's upscale pass. Scale is adjusted with a PI controller in pixel count domain
+struct DrsController
+{
+    // Controller runs every few frames to let new resolution settle
+    static constexpr uint32_t UpdateInterval = 4;
+    static constexpr double SmoothingFactor = 0.1;
+    static constexpr double ProportionalGain = 0.5;
+    static constexpr double IntegralGain = 0.1;
+
+    double SmoothedFrameTime = 0.0;
+    double LastError = 0.0;
+    uint32_t FrameCounter = 0;
+
+    // InSleepMs is frame limiter's sleep after present, GPU is idle during it when it's not behind
+    // Returns false for samples which are skipped (hitches & loading screens)
+    bool AddSample(double InBusyMs, double InSleepMs)
+    {
+        if (InBusyMs <= 0.0 || InBusyMs > 250.0)
+            return false;
+
+        auto busyTime = std::max(InBusyMs - InSleepMs, 0.1);
+
+        if (SmoothedFrameTime == 0.0)
+            SmoothedFrameTime = busyTime;
+        else
+            SmoothedFrameTime += SmoothingFactor * (busyTime - SmoothedFrameTime);
+
+        return true;
+    }
+
+    // Returns InScale when it's not time to update yet
+    float Step(float InScale, double InTargetMs, float InMinScale, float InMaxScale)
+    {
+        if (SmoothedFrameTime <= 0.0 || ++FrameCounter % UpdateInterval != 0)
+            return InScale;
+
+        // GPU cost is roughly linear with pixel count, positive error means there is headroom
+        auto error = std::clamp(InTargetMs / SmoothedFrameTime - 1.0, -0.5, 0.5);
+
+        // Velocity form of PI, clamping pixel ratio also prevents integral windup
+        double pixelRatio = (double)InScale * InScale;
+        pixelRatio += ProportionalGain * (error - LastError) + IntegralGain * error;
+        LastError = error;
+
+        pixelRatio = std::clamp(pixelRatio, (double)(InMinScale * InMinScale), (double)(InMaxScale * InMaxScale));
+
+        return (float)std::sqrt(pixelRatio);
+    }
+
+    void Reset()
+    {
+        SmoothedFrameTime = 0.0;
+        LastError = 0.0;
+        FrameCounter = 0;
+    }
+};
@@ -0,0 +1,86 @@
+#include "DrsGovernor.h"
+
+#include "Config.h"
+#include "FrameLimit.h"
+
+#include <cmath>
+
+constexpr float ScaleStep = 0.01f;
+
+bool DrsGovernor::IsActive()
+{
+    return Config::Instance()->DrsGovernorEnabled.value_or_default();
+}
+
+void DrsGovernor::AddGpuFrameTime(double InFrameTimeMs)
+{
+    if (IsActive())
+        _gpuFrameTime = InFrameTimeMs;
+}
+
+void DrsGovernor::Update()
+{
+    if (!IsActive())
+    {
+        if (_scale > 0.0f)
+            Reset();
+
+        return;
+    }
+
+    // Profilers read results a few frames later, not every present has a new sample
+    // Frame start is written before limiter's sleep, GPU waits for next frame while limiter sleeps
+    if (!_controller.AddSample(_gpuFrameTime.exchange(0.0), FrameLimit::LastSleepMs()))
+        return;
+
+    // Scale is initialized on first render size query
+    if (_scale <= 0.0f)
+        return;
+
+    auto target = (double)Config::Instance()->DrsTargetFrameTime.value_or_default();
+    auto newScale = _controller.Step(_scale, target, _minScale, _maxScale);
+
+    if (std::abs(newScale - _scale) >= ScaleStep)
+        LOG_DEBUG("GPU frame time: {0:.2f} ms, target: {1:.2f} ms, scale: {2:.3f} -> {3:.3f}", _controller.SmoothedFrameTime, target, (float)_scale, newScale);
+
+    _scale = newScale;
+}
+
+float DrsGovernor::Scale(float InDefaultScale, float InMinScale, float InMaxScale)
+{
+    if (InMinScale > InMaxScale)
+        std::swap(InMinScale, InMaxScale);
+
+    _minScale = InMinScale;
+    _maxScale = InMaxScale;
+
+    if (_scale <= 0.0f)
+    {
+        LOG_INFO("Starting with scale: {0:.3f} ({1:.3f} - {2:.3f})", InDefaultScale, InMinScale, InMaxScale);
+        _scale = std::clamp(InDefaultScale, InMinScale, InMaxScale);
+    }
+
+    // Quantize to prevent resizing for every tiny change
+    auto scale = std::round(_scale / ScaleStep) * ScaleStep;
+
+    return std::clamp(scale, InMinScale, InMaxScale);
+}
+
+std::optional<float> DrsGovernor::UpscaleRatio()
+{
+    if (!IsActive())
+        return std::nullopt;
+
+    // These inputs have no DRS bounds, bounds of last DLSS query or defaults are used
+    // First call starts from Quality ratio
+    auto scale = Scale(1.0f / 1.5f, _minScale, _maxScale);
+
+    return 1.0f / scale;
+}
+
+void DrsGovernor::Reset()
+{
+    _scale = 0.0f;
+    _gpuFrameTime = 0.0;
+    _controller.Reset();
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <pch.h>
+
+#include "DrsController.h"
+
+#include <atomic>
+#include <optional>
+
+// GPU frame time targeted render scale controller
+// Frame time is the GPU busy time of a frame reported by GPU profilers, from the frame start timestamp
+// written after previous present to end of upscaler pass, so GPU idle time of capped or CPU bound games is left out
+// Render scale is adjusted by DrsController once per present and handed to the game through
+// DLSS optimal settings & upscale ratio overrides of other inputs
+class DrsGovernor
+{
+    static inline std::atomic<float> _scale = 0.0f;
+    static inline std::atomic<float> _minScale = 0.5f;
+    static inline std::atomic<float> _maxScale = 1.0f;
+
+    // Latest sample which is not consumed by Update, 0 when there is none
+    static inline std::atomic<double> _gpuFrameTime = 0.0;
+
+    static inline DrsController _controller;
+
+public:
+    static bool IsActive();
+
+    // Called by GPU profilers with time from frame start to end of upscaler pass
+    static void AddGpuFrameTime(double InFrameTimeMs);
+
+    // Called once per present, uses GPU frame time reported since last call
+    static void Update();
+
+    // Returns governed render scale clamped to DRS bounds, InDefaultScale is used until first update
+    static float Scale(float InDefaultScale, float InMinScale, float InMaxScale);
+
+    // Upscale ratio (display / render) for ratio overrides of FSR & XeSS inputs, empty when governor is off
+    static std::optional<float> UpscaleRatio();
+
+    static float CurrentScale() { return _scale; }
+    static double SmoothedFrameTime() { return _controller.SmoothedFrameTime; }
+    static void Reset();
+};
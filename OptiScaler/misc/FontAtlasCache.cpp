@@ -0,0 +1,345 @@
+#include "FontAtlasCache.h"
+
+#include <Util.h>
+#include <Logger.h>
+
+#include "imgui/misc/freetype/imgui_freetype.h"
+
+#include <fstream>
+#include <thread>
+
+constexpr uint32_t CacheMagic = 0x544E4643; // CFNT
+constexpr uint32_t CacheFormatVersion = 1;
+
+static void HashBytes(uint64_t* InOutHash, const void* InData, size_t InSize)
+{
+    auto bytes = (const uint8_t*)InData;
+
+    // FNV-1a
+    for (size_t i = 0; i < InSize; i++)
+        *InOutHash = (*InOutHash ^ bytes[i]) * 1099511628211ull;
+}
+
+template <typename T>
+static void HashValue(uint64_t* InOutHash, const T& InValue)
+{
+    HashBytes(InOutHash, &InValue, sizeof(T));
+}
+
+std::filesystem::path FontAtlasCache::CachePath(uint64_t InKey)
+{
+    return Util::DllPath().parent_path() / "OptiScaler_Fonts" / std::format("{:016X}.bin", InKey);
+}
+
+uint64_t FontAtlasCache::Key(ImFontAtlas* InAtlas)
+{
+    uint64_t hash = 14695981039346656037ull;
+
+    HashValue(&hash, CacheFormatVersion);
+    HashValue(&hash, sizeof(ImFontGlyph));
+    HashValue(&hash, InAtlas->Flags);
+    HashValue(&hash, InAtlas->TexDesiredWidth);
+    HashValue(&hash, InAtlas->TexGlyphPadding);
+    HashValue(&hash, InAtlas->FontBuilderFlags);
+    HashValue(&hash, InAtlas->Fonts.Size);
+
+    for (auto& config : InAtlas->ConfigData)
+    {
+        HashValue(&hash, config.SizePixels);
+        HashValue(&hash, config.OversampleH);
+        HashValue(&hash, config.OversampleV);
+        HashValue(&hash, config.PixelSnapH);
+        HashValue(&hash, config.GlyphExtraSpacing);
+        HashValue(&hash, config.GlyphOffset);
+        HashValue(&hash, config.GlyphMinAdvanceX);
+        HashValue(&hash, config.GlyphMaxAdvanceX);
+        HashValue(&hash, config.MergeMode);
+        HashValue(&hash, config.FontBuilderFlags);
+        HashValue(&hash, config.RasterizerMultiply);
+        HashValue(&hash, config.RasterizerDensity);
+        HashValue(&hash, config.EllipsisChar);
+
+        // Same default as builders
+        auto ranges = config.GlyphRanges != nullptr ? config.GlyphRanges : InAtlas->GetGlyphRangesDefault();
+
+        for (; *ranges != 0; ranges++)
+            HashValue(&hash, *ranges);
+
+        HashValue(&hash, config.FontDataSize);
+        HashBytes(&hash, config.FontData, config.FontDataSize);
+    }
+
+    return hash;
+}
+
+bool FontAtlasCache::Load(ImFontAtlas* InAtlas, uint64_t InKey)
+{
+    auto path = CachePath(InKey);
+
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+        return false;
+
+    auto size = (size_t)file.tellg();
+    file.seekg(0);
+
+    std::vector<uint8_t> data(size);
+    if (!file.read((char*)data.data(), size))
+    {
+        LOG_ERROR("Can't read {0}", path.string());
+        return false;
+    }
+
+    size_t offset = 0;
+    auto read = [&data, &offset](size_t InSize) -> const uint8_t*
+    {
+        if (data.size() - offset < InSize)
+            return nullptr;
+
+        auto result = data.data() + offset;
+        offset += InSize;
+        return result;
+    };
+
+    Header header{};
+    auto headerData = read(sizeof(Header));
+
+    if (headerData == nullptr)
+        return false;
+
+    memcpy(&header, headerData, sizeof(Header));
+
+    if (header.Magic != CacheMagic || header.FormatVersion != CacheFormatVersion || header.Key != InKey || header.FontCount != InAtlas->Fonts.Size ||
+        header.TexWidth <= 0 || header.TexHeight <= 0 || header.CustomRectCount < 0 ||
+        header.PackIdMouseCursors >= header.CustomRectCount || header.PackIdLines >= header.CustomRectCount)
+    {
+        LOG_WARN("Font atlas cache {0} is invalid", path.string());
+        return false;
+    }
+
+    // Validate whole file before touching the atlas
+    std::vector<std::pair<FontInfo, const uint8_t*>> fonts;
+
+    for (int i = 0; i < header.FontCount; i++)
+    {
+        FontInfo info{};
+        auto infoData = read(sizeof(FontInfo));
+
+        if (infoData == nullptr)
+            return false;
+
+        memcpy(&info, infoData, sizeof(FontInfo));
+
+        auto glyphs = info.GlyphCount > 0 ? read(sizeof(ImFontGlyph) * info.GlyphCount) : nullptr;
+
+        if (glyphs == nullptr)
+            return false;
+
+        fonts.push_back({ info, glyphs });
+    }
+
+    auto rects = read(sizeof(RectInfo) * header.CustomRectCount);
+    auto bytesPerPixel = header.TexFormat == ImTextureFormat_Alpha8 ? 1 : 4;
+    auto pixels = read((size_t)header.TexWidth * header.TexHeight * bytesPerPixel);
+
+    if (rects == nullptr || pixels == nullptr || offset != data.size())
+    {
+        LOG_WARN("Font atlas cache {0} is truncated", path.string());
+        return false;
+    }
+
+    // Same steps with builders, old texture is kept for backends until it's replaced
+    InAtlas->PushTexPage();
+    InAtlas->TexData.AllocatePixels(header.TexWidth, header.TexHeight, header.TexFormat, false);
+    memcpy(InAtlas->TexData.TexPixels, pixels, (size_t)header.TexWidth * header.TexHeight * bytesPerPixel);
+
+    InAtlas->TexUvScale = header.TexUvScale;
+    InAtlas->TexUvWhitePixel = header.TexUvWhitePixel;
+    memcpy(InAtlas->TexUvLines, header.TexUvLines, sizeof(header.TexUvLines));
+
+    InAtlas->CustomRects.resize(header.CustomRectCount);
+
+    for (int i = 0; i < header.CustomRectCount; i++)
+    {
+        RectInfo rect{};
+        memcpy(&rect, rects + sizeof(RectInfo) * i, sizeof(RectInfo));
+
+        InAtlas->CustomRects[i] = ImFontAtlasCustomRect();
+        InAtlas->CustomRects[i].Width = rect.Width;
+        InAtlas->CustomRects[i].Height = rect.Height;
+        InAtlas->CustomRects[i].X = rect.X;
+        InAtlas->CustomRects[i].Y = rect.Y;
+    }
+
+    InAtlas->PackIdMouseCursors = header.PackIdMouseCursors;
+    InAtlas->PackIdLines = header.PackIdLines;
+
+    for (int i = 0; i < header.FontCount; i++)
+    {
+        auto& [info, glyphs] = fonts[i];
+        auto font = InAtlas->Fonts[i];
+
+        font->ClearOutputData();
+        font->ContainerAtlas = InAtlas;
+        font->FontSize = info.FontSize;
+        font->Ascent = info.Ascent;
+        font->Descent = info.Descent;
+        font->MetricsTotalSurface = info.MetricsTotalSurface;
+        font->FallbackChar = (ImWchar)info.FallbackChar;
+        font->EllipsisChar = (ImWchar)info.EllipsisChar;
+
+        font->Glyphs.resize(info.GlyphCount);
+        memcpy(font->Glyphs.Data, glyphs, sizeof(ImFontGlyph) * info.GlyphCount);
+        font->BuildLookupTable();
+    }
+
+    InAtlas->TexReady = true;
+    InAtlas->TexData.MarkDirty();
+
+    LOG_INFO("Loaded font atlas {0}x{1} from {2}", header.TexWidth, header.TexHeight, path.string());
+
+    return true;
+}
+
+void FontAtlasCache::Save(const ImFontAtlas* InAtlas, uint64_t InKey)
+{
+    if (InAtlas->TexData.TexPixels == nullptr)
+        return;
+
+    for (auto& rect : InAtlas->CustomRects)
+    {
+        // Glyph rects point to fonts, atlas is rasterized every time
+        if (rect.Font != nullptr)
+        {
+            LOG_DEBUG("Atlas has custom glyphs, not cached");
+            return;
+        }
+    }
+
+    Header header{};
+    header.Magic = CacheMagic;
+    header.FormatVersion = CacheFormatVersion;
+    header.Key = InKey;
+    header.TexFormat = InAtlas->TexData.TexFormat;
+    header.TexWidth = InAtlas->TexData.TexWidth;
+    header.TexHeight = InAtlas->TexData.TexHeight;
+    header.FontCount = InAtlas->Fonts.Size;
+    header.CustomRectCount = InAtlas->CustomRects.Size;
+    header.PackIdMouseCursors = InAtlas->PackIdMouseCursors;
+    header.PackIdLines = InAtlas->PackIdLines;
+    header.TexUvScale = InAtlas->TexUvScale;
+    header.TexUvWhitePixel = InAtlas->TexUvWhitePixel;
+    memcpy(header.TexUvLines, InAtlas->TexUvLines, sizeof(header.TexUvLines));
+
+    std::vector<uint8_t> data;
+    auto write = [&data](const void* InData, size_t InSize)
+    {
+        data.insert(data.end(), (const uint8_t*)InData, (const uint8_t*)InData + InSize);
+    };
+
+    write(&header, sizeof(Header));
+
+    for (auto font : InAtlas->Fonts)
+    {
+        FontInfo info{};
+        info.FontSize = font->FontSize;
+        info.Ascent = font->Ascent;
+        info.Descent = font->Descent;
+        info.MetricsTotalSurface = font->MetricsTotalSurface;
+        info.FallbackChar = font->FallbackChar;
+        info.EllipsisChar = font->EllipsisChar;
+        info.GlyphCount = font->Glyphs.Size;
+
+        write(&info, sizeof(FontInfo));
+        write(font->Glyphs.Data, sizeof(ImFontGlyph) * font->Glyphs.Size);
+    }
+
+    for (auto& rect : InAtlas->CustomRects)
+    {
+        RectInfo info{ rect.Width, rect.Height, rect.X, rect.Y };
+        write(&info, sizeof(RectInfo));
+    }
+
+    auto bytesPerPixel = header.TexFormat == ImTextureFormat_Alpha8 ? 1 : 4;
+    write(InAtlas->TexData.TexPixels, (size_t)header.TexWidth * header.TexHeight * bytesPerPixel);
+
+    auto path = CachePath(InKey);
+    auto tempPath = path;
+    tempPath += ".tmp";
+
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open() || !file.write((const char*)data.data(), data.size()))
+        {
+            LOG_ERROR("Can't write {0}", tempPath.string());
+            return;
+        }
+    }
+
+    // Replace old file only after new one is completely written
+    std::filesystem::rename(tempPath, path, ec);
+
+    if (ec)
+        LOG_ERROR("Can't replace {0}: {1}", path.string(), ec.message());
+    else
+        LOG_INFO("Saved font atlas ({0} bytes) to {1}", data.size(), path.string());
+}
+
+bool FontAtlasCache::Build(ImFontAtlas* InAtlas)
+{
+    auto key = Key(InAtlas);
+
+    if (Load(InAtlas, key))
+        return true;
+
+    auto start = Util::MillisecondsNow();
+
+    if (!ImGuiFreeType::GetBuilderForFreeType()->FontBuilder_Build(InAtlas))
+        return false;
+
+    LOG_DEBUG("Font atlas rasterized in {0:.2f} ms", Util::MillisecondsNow() - start);
+
+    Save(InAtlas, key);
+
+    return true;
+}
+
+const ImFontBuilderIO* FontAtlasCache::BuilderIO()
+{
+    static ImFontBuilderIO io{ Build };
+    return &io;
+}
+
+bool FontAtlasCache::IsCached(const std::function<bool(ImFontAtlas*)>& InSetup)
+{
+    ImFontAtlas atlas;
+
+    if (!InSetup(&atlas))
+        return false;
+
+    std::error_code ec;
+    return std::filesystem::exists(CachePath(Key(&atlas)), ec);
+}
+
+void FontAtlasCache::BuildAsync(std::function<bool(ImFontAtlas*)> InSetup)
+{
+    bool expected = false;
+
+    if (!_building.compare_exchange_strong(expected, true))
+        return;
+
+    // Not joined, rasterization is short and only touches its own atlas & file
+    std::thread([InSetup]()
+                {
+                    ImFontAtlas atlas;
+                    atlas.FontBuilderIO = BuilderIO();
+
+                    if (InSetup(&atlas))
+                        atlas.Build();
+
+                    _building = false;
+                }).detach();
+}
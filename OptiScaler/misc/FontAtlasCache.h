@@ -0,0 +1,77 @@
+#pragma once
+#include <pch.h>
+
+#include "imgui/imgui.h"
+#include "imgui/imgui_internal.h"
+
+#include <atomic>
+#include <filesystem>
+#include <functional>
+#include <vector>
+
+// Rasterized ImGui font atlases (texture, glyphs & custom rects) saved per font configuration
+// Atlas is loaded from disk instead of being rasterized by FreeType on every init & menu scale change
+class FontAtlasCache
+{
+    struct Header
+    {
+        uint32_t Magic;
+        uint32_t FormatVersion;
+        uint64_t Key;
+        uint32_t TexFormat;
+        int32_t TexWidth;
+        int32_t TexHeight;
+        int32_t FontCount;
+        int32_t CustomRectCount;
+        int32_t PackIdMouseCursors;
+        int32_t PackIdLines;
+        uint32_t Padding;
+        ImVec2 TexUvScale;
+        ImVec2 TexUvWhitePixel;
+        ImVec4 TexUvLines[IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1];
+    };
+
+    struct FontInfo
+    {
+        float FontSize;
+        float Ascent;
+        float Descent;
+        int32_t MetricsTotalSurface;
+        uint32_t FallbackChar;
+        uint32_t EllipsisChar;
+        int32_t GlyphCount;
+        uint32_t Padding;
+    };
+
+    struct RectInfo
+    {
+        uint16_t Width;
+        uint16_t Height;
+        uint16_t X;
+        uint16_t Y;
+    };
+
+    static inline std::atomic<bool> _building = false;
+
+    static std::filesystem::path CachePath(uint64_t InKey);
+
+    // Hash of everything which changes rasterization result, including font data
+    static uint64_t Key(ImFontAtlas* InAtlas);
+
+    static bool Load(ImFontAtlas* InAtlas, uint64_t InKey);
+    static void Save(const ImFontAtlas* InAtlas, uint64_t InKey);
+
+    // FontBuilder_Build of BuilderIO, falls back to FreeType when atlas is not cached
+    static bool Build(ImFontAtlas* InAtlas);
+
+public:
+    // Set as ImFontAtlas::FontBuilderIO before Build()
+    static const ImFontBuilderIO* BuilderIO();
+
+    // InSetup adds fonts to an empty atlas, returns false on error
+    static bool IsCached(const std::function<bool(ImFontAtlas*)>& InSetup);
+
+    // Rasterizes atlas of InSetup on a worker thread and saves it, does nothing if a build is running
+    static void BuildAsync(std::function<bool(ImFontAtlas*)> InSetup);
+    static bool IsBuilding() { return _building; }
+};
@@ -57,6 +57,8 @@ inline int FrameLimit::combined_sleep(int64_t ns) {
 
 void FrameLimit::sleep()
 {
+    _lastSleepMs = 0.0;
+
     if (auto fpsCap = Config::Instance()->FramerateLimit.value_or_default(); fpsCap != 0.0f)
     {
         uint64_t min_interval_us = std::clamp((uint64_t)(1'000'000 / fpsCap), 0ULL, 100'000'000ULL);
@@ -67,6 +69,8 @@ void FrameLimit::sleep()
             if (auto res = combined_sleep(min_interval_us * 1000 - frame_time); res)
                 LOG_ERROR("Sleep command failed: {}", res);
         }
-        previous_frame_time = get_timestamp();
+        auto sleep_end = get_timestamp();
+        _lastSleepMs = (double)(sleep_end - current_time) / 1'000'000.0;
+        previous_frame_time = sleep_end;
     }
 }
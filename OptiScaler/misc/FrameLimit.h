@@ -7,6 +7,9 @@ class FrameLimit
     static int timer_sleep(int64_t hundred_ns);
     static int busywait_sleep(int64_t ns);
     static int combined_sleep(int64_t ns);
+
+    static inline double _lastSleepMs = 0.0;
 public:
     static void sleep();
+    static double LastSleepMs() { return _lastSleepMs; }
 };
\ No newline at end of file
@@ -0,0 +1,147 @@
+#include "GameProfile.h"
+
+#include "IniDiff.h"
+
+#include <Util.h>
+
+#include <fstream>
+#include <sstream>
+
+static bool ReadValues(const std::filesystem::path& InPath, IniValues* OutValues)
+{
+    std::ifstream file(InPath, std::ios::binary);
+
+    if (!file.is_open())
+        return false;
+
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+
+    return IniDiff::Parse(buffer.str(), OutValues);
+}
+
+uint64_t GameProfile::ExeHash()
+{
+    static uint64_t hash = 0;
+
+    if (hash == 0)
+    {
+        auto exePath = Util::ExePath().wstring();
+
+        hash = 14695981039346656037ull;
+
+        for (auto c : exePath)
+            hash = (hash ^ (uint64_t)towlower(c)) * 1099511628211ull;
+    }
+
+    return hash;
+}
+
+std::optional<std::filesystem::path> GameProfile::Find(const std::filesystem::path& InIniFolder)
+{
+    if (_searched)
+        return _path;
+
+    _searched = true;
+
+    auto folder = InIniFolder / L"Profiles";
+    auto exeName = Util::ExePath().filename().wstring();
+    auto hashName = std::format(L"{}.{:016X}.ini", exeName, ExeHash());
+
+    for (auto& name : { hashName, exeName + L".ini" })
+    {
+        auto path = folder / name;
+
+        if (std::filesystem::exists(path))
+        {
+            LOG_INFO("Using game profile: {0}", path.string());
+            _path = path;
+            return _path;
+        }
+    }
+
+    LOG_DEBUG("No game profile, expected {0} or {1}.ini in {2}", wstring_to_string(hashName), wstring_to_string(exeName), folder.string());
+
+    return _path;
+}
+
+bool GameProfile::Merge(const std::filesystem::path& InProfile, CSimpleIniA* InOutIni)
+{
+    CSimpleIniA profile;
+
+    if (profile.LoadFile(InProfile.c_str()) != SI_OK)
+    {
+        LOG_ERROR("Can't load game profile: {0}", InProfile.string());
+        return false;
+    }
+
+    CSimpleIniA::TNamesDepend sections;
+    profile.GetAllSections(sections);
+
+    uint32_t count = 0;
+
+    for (auto& section : sections)
+    {
+        CSimpleIniA::TNamesDepend keys;
+        profile.GetAllKeys(section.pItem, keys);
+
+        for (auto& key : keys)
+        {
+            InOutIni->SetValue(section.pItem, key.pItem, profile.GetValue(section.pItem, key.pItem, "auto"));
+            count++;
+        }
+    }
+
+    LOG_DEBUG("Merged {0} values from game profile", count);
+
+    return true;
+}
+
+bool GameProfile::Save(const std::filesystem::path& InProfile, const std::filesystem::path& InGlobalIni, const CSimpleIniA& InIni)
+{
+    std::string data;
+
+    if (InIni.Save(data) < 0)
+        return false;
+
+    IniValues current;
+    IniValues global;
+
+    if (!IniDiff::Parse(data, &current))
+        return false;
+
+    // Missing global ini means every key is auto
+    ReadValues(InGlobalIni, &global);
+
+    CSimpleIniA profile;
+    profile.LoadFile(InProfile.c_str());
+
+    // Keep keys which are already in profile up to date
+    CSimpleIniA::TNamesDepend sections;
+    profile.GetAllSections(sections);
+
+    for (auto& section : sections)
+    {
+        CSimpleIniA::TNamesDepend keys;
+        profile.GetAllKeys(section.pItem, keys);
+
+        for (auto& key : keys)
+        {
+            auto it = current.find(IniDiff::Id(section.pItem, key.pItem));
+
+            if (it != current.end())
+                profile.SetValue(section.pItem, key.pItem, it->second.Value.empty() ? "auto" : it->second.Value.c_str());
+        }
+    }
+
+    // And add the ones which differ from global ini
+    for (auto& change : IniDiff::Diff(global, current))
+        profile.SetValue(change.Section.c_str(), change.Key.c_str(), change.NewValue.empty() ? "auto" : change.NewValue.c_str());
+
+    std::error_code ec;
+    std::filesystem::create_directories(InProfile.parent_path(), ec);
+
+    LOG_INFO("Trying to save game profile to: {0}", InProfile.string());
+
+    return profile.SaveFile(InProfile.c_str()) >= 0;
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include <pch.h>
+
+#include <SimpleIni.h>
+
+#include <filesystem>
+#include <optional>
+
+// Per game overrides layered over OptiScaler.ini
+// Profiles are looked up in Profiles folder next to ini as <exe name>.<path hash>.ini first, then <exe name>.ini
+// Path hash separates games which use same exe name (e.g. game.exe)
+class GameProfile
+{
+    static inline std::optional<std::filesystem::path> _path;
+    static inline bool _searched = false;
+
+public:
+    // FNV-1a of lower case exe path
+    static uint64_t ExeHash();
+
+    // Returns profile of running exe, searched once
+    static std::optional<std::filesystem::path> Find(const std::filesystem::path& InIniFolder);
+
+    // Copies values of profile over InOutIni
+    static bool Merge(const std::filesystem::path& InProfile, CSimpleIniA* InOutIni);
+
+    // Writes values of InIni which differ from InGlobalIni or already exist in profile
+    static bool Save(const std::filesystem::path& InProfile, const std::filesystem::path& InGlobalIni, const CSimpleIniA& InIni);
+};
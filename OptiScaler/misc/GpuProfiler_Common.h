@@ -0,0 +1,96 @@
+#pragma once
+#include <pch.h>
+
+#include <deque>
+#include <mutex>
+#include <algorithm>
+
+enum class GpuPass : uint32_t
+{
+    Upscale,        // Whole feature evaluate, includes bias, output scaling and RCAS
+    Dispatch,       // Only the upscaler backend's own dispatch (FSR/XeSS/DLSS)
+    Bias,
+    OutputScaling,
+    RCAS,
+    FGCopy,         // Depth & motion vector copies for OptiFG
+    HudlessCopy,
+    FormatTransfer,
+    Menu,
+    Count
+};
+
+struct GpuPassStats
+{
+    float Last = 0.0f;
+    float Average = 0.0f;
+    float P50 = 0.0f;
+    float P95 = 0.0f;
+    float P99 = 0.0f;
+    uint32_t Samples = 0;
+};
+
+inline const char* GpuPassName(GpuPass InPass)
+{
+    static const char* passNames[] = { "Upscale", "Upscaler Dispatch", "Bias", "Output Scaling", "RCAS", "FG Depth/MV Copy", "Hudless Copy", "Format Transfer", "Menu" };
+
+    if (InPass >= GpuPass::Count)
+        return "Unknown";
+
+    return passNames[(uint32_t)InPass];
+}
+
+// Last samples of each pass, shared by api specific profilers
+class GpuPassHistory
+{
+    static const uint32_t HistorySize = 240;
+
+    std::mutex _mutex;
+    std::deque<float> _history[(uint32_t)GpuPass::Count];
+
+public:
+    void Add(GpuPass InPass, float InTimeMs)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto& history = _history[(uint32_t)InPass];
+
+        history.push_back(InTimeMs);
+
+        if (history.size() > HistorySize)
+            history.pop_front();
+    }
+
+    bool GetStats(GpuPass InPass, GpuPassStats* OutStats)
+    {
+        if (OutStats == nullptr || InPass >= GpuPass::Count)
+            return false;
+
+        std::vector<float> samples;
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto& history = _history[(uint32_t)InPass];
+
+            if (history.empty())
+                return false;
+
+            samples.assign(history.begin(), history.end());
+            OutStats->Last = history.back();
+        }
+
+        float total = 0.0f;
+        for (auto sample : samples)
+            total += sample;
+
+        std::sort(samples.begin(), samples.end());
+
+        auto percentile = [&samples](float InPercent) { return samples[(size_t)((samples.size() - 1) * InPercent)]; };
+
+        OutStats->Average = total / samples.size();
+        OutStats->P50 = percentile(0.50f);
+        OutStats->P95 = percentile(0.95f);
+        OutStats->P99 = percentile(0.99f);
+        OutStats->Samples = (uint32_t)samples.size();
+
+        return true;
+    }
+};
@@ -0,0 +1,393 @@
+#include "GpuProfiler_Dx12.h"
+
+#include <State.h>
+#include <misc/DrsGovernor.h>
+#include <misc/Trace.h>
+
+#include <d3dx/d3dx12.h>
+
+bool GpuProfiler_Dx12::Init(ID3D12Device* InDevice)
+{
+    if (InDevice == nullptr)
+        return false;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_device == InDevice && _queryHeap != nullptr)
+        return true;
+
+    if (_queryHeap != nullptr)
+    {
+        LOG_DEBUG("Device changed, recreating profiler objects");
+
+        ReleaseFrameObjects();
+        _readbackBuffer->Unmap(0, nullptr);
+        _readbackBuffer->Release();
+        _readbackBuffer = nullptr;
+        _queryHeap->Release();
+        _queryHeap = nullptr;
+    }
+
+    _device = InDevice;
+    _timestamps = nullptr;
+    _markers = nullptr;
+
+    D3D12_QUERY_HEAP_DESC queryHeapDesc = {};
+    queryHeapDesc.Count = FrameCount * PassCount * 2 + FrameCount;
+    queryHeapDesc.NodeMask = 0;
+    queryHeapDesc.Type = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
+
+    auto result = InDevice->CreateQueryHeap(&queryHeapDesc, IID_PPV_ARGS(&_queryHeap));
+    if (result != S_OK)
+    {
+        LOG_ERROR("CreateQueryHeap error: {0:X}", (UINT)result);
+        _queryHeap = nullptr;
+        return false;
+    }
+
+    // Timestamps of all slots & frame starts followed by one marker per scope, stays mapped
+    auto timestampBytes = sizeof(UINT64) * (FrameCount * PassCount * 2 + FrameCount);
+    auto bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(timestampBytes + sizeof(uint32_t) * FrameCount * PassCount);
+    auto heapProps = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_READBACK);
+
+    result = InDevice->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &bufferDesc, D3D12_RESOURCE_STATE_COPY_DEST, nullptr, IID_PPV_ARGS(&_readbackBuffer));
+    if (result != S_OK)
+    {
+        LOG_ERROR("CreateCommittedResource error: {0:X}", (UINT)result);
+        _readbackBuffer = nullptr;
+        _queryHeap->Release();
+        _queryHeap = nullptr;
+        return false;
+    }
+
+    _readbackBuffer->SetName(L"GpuProfilerReadback");
+
+    void* data = nullptr;
+    if (_readbackBuffer->Map(0, nullptr, &data) != S_OK || data == nullptr)
+    {
+        LOG_ERROR("_readbackBuffer->Map error!");
+        _readbackBuffer->Release();
+        _readbackBuffer = nullptr;
+        _queryHeap->Release();
+        _queryHeap = nullptr;
+        return false;
+    }
+
+    memset(data, 0, bufferDesc.Width);
+    _timestamps = (UINT64*)data;
+    _markers = (uint32_t*)((uint8_t*)data + timestampBytes);
+
+    for (auto& frame : _scopes)
+    {
+        for (auto& scope : frame)
+            scope = {};
+    }
+
+    for (auto& frameStart : _frameStarts)
+        frameStart = {};
+
+    LOG_INFO("GPU profiler is ready, {0} frames x {1} passes", FrameCount, PassCount);
+
+    return true;
+}
+
+void GpuProfiler_Dx12::Begin(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCmdList, GpuPass InPass)
+{
+    if (_queryHeap == nullptr || InDevice != _device || InCmdList == nullptr || InPass >= GpuPass::Count)
+        return;
+
+    // Timestamps on copy lists need optional support
+    if (InCmdList->GetType() == D3D12_COMMAND_LIST_TYPE_COPY)
+        return;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_queryHeap == nullptr)
+        return;
+
+    auto slot = Slot();
+    auto& scope = _scopes[slot][(uint32_t)InPass];
+
+    // Only first occurrence of a pass is measured in a frame
+    if (scope.State != ScopeState::Free)
+        return;
+
+    InCmdList->EndQuery(_queryHeap, D3D12_QUERY_TYPE_TIMESTAMP, QueryIndex(slot, InPass));
+    scope.State = ScopeState::Begun;
+}
+
+void GpuProfiler_Dx12::End(ID3D12GraphicsCommandList* InCmdList, GpuPass InPass)
+{
+    if (_queryHeap == nullptr || InCmdList == nullptr || InPass >= GpuPass::Count)
+        return;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_queryHeap == nullptr)
+        return;
+
+    auto slot = Slot();
+    auto& scope = _scopes[slot][(uint32_t)InPass];
+
+    if (scope.State != ScopeState::Begun)
+        return;
+
+    auto index = QueryIndex(slot, InPass);
+    InCmdList->EndQuery(_queryHeap, D3D12_QUERY_TYPE_TIMESTAMP, index + 1);
+    InCmdList->ResolveQueryData(_queryHeap, D3D12_QUERY_TYPE_TIMESTAMP, index, 2, _readbackBuffer, index * sizeof(UINT64));
+
+    // Marker is written after the resolve is completed, so CPU can poll it without waiting
+    ID3D12GraphicsCommandList2* cmdList2 = nullptr;
+    scope.UseMarker = InCmdList->QueryInterface(IID_PPV_ARGS(&cmdList2)) == S_OK && cmdList2 != nullptr;
+
+    if (scope.UseMarker)
+    {
+        auto markerIndex = slot * PassCount + (uint32_t)InPass;
+
+        D3D12_WRITEBUFFERIMMEDIATE_PARAMETER param{};
+        param.Dest = _readbackBuffer->GetGPUVirtualAddress() + ((uint8_t*)&_markers[markerIndex] - (uint8_t*)_timestamps);
+        param.Value = _serial;
+
+        D3D12_WRITEBUFFERIMMEDIATE_MODE mode = D3D12_WRITEBUFFERIMMEDIATE_MODE_MARKER_OUT;
+        cmdList2->WriteBufferImmediate(1, &param, &mode);
+        cmdList2->Release();
+    }
+
+    scope.Serial = _serial;
+    scope.State = ScopeState::Ended;
+}
+
+void GpuProfiler_Dx12::ReadResults()
+{
+    if (_frequency == 0)
+        return;
+
+    // Oldest frame first, current frame's slot is the last one
+    for (uint32_t i = 1; i <= FrameCount; i++)
+    {
+        auto slot = (_serial + i) % FrameCount;
+
+        for (uint32_t pass = 0; pass < PassCount; pass++)
+        {
+            auto& scope = _scopes[slot][pass];
+
+            if (scope.State != ScopeState::Ended || scope.Serial == _serial)
+                continue;
+
+            // Without markers results are accepted when slot is about to be reused
+            bool ready = scope.UseMarker ? _markers[slot * PassCount + pass] == scope.Serial : (_serial - scope.Serial) >= FrameCount - 1;
+
+            if (!ready)
+                continue;
+
+            auto index = QueryIndex(slot, (GpuPass)pass);
+            auto startTime = _timestamps[index];
+            auto endTime = _timestamps[index + 1];
+
+            scope.State = ScopeState::Free;
+
+            if (endTime < startTime)
+                continue;
+
+            double elapsedTimeMs = (endTime - startTime) / static_cast<double>(_frequency) * 1000.0;
+
+            // filter out possibly wrong measured high values
+            if (elapsedTimeMs >= 100.0)
+                continue;
+
+            if (Trace::IsCapturing() && _calibrationGeneration == Trace::Generation())
+            {
+                auto toCpu = [](UINT64 InGpuTime) { return (int64_t)_cpuCalibration + (int64_t)(((double)InGpuTime - (double)_gpuCalibration) * Trace::Frequency() / _frequency); };
+                Trace::AddEvent(GpuPassName((GpuPass)pass), Trace::Track::Gpu, toCpu(startTime), toCpu(endTime));
+            }
+
+            _history.Add((GpuPass)pass, (float)elapsedTimeMs);
+
+            if (pass == (uint32_t)GpuPass::Upscale)
+            {
+                State::Instance().AddUpscaleTime(elapsedTimeMs);
+
+                // Frame start was submitted before this frame's commands, it's only missing if it couldn't be submitted
+                auto& frameStart = _frameStarts[slot];
+
+                if (frameStart.Serial == scope.Serial && _frameFence != nullptr && _frameFence->GetCompletedValue() >= frameStart.FenceValue)
+                {
+                    auto frameStartTime = _timestamps[FrameStartIndex(slot)];
+
+                    if (endTime > frameStartTime)
+                        DrsGovernor::AddGpuFrameTime((endTime - frameStartTime) / static_cast<double>(_frequency) * 1000.0);
+                }
+            }
+        }
+    }
+}
+
+void GpuProfiler_Dx12::EndFrame(ID3D12CommandQueue* InQueue)
+{
+    if (InQueue == nullptr)
+        return;
+
+    // Profiler might not be inited when only overlay menu is used
+    if (_queryHeap == nullptr && !State::Instance().isWorkingAsNvngx)
+    {
+        ID3D12Device* device = nullptr;
+
+        if (InQueue->GetDevice(IID_PPV_ARGS(&device)) == S_OK && device != nullptr)
+        {
+            Init(device);
+            device->Release();
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_queryHeap == nullptr)
+        return;
+
+    if (_frequency == 0 && InQueue->GetTimestampFrequency(&_frequency) != S_OK)
+        _frequency = 0;
+
+    if (Trace::IsCapturing() && _calibrationGeneration != Trace::Generation())
+    {
+        if (InQueue->GetClockCalibration(&_gpuCalibration, &_cpuCalibration) == S_OK)
+            _calibrationGeneration = Trace::Generation();
+    }
+
+    ReadResults();
+
+    _serial++;
+
+    // Zero is the initial value of markers
+    if (_serial == 0)
+        _serial++;
+
+    // GPU is more than FrameCount frames behind or scope was never ended, drop old results
+    for (auto& scope : _scopes[Slot()])
+    {
+        if (scope.State != ScopeState::Free)
+        {
+            if (scope.State == ScopeState::Ended)
+                _droppedScopes++;
+
+            scope.State = ScopeState::Free;
+        }
+    }
+}
+
+bool GpuProfiler_Dx12::CreateFrameObjects(D3D12_COMMAND_LIST_TYPE InType)
+{
+    if (_frameCmdList != nullptr && _frameListType == InType)
+        return true;
+
+    ReleaseFrameObjects();
+    _frameListType = InType;
+
+    for (auto& allocator : _frameAllocators)
+    {
+        auto result = _device->CreateCommandAllocator(InType, IID_PPV_ARGS(&allocator));
+        if (result != S_OK)
+        {
+            LOG_ERROR("CreateCommandAllocator error: {0:X}", (UINT)result);
+            allocator = nullptr;
+            ReleaseFrameObjects();
+            return false;
+        }
+    }
+
+    auto result = _device->CreateCommandList(0, InType, _frameAllocators[0], nullptr, IID_PPV_ARGS(&_frameCmdList));
+    if (result != S_OK)
+    {
+        LOG_ERROR("CreateCommandList error: {0:X}", (UINT)result);
+        _frameCmdList = nullptr;
+        ReleaseFrameObjects();
+        return false;
+    }
+
+    _frameCmdList->SetName(L"GpuProfilerFrameStart");
+    _frameCmdList->Close();
+
+    result = _device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&_frameFence));
+    if (result != S_OK)
+    {
+        LOG_ERROR("CreateFence error: {0:X}", (UINT)result);
+        _frameFence = nullptr;
+        ReleaseFrameObjects();
+        return false;
+    }
+
+    return true;
+}
+
+void GpuProfiler_Dx12::ReleaseFrameObjects()
+{
+    if (_frameCmdList != nullptr)
+    {
+        _frameCmdList->Release();
+        _frameCmdList = nullptr;
+    }
+
+    for (auto& allocator : _frameAllocators)
+    {
+        if (allocator != nullptr)
+        {
+            allocator->Release();
+            allocator = nullptr;
+        }
+    }
+
+    if (_frameFence != nullptr)
+    {
+        _frameFence->Release();
+        _frameFence = nullptr;
+    }
+
+    _frameFenceValue = 0;
+
+    for (auto& frameStart : _frameStarts)
+        frameStart = {};
+}
+
+void GpuProfiler_Dx12::StartFrame(ID3D12CommandQueue* InQueue)
+{
+    if (InQueue == nullptr)
+        return;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_queryHeap == nullptr)
+        return;
+
+    auto type = InQueue->GetDesc().Type;
+
+    // Timestamps on copy queues need optional support
+    if (type == D3D12_COMMAND_LIST_TYPE_COPY || !CreateFrameObjects(type))
+        return;
+
+    auto slot = Slot();
+    auto& frameStart = _frameStarts[slot];
+
+    // GPU is still using allocator of this slot, frame won't give a DRS sample
+    if (_frameFence->GetCompletedValue() < frameStart.FenceValue)
+    {
+        frameStart.Serial = 0;
+        return;
+    }
+
+    if (_frameAllocators[slot]->Reset() != S_OK || _frameCmdList->Reset(_frameAllocators[slot], nullptr) != S_OK)
+    {
+        frameStart.Serial = 0;
+        return;
+    }
+
+    auto index = FrameStartIndex(slot);
+    _frameCmdList->EndQuery(_queryHeap, D3D12_QUERY_TYPE_TIMESTAMP, index);
+    _frameCmdList->ResolveQueryData(_queryHeap, D3D12_QUERY_TYPE_TIMESTAMP, index, 1, _readbackBuffer, index * sizeof(UINT64));
+    _frameCmdList->Close();
+
+    ID3D12CommandList* cmdLists[] = { _frameCmdList };
+    InQueue->ExecuteCommandLists(1, cmdLists);
+    InQueue->Signal(_frameFence, ++_frameFenceValue);
+
+    frameStart.Serial = _serial;
+    frameStart.FenceValue = _frameFenceValue;
+}
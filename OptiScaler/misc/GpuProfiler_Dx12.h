@@ -0,0 +1,91 @@
+#pragma once
+#include <pch.h>
+
+#include "GpuProfiler_Common.h"
+
+#include <d3d12.h>
+#include <mutex>
+
+// Per pass GPU timestamp profiler
+// Every frame has its own slot in query heap & readback buffer, slots are read back
+// a few frames later when their markers are written by GPU so present never waits for GPU
+class GpuProfiler_Dx12
+{
+    static const uint32_t FrameCount = 4;
+    static const uint32_t PassCount = (uint32_t)GpuPass::Count;
+
+    enum class ScopeState : uint32_t
+    {
+        Free,
+        Begun,
+        Ended
+    };
+
+    struct Scope
+    {
+        ScopeState State = ScopeState::Free;
+        uint32_t Serial = 0;
+        bool UseMarker = false;
+    };
+
+    static inline std::mutex _mutex;
+
+    static inline ID3D12Device* _device = nullptr;
+    static inline ID3D12QueryHeap* _queryHeap = nullptr;
+    static inline ID3D12Resource* _readbackBuffer = nullptr;
+    static inline UINT64* _timestamps = nullptr;
+    static inline uint32_t* _markers = nullptr;
+    static inline UINT64 _frequency = 0;
+
+    static inline Scope _scopes[FrameCount][PassCount]{};
+    static inline uint32_t _serial = 1;
+    static inline uint32_t _droppedScopes = 0;
+
+    static inline GpuPassHistory _history;
+
+    // Timestamp submitted to present queue after present returns, GPU passes it when previous frame is done
+    // or when it's submitted if GPU is idle. From there to end of upscale pass is GPU busy time of DRS governor
+    struct FrameStart
+    {
+        uint32_t Serial = 0;
+        UINT64 FenceValue = 0;
+    };
+
+    static inline ID3D12CommandAllocator* _frameAllocators[FrameCount]{};
+    static inline ID3D12GraphicsCommandList* _frameCmdList = nullptr;
+    static inline ID3D12Fence* _frameFence = nullptr;
+    static inline UINT64 _frameFenceValue = 0;
+    static inline D3D12_COMMAND_LIST_TYPE _frameListType = D3D12_COMMAND_LIST_TYPE_DIRECT;
+    static inline FrameStart _frameStarts[FrameCount]{};
+
+    // GPU to CPU clock mapping for trace captures
+    static inline UINT64 _gpuCalibration = 0;
+    static inline UINT64 _cpuCalibration = 0;
+    static inline uint32_t _calibrationGeneration = 0;
+
+    static uint32_t Slot() { return _serial % FrameCount; }
+    static UINT QueryIndex(uint32_t InSlot, GpuPass InPass) { return (InSlot * PassCount + (uint32_t)InPass) * 2; }
+    static UINT FrameStartIndex(uint32_t InSlot) { return FrameCount * PassCount * 2 + InSlot; }
+    static void ReadResults();
+    static bool CreateFrameObjects(D3D12_COMMAND_LIST_TYPE InType);
+    static void ReleaseFrameObjects();
+
+public:
+    static bool Init(ID3D12Device* InDevice);
+    static bool IsInited() { return _queryHeap != nullptr; }
+
+    // Records start timestamp, scope is ignored if InDevice is not profiler's device or pass is already recorded this frame
+    static void Begin(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCmdList, GpuPass InPass);
+
+    // Records end timestamp and resolves the pair to readback buffer
+    static void End(ID3D12GraphicsCommandList* InCmdList, GpuPass InPass);
+
+    // Called once per present, collects completed frames and moves to next slot
+    static void EndFrame(ID3D12CommandQueue* InQueue);
+
+    // Called after present returned, writes start timestamp of next frame on InQueue
+    static void StartFrame(ID3D12CommandQueue* InQueue);
+
+    static bool GetStats(GpuPass InPass, GpuPassStats* OutStats) { return _history.GetStats(InPass, OutStats); }
+    static uint32_t DroppedScopes() { return _droppedScopes; }
+};
@@ -0,0 +1,356 @@
+#include "GpuProfiler_Vk.h"
+
+#include <State.h>
+#include <misc/DrsGovernor.h>
+
+void GpuProfiler_Vk::DestroyPools()
+{
+    for (auto& pool : _queryPools)
+    {
+        if (pool != VK_NULL_HANDLE)
+        {
+            vkDestroyQueryPool(_device, pool, nullptr);
+            pool = VK_NULL_HANDLE;
+        }
+    }
+
+    // Pending frame starts are waited, this only happens when device changes
+    for (uint32_t i = 0; i < FrameCount; i++)
+    {
+        if (_frameFences[i] != VK_NULL_HANDLE)
+        {
+            if (_frameStarts[i].Submitted)
+                vkWaitForFences(_device, 1, &_frameFences[i], VK_TRUE, UINT64_MAX);
+
+            vkDestroyFence(_device, _frameFences[i], nullptr);
+            _frameFences[i] = VK_NULL_HANDLE;
+        }
+
+        _frameCmdBuffers[i] = VK_NULL_HANDLE;
+        _frameStarts[i] = {};
+    }
+
+    if (_frameCommandPool != VK_NULL_HANDLE)
+    {
+        vkDestroyCommandPool(_device, _frameCommandPool, nullptr);
+        _frameCommandPool = VK_NULL_HANDLE;
+    }
+
+    if (_frameQueryPool != VK_NULL_HANDLE)
+    {
+        vkDestroyQueryPool(_device, _frameQueryPool, nullptr);
+        _frameQueryPool = VK_NULL_HANDLE;
+    }
+}
+
+bool GpuProfiler_Vk::CreateFrameObjects(VkPhysicalDevice InPD)
+{
+    uint32_t count = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(InPD, &count, nullptr);
+
+    std::vector<VkQueueFamilyProperties> families(count);
+    vkGetPhysicalDeviceQueueFamilyProperties(InPD, &count, families.data());
+
+    auto family = std::find_if(families.begin(), families.end(), [](const VkQueueFamilyProperties& InFamily) { return (InFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) != 0; });
+
+    if (family == families.end())
+        return false;
+
+    VkCommandPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    poolInfo.queueFamilyIndex = (uint32_t)(family - families.begin());
+
+    if (vkCreateCommandPool(_device, &poolInfo, nullptr, &_frameCommandPool) != VK_SUCCESS)
+    {
+        _frameCommandPool = VK_NULL_HANDLE;
+        return false;
+    }
+
+    VkCommandBufferAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocInfo.commandPool = _frameCommandPool;
+    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocInfo.commandBufferCount = FrameCount;
+
+    if (vkAllocateCommandBuffers(_device, &allocInfo, _frameCmdBuffers) != VK_SUCCESS)
+        return false;
+
+    VkFenceCreateInfo fenceInfo{};
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+    for (auto& fence : _frameFences)
+    {
+        if (vkCreateFence(_device, &fenceInfo, nullptr, &fence) != VK_SUCCESS)
+        {
+            fence = VK_NULL_HANDLE;
+            return false;
+        }
+    }
+
+    VkQueryPoolCreateInfo queryPoolInfo = {};
+    queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    queryPoolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    queryPoolInfo.queryCount = FrameCount;
+
+    if (vkCreateQueryPool(_device, &queryPoolInfo, nullptr, &_frameQueryPool) != VK_SUCCESS)
+    {
+        _frameQueryPool = VK_NULL_HANDLE;
+        return false;
+    }
+
+    return true;
+}
+
+bool GpuProfiler_Vk::Init(VkDevice InDevice, VkPhysicalDevice InPD)
+{
+    if (InDevice == VK_NULL_HANDLE || InPD == VK_NULL_HANDLE)
+        return false;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_device == InDevice)
+        return true;
+
+    if (_device != VK_NULL_HANDLE)
+    {
+        LOG_DEBUG("Device changed, recreating query pools");
+        DestroyPools();
+    }
+
+    _device = InDevice;
+
+    VkPhysicalDeviceProperties deviceProperties;
+    vkGetPhysicalDeviceProperties(InPD, &deviceProperties);
+    _timestampPeriod = deviceProperties.limits.timestampPeriod;
+
+    VkQueryPoolCreateInfo queryPoolInfo = {};
+    queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    queryPoolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    queryPoolInfo.queryCount = PassCount * 2;
+
+    for (auto& pool : _queryPools)
+    {
+        auto result = vkCreateQueryPool(InDevice, &queryPoolInfo, nullptr, &pool);
+
+        if (result != VK_SUCCESS)
+        {
+            LOG_ERROR("vkCreateQueryPool error: {0:X}", (UINT)result);
+            pool = VK_NULL_HANDLE;
+            DestroyPools();
+            _device = VK_NULL_HANDLE;
+            return false;
+        }
+    }
+
+    for (auto& frame : _scopes)
+    {
+        for (auto& scope : frame)
+            scope = {};
+    }
+
+    // Frame starts tell when results are ready, profiler can't work without them
+    if (!CreateFrameObjects(InPD))
+    {
+        LOG_ERROR("Can't create frame start objects");
+        DestroyPools();
+        _device = VK_NULL_HANDLE;
+        return false;
+    }
+
+    LOG_INFO("GPU profiler is ready, {0} frames x {1} passes", FrameCount, PassCount);
+
+    return true;
+}
+
+void GpuProfiler_Vk::Begin(VkDevice InDevice, VkCommandBuffer InCmdBuffer, GpuPass InPass)
+{
+    if (_device == VK_NULL_HANDLE || InDevice != _device || InCmdBuffer == VK_NULL_HANDLE || InPass >= GpuPass::Count)
+        return;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_device == VK_NULL_HANDLE)
+        return;
+
+    auto slot = Slot();
+    auto& scope = _scopes[slot][(uint32_t)InPass];
+
+    // Only first occurrence of a pass is measured in a frame
+    if (scope.State != ScopeState::Free)
+        return;
+
+    auto index = (uint32_t)InPass * 2;
+
+    // Queries must be reset before every use, per scope reset keeps other passes of the pool intact
+    vkCmdResetQueryPool(InCmdBuffer, _queryPools[slot], index, 2);
+    vkCmdWriteTimestamp(InCmdBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, _queryPools[slot], index);
+
+    scope.State = ScopeState::Begun;
+}
+
+void GpuProfiler_Vk::End(VkCommandBuffer InCmdBuffer, GpuPass InPass)
+{
+    if (_device == VK_NULL_HANDLE || InCmdBuffer == VK_NULL_HANDLE || InPass >= GpuPass::Count)
+        return;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_device == VK_NULL_HANDLE)
+        return;
+
+    auto slot = Slot();
+    auto& scope = _scopes[slot][(uint32_t)InPass];
+
+    if (scope.State != ScopeState::Begun)
+        return;
+
+    vkCmdWriteTimestamp(InCmdBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, _queryPools[slot], (uint32_t)InPass * 2 + 1);
+
+    scope.Serial = _serial;
+    scope.State = ScopeState::Ended;
+}
+
+bool GpuProfiler_Vk::FrameCompleted(uint32_t InSerial)
+{
+    // Frame start of next frame is submitted after this frame's present, fence signal covers every earlier
+    // submission of present queue. Passes recorded for another queue are assumed to finish before present
+    auto next = InSerial + 1;
+    auto& frameStart = _frameStarts[next % FrameCount];
+
+    return frameStart.Submitted && frameStart.Serial == next && vkGetFenceStatus(_device, _frameFences[next % FrameCount]) == VK_SUCCESS;
+}
+
+void GpuProfiler_Vk::ReadResults()
+{
+    // Oldest frame first, current frame's pool is the last one
+    for (uint32_t i = 1; i <= FrameCount; i++)
+    {
+        auto slot = (_serial + i) % FrameCount;
+
+        for (uint32_t pass = 0; pass < PassCount; pass++)
+        {
+            auto& scope = _scopes[slot][pass];
+
+            if (scope.State != ScopeState::Ended || scope.Serial == _serial || !FrameCompleted(scope.Serial))
+                continue;
+
+            // Value & availability pairs, never waits for GPU
+            uint64_t data[4]{};
+            auto result = vkGetQueryPoolResults(_device, _queryPools[slot], pass * 2, 2, sizeof(data), data, sizeof(uint64_t) * 2,
+                                                VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+
+            if ((result != VK_SUCCESS && result != VK_NOT_READY) || data[1] == 0 || data[3] == 0)
+                continue;
+
+            scope.State = ScopeState::Free;
+
+            if (data[2] < data[0])
+                continue;
+
+            double elapsedTimeMs = (data[2] - data[0]) * _timestampPeriod / 1e6;
+
+            // filter out possibly wrong measured high values
+            if (elapsedTimeMs >= 100.0)
+                continue;
+
+            _history.Add((GpuPass)pass, (float)elapsedTimeMs);
+
+            if (pass == (uint32_t)GpuPass::Upscale)
+            {
+                State::Instance().AddUpscaleTime(elapsedTimeMs);
+
+                // Fence of frame start makes sure its query was reset & written for this frame
+                auto& frameStart = _frameStarts[slot];
+
+                if (frameStart.Serial == scope.Serial && frameStart.Submitted && vkGetFenceStatus(_device, _frameFences[slot]) == VK_SUCCESS)
+                {
+                    uint64_t frameStartTime = 0;
+
+                    if (vkGetQueryPoolResults(_device, _frameQueryPool, slot, 1, sizeof(frameStartTime), &frameStartTime, sizeof(uint64_t),
+                                              VK_QUERY_RESULT_64_BIT) == VK_SUCCESS && data[2] > frameStartTime)
+                    {
+                        DrsGovernor::AddGpuFrameTime((data[2] - frameStartTime) * _timestampPeriod / 1e6);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void GpuProfiler_Vk::EndFrame()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_device == VK_NULL_HANDLE)
+        return;
+
+    ReadResults();
+
+    _serial++;
+
+    // GPU is more than FrameCount frames behind or scope was never ended, drop old results
+    for (auto& scope : _scopes[Slot()])
+    {
+        if (scope.State != ScopeState::Free)
+        {
+            if (scope.State == ScopeState::Ended)
+                _droppedScopes++;
+
+            scope.State = ScopeState::Free;
+        }
+    }
+}
+
+void GpuProfiler_Vk::StartFrame(VkQueue InQueue)
+{
+    if (InQueue == VK_NULL_HANDLE)
+        return;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_device == VK_NULL_HANDLE || _frameQueryPool == VK_NULL_HANDLE)
+        return;
+
+    auto slot = Slot();
+    auto& frameStart = _frameStarts[slot];
+
+    // GPU is still using command buffer of this slot, frame won't give a DRS sample
+    if (frameStart.Submitted && vkGetFenceStatus(_device, _frameFences[slot]) != VK_SUCCESS)
+    {
+        frameStart.Serial = 0;
+        return;
+    }
+
+    frameStart.Serial = 0;
+    frameStart.Submitted = false;
+
+    auto cmdBuffer = _frameCmdBuffers[slot];
+
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    if (vkResetFences(_device, 1, &_frameFences[slot]) != VK_SUCCESS || vkResetCommandBuffer(cmdBuffer, 0) != VK_SUCCESS ||
+        vkBeginCommandBuffer(cmdBuffer, &beginInfo) != VK_SUCCESS)
+    {
+        return;
+    }
+
+    vkCmdResetQueryPool(cmdBuffer, _frameQueryPool, slot, 1);
+    vkCmdWriteTimestamp(cmdBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, _frameQueryPool, slot);
+
+    if (vkEndCommandBuffer(cmdBuffer) != VK_SUCCESS)
+        return;
+
+    VkSubmitInfo submitInfo{};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &cmdBuffer;
+
+    if (vkQueueSubmit(InQueue, 1, &submitInfo, _frameFences[slot]) != VK_SUCCESS)
+        return;
+
+    frameStart.Serial = _serial;
+    frameStart.Submitted = true;
+}
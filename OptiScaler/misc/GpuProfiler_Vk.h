@@ -0,0 +1,84 @@
+#pragma once
+#include <pch.h>
+
+#include "GpuProfiler_Common.h"
+
+#include <vulkan/vulkan.hpp>
+#include <mutex>
+
+// Per pass GPU timestamp profiler for Vulkan
+// Every frame has its own query pool, pools are read back a few frames later so present never waits for GPU
+// Queries are reset inside recorded command buffers, so availability bits alone can still show values of previous use.
+// A frame's results are only read after fence of next frame's start (submitted after the frame's present) is signaled
+class GpuProfiler_Vk
+{
+    static const uint32_t FrameCount = 4;
+    static const uint32_t PassCount = (uint32_t)GpuPass::Count;
+
+    enum class ScopeState : uint32_t
+    {
+        Free,
+        Begun,
+        Ended
+    };
+
+    struct Scope
+    {
+        ScopeState State = ScopeState::Free;
+        uint32_t Serial = 0;
+    };
+
+    static inline std::mutex _mutex;
+
+    static inline VkDevice _device = VK_NULL_HANDLE;
+    static inline VkQueryPool _queryPools[FrameCount]{};
+    static inline double _timestampPeriod = 1.0;
+
+    static inline Scope _scopes[FrameCount][PassCount]{};
+    static inline uint32_t _serial = 1;
+    static inline uint32_t _droppedScopes = 0;
+
+    static inline GpuPassHistory _history;
+
+    // Timestamp submitted to present queue after present returns, GPU passes it when previous frame is done
+    // or when it's submitted if GPU is idle. From there to end of upscale pass is GPU busy time of DRS governor
+    // Its fence also marks previous frame as completed on present queue
+    // Pool uses first graphics queue family, same as overlay menu which also submits to present queue
+    struct FrameStart
+    {
+        uint32_t Serial = 0;
+        bool Submitted = false;
+    };
+
+    static inline VkQueryPool _frameQueryPool = VK_NULL_HANDLE;
+    static inline VkCommandPool _frameCommandPool = VK_NULL_HANDLE;
+    static inline VkCommandBuffer _frameCmdBuffers[FrameCount]{};
+    static inline VkFence _frameFences[FrameCount]{};
+    static inline FrameStart _frameStarts[FrameCount]{};
+
+    static uint32_t Slot() { return _serial % FrameCount; }
+    static bool FrameCompleted(uint32_t InSerial);
+    static void ReadResults();
+    static void DestroyPools();
+    static bool CreateFrameObjects(VkPhysicalDevice InPD);
+
+public:
+    static bool Init(VkDevice InDevice, VkPhysicalDevice InPD);
+    static bool IsInited() { return _device != VK_NULL_HANDLE; }
+
+    // Resets and writes start timestamp, must be called outside of a render pass
+    // Scope is ignored if InDevice is not profiler's device or pass is already recorded this frame
+    static void Begin(VkDevice InDevice, VkCommandBuffer InCmdBuffer, GpuPass InPass);
+
+    // Writes end timestamp
+    static void End(VkCommandBuffer InCmdBuffer, GpuPass InPass);
+
+    // Called once per present, collects available results and moves to next pool
+    static void EndFrame();
+
+    // Called after present returned, writes start timestamp of next frame on InQueue
+    static void StartFrame(VkQueue InQueue);
+
+    static bool GetStats(GpuPass InPass, GpuPassStats* OutStats) { return _history.GetStats(InPass, OutStats); }
+    static uint32_t DroppedScopes() { return _droppedScopes; }
+};
@@ -0,0 +1,200 @@
+#pragma once
+
+// Header only & free of Windows headers, so parsing & diffing can be built and checked on Linux too (tools/IniDiffTest.cpp)
+#include <SimpleIni.h>
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <map>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// What is needed for a changed ini key to take effect
+enum class IniChangeKind : uint8_t
+{
+    Immediate,          // Read every frame or every call
+    RecreateFeature,    // Used while creating upscaler, current feature is recreated
+    Restart             // Used only at startup or not known to be live
+};
+
+inline const char* IniChangeKindName(IniChangeKind InKind)
+{
+    switch (InKind)
+    {
+        case IniChangeKind::Immediate:
+            return "immediate";
+
+        case IniChangeKind::RecreateFeature:
+            return "recreate feature";
+
+        default:
+            return "restart";
+    }
+}
+
+struct IniChange
+{
+    std::string Section;
+    std::string Key;
+    std::string OldValue;   // Empty when key was added
+    std::string NewValue;   // Empty when key was removed
+    IniChangeKind Kind = IniChangeKind::Restart;
+};
+
+struct IniValue
+{
+    std::string Section;
+    std::string Key;
+    std::string Value;
+};
+
+// Keyed by lower case "section/key", ini keys are case insensitive
+using IniValues = std::map<std::string, IniValue>;
+
+class IniDiff
+{
+    static std::string Lower(std::string InText)
+    {
+        std::transform(InText.begin(), InText.end(), InText.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+        return InText;
+    }
+
+    static bool EqualsNoCase(const char* InA, const char* InB)
+    {
+        for (; *InA != 0 && *InB != 0; InA++, InB++)
+        {
+            if (std::tolower((unsigned char)*InA) != std::tolower((unsigned char)*InB))
+                return false;
+        }
+
+        return *InA == *InB;
+    }
+
+public:
+    // Parses bool & number values of Config without stream overhead, "auto" or invalid values return nullopt
+    template <typename T>
+    static std::optional<T> ParseValue(const char* InValue)
+    {
+        if (InValue == nullptr || InValue[0] == '\0')
+            return std::nullopt;
+
+        if constexpr (std::is_same_v<T, bool>)
+        {
+            if (EqualsNoCase(InValue, "true"))
+                return true;
+
+            if (EqualsNoCase(InValue, "false"))
+                return false;
+
+            return std::nullopt;
+        }
+        else
+        {
+            auto begin = InValue;
+            auto end = InValue + strlen(InValue);
+
+            // istringstream accepted explicit plus sign
+            if (*begin == '+')
+                begin++;
+
+            T result{};
+            auto [ptr, ec] = std::from_chars(begin, end, result);
+
+            if (ec != std::errc() || ptr != end)
+                return std::nullopt;
+
+            return result;
+        }
+    }
+
+    // Key of a value in IniValues
+    static std::string Id(const std::string& InSection, const std::string& InKey) { return Lower(InSection + "/" + InKey); }
+
+    // "auto" is same as a missing key for Config, both are stored as empty
+    static bool Parse(const std::string& InText, IniValues* OutValues)
+    {
+        if (OutValues == nullptr)
+            return false;
+
+        CSimpleIniA ini;
+
+        if (ini.LoadData(InText) < 0)
+            return false;
+
+        OutValues->clear();
+
+        CSimpleIniA::TNamesDepend sections;
+        ini.GetAllSections(sections);
+
+        for (auto& section : sections)
+        {
+            CSimpleIniA::TNamesDepend keys;
+            ini.GetAllKeys(section.pItem, keys);
+
+            for (auto& key : keys)
+            {
+                auto value = ini.GetValue(section.pItem, key.pItem, "");
+
+                if (value == nullptr || Lower(value) == "auto")
+                    value = "";
+
+                (*OutValues)[Id(section.pItem, key.pItem)] = { section.pItem, key.pItem, value };
+            }
+        }
+
+        return true;
+    }
+
+    // Values of InOverlay replace or add to InOutValues, same as game profile over global ini
+    static void Overlay(const IniValues& InOverlay, IniValues* InOutValues)
+    {
+        if (InOutValues == nullptr)
+            return;
+
+        for (auto& [id, value] : InOverlay)
+            (*InOutValues)[id] = value;
+    }
+
+    // InClassify tags each change, changes are Restart without it
+    static std::vector<IniChange> Diff(const IniValues& InOld, const IniValues& InNew, IniChangeKind (*InClassify)(const std::string&, const std::string&) = nullptr)
+    {
+        std::vector<IniChange> changes;
+
+        auto add = [&changes, InClassify](const IniValue& InValue, const std::string& InOldValue, const std::string& InNewValue)
+        {
+            IniChange change{ InValue.Section, InValue.Key, InOldValue, InNewValue };
+
+            if (InClassify != nullptr)
+                change.Kind = InClassify(InValue.Section, InValue.Key);
+
+            changes.push_back(change);
+        };
+
+        for (auto& [id, newValue] : InNew)
+        {
+            auto old = InOld.find(id);
+
+            if (old == InOld.end())
+            {
+                if (!newValue.Value.empty())
+                    add(newValue, "", newValue.Value);
+            }
+            else if (old->second.Value != newValue.Value)
+            {
+                add(newValue, old->second.Value, newValue.Value);
+            }
+        }
+
+        for (auto& [id, oldValue] : InOld)
+        {
+            if (!oldValue.Value.empty() && !InNew.contains(id))
+                add(oldValue, oldValue.Value, "");
+        }
+
+        return changes;
+    }
+};
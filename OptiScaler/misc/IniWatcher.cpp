@@ -0,0 +1,233 @@
+#include "IniWatcher.h"
+
+#include "Config.h"
+
+#include <fstream>
+#include <sstream>
+
+// Editors write files in a few steps, wait a bit before reading
+constexpr DWORD DebounceMs = 100;
+constexpr uint32_t ReadRetries = 5;
+
+IniWatcher::FileStamp IniWatcher::Stamp(const std::filesystem::path& InPath)
+{
+    FileStamp stamp{};
+    std::error_code ec;
+
+    stamp.LastWrite = std::filesystem::last_write_time(InPath, ec);
+    stamp.Exists = !ec;
+
+    if (stamp.Exists)
+        stamp.Size = std::filesystem::file_size(InPath, ec);
+
+    return stamp;
+}
+
+bool IniWatcher::ReadFile(const std::filesystem::path& InPath, IniValues* OutValues)
+{
+    for (uint32_t i = 0; i < ReadRetries; i++)
+    {
+        std::ifstream file(InPath, std::ios::binary);
+
+        if (file.is_open())
+        {
+            std::stringstream buffer;
+            buffer << file.rdbuf();
+
+            if (IniDiff::Parse(buffer.str(), OutValues))
+                return true;
+        }
+
+        // File might be locked by editor
+        Sleep(DebounceMs);
+    }
+
+    return false;
+}
+
+bool IniWatcher::ReadValues(IniValues* OutValues)
+{
+    if (!ReadFile(_path, OutValues))
+        return false;
+
+    if (_profilePath.empty())
+        return true;
+
+    // Deleted profile leaves only ini values
+    IniValues profile;
+
+    if (std::filesystem::exists(_profilePath) && ReadFile(_profilePath, &profile))
+        IniDiff::Overlay(profile, OutValues);
+
+    return true;
+}
+
+void IniWatcher::CheckForChanges()
+{
+    // Folder notifications also come for other files & attribute only changes
+    auto iniStamp = Stamp(_path);
+    auto profileStamp = _profilePath.empty() ? FileStamp{} : Stamp(_profilePath);
+
+    {
+        std::scoped_lock lock(_mutex);
+
+        if (iniStamp == _iniStamp && profileStamp == _profileStamp)
+            return;
+
+        _iniStamp = iniStamp;
+        _profileStamp = profileStamp;
+    }
+
+    IniValues values;
+
+    if (!ReadValues(&values))
+    {
+        LOG_WARN("Can't read {0}", _path.string());
+        return;
+    }
+
+    std::scoped_lock lock(_mutex);
+
+    auto changes = IniDiff::Diff(_values, values, Config::IniChangeKindOf);
+    _values = std::move(values);
+
+    if (changes.empty())
+        return;
+
+    for (auto& change : changes)
+    {
+        auto existing = std::find_if(_pending.begin(), _pending.end(), [&change](const IniChange& c)
+                                     { return lstrcmpiA(c.Section.c_str(), change.Section.c_str()) == 0 && lstrcmpiA(c.Key.c_str(), change.Key.c_str()) == 0; });
+
+        if (existing == _pending.end())
+        {
+            _pending.push_back(change);
+        }
+        else
+        {
+            existing->NewValue = change.NewValue;
+        }
+    }
+
+    LOG_DEBUG("{0} ini change(s) pending", _pending.size());
+    _hasPending = true;
+}
+
+void IniWatcher::WatcherThread()
+{
+    std::vector<std::filesystem::path> folders = { _path.parent_path() };
+
+    if (!_profilePath.empty())
+        folders.push_back(_profilePath.parent_path());
+
+    std::vector<HANDLE> handles = { _stopEvent };
+
+    for (auto& folder : folders)
+    {
+        auto notification = FindFirstChangeNotificationW(folder.wstring().c_str(), FALSE, FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME);
+
+        if (notification == INVALID_HANDLE_VALUE)
+        {
+            LOG_ERROR("FindFirstChangeNotificationW error for {0}: {1:X}", folder.string(), GetLastError());
+            continue;
+        }
+
+        handles.push_back(notification);
+    }
+
+    while (handles.size() > 1)
+    {
+        auto result = WaitForMultipleObjects((DWORD)handles.size(), handles.data(), FALSE, INFINITE);
+
+        if (result <= WAIT_OBJECT_0 || result >= WAIT_OBJECT_0 + handles.size())
+            break;
+
+        // Collapse notifications of a single save
+        Sleep(DebounceMs);
+
+        if (!FindNextChangeNotification(handles[result - WAIT_OBJECT_0]))
+        {
+            LOG_ERROR("FindNextChangeNotification error: {0:X}", GetLastError());
+            break;
+        }
+
+        CheckForChanges();
+    }
+
+    for (size_t i = 1; i < handles.size(); i++)
+        FindCloseChangeNotification(handles[i]);
+}
+
+void IniWatcher::Start(const std::filesystem::path& InPath, const std::filesystem::path& InProfilePath)
+{
+    if (_thread.joinable())
+        return;
+
+    _path = InPath;
+    _profilePath = InProfilePath;
+    _iniStamp = Stamp(_path);
+    _profileStamp = _profilePath.empty() ? FileStamp{} : Stamp(_profilePath);
+
+    if (!ReadValues(&_values))
+    {
+        LOG_ERROR("Can't read {0}, not watching", _path.string());
+        return;
+    }
+
+    _stopEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+
+    if (_stopEvent == nullptr)
+        return;
+
+    _thread = std::thread(WatcherThread);
+
+    if (_profilePath.empty())
+        LOG_INFO("Watching {0}", _path.string());
+    else
+        LOG_INFO("Watching {0} & {1}", _path.string(), _profilePath.string());
+}
+
+void IniWatcher::Stop()
+{
+    if (!_thread.joinable())
+        return;
+
+    SetEvent(_stopEvent);
+
+    // Called from DllMain, joining there would wait for loader lock
+    _thread.detach();
+}
+
+void IniWatcher::Rebase()
+{
+    if (!_thread.joinable())
+        return;
+
+    IniValues values;
+
+    if (!ReadValues(&values))
+        return;
+
+    std::scoped_lock lock(_mutex);
+    _iniStamp = Stamp(_path);
+    _profileStamp = _profilePath.empty() ? FileStamp{} : Stamp(_profilePath);
+    _values = std::move(values);
+    _pending.clear();
+    _hasPending = false;
+}
+
+void IniWatcher::ApplyPending()
+{
+    if (!_hasPending)
+        return;
+
+    std::vector<IniChange> changes;
+
+    {
+        std::scoped_lock lock(_mutex);
+        changes.swap(_pending);
+        _hasPending = false;
+    }
+
+    Config::Instance()->ApplyIniChanges(changes);
+}
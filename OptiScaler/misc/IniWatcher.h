@@ -0,0 +1,55 @@
+#pragma once
+#include <pch.h>
+
+#include "IniDiff.h"
+
+#include <atomic>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+
+// Watches ini & game profile folders on a background thread, changed files are parsed & diffed there
+// Profile values are laid over ini values like config loading does
+// Changes are collected per key and applied once per present with ApplyPending
+class IniWatcher
+{
+    // Files are only parsed when last write time or size changes
+    struct FileStamp
+    {
+        std::filesystem::file_time_type LastWrite{};
+        uintmax_t Size = 0;
+        bool Exists = false;
+
+        bool operator==(const FileStamp&) const = default;
+    };
+
+    static inline std::filesystem::path _path;
+    static inline std::filesystem::path _profilePath;
+    static inline FileStamp _iniStamp;
+    static inline FileStamp _profileStamp;
+
+    static inline std::thread _thread;
+    static inline HANDLE _stopEvent = nullptr;
+
+    static inline std::mutex _mutex;
+    static inline IniValues _values;
+    static inline std::vector<IniChange> _pending;
+    static inline std::atomic<bool> _hasPending = false;
+
+    static FileStamp Stamp(const std::filesystem::path& InPath);
+    static bool ReadFile(const std::filesystem::path& InPath, IniValues* OutValues);
+    static bool ReadValues(IniValues* OutValues);
+    static void CheckForChanges();
+    static void WatcherThread();
+
+public:
+    // InProfilePath is game profile of running exe, empty when there is none
+    static void Start(const std::filesystem::path& InPath, const std::filesystem::path& InProfilePath);
+    static void Stop();
+
+    // Takes current file as base, used after ini is saved by us
+    static void Rebase();
+
+    // Called from present hooks, applies collected changes to Config
+    static void ApplyPending();
+};
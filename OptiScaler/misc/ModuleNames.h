@@ -0,0 +1,244 @@
+#pragma once
+
+// Only depends on standard headers so it can be benchmarked without Windows SDK (tools/ModuleNamesBench.cpp)
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+// Dlls which LoadLibrary & GetModuleHandle hooks are interested in
+enum class ModuleKind : uint8_t
+{
+    Unknown,
+
+    Nvngx,
+    NvngxDlss,
+    XeSS,
+    NvApi,
+    Dx11,
+    Dx12,
+    Dxgi,
+    Vulkan,
+    Streamline,
+    Fsr2,
+    Fsr2Dx12,
+    Fsr3,
+    Fsr3Dx12,
+    FfxDx12,
+    FfxVk,
+    Overlay,
+
+    // Names OptiScaler might be loaded as
+    Version,
+    Winmm,
+    Wininet,
+    Dbghelp,
+    Winhttp,
+    OptiScaler,
+
+    // Matched only by extension
+    OptiDll,
+    NgxBin,
+
+    // Not in name table, only used for hooks installed on attach
+    Kernel32,
+    KernelBase,
+
+    Count
+};
+
+// Lookup table of ModuleNames, kept outside so it's complete before being built at compile time
+class ModuleNameTable
+{
+    friend class ModuleNames;
+
+    struct Entry
+    {
+        std::string_view Stem;
+        ModuleKind Kind;
+    };
+
+    // Stems are lower case, accepted with .dll extension or without any extension
+    static constexpr Entry Entries[] =
+    {
+        { "nvngx", ModuleKind::Nvngx },
+        { "_nvngx", ModuleKind::Nvngx },
+        { "nvngx_dlss", ModuleKind::NvngxDlss },
+        { "libxess", ModuleKind::XeSS },
+        { "nvapi64", ModuleKind::NvApi },
+        { "d3d11", ModuleKind::Dx11 },
+        { "d3d12", ModuleKind::Dx12 },
+        { "dxgi", ModuleKind::Dxgi },
+        { "vulkan-1", ModuleKind::Vulkan },
+        { "sl.interposer", ModuleKind::Streamline },
+        { "ffx_fsr2_api_x64", ModuleKind::Fsr2 },
+        { "ffx_fsr2_api_dx12_x64", ModuleKind::Fsr2Dx12 },
+        { "ffx_fsr3upscaler_x64", ModuleKind::Fsr3 },
+        { "ffx_backend_dx12_x64", ModuleKind::Fsr3Dx12 },
+        { "amd_fidelityfx_dx12", ModuleKind::FfxDx12 },
+        { "amd_fidelityfx_vk", ModuleKind::FfxVk },
+        { "eosovh-win32-shipping", ModuleKind::Overlay },
+        { "eosovh-win64-shipping", ModuleKind::Overlay },
+        { "gameoverlayrenderer", ModuleKind::Overlay },
+        { "gameoverlayrenderer64", ModuleKind::Overlay },
+        { "version", ModuleKind::Version },
+        { "winmm", ModuleKind::Winmm },
+        { "wininet", ModuleKind::Wininet },
+        { "dbghelp", ModuleKind::Dbghelp },
+        { "winhttp", ModuleKind::Winhttp },
+        { "optiscaler", ModuleKind::OptiScaler },
+    };
+
+    static constexpr uint32_t EntryCount = sizeof(Entries) / sizeof(Entries[0]);
+    static constexpr uint32_t Size = 256;
+    static constexpr uint8_t EmptySlot = 0xFF;
+
+    // FNV-1a
+    static constexpr uint32_t HashSeed = 2166136261u;
+    static constexpr uint32_t HashStep(uint32_t InHash, uint32_t InChar) { return (InHash ^ InChar) * 16777619u; }
+
+    static constexpr uint32_t Slot(uint32_t InHash) { return (InHash ^ (InHash >> 16)) & (Size - 1); }
+
+    static constexpr uint32_t StemHash(std::string_view InStem)
+    {
+        auto hash = HashSeed;
+
+        for (auto c : InStem)
+            hash = HashStep(hash, (uint8_t)c);
+
+        return hash;
+    }
+
+public:
+    std::array<uint8_t, Size> Slots{};
+    bool Perfect = true;
+
+    static constexpr ModuleNameTable Build()
+    {
+        ModuleNameTable table{};
+        table.Slots.fill(EmptySlot);
+
+        for (uint32_t i = 0; i < EntryCount; i++)
+        {
+            auto slot = Slot(StemHash(Entries[i].Stem));
+
+            if (table.Slots[slot] != EmptySlot)
+                table.Perfect = false;
+
+            table.Slots[slot] = (uint8_t)i;
+        }
+
+        return table;
+    }
+};
+
+// Classifies a dll name or path by its file name, case insensitive and without allocating
+// Names are looked up from a perfect hash table which is built & verified at compile time
+class ModuleNames
+{
+    static constexpr ModuleNameTable _table = ModuleNameTable::Build();
+    static_assert(_table.Perfect, "Module names collide, change ModuleNameTable::Size or Slot()");
+    static_assert((uint32_t)ModuleKind::Count <= 64, "Self mask can't hold all module kinds");
+
+    static constexpr uint32_t Lower(uint32_t InChar) { return (InChar >= 'A' && InChar <= 'Z') ? InChar + ('a' - 'A') : InChar; }
+
+    template <typename T>
+    static constexpr bool ExtensionIs(const T* InBegin, const T* InEnd, std::string_view InExt)
+    {
+        if ((size_t)(InEnd - InBegin) != InExt.size())
+            return false;
+
+        for (size_t i = 0; i < InExt.size(); i++)
+        {
+            if (Lower((std::make_unsigned_t<T>)InBegin[i]) != (uint8_t)InExt[i])
+                return false;
+        }
+
+        return true;
+    }
+
+    // Set while DllMain decides which dll OptiScaler is loaded as
+    static inline uint64_t _selfMask = 0;
+
+public:
+    // Walks InName once, hashing the lower cased file name while looking for separators & extension
+    // Only the hash table candidate is compared afterwards
+    template <typename T>
+    static constexpr ModuleKind Classify(const T* InName)
+    {
+        if (InName == nullptr)
+            return ModuleKind::Unknown;
+
+        const T* fileName = InName;
+        const T* dot = nullptr;
+        auto hash = ModuleNameTable::HashSeed;
+        auto dotHash = ModuleNameTable::HashSeed;
+
+        const T* c = InName;
+        for (; *c != 0; c++)
+        {
+            auto ch = Lower((std::make_unsigned_t<T>)*c);
+
+            if (ch == '\\' || ch == '/')
+            {
+                fileName = c + 1;
+                dot = nullptr;
+                hash = ModuleNameTable::HashSeed;
+                continue;
+            }
+
+            if (ch == '.')
+            {
+                dot = c;
+                dotHash = hash;
+            }
+
+            hash = ModuleNameTable::HashStep(hash, ch);
+        }
+
+        const T* stemEnd = c;
+
+        if (dot != nullptr)
+        {
+            if (ExtensionIs(dot, c, ".optidll"))
+                return ModuleKind::OptiDll;
+
+            if (ExtensionIs(dot, c, ".bin"))
+                return ModuleKind::NgxBin;
+
+            // Unknown extensions are part of the name (sl.interposer)
+            if (ExtensionIs(dot, c, ".dll") || ExtensionIs(dot, c, ".asi"))
+            {
+                stemEnd = dot;
+                hash = dotHash;
+            }
+        }
+
+        auto index = _table.Slots[ModuleNameTable::Slot(hash)];
+
+        if (index == ModuleNameTable::EmptySlot)
+            return ModuleKind::Unknown;
+
+        auto& entry = ModuleNameTable::Entries[index];
+
+        if ((size_t)(stemEnd - fileName) != entry.Stem.size())
+            return ModuleKind::Unknown;
+
+        for (size_t i = 0; i < entry.Stem.size(); i++)
+        {
+            if (Lower((std::make_unsigned_t<T>)fileName[i]) != (uint8_t)entry.Stem[i])
+                return ModuleKind::Unknown;
+        }
+
+        // Only OptiScaler itself is loaded as an asi
+        if (stemEnd != c && entry.Kind != ModuleKind::OptiScaler && ExtensionIs(stemEnd, c, ".asi"))
+            return ModuleKind::Unknown;
+
+        return entry.Kind;
+    }
+
+    // Marks InKind as one of the names OptiScaler is loaded as
+    static void SetSelf(ModuleKind InKind) { _selfMask |= 1ull << (uint32_t)InKind; }
+
+    static bool IsSelf(ModuleKind InKind) { return InKind != ModuleKind::Unknown && (_selfMask & (1ull << (uint32_t)InKind)) != 0; }
+};
@@ -0,0 +1,354 @@
+#include "PipelineCache_Vk.h"
+
+#include <Config.h>
+#include <State.h>
+#include <Util.h>
+
+#include <fstream>
+
+constexpr uint32_t CacheMagic = 0x4B565043; // CPVK
+constexpr uint32_t CacheFormatVersion = 1;
+
+std::filesystem::path PipelineCache_Vk::CachePath()
+{
+    return Util::DllPath().parent_path() / "OptiScaler_Vk.plc";
+}
+
+void PipelineCache_Vk::FillHeader(VkPhysicalDevice InPD, Header* OutHeader)
+{
+    *OutHeader = {};
+    OutHeader->Magic = CacheMagic;
+    OutHeader->FormatVersion = CacheFormatVersion;
+
+    VkPhysicalDeviceIDProperties idProperties{};
+    idProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES;
+
+    VkPhysicalDeviceProperties2 properties{};
+    properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+    properties.pNext = &idProperties;
+
+    // Cache must be keyed with real device info
+    State::Instance().skipSpoofing = true;
+    vkGetPhysicalDeviceProperties2(InPD, &properties);
+    State::Instance().skipSpoofing = false;
+
+    OutHeader->VendorId = properties.properties.vendorID;
+    OutHeader->DeviceId = properties.properties.deviceID;
+    OutHeader->DriverVersion = properties.properties.driverVersion;
+    memcpy(OutHeader->DeviceUUID, idProperties.deviceUUID, VK_UUID_SIZE);
+    memcpy(OutHeader->DriverUUID, idProperties.driverUUID, VK_UUID_SIZE);
+    memcpy(OutHeader->CacheUUID, properties.properties.pipelineCacheUUID, VK_UUID_SIZE);
+}
+
+std::vector<uint8_t> PipelineCache_Vk::ReadFile()
+{
+    auto path = CachePath();
+
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+    {
+        LOG_DEBUG("No cache file at {0}", path.string());
+        return {};
+    }
+
+    auto size = (size_t)file.tellg();
+    file.seekg(0);
+
+    std::vector<uint8_t> data(size);
+    if (!file.read((char*)data.data(), size))
+    {
+        LOG_ERROR("Can't read {0}", path.string());
+        return {};
+    }
+
+    LOG_DEBUG("Read {0} bytes from {1}", size, path.string());
+
+    return data;
+}
+
+void PipelineCache_Vk::WriteFile(std::vector<uint8_t> InData)
+{
+    auto path = CachePath();
+    auto tempPath = path;
+    tempPath += ".tmp";
+
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open() || !file.write((const char*)InData.data(), InData.size()))
+        {
+            LOG_ERROR("Can't write {0}", tempPath.string());
+            return;
+        }
+    }
+
+    // Replace old file only after new one is completely written
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+
+    if (ec)
+        LOG_ERROR("Can't replace {0}: {1}", path.string(), ec.message());
+    else
+        LOG_INFO("Saved {0} bytes to {1}", InData.size(), path.string());
+}
+
+void PipelineCache_Vk::WaitIO()
+{
+    if (!_ioThread.joinable())
+        return;
+
+    if (State::Instance().isShuttingDown)
+        _ioThread.detach();
+    else
+        _ioThread.join();
+}
+
+void PipelineCache_Vk::Bind()
+{
+    _binding.store({ _device, _cache }, std::memory_order_release);
+}
+
+VkPipelineCache PipelineCache_Vk::CacheOf(VkDevice InDevice)
+{
+    auto binding = _binding.load(std::memory_order_acquire);
+    return binding.Device == InDevice ? binding.Cache : VK_NULL_HANDLE;
+}
+
+void PipelineCache_Vk::AddCreationTime(double InStartMs)
+{
+    _creationTimeUs += (int64_t)((Util::MillisecondsNow() - InStartMs) * 1000.0);
+    _creationCount++;
+}
+
+void PipelineCache_Vk::WriteCache(VkDevice InDevice, VkPipelineCache InCache, Header InHeader)
+{
+    size_t dataSize = 0;
+    vkGetPipelineCacheData(InDevice, InCache, &dataSize, nullptr);
+
+    std::vector<uint8_t> data(sizeof(Header) + dataSize);
+    auto result = vkGetPipelineCacheData(InDevice, InCache, &dataSize, data.data() + sizeof(Header));
+
+    // VK_INCOMPLETE when pipelines are added between calls, next save will write them
+    if (result != VK_SUCCESS)
+    {
+        LOG_ERROR("vkGetPipelineCacheData error: {0:X}", (UINT)result);
+        return;
+    }
+
+    InHeader.BlobSize = dataSize;
+    memcpy(data.data(), &InHeader, sizeof(Header));
+    data.resize(sizeof(Header) + dataSize);
+
+    WriteFile(std::move(data));
+}
+
+VkPipelineCache PipelineCache_Vk::Get(VkDevice InDevice, VkPhysicalDevice InPD)
+{
+    if (InDevice == VK_NULL_HANDLE || InPD == VK_NULL_HANDLE || !Config::Instance()->VulkanPipelineCache.value_or_default())
+        return VK_NULL_HANDLE;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_cache != VK_NULL_HANDLE && _device == InDevice)
+        return _cache;
+
+    // IO thread might be reading old cache
+    WaitIO();
+
+    // Old device is still alive, its objects might be created with old cache until it's destroyed
+    if (_cache != VK_NULL_HANDLE)
+    {
+        LOG_DEBUG("Device changed, creating a new pipeline cache");
+        _oldCaches.emplace_back(_device, _cache);
+    }
+
+    _device = InDevice;
+    _cache = VK_NULL_HANDLE;
+    _savedSize = 0;
+    _loaded = false;
+    Bind();
+
+    FillHeader(InPD, &_header);
+
+    VkPipelineCacheCreateInfo info{};
+    info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+
+    auto fileData = ReadFile();
+
+    if (fileData.size() > sizeof(Header))
+    {
+        Header fileHeader{};
+        memcpy(&fileHeader, fileData.data(), sizeof(Header));
+
+        // Header has no implicit padding, everything before blob size must match
+        if (memcmp(&fileHeader, &_header, offsetof(Header, BlobSize)) == 0 && fileHeader.BlobSize == fileData.size() - sizeof(Header))
+        {
+            info.initialDataSize = (size_t)fileHeader.BlobSize;
+            info.pInitialData = fileData.data() + sizeof(Header);
+        }
+        else
+        {
+            LOG_INFO("Pipeline cache is invalidated (device or driver changed)");
+        }
+    }
+
+    auto result = vkCreatePipelineCache(InDevice, &info, nullptr, &_cache);
+
+    if (result == VK_SUCCESS && info.initialDataSize > 0)
+    {
+        LOG_INFO("Loaded pipeline cache from file ({0} bytes)", info.initialDataSize);
+        _savedSize = info.initialDataSize;
+        _loaded = true;
+    }
+    else if (result != VK_SUCCESS && info.initialDataSize > 0)
+    {
+        // Driver also validates the data, try again with an empty cache
+        LOG_WARN("Cached pipeline data rejected: {0:X}", (UINT)result);
+        info.initialDataSize = 0;
+        info.pInitialData = nullptr;
+        result = vkCreatePipelineCache(InDevice, &info, nullptr, &_cache);
+    }
+
+    if (result != VK_SUCCESS)
+    {
+        LOG_ERROR("vkCreatePipelineCache error: {0:X}", (UINT)result);
+        _cache = VK_NULL_HANDLE;
+        _device = VK_NULL_HANDLE;
+    }
+
+    Bind();
+
+    return _cache;
+}
+
+PFN_vkGetDeviceProcAddr PipelineCache_Vk::DeviceProcAddr(VkDevice InDevice, VkPhysicalDevice InPD, PFN_vkGetDeviceProcAddr InGDPA)
+{
+    if (InGDPA == nullptr || Get(InDevice, InPD) == VK_NULL_HANDLE)
+        return InGDPA;
+
+    // Backends resolve their functions once while creating the context
+    _gdpa = InGDPA;
+
+    return hkvkGetDeviceProcAddr;
+}
+
+PFN_vkVoidFunction VKAPI_CALL PipelineCache_Vk::hkvkGetDeviceProcAddr(VkDevice InDevice, const char* InName)
+{
+    auto function = _gdpa(InDevice, InName);
+
+    if (function == nullptr || InName == nullptr)
+        return function;
+
+    if (strcmp(InName, "vkCreateComputePipelines") == 0)
+    {
+        o_vkCreateComputePipelines = (PFN_vkCreateComputePipelines)function;
+        return (PFN_vkVoidFunction)hkvkCreateComputePipelines;
+    }
+
+    if (strcmp(InName, "vkCreateGraphicsPipelines") == 0)
+    {
+        o_vkCreateGraphicsPipelines = (PFN_vkCreateGraphicsPipelines)function;
+        return (PFN_vkVoidFunction)hkvkCreateGraphicsPipelines;
+    }
+
+    return function;
+}
+
+VkResult VKAPI_CALL PipelineCache_Vk::hkvkCreateComputePipelines(VkDevice InDevice, VkPipelineCache InCache, uint32_t InCount,
+                                                                 const VkComputePipelineCreateInfo* InInfos, const VkAllocationCallbacks* InAllocator,
+                                                                 VkPipeline* OutPipelines)
+{
+    if (InCache == VK_NULL_HANDLE)
+        InCache = CacheOf(InDevice);
+
+    if (!_timing.load(std::memory_order_relaxed))
+        return o_vkCreateComputePipelines(InDevice, InCache, InCount, InInfos, InAllocator, OutPipelines);
+
+    auto start = Util::MillisecondsNow();
+    auto result = o_vkCreateComputePipelines(InDevice, InCache, InCount, InInfos, InAllocator, OutPipelines);
+    AddCreationTime(start);
+
+    return result;
+}
+
+VkResult VKAPI_CALL PipelineCache_Vk::hkvkCreateGraphicsPipelines(VkDevice InDevice, VkPipelineCache InCache, uint32_t InCount,
+                                                                  const VkGraphicsPipelineCreateInfo* InInfos, const VkAllocationCallbacks* InAllocator,
+                                                                  VkPipeline* OutPipelines)
+{
+    if (InCache == VK_NULL_HANDLE)
+        InCache = CacheOf(InDevice);
+
+    if (!_timing.load(std::memory_order_relaxed))
+        return o_vkCreateGraphicsPipelines(InDevice, InCache, InCount, InInfos, InAllocator, OutPipelines);
+
+    auto start = Util::MillisecondsNow();
+    auto result = o_vkCreateGraphicsPipelines(InDevice, InCache, InCount, InInfos, InAllocator, OutPipelines);
+    AddCreationTime(start);
+
+    return result;
+}
+
+void PipelineCache_Vk::Save()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_cache == VK_NULL_HANDLE)
+        return;
+
+    // Startup pipelines are created before first save, later creations are not timed
+    if (_timing.exchange(false) && _creationCount > 0)
+    {
+        LOG_INFO("Pipeline creation took {0:.2f} ms in {1} calls, cache file was {2}", _creationTimeUs / 1000.0, _creationCount.load(),
+                 _loaded ? "loaded" : "not used");
+    }
+
+    size_t size = 0;
+    auto result = vkGetPipelineCacheData(_device, _cache, &size, nullptr);
+
+    if (result != VK_SUCCESS || size <= _savedSize)
+        return;
+
+    WaitIO();
+
+    _savedSize = size;
+
+    // Cache is internally synchronized, data can be read while other pipelines are created
+    _ioThread = std::thread(WriteCache, _device, _cache, _header);
+}
+
+void PipelineCache_Vk::DeviceDestroyed(VkDevice InDevice)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    for (auto it = _oldCaches.begin(); it != _oldCaches.end();)
+    {
+        if (it->first == InDevice)
+        {
+            vkDestroyPipelineCache(it->first, it->second, nullptr);
+            it = _oldCaches.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    if (_cache == VK_NULL_HANDLE || _device != InDevice)
+        return;
+
+    // Cache can't be read after device is gone, so last save is done here without a worker
+    if (_ioThread.joinable())
+        _ioThread.join();
+
+    size_t size = 0;
+    if (vkGetPipelineCacheData(_device, _cache, &size, nullptr) == VK_SUCCESS && size > _savedSize)
+        WriteCache(_device, _cache, _header);
+
+    vkDestroyPipelineCache(_device, _cache, nullptr);
+
+    LOG_DEBUG("Destroyed pipeline cache of device {0:X}", (size_t)InDevice);
+
+    _device = VK_NULL_HANDLE;
+    _cache = VK_NULL_HANDLE;
+    _savedSize = 0;
+    Bind();
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include <pch.h>
+
+#include <vulkan/vulkan.hpp>
+#include <filesystem>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <atomic>
+
+// Process wide VkPipelineCache for every pipeline OptiScaler creates (menu overlay & FFX backends)
+// Serialized next to the dll and reloaded on next launch when vendor, device, driver & cache UUIDs match
+class PipelineCache_Vk
+{
+    struct Header
+    {
+        uint32_t Magic;
+        uint32_t FormatVersion;
+        uint32_t VendorId;
+        uint32_t DeviceId;
+        uint32_t DriverVersion;
+        uint32_t Padding;
+        uint8_t DeviceUUID[VK_UUID_SIZE];
+        uint8_t DriverUUID[VK_UUID_SIZE];
+        uint8_t CacheUUID[VK_UUID_SIZE];
+        uint64_t BlobSize;
+    };
+
+    static inline std::mutex _mutex;
+    static inline std::thread _ioThread;
+
+    static inline VkDevice _device = VK_NULL_HANDLE;
+    static inline VkPipelineCache _cache = VK_NULL_HANDLE;
+    static inline Header _header{};
+    static inline size_t _savedSize = 0;
+    static inline bool _loaded = false;
+
+    // Device & cache read by pipeline creation hooks without the lock
+    // Written together under _mutex, so a hook never pairs a device with cache of another one
+    struct Binding
+    {
+        VkDevice Device = VK_NULL_HANDLE;
+        VkPipelineCache Cache = VK_NULL_HANDLE;
+    };
+
+    static inline std::atomic<Binding> _binding{};
+
+    // Caches of previous devices, kept until their device is destroyed
+    static inline std::vector<std::pair<VkDevice, VkPipelineCache>> _oldCaches;
+
+    // Original functions of FFX backends' device proc addr
+    static inline PFN_vkGetDeviceProcAddr _gdpa = nullptr;
+    static inline PFN_vkCreateComputePipelines o_vkCreateComputePipelines = nullptr;
+    static inline PFN_vkCreateGraphicsPipelines o_vkCreateGraphicsPipelines = nullptr;
+
+    // Pipeline creation time of cached calls, for comparing startups with & without a cache file
+    // Only measured until first save reports it
+    static inline std::atomic<bool> _timing = true;
+    static inline std::atomic<int64_t> _creationTimeUs = 0;
+    static inline std::atomic<uint32_t> _creationCount = 0;
+
+    static std::filesystem::path CachePath();
+    static void FillHeader(VkPhysicalDevice InPD, Header* OutHeader);
+    static std::vector<uint8_t> ReadFile();
+    static void WriteFile(std::vector<uint8_t> InData);
+    static void WriteCache(VkDevice InDevice, VkPipelineCache InCache, Header InHeader);
+
+    // Must be called with _mutex locked
+    static void WaitIO();
+
+    // Must be called with _mutex locked after _device or _cache changed
+    static void Bind();
+
+    static VkPipelineCache CacheOf(VkDevice InDevice);
+    static void AddCreationTime(double InStartMs);
+
+    static PFN_vkVoidFunction VKAPI_CALL hkvkGetDeviceProcAddr(VkDevice InDevice, const char* InName);
+    static VkResult VKAPI_CALL hkvkCreateComputePipelines(VkDevice InDevice, VkPipelineCache InCache, uint32_t InCount,
+                                                          const VkComputePipelineCreateInfo* InInfos, const VkAllocationCallbacks* InAllocator,
+                                                          VkPipeline* OutPipelines);
+    static VkResult VKAPI_CALL hkvkCreateGraphicsPipelines(VkDevice InDevice, VkPipelineCache InCache, uint32_t InCount,
+                                                           const VkGraphicsPipelineCreateInfo* InInfos, const VkAllocationCallbacks* InAllocator,
+                                                           VkPipeline* OutPipelines);
+
+public:
+    // Returns cache of InDevice, primed from cache file when it's valid
+    // Returns VK_NULL_HANDLE when disabled in config
+    static VkPipelineCache Get(VkDevice InDevice, VkPhysicalDevice InPD);
+
+    // Returns a device proc addr which passes the cache to pipeline creations without one
+    // Returns InGDPA when cache is disabled or can't be created
+    static PFN_vkGetDeviceProcAddr DeviceProcAddr(VkDevice InDevice, VkPhysicalDevice InPD, PFN_vkGetDeviceProcAddr InGDPA);
+
+    // Writes cache data on a worker thread if new pipelines are added
+    static void Save();
+
+    // Called before InDevice is destroyed, saves & destroys its cache
+    static void DeviceDestroyed(VkDevice InDevice);
+};
@@ -0,0 +1,149 @@
+#include "RootSignatureCache.h"
+
+#include <misc/SamplerTracker.h>
+
+static void AppendBytes(std::vector<uint8_t>* InOutContent, const void* InData, size_t InSize)
+{
+    auto bytes = (const uint8_t*)InData;
+    InOutContent->insert(InOutContent->end(), bytes, bytes + InSize);
+}
+
+template <typename T>
+static void AppendValue(std::vector<uint8_t>* InOutContent, const T& InValue)
+{
+    AppendBytes(InOutContent, &InValue, sizeof(T));
+}
+
+uint64_t RootSignatureCache::Hash(const std::vector<uint8_t>& InContent)
+{
+    uint64_t hash = 14695981039346656037ull;
+
+    // FNV-1a
+    for (auto byte : InContent)
+        hash = (hash ^ byte) * 1099511628211ull;
+
+    return hash;
+}
+
+std::vector<uint8_t> RootSignatureCache::Content(const D3D12_ROOT_SIGNATURE_DESC* InDesc, D3D_ROOT_SIGNATURE_VERSION InVersion, const ConfigSnapshot* InConfig)
+{
+    std::vector<uint8_t> content;
+    content.reserve(256);
+
+    AppendValue(&content, InVersion);
+    AppendValue(&content, InDesc->Flags);
+    AppendValue(&content, InDesc->NumParameters);
+
+    for (UINT i = 0; i < InDesc->NumParameters; i++)
+    {
+        auto& param = InDesc->pParameters[i];
+
+        AppendValue(&content, param.ParameterType);
+        AppendValue(&content, param.ShaderVisibility);
+
+        // Union members are stored by type, descriptor table only holds a pointer to ranges
+        switch (param.ParameterType)
+        {
+            case D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE:
+                AppendValue(&content, param.DescriptorTable.NumDescriptorRanges);
+
+                if (param.DescriptorTable.NumDescriptorRanges > 0 && param.DescriptorTable.pDescriptorRanges != nullptr)
+                    AppendBytes(&content, param.DescriptorTable.pDescriptorRanges, sizeof(D3D12_DESCRIPTOR_RANGE) * param.DescriptorTable.NumDescriptorRanges);
+
+                break;
+
+            case D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS:
+                AppendValue(&content, param.Constants);
+                break;
+
+            default:
+                AppendValue(&content, param.Descriptor);
+                break;
+        }
+    }
+
+    AppendValue(&content, InDesc->NumStaticSamplers);
+
+    if (InDesc->NumStaticSamplers > 0 && InDesc->pStaticSamplers != nullptr)
+        AppendBytes(&content, InDesc->pStaticSamplers, sizeof(D3D12_STATIC_SAMPLER_DESC) * InDesc->NumStaticSamplers);
+
+    AppendValue(&content, InConfig->HasAnisotropyOverride);
+    AppendValue(&content, InConfig->AnisotropyOverride);
+    AppendValue(&content, InConfig->HasMipmapBiasOverride);
+    AppendValue(&content, InConfig->MipmapBiasOverride);
+    AppendValue(&content, InConfig->MipmapBiasFixedOverride);
+    AppendValue(&content, InConfig->MipmapBiasScaleOverride);
+    AppendValue(&content, InConfig->MipmapBiasOverrideAll);
+    AppendValue(&content, InConfig->MipmapBiasAuto);
+
+    // Auto bias is keyed by the rounded bias static samplers get, not by exact render scale,
+    // otherwise every DRS step would miss the cache
+    if (InConfig->MipmapBiasAuto)
+        AppendValue(&content, SamplerTracker::AutoBias(InConfig));
+
+    return content;
+}
+
+ID3DBlob* RootSignatureCache::Find(const std::vector<uint8_t>& InContent)
+{
+    auto key = Hash(InContent);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto it = _blobs.find(key);
+
+    // Hash collision of a different desc is a miss
+    if (it == _blobs.end() || it->second.Content != InContent)
+    {
+        _misses++;
+        return nullptr;
+    }
+
+    _hits++;
+    it->second.Blob->AddRef();
+
+    return it->second.Blob;
+}
+
+void RootSignatureCache::Add(std::vector<uint8_t> InContent, ID3DBlob* InBlob, double InSerializeMs)
+{
+    _serializeTimeUs += (int64_t)(InSerializeMs * 1000.0);
+
+    if (InBlob == nullptr)
+        return;
+
+    auto key = Hash(InContent);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // First desc of a hash keeps the slot
+    if (_blobs.size() >= MaxEntries || _blobs.contains(key))
+        return;
+
+    InBlob->AddRef();
+    _blobs[key] = { std::move(InContent), InBlob };
+
+    LOG_DEBUG("Cached root signature {0:016X}, size: {1}, serialized in {2:.3f} ms", key, InBlob->GetBufferSize(), InSerializeMs);
+}
+
+RootSignatureCache::Stats RootSignatureCache::GetStats()
+{
+    Stats stats{};
+    stats.Hits = _hits;
+    stats.Misses = _misses;
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        stats.Entries = _blobs.size();
+    }
+
+    auto total = stats.Hits + stats.Misses;
+
+    if (total > 0)
+        stats.HitRate = (double)stats.Hits / (double)total;
+
+    if (stats.Misses > 0)
+        stats.SavedMs = (_serializeTimeUs / 1000.0) / (double)stats.Misses * (double)stats.Hits;
+
+    return stats;
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <pch.h>
+
+#include <Config.h>
+
+#include <d3d12.h>
+#include <ankerl/unordered_dense.h>
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+// Serialized root signatures with patched static samplers, keyed by content of the original desc & sampler settings
+// Entries keep the full content, a hash match is only a hit when content is also equal
+// Engines which serialize same root signatures while streaming get the cached blob instead of patching & serializing again
+class RootSignatureCache
+{
+    // Blobs are kept referenced until process exit, new ones are not cached after this
+    static constexpr size_t MaxEntries = 1024;
+
+    static inline std::mutex _mutex;
+    struct Entry
+    {
+        std::vector<uint8_t> Content;
+        ID3DBlob* Blob = nullptr;
+    };
+
+    static inline ankerl::unordered_dense::map<uint64_t, Entry> _blobs;
+
+    static uint64_t Hash(const std::vector<uint8_t>& InContent);
+
+    static inline std::atomic<uint64_t> _hits = 0;
+    static inline std::atomic<uint64_t> _misses = 0;
+    static inline std::atomic<int64_t> _serializeTimeUs = 0;
+
+public:
+    struct Stats
+    {
+        uint64_t Hits = 0;
+        uint64_t Misses = 0;
+        size_t Entries = 0;
+        double HitRate = 0.0;
+
+        // Average serialize time of misses * hits
+        double SavedMs = 0.0;
+    };
+
+    // Bytes of original (not patched) desc, version and every setting which changes patching result
+    static std::vector<uint8_t> Content(const D3D12_ROOT_SIGNATURE_DESC* InDesc, D3D_ROOT_SIGNATURE_VERSION InVersion, const ConfigSnapshot* InConfig);
+
+    // Returns a referenced blob on hit, nullptr on miss
+    static ID3DBlob* Find(const std::vector<uint8_t>& InContent);
+
+    // InBlob is referenced by cache, InSerializeMs is time spent for patching & serializing it
+    static void Add(std::vector<uint8_t> InContent, ID3DBlob* InBlob, double InSerializeMs);
+
+    static Stats GetStats();
+};
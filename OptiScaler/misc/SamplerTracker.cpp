@@ -0,0 +1,395 @@
+#include "SamplerTracker.h"
+
+#include <State.h>
+
+void SamplerTracker::UpdateMipBiasState(float InBias)
+{
+    if (State::Instance().lastMipBiasMax < InBias)
+        State::Instance().lastMipBiasMax = InBias;
+
+    if (State::Instance().lastMipBias > InBias)
+        State::Instance().lastMipBias = InBias;
+}
+
+bool SamplerTracker::OverrideBias(const ConfigSnapshot* InConfig, float InBias, float* OutBias)
+{
+    if (InConfig->MipmapBiasAuto)
+    {
+        *OutBias = AutoBias(InConfig);
+        return true;
+    }
+
+    if (!InConfig->HasMipmapBiasOverride)
+        return false;
+
+    if (InConfig->MipmapBiasFixedOverride)
+        *OutBias = InConfig->MipmapBiasOverride;
+    else if (InConfig->MipmapBiasScaleOverride)
+        *OutBias = InBias * InConfig->MipmapBiasOverride;
+    else
+        *OutBias = InBias + InConfig->MipmapBiasOverride;
+
+    return true;
+}
+
+void SamplerTracker::PatchDesc(const ConfigSnapshot* InConfig, const D3D12_SAMPLER_DESC* InDesc, D3D12_SAMPLER_DESC* OutDesc)
+{
+    *OutDesc = *InDesc;
+
+    if (InConfig->HasAnisotropyOverride)
+    {
+        if (InDesc->Filter == D3D12_FILTER_MIN_MAG_MIP_LINEAR || InDesc->Filter == D3D12_FILTER_MIN_MAG_LINEAR_MIP_POINT || InDesc->Filter == D3D12_FILTER_ANISOTROPIC)
+        {
+            OutDesc->Filter = D3D12_FILTER_ANISOTROPIC;
+            LOG_DEBUG("Overriding {2:X} to anisotropic filtering {0} -> {1}", InDesc->MaxAnisotropy, InConfig->AnisotropyOverride, (UINT)InDesc->Filter);
+            OutDesc->MaxAnisotropy = InConfig->AnisotropyOverride;
+        }
+    }
+
+    if (InDesc->MipLODBias < 0.0f || InConfig->MipmapBiasOverrideAll)
+    {
+        if (OverrideBias(InConfig, InDesc->MipLODBias, &OutDesc->MipLODBias))
+            LOG_DEBUG("Overriding mipmap bias {0} -> {1}", InDesc->MipLODBias, OutDesc->MipLODBias);
+
+        UpdateMipBiasState(OutDesc->MipLODBias);
+    }
+}
+
+void SamplerTracker::PatchDesc(const ConfigSnapshot* InConfig, const D3D11_SAMPLER_DESC* InDesc, D3D11_SAMPLER_DESC* OutDesc)
+{
+    *OutDesc = *InDesc;
+
+    if (InConfig->HasAnisotropyOverride)
+    {
+        auto filter = InDesc->Filter;
+
+        if (filter <= D3D11_FILTER_MAXIMUM_ANISOTROPIC)
+        {
+            if (filter <= D3D11_FILTER_ANISOTROPIC)
+                OutDesc->Filter = D3D11_FILTER_ANISOTROPIC;
+            else if (filter <= D3D11_FILTER_COMPARISON_ANISOTROPIC)
+                OutDesc->Filter = D3D11_FILTER_COMPARISON_ANISOTROPIC;
+            else if (filter <= D3D11_FILTER_MINIMUM_ANISOTROPIC)
+                OutDesc->Filter = D3D11_FILTER_MINIMUM_ANISOTROPIC;
+            else
+                OutDesc->Filter = D3D11_FILTER_MAXIMUM_ANISOTROPIC;
+
+            LOG_DEBUG("Overriding {2:X} to anisotropic filtering {0} -> {1}", InDesc->MaxAnisotropy, InConfig->AnisotropyOverride, (UINT)filter);
+            OutDesc->MaxAnisotropy = InConfig->AnisotropyOverride;
+        }
+    }
+
+    if (InDesc->MipLODBias < 0.0f || InConfig->MipmapBiasOverrideAll)
+    {
+        if (OverrideBias(InConfig, InDesc->MipLODBias, &OutDesc->MipLODBias))
+            LOG_DEBUG("Overriding mipmap bias {0} -> {1}", InDesc->MipLODBias, OutDesc->MipLODBias);
+
+        UpdateMipBiasState(OutDesc->MipLODBias);
+    }
+}
+
+void SamplerTracker::PatchDesc(const ConfigSnapshot* InConfig, D3D12_STATIC_SAMPLER_DESC* InOutDesc)
+{
+    if (InOutDesc->MipLODBias < 0.0f || InConfig->MipmapBiasOverrideAll)
+    {
+        float bias = InOutDesc->MipLODBias;
+
+        if (OverrideBias(InConfig, InOutDesc->MipLODBias, &bias))
+        {
+            LOG_DEBUG("Overriding mipmap bias {0} -> {1}", InOutDesc->MipLODBias, bias);
+            InOutDesc->MipLODBias = bias;
+            UpdateMipBiasState(bias);
+        }
+    }
+
+    if (InConfig->HasAnisotropyOverride)
+    {
+        if (InOutDesc->Filter == D3D12_FILTER_MIN_MAG_MIP_LINEAR || InOutDesc->Filter == D3D12_FILTER_MIN_MAG_LINEAR_MIP_POINT || InOutDesc->Filter == D3D12_FILTER_ANISOTROPIC)
+        {
+            LOG_DEBUG("Overriding {2:X} to anisotropic filtering {0} -> {1}", InOutDesc->MaxAnisotropy, InConfig->AnisotropyOverride, (UINT)InOutDesc->Filter);
+            InOutDesc->Filter = D3D12_FILTER_ANISOTROPIC;
+            InOutDesc->MaxAnisotropy = InConfig->AnisotropyOverride;
+        }
+    }
+}
+
+SamplerTracker::HeapInfo* SamplerTracker::FindHeap(SIZE_T InHandle)
+{
+    for (auto& heap : _heaps)
+    {
+        if (InHandle >= heap.CpuStart && InHandle < heap.CpuEnd)
+            return &heap;
+    }
+
+    return nullptr;
+}
+
+void SamplerTracker::CopyTracked(SIZE_T InDest, SIZE_T InSrc)
+{
+    if (FindHeap(InDest) == nullptr)
+        return;
+
+    // Source is read before destination shard is locked, only one shard lock is held at a time
+    bool found = false;
+    D3D12_SAMPLER_DESC desc{};
+
+    {
+        auto& shard = Shard(InSrc);
+        std::lock_guard<std::mutex> lock(shard.Mutex);
+
+        if (auto it = shard.Samplers.find(InSrc); it != shard.Samplers.end())
+        {
+            desc = it->second;
+            found = true;
+        }
+    }
+
+    // Destination now holds source's sampler, or an untracked one
+    auto& shard = Shard(InDest);
+    std::lock_guard<std::mutex> lock(shard.Mutex);
+
+    if (found)
+        shard.Samplers[InDest] = desc;
+    else
+        shard.Samplers.erase(InDest);
+}
+
+void WINAPI SamplerTracker::HeapDestroyed(void* InHeap)
+{
+    std::unique_lock<std::shared_mutex> lock(_mutex);
+
+    for (auto heap = _heaps.begin(); heap != _heaps.end(); heap++)
+    {
+        if (heap->Heap != InHeap)
+            continue;
+
+        for (auto& shard : _shards)
+        {
+            std::lock_guard<std::mutex> shardLock(shard.Mutex);
+
+            for (auto it = shard.Samplers.begin(); it != shard.Samplers.end();)
+            {
+                if (it->first >= heap->CpuStart && it->first < heap->CpuEnd)
+                    it = shard.Samplers.erase(it);
+                else
+                    it++;
+            }
+        }
+
+        LOG_DEBUG("Sampler heap destroyed: {:X}", (size_t)InHeap);
+
+        _heaps.erase(heap);
+        _heapCount = _heaps.size();
+        return;
+    }
+}
+
+void SamplerTracker::RegisterHeap(ID3D12Device* InDevice, ID3D12DescriptorHeap* InHeap, const D3D12_DESCRIPTOR_HEAP_DESC* InDesc)
+{
+    if (!_tracking || InDevice == nullptr || InHeap == nullptr || InDesc == nullptr || InDesc->Type != D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER)
+        return;
+
+    // GPU might be reading shader visible heaps, their descriptors are never rewritten
+    if ((InDesc->Flags & D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE) != 0)
+        return;
+
+    // Heap is tracked only when we are notified of its destruction
+    ID3DDestructionNotifier* notifier = nullptr;
+    if (InHeap->QueryInterface(IID_PPV_ARGS(&notifier)) != S_OK || notifier == nullptr)
+    {
+        LOG_DEBUG("Sampler heap has no destruction notifier, samplers of heap won't be tracked");
+        return;
+    }
+
+    HeapInfo info{};
+    info.Device = InDevice;
+    info.Heap = InHeap;
+    info.CpuStart = InHeap->GetCPUDescriptorHandleForHeapStart().ptr;
+    info.CpuEnd = info.CpuStart + (SIZE_T)InDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER) * InDesc->NumDescriptors;
+
+    {
+        std::unique_lock<std::shared_mutex> lock(_mutex);
+        _heaps.push_back(info);
+        _heapCount = _heaps.size();
+    }
+
+    UINT callbackId = 0;
+    auto result = notifier->RegisterDestructionCallback(HeapDestroyed, InHeap, &callbackId);
+    notifier->Release();
+
+    if (result != S_OK)
+    {
+        LOG_DEBUG("RegisterDestructionCallback error: {:X}", (UINT)result);
+        HeapDestroyed(InHeap);
+        return;
+    }
+
+    LOG_DEBUG("Sampler heap: {:X}, Cpu: {}-{}, Desc count: {}", (size_t)InHeap, info.CpuStart, info.CpuEnd, InDesc->NumDescriptors);
+}
+
+void SamplerTracker::Track(const D3D12_SAMPLER_DESC* InDesc, D3D12_CPU_DESCRIPTOR_HANDLE InHandle)
+{
+    if (_heapCount == 0)
+        return;
+
+    std::shared_lock<std::shared_mutex> lock(_mutex);
+
+    if (FindHeap(InHandle.ptr) == nullptr)
+        return;
+
+    // Latest sampler written to handle replaces the old one
+    auto& shard = Shard(InHandle.ptr);
+    std::lock_guard<std::mutex> shardLock(shard.Mutex);
+    shard.Samplers[InHandle.ptr] = *InDesc;
+}
+
+void SamplerTracker::CopyDescriptors(PFN_CopyDescriptors InCopy, ID3D12Device* InDevice,
+                                     UINT InNumDestRanges, D3D12_CPU_DESCRIPTOR_HANDLE* InDestStarts, UINT* InDestSizes,
+                                     UINT InNumSrcRanges, D3D12_CPU_DESCRIPTOR_HANDLE* InSrcStarts, UINT* InSrcSizes)
+{
+    // No CPU only sampler heaps, nothing can be tracked
+    if (_heapCount == 0)
+    {
+        InCopy(InDevice, InNumDestRanges, InDestStarts, InDestSizes, InNumSrcRanges, InSrcStarts, InSrcSizes, D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER);
+        return;
+    }
+
+    std::shared_lock<std::shared_mutex> lock(_mutex);
+
+    InCopy(InDevice, InNumDestRanges, InDestStarts, InDestSizes, InNumSrcRanges, InSrcStarts, InSrcSizes, D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER);
+
+    auto increment = InDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER);
+
+    // Null range sizes mean ranges of one descriptor
+    UINT destRange = 0;
+    UINT destIndex = 0;
+
+    for (UINT i = 0; i < InNumSrcRanges; i++)
+    {
+        UINT srcSize = InSrcSizes != nullptr ? InSrcSizes[i] : 1;
+
+        for (UINT j = 0; j < srcSize && destRange < InNumDestRanges; j++)
+        {
+            CopyTracked(InDestStarts[destRange].ptr + (SIZE_T)destIndex * increment, InSrcStarts[i].ptr + (SIZE_T)j * increment);
+
+            UINT destSize = InDestSizes != nullptr ? InDestSizes[destRange] : 1;
+
+            if (++destIndex >= destSize)
+            {
+                destIndex = 0;
+                destRange++;
+            }
+        }
+    }
+}
+
+void SamplerTracker::CopyDescriptorsSimple(PFN_CopyDescriptorsSimple InCopy, ID3D12Device* InDevice, UINT InCount,
+                                           D3D12_CPU_DESCRIPTOR_HANDLE InDest, D3D12_CPU_DESCRIPTOR_HANDLE InSrc)
+{
+    // No CPU only sampler heaps, nothing can be tracked
+    if (_heapCount == 0)
+    {
+        InCopy(InDevice, InCount, InDest, InSrc, D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER);
+        return;
+    }
+
+    std::shared_lock<std::shared_mutex> lock(_mutex);
+
+    InCopy(InDevice, InCount, InDest, InSrc, D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER);
+
+    auto increment = InDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER);
+
+    for (UINT i = 0; i < InCount; i++)
+        CopyTracked(InDest.ptr + (SIZE_T)i * increment, InSrc.ptr + (SIZE_T)i * increment);
+}
+
+void SamplerTracker::Update()
+{
+    auto config = Config::Snapshot();
+
+    float renderScale = 1.0f;
+    auto feature = State::Instance().currentFeature;
+
+    if (feature != nullptr && feature->RenderWidth() > 0 && feature->DisplayWidth() > 0)
+        renderScale = (float)feature->RenderWidth() / (float)feature->DisplayWidth();
+
+    _renderScale = renderScale;
+
+    BiasSettings settings{};
+    settings.HasOverride = config->HasMipmapBiasOverride;
+    settings.Override = config->MipmapBiasOverride;
+    settings.Fixed = config->MipmapBiasFixedOverride;
+    settings.Scale = config->MipmapBiasScaleOverride;
+    settings.All = config->MipmapBiasOverrideAll;
+    settings.Auto = config->MipmapBiasAuto;
+    settings.AutoOffset = config->MipmapBiasAutoOffset;
+
+    // Render scale only matters for auto bias, small changes of it keep the same bias
+    if (settings.Auto)
+        settings.AutoBias = AutoBias(config);
+
+    if (settings == _lastSettings)
+        return;
+
+    _lastSettings = settings;
+
+    if (_createSampler == nullptr || _heapCount == 0)
+        return;
+
+    // Original & patched descs are collected without blocking copies
+    struct Recreate
+    {
+        SIZE_T Handle;
+        D3D12_SAMPLER_DESC Original;
+        D3D12_SAMPLER_DESC Patched;
+    };
+
+    std::vector<Recreate> samplers;
+
+    {
+        std::shared_lock<std::shared_mutex> lock(_mutex);
+
+        for (auto& shard : _shards)
+        {
+            std::lock_guard<std::mutex> shardLock(shard.Mutex);
+
+            for (auto& [handle, desc] : shard.Samplers)
+                samplers.push_back({ handle, desc, {} });
+        }
+    }
+
+    if (samplers.empty())
+        return;
+
+    State::Instance().lastMipBias = 100.0f;
+    State::Instance().lastMipBiasMax = -100.0f;
+
+    for (auto& sampler : samplers)
+        PatchDesc(config, &sampler.Original, &sampler.Patched);
+
+    size_t count = 0;
+
+    {
+        std::unique_lock<std::shared_mutex> lock(_mutex);
+
+        // Only CPU only heaps are tracked, GPU doesn't read descriptors we write here
+        // Handles which were rewritten or copied over meanwhile are skipped, they are patched already
+        for (auto& sampler : samplers)
+        {
+            auto heap = FindHeap(sampler.Handle);
+            if (heap == nullptr)
+                continue;
+
+            auto& shard = Shard(sampler.Handle);
+            auto it = shard.Samplers.find(sampler.Handle);
+
+            if (it == shard.Samplers.end() || memcmp(&it->second, &sampler.Original, sizeof(D3D12_SAMPLER_DESC)) != 0)
+                continue;
+
+            _createSampler(heap->Device, &sampler.Patched, { sampler.Handle });
+            count++;
+        }
+    }
+
+    LOG_INFO("Recreated {0} samplers, render scale: {1:.3f}", count, renderScale);
+}
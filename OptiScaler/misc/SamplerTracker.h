@@ -0,0 +1,127 @@
+#pragma once
+#include <pch.h>
+
+#include <Config.h>
+
+#include <d3d11.h>
+#include <d3d12.h>
+#include <ankerl/unordered_dense.h>
+
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+// Mipmap bias & anisotropy overrides of game samplers
+// Dx12 sampler descriptors of CPU only (not shader visible) heaps are kept with their original desc and
+// recreated in place when bias settings or render scale (with MipmapBiasAuto) change.
+// GPU never reads these heaps, new values reach shader visible heaps with game's next copy.
+// Samplers created directly in shader visible heaps are only patched at creation.
+// Tracking is only enabled when a mipmap bias override is active while hooking the device,
+// otherwise sampler copies are not hooked at all.
+class SamplerTracker
+{
+public:
+    typedef void(*PFN_CreateSampler)(ID3D12Device* device, const D3D12_SAMPLER_DESC* pDesc, D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptor);
+    typedef void(*PFN_CopyDescriptors)(ID3D12Device* This, UINT NumDestDescriptorRanges, D3D12_CPU_DESCRIPTOR_HANDLE* pDestDescriptorRangeStarts, UINT* pDestDescriptorRangeSizes, UINT NumSrcDescriptorRanges, D3D12_CPU_DESCRIPTOR_HANDLE* pSrcDescriptorRangeStarts, UINT* pSrcDescriptorRangeSizes, D3D12_DESCRIPTOR_HEAP_TYPE DescriptorHeapsType);
+    typedef void(*PFN_CopyDescriptorsSimple)(ID3D12Device* This, UINT NumDescriptors, D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptorRangeStart, D3D12_CPU_DESCRIPTOR_HANDLE SrcDescriptorRangeStart, D3D12_DESCRIPTOR_HEAP_TYPE DescriptorHeapsType);
+
+private:
+    // Heaps are not referenced, they are removed with their samplers by destruction callback
+    struct HeapInfo
+    {
+        ID3D12Device* Device = nullptr;
+        ID3D12DescriptorHeap* Heap = nullptr;
+        SIZE_T CpuStart = 0;
+        SIZE_T CpuEnd = 0;
+    };
+
+    // Inputs of bias calculation, samplers are recreated when one changes
+    struct BiasSettings
+    {
+        bool HasOverride = false;
+        float Override = 0.0f;
+        bool Fixed = false;
+        bool Scale = false;
+        bool All = false;
+        bool Auto = false;
+        float AutoOffset = 0.0f;
+        float AutoBias = 0.0f;
+
+        bool operator==(const BiasSettings&) const = default;
+    };
+
+    // Tracked descs are split by handle, copies on different threads rarely wait for each other
+    struct SamplerShard
+    {
+        std::mutex Mutex;
+        ankerl::unordered_dense::map<SIZE_T, D3D12_SAMPLER_DESC> Samplers;
+    };
+
+    static constexpr size_t ShardCount = 16;
+
+    // Heaps change rarely, copies & tracking take it shared
+    // Update takes it exclusive only while writing descriptors, copies never read a half written one
+    static inline std::shared_mutex _mutex;
+    static inline std::vector<HeapInfo> _heaps;
+    static inline std::atomic<size_t> _heapCount = 0;
+    static inline SamplerShard _shards[ShardCount];
+    static inline PFN_CreateSampler _createSampler = nullptr;
+    static inline bool _tracking = false;
+
+    static inline std::atomic<float> _renderScale = 1.0f;
+    static inline BiasSettings _lastSettings{};
+
+    static void UpdateMipBiasState(float InBias);
+
+    // Descriptor handles are at least 16 bytes apart
+    static SamplerShard& Shard(SIZE_T InHandle) { return _shards[(InHandle >> 4) % ShardCount]; }
+
+    // Must be called with _mutex locked
+    static HeapInfo* FindHeap(SIZE_T InHandle);
+    static void CopyTracked(SIZE_T InDest, SIZE_T InSrc);
+
+    static void WINAPI HeapDestroyed(void* InHeap);
+
+public:
+    // Bias of a sampler which is selected for override (< 0 or MipmapBiasOverrideAll), false when it's kept
+    static bool OverrideBias(const ConfigSnapshot* InConfig, float InBias, float* OutBias);
+
+    static void PatchDesc(const ConfigSnapshot* InConfig, const D3D12_SAMPLER_DESC* InDesc, D3D12_SAMPLER_DESC* OutDesc);
+    static void PatchDesc(const ConfigSnapshot* InConfig, const D3D11_SAMPLER_DESC* InDesc, D3D11_SAMPLER_DESC* OutDesc);
+    static void PatchDesc(const ConfigSnapshot* InConfig, D3D12_STATIC_SAMPLER_DESC* InOutDesc);
+
+    // Auto bias is rounded to this step, render scale changes of DRS don't recreate samplers every frame
+    static constexpr float AutoBiasStep = 0.05f;
+
+    // InCreateSampler should be the original (not hooked) function
+    static void SetCreateSampler(PFN_CreateSampler InCreateSampler) { _createSampler = InCreateSampler; }
+
+    // True when samplers need to follow bias changes, decides if copy hooks are attached
+    static bool ShouldTrack(const ConfigSnapshot* InConfig) { return InConfig->HasMipmapBiasOverride || InConfig->MipmapBiasAuto; }
+
+    // Set once while hooking device, before any sampler is created
+    static void SetTracking(bool InTracking) { _tracking = InTracking; }
+    static bool IsTracking() { return _tracking; }
+
+    static void RegisterHeap(ID3D12Device* InDevice, ID3D12DescriptorHeap* InHeap, const D3D12_DESCRIPTOR_HEAP_DESC* InDesc);
+    static void Track(const D3D12_SAMPLER_DESC* InDesc, D3D12_CPU_DESCRIPTOR_HANDLE InHandle);
+
+    // Calls InCopy for sampler copies & moves tracked descs with them
+    // Copies run in parallel, only Update's descriptor writes block them
+    static void CopyDescriptors(PFN_CopyDescriptors InCopy, ID3D12Device* InDevice,
+                                UINT InNumDestRanges, D3D12_CPU_DESCRIPTOR_HANDLE* InDestStarts, UINT* InDestSizes,
+                                UINT InNumSrcRanges, D3D12_CPU_DESCRIPTOR_HANDLE* InSrcStarts, UINT* InSrcSizes);
+    static void CopyDescriptorsSimple(PFN_CopyDescriptorsSimple InCopy, ID3D12Device* InDevice, UINT InCount,
+                                      D3D12_CPU_DESCRIPTOR_HANDLE InDest, D3D12_CPU_DESCRIPTOR_HANDLE InSrc);
+
+    // Render / display width of current feature, updated once per present
+    static float RenderScale() { return _renderScale; }
+
+    // log2(RenderScale) + MipmapBiasAutoOffset rounded to AutoBiasStep
+    static float AutoBias(const ConfigSnapshot* InConfig) { return std::round((std::log2(RenderScale()) + InConfig->MipmapBiasAutoOffset) / AutoBiasStep) * AutoBiasStep; }
+
+    // Called once per present, recreates tracked samplers when bias inputs change
+    static void Update();
+};
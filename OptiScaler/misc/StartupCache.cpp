@@ -0,0 +1,316 @@
+#include "StartupCache.h"
+
+#include "GameProfile.h"
+
+#include <Config.h>
+
+#include <fstream>
+
+constexpr uint32_t CacheMagic = 0x43535043; // CPSC
+constexpr uint32_t CacheFormatVersion = 1;
+
+bool StartupCache::IsEnabled()
+{
+    return Config::Instance()->UseStartupCache.value_or_default();
+}
+
+std::filesystem::path StartupCache::CachePath()
+{
+    return Util::DllPath().parent_path() / "OptiScaler_Startup.bin";
+}
+
+uint64_t StartupCache::WriteTime(const std::wstring& InPath, uint64_t* OutSize)
+{
+    WIN32_FILE_ATTRIBUTE_DATA attributes{};
+
+    if (!GetFileAttributesExW(InPath.c_str(), GetFileExInfoStandard, &attributes))
+        return 0;
+
+    if (OutSize != nullptr)
+        *OutSize = ((uint64_t)attributes.nFileSizeHigh << 32) | attributes.nFileSizeLow;
+
+    return ((uint64_t)attributes.ftLastWriteTime.dwHighDateTime << 32) | attributes.ftLastWriteTime.dwLowDateTime;
+}
+
+uint64_t StartupCache::DriverHash()
+{
+    // Display adapter class, every adapter has a numbered subkey with its driver info
+    HKEY classKey = nullptr;
+
+    if (RegOpenKeyExW(HKEY_LOCAL_MACHINE, L"SYSTEM\\CurrentControlSet\\Control\\Class\\{4d36e968-e325-11ce-bfc1-08002be10318}", 0, KEY_READ, &classKey) != ERROR_SUCCESS)
+        return 0;
+
+    uint64_t hash = 14695981039346656037ull;
+    wchar_t subKey[64];
+
+    for (DWORD i = 0;; i++)
+    {
+        DWORD subKeySize = ARRAYSIZE(subKey);
+
+        if (RegEnumKeyExW(classKey, i, subKey, &subKeySize, nullptr, nullptr, nullptr, nullptr) != ERROR_SUCCESS)
+            break;
+
+        for (auto valueName : { L"DriverVersion", L"DriverDesc" })
+        {
+            wchar_t value[256];
+            DWORD valueSize = sizeof(value);
+
+            if (RegGetValueW(classKey, subKey, valueName, RRF_RT_REG_SZ, nullptr, value, &valueSize) != ERROR_SUCCESS)
+                continue;
+
+            for (size_t c = 0; c < valueSize / sizeof(wchar_t) && value[c] != 0; c++)
+                hash = (hash ^ value[c]) * 1099511628211ull;
+        }
+    }
+
+    RegCloseKey(classKey);
+
+    return hash;
+}
+
+void StartupCache::Load()
+{
+    if (_loaded)
+        return;
+
+    _loaded = true;
+
+    _data = {};
+    _data.Magic = CacheMagic;
+    _data.FormatVersion = CacheFormatVersion;
+    _data.ExeHash = GameProfile::ExeHash();
+    _data.ExeWriteTime = WriteTime(Util::ExePath().wstring());
+    _data.DriverHash = DriverHash();
+
+    auto path = CachePath();
+    auto file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        LOG_DEBUG("No cache file at {0}", path.string());
+        _dirty = true;
+        return;
+    }
+
+    LARGE_INTEGER size{};
+    HANDLE mapping = nullptr;
+    const Data* view = nullptr;
+
+    if (GetFileSizeEx(file, &size) && size.QuadPart == sizeof(Data))
+        mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+    if (mapping != nullptr)
+        view = (const Data*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, sizeof(Data));
+
+    if (view != nullptr && view->Magic == _data.Magic && view->FormatVersion == _data.FormatVersion && view->ExeHash == _data.ExeHash &&
+        view->ExeWriteTime == _data.ExeWriteTime && view->DriverHash == _data.DriverHash)
+    {
+        memcpy(&_data, view, sizeof(Data));
+        LOG_INFO("Loaded startup cache, {0} DLL versions", _data.DllVersionCount);
+    }
+    else
+    {
+        LOG_INFO("Startup cache is outdated, probing again");
+        _dirty = true;
+    }
+
+    if (view != nullptr)
+        UnmapViewOfFile(view);
+
+    if (mapping != nullptr)
+        CloseHandle(mapping);
+
+    CloseHandle(file);
+}
+
+std::optional<bool> StartupCache::Fsr4Update()
+{
+    if (!IsEnabled())
+        return std::nullopt;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    Load();
+
+    if (_data.HasFsr4Update == 0)
+        return std::nullopt;
+
+    return _data.Fsr4Update != 0;
+}
+
+void StartupCache::SetFsr4Update(bool InValue)
+{
+    if (!IsEnabled())
+        return;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    Load();
+
+    _data.HasFsr4Update = 1;
+    _data.Fsr4Update = InValue ? 1 : 0;
+    _dirty = true;
+}
+
+std::optional<std::vector<std::filesystem::path>> StartupCache::DriverStore()
+{
+    if (!IsEnabled())
+        return std::nullopt;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    Load();
+
+    if (_data.HasDriverStore == 0)
+        return std::nullopt;
+
+    std::vector<std::filesystem::path> result;
+
+    for (uint32_t i = 0; i < _data.DriverStoreCount && i < MaxDriverStores; i++)
+    {
+        std::filesystem::path path(_data.DriverStore[i]);
+
+        // Folder is removed after a driver update which didn't change version strings
+        if (!std::filesystem::exists(path))
+        {
+            _data.HasDriverStore = 0;
+            return std::nullopt;
+        }
+
+        result.push_back(path);
+    }
+
+    return result;
+}
+
+void StartupCache::SetDriverStore(const std::vector<std::filesystem::path>& InPaths)
+{
+    if (!IsEnabled() || InPaths.empty())
+        return;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    Load();
+
+    _data.DriverStoreCount = 0;
+
+    for (auto& path : InPaths)
+    {
+        auto pathStr = path.wstring();
+
+        if (_data.DriverStoreCount >= MaxDriverStores || pathStr.size() >= MAX_PATH)
+            break;
+
+        wcscpy_s(_data.DriverStore[_data.DriverStoreCount++], pathStr.c_str());
+    }
+
+    _data.HasDriverStore = 1;
+    _dirty = true;
+}
+
+std::optional<bool> StartupCache::DllVersion(const std::wstring& InPath, Util::version_t* OutVersion)
+{
+    if (!IsEnabled())
+        return std::nullopt;
+
+    uint64_t size = 0;
+    auto writeTime = WriteTime(InPath, &size);
+
+    if (writeTime == 0)
+        return std::nullopt;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    Load();
+
+    for (uint32_t i = 0; i < _data.DllVersionCount; i++)
+    {
+        auto& entry = _data.DllVersions[i];
+
+        if (_wcsicmp(entry.Path, InPath.c_str()) != 0)
+            continue;
+
+        if (entry.WriteTime != writeTime || entry.FileSize != size)
+            return std::nullopt;
+
+        if (OutVersion != nullptr)
+            *OutVersion = entry.Version;
+
+        return entry.Found != 0;
+    }
+
+    return std::nullopt;
+}
+
+void StartupCache::SetDllVersion(const std::wstring& InPath, bool InFound, const Util::version_t& InVersion)
+{
+    if (!IsEnabled() || InPath.size() >= MAX_PATH)
+        return;
+
+    uint64_t size = 0;
+    auto writeTime = WriteTime(InPath, &size);
+
+    if (writeTime == 0)
+        return;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    Load();
+
+    DllVersionEntry* entry = nullptr;
+
+    for (uint32_t i = 0; i < _data.DllVersionCount; i++)
+    {
+        if (_wcsicmp(_data.DllVersions[i].Path, InPath.c_str()) == 0)
+        {
+            entry = &_data.DllVersions[i];
+            break;
+        }
+    }
+
+    if (entry == nullptr)
+    {
+        if (_data.DllVersionCount >= MaxDllVersions)
+            return;
+
+        entry = &_data.DllVersions[_data.DllVersionCount++];
+        wcscpy_s(entry->Path, InPath.c_str());
+    }
+
+    entry->WriteTime = writeTime;
+    entry->FileSize = size;
+    entry->Version = InVersion;
+    entry->Found = InFound ? 1 : 0;
+    _dirty = true;
+}
+
+void StartupCache::Flush()
+{
+    if (!IsEnabled())
+        return;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (!_loaded || !_dirty)
+        return;
+
+    auto path = CachePath();
+    auto tempPath = path;
+    tempPath += ".tmp";
+
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open() || !file.write((const char*)&_data, sizeof(Data)))
+        {
+            LOG_ERROR("Can't write {0}", tempPath.string());
+            return;
+        }
+    }
+
+    // Replace old file only after new one is completely written
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+
+    if (ec)
+    {
+        LOG_ERROR("Can't replace {0}: {1}", path.string(), ec.message());
+        return;
+    }
+
+    _dirty = false;
+    LOG_INFO("Saved startup cache to {0}", path.string());
+}
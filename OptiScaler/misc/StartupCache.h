@@ -0,0 +1,74 @@
+#pragma once
+#include <pch.h>
+
+#include <Util.h>
+
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+// Results of slow startup probing (GPU detection, driver store & DLL versions)
+// Kept in a fixed layout binary file next to dll, which is mapped and validated on first use
+// Whole cache is dropped when game exe or display driver changes, DLL versions are also checked against file time & size
+class StartupCache
+{
+    static constexpr uint32_t MaxDriverStores = 4;
+    static constexpr uint32_t MaxDllVersions = 32;
+
+    struct DllVersionEntry
+    {
+        wchar_t Path[MAX_PATH];
+        uint64_t WriteTime;
+        uint64_t FileSize;
+        Util::version_t Version;
+        uint32_t Found;
+    };
+
+    struct Data
+    {
+        uint32_t Magic;
+        uint32_t FormatVersion;
+        uint64_t ExeHash;
+        uint64_t ExeWriteTime;
+        uint64_t DriverHash;
+
+        uint32_t HasFsr4Update;
+        uint32_t Fsr4Update;
+
+        uint32_t HasDriverStore;
+        uint32_t DriverStoreCount;
+        wchar_t DriverStore[MaxDriverStores][MAX_PATH];
+
+        uint32_t DllVersionCount;
+        uint32_t Padding;
+        DllVersionEntry DllVersions[MaxDllVersions];
+    };
+
+    static inline std::mutex _mutex;
+    static inline Data _data{};
+    static inline bool _loaded = false;
+    static inline bool _dirty = false;
+
+    static bool IsEnabled();
+    static std::filesystem::path CachePath();
+    static uint64_t WriteTime(const std::wstring& InPath, uint64_t* OutSize = nullptr);
+    static uint64_t DriverHash();
+
+    // Should be called with _mutex locked
+    static void Load();
+
+public:
+    static std::optional<bool> Fsr4Update();
+    static void SetFsr4Update(bool InValue);
+
+    static std::optional<std::vector<std::filesystem::path>> DriverStore();
+    static void SetDriverStore(const std::vector<std::filesystem::path>& InPaths);
+
+    // Returns nullopt when InPath is not cached or changed, otherwise if it had version info
+    static std::optional<bool> DllVersion(const std::wstring& InPath, Util::version_t* OutVersion);
+    static void SetDllVersion(const std::wstring& InPath, bool InFound, const Util::version_t& InVersion);
+
+    // Writes cache file when something new is added
+    static void Flush();
+};
@@ -0,0 +1,180 @@
+#include "StartupProfiler.h"
+
+#include "Trace.h"
+
+#include <Util.h>
+
+static int64_t Frequency()
+{
+    static int64_t frequency = 0;
+
+    if (frequency == 0)
+    {
+        LARGE_INTEGER value;
+        QueryPerformanceFrequency(&value);
+        frequency = value.QuadPart;
+    }
+
+    return frequency;
+}
+
+static uint64_t FileTimeToUInt64(const FILETIME& InTime)
+{
+    return ((uint64_t)InTime.dwHighDateTime << 32) | InTime.dwLowDateTime;
+}
+
+int64_t StartupProfiler::Now()
+{
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return counter.QuadPart;
+}
+
+double StartupProfiler::ToMs(int64_t InTicks)
+{
+    return (double)InTicks * 1000.0 / (double)Frequency();
+}
+
+void StartupProfiler::Begin()
+{
+    if (_origin != 0)
+        return;
+
+    _origin = Now();
+    _rootChildTicks = 0;
+
+    FILETIME creation, exit, kernel, user, now;
+
+    // Logger isn't ready at this point, only store it
+    if (GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user))
+    {
+        GetSystemTimePreciseAsFileTime(&now);
+        _processAgeMs = (double)(FileTimeToUInt64(now) - FileTimeToUInt64(creation)) / 10000.0;
+    }
+}
+
+void StartupProfiler::EndAttach()
+{
+    if (_origin != 0)
+        Add(StartupPhase::DllAttach, _origin, Now(), _rootChildTicks);
+}
+
+void StartupProfiler::Add(StartupPhase InPhase, int64_t InStart, int64_t InEnd, int64_t InChildTicks)
+{
+    if (InPhase >= StartupPhase::Count || IsFinished())
+        return;
+
+    auto& phase = _phases[(uint32_t)InPhase];
+
+    // Only first call of these is recorded
+    if (InPhase == StartupPhase::FirstCreateFeature || InPhase == StartupPhase::FirstEvaluate)
+    {
+        uint32_t expected = 0;
+
+        if (!phase.Calls.compare_exchange_strong(expected, 1))
+            return;
+    }
+    else if (phase.Calls.fetch_add(1) != 0)
+    {
+        phase.Total += InEnd - InStart;
+        phase.Self += InEnd - InStart - InChildTicks;
+        return;
+    }
+
+    phase.FirstStart = InStart;
+    phase.FirstEnd = InEnd;
+    phase.ThreadId = GetCurrentThreadId();
+    phase.Total += InEnd - InStart;
+    phase.Self += InEnd - InStart - InChildTicks;
+}
+
+void StartupProfiler::Finish()
+{
+    _finished = true;
+}
+
+void StartupProfiler::NewFrame()
+{
+    if (!IsFinished() || _logged.load(std::memory_order_relaxed))
+        return;
+
+    bool expected = false;
+
+    if (!_logged.compare_exchange_strong(expected, true))
+        return;
+
+    LogSummary();
+}
+
+bool StartupProfiler::GetStats(StartupPhase InPhase, StartupPhaseStats* OutStats)
+{
+    if (OutStats == nullptr || InPhase >= StartupPhase::Count)
+        return false;
+
+    auto& phase = _phases[(uint32_t)InPhase];
+    auto calls = phase.Calls.load();
+
+    if (calls == 0)
+        return false;
+
+    OutStats->StartMs = ToMs(phase.FirstStart - _origin);
+    OutStats->DurationMs = ToMs(phase.Total);
+    OutStats->SelfMs = ToMs(phase.Self);
+    OutStats->Calls = calls;
+
+    return true;
+}
+
+void StartupProfiler::LogSummary()
+{
+    LOG_INFO("Startup timeline, process was running for {0:.1f} ms before attach", _processAgeMs);
+    LOG_INFO("  {0:<20} {1:>10} {2:>12} {3:>10} {4:>6}", "Phase", "Start ms", "Duration ms", "Self ms", "Calls");
+
+    for (uint32_t i = 0; i < (uint32_t)StartupPhase::Count; i++)
+    {
+        StartupPhaseStats stats{};
+
+        if (!GetStats((StartupPhase)i, &stats))
+            continue;
+
+        LOG_INFO("  {0:<20} {1:>10.2f} {2:>12.2f} {3:>10.2f} {4:>6}", StartupPhaseName((StartupPhase)i), stats.StartMs, stats.DurationMs,
+                 stats.SelfMs, stats.Calls);
+    }
+}
+
+bool StartupProfiler::WriteTrace()
+{
+    int64_t origin = _origin;
+
+    if (origin == 0)
+        return false;
+
+    auto path = Util::DllPath().parent_path() / std::format("OptiScaler_startup_{0}.json", origin);
+
+    TraceJsonWriter writer;
+
+    if (!writer.Open(path))
+        return false;
+
+    auto toUs = [origin](int64_t InTime) { return ToMs(InTime - origin) * 1000.0; };
+
+    writer.ProcessName(1, "OptiScaler Startup");
+
+    for (uint32_t i = 0; i < (uint32_t)StartupPhase::Count; i++)
+    {
+        auto& phase = _phases[i];
+
+        if (phase.Calls == 0)
+            continue;
+
+        writer.Complete(StartupPhaseName((StartupPhase)i), "startup", 1, phase.ThreadId.load(), toUs(phase.FirstStart),
+                        toUs(phase.FirstEnd) - toUs(phase.FirstStart),
+                        std::format("\"calls\":{0},\"totalMs\":{1:.3f},\"selfMs\":{2:.3f}", phase.Calls.load(), ToMs(phase.Total), ToMs(phase.Self)));
+    }
+
+    writer.Close();
+
+    LOG_INFO("Wrote startup timeline to {0}", path.string());
+
+    return true;
+}
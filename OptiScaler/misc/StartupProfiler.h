@@ -0,0 +1,143 @@
+#pragma once
+#include <pch.h>
+
+#include <atomic>
+
+enum class StartupPhase : uint32_t
+{
+    DllAttach,          // Whole DLL_PROCESS_ATTACH, includes most of the phases below
+    ConfigLoad,
+    PrepareLogger,
+    GpuDetection,       // isNvidia & CheckForGPU
+    DriverStore,
+    WorkingMode,        // CheckWorkingMode, loads original dll when OptiScaler is a proxy
+    ModuleHooks,        // Export hooks of d3d, dxgi & vulkan dlls
+    AttachHooks,
+    LoadHooks,          // LoadLibrary calls for dlls OptiScaler hooks, includes the load
+    ProxyLoad,          // Loading real nvngx, ffx & xess dlls
+    FirstCreateFeature,
+    FirstEvaluate,
+    Count
+};
+
+inline const char* StartupPhaseName(StartupPhase InPhase)
+{
+    static const char* phaseNames[] = { "Dll Attach", "Config Load", "Prepare Logger", "GPU Detection", "Driver Store", "Working Mode",
+                                        "Module Hooks", "Attach Hooks", "Load Hooks", "Proxy Load", "First CreateFeature", "First Evaluate" };
+
+    if (InPhase >= StartupPhase::Count)
+        return "Unknown";
+
+    return phaseNames[(uint32_t)InPhase];
+}
+
+struct StartupPhaseStats
+{
+    double StartMs = 0.0;       // From start of dll attach, config might be loaded before it
+    double DurationMs = 0.0;    // Total of all calls
+    double SelfMs = 0.0;        // Total without nested phases of same thread
+    uint32_t Calls = 0;
+};
+
+// QueryPerformanceCounter timeline of startup, from dll attach until first upscaled frame
+// Summary is logged when first upscaled frame is presented, shown in menu & can be saved as Chrome trace json
+class StartupProfiler
+{
+    struct Phase
+    {
+        std::atomic<int64_t> FirstStart = 0;
+        std::atomic<int64_t> FirstEnd = 0;
+        std::atomic<int64_t> Total = 0;
+        std::atomic<int64_t> Self = 0;
+        std::atomic<uint32_t> Calls = 0;
+        std::atomic<uint32_t> ThreadId = 0;
+    };
+
+    static inline Phase _phases[(uint32_t)StartupPhase::Count];
+    static inline std::atomic<int64_t> _origin = 0;
+    static inline std::atomic<bool> _finished = false;
+    static inline std::atomic<bool> _logged = false;
+    static inline double _processAgeMs = 0.0;
+
+    // Time of outermost zones on this thread, DllAttach's nested phases on attach thread
+    static inline thread_local int64_t _rootChildTicks = 0;
+
+    static double ToMs(int64_t InTicks);
+    static void LogSummary();
+
+public:
+    // Stops recording after first evaluate, later calls of phases are not startup cost
+    static bool IsFinished() { return _finished.load(std::memory_order_relaxed); }
+
+    static int64_t Now();
+
+    // Sets origin of timeline, called at start of dll attach
+    static void Begin();
+
+    // Records DllAttach phase from Begin until now
+    static void EndAttach();
+
+    // InStart & InEnd are QueryPerformanceCounter values, InChildTicks is time of nested phases
+    static void Add(StartupPhase InPhase, int64_t InStart, int64_t InEnd, int64_t InChildTicks);
+
+    // Adds time of a zone which isn't nested in another one
+    static void AddRoot(int64_t InTicks) { _rootChildTicks += InTicks; }
+
+    // Stops recording, called after first evaluate
+    static void Finish();
+
+    // Called once per present, logs the summary at first present after Finish
+    static void NewFrame();
+
+    static bool GetStats(StartupPhase InPhase, StartupPhaseStats* OutStats);
+
+    // Time between process creation and dll attach
+    static double ProcessAgeMs() { return _processAgeMs; }
+
+    // Writes first call of each phase next to OptiScaler, returns false on failure
+    static bool WriteTrace();
+};
+
+// Records duration of enclosing scope as InPhase until startup is finished
+// First* phases only record their first call, nested zones are subtracted from self time of enclosing one
+class StartupZone
+{
+    StartupPhase _phase;
+    int64_t _start = 0;
+    int64_t _childTicks = 0;
+    StartupZone* _parent = nullptr;
+
+    static inline thread_local StartupZone* _current = nullptr;
+
+public:
+    StartupZone(StartupPhase InPhase) : _phase(InPhase)
+    {
+        if (StartupProfiler::IsFinished())
+            return;
+
+        _start = StartupProfiler::Now();
+        _parent = _current;
+        _current = this;
+    }
+
+    ~StartupZone()
+    {
+        if (_start == 0)
+            return;
+
+        _current = _parent;
+
+        auto end = StartupProfiler::Now();
+        StartupProfiler::Add(_phase, _start, end, _childTicks);
+
+        if (_parent != nullptr)
+            _parent->_childTicks += end - _start;
+        else
+            StartupProfiler::AddRoot(end - _start);
+
+        if (_phase == StartupPhase::FirstEvaluate)
+            StartupProfiler::Finish();
+    }
+};
+
+#define STARTUP_ZONE(phase) StartupZone _startupZone(phase)
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <deque>
+#include <numeric>
+#include <stddef.h>
+#include <stdint.h>
+
+// Fixed size window of frame or pass times with running sums, used for menu averages & plots
+// Only depends on standard headers so it can be tested without Windows SDK (tools/TimeWindowTest)
+struct TimeWindow
+{
+    // Running sums are recomputed from values every this many adds, so rounding errors of spikes can't build up
+    static constexpr uint32_t RecomputeInterval = 1024;
+
+    std::deque<double> Values;
+    double Sum = 0.0;
+
+    // Last RecentSize values which are not zero, for displayed fps
+    size_t RecentSize = 0;
+    double RecentSum = 0.0;
+    uint32_t RecentCount = 0;
+
+    uint32_t AddCount = 0;
+
+    TimeWindow(size_t InRecentSize = 0) : RecentSize(InRecentSize) {}
+
+    // Fills window with InSize zeros
+    void Reset(size_t InSize)
+    {
+        Values.assign(InSize, 0.0);
+        Sum = 0.0;
+        RecentSum = 0.0;
+        RecentCount = 0;
+        AddCount = 0;
+    }
+
+    void Add(double InValue)
+    {
+        if (Values.empty())
+            return;
+
+        if (RecentSize > 0 && RecentSize <= Values.size())
+        {
+            // Leaves the recent window
+            auto oldRecent = Values[Values.size() - RecentSize];
+
+            if (oldRecent > 0.0)
+            {
+                RecentSum -= oldRecent;
+                RecentCount--;
+            }
+
+            if (InValue > 0.0)
+            {
+                RecentSum += InValue;
+                RecentCount++;
+            }
+        }
+
+        Sum += InValue - Values.front();
+        Values.pop_front();
+        Values.push_back(InValue);
+
+        if (++AddCount % RecomputeInterval == 0)
+            Recompute();
+    }
+
+    void Recompute()
+    {
+        Sum = std::accumulate(Values.begin(), Values.end(), 0.0);
+        RecentSum = 0.0;
+        RecentCount = 0;
+
+        if (RecentSize == 0 || RecentSize > Values.size())
+            return;
+
+        for (auto it = Values.end() - (ptrdiff_t)RecentSize; it != Values.end(); ++it)
+        {
+            if (*it > 0.0)
+            {
+                RecentSum += *it;
+                RecentCount++;
+            }
+        }
+    }
+
+    double Last() const { return Values.empty() ? 0.0 : Values.back(); }
+    double Average() const { return Values.empty() ? 0.0 : Sum / Values.size(); }
+
+    // Returns 0 when there is no recent value
+    double RecentAverage() const { return RecentCount > 0 ? RecentSum / RecentCount : 0.0; }
+};
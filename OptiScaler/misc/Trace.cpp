@@ -0,0 +1,342 @@
+#include "Trace.h"
+
+#include <Util.h>
+
+#include <mutex>
+#include <thread>
+
+struct TraceEvent
+{
+    const char* Name;
+    int64_t Start;
+    int64_t End;
+    Trace::Track Track;
+};
+
+// Only owner thread writes events, count is published after event is written
+struct TraceThreadBuffer
+{
+    static const uint32_t Capacity = 65536;
+
+    uint32_t ThreadId = 0;
+    std::atomic<uint32_t> Generation = 0;
+    std::atomic<uint32_t> Count = 0;
+    std::atomic<uint32_t> Dropped = 0;
+    std::atomic<bool> Exited = false;    // Owner thread is gone, buffer is recycled after next write
+    std::unique_ptr<TraceEvent[]> Events;
+};
+
+// Set when owner of thread's buffer is destroyed, it's trivially destructible so it can be read after that
+static thread_local bool threadExiting = false;
+
+// Marks buffer of an exiting thread, thread_local destructors run on thread exit
+struct TraceThreadOwner
+{
+    TraceThreadBuffer* Buffer = nullptr;
+
+    ~TraceThreadOwner()
+    {
+        threadExiting = true;
+
+        if (Buffer != nullptr)
+            Buffer->Exited.store(true, std::memory_order_release);
+
+        Buffer = nullptr;
+    }
+};
+
+static const char* TrackNames[] = { "cpu", "lock wait", "lock hold", "gpu", "frame" };
+
+// Buffers of exited threads are moved to freeBuffers after their events are written, new threads reuse them
+// A buffer is never removed while it might be written to file
+static const size_t MaxFreeBuffers = 8;
+static std::mutex buffersMutex;
+static std::vector<std::unique_ptr<TraceThreadBuffer>> buffers;
+static std::vector<std::unique_ptr<TraceThreadBuffer>> freeBuffers;
+static thread_local TraceThreadOwner threadBuffer;
+
+static TraceThreadBuffer* GetThreadBuffer()
+{
+    if (threadBuffer.Buffer != nullptr)
+        return threadBuffer.Buffer;
+
+    std::lock_guard<std::mutex> lock(buffersMutex);
+
+    std::unique_ptr<TraceThreadBuffer> buffer;
+
+    if (!freeBuffers.empty())
+    {
+        buffer = std::move(freeBuffers.back());
+        freeBuffers.pop_back();
+
+        buffer->Generation.store(0, std::memory_order_relaxed);
+        buffer->Count.store(0, std::memory_order_relaxed);
+        buffer->Dropped.store(0, std::memory_order_relaxed);
+        buffer->Exited.store(false, std::memory_order_relaxed);
+    }
+    else
+    {
+        buffer = std::make_unique<TraceThreadBuffer>();
+        buffer->Events = std::make_unique<TraceEvent[]>(TraceThreadBuffer::Capacity);
+    }
+
+    buffer->ThreadId = GetCurrentThreadId();
+    threadBuffer.Buffer = buffer.get();
+    buffers.push_back(std::move(buffer));
+
+    return threadBuffer.Buffer;
+}
+
+// Called by writer after every buffer is written, no capture can run until it's done
+static void RecycleExitedBuffers()
+{
+    std::lock_guard<std::mutex> lock(buffersMutex);
+
+    for (size_t i = 0; i < buffers.size();)
+    {
+        auto& buffer = buffers[i];
+
+        if (!buffer->Exited.load(std::memory_order_acquire))
+        {
+            i++;
+            continue;
+        }
+
+        if (freeBuffers.size() < MaxFreeBuffers)
+            freeBuffers.push_back(std::move(buffer));
+
+        buffers.erase(buffers.begin() + i);
+    }
+}
+
+int64_t Trace::Now()
+{
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return counter.QuadPart;
+}
+
+int64_t Trace::Frequency()
+{
+    auto frequency = _frequency.load(std::memory_order_relaxed);
+
+    // Every thread would store the same value, no need to synchronize first call
+    if (frequency == 0)
+    {
+        LARGE_INTEGER counterFrequency;
+        QueryPerformanceFrequency(&counterFrequency);
+        frequency = counterFrequency.QuadPart;
+        _frequency.store(frequency, std::memory_order_relaxed);
+    }
+
+    return frequency;
+}
+
+bool Trace::Start(int32_t InFrames)
+{
+    if (_capturing || _writing || InFrames <= 0)
+        return false;
+
+    Frequency();
+
+    _startTime = Now();
+    _lastFrameTime = 0;
+    _framesLeft = InFrames;
+    _generation++;
+    _capturing = true;
+
+    LOG_INFO("Capturing trace for {0} frames", InFrames);
+
+    return true;
+}
+
+void Trace::Stop()
+{
+    bool expected = true;
+
+    if (!_capturing.compare_exchange_strong(expected, false))
+        return;
+
+    _writing = true;
+
+    auto generation = _generation.load();
+    auto endTime = Now();
+
+    // Threads which passed IsCapturing check might still be adding events, writer only reads published ones
+    std::thread(&Trace::Write, generation, endTime).detach();
+}
+
+void Trace::NewFrame()
+{
+    if (!IsCapturing())
+        return;
+
+    auto now = Now();
+
+    if (_lastFrameTime != 0)
+        AddEvent("Frame", Track::Frame, _lastFrameTime, now);
+
+    _lastFrameTime = now;
+
+    if (--_framesLeft <= 0)
+        Stop();
+}
+
+void Trace::AddEvent(const char* InName, Track InTrack, int64_t InStart, int64_t InEnd)
+{
+    // A new buffer of an exiting thread would never be marked exited & recycled
+    if (threadExiting)
+        return;
+
+    auto buffer = GetThreadBuffer();
+    auto generation = _generation.load(std::memory_order_relaxed);
+
+    // First event of a new capture on this thread
+    if (buffer->Generation.load(std::memory_order_relaxed) != generation)
+    {
+        buffer->Dropped.store(0, std::memory_order_relaxed);
+        buffer->Count.store(0, std::memory_order_relaxed);
+        buffer->Generation.store(generation, std::memory_order_release);
+    }
+
+    auto count = buffer->Count.load(std::memory_order_relaxed);
+
+    if (count >= TraceThreadBuffer::Capacity)
+    {
+        buffer->Dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    buffer->Events[count] = { InName, InStart, InEnd, InTrack };
+    buffer->Count.store(count + 1, std::memory_order_release);
+}
+
+bool TraceJsonWriter::Open(const std::filesystem::path& InPath)
+{
+    _file.open(InPath, std::ios::trunc);
+
+    if (!_file.is_open())
+    {
+        LOG_ERROR("Can't create {0}", InPath.string());
+        return false;
+    }
+
+    _file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    _empty = true;
+
+    return true;
+}
+
+const char* TraceJsonWriter::Separator()
+{
+    if (!_empty)
+        return ",\n";
+
+    _empty = false;
+    return "\n";
+}
+
+void TraceJsonWriter::ProcessName(uint32_t InPid, const std::string& InName)
+{
+    _file << Separator() << std::format("{{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":{0},\"args\":{{\"name\":\"{1}\"}}}}", InPid, InName);
+}
+
+void TraceJsonWriter::ThreadName(uint32_t InPid, uint32_t InTid, const std::string& InName)
+{
+    _file << Separator() << std::format("{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":{0},\"tid\":{1},\"args\":{{\"name\":\"{2}\"}}}}", InPid, InTid, InName);
+}
+
+void TraceJsonWriter::Complete(const char* InName, const char* InCategory, uint32_t InPid, uint32_t InTid, double InStartUs, double InDurationUs,
+                               const std::string& InArgs)
+{
+    _file << Separator() << std::format("{{\"name\":\"{0}\",\"cat\":\"{1}\",\"ph\":\"X\",\"pid\":{2},\"tid\":{3},\"ts\":{4:.3f},\"dur\":{5:.3f}",
+                                        InName, InCategory, InPid, InTid, InStartUs, InDurationUs);
+
+    if (!InArgs.empty())
+        _file << ",\"args\":{" << InArgs << "}";
+
+    _file << "}";
+}
+
+void TraceJsonWriter::Close()
+{
+    if (!_file.is_open())
+        return;
+
+    _file << "\n]}\n";
+    _file.close();
+}
+
+void Trace::Write(uint32_t InGeneration, int64_t InEndTime)
+{
+    auto path = Util::DllPath().parent_path() / std::format("OptiScaler_trace_{0}.json", _startTime);
+
+    TraceJsonWriter writer;
+
+    if (!writer.Open(path))
+    {
+        RecycleExitedBuffers();
+        _writing = false;
+        return;
+    }
+
+    auto frequency = (double)Frequency();
+    auto toUs = [frequency](int64_t InTime) { return (double)(InTime - _startTime) * 1000000.0 / frequency; };
+
+    std::vector<TraceThreadBuffer*> snapshot;
+
+    {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+
+        for (auto& buffer : buffers)
+            snapshot.push_back(buffer.get());
+    }
+
+    size_t eventCount = 0;
+    uint32_t droppedCount = 0;
+
+    writer.ProcessName(1, "OptiScaler CPU");
+    writer.ProcessName(2, "OptiScaler GPU");
+    writer.ThreadName(2, 1, "Passes");
+
+    for (auto buffer : snapshot)
+    {
+        if (buffer->Generation.load(std::memory_order_acquire) != InGeneration)
+            continue;
+
+        auto count = buffer->Count.load(std::memory_order_acquire);
+        droppedCount += buffer->Dropped.load(std::memory_order_relaxed);
+
+        if (count == 0)
+            continue;
+
+        writer.ThreadName(1, buffer->ThreadId, std::format("Thread {0}", buffer->ThreadId));
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            auto& event = buffer->Events[i];
+
+            if (event.Start < _startTime || event.Start > InEndTime)
+                continue;
+
+            auto gpu = event.Track == Trace::Track::Gpu;
+
+            // GPU events are on a single track of GPU process
+            writer.Complete(event.Name, TrackNames[(uint32_t)event.Track], gpu ? 2 : 1, gpu ? 1 : buffer->ThreadId,
+                            toUs(event.Start), toUs(event.End) - toUs(event.Start));
+
+            eventCount++;
+        }
+    }
+
+    writer.Close();
+
+    if (droppedCount > 0)
+        LOG_WARN("{0} events are dropped, thread buffers were full", droppedCount);
+
+    LOG_INFO("Wrote {0} events to {1}", eventCount, path.string());
+
+    RecycleExitedBuffers();
+
+    _writing = false;
+}
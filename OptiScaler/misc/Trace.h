@@ -0,0 +1,134 @@
+#pragma once
+#include <pch.h>
+
+#include <atomic>
+#include <fstream>
+
+// Timeline capture of hook zones, lock waits & GPU passes, written as Chrome trace json
+// Events are appended to per thread buffers without locking, names must be string literals
+class Trace
+{
+public:
+    enum class Track : uint32_t
+    {
+        Cpu,
+        LockWait,
+        LockHold,
+        Gpu,
+        Frame
+    };
+
+private:
+    static inline std::atomic<bool> _capturing = false;
+    static inline std::atomic<uint32_t> _generation = 0;
+    static inline std::atomic<int32_t> _framesLeft = 0;
+    static inline std::atomic<bool> _writing = false;
+
+    static inline int64_t _startTime = 0;
+    static inline int64_t _lastFrameTime = 0;
+    static inline std::atomic<int64_t> _frequency = 0;
+
+    static void Stop();
+    static void Write(uint32_t InGeneration, int64_t InEndTime);
+
+public:
+    static bool IsCapturing() { return _capturing.load(std::memory_order_relaxed); }
+    static bool IsWriting() { return _writing; }
+    static int32_t FramesLeft() { return _framesLeft; }
+    static uint32_t Generation() { return _generation; }
+
+    // Starts a capture of InFrames presents, ignored while a capture is running or being written
+    static bool Start(int32_t InFrames);
+
+    // Called once per present, ends capture after requested frame count
+    static void NewFrame();
+
+    // Adds a complete event, InStart & InEnd are QueryPerformanceCounter values
+    static void AddEvent(const char* InName, Track InTrack, int64_t InStart, int64_t InEnd);
+
+    static int64_t Now();
+    static int64_t Frequency();
+
+    // Waits shorter than 10 us are treated as uncontended, they would only bloat the trace
+    static bool IsContended(int64_t InRequested, int64_t InAcquired) { return InAcquired - InRequested > Frequency() / 100000; }
+};
+
+// Records duration of enclosing scope while a capture is running
+class TraceZone
+{
+    const char* _name;
+    int64_t _start = 0;
+
+public:
+    TraceZone(const char* InName) : _name(InName)
+    {
+        if (Trace::IsCapturing())
+            _start = Trace::Now();
+    }
+
+    ~TraceZone()
+    {
+        if (_start != 0 && Trace::IsCapturing())
+            Trace::AddEvent(_name, Trace::Track::Cpu, _start, Trace::Now());
+    }
+};
+
+// Lock wrapper which records contended waits and exclusive hold times
+// LockType is std::unique_lock or std::shared_lock, hold time is only recorded for unique locks
+template <class LockType>
+class TracedLock
+{
+    const char* _name;
+    int64_t _acquired = 0;
+    LockType _lock;
+
+    static const bool Exclusive = std::is_same_v<LockType, std::unique_lock<typename LockType::mutex_type>>;
+
+    static int64_t StartTime() { return Trace::IsCapturing() ? Trace::Now() : 0; }
+
+public:
+    template <class MutexType>
+    TracedLock(MutexType& InMutex, const char* InName) : _name(InName), _acquired(StartTime()), _lock(InMutex)
+    {
+        if (_acquired == 0)
+            return;
+
+        auto requested = _acquired;
+        _acquired = Trace::Now();
+
+        if (Trace::IsContended(requested, _acquired))
+            Trace::AddEvent(_name, Trace::Track::LockWait, requested, _acquired);
+    }
+
+    ~TracedLock()
+    {
+        if (Exclusive && _acquired != 0 && Trace::IsCapturing())
+            Trace::AddEvent(_name, Trace::Track::LockHold, _acquired, Trace::Now());
+    }
+};
+
+// Chrome trace json file, used by Trace & StartupProfiler
+// Can be opened with Perfetto or chrome://tracing
+class TraceJsonWriter
+{
+    std::ofstream _file;
+    bool _empty = true;
+
+    // Events are separated by commas, first one has none
+    const char* Separator();
+
+public:
+    bool Open(const std::filesystem::path& InPath);
+
+    void ProcessName(uint32_t InPid, const std::string& InName);
+    void ThreadName(uint32_t InPid, uint32_t InTid, const std::string& InName);
+
+    // Complete event, times are in us, InArgs is contents of args object ("\"calls\":2") or empty
+    void Complete(const char* InName, const char* InCategory, uint32_t InPid, uint32_t InTid, double InStartUs, double InDurationUs,
+                  const std::string& InArgs = "");
+
+    // Ends event list, file can't be written after this
+    void Close();
+};
+
+#define TRACE_ZONE(name) TraceZone _traceZone(name)
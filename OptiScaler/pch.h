@@ -21,6 +21,7 @@
 #define SPDLOG_USE_STD_FORMAT
 #define SPDLOG_WCHAR_FILENAMES
 #include "spdlog/spdlog.h"
+#include "misc/BinaryLog.h"
 
 // Enables logging of DLSS NV Parameters
 //#define DLSS_PARAM_DUMP
@@ -38,10 +39,10 @@ inline HMODULE reshadeHandle = nullptr;
 inline DWORD processId;
 
 #define LOG_TRACE(msg, ...) \
-    spdlog::trace(__FUNCTION__ " " msg, ##__VA_ARGS__)
+    BINARY_LOG_OR_SPDLOG(spdlog::level::trace, spdlog::trace, __FUNCTION__ " " msg, ##__VA_ARGS__)
 
 #define LOG_DEBUG(msg, ...) \
-    spdlog::debug(__FUNCTION__ " " msg, ##__VA_ARGS__)
+    BINARY_LOG_OR_SPDLOG(spdlog::level::debug, spdlog::debug, __FUNCTION__ " " msg, ##__VA_ARGS__)
 
 #ifdef DETAILED_DEBUG_LOGS
 #define LOG_DEBUG_ONLY(msg, ...) \
@@ -67,10 +68,10 @@ inline DWORD processId;
     spdlog::error(__FUNCTION__ " " msg, ##__VA_ARGS__)
 
 #define LOG_FUNC() \
-    spdlog::trace(__FUNCTION__)
+    BINARY_LOG_OR_SPDLOG(spdlog::level::trace, spdlog::trace, __FUNCTION__)
 
 #define LOG_FUNC_RESULT(result) \
-    spdlog::trace(__FUNCTION__ " result: {0:X}" , (UINT64)result)
+    BINARY_LOG_OR_SPDLOG(spdlog::level::trace, spdlog::trace, __FUNCTION__ " result: {0:X}", (UINT64)result)
 
 typedef struct _feature_version
 {
@@ -4,6 +4,7 @@
 #include "Util.h"
 #include "Config.h"
 #include "Logger.h"
+#include "misc/StartupProfiler.h"
 
 #include <inputs/FfxApi_Dx12.h>
 #include <inputs/FfxApi_Vk.h>
@@ -43,6 +44,8 @@ public:
         if (_dllDx12 != nullptr || _D3D12_CreateContext != nullptr)
             return true;
 
+        STARTUP_ZONE(StartupPhase::ProxyLoad);
+
         spdlog::info("");
 
         if (module != nullptr)
@@ -165,6 +168,8 @@ public:
         if (_dllVk != nullptr || _VULKAN_CreateContext != nullptr)
             return true;
 
+        STARTUP_ZONE(StartupPhase::ProxyLoad);
+
         spdlog::info("");
 
         LOG_DEBUG("Loading amd_fidelityfx_vk.dll methods");
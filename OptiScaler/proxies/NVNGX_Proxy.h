@@ -4,6 +4,7 @@
 #include "Util.h"
 #include "Config.h"
 #include "Logger.h"
+#include "misc/StartupProfiler.h"
 #include <vulkan/vulkan.hpp>
 
 #include "nvapi/NvApiHooks.h"
@@ -318,6 +319,8 @@ public:
         if (_dll != nullptr)
             return;
 
+        STARTUP_ZONE(StartupPhase::ProxyLoad);
+
         LOG_INFO("");
 
         if (nvngxModule != nullptr)
@@ -4,6 +4,7 @@
 #include "Util.h"
 #include "Config.h"
 #include "Logger.h"
+#include "misc/StartupProfiler.h"
 
 #include <inputs/XeSS_Common.h>
 #include <inputs/XeSS_Dx12.h>
@@ -205,6 +206,8 @@ public:
         if (_dll != nullptr)
             return true;
 
+        STARTUP_ZONE(StartupPhase::ProxyLoad);
+
         HMODULE mainModule = nullptr;
 
         mainModule = GetModuleHandle(L"libxess.dll");
@@ -247,6 +250,8 @@ public:
         if (_dlldx11 != nullptr)
             return true;
 
+        STARTUP_ZONE(StartupPhase::ProxyLoad);
+
         HMODULE dx11Module = nullptr;
 
         dx11Module = GetModuleHandle(L"libxess_dx11.dll");
@@ -721,6 +726,7 @@ public:
     static PFN_xessGetProperties GetProperties() { return _xessGetProperties; }
     static PFN_xessDestroyContext DestroyContext() { return _xessDestroyContext; }
     static PFN_xessSetVelocityScale SetVelocityScale() { return _xessSetVelocityScale; }
+    static PFN_xessGetPipelineBuildStatus GetPipelineBuildStatus() { return _xessGetPipelineBuildStatus; }
 
     static PFN_xessD3D12GetInitParams D3D12GetInitParams() { return _xessD3D12GetInitParams; }
     static PFN_xessForceLegacyScaleFactors ForceLegacyScaleFactors() { return _xessForceLegacyScaleFactors; }
@@ -0,0 +1,556 @@
+#include "Shader_Vk.h"
+
+#include <State.h>
+#include <misc/GpuProfiler_Vk.h>
+#include <misc/PipelineCache_Vk.h>
+
+Shader_Vk::Shader_Vk(std::string InName, VkDevice InDevice, VkPhysicalDevice InPD) : _name(InName), _device(InDevice), _physicalDevice(InPD)
+{
+    if (InPD != VK_NULL_HANDLE)
+        vkGetPhysicalDeviceMemoryProperties(InPD, &_memoryProperties);
+}
+
+bool Shader_Vk::FindMemoryType(uint32_t InTypeBits, VkMemoryPropertyFlags InFlags, uint32_t* OutIndex) const
+{
+    for (uint32_t i = 0; i < _memoryProperties.memoryTypeCount; i++)
+    {
+        if ((InTypeBits & (1 << i)) && (_memoryProperties.memoryTypes[i].propertyFlags & InFlags) == InFlags)
+        {
+            *OutIndex = i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool Shader_Vk::CheckSpirv(const std::vector<uint32_t>& InCode, uint32_t InGroupSizeX, uint32_t InGroupSizeY) const
+{
+    const uint32_t OpExecutionMode = 16;
+    const uint32_t OpDecorate = 71;
+    const uint32_t ExecutionModeLocalSize = 17;
+    const uint32_t DecorationBinding = 33;
+
+    // 5 word header, then instructions with word count in high half of first word
+    if (InCode.size() < 5 || InCode[0] != 0x07230203)
+    {
+        LOG_ERROR("[{0}] Not a SPIR-V module!", _name);
+        return false;
+    }
+
+    uint32_t groupSizeX = 0;
+    uint32_t groupSizeY = 0;
+    uint32_t usedBindings = 0;
+
+    for (size_t i = 5; i < InCode.size();)
+    {
+        uint32_t wordCount = InCode[i] >> 16;
+        uint32_t opCode = InCode[i] & 0xFFFF;
+
+        if (wordCount == 0 || i + wordCount > InCode.size())
+        {
+            LOG_ERROR("[{0}] Malformed SPIR-V module!", _name);
+            return false;
+        }
+
+        if (opCode == OpExecutionMode && wordCount >= 6 && InCode[i + 2] == ExecutionModeLocalSize)
+        {
+            groupSizeX = InCode[i + 3];
+            groupSizeY = InCode[i + 4];
+        }
+        else if (opCode == OpDecorate && wordCount >= 4 && InCode[i + 2] == DecorationBinding && InCode[i + 3] < 32)
+        {
+            usedBindings |= 1 << InCode[i + 3];
+        }
+
+        i += wordCount;
+    }
+
+    if (groupSizeX != InGroupSizeX || groupSizeY != InGroupSizeY)
+    {
+        LOG_ERROR("[{0}] SPIR-V thread group size {1}x{2} doesn't match Dx12 pass {3}x{4}!", _name, groupSizeX, groupSizeY, InGroupSizeX, InGroupSizeY);
+        return false;
+    }
+
+    // b0, t0, (t1), u0 of Dx12 pass
+    uint32_t expectedBindings = (1 << 0) | (1 << 1) | (1 << 3) | (_hasSecondSrv ? (1 << 2) : 0);
+
+    if (usedBindings != expectedBindings)
+    {
+        LOG_ERROR("[{0}] SPIR-V bindings {1:b} don't match Dx12 registers {2:b}!", _name, usedBindings, expectedBindings);
+        return false;
+    }
+
+    return true;
+}
+
+bool Shader_Vk::CreatePipeline(const unsigned char* InSpirv, size_t InSize, bool InSecondSrv, VkDeviceSize InConstantSize, uint32_t InGroupSizeX, uint32_t InGroupSizeY)
+{
+    if (_device == VK_NULL_HANDLE || _physicalDevice == VK_NULL_HANDLE || InSpirv == nullptr || InSize == 0 || InSize % sizeof(uint32_t) != 0)
+        return false;
+
+    _hasSecondSrv = InSecondSrv;
+
+    // UAVs are typed with game's output format, shaders are compiled without a storage format
+    VkPhysicalDeviceFeatures features{};
+    vkGetPhysicalDeviceFeatures(_physicalDevice, &features);
+
+    if (!features.shaderStorageImageWriteWithoutFormat)
+    {
+        LOG_ERROR("[{0}] shaderStorageImageWriteWithoutFormat is not supported!", _name);
+        return false;
+    }
+
+    VkDescriptorSetLayoutBinding bindings[4]{};
+    uint32_t bindingCount = 0;
+
+    bindings[bindingCount++] = { 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr };
+    bindings[bindingCount++] = { 1, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr };
+
+    if (_hasSecondSrv)
+        bindings[bindingCount++] = { 2, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr };
+
+    bindings[bindingCount++] = { 3, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr };
+
+    VkDescriptorSetLayoutCreateInfo setLayoutInfo{};
+    setLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    setLayoutInfo.bindingCount = bindingCount;
+    setLayoutInfo.pBindings = bindings;
+
+    auto result = vkCreateDescriptorSetLayout(_device, &setLayoutInfo, nullptr, &_setLayout);
+
+    if (result != VK_SUCCESS)
+    {
+        LOG_ERROR("[{0}] vkCreateDescriptorSetLayout error: {1:X}", _name, (UINT)result);
+        return false;
+    }
+
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+    pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipelineLayoutInfo.setLayoutCount = 1;
+    pipelineLayoutInfo.pSetLayouts = &_setLayout;
+
+    result = vkCreatePipelineLayout(_device, &pipelineLayoutInfo, nullptr, &_pipelineLayout);
+
+    if (result != VK_SUCCESS)
+    {
+        LOG_ERROR("[{0}] vkCreatePipelineLayout error: {1:X}", _name, (UINT)result);
+        return false;
+    }
+
+    // Header arrays are byte aligned, code must be word aligned
+    std::vector<uint32_t> code(InSize / sizeof(uint32_t));
+    memcpy(code.data(), InSpirv, InSize);
+
+    if (!CheckSpirv(code, InGroupSizeX, InGroupSizeY))
+        return false;
+
+    VkShaderModuleCreateInfo moduleInfo{};
+    moduleInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    moduleInfo.codeSize = InSize;
+    moduleInfo.pCode = code.data();
+
+    VkShaderModule shaderModule = VK_NULL_HANDLE;
+    result = vkCreateShaderModule(_device, &moduleInfo, nullptr, &shaderModule);
+
+    if (result != VK_SUCCESS)
+    {
+        LOG_ERROR("[{0}] vkCreateShaderModule error: {1:X}", _name, (UINT)result);
+        return false;
+    }
+
+    VkComputePipelineCreateInfo pipelineInfo{};
+    pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipelineInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    pipelineInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    pipelineInfo.stage.module = shaderModule;
+    pipelineInfo.stage.pName = "CSMain";
+    pipelineInfo.layout = _pipelineLayout;
+
+    result = vkCreateComputePipelines(_device, PipelineCache_Vk::Get(_device, _physicalDevice), 1, &pipelineInfo, nullptr, &_pipeline);
+
+    vkDestroyShaderModule(_device, shaderModule, nullptr);
+
+    if (result != VK_SUCCESS)
+    {
+        LOG_ERROR("[{0}] vkCreateComputePipelines error: {1:X}", _name, (UINT)result);
+        _pipeline = VK_NULL_HANDLE;
+        return false;
+    }
+
+    VkDescriptorPoolSize poolSizes[] =
+    {
+        { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, RingSize },
+        { VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, RingSize * 2 },
+        { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, RingSize }
+    };
+
+    VkDescriptorPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.maxSets = RingSize;
+    poolInfo.poolSizeCount = (uint32_t)std::size(poolSizes);
+    poolInfo.pPoolSizes = poolSizes;
+
+    result = vkCreateDescriptorPool(_device, &poolInfo, nullptr, &_descriptorPool);
+
+    if (result != VK_SUCCESS)
+    {
+        LOG_ERROR("[{0}] vkCreateDescriptorPool error: {1:X}", _name, (UINT)result);
+        return false;
+    }
+
+    VkDescriptorSetLayout setLayouts[RingSize];
+    for (auto& layout : setLayouts)
+        layout = _setLayout;
+
+    VkDescriptorSetAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool = _descriptorPool;
+    allocInfo.descriptorSetCount = RingSize;
+    allocInfo.pSetLayouts = setLayouts;
+
+    result = vkAllocateDescriptorSets(_device, &allocInfo, _sets);
+
+    if (result != VK_SUCCESS)
+    {
+        LOG_ERROR("[{0}] vkAllocateDescriptorSets error: {1:X}", _name, (UINT)result);
+        return false;
+    }
+
+    // One persistently mapped buffer for constants of all slots
+    VkPhysicalDeviceProperties properties{};
+    vkGetPhysicalDeviceProperties(_physicalDevice, &properties);
+
+    auto alignment = properties.limits.minUniformBufferOffsetAlignment;
+    _constantSlotSize = alignment > 0 ? (InConstantSize + alignment - 1) / alignment * alignment : InConstantSize;
+
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = _constantSlotSize * RingSize;
+    bufferInfo.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    result = vkCreateBuffer(_device, &bufferInfo, nullptr, &_constantBuffer);
+
+    if (result != VK_SUCCESS)
+    {
+        LOG_ERROR("[{0}] vkCreateBuffer error: {1:X}", _name, (UINT)result);
+        return false;
+    }
+
+    VkMemoryRequirements requirements{};
+    vkGetBufferMemoryRequirements(_device, _constantBuffer, &requirements);
+
+    VkMemoryAllocateInfo memoryInfo{};
+    memoryInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    memoryInfo.allocationSize = requirements.size;
+
+    if (!FindMemoryType(requirements.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &memoryInfo.memoryTypeIndex))
+    {
+        LOG_ERROR("[{0}] Can't find host visible memory type!", _name);
+        return false;
+    }
+
+    result = vkAllocateMemory(_device, &memoryInfo, nullptr, &_constantMemory);
+
+    if (result != VK_SUCCESS)
+    {
+        LOG_ERROR("[{0}] vkAllocateMemory error: {1:X}", _name, (UINT)result);
+        return false;
+    }
+
+    vkBindBufferMemory(_device, _constantBuffer, _constantMemory, 0);
+
+    result = vkMapMemory(_device, _constantMemory, 0, VK_WHOLE_SIZE, 0, (void**)&_constantData);
+
+    if (result != VK_SUCCESS)
+    {
+        LOG_ERROR("[{0}] vkMapMemory error: {1:X}", _name, (UINT)result);
+        _constantData = nullptr;
+        return false;
+    }
+
+    return true;
+}
+
+bool Shader_Vk::CreateBufferResource(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Resource_VK* InSource, uint32_t InWidth, uint32_t InHeight)
+{
+    if (!_init || InCmdBuffer == VK_NULL_HANDLE || InSource == nullptr)
+        return false;
+
+    auto format = InSource->Resource.ImageViewInfo.Format;
+
+    if (_bufferImage != VK_NULL_HANDLE)
+    {
+        if (_bufferResource.Resource.ImageViewInfo.Width == InWidth && _bufferResource.Resource.ImageViewInfo.Height == InHeight &&
+            _bufferResource.Resource.ImageViewInfo.Format == format)
+            return true;
+
+        // Previous frames might still use the old image
+        _retired.push_back({ _bufferImage, _bufferView, _bufferMemory, _dispatchCount });
+
+        _bufferImage = VK_NULL_HANDLE;
+        _bufferView = VK_NULL_HANDLE;
+        _bufferMemory = VK_NULL_HANDLE;
+    }
+
+    LOG_DEBUG("[{0}] Start!", _name);
+
+    VkImageCreateInfo imageInfo{};
+    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.imageType = VK_IMAGE_TYPE_2D;
+    imageInfo.format = format;
+    imageInfo.extent = { InWidth, InHeight, 1 };
+    imageInfo.mipLevels = 1;
+    imageInfo.arrayLayers = 1;
+    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.usage = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    auto result = vkCreateImage(_device, &imageInfo, nullptr, &_bufferImage);
+
+    if (result != VK_SUCCESS)
+    {
+        LOG_ERROR("[{0}] vkCreateImage error: {1:X}", _name, (UINT)result);
+        _bufferImage = VK_NULL_HANDLE;
+        return false;
+    }
+
+    VkMemoryRequirements requirements{};
+    vkGetImageMemoryRequirements(_device, _bufferImage, &requirements);
+
+    VkMemoryAllocateInfo memoryInfo{};
+    memoryInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    memoryInfo.allocationSize = requirements.size;
+
+    if (!FindMemoryType(requirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &memoryInfo.memoryTypeIndex) ||
+        vkAllocateMemory(_device, &memoryInfo, nullptr, &_bufferMemory) != VK_SUCCESS)
+    {
+        LOG_ERROR("[{0}] Can't allocate image memory!", _name);
+        vkDestroyImage(_device, _bufferImage, nullptr);
+        _bufferImage = VK_NULL_HANDLE;
+        _bufferMemory = VK_NULL_HANDLE;
+        return false;
+    }
+
+    vkBindImageMemory(_device, _bufferImage, _bufferMemory, 0);
+
+    VkImageViewCreateInfo viewInfo{};
+    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    viewInfo.image = _bufferImage;
+    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    viewInfo.format = format;
+    viewInfo.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+
+    result = vkCreateImageView(_device, &viewInfo, nullptr, &_bufferView);
+
+    if (result != VK_SUCCESS)
+    {
+        LOG_ERROR("[{0}] vkCreateImageView error: {1:X}", _name, (UINT)result);
+        vkDestroyImage(_device, _bufferImage, nullptr);
+        vkFreeMemory(_device, _bufferMemory, nullptr);
+        _bufferImage = VK_NULL_HANDLE;
+        _bufferView = VK_NULL_HANDLE;
+        _bufferMemory = VK_NULL_HANDLE;
+        return false;
+    }
+
+    _bufferResource = {};
+    _bufferResource.Type = NVSDK_NGX_RESOURCE_VK_TYPE_VK_IMAGEVIEW;
+    _bufferResource.ReadWrite = true;
+    _bufferResource.Resource.ImageViewInfo.Image = _bufferImage;
+    _bufferResource.Resource.ImageViewInfo.ImageView = _bufferView;
+    _bufferResource.Resource.ImageViewInfo.Format = format;
+    _bufferResource.Resource.ImageViewInfo.Width = InWidth;
+    _bufferResource.Resource.ImageViewInfo.Height = InHeight;
+    _bufferResource.Resource.ImageViewInfo.SubresourceRange = viewInfo.subresourceRange;
+
+    // Image stays in GENERAL, upscalers get it as an UAV and passes read it as a sampled image
+    VkImageMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcAccessMask = 0;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    barrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = _bufferImage;
+    barrier.subresourceRange = viewInfo.subresourceRange;
+
+    vkCmdPipelineBarrier(InCmdBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+    _bufferAccess = VK_ACCESS_SHADER_WRITE_BIT;
+
+    return true;
+}
+
+void Shader_Vk::SetBufferState(VkCommandBuffer InCmdBuffer, VkAccessFlags InAccess)
+{
+    if (_bufferImage == VK_NULL_HANDLE || InCmdBuffer == VK_NULL_HANDLE)
+        return;
+
+    // Read after read doesn't need a barrier, writes always do
+    if (_bufferAccess == InAccess && InAccess == VK_ACCESS_SHADER_READ_BIT)
+        return;
+
+    VkImageMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcAccessMask = _bufferAccess;
+    barrier.dstAccessMask = InAccess;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_GENERAL;
+    barrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = _bufferImage;
+    barrier.subresourceRange = _bufferResource.Resource.ImageViewInfo.SubresourceRange;
+
+    vkCmdPipelineBarrier(InCmdBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+    _bufferAccess = InAccess;
+}
+
+bool Shader_Vk::Prepare(const void* InConstants, VkDeviceSize InSize, VkImageView InSource, VkImageLayout InSourceLayout, VkImageView InSecondSource,
+                        VkImageView InDest)
+{
+    if (!_init || _constantData == nullptr || InSize > _constantSlotSize || InSource == VK_NULL_HANDLE || InDest == VK_NULL_HANDLE ||
+        (_hasSecondSrv && InSecondSource == VK_NULL_HANDLE))
+        return false;
+
+    _slot = (_slot + 1) % RingSize;
+
+    DestroyRetired(false);
+
+    auto offset = _constantSlotSize * _slot;
+    memcpy(_constantData + offset, InConstants, (size_t)InSize);
+
+    VkDescriptorBufferInfo bufferInfo{ _constantBuffer, offset, InSize };
+    VkDescriptorImageInfo sourceInfo{ VK_NULL_HANDLE, InSource, InSourceLayout };
+    VkDescriptorImageInfo secondInfo{ VK_NULL_HANDLE, InSecondSource, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+    VkDescriptorImageInfo destInfo{ VK_NULL_HANDLE, InDest, VK_IMAGE_LAYOUT_GENERAL };
+
+    VkWriteDescriptorSet writes[4]{};
+    uint32_t writeCount = 0;
+
+    auto addWrite = [&](uint32_t binding, VkDescriptorType type, const VkDescriptorImageInfo* pImage, const VkDescriptorBufferInfo* pBuffer)
+        {
+            auto& write = writes[writeCount++];
+            write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            write.dstSet = _sets[_slot];
+            write.dstBinding = binding;
+            write.descriptorCount = 1;
+            write.descriptorType = type;
+            write.pImageInfo = pImage;
+            write.pBufferInfo = pBuffer;
+        };
+
+    addWrite(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, nullptr, &bufferInfo);
+    addWrite(1, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, &sourceInfo, nullptr);
+
+    if (_hasSecondSrv)
+        addWrite(2, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, &secondInfo, nullptr);
+
+    addWrite(3, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, &destInfo, nullptr);
+
+    vkUpdateDescriptorSets(_device, writeCount, writes, 0, nullptr);
+
+    return true;
+}
+
+void Shader_Vk::Dispatch(VkCommandBuffer InCmdBuffer, VkImage InDest, GpuPass InPass, uint32_t InGroupsX, uint32_t InGroupsY)
+{
+    vkCmdBindPipeline(InCmdBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, _pipeline);
+    vkCmdBindDescriptorSets(InCmdBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, _pipelineLayout, 0, 1, &_sets[_slot], 0, nullptr);
+
+    GpuProfiler_Vk::Begin(_device, InCmdBuffer, InPass);
+    vkCmdDispatch(InCmdBuffer, InGroupsX, InGroupsY, 1);
+    GpuProfiler_Vk::End(InCmdBuffer, InPass);
+
+    _dispatchCount++;
+
+    // Our own buffer is handled with SetBufferState, game's output might be used by anything after us
+    if (InDest == _bufferImage)
+    {
+        _bufferAccess = VK_ACCESS_SHADER_WRITE_BIT;
+        return;
+    }
+
+    VkImageMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_GENERAL;
+    barrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = InDest;
+    barrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+
+    vkCmdPipelineBarrier(InCmdBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+}
+
+void Shader_Vk::DestroyRetired(bool InAll)
+{
+    for (auto it = _retired.begin(); it != _retired.end();)
+    {
+        if (!InAll && _dispatchCount - it->Dispatch < RingSize)
+        {
+            it++;
+            continue;
+        }
+
+        if (it->View != VK_NULL_HANDLE)
+            vkDestroyImageView(_device, it->View, nullptr);
+
+        if (it->Image != VK_NULL_HANDLE)
+            vkDestroyImage(_device, it->Image, nullptr);
+
+        if (it->Memory != VK_NULL_HANDLE)
+            vkFreeMemory(_device, it->Memory, nullptr);
+
+        it = _retired.erase(it);
+    }
+}
+
+Shader_Vk::~Shader_Vk()
+{
+    // Features are released after vkDeviceWaitIdle
+    if (_device == VK_NULL_HANDLE || State::Instance().isShuttingDown)
+        return;
+
+    DestroyRetired(true);
+
+    if (_bufferView != VK_NULL_HANDLE)
+        vkDestroyImageView(_device, _bufferView, nullptr);
+
+    if (_bufferImage != VK_NULL_HANDLE)
+        vkDestroyImage(_device, _bufferImage, nullptr);
+
+    if (_bufferMemory != VK_NULL_HANDLE)
+        vkFreeMemory(_device, _bufferMemory, nullptr);
+
+    if (_constantMemory != VK_NULL_HANDLE)
+    {
+        if (_constantData != nullptr)
+            vkUnmapMemory(_device, _constantMemory);
+
+        vkFreeMemory(_device, _constantMemory, nullptr);
+    }
+
+    if (_constantBuffer != VK_NULL_HANDLE)
+        vkDestroyBuffer(_device, _constantBuffer, nullptr);
+
+    // Sets are freed with the pool
+    if (_descriptorPool != VK_NULL_HANDLE)
+        vkDestroyDescriptorPool(_device, _descriptorPool, nullptr);
+
+    if (_pipeline != VK_NULL_HANDLE)
+        vkDestroyPipeline(_device, _pipeline, nullptr);
+
+    if (_pipelineLayout != VK_NULL_HANDLE)
+        vkDestroyPipelineLayout(_device, _pipelineLayout, nullptr);
+
+    if (_setLayout != VK_NULL_HANDLE)
+        vkDestroyDescriptorSetLayout(_device, _setLayout, nullptr);
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <pch.h>
+
+#include <misc/GpuProfiler_Common.h>
+
+#include <vulkan/vulkan.hpp>
+#include <nvsdk_ngx_vk.h>
+#include <vector>
+
+// Common part of Vulkan compute passes (RCAS & output scaling)
+// Layout follows the Dx12 registers, shaders are compiled with -fvk-t-shift 1 0 -fvk-u-shift 3 0
+//   0: Params (b0), 1: first SRV (t0), 2: second SRV (t1), 3: UAV (u0)
+// Descriptor sets & constant slots are used as a ring, a slot is only rewritten after RingSize dispatches
+class Shader_Vk
+{
+public:
+    static const uint32_t RingSize = 4;
+
+private:
+    struct RetiredBuffer
+    {
+        VkImage Image = VK_NULL_HANDLE;
+        VkImageView View = VK_NULL_HANDLE;
+        VkDeviceMemory Memory = VK_NULL_HANDLE;
+        uint64_t Dispatch = 0;
+    };
+
+    VkDescriptorSetLayout _setLayout = VK_NULL_HANDLE;
+    VkPipelineLayout _pipelineLayout = VK_NULL_HANDLE;
+    VkPipeline _pipeline = VK_NULL_HANDLE;
+    VkDescriptorPool _descriptorPool = VK_NULL_HANDLE;
+    VkDescriptorSet _sets[RingSize]{};
+
+    VkBuffer _constantBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory _constantMemory = VK_NULL_HANDLE;
+    uint8_t* _constantData = nullptr;
+    VkDeviceSize _constantSlotSize = 0;
+
+    VkImage _bufferImage = VK_NULL_HANDLE;
+    VkImageView _bufferView = VK_NULL_HANDLE;
+    VkDeviceMemory _bufferMemory = VK_NULL_HANDLE;
+    VkAccessFlags _bufferAccess = 0;
+    bool _bufferUndefined = true;
+    NVSDK_NGX_Resource_VK _bufferResource{};
+    std::vector<RetiredBuffer> _retired;
+
+    VkPhysicalDeviceMemoryProperties _memoryProperties{};
+    bool _hasSecondSrv = false;
+    uint32_t _slot = 0;
+    uint64_t _dispatchCount = 0;
+
+    bool FindMemoryType(uint32_t InTypeBits, VkMemoryPropertyFlags InFlags, uint32_t* OutIndex) const;
+    bool CheckSpirv(const std::vector<uint32_t>& InCode, uint32_t InGroupSizeX, uint32_t InGroupSizeY) const;
+    void DestroyRetired(bool InAll);
+
+protected:
+    std::string _name = "";
+    bool _init = false;
+    VkDevice _device = VK_NULL_HANDLE;
+    VkPhysicalDevice _physicalDevice = VK_NULL_HANDLE;
+
+    // Creates layouts, pipeline, descriptor ring & constant ring
+    // InGroupSize is the thread group size used for group counts of Dx12 pass, SPIR-V is checked against it & register layout
+    bool CreatePipeline(const unsigned char* InSpirv, size_t InSize, bool InSecondSrv, VkDeviceSize InConstantSize, uint32_t InGroupSizeX, uint32_t InGroupSizeY);
+
+    // Moves to next ring slot, writes constants & descriptors of it
+    // Sources must be in InSourceLayout, second source in SHADER_READ_ONLY_OPTIMAL (COMPUTE_READ of FFX & XeSS), dest in GENERAL
+    bool Prepare(const void* InConstants, VkDeviceSize InSize, VkImageView InSource, VkImageLayout InSourceLayout, VkImageView InSecondSource, VkImageView InDest);
+
+    // Records dispatch & makes dest writes visible to following commands
+    void Dispatch(VkCommandBuffer InCmdBuffer, VkImage InDest, GpuPass InPass, uint32_t InGroupsX, uint32_t InGroupsY);
+
+    Shader_Vk(std::string InName, VkDevice InDevice, VkPhysicalDevice InPD);
+
+public:
+    // (Re)creates intermediate image with InSource's format, image is kept in GENERAL layout
+    bool CreateBufferResource(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Resource_VK* InSource, uint32_t InWidth, uint32_t InHeight);
+
+    // Vulkan version of the resource state transitions of Dx12, only adds a memory barrier as layout doesn't change
+    void SetBufferState(VkCommandBuffer InCmdBuffer, VkAccessFlags InAccess);
+
+    NVSDK_NGX_Resource_VK* Buffer() { return _bufferImage != VK_NULL_HANDLE ? &_bufferResource : nullptr; }
+    bool IsInit() const { return _init; }
+    bool CanRender() const { return _init && _bufferImage != VK_NULL_HANDLE; }
+
+    virtual ~Shader_Vk();
+};
@@ -4,6 +4,7 @@
 #include "precompile/Bias_Shader.h"
 
 #include <Config.h>
+#include <misc/GpuProfiler_Dx12.h>
 
 inline static DXGI_FORMAT TranslateTypelessFormats(DXGI_FORMAT format)
 {
@@ -225,7 +226,9 @@ bool Bias_Dx12::Dispatch(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCm
 	dispatchWidth = (inDesc.Width + InNumThreadsX - 1) / InNumThreadsX;
 	dispatchHeight = (inDesc.Height + InNumThreadsY - 1) / InNumThreadsY;
 
+	GpuProfiler_Dx12::Begin(InDevice, InCmdList, GpuPass::Bias);
 	InCmdList->Dispatch(dispatchWidth, dispatchHeight, 1);
+	GpuProfiler_Dx12::End(InCmdList, GpuPass::Bias);
 
 	return true;
 }
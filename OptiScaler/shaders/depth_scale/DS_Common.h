@@ -8,6 +8,19 @@ using namespace DirectX;
 struct alignas(256) DSConstants
 {
     float DepthScale;
+    uint32_t Width;
+    uint32_t Height;
+};
+
+// Layout of one readback ring slot
+// MinDepth & MaxDepth are copied from the reduction buffer,
+// Marker is written by the GPU after the copy is completed
+struct DSMinMaxReadback
+{
+    float MinDepth;
+    float MaxDepth;
+    uint32_t Marker;
+    uint32_t Padding;
 };
 
 inline static std::string shaderCode = R"(
@@ -38,6 +51,81 @@ void CSMain(uint3 dispatchThreadID : SV_DispatchThreadID)
 }
 )";
 
+// Hierarchical min/max reduction of depth
+// Each thread reduces a 2x2 quad, groups reduce in shared memory
+// and only one atomic per group is issued to the 8 byte result buffer
+inline static std::string reduceShaderCode = R"(
+cbuffer Params : register(b0)
+{
+    float DepthScale;
+    uint Width;
+    uint Height;
+};
+
+// Input texture
+Texture2D<float> SourceTexture : register(t0);
+
+// Min (offset 0) & max (offset 4) as uint, valid for non-negative floats
+RWByteAddressBuffer MinMaxBuffer : register(u0);
+
+groupshared float gsMin[256];
+groupshared float gsMax[256];
+
+[numthreads(16, 16, 1)]
+void CSMain(uint3 groupId : SV_GroupID, uint3 groupThreadId : SV_GroupThreadID, uint groupIndex : SV_GroupIndex)
+{
+    uint2 basePos = groupId.xy * 32 + groupThreadId.xy * 2;
+
+    float minDepth = 3.402823466e+38f;
+    float maxDepth = 0.0f;
+
+    [unroll]
+    for (uint y = 0; y < 2; y++)
+    {
+        [unroll]
+        for (uint x = 0; x < 2; x++)
+        {
+            uint2 pos = basePos + uint2(x, y);
+
+            if (pos.x < Width && pos.y < Height)
+            {
+                float depth = SourceTexture.Load(int3(pos, 0));
+
+                if (!isnan(depth) && !isinf(depth))
+                {
+                    depth = max(depth, 0.0f);
+                    minDepth = min(minDepth, depth);
+                    maxDepth = max(maxDepth, depth);
+                }
+            }
+        }
+    }
+
+    gsMin[groupIndex] = minDepth;
+    gsMax[groupIndex] = maxDepth;
+    GroupMemoryBarrierWithGroupSync();
+
+    [unroll]
+    for (uint s = 128; s > 0; s >>= 1)
+    {
+        if (groupIndex < s)
+        {
+            gsMin[groupIndex] = min(gsMin[groupIndex], gsMin[groupIndex + s]);
+            gsMax[groupIndex] = max(gsMax[groupIndex], gsMax[groupIndex + s]);
+        }
+
+        GroupMemoryBarrierWithGroupSync();
+    }
+
+    if (groupIndex == 0)
+    {
+        uint ignored;
+        MinMaxBuffer.InterlockedMin(0, asuint(gsMin[0]), ignored);
+        MinMaxBuffer.InterlockedMax(4, asuint(gsMax[0]), ignored);
+    }
+}
+)";
+
 inline static ID3DBlob* DS_CompileShader(const char* shaderCode, const char* entryPoint, const char* target)
 {
     ID3DBlob* shaderBlob = nullptr;
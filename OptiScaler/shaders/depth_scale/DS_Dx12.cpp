@@ -4,6 +4,8 @@
 #include <State.h>
 #include "precompiled/DS_Shader.h"
 
+#include <algorithm>
+
 inline static DXGI_FORMAT TranslateTypelessFormats(DXGI_FORMAT format)
 {
     switch (format) {
@@ -127,6 +129,212 @@ void DS_Dx12::SetBufferState(ID3D12GraphicsCommandList* InCommandList, D3D12_RES
     _bufferState = InState;
 }
 
+void DS_Dx12::SetMinMaxBufferState(ID3D12GraphicsCommandList* InCommandList, D3D12_RESOURCE_STATES InState)
+{
+    if (_minMaxBufferState == InState)
+        return;
+
+    D3D12_RESOURCE_BARRIER barrier = {};
+    barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+    barrier.Transition.pResource = _minMaxBuffer;
+    barrier.Transition.StateBefore = _minMaxBufferState;
+    barrier.Transition.StateAfter = InState;
+    barrier.Transition.Subresource = 0;
+    InCommandList->ResourceBarrier(1, &barrier);
+    _minMaxBufferState = InState;
+}
+
+bool DS_Dx12::CreateReductionResources(ID3D12Device* InDevice)
+{
+    LOG_DEBUG("[{0}] Start!", _name);
+
+    auto reduceShader = DS_CompileShader(reduceShaderCode.c_str(), "CSMain", "cs_5_0");
+
+    if (reduceShader == nullptr)
+    {
+        LOG_ERROR("[{0}] Reduce CompileShader error!", _name);
+        return false;
+    }
+
+    auto pipelineResult = CreateComputeShader(InDevice, _rootSignature, &_reducePipelineState, reduceShader);
+    reduceShader->Release();
+
+    if (!pipelineResult)
+    {
+        LOG_ERROR("[{0}] Reduce CreateComputeShader error!", _name);
+        return false;
+    }
+
+    // Reduction target, min & max as uint
+    auto bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(256, D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+    auto defaultHeap = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT);
+
+    auto hr = InDevice->CreateCommittedResource(&defaultHeap, D3D12_HEAP_FLAG_NONE, &bufferDesc, D3D12_RESOURCE_STATE_COPY_DEST, nullptr, IID_PPV_ARGS(&_minMaxBuffer));
+
+    if (hr != S_OK)
+    {
+        LOG_ERROR("[{0}] CreateCommittedResource _minMaxBuffer error {1:x}", _name, (unsigned int)hr);
+        return false;
+    }
+
+    _minMaxBuffer->SetName(L"DepthMinMax_Buffer");
+    _minMaxBufferState = D3D12_RESOURCE_STATE_COPY_DEST;
+
+    // Initial values copied before every reduction
+    auto initDesc = CD3DX12_RESOURCE_DESC::Buffer(256);
+    auto uploadHeap = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
+
+    hr = InDevice->CreateCommittedResource(&uploadHeap, D3D12_HEAP_FLAG_NONE, &initDesc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&_minMaxInitBuffer));
+
+    if (hr != S_OK)
+    {
+        LOG_ERROR("[{0}] CreateCommittedResource _minMaxInitBuffer error {1:x}", _name, (unsigned int)hr);
+        return false;
+    }
+
+    uint32_t* initData = nullptr;
+    CD3DX12_RANGE readRange(0, 0);
+
+    if (_minMaxInitBuffer->Map(0, &readRange, reinterpret_cast<void**>(&initData)) != S_OK || initData == nullptr)
+    {
+        LOG_ERROR("[{0}] _minMaxInitBuffer->Map error!", _name);
+        return false;
+    }
+
+    initData[0] = 0x7F7FFFFF; // FLT_MAX
+    initData[1] = 0;
+    _minMaxInitBuffer->Unmap(0, nullptr);
+
+    // Readback ring, stays mapped
+    auto readbackDesc = CD3DX12_RESOURCE_DESC::Buffer(sizeof(DSMinMaxReadback) * ReadbackRingSize);
+    auto readbackHeap = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_READBACK);
+
+    hr = InDevice->CreateCommittedResource(&readbackHeap, D3D12_HEAP_FLAG_NONE, &readbackDesc, D3D12_RESOURCE_STATE_COPY_DEST, nullptr, IID_PPV_ARGS(&_readbackBuffer));
+
+    if (hr != S_OK)
+    {
+        LOG_ERROR("[{0}] CreateCommittedResource _readbackBuffer error {1:x}", _name, (unsigned int)hr);
+        return false;
+    }
+
+    if (_readbackBuffer->Map(0, nullptr, reinterpret_cast<void**>(&_readbackData)) != S_OK || _readbackData == nullptr)
+    {
+        LOG_ERROR("[{0}] _readbackBuffer->Map error!", _name);
+        _readbackData = nullptr;
+        return false;
+    }
+
+    memset(_readbackData, 0, sizeof(DSMinMaxReadback) * ReadbackRingSize);
+
+    return true;
+}
+
+void DS_Dx12::Reduce(ID3D12GraphicsCommandList* InCmdList, uint32_t InWidth, uint32_t InHeight)
+{
+    auto slot = _reductionCounter % ReadbackRingSize;
+
+    // Result of this slot is not consumed yet
+    if (_readbackMarker[slot] != 0)
+    {
+        LOG_DEBUG("[{0}] Readback slot {1} is still pending, skipping reduction", _name, slot);
+        return;
+    }
+
+    // Command list is submitted by the game, marker is the only completion signal we get
+    ID3D12GraphicsCommandList2* cmdList2 = nullptr;
+    if (InCmdList->QueryInterface(IID_PPV_ARGS(&cmdList2)) != S_OK || cmdList2 == nullptr)
+    {
+        LOG_WARN("[{0}] WriteBufferImmediate is not supported, auto depth scale disabled!", _name);
+        _reduceInitFailed = true;
+        return;
+    }
+
+    _reductionCounter++;
+
+    // Serial 0 marks free slots
+    if (_reductionCounter == 0)
+        _reductionCounter++;
+
+    SetMinMaxBufferState(InCmdList, D3D12_RESOURCE_STATE_COPY_DEST);
+    InCmdList->CopyBufferRegion(_minMaxBuffer, 0, _minMaxInitBuffer, 0, sizeof(float) * 2);
+    SetMinMaxBufferState(InCmdList, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+
+    InCmdList->SetPipelineState(_reducePipelineState);
+    InCmdList->SetComputeRootDescriptorTable(1, _gpuReduceUavHandle[_counter]);
+    InCmdList->Dispatch((InWidth + 31) / 32, (InHeight + 31) / 32, 1);
+
+    SetMinMaxBufferState(InCmdList, D3D12_RESOURCE_STATE_COPY_SOURCE);
+    InCmdList->CopyBufferRegion(_readbackBuffer, slot * sizeof(DSMinMaxReadback), _minMaxBuffer, 0, sizeof(float) * 2);
+
+    // Marker is written after the copy is completed, so CPU can poll it without waiting
+    D3D12_WRITEBUFFERIMMEDIATE_PARAMETER param{};
+    param.Dest = _readbackBuffer->GetGPUVirtualAddress() + slot * sizeof(DSMinMaxReadback) + offsetof(DSMinMaxReadback, Marker);
+    param.Value = _reductionCounter;
+
+    D3D12_WRITEBUFFERIMMEDIATE_MODE mode = D3D12_WRITEBUFFERIMMEDIATE_MODE_MARKER_OUT;
+    cmdList2->WriteBufferImmediate(1, &param, &mode);
+    cmdList2->Release();
+
+    _readbackMarker[slot] = _reductionCounter;
+}
+
+void DS_Dx12::ReadbackMinMax()
+{
+    // Command lists might complete out of recording order, results are applied oldest first
+    uint32_t ready[ReadbackRingSize]{};
+    uint32_t readyCount = 0;
+
+    for (uint32_t i = 0; i < ReadbackRingSize; i++)
+    {
+        if (_readbackMarker[i] == 0 || _readbackData[i].Marker != _readbackMarker[i])
+            continue;
+
+        ready[readyCount++] = i;
+    }
+
+    std::sort(ready, ready + readyCount, [this](uint32_t a, uint32_t b) { return (int32_t)(_readbackMarker[a] - _readbackMarker[b]) < 0; });
+
+    for (uint32_t i = 0; i < readyCount; i++)
+    {
+        auto slot = ready[i];
+        auto marker = _readbackMarker[slot];
+        _readbackMarker[slot] = 0;
+
+        // A newer reduction was already applied
+        if (_lastAppliedMarker != 0 && (int32_t)(marker - _lastAppliedMarker) <= 0)
+            continue;
+
+        _lastAppliedMarker = marker;
+        _lastMinDepth = _readbackData[slot].MinDepth;
+        _lastMaxDepth = _readbackData[slot].MaxDepth;
+
+        LOG_DEBUG("[{0}] Depth min: {1}, max: {2}, serial: {3}", _name, _lastMinDepth, _lastMaxDepth, marker);
+
+        UpdateAutoScale(_lastMaxDepth);
+    }
+}
+
+void DS_Dx12::UpdateAutoScale(float InMaxDepth)
+{
+    const float hysteresis = 0.1f;
+    const float shrinkRate = 0.25f;
+
+    // Empty or invalid reduction
+    if (!std::isfinite(InMaxDepth) || InMaxDepth <= 0.0f)
+        return;
+
+    // Grow immediately to prevent clipping, shrink slowly and only outside of hysteresis band
+    if (_autoScale <= 0.0f || InMaxDepth > _autoScale)
+        _autoScale = InMaxDepth;
+    else if (InMaxDepth < _autoScale * (1.0f - hysteresis))
+        _autoScale += (InMaxDepth - _autoScale) * shrinkRate;
+    else
+        return;
+
+    State::Instance().FGautoDepthScale = _autoScale;
+    LOG_DEBUG("[{0}] New auto depth scale: {1}", _name, _autoScale);
+}
+
 bool DS_Dx12::Dispatch(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCmdList, ID3D12Resource* InResource, ID3D12Resource* OutResource)
 {
     if (!_init || InDevice == nullptr || InCmdList == nullptr || InResource == nullptr || OutResource == nullptr)
@@ -167,6 +375,57 @@ bool DS_Dx12::Dispatch(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCmdL
         _gpuCbvHandle[_counter].ptr += InDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
     }
 
+    bool autoScale = false;
+
+    if (Config::Instance()->FGDepthScaleAuto.value_or_default() && !_reduceInitFailed)
+    {
+        if (!CanReduce())
+        {
+            _reduceInitFailed = !CreateReductionResources(InDevice);
+
+            if (_reduceInitFailed)
+                LOG_WARN("[{0}] Can't create reduction resources, auto depth scale disabled!", _name);
+        }
+
+        autoScale = CanReduce();
+    }
+
+    if (autoScale && _cpuReduceUavHandle[_counter].ptr == NULL)
+    {
+        _cpuReduceUavHandle[_counter] = _cpuCbvHandle[_counter];
+        _cpuReduceUavHandle[_counter].ptr += InDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+
+        _gpuReduceUavHandle[_counter] = _gpuCbvHandle[_counter];
+        _gpuReduceUavHandle[_counter].ptr += InDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+
+        // Raw view of min & max
+        D3D12_UNORDERED_ACCESS_VIEW_DESC reduceUavDesc = {};
+        reduceUavDesc.Format = DXGI_FORMAT_R32_TYPELESS;
+        reduceUavDesc.ViewDimension = D3D12_UAV_DIMENSION_BUFFER;
+        reduceUavDesc.Buffer.FirstElement = 0;
+        reduceUavDesc.Buffer.NumElements = 2;
+        reduceUavDesc.Buffer.Flags = D3D12_BUFFER_UAV_FLAG_RAW;
+        InDevice->CreateUnorderedAccessView(_minMaxBuffer, nullptr, &reduceUavDesc, _cpuReduceUavHandle[_counter]);
+    }
+
+    // Use results of earlier reductions, never waits for GPU
+    if (autoScale)
+        ReadbackMinMax();
+
+    uint32_t width = 0;
+    uint32_t height = 0;
+
+    if ((State::Instance().currentFeature->GetFeatureFlags() & NVSDK_NGX_DLSS_Feature_Flags_MVLowRes) == 0)
+    {
+        width = State::Instance().currentFeature->DisplayWidth();
+        height = State::Instance().currentFeature->DisplayHeight();
+    }
+    else
+    {
+        width = State::Instance().currentFeature->RenderWidth();
+        height = State::Instance().currentFeature->RenderHeight();
+    }
+
     auto inDesc = InResource->GetDesc();
     auto outDesc = OutResource->GetDesc();
 
@@ -187,7 +446,13 @@ bool DS_Dx12::Dispatch(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCmdL
 
     DSConstants constants{};
 
-    constants.DepthScale = Config::Instance()->FGDepthScaleMax.value_or_default();
+    if (autoScale && _autoScale > 0.0f)
+        constants.DepthScale = _autoScale;
+    else
+        constants.DepthScale = Config::Instance()->FGDepthScaleMax.value_or_default();
+
+    constants.Width = width;
+    constants.Height = height;
 
     // Copy the updated constant buffer data to the constant buffer resource
     BYTE* pCBDataBegin;
@@ -225,20 +490,23 @@ bool DS_Dx12::Dispatch(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCmdL
     InCmdList->SetComputeRootDescriptorTable(1, _gpuUavHandle[_counter]);
     InCmdList->SetComputeRootDescriptorTable(2, _gpuCbvHandle[_counter]);
 
-    UINT dispatchWidth = 0;
-    UINT dispatchHeight = 0;
-
-    if ((State::Instance().currentFeature->GetFeatureFlags() & NVSDK_NGX_DLSS_Feature_Flags_MVLowRes) == 0)
+    // Min/max reduction every N frames
+    if (autoScale)
     {
-        dispatchWidth = static_cast<UINT>((State::Instance().currentFeature->DisplayWidth() + InNumThreadsX - 1) / InNumThreadsX);
-        dispatchHeight = (State::Instance().currentFeature->DisplayHeight() + InNumThreadsY - 1) / InNumThreadsY;
-    }
-    else
-    {
-        dispatchWidth = static_cast<UINT>((State::Instance().currentFeature->RenderWidth() + InNumThreadsX - 1) / InNumThreadsX);
-        dispatchHeight = (State::Instance().currentFeature->RenderHeight() + InNumThreadsY - 1) / InNumThreadsY;
+        auto interval = (uint32_t)std::max(Config::Instance()->FGDepthScaleAutoInterval.value_or_default(), 1);
+
+        if ((_frameCounter++ % interval) == 0)
+        {
+            Reduce(InCmdList, width, height);
+
+            InCmdList->SetPipelineState(_pipelineState);
+            InCmdList->SetComputeRootDescriptorTable(1, _gpuUavHandle[_counter]);
+        }
     }
 
+    UINT dispatchWidth = static_cast<UINT>((width + InNumThreadsX - 1) / InNumThreadsX);
+    UINT dispatchHeight = (height + InNumThreadsY - 1) / InNumThreadsY;
+
     InCmdList->Dispatch(dispatchWidth, dispatchHeight, 1);
 
     return true;
@@ -405,7 +673,7 @@ DS_Dx12::DS_Dx12(std::string InName, ID3D12Device* InDevice) : _name(InName), _d
 
 
     D3D12_DESCRIPTOR_HEAP_DESC heapDesc = {};
-    heapDesc.NumDescriptors = 3; // SRV + UAV + CBV
+    heapDesc.NumDescriptors = 4; // SRV + UAV + CBV + Reduction UAV
     heapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
     heapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
 
@@ -511,4 +779,34 @@ DS_Dx12::~DS_Dx12()
         _constantBuffer->Release();
         _constantBuffer = nullptr;
     }
+
+    if (_reducePipelineState != nullptr)
+    {
+        _reducePipelineState->Release();
+        _reducePipelineState = nullptr;
+    }
+
+    if (_minMaxBuffer != nullptr)
+    {
+        _minMaxBuffer->Release();
+        _minMaxBuffer = nullptr;
+    }
+
+    if (_minMaxInitBuffer != nullptr)
+    {
+        _minMaxInitBuffer->Release();
+        _minMaxInitBuffer = nullptr;
+    }
+
+    if (_readbackBuffer != nullptr)
+    {
+        if (_readbackData != nullptr)
+        {
+            _readbackBuffer->Unmap(0, nullptr);
+            _readbackData = nullptr;
+        }
+
+        _readbackBuffer->Release();
+        _readbackBuffer = nullptr;
+    }
 }
\ No newline at end of file
@@ -21,6 +21,8 @@ private:
     D3D12_GPU_DESCRIPTOR_HANDLE _gpuSrvHandle[2]{ { NULL }, { NULL } };
     D3D12_GPU_DESCRIPTOR_HANDLE _gpuUavHandle[2]{ { NULL }, { NULL } };
     D3D12_GPU_DESCRIPTOR_HANDLE _gpuCbvHandle[2]{ { NULL }, { NULL } };
+    D3D12_CPU_DESCRIPTOR_HANDLE _cpuReduceUavHandle[2]{ { NULL }, { NULL } };
+    D3D12_GPU_DESCRIPTOR_HANDLE _gpuReduceUavHandle[2]{ { NULL }, { NULL } };
     int _counter = 0;
 
     uint32_t InNumThreadsX = 16;
@@ -31,6 +33,30 @@ private:
     ID3D12Resource* _constantBuffer = nullptr;
     D3D12_RESOURCE_STATES _bufferState = D3D12_RESOURCE_STATE_COMMON;
 
+    // Depth min/max reduction for automatic depth scale
+    static const uint32_t ReadbackRingSize = 4;
+
+    ID3D12PipelineState* _reducePipelineState = nullptr;
+    ID3D12Resource* _minMaxBuffer = nullptr;
+    ID3D12Resource* _minMaxInitBuffer = nullptr;
+    ID3D12Resource* _readbackBuffer = nullptr;
+    D3D12_RESOURCE_STATES _minMaxBufferState = D3D12_RESOURCE_STATE_COPY_DEST;
+    DSMinMaxReadback* _readbackData = nullptr;
+    uint32_t _readbackMarker[ReadbackRingSize]{};
+    uint32_t _reductionCounter = 0;
+    uint32_t _lastAppliedMarker = 0;
+    uint32_t _frameCounter = 0;
+    bool _reduceInitFailed = false;
+    float _autoScale = 0.0f;
+    float _lastMinDepth = 0.0f;
+    float _lastMaxDepth = 0.0f;
+
+    bool CreateReductionResources(ID3D12Device* InDevice);
+    void Reduce(ID3D12GraphicsCommandList* InCmdList, uint32_t InWidth, uint32_t InHeight);
+    void SetMinMaxBufferState(ID3D12GraphicsCommandList* InCommandList, D3D12_RESOURCE_STATES InState);
+    void ReadbackMinMax();
+    void UpdateAutoScale(float InMaxDepth);
+
 public:
     bool CreateBufferResource(ID3D12Device* InDevice, ID3D12Resource* InSource, uint32_t InWidth, uint32_t InHeight, D3D12_RESOURCE_STATES InState);
     void SetBufferState(ID3D12GraphicsCommandList* InCommandList, D3D12_RESOURCE_STATES InState);
@@ -39,6 +65,12 @@ public:
     ID3D12Resource* Buffer() { return _buffer; }
     bool IsInit() const { return _init; }
     bool CanRender() const { return _init && _buffer != nullptr; }
+    bool CanReduce() const { return _reducePipelineState != nullptr && _readbackData != nullptr; }
+
+    // Scale derived from depth reduction, 0 until first readback
+    float AutoScale() const { return _autoScale; }
+    float LastMinDepth() const { return _lastMinDepth; }
+    float LastMaxDepth() const { return _lastMaxDepth; }
 
     DS_Dx12(std::string InName, ID3D12Device* InDevice);
 
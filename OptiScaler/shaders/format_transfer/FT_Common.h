@@ -3,97 +3,135 @@
 #include <d3dcompiler.h>
 #include <DirectXMath.h>
 
-inline static std::string ftR10G10B10A2Code = R"(
-Texture2D<float4> SourceTexture : register(t0); 
-RWTexture2D<uint> DestinationTexture : register(u0); // R10G10B10A2_UNORM destination texture
-
-// Shader to perform the conversion
-[numthreads(512, 1, 1)]
-void CSMain(uint3 dispatchThreadID : SV_DispatchThreadID)
+// Destination packing, matches FT_DST_PACK define in shader
+enum FT_DestPack : uint32_t
 {
-    // Read from the source texture
-    float4 srcColor = SourceTexture.Load(int3(dispatchThreadID.xy, 0));
+    FT_Pack_R10G10B10A2 = 0,
+    FT_Pack_R8G8B8A8 = 1,
+    FT_Pack_B8G8R8A8 = 2,
+    FT_Pack_R16G16B16A16 = 3,
+    FT_Pack_Count
+};
+
+// Color transfer applied before packing, matches FT_TRANSFER define in shader
+enum FT_Transfer : uint32_t
+{
+    FT_Transfer_None = 0,
+    FT_Transfer_ScRgbToPq = 1,  // FP16 scRGB source -> HDR10 (Rec.2020 PQ) destination
+    FT_Transfer_PqToScRgb = 2,  // HDR10 (Rec.2020 PQ) source -> FP16 scRGB destination
+    FT_Transfer_Count
+};
+
+// Single source for every format transfer pipeline, shader_tools/build_ft_shader.bat precompiles it from here
+// Only compiled when precompiled shaders are missing, disabled or rejected by driver
+// Variants are selected with FT_DST_PACK and FT_TRANSFER defines
+// Uses 8x8 tiles so neighbouring threads touch neighbouring texels of both textures
+inline static std::string ftShaderCode = R"(
+#ifndef FT_DST_PACK
+#define FT_DST_PACK 0
+#endif
+
+#ifndef FT_TRANSFER
+#define FT_TRANSFER 0
+#endif
+
+Texture2D<float4> SourceTexture : register(t0);
+
+#if FT_DST_PACK == 3
+RWTexture2D<float4> DestinationTexture : register(u0);  // R16G16B16A16_FLOAT destination texture
+#else
+RWTexture2D<uint> DestinationTexture : register(u0);    // Packed 32bit destination texture
+#endif
+
+static const float3x3 Rec709ToRec2020 =
+{
+    0.6274040f, 0.3292820f, 0.0433136f,
+    0.0690970f, 0.9195400f, 0.0113612f,
+    0.0163916f, 0.0880132f, 0.8955950f
+};
 
-    // Clamp color channels to [0, 1] range, as R10G10B10A2_UNORM is normalized
-    srcColor = saturate(srcColor); // Ensures all values are between 0 and 1
+static const float3x3 Rec2020ToRec709 =
+{
+     1.6604910f, -0.5876411f, -0.0728499f,
+    -0.1245505f,  1.1328999f, -0.0083494f,
+    -0.0181508f, -0.1005789f,  1.1187297f
+};
 
-    // Convert each channel to its corresponding bit range
-    uint R = (uint)(srcColor.r * 1023.0f); // 10 bits for Red
-    uint G = (uint)(srcColor.g * 1023.0f); // 10 bits for Green
-    uint B = (uint)(srcColor.b * 1023.0f); // 10 bits for Blue
-    uint A = (uint)(srcColor.a * 3.0f);    // 2 bits for Alpha
+static const float PQ_m1 = 0.1593017578125f;
+static const float PQ_m2 = 78.84375f;
+static const float PQ_c1 = 0.8359375f;
+static const float PQ_c2 = 18.8515625f;
+static const float PQ_c3 = 18.6875f;
 
-    // Pack the values into a single 32-bit unsigned int
-    uint packedColor = R | G << 10 | B << 20 | A << 30;
+// scRGB 1.0 is 80 nits, PQ 1.0 is 10000 nits
+static const float ScRgbToPqScale = 80.0f / 10000.0f;
 
-    // Write the packed color to the destination texture
-    DestinationTexture[dispatchThreadID.xy] = packedColor;
+float3 PQEncode(float3 linearColor)
+{
+    float3 p = pow(saturate(linearColor), PQ_m1);
+    return pow((PQ_c1 + PQ_c2 * p) / (1.0f + PQ_c3 * p), PQ_m2);
 }
-)";
-
-inline static std::string ftR8G8B8A8Code = R"(
-Texture2D<float4> SourceTexture : register(t0); 
-RWTexture2D<uint> DestinationTexture : register(u0); // R8G8B8A8_UNORM destination texture
 
-// Shader to perform the conversion
-[numthreads(512, 1, 1)]
-void CSMain(uint3 dispatchThreadID : SV_DispatchThreadID)
+float3 PQDecode(float3 pqColor)
 {
-    // Read from the source texture
-    float4 srcColor = SourceTexture.Load(int3(dispatchThreadID.xy, 0));
-
-    // Clamp color channels to [0, 1] range, as R8G8B8A8_UNORM is normalized
-    srcColor = saturate(srcColor); // Ensures all values are between 0 and 1
-
-    // Convert each channel to its corresponding bit range
-    uint R = (uint)(srcColor.r * 255.0f); // 8 bits for Red
-    uint G = (uint)(srcColor.g * 255.0f); // 8 bits for Green
-    uint B = (uint)(srcColor.b * 255.0f); // 8 bits for Blue
-    uint A = (uint)(srcColor.a * 255.0f); // 8 bits for Alpha
-
-    // Pack the values into a single 32-bit unsigned int
-    uint packedColor = R | G << 8 | B << 16 | A << 24;
-
-    // Write the packed color to the destination texture
-    DestinationTexture[dispatchThreadID.xy] = packedColor;
+    float3 p = pow(saturate(pqColor), 1.0f / PQ_m2);
+    return pow(max(p - PQ_c1, 0.0f) / (PQ_c2 - PQ_c3 * p), 1.0f / PQ_m1);
 }
-)";
-
-inline static std::string ftB8G8R8A8Code = R"(
-Texture2D<float4> SourceTexture : register(t0); 
-RWTexture2D<uint> DestinationTexture : register(u0); // B8R8G8A8_UNORM destination texture
 
-// Shader to perform the conversion
-[numthreads(512, 1, 1)]
+[numthreads(8, 8, 1)]
 void CSMain(uint3 dispatchThreadID : SV_DispatchThreadID)
 {
-    // Read from the source texture
-    float4 srcColor = SourceTexture.Load(int3(dispatchThreadID.xy, 0));
+    uint width, height;
+    DestinationTexture.GetDimensions(width, height);
 
-    // Clamp color channels to [0, 1] range, as R8G8B8A8_UNORM is normalized
-    srcColor = saturate(srcColor); // Ensures all values are between 0 and 1
+    if (dispatchThreadID.x >= width || dispatchThreadID.y >= height)
+        return;
 
-    // Convert each channel to its corresponding bit range
-    uint R = (uint)(srcColor.r * 255.0f); // 8 bits for Red
-    uint G = (uint)(srcColor.g * 255.0f); // 8 bits for Green
-    uint B = (uint)(srcColor.b * 255.0f); // 8 bits for Blue
-    uint A = (uint)(srcColor.a * 255.0f); // 8 bits for Alpha
+    float4 srcColor = SourceTexture.Load(int3(dispatchThreadID.xy, 0));
 
-    // Pack the values into a single 32-bit unsigned int
-    uint packedColor = B | R << 8 | G << 16 | A << 24;
+#if FT_TRANSFER == 1
+    srcColor.rgb = PQEncode(mul(Rec709ToRec2020, srcColor.rgb) * ScRgbToPqScale);
+#elif FT_TRANSFER == 2
+    srcColor.rgb = mul(Rec2020ToRec709, PQDecode(srcColor.rgb)) / ScRgbToPqScale;
+#endif
+
+#if FT_DST_PACK == 3
+    DestinationTexture[dispatchThreadID.xy] = srcColor;
+#else
+    // Packed destinations are normalized
+    srcColor = saturate(srcColor);
+
+#if FT_DST_PACK == 0
+    uint R = (uint) (srcColor.r * 1023.0f + 0.5f);
+    uint G = (uint) (srcColor.g * 1023.0f + 0.5f);
+    uint B = (uint) (srcColor.b * 1023.0f + 0.5f);
+    uint A = (uint) (srcColor.a * 3.0f + 0.5f);
+    uint packedColor = R | G << 10 | B << 20 | A << 30;
+#elif FT_DST_PACK == 1
+    uint R = (uint) (srcColor.r * 255.0f + 0.5f);
+    uint G = (uint) (srcColor.g * 255.0f + 0.5f);
+    uint B = (uint) (srcColor.b * 255.0f + 0.5f);
+    uint A = (uint) (srcColor.a * 255.0f + 0.5f);
+    uint packedColor = R | G << 8 | B << 16 | A << 24;
+#else
+    uint R = (uint) (srcColor.r * 255.0f + 0.5f);
+    uint G = (uint) (srcColor.g * 255.0f + 0.5f);
+    uint B = (uint) (srcColor.b * 255.0f + 0.5f);
+    uint A = (uint) (srcColor.a * 255.0f + 0.5f);
+    uint packedColor = B | G << 8 | R << 16 | A << 24;
+#endif
 
-    // Write the packed color to the destination texture
     DestinationTexture[dispatchThreadID.xy] = packedColor;
+#endif
 }
 )";
 
-
-inline static ID3DBlob* FT_CompileShader(const char* shaderCode, const char* entryPoint, const char* target)
+inline static ID3DBlob* FT_CompileShader(const char* shaderCode, const char* entryPoint, const char* target, const D3D_SHADER_MACRO* defines = nullptr)
 {
     ID3DBlob* shaderBlob = nullptr;
     ID3DBlob* errorBlob = nullptr;
 
-    HRESULT hr = D3DCompile(shaderCode, strlen(shaderCode), nullptr, nullptr, nullptr, entryPoint, target, D3DCOMPILE_OPTIMIZATION_LEVEL3, 0, &shaderBlob, &errorBlob);
+    HRESULT hr = D3DCompile(shaderCode, strlen(shaderCode), nullptr, defines, nullptr, entryPoint, target, D3DCOMPILE_OPTIMIZATION_LEVEL3, 0, &shaderBlob, &errorBlob);
 
     if (FAILED(hr))
     {
@@ -115,4 +153,4 @@ inline static ID3DBlob* FT_CompileShader(const char* shaderCode, const char* ent
         errorBlob->Release();
 
     return shaderBlob;
-}
\ No newline at end of file
+}
@@ -1,10 +1,19 @@
 #include "FT_Dx12.h"
 
-#include "precompile/R10G10B10A2_Shader.h"
-#include "precompile/R8G8B8A8_Shader.h"
-#include "precompile/B8R8G8A8_Shader.h"
+// Generated from ftShaderCode by shader_tools/build_ft_shader.bat, named by FT_DST_PACK & FT_TRANSFER
+// All variants are generated together, without them every pipeline is compiled at runtime
+#if __has_include("precompile/FT_Shader_0_0.h")
+#define FT_PRECOMPILED
+#include "precompile/FT_Shader_0_0.h"
+#include "precompile/FT_Shader_0_1.h"
+#include "precompile/FT_Shader_1_0.h"
+#include "precompile/FT_Shader_2_0.h"
+#include "precompile/FT_Shader_3_0.h"
+#include "precompile/FT_Shader_3_2.h"
+#endif
 
 #include <Config.h>
+#include <misc/GpuProfiler_Dx12.h>
 
 inline static DXGI_FORMAT TranslateTypelessFormats(DXGI_FORMAT format)
 {
@@ -16,7 +25,7 @@ inline static DXGI_FORMAT TranslateTypelessFormats(DXGI_FORMAT format)
         case DXGI_FORMAT_R16G16B16A16_TYPELESS:
             return DXGI_FORMAT_R16G16B16A16_FLOAT;
         case DXGI_FORMAT_R10G10B10A2_TYPELESS:
-            return DXGI_FORMAT_R10G10B10A2_UINT;
+            return DXGI_FORMAT_R10G10B10A2_UNORM;
         case DXGI_FORMAT_R8G8B8A8_TYPELESS:
             return DXGI_FORMAT_R8G8B8A8_UNORM;
         case DXGI_FORMAT_B8G8R8A8_TYPELESS:
@@ -36,12 +45,37 @@ inline static DXGI_FORMAT TranslateTypelessFormats(DXGI_FORMAT format)
     }
 }
 
-static bool CreateComputeShader(ID3D12Device* device, ID3D12RootSignature* rootSignature, ID3D12PipelineState** pipelineState, ID3DBlob* shaderBlob)
+static D3D12_SHADER_BYTECODE PrecompiledShader(FT_DestPack InPack, FT_Transfer InTransfer)
+{
+#ifdef FT_PRECOMPILED
+    if (InPack == FT_Pack_R10G10B10A2 && InTransfer == FT_Transfer_None)
+        return CD3DX12_SHADER_BYTECODE(ft_0_0_cso, sizeof(ft_0_0_cso));
+
+    if (InPack == FT_Pack_R10G10B10A2 && InTransfer == FT_Transfer_ScRgbToPq)
+        return CD3DX12_SHADER_BYTECODE(ft_0_1_cso, sizeof(ft_0_1_cso));
+
+    if (InPack == FT_Pack_R8G8B8A8 && InTransfer == FT_Transfer_None)
+        return CD3DX12_SHADER_BYTECODE(ft_1_0_cso, sizeof(ft_1_0_cso));
+
+    if (InPack == FT_Pack_B8G8R8A8 && InTransfer == FT_Transfer_None)
+        return CD3DX12_SHADER_BYTECODE(ft_2_0_cso, sizeof(ft_2_0_cso));
+
+    if (InPack == FT_Pack_R16G16B16A16 && InTransfer == FT_Transfer_None)
+        return CD3DX12_SHADER_BYTECODE(ft_3_0_cso, sizeof(ft_3_0_cso));
+
+    if (InPack == FT_Pack_R16G16B16A16 && InTransfer == FT_Transfer_PqToScRgb)
+        return CD3DX12_SHADER_BYTECODE(ft_3_2_cso, sizeof(ft_3_2_cso));
+#endif
+
+    return {};
+}
+
+static bool CreateComputeShader(ID3D12Device* device, ID3D12RootSignature* rootSignature, ID3D12PipelineState** pipelineState, D3D12_SHADER_BYTECODE shader)
 {
     D3D12_COMPUTE_PIPELINE_STATE_DESC psoDesc = {};
     psoDesc.pRootSignature = rootSignature;
     psoDesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
-    psoDesc.CS = CD3DX12_SHADER_BYTECODE(shaderBlob->GetBufferPointer(), shaderBlob->GetBufferSize());
+    psoDesc.CS = shader;
 
     HRESULT hr = device->CreateComputePipelineState(&psoDesc, __uuidof(ID3D12PipelineState*), (void**)pipelineState);
 
@@ -54,7 +88,120 @@ static bool CreateComputeShader(ID3D12Device* device, ID3D12RootSignature* rootS
     return true;
 }
 
-bool FT_Dx12::CreateBufferResource(ID3D12Device* InDevice, ID3D12Resource* InSource, D3D12_RESOURCE_STATES InState)
+
+FT_DestPack FT_Dx12::DestPack(DXGI_FORMAT InFormat)
+{
+    switch (InFormat)
+    {
+        case DXGI_FORMAT_R10G10B10A2_UNORM:
+        case DXGI_FORMAT_R10G10B10A2_TYPELESS:
+            return FT_Pack_R10G10B10A2;
+
+        case DXGI_FORMAT_R8G8B8A8_UNORM:
+        case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+        case DXGI_FORMAT_R8G8B8A8_TYPELESS:
+            return FT_Pack_R8G8B8A8;
+
+        case DXGI_FORMAT_B8G8R8A8_UNORM:
+        case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+        case DXGI_FORMAT_B8G8R8A8_TYPELESS:
+            return FT_Pack_B8G8R8A8;
+
+        case DXGI_FORMAT_R16G16B16A16_FLOAT:
+        case DXGI_FORMAT_R16G16B16A16_TYPELESS:
+            return FT_Pack_R16G16B16A16;
+
+        default:
+            return FT_Pack_Count;
+    }
+}
+
+static bool IsFloatFormat(DXGI_FORMAT InFormat)
+{
+    switch (InFormat)
+    {
+        case DXGI_FORMAT_R16G16B16A16_FLOAT:
+        case DXGI_FORMAT_R16G16B16A16_TYPELESS:
+        case DXGI_FORMAT_R11G11B10_FLOAT:
+        case DXGI_FORMAT_R32G32B32A32_FLOAT:
+        case DXGI_FORMAT_R32G32B32A32_TYPELESS:
+        case DXGI_FORMAT_R32G32B32_FLOAT:
+        case DXGI_FORMAT_R32G32B32_TYPELESS:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+FT_Transfer FT_Dx12::Transfer(DXGI_FORMAT InSourceFormat, DXGI_FORMAT InDestFormat)
+{
+    if (!State::Instance().isHdrActive)
+        return FT_Transfer_None;
+
+    auto pack = DestPack(InDestFormat);
+
+    // scRGB hudless to HDR10 swapchain
+    if (pack == FT_Pack_R10G10B10A2 && IsFloatFormat(InSourceFormat))
+        return FT_Transfer_ScRgbToPq;
+
+    // HDR10 hudless to scRGB swapchain
+    if (pack == FT_Pack_R16G16B16A16 && DestPack(InSourceFormat) == FT_Pack_R10G10B10A2)
+        return FT_Transfer_PqToScRgb;
+
+    return FT_Transfer_None;
+}
+
+bool FT_Dx12::IsSourceSupported(DXGI_FORMAT InFormat)
+{
+    return IsFloatFormat(InFormat) || DestPack(InFormat) != FT_Pack_Count;
+}
+
+bool FT_Dx12::CreatePipeline(ID3D12Device* InDevice, FT_DestPack InPack, FT_Transfer InTransfer)
+{
+    auto packStr = std::to_string((uint32_t)InPack);
+    auto transferStr = std::to_string((uint32_t)InTransfer);
+
+    if (Config::Instance()->UsePrecompiledShaders.value_or_default())
+    {
+        auto shader = PrecompiledShader(InPack, InTransfer);
+
+        if (shader.BytecodeLength > 0)
+        {
+            if (CreateComputeShader(InDevice, _rootSignature, &_pipelineStates[InPack][InTransfer], shader))
+                return true;
+
+            LOG_WARN("[{0}] Precompiled shader failed, compiling it, pack: {1}, transfer: {2}", _name, packStr, transferStr);
+        }
+    }
+
+    // Fallback, same source as precompiled variants
+    D3D_SHADER_MACRO defines[] =
+    {
+        { "FT_DST_PACK", packStr.c_str() },
+        { "FT_TRANSFER", transferStr.c_str() },
+        { nullptr, nullptr }
+    };
+
+    auto shaderBlob = FT_CompileShader(ftShaderCode.c_str(), "CSMain", "cs_5_0", defines);
+
+    if (shaderBlob == nullptr)
+    {
+        LOG_ERROR("[{0}] CompileShader error, pack: {1}, transfer: {2}", _name, packStr, transferStr);
+        return false;
+    }
+
+    auto result = CreateComputeShader(InDevice, _rootSignature, &_pipelineStates[InPack][InTransfer],
+                                      CD3DX12_SHADER_BYTECODE(shaderBlob->GetBufferPointer(), shaderBlob->GetBufferSize()));
+    shaderBlob->Release();
+
+    if (!result)
+        LOG_ERROR("[{0}] CreateComputeShader error, pack: {1}, transfer: {2}", _name, packStr, transferStr);
+
+    return result;
+}
+
+bool FT_Dx12::CreateBufferResource(ID3D12Device* InDevice, ID3D12Resource* InSource, DXGI_FORMAT InFormat, D3D12_RESOURCE_STATES InState)
 {
     if (InDevice == nullptr || InSource == nullptr)
         return false;
@@ -67,7 +214,7 @@ bool FT_Dx12::CreateBufferResource(ID3D12Device* InDevice, ID3D12Resource* InSou
     {
         auto bufDesc = _buffer->GetDesc();
 
-        if (bufDesc.Width != texDesc.Width || bufDesc.Height != texDesc.Height || bufDesc.Format != format)
+        if (bufDesc.Width != texDesc.Width || bufDesc.Height != texDesc.Height || bufDesc.Format != InFormat)
         {
             _buffer->Release();
             _buffer = nullptr;
@@ -78,7 +225,7 @@ bool FT_Dx12::CreateBufferResource(ID3D12Device* InDevice, ID3D12Resource* InSou
 
     LOG_DEBUG("[{0}] Start!", _name);
 
-    LOG_INFO("Texture Format: {}", (UINT)texDesc.Format);
+    LOG_INFO("Texture Format: {}, Buffer Format: {}", (UINT)texDesc.Format, (UINT)InFormat);
 
     D3D12_HEAP_PROPERTIES heapProperties;
     D3D12_HEAP_FLAGS heapFlags;
@@ -90,7 +237,7 @@ bool FT_Dx12::CreateBufferResource(ID3D12Device* InDevice, ID3D12Resource* InSou
         return false;
     }
 
-    texDesc.Format = format;
+    texDesc.Format = InFormat;
     texDesc.Flags |= D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET | D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
 
     hr = InDevice->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &texDesc, InState, nullptr, IID_PPV_ARGS(&_buffer));
@@ -104,11 +251,11 @@ bool FT_Dx12::CreateBufferResource(ID3D12Device* InDevice, ID3D12Resource* InSou
 
     _buffer->SetName(L"HUDless_Buffer");
     _bufferState = InState;
+    format = InFormat;
 
     return true;
 }
 
-
 void FT_Dx12::SetBufferState(ID3D12GraphicsCommandList* InCommandList, D3D12_RESOURCE_STATES InState)
 {
     if (_bufferState == InState)
@@ -131,6 +278,26 @@ bool FT_Dx12::Dispatch(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCmdL
 
     LOG_DEBUG("[{0}] Start!", _name);
 
+    auto inDesc = InResource->GetDesc();
+    auto outDesc = OutResource->GetDesc();
+
+    auto pack = DestPack(outDesc.Format);
+
+    if (pack == FT_Pack_Count || !IsSourceSupported(inDesc.Format))
+    {
+        LOG_ERROR("[{0}] Unsupported format pair {1} -> {2}", _name, (UINT)inDesc.Format, (UINT)outDesc.Format);
+        return false;
+    }
+
+    auto transfer = Transfer(inDesc.Format, outDesc.Format);
+    auto pipelineState = _pipelineStates[pack][transfer];
+
+    if (pipelineState == nullptr)
+    {
+        LOG_ERROR("[{0}] No pipeline for pack: {1}, transfer: {2}", _name, (UINT)pack, (UINT)transfer);
+        return false;
+    }
+
     _counter++;
     _counter = _counter % 2;
 
@@ -152,9 +319,6 @@ bool FT_Dx12::Dispatch(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCmdL
         _gpuUavHandle[_counter].ptr += InDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
     }
 
-    auto inDesc = InResource->GetDesc();
-    auto outDesc = OutResource->GetDesc();
-
     // Create SRV for Input Texture
     D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
     srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
@@ -167,7 +331,7 @@ bool FT_Dx12::Dispatch(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCmdL
 
     // Create UAV for Output Texture
     D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
-    uavDesc.Format = DXGI_FORMAT_R32_UINT;
+    uavDesc.Format = pack == FT_Pack_R16G16B16A16 ? DXGI_FORMAT_R16G16B16A16_FLOAT : DXGI_FORMAT_R32_UINT;
     uavDesc.ViewDimension = D3D12_UAV_DIMENSION_TEXTURE2D;
     uavDesc.Texture2D.MipSlice = 0;
     InDevice->CreateUnorderedAccessView(OutResource, nullptr, &uavDesc, _cpuUavHandle[_counter]);
@@ -176,23 +340,22 @@ bool FT_Dx12::Dispatch(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCmdL
     InCmdList->SetDescriptorHeaps(_countof(heaps), heaps);
 
     InCmdList->SetComputeRootSignature(_rootSignature);
-    InCmdList->SetPipelineState(_pipelineState);
+    InCmdList->SetPipelineState(pipelineState);
 
     InCmdList->SetComputeRootDescriptorTable(0, _gpuSrvHandle[_counter]);
     InCmdList->SetComputeRootDescriptorTable(1, _gpuUavHandle[_counter]);
 
-    UINT dispatchWidth = 0;
-    UINT dispatchHeight = 0;
-
-    dispatchWidth = static_cast<UINT>((State::Instance().currentFeature->DisplayWidth() + InNumThreadsX - 1) / InNumThreadsX);
-    dispatchHeight = (State::Instance().currentFeature->DisplayHeight() + InNumThreadsY - 1) / InNumThreadsY;
+    UINT dispatchWidth = static_cast<UINT>((outDesc.Width + InNumThreadsX - 1) / InNumThreadsX);
+    UINT dispatchHeight = (outDesc.Height + InNumThreadsY - 1) / InNumThreadsY;
 
+    GpuProfiler_Dx12::Begin(InDevice, InCmdList, GpuPass::FormatTransfer);
     InCmdList->Dispatch(dispatchWidth, dispatchHeight, 1);
+    GpuProfiler_Dx12::End(InCmdList, GpuPass::FormatTransfer);
 
     return true;
 }
 
-FT_Dx12::FT_Dx12(std::string InName, ID3D12Device* InDevice, DXGI_FORMAT InFormat) : _name(InName), _device(InDevice), format(InFormat)
+FT_Dx12::FT_Dx12(std::string InName, ID3D12Device* InDevice) : _name(InName), _device(InDevice)
 {
     if (InDevice == nullptr)
     {
@@ -286,83 +449,16 @@ FT_Dx12::FT_Dx12(std::string InName, ID3D12Device* InDevice, DXGI_FORMAT InForma
         return;
     }
 
-    // Compile shader blobs
-    ID3DBlob* _recEncodeShader = nullptr;
-
-    if (Config::Instance()->UsePrecompiledShaders.value_or_default())
-    {
-        D3D12_COMPUTE_PIPELINE_STATE_DESC computePsoDesc = {};
-        computePsoDesc.pRootSignature = _rootSignature;
-        computePsoDesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
-
-        if (InFormat == DXGI_FORMAT_R10G10B10A2_UNORM || InFormat == DXGI_FORMAT_R10G10B10A2_TYPELESS || 
-            InFormat == DXGI_FORMAT_R16G16B16A16_FLOAT || InFormat == DXGI_FORMAT_R16G16B16A16_TYPELESS || 
-            InFormat == DXGI_FORMAT_R11G11B10_FLOAT || 
-            InFormat == DXGI_FORMAT_R32G32B32A32_FLOAT || InFormat == DXGI_FORMAT_R32G32B32A32_TYPELESS ||
-            InFormat == DXGI_FORMAT_R32G32B32_FLOAT || InFormat == DXGI_FORMAT_R32G32B32_TYPELESS)
-        {
-            computePsoDesc.CS = CD3DX12_SHADER_BYTECODE(reinterpret_cast<const void*>(r10g10b10a2_cso), sizeof(r10g10b10a2_cso));
-        }
-        else if (InFormat == DXGI_FORMAT_R8G8B8A8_TYPELESS || InFormat == DXGI_FORMAT_R8G8B8A8_UNORM || InFormat == DXGI_FORMAT_R8G8B8A8_UNORM_SRGB)
-        {
-            computePsoDesc.CS = CD3DX12_SHADER_BYTECODE(reinterpret_cast<const void*>(r8g8b8a8_cso), sizeof(r8g8b8a8_cso));
-        }
-        else if (InFormat == DXGI_FORMAT_B8G8R8A8_TYPELESS || InFormat == DXGI_FORMAT_B8G8R8A8_UNORM || InFormat == DXGI_FORMAT_B8G8R8A8_UNORM_SRGB)
-        {
-            computePsoDesc.CS = CD3DX12_SHADER_BYTECODE(reinterpret_cast<const void*>(b8r8g8a8_cso), sizeof(b8r8g8a8_cso));
-        }
-        else
-        {
-            LOG_ERROR("[{0}] texture format is not found!", _name);
-            return;
-        }
-
-        auto hr = InDevice->CreateComputePipelineState(&computePsoDesc, __uuidof(ID3D12PipelineState*), (void**)&_pipelineState);
-
-        if (FAILED(hr))
-        {
-            LOG_ERROR("[{0}] CreateComputePipelineState error: {1:X}", _name, hr);
-            return;
-        }
-    }
-    else
+    // Build every pipeline once, only HDR pairs need a color transfer
+    if (!CreatePipeline(InDevice, FT_Pack_R10G10B10A2, FT_Transfer_None) ||
+        !CreatePipeline(InDevice, FT_Pack_R10G10B10A2, FT_Transfer_ScRgbToPq) ||
+        !CreatePipeline(InDevice, FT_Pack_R8G8B8A8, FT_Transfer_None) ||
+        !CreatePipeline(InDevice, FT_Pack_B8G8R8A8, FT_Transfer_None) ||
+        !CreatePipeline(InDevice, FT_Pack_R16G16B16A16, FT_Transfer_None) ||
+        !CreatePipeline(InDevice, FT_Pack_R16G16B16A16, FT_Transfer_PqToScRgb))
     {
-        if (InFormat == DXGI_FORMAT_R10G10B10A2_UNORM)
-        {
-            _recEncodeShader = FT_CompileShader(ftR10G10B10A2Code.c_str(), "CSMain", "cs_5_0");
-        }
-        else if (InFormat == DXGI_FORMAT_R8G8B8A8_UNORM || InFormat == DXGI_FORMAT_R8G8B8A8_UNORM_SRGB)
-        {
-            _recEncodeShader = FT_CompileShader(ftR8G8B8A8Code.c_str(), "CSMain", "cs_5_0");
-        }
-        else if (InFormat == DXGI_FORMAT_B8G8R8A8_UNORM)
-        {
-            _recEncodeShader = FT_CompileShader(ftB8G8R8A8Code.c_str(), "CSMain", "cs_5_0");
-        }
-        else
-        {
-            LOG_ERROR("[{0}] texture format is not found!", _name);
-            return;
-        }
-
-        if (_recEncodeShader == nullptr)
-        {
-            LOG_ERROR("[{0}] CompileShader error!", _name);
-            return;
-        }
-
-        // create pso objects
-        if (!CreateComputeShader(InDevice, _rootSignature, &_pipelineState, _recEncodeShader))
-        {
-            LOG_ERROR("[{0}] CreateComputeShader error!", _name);
-            return;
-        }
-
-        if (_recEncodeShader != nullptr)
-        {
-            _recEncodeShader->Release();
-            _recEncodeShader = nullptr;
-        }
+        LOG_ERROR("[{0}] Can't create pipelines!", _name);
+        return;
     }
 
     D3D12_DESCRIPTOR_HEAP_DESC heapDesc = {};
@@ -397,24 +493,6 @@ FT_Dx12::FT_Dx12(std::string InName, ID3D12Device* InDevice, DXGI_FORMAT InForma
     _init = _srvHeap[2] != nullptr;
 }
 
-bool FT_Dx12::IsFormatCompatible(DXGI_FORMAT InFormat)
-{
-    if (format == DXGI_FORMAT_R10G10B10A2_UNORM || format == DXGI_FORMAT_R10G10B10A2_TYPELESS)
-    {
-        return InFormat == DXGI_FORMAT_R10G10B10A2_UNORM || InFormat == DXGI_FORMAT_R10G10B10A2_TYPELESS;
-    }
-    else if (format == DXGI_FORMAT_R8G8B8A8_UNORM || format == DXGI_FORMAT_R8G8B8A8_UNORM_SRGB || format == DXGI_FORMAT_R8G8B8A8_TYPELESS)
-    {
-        return InFormat == DXGI_FORMAT_R8G8B8A8_UNORM || InFormat == DXGI_FORMAT_R8G8B8A8_UNORM_SRGB || InFormat == DXGI_FORMAT_R8G8B8A8_TYPELESS;
-    }
-    else if (format == DXGI_FORMAT_B8G8R8A8_UNORM)
-    {
-        return InFormat == DXGI_FORMAT_B8G8R8A8_UNORM;
-    }
-
-    return false;
-}
-
 FT_Dx12::~FT_Dx12()
 {
     if (!_init || State::Instance().isShuttingDown)
@@ -445,10 +523,16 @@ FT_Dx12::~FT_Dx12()
         d3d12Fence = nullptr;
     }
 
-    if (_pipelineState != nullptr)
+    for (size_t i = 0; i < FT_Pack_Count; i++)
     {
-        _pipelineState->Release();
-        _pipelineState = nullptr;
+        for (size_t j = 0; j < FT_Transfer_Count; j++)
+        {
+            if (_pipelineStates[i][j] != nullptr)
+            {
+                _pipelineStates[i][j]->Release();
+                _pipelineStates[i][j] = nullptr;
+            }
+        }
     }
 
     if (_rootSignature != nullptr)
@@ -7,13 +7,16 @@
 #include <d3d12.h>
 #include <d3dx/d3dx12.h>
 
+// Format transfer engine
+// Pipelines for every supported destination packing / color transfer pair are created once,
+// the matching one is selected on each dispatch from source & destination formats
 class FT_Dx12
 {
 private:
     std::string _name = "";
     bool _init = false;
     ID3D12RootSignature* _rootSignature = nullptr;
-    ID3D12PipelineState* _pipelineState = nullptr;
+    ID3D12PipelineState* _pipelineStates[FT_Pack_Count][FT_Transfer_Count]{};
     ID3D12DescriptorHeap* _srvHeap[3] = { nullptr, nullptr, nullptr };
     D3D12_CPU_DESCRIPTOR_HANDLE _cpuSrvHandle[2]{ { NULL }, { NULL } };
     D3D12_CPU_DESCRIPTOR_HANDLE _cpuUavHandle[2]{ { NULL }, { NULL } };
@@ -21,16 +24,25 @@ private:
     D3D12_GPU_DESCRIPTOR_HANDLE _gpuUavHandle[2]{ { NULL }, { NULL } };
     int _counter = 0;
 
-    uint32_t InNumThreadsX = 512;
-    uint32_t InNumThreadsY = 1;
+    uint32_t InNumThreadsX = 8;
+    uint32_t InNumThreadsY = 8;
 
     ID3D12Device* _device = nullptr;
     ID3D12Resource* _buffer = nullptr;
     D3D12_RESOURCE_STATES _bufferState = D3D12_RESOURCE_STATE_COMMON;
-    DXGI_FORMAT format;
+    DXGI_FORMAT format = DXGI_FORMAT_UNKNOWN;
+
+    bool CreatePipeline(ID3D12Device* InDevice, FT_DestPack InPack, FT_Transfer InTransfer);
 
 public:
-    bool CreateBufferResource(ID3D12Device* InDevice, ID3D12Resource* InSource, D3D12_RESOURCE_STATES InState);
+    // Maps a format to destination packing, returns FT_Pack_Count for unsupported formats
+    static FT_DestPack DestPack(DXGI_FORMAT InFormat);
+    static FT_Transfer Transfer(DXGI_FORMAT InSourceFormat, DXGI_FORMAT InDestFormat);
+    static bool IsSourceSupported(DXGI_FORMAT InFormat);
+    static bool IsDestinationSupported(DXGI_FORMAT InFormat) { return DestPack(InFormat) != FT_Pack_Count; }
+
+    // Creates (or reuses) the output buffer with source dimensions and InFormat
+    bool CreateBufferResource(ID3D12Device* InDevice, ID3D12Resource* InSource, DXGI_FORMAT InFormat, D3D12_RESOURCE_STATES InState);
     void SetBufferState(ID3D12GraphicsCommandList* InCommandList, D3D12_RESOURCE_STATES InState);
     bool Dispatch(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCmdList, ID3D12Resource* InResource, ID3D12Resource* OutResource);
 
@@ -39,9 +51,7 @@ public:
     bool CanRender() const { return _init && _buffer != nullptr; }
     DXGI_FORMAT Format() const { return format; }
 
-    FT_Dx12(std::string InName, ID3D12Device* InDevice, DXGI_FORMAT InFormat);
-    
-    bool IsFormatCompatible(DXGI_FORMAT InFormat);
+    FT_Dx12(std::string InName, ID3D12Device* InDevice);
 
     ~FT_Dx12();
-};
\ No newline at end of file
+};
@@ -12,6 +12,7 @@
 
 #include <shaders/fsr1/ffx_fsr1.h>
 #include <shaders/fsr1/FSR_EASU_Shader.h>
+#include <misc/GpuProfiler_Dx12.h>
 
 #include <Config.h>
 
@@ -253,7 +254,9 @@ bool OS_Dx12::Dispatch(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCmdL
     //    dispatchHeight = (State::Instance().currentFeature->TargetHeight() + InNumThreadsY - 1) / InNumThreadsY;
     //}
 
+    GpuProfiler_Dx12::Begin(InDevice, InCmdList, GpuPass::OutputScaling);
     InCmdList->Dispatch(dispatchWidth, dispatchHeight, 1);
+    GpuProfiler_Dx12::End(InCmdList, GpuPass::OutputScaling);
 
     return true;
 }
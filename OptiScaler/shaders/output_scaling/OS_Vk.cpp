@@ -0,0 +1,88 @@
+#include "OS_Vk.h"
+
+// Generated from precompile/*.hlsl by shader_tools/build_precompiled_shader.bat
+#if __has_include("precompile/BCUS_Shader_Vk.h")
+#include "precompile/bcds_lanczos_Shader_Vk.h"
+#include "precompile/bcds_catmull_Shader_Vk.h"
+#include "precompile/bcds_bicubic_Shader_Vk.h"
+#include "precompile/bcds_magc_Shader_Vk.h"
+
+#include "precompile/BCUS_Shader_Vk.h"
+#define OS_SPIRV_AVAILABLE
+#else
+#pragma message("*_Shader_Vk.h headers are missing, Vulkan output scaling is disabled. Run shader_tools/build_precompiled_shader.bat in shaders/output_scaling/precompile")
+#endif
+
+#include <Config.h>
+
+bool OS_Vk::Dispatch(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Resource_VK* InResource, NVSDK_NGX_Resource_VK* OutResource)
+{
+    if (!_init || InCmdBuffer == VK_NULL_HANDLE || InResource == nullptr || OutResource == nullptr || State::Instance().currentFeature == nullptr)
+        return false;
+
+    LOG_DEBUG("[{0}] Start!", _name);
+
+    Constants constants{};
+    constants.srcWidth = State::Instance().currentFeature->TargetWidth();
+    constants.srcHeight = State::Instance().currentFeature->TargetHeight();
+    constants.destWidth = State::Instance().currentFeature->DisplayWidth();
+    constants.destHeight = State::Instance().currentFeature->DisplayHeight();
+
+    if (!Prepare(&constants, sizeof(constants), InResource->Resource.ImageViewInfo.ImageView, VK_IMAGE_LAYOUT_GENERAL, VK_NULL_HANDLE,
+                 OutResource->Resource.ImageViewInfo.ImageView))
+    {
+        LOG_ERROR("[{0}] Can't prepare descriptors!", _name);
+        return false;
+    }
+
+    uint32_t dispatchWidth = (State::Instance().currentFeature->DisplayWidth() + InNumThreadsX - 1) / InNumThreadsX;
+    uint32_t dispatchHeight = (State::Instance().currentFeature->DisplayHeight() + InNumThreadsY - 1) / InNumThreadsY;
+
+    Shader_Vk::Dispatch(InCmdBuffer, OutResource->Resource.ImageViewInfo.Image, GpuPass::OutputScaling, dispatchWidth, dispatchHeight);
+
+    return true;
+}
+
+OS_Vk::OS_Vk(std::string InName, VkDevice InDevice, VkPhysicalDevice InPD, bool InUpsample) : Shader_Vk(InName, InDevice, InPD), _upsample(InUpsample)
+{
+    if (InDevice == VK_NULL_HANDLE || InPD == VK_NULL_HANDLE)
+    {
+        LOG_ERROR("InDevice or InPD is null!");
+        return;
+    }
+
+    LOG_DEBUG("{0} start!", _name);
+
+    // FSR1 EASU needs a sampler & its own constants, only bicubic/downscalers are ported
+    if (Config::Instance()->OutputScalingUseFsr.value_or_default())
+        LOG_WARN("[{0}] FSR1 scaling is not available for Vulkan, using bicubic", _name);
+
+#ifndef OS_SPIRV_AVAILABLE
+    LOG_ERROR("[{0}] Built without SPIR-V shaders, output scaling is not available", _name);
+#else
+    if (_upsample)
+    {
+        _init = CreatePipeline(BCUS_spv, sizeof(BCUS_spv), false, sizeof(Constants), InNumThreadsX, InNumThreadsY);
+        return;
+    }
+
+    switch (Config::Instance()->OutputScalingDownscaler.value_or_default())
+    {
+        case 1:
+            _init = CreatePipeline(bcds_lanczos_spv, sizeof(bcds_lanczos_spv), false, sizeof(Constants), InNumThreadsX, InNumThreadsY);
+            break;
+
+        case 2:
+            _init = CreatePipeline(bcds_catmull_spv, sizeof(bcds_catmull_spv), false, sizeof(Constants), InNumThreadsX, InNumThreadsY);
+            break;
+
+        case 3:
+            _init = CreatePipeline(bcds_magc_spv, sizeof(bcds_magc_spv), false, sizeof(Constants), InNumThreadsX, InNumThreadsY);
+            break;
+
+        default:
+            _init = CreatePipeline(bcds_bicubic_spv, sizeof(bcds_bicubic_spv), false, sizeof(Constants), InNumThreadsX, InNumThreadsY);
+            break;
+    }
+#endif
+}
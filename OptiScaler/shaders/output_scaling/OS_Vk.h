@@ -0,0 +1,24 @@
+#pragma once
+
+#include <pch.h>
+
+#include "OS_Common.h"
+
+#include <shaders/Shader_Vk.h>
+
+class OS_Vk : public Shader_Vk
+{
+private:
+    bool _upsample = false;
+
+    uint32_t InNumThreadsX = 16;
+    uint32_t InNumThreadsY = 16;
+
+public:
+    // InResource is sampled in GENERAL layout
+    bool Dispatch(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Resource_VK* InResource, NVSDK_NGX_Resource_VK* OutResource);
+
+    bool IsUpsampling() { return _upsample; }
+
+    OS_Vk(std::string InName, VkDevice InDevice, VkPhysicalDevice InPD, bool InUpsample);
+};
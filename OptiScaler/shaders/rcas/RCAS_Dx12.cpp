@@ -3,6 +3,7 @@
 #include "precompile/RCAS_Shader.h"
 
 #include <Config.h>
+#include <misc/GpuProfiler_Dx12.h>
 
 inline static DXGI_FORMAT TranslateTypelessFormats(DXGI_FORMAT format)
 {
@@ -270,7 +271,9 @@ bool RCAS_Dx12::Dispatch(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCm
 	dispatchWidth = (inDesc.Width + InNumThreadsX - 1) / InNumThreadsX;
 	dispatchHeight = (inDesc.Height + InNumThreadsY - 1) / InNumThreadsY;
 
+	GpuProfiler_Dx12::Begin(InDevice, InCmdList, GpuPass::RCAS);
 	InCmdList->Dispatch(dispatchWidth, dispatchHeight, 1);
+	GpuProfiler_Dx12::End(InCmdList, GpuPass::RCAS);
 
 	return true;
 }
@@ -0,0 +1,70 @@
+#include "RCAS_Vk.h"
+
+// Generated from precompile/rcas.hlsl by shader_tools/build_precompiled_shader.bat
+#if __has_include("precompile/RCAS_Shader_Vk.h")
+#include "precompile/RCAS_Shader_Vk.h"
+#define RCAS_SPIRV_AVAILABLE
+#else
+#pragma message("RCAS_Shader_Vk.h is missing, Vulkan RCAS is disabled. Run shader_tools/build_precompiled_shader.bat rcas in shaders/rcas/precompile")
+#endif
+
+#include <Config.h>
+
+bool RCAS_Vk::Dispatch(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Resource_VK* InResource, NVSDK_NGX_Resource_VK* InMotionVectors, RcasConstants InConstants, NVSDK_NGX_Resource_VK* OutResource)
+{
+	if (!_init || InCmdBuffer == VK_NULL_HANDLE || InResource == nullptr || InMotionVectors == nullptr || OutResource == nullptr)
+		return false;
+
+	LOG_DEBUG("[{0}] Start!", _name);
+
+	InternalConstants constants{};
+	constants.DisplayHeight = InConstants.DisplayHeight;
+	constants.DisplayWidth = InConstants.DisplayWidth;
+	constants.DynamicSharpenEnabled = Config::Instance()->MotionSharpnessEnabled.value_or_default() ? 1 : 0;
+	constants.MotionSharpness = Config::Instance()->MotionSharpness.value_or_default();
+	constants.MvScaleX = InConstants.MvScaleX;
+	constants.MvScaleY = InConstants.MvScaleY;
+	constants.Sharpness = InConstants.Sharpness;
+	constants.Debug = Config::Instance()->MotionSharpnessDebug.value_or_default() ? 1 : 0;
+	constants.Threshold = Config::Instance()->MotionThreshold.value_or_default();
+	constants.ScaleLimit = Config::Instance()->MotionScaleLimit.value_or_default();
+	constants.DisplaySizeMV = InConstants.DisplaySizeMV ? 1 : 0;
+
+	if (InConstants.RenderWidth == 0 || InConstants.DisplayWidth == 0)
+		constants.MotionTextureScale = 1.0f;
+	else
+		constants.MotionTextureScale = (float)InConstants.RenderWidth / (float)InConstants.DisplayWidth;
+
+	auto& inInfo = InResource->Resource.ImageViewInfo;
+
+	if (!Prepare(&constants, sizeof(constants), inInfo.ImageView, VK_IMAGE_LAYOUT_GENERAL, InMotionVectors->Resource.ImageViewInfo.ImageView,
+				 OutResource->Resource.ImageViewInfo.ImageView))
+	{
+		LOG_ERROR("[{0}] Can't prepare descriptors!", _name);
+		return false;
+	}
+
+	uint32_t dispatchWidth = (inInfo.Width + InNumThreadsX - 1) / InNumThreadsX;
+	uint32_t dispatchHeight = (inInfo.Height + InNumThreadsY - 1) / InNumThreadsY;
+
+	Shader_Vk::Dispatch(InCmdBuffer, OutResource->Resource.ImageViewInfo.Image, GpuPass::RCAS, dispatchWidth, dispatchHeight);
+
+	return true;
+}
+
+RCAS_Vk::RCAS_Vk(std::string InName, VkDevice InDevice, VkPhysicalDevice InPD) : Shader_Vk(InName, InDevice, InPD)
+{
+	if (InDevice == VK_NULL_HANDLE || InPD == VK_NULL_HANDLE)
+	{
+		LOG_ERROR("InDevice or InPD is null!");
+		return;
+	}
+
+	LOG_DEBUG("{0} start!", _name);
+
+#ifdef RCAS_SPIRV_AVAILABLE
+	_init = CreatePipeline(rcas_spv, sizeof(rcas_spv), true, sizeof(InternalConstants), InNumThreadsX, InNumThreadsY);
+#else
+	LOG_ERROR("[{0}] Built without SPIR-V shader, RCAS is not available", _name);
+#endif
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <pch.h>
+
+#include "RCAS_Common.h"
+
+#include <shaders/Shader_Vk.h>
+
+class RCAS_Vk : public Shader_Vk
+{
+private:
+	// Same layout with Params cbuffer of rcas.hlsl
+	struct InternalConstants
+	{
+		float Sharpness;
+
+		// Motion Vector Stuff
+		int DynamicSharpenEnabled;
+		int DisplaySizeMV;
+		int Debug;
+
+		float MotionSharpness;
+		float MotionTextureScale;
+		float MvScaleX;
+		float MvScaleY;
+		float Threshold;
+		float ScaleLimit;
+		int DisplayWidth;
+		int DisplayHeight;
+	};
+
+	// 12 scalars of Params, Dx12 pass uploads the same fields padded to 256 bytes
+	static_assert(sizeof(InternalConstants) == 48 && offsetof(InternalConstants, DisplayHeight) == 44);
+
+	uint32_t InNumThreadsX = 32;
+	uint32_t InNumThreadsY = 32;
+
+public:
+	// InResource is sampled in GENERAL layout, InMotionVectors in SHADER_READ_ONLY_OPTIMAL
+	bool Dispatch(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Resource_VK* InResource, NVSDK_NGX_Resource_VK* InMotionVectors, RcasConstants InConstants, NVSDK_NGX_Resource_VK* OutResource);
+
+	RCAS_Vk(std::string InName, VkDevice InDevice, VkPhysicalDevice InPD);
+};
@@ -0,0 +1,26 @@
+@echo off
+
+rem Regenerates precompiled format transfer shaders, run after changing ftShaderCode in FT_Common.h and commit the outputs
+rem Every FT_DST_PACK / FT_TRANSFER variant used by FT_Dx12 is built
+set FTDir=%~dp0..\format_transfer
+set FTSource=%TEMP%\ft.hlsl
+
+if not exist "%FTDir%\precompile" mkdir "%FTDir%\precompile"
+
+python "%~dp0extract_shader.py" "%FTDir%\FT_Common.h" ftShaderCode "%FTSource%" || exit /b 1
+
+for %%v in (0_0 0_1 1_0 2_0 3_0 3_2) do call :Build %%v || exit /b 1
+
+del "%FTSource%"
+exit /b 0
+
+:Build
+set Variant=%1
+
+echo Creating Dx12 CSO %Variant%
+"%~dp0dxc.exe" -T cs_6_0 -E CSMain -D FT_DST_PACK=%Variant:~0,1% -D FT_TRANSFER=%Variant:~2,1% -Vi "%FTSource%" -Fo "%FTDir%\precompile\FT_Shader_%Variant%.cso" || exit /b 1
+
+echo Creating Dx12 Header %Variant%
+python "%~dp0create_header.py" "%FTDir%\precompile\FT_Shader_%Variant%.cso" "%FTDir%\precompile\FT_Shader_%Variant%.h" ft_%Variant%_cso || exit /b 1
+
+exit /b 0
@@ -17,4 +17,6 @@ echo Creating Dx11 CSO
 "%~dp0fxc.exe" -T cs_5_0 -E CSMain -Cc -Vi "%ShaderName%.hlsl" -Fo "%ShaderName%_Shader_Dx11.cso"
 
 echo Creating Dx11 Header
-python "%~dp0create_header.py" "%ShaderName%_Shader_Dx11.cso" "%ShaderName%_Shader_Dx11.h" %ShaderName%_cso
\ No newline at end of file
+python "%~dp0create_header.py" "%ShaderName%_Shader_Dx11.cso" "%ShaderName%_Shader_Dx11.h" %ShaderName%_cso
+
+call "%~dp0build_vk_shader.bat" "%ShaderName%.hlsl" "%ShaderName%_Shader_Vk" %ShaderName%_spv
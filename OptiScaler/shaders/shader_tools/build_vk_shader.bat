@@ -0,0 +1,14 @@
+@echo off
+
+rem Used by build_precompiled_shader.bat, generated header is committed next to the shader
+if "%~3"=="" (
+    echo Usage: %~nx0 InputHlsl OutputName ArrayName
+    exit /b 1
+)
+
+echo Creating Vulkan SPIR-V
+rem Bindings follow Dx12 registers: b0 = 0, t0 = 1, t1 = 2, u0 = 3
+"%~dp0dxc.exe" -spirv -T cs_6_0 -E CSMain -fspv-target-env=vulkan1.1 -fvk-use-dx-layout -fvk-t-shift 1 0 -fvk-u-shift 3 0 -Vi "%~1" -Fo "%~2.spv" || exit /b 1
+
+echo Creating Vulkan Header
+python "%~dp0create_header.py" "%~2.spv" "%~2.h" %3 || exit /b 1
@@ -9,7 +9,7 @@ def convert_shader_to_header(input_file_path, output_file_path, array_name):
     except IOError as e:
         print(f"Failed to open the input file: {input_file_path}")
         print(e)
-        return
+        sys.exit(1)
 
     # Open the output file
     try:
@@ -30,6 +30,7 @@ def convert_shader_to_header(input_file_path, output_file_path, array_name):
     except IOError as e:
         print(f"Failed to open the output file: {output_file_path}")
         print(e)
+        sys.exit(1)
 
 if __name__ == "__main__":
     if len(sys.argv) != 4:
@@ -0,0 +1,46 @@
+import sys
+import os
+
+def extract_shader(input_header_path, variable_name, output_file_path):
+    # Read the C++ header holding the shader as a raw string
+    try:
+        with open(input_header_path, 'r') as input_file:
+            text = input_file.read()
+    except IOError as e:
+        print(f"Failed to open the input file: {input_header_path}")
+        print(e)
+        sys.exit(1)
+
+    start_marker = f"{variable_name} = R\"("
+    start = text.find(start_marker)
+    if start < 0:
+        print(f"Can't find {variable_name} in {input_header_path}")
+        sys.exit(1)
+
+    start += len(start_marker)
+    end = text.find(")\";", start)
+    if end < 0:
+        print(f"Can't find end of {variable_name} in {input_header_path}")
+        sys.exit(1)
+
+    # Write the shader source
+    try:
+        with open(output_file_path, 'w') as output_file:
+            output_file.write(text[start:end].lstrip("\n"))
+
+        print(f"Shader extracted successfully: {output_file_path}")
+    except IOError as e:
+        print(f"Failed to open the output file: {output_file_path}")
+        print(e)
+        sys.exit(1)
+
+if __name__ == "__main__":
+    if len(sys.argv) != 4:
+        print(f"Usage: {os.path.basename(__file__)} <input_header_file> <variable_name> <output_shader_file>")
+        sys.exit(1)
+
+    input_header_file = sys.argv[1]
+    variable_name = sys.argv[2]
+    output_shader_file = sys.argv[3]
+
+    extract_shader(input_header_file, variable_name, output_shader_file)
@@ -0,0 +1,458 @@
+#include "FeatureBuilder_Dx12.h"
+#include <pch.h>
+
+#include "State.h"
+
+bool FeatureBuilder_Dx12::CreateObjects()
+{
+    if (_queue != nullptr)
+        return true;
+
+    D3D12_COMMAND_QUEUE_DESC queueDesc = {};
+    queueDesc.Type = D3D12_COMMAND_LIST_TYPE_DIRECT;
+    queueDesc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
+
+    auto result = _device->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&_queue));
+    if (result != S_OK)
+    {
+        LOG_ERROR("CreateCommandQueue error: {0:X}", (UINT)result);
+        return false;
+    }
+
+    _queue->SetName(L"FeatureBuilderQueue");
+
+    result = _device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&_allocator));
+    if (result != S_OK)
+    {
+        LOG_ERROR("CreateCommandAllocator error: {0:X}", (UINT)result);
+        return false;
+    }
+
+    result = _device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, _allocator, nullptr, IID_PPV_ARGS(&_cmdList));
+    if (result != S_OK)
+    {
+        LOG_ERROR("CreateCommandList error: {0:X}", (UINT)result);
+        return false;
+    }
+
+    _cmdList->SetName(L"FeatureBuilderCommandList");
+    _cmdList->Close();
+
+    result = _device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&_fence));
+    if (result != S_OK)
+    {
+        LOG_ERROR("CreateFence error: {0:X}", (UINT)result);
+        return false;
+    }
+
+    return true;
+}
+
+void FeatureBuilder_Dx12::Build(FeatureFactory InFactory, NVSDK_NGX_Parameter* InParameters)
+{
+    LOG_INFO("Building {0} feature on worker thread", _backend);
+
+    do
+    {
+        if (!CreateObjects())
+            break;
+
+        _feature = InFactory();
+
+        if (_feature == nullptr || !_feature->ModuleLoaded())
+        {
+            LOG_ERROR("Can't load {0} module!", _backend);
+            break;
+        }
+
+        if (_allocator->Reset() != S_OK || _cmdList->Reset(_allocator, nullptr) != S_OK)
+        {
+            LOG_ERROR("Can't reset command list!");
+            break;
+        }
+
+        auto initResult = _feature->Init(_device, _cmdList, InParameters);
+
+        // Command list must be closed & executed even init fails
+        _cmdList->Close();
+
+        ID3D12CommandList* cmdLists[] = { _cmdList };
+        _queue->ExecuteCommandLists(1, cmdLists);
+        _queue->Signal(_fence, ++_fenceValue);
+
+        if (!initResult)
+        {
+            LOG_ERROR("Init failed for {0} feature", _backend);
+            break;
+        }
+
+        LOG_INFO("{0} feature is inited, waiting for GPU", _backend);
+        _status = Status::Executing;
+        return;
+
+    } while (false);
+
+    _status = Status::Failed;
+}
+
+void FeatureBuilder_Dx12::JoinWorker()
+{
+    if (!_worker.joinable())
+        return;
+
+    // Joining during process exit might deadlock
+    if (State::Instance().isShuttingDown)
+        _worker.detach();
+    else
+        _worker.join();
+}
+
+bool FeatureBuilder_Dx12::Start(ID3D12Device* InDevice, unsigned int InHandleId, std::string InBackend, FeatureFactory InFactory, NVSDK_NGX_Parameter* InParameters)
+{
+    if (_status != Status::Idle || InDevice == nullptr)
+        return false;
+
+    JoinWorker();
+
+    if (_device != InDevice && _queue != nullptr)
+    {
+        LOG_DEBUG("Device changed, recreating builder objects");
+
+        _cmdList->Release();
+        _cmdList = nullptr;
+        _allocator->Release();
+        _allocator = nullptr;
+        _fence->Release();
+        _fence = nullptr;
+        _queue->Release();
+        _queue = nullptr;
+        _fenceValue = 0;
+    }
+
+    _device = InDevice;
+    _handleId = InHandleId;
+    _backend = InBackend;
+    _feature.reset();
+
+    _status = Status::Building;
+    _worker = std::thread(&FeatureBuilder_Dx12::Build, this, InFactory, InParameters);
+
+    return true;
+}
+
+FeatureBuilder_Dx12::Status FeatureBuilder_Dx12::Poll()
+{
+    if (_status == Status::Executing && _fence->GetCompletedValue() >= _fenceValue)
+    {
+        JoinWorker();
+        _status = Status::Ready;
+    }
+    else if (_status == Status::Failed)
+    {
+        JoinWorker();
+    }
+
+    return _status;
+}
+
+std::unique_ptr<IFeature_Dx12> FeatureBuilder_Dx12::Take()
+{
+    if (_status != Status::Ready)
+        return nullptr;
+
+    _status = Status::Idle;
+    return std::move(_feature);
+}
+
+void FeatureBuilder_Dx12::Reset()
+{
+    JoinWorker();
+
+    // Unfinished feature was only used by builder's queue
+    if (_feature != nullptr)
+        Retire(std::move(_feature), _queue);
+
+    _status = Status::Idle;
+}
+
+ID3D12Fence* FeatureBuilder_Dx12::SignalFence(ID3D12CommandQueue* InQueue)
+{
+    ID3D12Device* device = nullptr;
+    ID3D12Fence* fence = nullptr;
+
+    do
+    {
+        if (InQueue->GetDevice(IID_PPV_ARGS(&device)) != S_OK)
+            break;
+
+        if (device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&fence)) != S_OK)
+            break;
+
+        // Fence passes after every command submitted to queue before now
+        if (InQueue->Signal(fence, 1) != S_OK)
+        {
+            fence->Release();
+            fence = nullptr;
+        }
+
+    } while (false);
+
+    if (device != nullptr)
+        device->Release();
+
+    if (fence == nullptr)
+        LOG_WARN("Can't signal retire fence");
+
+    return fence;
+}
+
+bool FeatureBuilder_Dx12::CreateMarkerBuffer(ID3D12Device* InDevice)
+{
+    if (_markerBuffer != nullptr)
+        return _markerDevice == InDevice;
+
+    D3D12_HEAP_PROPERTIES heapProperties{};
+    heapProperties.Type = D3D12_HEAP_TYPE_READBACK;
+
+    D3D12_RESOURCE_DESC desc{};
+    desc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+    desc.Width = sizeof(uint32_t) * MarkerSlotCount;
+    desc.Height = 1;
+    desc.DepthOrArraySize = 1;
+    desc.MipLevels = 1;
+    desc.Format = DXGI_FORMAT_UNKNOWN;
+    desc.SampleDesc.Count = 1;
+    desc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+
+    auto result = InDevice->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &desc, D3D12_RESOURCE_STATE_COPY_DEST, nullptr,
+                                                    IID_PPV_ARGS(&_markerBuffer));
+
+    if (result != S_OK)
+    {
+        LOG_ERROR("CreateCommittedResource error: {0:X}", (UINT)result);
+        _markerBuffer = nullptr;
+        return false;
+    }
+
+    void* data = nullptr;
+
+    if (_markerBuffer->Map(0, nullptr, &data) != S_OK || data == nullptr)
+    {
+        LOG_ERROR("Can't map marker buffer");
+        _markerBuffer->Release();
+        _markerBuffer = nullptr;
+        return false;
+    }
+
+    _markerBuffer->SetName(L"FeatureBuilderMarkers");
+    _markerDevice = InDevice;
+    _markerData = (volatile uint32_t*)data;
+
+    for (uint32_t i = 0; i < MarkerSlotCount; i++)
+    {
+        _markerData[i] = 0;
+        _freeSlots.push_back(MarkerSlotCount - 1 - i);
+    }
+
+    return true;
+}
+
+bool FeatureBuilder_Dx12::AcquireMarkerSlot(uint32_t* OutSlot)
+{
+    // Features which are parked or destroyed keep their slot, slots of passed markers are taken back
+    // Live features get a new slot at their next evaluate
+    if (_freeSlots.empty())
+    {
+        std::erase_if(_markers, [](const auto& entry)
+                      {
+                          if (_markerData[entry.second.Slot] < entry.second.Value)
+                              return false;
+
+                          _freeSlots.push_back(entry.second.Slot);
+                          return true;
+                      });
+    }
+
+    if (_freeSlots.empty())
+        return false;
+
+    *OutSlot = _freeSlots.back();
+    _freeSlots.pop_back();
+    return true;
+}
+
+void FeatureBuilder_Dx12::MarkEvaluated(const IFeature_Dx12* InFeature, ID3D12GraphicsCommandList* InCmdList)
+{
+    if (InFeature == nullptr || InCmdList == nullptr)
+        return;
+
+    ID3D12GraphicsCommandList2* cmdList2 = nullptr;
+    if (InCmdList->QueryInterface(IID_PPV_ARGS(&cmdList2)) != S_OK || cmdList2 == nullptr)
+        return;
+
+    ID3D12Device* device = nullptr;
+
+    do
+    {
+        if (InCmdList->GetDevice(IID_PPV_ARGS(&device)) != S_OK)
+            break;
+
+        std::lock_guard<std::mutex> lock(_retiredMutex);
+
+        // Features of another device fall back to present queue fence
+        if (!CreateMarkerBuffer(device))
+            break;
+
+        auto it = _markers.find(InFeature);
+
+        if (it == _markers.end())
+        {
+            uint32_t slot = 0;
+
+            if (!AcquireMarkerSlot(&slot))
+                break;
+
+            it = _markers.emplace(InFeature, FeatureMarker{ slot, 0 }).first;
+        }
+
+        // Serial is shared by all slots so a reused slot never holds a bigger stale value
+        it->second.Value = ++_markerSerial;
+
+        D3D12_WRITEBUFFERIMMEDIATE_PARAMETER param{};
+        param.Dest = _markerBuffer->GetGPUVirtualAddress() + it->second.Slot * sizeof(uint32_t);
+        param.Value = it->second.Value;
+
+        D3D12_WRITEBUFFERIMMEDIATE_MODE mode = D3D12_WRITEBUFFERIMMEDIATE_MODE_MARKER_OUT;
+        cmdList2->WriteBufferImmediate(1, &param, &mode);
+
+    } while (false);
+
+    if (device != nullptr)
+        device->Release();
+
+    cmdList2->Release();
+}
+
+void FeatureBuilder_Dx12::Retire(std::unique_ptr<IFeature_Dx12> InFeature, ID3D12CommandQueue* InQueue)
+{
+    if (InFeature == nullptr)
+        return;
+
+    RetiredFeature retired{};
+    retired.Feature = InFeature.release();
+
+    std::lock_guard<std::mutex> lock(_retiredMutex);
+
+    if (auto it = _markers.find(retired.Feature); it != _markers.end())
+    {
+        retired.Slot = it->second.Slot;
+        retired.Marker = it->second.Value;
+        _markers.erase(it);
+    }
+    else if (InQueue != nullptr)
+    {
+        retired.Fence = SignalFence(InQueue);
+    }
+
+    LOG_DEBUG("Retired {0} feature, marker: {1}", retired.Feature->Name(), retired.Marker);
+
+    _retired.push_back(retired);
+}
+
+void FeatureBuilder_Dx12::ReleaseRetired(ID3D12CommandQueue* InQueue)
+{
+    std::vector<RetiredFeature> completed;
+
+    {
+        std::lock_guard<std::mutex> lock(_retiredMutex);
+
+        if (_retired.empty())
+            return;
+
+        std::erase_if(_retired, [&completed, InQueue](RetiredFeature& retired)
+                      {
+                          // Written after last command which used the feature, on the queue which executed it
+                          if (retired.Slot >= 0)
+                          {
+                              if (_markerData[retired.Slot] < retired.Marker)
+                                  return false;
+
+                              _freeSlots.push_back(retired.Slot);
+                              completed.push_back(retired);
+                              return true;
+                          }
+
+                          // Game's commands using feature are submitted before present
+                          if (retired.Fence == nullptr)
+                          {
+                              if (InQueue != nullptr)
+                                  retired.Fence = SignalFence(InQueue);
+
+                              return false;
+                          }
+
+                          if (retired.Fence->GetCompletedValue() < 1)
+                              return false;
+
+                          completed.push_back(retired);
+                          return true;
+                      });
+    }
+
+    // Features are only retired on backend changes, destroying them on present thread is fine
+    // and they never outlive the device or the dll
+    for (auto& retired : completed)
+    {
+        LOG_DEBUG("Destroying retired {0} feature", retired.Feature->Name());
+        delete retired.Feature;
+
+        if (retired.Fence != nullptr)
+            retired.Fence->Release();
+    }
+}
+
+FeatureBuilder_Dx12::~FeatureBuilder_Dx12()
+{
+    JoinWorker();
+
+    if (State::Instance().isShuttingDown)
+        return;
+
+    // Builder is only destroyed on release, waiting here is fine
+    if (_fence != nullptr && _fence->GetCompletedValue() < _fenceValue)
+    {
+        HANDLE fenceEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+
+        if (fenceEvent != NULL && _fence->SetEventOnCompletion(_fenceValue, fenceEvent) == S_OK)
+        {
+            WaitForSingleObject(fenceEvent, INFINITE);
+            CloseHandle(fenceEvent);
+        }
+    }
+
+    _feature.reset();
+
+    if (_cmdList != nullptr)
+    {
+        _cmdList->Release();
+        _cmdList = nullptr;
+    }
+
+    if (_allocator != nullptr)
+    {
+        _allocator->Release();
+        _allocator = nullptr;
+    }
+
+    if (_fence != nullptr)
+    {
+        _fence->Release();
+        _fence = nullptr;
+    }
+
+    if (_queue != nullptr)
+    {
+        _queue->Release();
+        _queue = nullptr;
+    }
+}
@@ -0,0 +1,113 @@
+#pragma once
+#include <pch.h>
+
+#include "IFeature_Dx12.h"
+
+#include <d3d12.h>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <functional>
+#include <unordered_map>
+
+// Creates and inits a Dx12 feature on a worker thread
+// Init commands are recorded to builder's own command list and executed on its own queue,
+// feature is only handed out after builder's fence is signaled so it can be swapped in without waiting
+class FeatureBuilder_Dx12
+{
+public:
+    enum class Status : uint32_t
+    {
+        Idle,
+        Building,
+        Executing,
+        Ready,
+        Failed
+    };
+
+    using FeatureFactory = std::function<std::unique_ptr<IFeature_Dx12>()>;
+
+private:
+    std::thread _worker;
+    std::atomic<Status> _status = Status::Idle;
+
+    ID3D12Device* _device = nullptr;
+    ID3D12CommandQueue* _queue = nullptr;
+    ID3D12CommandAllocator* _allocator = nullptr;
+    ID3D12GraphicsCommandList* _cmdList = nullptr;
+    ID3D12Fence* _fence = nullptr;
+    UINT64 _fenceValue = 0;
+
+    std::unique_ptr<IFeature_Dx12> _feature;
+    std::string _backend;
+    unsigned int _handleId = 0;
+
+    // Replaced features, destroyed after their marker or fence is completed
+    struct RetiredFeature
+    {
+        IFeature_Dx12* Feature = nullptr;
+        ID3D12Fence* Fence = nullptr;
+        int32_t Slot = -1;
+        uint32_t Marker = 0;
+    };
+
+    // Last marker written to game's command list after a feature's evaluate
+    // Marker is written by the queue which executes that command list, whichever queue game uses
+    struct FeatureMarker
+    {
+        uint32_t Slot = 0;
+        uint32_t Value = 0;
+    };
+
+    static const uint32_t MarkerSlotCount = 64;
+
+    static inline std::mutex _retiredMutex;
+    static inline std::vector<RetiredFeature> _retired;
+
+    static inline ID3D12Device* _markerDevice = nullptr;
+    static inline ID3D12Resource* _markerBuffer = nullptr;
+    static inline volatile uint32_t* _markerData = nullptr;
+    static inline std::unordered_map<const IFeature_Dx12*, FeatureMarker> _markers;
+    static inline std::vector<uint32_t> _freeSlots;
+    static inline uint32_t _markerSerial = 0;
+
+    static ID3D12Fence* SignalFence(ID3D12CommandQueue* InQueue);
+    static bool CreateMarkerBuffer(ID3D12Device* InDevice);
+    static bool AcquireMarkerSlot(uint32_t* OutSlot);
+
+    bool CreateObjects();
+    void Build(FeatureFactory InFactory, NVSDK_NGX_Parameter* InParameters);
+    void JoinWorker();
+
+public:
+    // Starts building, returns false if builder is busy
+    bool Start(ID3D12Device* InDevice, unsigned int InHandleId, std::string InBackend, FeatureFactory InFactory, NVSDK_NGX_Parameter* InParameters);
+
+    // Never blocks, moves Executing to Ready when builder's fence is completed
+    Status Poll();
+
+    // Returns ready feature and resets builder to Idle
+    std::unique_ptr<IFeature_Dx12> Take();
+
+    // Drops a failed or unfinished build and resets builder to Idle
+    void Reset();
+
+    // Writes a marker to InCmdList after InFeature's evaluate, retired features wait for their last marker
+    static void MarkEvaluated(const IFeature_Dx12* InFeature, ID3D12GraphicsCommandList* InCmdList);
+
+    // Feature is destroyed after GPU passes the marker of its last evaluate
+    // Features without a marker wait for a fence signaled on InQueue
+    // or, without InQueue, on present queue by next ReleaseRetired call
+    static void Retire(std::unique_ptr<IFeature_Dx12> InFeature, ID3D12CommandQueue* InQueue = nullptr);
+
+    // Called once per present, never blocks
+    // Signals pending fences on InQueue and destroys features whose marker or fence is completed
+    static void ReleaseRetired(ID3D12CommandQueue* InQueue);
+
+    bool IsBusy() const { return _status != Status::Idle; }
+    unsigned int HandleId() const { return _handleId; }
+    std::string Backend() const { return _backend; }
+
+    ~FeatureBuilder_Dx12();
+};
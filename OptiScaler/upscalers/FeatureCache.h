@@ -0,0 +1,158 @@
+#pragma once
+#include <pch.h>
+
+#include "IFeature.h"
+
+#include <vector>
+
+// Identifies an inited upscaler context, features with same key can be reused without Init
+struct FeatureCacheKey
+{
+    std::string Backend;
+    unsigned int RenderWidth = 0;
+    unsigned int RenderHeight = 0;
+    unsigned int DisplayWidth = 0;
+    unsigned int DisplayHeight = 0;
+    int Flags = 0;
+
+    bool IsValid() const { return !Backend.empty() && DisplayWidth > 0 && DisplayHeight > 0; }
+    bool operator==(const FeatureCacheKey& other) const = default;
+
+    // Key of a feature which would be created from InParameters, used to check cache before creating one
+    static FeatureCacheKey From(const std::string& InBackend, NVSDK_NGX_Parameter* InParameters)
+    {
+        FeatureCreateInfo info{};
+
+        if (InParameters == nullptr || !IFeature::ReadCreateInfo(InParameters, InBackend == "fsr31", &info))
+            return {};
+
+        return { InBackend, info.RenderWidth, info.RenderHeight, info.DisplayWidth, info.DisplayHeight, info.Flags };
+    }
+
+    // Should be called before Init, values are the ones parsed from creation parameters
+    static FeatureCacheKey From(const std::string& InBackend, IFeature* InFeature)
+    {
+        if (InFeature == nullptr)
+            return {};
+
+        return { InBackend, InFeature->RenderWidth(), InFeature->RenderHeight(),
+                 InFeature->DisplayWidth(), InFeature->DisplayHeight(), InFeature->GetFeatureFlags() };
+    }
+};
+
+// Small LRU of released but still inited features
+// Entries are limited by count and by an estimated VRAM budget, least recently used ones are destroyed first
+template <class FeatureType>
+class FeatureCache
+{
+private:
+    struct Entry
+    {
+        FeatureCacheKey key;
+        std::unique_ptr<FeatureType> feature;
+        uint64_t size = 0;
+    };
+
+    // Most recently used entry is at the back
+    std::vector<Entry> _entries;
+    uint64_t _usedBytes = 0;
+
+    uint32_t _hits = 0;
+    uint32_t _misses = 0;
+
+    void Evict(size_t InMaxEntries, uint64_t InBudgetBytes)
+    {
+        while (!_entries.empty() && (_entries.size() > InMaxEntries || _usedBytes > InBudgetBytes))
+        {
+            LOG_DEBUG("Evicting {0} {1}x{2} -> {3}x{4}", _entries.front().key.Backend, _entries.front().key.RenderWidth,
+                      _entries.front().key.RenderHeight, _entries.front().key.DisplayWidth, _entries.front().key.DisplayHeight);
+
+            _usedBytes -= _entries.front().size;
+            _entries.erase(_entries.begin());
+        }
+    }
+
+public:
+    // Rough size of upscaler internal resources, history & lock buffers are display sized, the rest are render sized
+    static uint64_t EstimateSize(const FeatureCacheKey& InKey)
+    {
+        return (uint64_t)InKey.DisplayWidth * InKey.DisplayHeight * 32 + (uint64_t)InKey.RenderWidth * InKey.RenderHeight * 16;
+    }
+
+    // Takes ownership of an inited feature, returns false (and destroys it) when it doesn't fit
+    bool Put(const FeatureCacheKey& InKey, std::unique_ptr<FeatureType> InFeature, size_t InMaxEntries, uint64_t InBudgetBytes)
+    {
+        if (InFeature == nullptr || !InKey.IsValid() || InMaxEntries == 0)
+            return false;
+
+        auto size = EstimateSize(InKey);
+
+        if (size > InBudgetBytes)
+        {
+            LOG_DEBUG("{0} {1}x{2} is over budget ({3} MB), not caching", InKey.Backend, InKey.DisplayWidth, InKey.DisplayHeight, size >> 20);
+            return false;
+        }
+
+        // Same key should not exist but replace it if it does
+        for (size_t i = 0; i < _entries.size(); i++)
+        {
+            if (_entries[i].key == InKey)
+            {
+                _usedBytes -= _entries[i].size;
+                _entries.erase(_entries.begin() + i);
+                break;
+            }
+        }
+
+        Evict(InMaxEntries - 1, InBudgetBytes - size);
+
+        LOG_INFO("Caching {0} {1}x{2} -> {3}x{4} ({5} MB)", InKey.Backend, InKey.RenderWidth, InKey.RenderHeight, InKey.DisplayWidth, InKey.DisplayHeight, size >> 20);
+
+        _usedBytes += size;
+        _entries.push_back({ InKey, std::move(InFeature), size });
+
+        return true;
+    }
+
+    // Returns cached feature for InKey and removes it from cache, nullptr on miss
+    std::unique_ptr<FeatureType> Take(const FeatureCacheKey& InKey)
+    {
+        if (!InKey.IsValid())
+            return nullptr;
+
+        for (size_t i = 0; i < _entries.size(); i++)
+        {
+            if (_entries[i].key == InKey)
+            {
+                auto feature = std::move(_entries[i].feature);
+                _usedBytes -= _entries[i].size;
+                _entries.erase(_entries.begin() + i);
+                _hits++;
+
+                LOG_INFO("Reusing cached {0} {1}x{2} -> {3}x{4}, hits: {5}, misses: {6}", InKey.Backend, InKey.RenderWidth, InKey.RenderHeight,
+                         InKey.DisplayWidth, InKey.DisplayHeight, _hits, _misses);
+                return feature;
+            }
+        }
+
+        _misses++;
+
+        LOG_DEBUG("No cached {0} {1}x{2} -> {3}x{4}, hits: {5}, misses: {6}", InKey.Backend, InKey.RenderWidth, InKey.RenderHeight,
+                  InKey.DisplayWidth, InKey.DisplayHeight, _hits, _misses);
+        return nullptr;
+    }
+
+    void Clear()
+    {
+        if (!_entries.empty())
+            LOG_DEBUG("Clearing {0} cached features", _entries.size());
+
+        _entries.clear();
+        _usedBytes = 0;
+    }
+
+    size_t Count() const { return _entries.size(); }
+    uint64_t UsedBytes() const { return _usedBytes; }
+    uint32_t Hits() const { return _hits; }
+    uint32_t Misses() const { return _misses; }
+};
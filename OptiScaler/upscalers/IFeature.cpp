@@ -1,14 +1,27 @@
 #include <pch.h>
 #include <Config.h>
+#include <State.h>
 #include "IFeature.h"
 
 void IFeature::SetHandle(unsigned int InHandleId)
 {
+	// Handles are owned by NVNGX layer, Dx11 & Vulkan return them to the game
+	// so they are never deleted here, even after feature is destroyed
+	if (_handle != nullptr)
+	{
+		// Cached features get a new handle, old id is not used by anyone anymore
+		LOG_INFO("Handle: {0} -> {1}", _handle->Id, InHandleId);
+		State::Instance().changeBackend.erase(_handle->Id);
+	}
+	else
+	{
+		LOG_INFO("Handle: {0}", InHandleId);
+	}
+
 	_handle = new NVSDK_NGX_Handle{ InHandleId };
-	LOG_INFO("Handle: {0}", _handle->Id);
 }
 
-bool IFeature::SetInitParameters(NVSDK_NGX_Parameter* InParameters)
+bool IFeature::ReadCreateInfo(NVSDK_NGX_Parameter* InParameters, bool InSupportsUpscaleSize, FeatureCreateInfo* OutInfo)
 {
 	unsigned int width = 0;
 	unsigned int outWidth = 0;
@@ -16,64 +29,91 @@ bool IFeature::SetInitParameters(NVSDK_NGX_Parameter* InParameters)
 	unsigned int outHeight = 0;
 	int pqValue = 0;
 
-	InParameters->Get(NVSDK_NGX_Parameter_DLSS_Feature_Create_Flags, &_featureFlags);
+	InParameters->Get(NVSDK_NGX_Parameter_DLSS_Feature_Create_Flags, &OutInfo->Flags);
 
-	if (InParameters->Get(NVSDK_NGX_Parameter_Width, &width) == NVSDK_NGX_Result_Success &&
-		InParameters->Get(NVSDK_NGX_Parameter_Height, &height) == NVSDK_NGX_Result_Success &&
-		InParameters->Get(NVSDK_NGX_Parameter_OutWidth, &outWidth) == NVSDK_NGX_Result_Success &&
-		InParameters->Get(NVSDK_NGX_Parameter_OutHeight, &outHeight) == NVSDK_NGX_Result_Success &&
-		InParameters->Get(NVSDK_NGX_Parameter_PerfQualityValue, &pqValue) == NVSDK_NGX_Result_Success)
+	if (InParameters->Get(NVSDK_NGX_Parameter_Width, &width) != NVSDK_NGX_Result_Success ||
+		InParameters->Get(NVSDK_NGX_Parameter_Height, &height) != NVSDK_NGX_Result_Success ||
+		InParameters->Get(NVSDK_NGX_Parameter_OutWidth, &outWidth) != NVSDK_NGX_Result_Success ||
+		InParameters->Get(NVSDK_NGX_Parameter_OutHeight, &outHeight) != NVSDK_NGX_Result_Success ||
+		InParameters->Get(NVSDK_NGX_Parameter_PerfQualityValue, &pqValue) != NVSDK_NGX_Result_Success)
 	{
+		return false;
+	}
+
+	// FSR 3.1 uses upscaleSize for this, max size should stay the same
+	if (!InSupportsUpscaleSize)
 		GetDynamicOutputResolution(InParameters, &outWidth, &outHeight);
 
-		// Thanks to Crytek added these checks
-		if (width > 16384 || width < 20)
-			width = 0;
+	// Thanks to Crytek added these checks
+	if (width > 16384 || width < 20)
+		width = 0;
 
-		if (height > 16384 || height < 20)
-			height = 0;
+	if (height > 16384 || height < 20)
+		height = 0;
 
-		if (outWidth > 16384 || outWidth < 20)
-			outWidth = 0;
+	if (outWidth > 16384 || outWidth < 20)
+		outWidth = 0;
 
-		if (outHeight > 16384 || outHeight < 20)
-			outHeight = 0;
+	if (outHeight > 16384 || outHeight < 20)
+		outHeight = 0;
 
-		if (pqValue > 5 || pqValue < 0)
-			pqValue = 1;
+	if (pqValue > 5 || pqValue < 0)
+		pqValue = 1;
 
-		// When using extended limits render res might be bigger than display res
-		// it might create rendering issues but extending limits is an advanced option after all
-		if (!Config::Instance()->ExtendedLimits.value_or_default())
-		{
-			_displayWidth = width > outWidth ? width : outWidth;
-			_displayHeight = height > outHeight ? height : outHeight;
-			_targetWidth = _displayWidth;
-			_targetHeight = _displayHeight;
-			_renderWidth = width < outWidth ? width : outWidth;
-			_renderHeight = height < outHeight ? height : outHeight;
-		}
-		else
-		{
-			_displayWidth = outWidth;
-			_displayHeight = outHeight;
-			_targetWidth = _displayWidth;
-			_targetHeight = _displayHeight;
-			_renderWidth = width;
-			_renderHeight = height;
-		}
+	// When using extended limits render res might be bigger than display res
+	// it might create rendering issues but extending limits is an advanced option after all
+	if (!Config::Instance()->ExtendedLimits.value_or_default())
+	{
+		OutInfo->DisplayWidth = width > outWidth ? width : outWidth;
+		OutInfo->DisplayHeight = height > outHeight ? height : outHeight;
+		OutInfo->RenderWidth = width < outWidth ? width : outWidth;
+		OutInfo->RenderHeight = height < outHeight ? height : outHeight;
+	}
+	else
+	{
+		OutInfo->DisplayWidth = outWidth;
+		OutInfo->DisplayHeight = outHeight;
+		OutInfo->RenderWidth = width;
+		OutInfo->RenderHeight = height;
+	}
 
+	OutInfo->PerfQuality = pqValue;
 
-		_perfQualityValue = (NVSDK_NGX_PerfQuality_Value)pqValue;
+	return true;
+}
 
-		LOG_INFO("Render Resolution: {0}x{1}, Display Resolution {2}x{3}, Quality: {4}",
-			_renderWidth, _renderHeight, _displayWidth, _displayHeight, pqValue);
+bool IFeature::SetInitParameters(NVSDK_NGX_Parameter* InParameters)
+{
+	// Set by FSR 3.1 features before calling IFeature constructor, only valid for this creation
+	int supportsUpscaleSize = 0;
+	InParameters->Get("OptiScaler.SupportsUpscaleSize", &supportsUpscaleSize);
 
-		return true;
+	if (supportsUpscaleSize)
+		InParameters->Set("OptiScaler.SupportsUpscaleSize", 0);
+
+	FeatureCreateInfo info{};
+	auto result = ReadCreateInfo(InParameters, supportsUpscaleSize != 0, &info);
+
+	_featureFlags = info.Flags;
+
+	if (!result)
+	{
+		LOG_ERROR("Can't set parameters!");
+		return false;
 	}
 
-	LOG_ERROR("Can't set parameters!");
-	return false;
+	_displayWidth = info.DisplayWidth;
+	_displayHeight = info.DisplayHeight;
+	_targetWidth = _displayWidth;
+	_targetHeight = _displayHeight;
+	_renderWidth = info.RenderWidth;
+	_renderHeight = info.RenderHeight;
+	_perfQualityValue = (NVSDK_NGX_PerfQuality_Value)info.PerfQuality;
+
+	LOG_INFO("Render Resolution: {0}x{1}, Display Resolution {2}x{3}, Quality: {4}",
+		_renderWidth, _renderHeight, _displayWidth, _displayHeight, info.PerfQuality);
+
+	return true;
 }
 
 void IFeature::GetRenderResolution(NVSDK_NGX_Parameter* InParameters, unsigned int* OutWidth, unsigned int* OutHeight)
@@ -157,6 +197,31 @@ float IFeature::GetSharpness(const NVSDK_NGX_Parameter* InParameters)
 	return sharpness;
 }
 
+void IFeature::SetInit(bool InValue)
+{
+	_isInited = InValue;
+
+	if (InValue)
+	{
+		_createRenderWidth = _renderWidth;
+		_createRenderHeight = _renderHeight;
+		_createTargetWidth = _targetWidth;
+		_createTargetHeight = _targetHeight;
+		_createDisplayWidth = _displayWidth;
+		_createDisplayHeight = _displayHeight;
+	}
+}
+
+void IFeature::RestoreCreateResolution()
+{
+	_renderWidth = _createRenderWidth;
+	_renderHeight = _createRenderHeight;
+	_targetWidth = _createTargetWidth;
+	_targetHeight = _createTargetHeight;
+	_displayWidth = _createDisplayWidth;
+	_displayHeight = _createDisplayHeight;
+}
+
 bool IFeature::UpdateOutputResolution(const NVSDK_NGX_Parameter* InParameters)
 {
 	// Check for FSR's dynamic resolution output
@@ -198,14 +263,6 @@ bool IFeature::UpdateOutputResolution(const NVSDK_NGX_Parameter* InParameters)
 
 void IFeature::GetDynamicOutputResolution(NVSDK_NGX_Parameter* InParameters, unsigned int* width, unsigned int* height)
 {
-	// FSR 3.1 uses upscaleSize for this, max size should stay the same
-	int supportsUpscaleSize = 0;
-	InParameters->Get("OptiScaler.SupportsUpscaleSize", &supportsUpscaleSize);
-	if (supportsUpscaleSize) {
-		InParameters->Set("OptiScaler.SupportsUpscaleSize", 0);
-		return;
-	}
-
 	// Check for FSR's dynamic resolution output
 	auto fsrDynamicOutputWidth = 0;
 	auto fsrDynamicOutputHeight = 0;
@@ -7,6 +7,17 @@
 
 inline static unsigned int handleCounter = DLSS_MOD_ID_OFFSET;
 
+// Values read from creation parameters, same ones feature would be created with
+struct FeatureCreateInfo
+{
+	unsigned int RenderWidth = 0;
+	unsigned int RenderHeight = 0;
+	unsigned int DisplayWidth = 0;
+	unsigned int DisplayHeight = 0;
+	int Flags = 0;
+	int PerfQuality = 1;
+};
+
 class IFeature
 {
 private:
@@ -35,21 +46,36 @@ protected:
 	unsigned int _displayWidth = 0;
 	unsigned int _displayHeight = 0;
 
+	// Resolution feature is inited with, others can change after Init
+	unsigned int _createRenderWidth = 0;
+	unsigned int _createRenderHeight = 0;
+	unsigned int _createTargetWidth = 0;
+	unsigned int _createTargetHeight = 0;
+	unsigned int _createDisplayWidth = 0;
+	unsigned int _createDisplayHeight = 0;
+
 	long _frameCount = 0;
 	bool _moduleLoaded = false;
 
 	void SetHandle(unsigned int InHandleId);
 	bool SetInitParameters(NVSDK_NGX_Parameter* InParameters);
 	void GetRenderResolution(NVSDK_NGX_Parameter* InParameters, unsigned int* OutWidth, unsigned int* OutHeight);
-	void GetDynamicOutputResolution(NVSDK_NGX_Parameter* InParameters, unsigned int* width, unsigned int* height);
+	static void GetDynamicOutputResolution(NVSDK_NGX_Parameter* InParameters, unsigned int* width, unsigned int* height);
 	float GetSharpness(const NVSDK_NGX_Parameter* InParameters);
 
-	virtual void SetInit(bool InValue) { _isInited = InValue; }
+	virtual void SetInit(bool InValue);
 
 public:
 	NVSDK_NGX_Handle* Handle() const { return _handle; };
 	static unsigned int GetNextHandleId() { return handleCounter++; }
 
+	// Doesn't change InParameters, InSupportsUpscaleSize is true for FSR 3.1 features
+	static bool ReadCreateInfo(NVSDK_NGX_Parameter* InParameters, bool InSupportsUpscaleSize, FeatureCreateInfo* OutInfo);
+
+	// Used when a cached feature is handed out for a new handle
+	void ChangeHandle(unsigned int InHandleId) { SetHandle(InHandleId); }
+	void RestoreCreateResolution();
+
 	int GetFeatureFlags() const { return _featureFlags; }
 
 	bool UpdateOutputResolution(const NVSDK_NGX_Parameter* InParameters);
@@ -59,6 +85,10 @@ public:
 	unsigned int TargetHeight() const { return _targetHeight; };
 	unsigned int RenderWidth() const { return _renderWidth; };
 	unsigned int RenderHeight() const { return _renderHeight; };
+	unsigned int CreateRenderWidth() const { return _createRenderWidth; };
+	unsigned int CreateRenderHeight() const { return _createRenderHeight; };
+	unsigned int CreateDisplayWidth() const { return _createDisplayWidth; };
+	unsigned int CreateDisplayHeight() const { return _createDisplayHeight; };
 	NVSDK_NGX_PerfQuality_Value PerfQualityValue() const { return _perfQualityValue; }
 	bool IsInitParameters() const { return _initParameters; };
 	bool IsInited() const { return _isInited; }
@@ -2,6 +2,11 @@
 #include <vulkan/vulkan.hpp>
 #include "IFeature.h"
 
+#include <Config.h>
+
+#include <shaders/output_scaling/OS_Vk.h>
+#include <shaders/rcas/RCAS_Vk.h>
+
 class IFeature_Vk : public virtual IFeature
 {
 private:
@@ -12,6 +17,28 @@ protected:
 	VkDevice Device = nullptr;
 	PFN_vkGetInstanceProcAddr GIPA = nullptr;
 	PFN_vkGetDeviceProcAddr GDPA = nullptr;
+	std::unique_ptr<OS_Vk> OutputScaler = nullptr;
+	std::unique_ptr<RCAS_Vk> RCAS = nullptr;
+
+	// Called before upscaler context is created, context is sized for output scaling only if its pass is usable
+	void CreateShaders()
+	{
+		// Extended limits downscales from render size, otherwise multiplier below 1.0 means upscaling to display size
+		bool extendedDownscale = Config::Instance()->ExtendedLimits.value_or_default() && RenderWidth() > DisplayWidth();
+		bool upsample = !extendedDownscale && Config::Instance()->OutputScalingMultiplier.value_or_default() < 1.0f;
+
+		OutputScaler = std::make_unique<OS_Vk>("Output Scaling", Device, PhysicalDevice, upsample);
+		RCAS = std::make_unique<RCAS_Vk>("RCAS", Device, PhysicalDevice);
+
+		if (!OutputScaler->IsInit() && Config::Instance()->OutputScalingEnabled.value_or_default())
+		{
+			LOG_WARN("Output scaling pass is not available, disabling output scaling");
+			Config::Instance()->OutputScalingEnabled.set_volatile_value(false);
+		}
+
+		if (!RCAS->IsInit())
+			Config::Instance()->RcasEnabled.set_volatile_value(false);
+	}
 
 public:
 	virtual bool Init(VkInstance InInstance, VkPhysicalDevice InPD, VkDevice InDevice, VkCommandBuffer InCmdList, PFN_vkGetInstanceProcAddr InGIPA, PFN_vkGetDeviceProcAddr InGDPA, NVSDK_NGX_Parameter* InParameters) = 0;
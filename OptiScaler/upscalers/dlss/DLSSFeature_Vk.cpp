@@ -1,6 +1,7 @@
 #include <pch.h>
 #include <Config.h>
 #include <Logger.h>
+#include <misc/GpuProfiler_Vk.h>
 
 #include "DLSSFeature_Vk.h"
 
@@ -87,7 +88,9 @@ bool DLSSFeatureVk::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter* I
 	{
 		ProcessEvaluateParams(InParameters);
 
+		GpuProfiler_Vk::Begin(Device, InCmdBuffer, GpuPass::Dispatch);
 		nvResult = NVNGXProxy::VULKAN_EvaluateFeature()(InCmdBuffer, _p_dlssHandle, InParameters, NULL);
+		GpuProfiler_Vk::End(InCmdBuffer, GpuPass::Dispatch);
 
 		if (nvResult != NVSDK_NGX_Result_Success)
 		{
@@ -1,6 +1,7 @@
 #include <pch.h>
 #include <Config.h>
 #include <Logger.h>
+#include <misc/GpuProfiler_Vk.h>
 
 #include "DLSSDFeature_Vk.h"
 
@@ -91,7 +92,9 @@ bool DLSSDFeatureVk::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter*
 	{
 		ProcessEvaluateParams(InParameters);
 
+		GpuProfiler_Vk::Begin(Device, InCmdBuffer, GpuPass::Dispatch);
 		nvResult = NVNGXProxy::VULKAN_EvaluateFeature()(InCmdBuffer, _p_dlssdHandle, InParameters, NULL);
+		GpuProfiler_Vk::End(InCmdBuffer, GpuPass::Dispatch);
 
 		if (nvResult != NVSDK_NGX_Result_Success)
 		{
@@ -1,5 +1,7 @@
 #include <pch.h>
 #include <Config.h>
+#include <misc/PipelineCache_Vk.h>
+#include <misc/GpuProfiler_Vk.h>
 
 #include "FSR2Feature_Vk.h"
 
@@ -23,7 +25,7 @@ bool FSR2FeatureVk::InitFSR2(const NVSDK_NGX_Parameter* InParameters)
     auto scratchBufferSize = ffxFsr2GetScratchMemorySizeVK(PhysicalDevice);
     void* scratchBuffer = calloc(scratchBufferSize, 1);
 
-    auto errorCode = ffxFsr2GetInterfaceVK(&_contextDesc.callbacks, scratchBuffer, scratchBufferSize, PhysicalDevice, vkGetDeviceProcAddr);
+    auto errorCode = ffxFsr2GetInterfaceVK(&_contextDesc.callbacks, scratchBuffer, scratchBufferSize, PhysicalDevice, PipelineCache_Vk::DeviceProcAddr(Device, PhysicalDevice, vkGetDeviceProcAddr));
 
     if (errorCode != FFX_OK)
     {
@@ -33,20 +35,6 @@ bool FSR2FeatureVk::InitFSR2(const NVSDK_NGX_Parameter* InParameters)
     }
 
     _contextDesc.device = ffxGetDeviceVK(Device);
-    
-    if (Config::Instance()->ExtendedLimits.value_or_default())
-    {
-        _contextDesc.maxRenderSize.width = RenderWidth() < DisplayWidth() ? DisplayWidth() : RenderWidth();
-        _contextDesc.maxRenderSize.height = RenderHeight() < DisplayHeight() ? DisplayHeight() : RenderHeight();
-    }
-    else
-    {
-        _contextDesc.maxRenderSize.width = DisplayWidth();
-        _contextDesc.maxRenderSize.height = DisplayHeight();
-    }
-
-    _contextDesc.displaySize.width = DisplayWidth();
-    _contextDesc.displaySize.height = DisplayHeight();
     _contextDesc.flags = 0;
 
     bool Hdr = GetFeatureFlags() & NVSDK_NGX_DLSS_Feature_Flags_IsHDR;
@@ -107,6 +95,62 @@ bool FSR2FeatureVk::InitFSR2(const NVSDK_NGX_Parameter* InParameters)
         LOG_INFO("contextDesc.initFlags (LowResMV) {0:b}", _contextDesc.flags);
     }
 
+    if (Config::Instance()->OutputScalingEnabled.value_or_default() && !Config::Instance()->DisplayResolution.value_or(false) && !State::Instance().DisplaySizeMV.value_or(false))
+    {
+        float ssMulti = Config::Instance()->OutputScalingMultiplier.value_or_default();
+
+        if (ssMulti < 0.5f)
+        {
+            ssMulti = 0.5f;
+            Config::Instance()->OutputScalingMultiplier.set_volatile_value(ssMulti);
+        }
+        else if (ssMulti > 3.0f)
+        {
+            ssMulti = 3.0f;
+            Config::Instance()->OutputScalingMultiplier.set_volatile_value(ssMulti);
+        }
+
+        _targetWidth = DisplayWidth() * ssMulti;
+        _targetHeight = DisplayHeight() * ssMulti;
+    }
+    else
+    {
+        _targetWidth = DisplayWidth();
+        _targetHeight = DisplayHeight();
+    }
+
+    // extended limits changes how resolution 
+    if (Config::Instance()->ExtendedLimits.value_or_default() && RenderWidth() > DisplayWidth())
+    {
+        _contextDesc.maxRenderSize.width = RenderWidth();
+        _contextDesc.maxRenderSize.height = RenderHeight();
+
+        Config::Instance()->OutputScalingMultiplier.set_volatile_value(1.0f);
+
+        // if output scaling active let it to handle downsampling
+        if (Config::Instance()->OutputScalingEnabled.value_or_default() && !Config::Instance()->DisplayResolution.value_or(false) && !State::Instance().DisplaySizeMV.value_or(false))
+        {
+            _contextDesc.displaySize.width = _contextDesc.maxRenderSize.width;
+            _contextDesc.displaySize.height = _contextDesc.maxRenderSize.height;
+
+            // update target res
+            _targetWidth = _contextDesc.maxRenderSize.width;
+            _targetHeight = _contextDesc.maxRenderSize.height;
+        }
+        else
+        {
+            _contextDesc.displaySize.width = DisplayWidth();
+            _contextDesc.displaySize.height = DisplayHeight();
+        }
+    }
+    else
+    {
+        _contextDesc.maxRenderSize.width = TargetWidth() > DisplayWidth() ? TargetWidth() : DisplayWidth();
+        _contextDesc.maxRenderSize.height = TargetHeight() > DisplayHeight() ? TargetHeight() : DisplayHeight();
+        _contextDesc.displaySize.width = TargetWidth();
+        _contextDesc.displaySize.height = TargetHeight();
+    }
+
 #if _DEBUG
     _contextDesc.flags |= FFX_FSR2_ENABLE_DEBUG_CHECKING;
     _contextDesc.fpMessage = FfxLogCallback;
@@ -126,6 +170,8 @@ bool FSR2FeatureVk::InitFSR2(const NVSDK_NGX_Parameter* InParameters)
 
     SetInit(true);
 
+    PipelineCache_Vk::Save();
+
     return true;
 }
 
@@ -142,6 +188,8 @@ bool FSR2FeatureVk::Init(VkInstance InInstance, VkPhysicalDevice InPD, VkDevice
     GIPA = InGIPA;
     GDPA = InGDPA;
 
+    CreateShaders();
+
     return InitFSR2(InParameters);
 }
 
@@ -152,11 +200,33 @@ bool FSR2FeatureVk::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter* I
     if (!IsInited())
         return false;
 
+    if (!RCAS->IsInit())
+        Config::Instance()->RcasEnabled.set_volatile_value(false);
+
     FfxFsr2DispatchDescription params{};
 
     InParameters->Get(NVSDK_NGX_Parameter_Jitter_Offset_X, &params.jitterOffset.x);
     InParameters->Get(NVSDK_NGX_Parameter_Jitter_Offset_Y, &params.jitterOffset.y);
 
+    if (Config::Instance()->OverrideSharpness.value_or_default())
+        _sharpness = Config::Instance()->Sharpness.value_or_default();
+    else
+        _sharpness = GetSharpness(InParameters);
+
+    if (Config::Instance()->RcasEnabled.value_or_default())
+    {
+        params.enableSharpening = false;
+        params.sharpness = 0.0f;
+    }
+    else
+    {
+        if (_sharpness > 1.0f)
+            _sharpness = 1.0f;
+
+        params.enableSharpening = _sharpness > 0.0f;
+        params.sharpness = _sharpness;
+    }
+
     unsigned int reset;
     InParameters->Get(NVSDK_NGX_Parameter_Reset, &reset);
     params.reset = (reset == 1);
@@ -165,6 +235,8 @@ bool FSR2FeatureVk::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter* I
 
     LOG_DEBUG("Input Resolution: {0}x{1}", params.renderSize.width, params.renderSize.height);
 
+    bool useSS = Config::Instance()->OutputScalingEnabled.value_or_default() && !Config::Instance()->DisplayResolution.value_or(false) && !State::Instance().DisplaySizeMV.value_or(false);
+
     params.commandList = ffxGetCommandListVK(InCmdBuffer);
 
     void* paramColor;
@@ -206,14 +278,38 @@ bool FSR2FeatureVk::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter* I
     void* paramOutput;
     InParameters->Get(NVSDK_NGX_Parameter_Output, &paramOutput);
 
+    // Resource upscaler writes, might be output scaler's or RCAS's buffer
+    NVSDK_NGX_Resource_VK* upscalerOutput = (NVSDK_NGX_Resource_VK*)paramOutput;
+
     if (paramOutput)
     {
         LOG_DEBUG("Output exist..");
 
-        params.output = ffxGetTextureResourceVK(&_context, ((NVSDK_NGX_Resource_VK*)paramOutput)->Resource.ImageViewInfo.Image,
-                                                ((NVSDK_NGX_Resource_VK*)paramOutput)->Resource.ImageViewInfo.ImageView,
-                                                ((NVSDK_NGX_Resource_VK*)paramOutput)->Resource.ImageViewInfo.Width, ((NVSDK_NGX_Resource_VK*)paramOutput)->Resource.ImageViewInfo.Height,
-                                                ((NVSDK_NGX_Resource_VK*)paramOutput)->Resource.ImageViewInfo.Format, (wchar_t*)L"FSR2_Output", FFX_RESOURCE_STATE_UNORDERED_ACCESS);
+        if (useSS)
+        {
+            if (OutputScaler->CreateBufferResource(InCmdBuffer, (NVSDK_NGX_Resource_VK*)paramOutput, TargetWidth(), TargetHeight()))
+            {
+                OutputScaler->SetBufferState(InCmdBuffer, VK_ACCESS_SHADER_WRITE_BIT);
+                upscalerOutput = OutputScaler->Buffer();
+            }
+            else
+            {
+                useSS = false;
+            }
+        }
+
+        if (Config::Instance()->RcasEnabled.value_or_default() &&
+            (_sharpness > 0.0f || (Config::Instance()->MotionSharpnessEnabled.value_or_default() && Config::Instance()->MotionSharpness.value_or_default() > 0.0f)) &&
+            RCAS != nullptr && RCAS.get() != nullptr && RCAS->IsInit() &&
+            RCAS->CreateBufferResource(InCmdBuffer, upscalerOutput, upscalerOutput->Resource.ImageViewInfo.Width, upscalerOutput->Resource.ImageViewInfo.Height))
+        {
+            RCAS->SetBufferState(InCmdBuffer, VK_ACCESS_SHADER_WRITE_BIT);
+            upscalerOutput = RCAS->Buffer();
+        }
+
+        params.output = ffxGetTextureResourceVK(&_context, upscalerOutput->Resource.ImageViewInfo.Image, upscalerOutput->Resource.ImageViewInfo.ImageView,
+                                                upscalerOutput->Resource.ImageViewInfo.Width, upscalerOutput->Resource.ImageViewInfo.Height,
+                                                upscalerOutput->Resource.ImageViewInfo.Format, (wchar_t*)L"FSR2_Output", FFX_RESOURCE_STATE_UNORDERED_ACCESS);
     }
     else
     {
@@ -328,30 +424,6 @@ bool FSR2FeatureVk::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter* I
         params.motionVectorScale.y = MVScaleY;
     }
 
-    if (Config::Instance()->OverrideSharpness.value_or_default())
-    {
-        params.enableSharpening = Config::Instance()->Sharpness.value_or_default() > 0.0f;
-        params.sharpness = Config::Instance()->Sharpness.value_or_default();
-    }
-    else
-    {
-        float shapness = 0.0f;
-        if (InParameters->Get(NVSDK_NGX_Parameter_Sharpness, &shapness) == NVSDK_NGX_Result_Success)
-        {
-            _sharpness = shapness;
-
-            params.enableSharpening = shapness > 0.0f;
-
-            if (params.enableSharpening)
-            {
-                if (shapness > 1.0f)
-                    params.sharpness = 1.0f;
-                else
-                    params.sharpness = shapness;
-            }
-        }
-    }
-
     if (IsDepthInverted())
     {
         params.cameraFar = Config::Instance()->FsrCameraNear.value_or_default();
@@ -377,7 +449,9 @@ bool FSR2FeatureVk::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter* I
         params.preExposure = 1.0f;
 
     LOG_DEBUG("Dispatch!!");
+    GpuProfiler_Vk::Begin(Device, InCmdBuffer, GpuPass::Dispatch);
     auto result = ffxFsr2ContextDispatch(&_context, &params);
+    GpuProfiler_Vk::End(InCmdBuffer, GpuPass::Dispatch);
 
     if (result != FFX_OK)
     {
@@ -385,6 +459,46 @@ bool FSR2FeatureVk::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter* I
         return false;
     }
 
+    // apply rcas
+    if (Config::Instance()->RcasEnabled.value_or_default() &&
+        (_sharpness > 0.0f || (Config::Instance()->MotionSharpnessEnabled.value_or_default() && Config::Instance()->MotionSharpness.value_or_default() > 0.0f)) &&
+        RCAS != nullptr && RCAS.get() != nullptr && RCAS->CanRender() && upscalerOutput == RCAS->Buffer())
+    {
+        RCAS->SetBufferState(InCmdBuffer, VK_ACCESS_SHADER_READ_BIT);
+
+        RcasConstants rcasConstants{};
+
+        rcasConstants.Sharpness = _sharpness;
+        rcasConstants.DisplayWidth = TargetWidth();
+        rcasConstants.DisplayHeight = TargetHeight();
+        InParameters->Get(NVSDK_NGX_Parameter_MV_Scale_X, &rcasConstants.MvScaleX);
+        InParameters->Get(NVSDK_NGX_Parameter_MV_Scale_Y, &rcasConstants.MvScaleY);
+        rcasConstants.DisplaySizeMV = !(GetFeatureFlags() & NVSDK_NGX_DLSS_Feature_Flags_MVLowRes);
+        rcasConstants.RenderHeight = RenderHeight();
+        rcasConstants.RenderWidth = RenderWidth();
+
+        auto rcasOutput = useSS ? OutputScaler->Buffer() : (NVSDK_NGX_Resource_VK*)paramOutput;
+
+        if (!RCAS->Dispatch(InCmdBuffer, RCAS->Buffer(), (NVSDK_NGX_Resource_VK*)paramVelocity, rcasConstants, rcasOutput))
+        {
+            Config::Instance()->RcasEnabled.set_volatile_value(false);
+            return true;
+        }
+    }
+
+    if (useSS)
+    {
+        LOG_DEBUG("scaling output...");
+        OutputScaler->SetBufferState(InCmdBuffer, VK_ACCESS_SHADER_READ_BIT);
+
+        if (!OutputScaler->Dispatch(InCmdBuffer, OutputScaler->Buffer(), (NVSDK_NGX_Resource_VK*)paramOutput))
+        {
+            Config::Instance()->OutputScalingEnabled.set_volatile_value(false);
+            State::Instance().changeBackend[Handle()->Id] = true;
+            return true;
+        }
+    }
+
     _frameCount++;
 
     return true;
@@ -1,5 +1,7 @@
 #include <pch.h>
 #include <Config.h>
+#include <misc/PipelineCache_Vk.h>
+#include <misc/GpuProfiler_Vk.h>
 
 #include "FSR2Feature_Vk_212.h"
 
@@ -23,7 +25,7 @@ bool FSR2FeatureVk212::InitFSR2(const NVSDK_NGX_Parameter* InParameters)
     auto scratchBufferSize = Fsr212::ffxFsr2GetScratchMemorySizeVK212(PhysicalDevice);
     void* scratchBuffer = calloc(scratchBufferSize, 1);
 
-    auto errorCode = Fsr212::ffxFsr2GetInterfaceVK212(&_contextDesc.callbacks, scratchBuffer, scratchBufferSize, PhysicalDevice, vkGetDeviceProcAddr);
+    auto errorCode = Fsr212::ffxFsr2GetInterfaceVK212(&_contextDesc.callbacks, scratchBuffer, scratchBufferSize, PhysicalDevice, PipelineCache_Vk::DeviceProcAddr(Device, PhysicalDevice, vkGetDeviceProcAddr));
 
     if (errorCode != Fsr212::FFX_OK)
     {
@@ -122,6 +124,8 @@ bool FSR2FeatureVk212::InitFSR2(const NVSDK_NGX_Parameter* InParameters)
 
     SetInit(true);
 
+    PipelineCache_Vk::Save();
+
     return true;
 }
 
@@ -419,7 +423,9 @@ bool FSR2FeatureVk212::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter
         params.preExposure = 1.0f;
 
     LOG_DEBUG("Dispatch!!");
+    GpuProfiler_Vk::Begin(Device, InCmdBuffer, GpuPass::Dispatch);
     auto result = Fsr212::ffxFsr2ContextDispatch212(&_context, &params);
+    GpuProfiler_Vk::End(InCmdBuffer, GpuPass::Dispatch);
 
     if (result != Fsr212::FFX_OK)
     {
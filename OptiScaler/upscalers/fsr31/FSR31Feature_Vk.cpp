@@ -2,6 +2,8 @@
 #include <Config.h>
 #include <Util.h>
 #include <proxies/FfxApi_Proxy.h>
+#include <misc/PipelineCache_Vk.h>
+#include <misc/GpuProfiler_Vk.h>
 #include "FSR31Feature_Vk.h"
 
 #include "nvsdk_ngx_vk.h"
@@ -233,19 +235,61 @@ bool FSR31FeatureVk::InitFSR3(const NVSDK_NGX_Parameter* InParameters)
         LOG_INFO("contextDesc.initFlags (NonLinearColorSpace) {0:b}", _contextDesc.flags);
     }
 
-    if (Config::Instance()->ExtendedLimits.value_or_default())
+    if (Config::Instance()->OutputScalingEnabled.value_or_default() && !Config::Instance()->DisplayResolution.value_or(false) && !State::Instance().DisplaySizeMV.value_or(false))
     {
-        _contextDesc.maxRenderSize.width = RenderWidth() < DisplayWidth() ? DisplayWidth() : RenderWidth();
-        _contextDesc.maxRenderSize.height = RenderHeight() < DisplayHeight() ? DisplayHeight() : RenderHeight();
+        float ssMulti = Config::Instance()->OutputScalingMultiplier.value_or_default();
+
+        if (ssMulti < 0.5f)
+        {
+            ssMulti = 0.5f;
+            Config::Instance()->OutputScalingMultiplier.set_volatile_value(ssMulti);
+        }
+        else if (ssMulti > 3.0f)
+        {
+            ssMulti = 3.0f;
+            Config::Instance()->OutputScalingMultiplier.set_volatile_value(ssMulti);
+        }
+
+        _targetWidth = DisplayWidth() * ssMulti;
+        _targetHeight = DisplayHeight() * ssMulti;
     }
     else
     {
-        _contextDesc.maxRenderSize.width = DisplayWidth();
-        _contextDesc.maxRenderSize.height = DisplayHeight();
+        _targetWidth = DisplayWidth();
+        _targetHeight = DisplayHeight();
     }
 
-    _contextDesc.maxUpscaleSize.width = DisplayWidth();
-    _contextDesc.maxUpscaleSize.height = DisplayHeight();
+    // extended limits changes how resolution 
+    if (Config::Instance()->ExtendedLimits.value_or_default() && RenderWidth() > DisplayWidth())
+    {
+        _contextDesc.maxRenderSize.width = RenderWidth();
+        _contextDesc.maxRenderSize.height = RenderHeight();
+
+        Config::Instance()->OutputScalingMultiplier.set_volatile_value(1.0f);
+
+        // if output scaling active let it to handle downsampling
+        if (Config::Instance()->OutputScalingEnabled.value_or_default() && !Config::Instance()->DisplayResolution.value_or(false) && !State::Instance().DisplaySizeMV.value_or(false))
+        {
+            _contextDesc.maxUpscaleSize.width = _contextDesc.maxRenderSize.width;
+            _contextDesc.maxUpscaleSize.height = _contextDesc.maxRenderSize.height;
+
+            // update target res
+            _targetWidth = _contextDesc.maxRenderSize.width;
+            _targetHeight = _contextDesc.maxRenderSize.height;
+        }
+        else
+        {
+            _contextDesc.maxUpscaleSize.width = DisplayWidth();
+            _contextDesc.maxUpscaleSize.height = DisplayHeight();
+        }
+    }
+    else
+    {
+        _contextDesc.maxRenderSize.width = TargetWidth() > DisplayWidth() ? TargetWidth() : DisplayWidth();
+        _contextDesc.maxRenderSize.height = TargetHeight() > DisplayHeight() ? TargetHeight() : DisplayHeight();
+        _contextDesc.maxUpscaleSize.width = TargetWidth();
+        _contextDesc.maxUpscaleSize.height = TargetHeight();
+    }
 
     ffxCreateBackendVKDesc backendDesc = { 0 };
     backendDesc.header.type = FFX_API_CREATE_CONTEXT_DESC_TYPE_BACKEND_VK;
@@ -253,9 +297,9 @@ bool FSR31FeatureVk::InitFSR3(const NVSDK_NGX_Parameter* InParameters)
     backendDesc.vkPhysicalDevice = PhysicalDevice;
 
     if (GDPA == nullptr)
-        backendDesc.vkDeviceProcAddr = vkGetDeviceProcAddr;
+        backendDesc.vkDeviceProcAddr = PipelineCache_Vk::DeviceProcAddr(Device, PhysicalDevice, vkGetDeviceProcAddr);
     else
-        backendDesc.vkDeviceProcAddr = GDPA;
+        backendDesc.vkDeviceProcAddr = PipelineCache_Vk::DeviceProcAddr(Device, PhysicalDevice, GDPA);
 
     _contextDesc.header.pNext = &backendDesc.header;
 
@@ -285,6 +329,8 @@ bool FSR31FeatureVk::InitFSR3(const NVSDK_NGX_Parameter* InParameters)
 
     SetInit(true);
 
+    PipelineCache_Vk::Save();
+
     return true;
 }
 
@@ -301,6 +347,8 @@ bool FSR31FeatureVk::Init(VkInstance InInstance, VkPhysicalDevice InPD, VkDevice
     GIPA = InGIPA;
     GDPA = InGDPA;
 
+    CreateShaders();
+
     return InitFSR3(InParameters);
 }
 
@@ -311,9 +359,31 @@ bool FSR31FeatureVk::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter*
     if (!IsInited())
         return false;
 
+    if (!RCAS->IsInit())
+        Config::Instance()->RcasEnabled.set_volatile_value(false);
+
     struct ffxDispatchDescUpscale params = { 0 };
     params.header.type = FFX_API_DISPATCH_DESC_TYPE_UPSCALE;
 
+    if (Config::Instance()->OverrideSharpness.value_or_default())
+        _sharpness = Config::Instance()->Sharpness.value_or_default();
+    else
+        _sharpness = GetSharpness(InParameters);
+
+    if (Config::Instance()->RcasEnabled.value_or_default())
+    {
+        params.enableSharpening = false;
+        params.sharpness = 0.0f;
+    }
+    else
+    {
+        if (_sharpness > 1.0f)
+            _sharpness = 1.0f;
+
+        params.enableSharpening = _sharpness > 0.0f;
+        params.sharpness = _sharpness;
+    }
+
     if (Config::Instance()->FsrDebugView.value_or_default())
         params.flags = FFX_UPSCALE_FLAG_DRAW_DEBUG_VIEW;
 
@@ -333,6 +403,8 @@ bool FSR31FeatureVk::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter*
 
     LOG_DEBUG("Input Resolution: {0}x{1}", params.renderSize.width, params.renderSize.height);
 
+    bool useSS = Config::Instance()->OutputScalingEnabled.value_or_default() && !Config::Instance()->DisplayResolution.value_or(false) && !State::Instance().DisplaySizeMV.value_or(false);
+
     params.commandList = InCmdBuffer;
 
     void* paramColor;
@@ -372,12 +444,36 @@ bool FSR31FeatureVk::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter*
     void* paramOutput;
     InParameters->Get(NVSDK_NGX_Parameter_Output, &paramOutput);
 
+    // Resource upscaler writes, might be output scaler's or RCAS's buffer
+    NVSDK_NGX_Resource_VK* upscalerOutput = (NVSDK_NGX_Resource_VK*)paramOutput;
+
     if (paramOutput)
     {
         LOG_DEBUG("Output exist..");
 
-        params.output = ffxApiGetResourceVK(((NVSDK_NGX_Resource_VK*)paramOutput)->Resource.ImageViewInfo.Image,
-                                            ffxApiGetImageResourceDescriptionVKLocal((NVSDK_NGX_Resource_VK*)paramOutput),
+        if (useSS)
+        {
+            if (OutputScaler->CreateBufferResource(InCmdBuffer, (NVSDK_NGX_Resource_VK*)paramOutput, TargetWidth(), TargetHeight()))
+            {
+                OutputScaler->SetBufferState(InCmdBuffer, VK_ACCESS_SHADER_WRITE_BIT);
+                upscalerOutput = OutputScaler->Buffer();
+            }
+            else
+            {
+                useSS = false;
+            }
+        }
+
+        if (Config::Instance()->RcasEnabled.value_or_default() &&
+            (_sharpness > 0.0f || (Config::Instance()->MotionSharpnessEnabled.value_or_default() && Config::Instance()->MotionSharpness.value_or_default() > 0.0f)) &&
+            RCAS != nullptr && RCAS.get() != nullptr && RCAS->IsInit() &&
+            RCAS->CreateBufferResource(InCmdBuffer, upscalerOutput, upscalerOutput->Resource.ImageViewInfo.Width, upscalerOutput->Resource.ImageViewInfo.Height))
+        {
+            RCAS->SetBufferState(InCmdBuffer, VK_ACCESS_SHADER_WRITE_BIT);
+            upscalerOutput = RCAS->Buffer();
+        }
+
+        params.output = ffxApiGetResourceVK(upscalerOutput->Resource.ImageViewInfo.Image, ffxApiGetImageResourceDescriptionVKLocal(upscalerOutput),
                                             FFX_API_RESOURCE_STATE_UNORDERED_ACCESS);
     }
     else
@@ -492,30 +588,6 @@ bool FSR31FeatureVk::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter*
         params.motionVectorScale.y = MVScaleY;
     }
 
-    if (Config::Instance()->OverrideSharpness.value_or_default())
-    {
-        params.enableSharpening = Config::Instance()->Sharpness.value_or_default() > 0.0f;
-        params.sharpness = Config::Instance()->Sharpness.value_or_default();
-    }
-    else
-    {
-        float shapness = 0.0f;
-        if (InParameters->Get(NVSDK_NGX_Parameter_Sharpness, &shapness) == NVSDK_NGX_Result_Success)
-        {
-            _sharpness = shapness;
-
-            params.enableSharpening = shapness > 0.0f;
-
-            if (params.enableSharpening)
-            {
-                if (shapness > 1.0f)
-                    params.sharpness = 1.0f;
-                else
-                    params.sharpness = shapness;
-            }
-        }
-    }
-
     if (IsDepthInverted())
     {
         params.cameraFar = Config::Instance()->FsrCameraNear.value_or_default();
@@ -553,6 +625,9 @@ bool FSR31FeatureVk::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter*
             LOG_WARN("Velocity configure result: {}", (UINT)result);
     }
 
+    params.upscaleSize.width = TargetWidth();
+    params.upscaleSize.height = TargetHeight();
+
     if (InParameters->Get("FSR.upscaleSize.width", &params.upscaleSize.width) == NVSDK_NGX_Result_Success && Config::Instance()->OutputScalingEnabled.value_or_default())
         params.upscaleSize.width *= Config::Instance()->OutputScalingMultiplier.value_or_default();
 
@@ -560,7 +635,9 @@ bool FSR31FeatureVk::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter*
         params.upscaleSize.height *= Config::Instance()->OutputScalingMultiplier.value_or_default();
 
     LOG_DEBUG("Dispatch!!");
+    GpuProfiler_Vk::Begin(Device, InCmdBuffer, GpuPass::Dispatch);
     auto result = FfxApiProxy::VULKAN_Dispatch()(&_context, &params.header);
+    GpuProfiler_Vk::End(InCmdBuffer, GpuPass::Dispatch);
 
     if (result != FFX_API_RETURN_OK)
     {
@@ -568,6 +645,46 @@ bool FSR31FeatureVk::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter*
         return false;
     }
 
+    // apply rcas
+    if (Config::Instance()->RcasEnabled.value_or_default() &&
+        (_sharpness > 0.0f || (Config::Instance()->MotionSharpnessEnabled.value_or_default() && Config::Instance()->MotionSharpness.value_or_default() > 0.0f)) &&
+        RCAS != nullptr && RCAS.get() != nullptr && RCAS->CanRender() && upscalerOutput == RCAS->Buffer())
+    {
+        RCAS->SetBufferState(InCmdBuffer, VK_ACCESS_SHADER_READ_BIT);
+
+        RcasConstants rcasConstants{};
+
+        rcasConstants.Sharpness = _sharpness;
+        rcasConstants.DisplayWidth = TargetWidth();
+        rcasConstants.DisplayHeight = TargetHeight();
+        InParameters->Get(NVSDK_NGX_Parameter_MV_Scale_X, &rcasConstants.MvScaleX);
+        InParameters->Get(NVSDK_NGX_Parameter_MV_Scale_Y, &rcasConstants.MvScaleY);
+        rcasConstants.DisplaySizeMV = !(GetFeatureFlags() & NVSDK_NGX_DLSS_Feature_Flags_MVLowRes);
+        rcasConstants.RenderHeight = RenderHeight();
+        rcasConstants.RenderWidth = RenderWidth();
+
+        auto rcasOutput = useSS ? OutputScaler->Buffer() : (NVSDK_NGX_Resource_VK*)paramOutput;
+
+        if (!RCAS->Dispatch(InCmdBuffer, RCAS->Buffer(), (NVSDK_NGX_Resource_VK*)paramVelocity, rcasConstants, rcasOutput))
+        {
+            Config::Instance()->RcasEnabled.set_volatile_value(false);
+            return true;
+        }
+    }
+
+    if (useSS)
+    {
+        LOG_DEBUG("scaling output...");
+        OutputScaler->SetBufferState(InCmdBuffer, VK_ACCESS_SHADER_READ_BIT);
+
+        if (!OutputScaler->Dispatch(InCmdBuffer, OutputScaler->Buffer(), (NVSDK_NGX_Resource_VK*)paramOutput))
+        {
+            Config::Instance()->OutputScalingEnabled.set_volatile_value(false);
+            State::Instance().changeBackend[Handle()->Id] = true;
+            return true;
+        }
+    }
+
     _frameCount++;
 
     return true;
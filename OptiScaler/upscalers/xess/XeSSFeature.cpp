@@ -1,5 +1,6 @@
 #pragma once
 #include "XeSSFeature.h"
+#include "XeSSPipelineCache.h"
 
 #include <pch.h>
 #include <Config.h>
@@ -278,7 +279,14 @@ bool XeSSFeature::InitXeSS(ID3D12Device* device, const NVSDK_NGX_Parameter* InPa
         }
         else
         {
-            HRESULT hr = device1->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(&_localPipeline));
+            HRESULT hr = S_OK;
+
+            // Shared library keeps pipelines between features & launches
+            if (Config::Instance()->XeSSUsePipelineCache.value_or_default())
+                _localPipeline = XeSSPipelineCache::Get(device);
+
+            if (_localPipeline == nullptr)
+                hr = device1->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(&_localPipeline));
 
             if (FAILED(hr) || !_localPipeline)
             {
@@ -334,11 +342,33 @@ bool XeSSFeature::InitXeSS(ID3D12Device* device, const NVSDK_NGX_Parameter* InPa
         return false;
     }
 
+    // Without build status, pipelines are saved when cache is released
+    if (xessParams.pPipelineLibrary != nullptr && Config::Instance()->XeSSUsePipelineCache.value_or_default())
+        _pipelineCachePending = XeSSProxy::GetPipelineBuildStatus() != nullptr;
+
     SetInit(true);
 
     return true;
 }
 
+void XeSSFeature::CheckPipelineCache()
+{
+    if (!_pipelineCachePending)
+        return;
+
+    auto ret = XeSSProxy::GetPipelineBuildStatus()(_xessContext);
+
+    if (ret == XESS_RESULT_ERROR_OPERATION_IN_PROGRESS)
+        return;
+
+    _pipelineCachePending = false;
+
+    if (ret == XESS_RESULT_SUCCESS)
+        XeSSPipelineCache::Save();
+    else
+        LOG_WARN("xessGetPipelineBuildStatus: {0}", ResultToString(ret));
+}
+
 XeSSFeature::XeSSFeature(unsigned int handleId, NVSDK_NGX_Parameter* InParameters) : IFeature(handleId, InParameters)
 {
 }
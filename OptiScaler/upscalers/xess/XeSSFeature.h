@@ -41,7 +41,11 @@ protected:
 	
 	int dumpCount = 0;
 
+	// Pipelines are built in background, cache is saved when build is completed
+	bool _pipelineCachePending = false;
+
 	bool InitXeSS(ID3D12Device* device, const NVSDK_NGX_Parameter* InParameters);
+	void CheckPipelineCache();
 
 public:
 	feature_version Version() { return feature_version{ XeSSProxy::Version().major, XeSSProxy::Version().minor, XeSSProxy::Version().patch}; }
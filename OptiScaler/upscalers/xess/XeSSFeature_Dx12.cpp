@@ -38,6 +38,8 @@ bool XeSSFeatureDx12::Evaluate(ID3D12GraphicsCommandList* InCommandList, NVSDK_N
         return false;
     }
 
+    CheckPipelineCache();
+
     if (!RCAS->IsInit())
         Config::Instance()->RcasEnabled = false;
 
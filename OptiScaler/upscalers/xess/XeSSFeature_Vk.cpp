@@ -1,5 +1,6 @@
 #include "XeSSFeature_Vk.h"
 #include <nvsdk_ngx_vk.h>
+#include <misc/GpuProfiler_Vk.h>
 
 static std::string ResultToString(xess_result_t result)
 {
@@ -80,6 +81,12 @@ bool XeSSFeature_Vk::Init(VkInstance InInstance, VkPhysicalDevice InPD, VkDevice
         return false;
     }
 
+    Instance = InInstance;
+    PhysicalDevice = InPD;
+    Device = InDevice;
+
+    CreateShaders();
+
     State::Instance().skipSpoofing = true;
 
     auto ret = XeSSProxy::VKCreateContext()(InInstance, InPD, InDevice, &_xessContext);
@@ -248,7 +255,7 @@ bool XeSSFeature_Vk::Init(VkInstance InInstance, VkPhysicalDevice InPD, VkDevice
         _targetHeight = RenderHeight();
 
         // enable output scaling to restore image
-        if (!Config::Instance()->DisplayResolution.value_or(false))
+        if (!Config::Instance()->DisplayResolution.value_or(false) && OutputScaler->IsInit())
         {
             Config::Instance()->OutputScalingMultiplier = 1.0f;
             Config::Instance()->OutputScalingEnabled = true;
@@ -398,6 +405,9 @@ bool XeSSFeature_Vk::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter*
         return false;
     }
 
+    if (!RCAS->IsInit())
+        Config::Instance()->RcasEnabled.set_volatile_value(false);
+
     if (State::Instance().xessDebug)
     {
         LOG_ERROR("xessDebug");
@@ -462,10 +472,35 @@ bool XeSSFeature_Vk::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter*
     }
 
     NVSDK_NGX_Resource_VK* paramOutput = nullptr;
+    NVSDK_NGX_Resource_VK* upscalerOutput = nullptr;
     if (InParameters->Get(NVSDK_NGX_Parameter_Output, (void**)&paramOutput) == NVSDK_NGX_Result_Success && paramOutput != nullptr)
     {
         LOG_DEBUG("Output exist..");
-        params.outputTexture = NV_to_XeSS(paramOutput);
+
+        upscalerOutput = paramOutput;
+
+        if (useSS)
+        {
+            if (OutputScaler->CreateBufferResource(InCmdBuffer, paramOutput, TargetWidth(), TargetHeight()))
+            {
+                OutputScaler->SetBufferState(InCmdBuffer, VK_ACCESS_SHADER_WRITE_BIT);
+                upscalerOutput = OutputScaler->Buffer();
+            }
+            else
+            {
+                useSS = false;
+            }
+        }
+
+        if (Config::Instance()->RcasEnabled.value_or(true) &&
+            (sharpness > 0.0f || (Config::Instance()->MotionSharpnessEnabled.value_or(false) && Config::Instance()->MotionSharpness.value_or(0.4) > 0.0f)) &&
+            RCAS->IsInit() && RCAS->CreateBufferResource(InCmdBuffer, upscalerOutput, upscalerOutput->Resource.ImageViewInfo.Width, upscalerOutput->Resource.ImageViewInfo.Height))
+        {
+            RCAS->SetBufferState(InCmdBuffer, VK_ACCESS_SHADER_WRITE_BIT);
+            upscalerOutput = RCAS->Buffer();
+        }
+
+        params.outputTexture = NV_to_XeSS(upscalerOutput);
     }
     else
     {
@@ -561,7 +596,9 @@ bool XeSSFeature_Vk::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter*
         LOG_WARN("Can't get motion vector scales!");
 
     LOG_DEBUG("Executing!!");
+    GpuProfiler_Vk::Begin(Device, InCmdBuffer, GpuPass::Dispatch);
     xessResult = XeSSProxy::VKExecute()(_xessContext, InCmdBuffer, &params);
+    GpuProfiler_Vk::End(InCmdBuffer, GpuPass::Dispatch);
 
     if (xessResult != XESS_RESULT_SUCCESS)
     {
@@ -569,6 +606,44 @@ bool XeSSFeature_Vk::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter*
         return false;
     }
 
+    // Apply RCAS
+    if (Config::Instance()->RcasEnabled.value_or(true) &&
+        (sharpness > 0.0f || (Config::Instance()->MotionSharpnessEnabled.value_or(false) && Config::Instance()->MotionSharpness.value_or(0.4) > 0.0f)) &&
+        RCAS->CanRender() && upscalerOutput == RCAS->Buffer())
+    {
+        RCAS->SetBufferState(InCmdBuffer, VK_ACCESS_SHADER_READ_BIT);
+
+        RcasConstants rcasConstants{};
+
+        rcasConstants.Sharpness = sharpness;
+        rcasConstants.DisplayWidth = TargetWidth();
+        rcasConstants.DisplayHeight = TargetHeight();
+        InParameters->Get(NVSDK_NGX_Parameter_MV_Scale_X, &rcasConstants.MvScaleX);
+        InParameters->Get(NVSDK_NGX_Parameter_MV_Scale_Y, &rcasConstants.MvScaleY);
+        rcasConstants.DisplaySizeMV = !(GetFeatureFlags() & NVSDK_NGX_DLSS_Feature_Flags_MVLowRes);
+        rcasConstants.RenderHeight = RenderHeight();
+        rcasConstants.RenderWidth = RenderWidth();
+
+        if (!RCAS->Dispatch(InCmdBuffer, RCAS->Buffer(), paramVelocity, rcasConstants, useSS ? OutputScaler->Buffer() : paramOutput))
+        {
+            Config::Instance()->RcasEnabled.set_volatile_value(false);
+            return true;
+        }
+    }
+
+    if (useSS)
+    {
+        LOG_DEBUG("scaling output...");
+        OutputScaler->SetBufferState(InCmdBuffer, VK_ACCESS_SHADER_READ_BIT);
+
+        if (!OutputScaler->Dispatch(InCmdBuffer, OutputScaler->Buffer(), paramOutput))
+        {
+            Config::Instance()->OutputScalingEnabled.set_volatile_value(false);
+            State::Instance().changeBackend[Handle()->Id] = true;
+            return true;
+        }
+    }
+
     _frameCount++;
 
     return true;
@@ -0,0 +1,348 @@
+#include "XeSSPipelineCache.h"
+
+#include <Config.h>
+#include <State.h>
+#include <Util.h>
+#include <proxies/XeSS_Proxy.h>
+
+#include <dxgi1_4.h>
+#include <fstream>
+
+constexpr uint32_t CacheMagic = 0x50535858; // XXSP
+constexpr uint32_t CacheFormatVersion = 1;
+
+std::filesystem::path XeSSPipelineCache::CachePath()
+{
+    return Util::DllPath().parent_path() / "OptiScaler_XeSS.plc";
+}
+
+bool XeSSPipelineCache::FillHeader(ID3D12Device* InDevice, Header* OutHeader)
+{
+    *OutHeader = {};
+    OutHeader->Magic = CacheMagic;
+    OutHeader->FormatVersion = CacheFormatVersion;
+
+    auto xessVersion = XeSSProxy::Version();
+    OutHeader->XeSSVersion = (xessVersion.major << 24) | (xessVersion.minor << 16) | xessVersion.patch;
+
+    IDXGIFactory4* factory = nullptr;
+    if (CreateDXGIFactory2(0, IID_PPV_ARGS(&factory)) != S_OK || factory == nullptr)
+    {
+        LOG_ERROR("Can't create factory");
+        return false;
+    }
+
+    IDXGIAdapter1* adapter = nullptr;
+    auto result = factory->EnumAdapterByLuid(InDevice->GetAdapterLuid(), IID_PPV_ARGS(&adapter));
+    factory->Release();
+
+    if (result != S_OK || adapter == nullptr)
+    {
+        LOG_ERROR("Can't find adapter of device: {0:X}", (UINT)result);
+        return false;
+    }
+
+    DXGI_ADAPTER_DESC1 desc{};
+    LARGE_INTEGER driverVersion{};
+
+    // Cache must be keyed with real adapter info
+    State::Instance().skipSpoofing = true;
+    result = adapter->GetDesc1(&desc);
+    adapter->CheckInterfaceSupport(__uuidof(IDXGIDevice), &driverVersion);
+    State::Instance().skipSpoofing = false;
+
+    adapter->Release();
+
+    if (result != S_OK)
+    {
+        LOG_ERROR("Can't get adapter desc: {0:X}", (UINT)result);
+        return false;
+    }
+
+    OutHeader->VendorId = desc.VendorId;
+    OutHeader->DeviceId = desc.DeviceId;
+    OutHeader->SubSysId = desc.SubSysId;
+    OutHeader->Revision = desc.Revision;
+    OutHeader->DriverVersion = driverVersion.QuadPart;
+
+    return true;
+}
+
+void XeSSPipelineCache::ReadFile()
+{
+    auto path = CachePath();
+
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+    {
+        LOG_DEBUG("No cache file at {0}", path.string());
+        return;
+    }
+
+    auto size = (size_t)file.tellg();
+    file.seekg(0);
+
+    std::vector<uint8_t> data(size);
+    if (!file.read((char*)data.data(), size))
+    {
+        LOG_ERROR("Can't read {0}", path.string());
+        return;
+    }
+
+    LOG_DEBUG("Read {0} bytes from {1}", size, path.string());
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _fileData = std::move(data);
+}
+
+void XeSSPipelineCache::WriteFile(std::vector<uint8_t> InData)
+{
+    auto path = CachePath();
+    auto tempPath = path;
+    tempPath += ".tmp";
+
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open() || !file.write((const char*)InData.data(), InData.size()))
+        {
+            LOG_ERROR("Can't write {0}", tempPath.string());
+            return;
+        }
+    }
+
+    // Replace old file only after new one is completely written
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+
+    if (ec)
+        LOG_ERROR("Can't replace {0}: {1}", path.string(), ec.message());
+    else
+        LOG_INFO("Saved {0} bytes to {1}", InData.size(), path.string());
+}
+
+bool XeSSPipelineCache::Serialize(ID3D12PipelineLibrary* InLibrary, Header InHeader, std::vector<uint8_t>* OutData)
+{
+    // Pipelines might be stored between size query & serialize, size is queried again when it fails
+    for (int i = 0; i < 3; i++)
+    {
+        auto size = InLibrary->GetSerializedSize();
+        InHeader.BlobSize = size;
+
+        OutData->resize(sizeof(Header) + size);
+        memcpy(OutData->data(), &InHeader, sizeof(Header));
+
+        auto hr = InLibrary->Serialize(OutData->data() + sizeof(Header), size);
+
+        if (hr == S_OK)
+            return true;
+
+        LOG_WARN("Serialize failed {0:x}, size: {1}", (UINT)hr, size);
+    }
+
+    OutData->clear();
+    return false;
+}
+
+void XeSSPipelineCache::ReleaseLibrary()
+{
+    if (_library != nullptr && _library->Release() > 0)
+    {
+        // Features still use the library, keep its blob alive
+        _retiredBlobs.push_back(std::move(_blob));
+    }
+
+    _library = nullptr;
+    _blob.clear();
+}
+
+void XeSSPipelineCache::WaitIO()
+{
+    if (!_ioThread.joinable())
+        return;
+
+    if (State::Instance().isShuttingDown)
+        _ioThread.detach();
+    else
+        _ioThread.join();
+}
+
+void XeSSPipelineCache::Preload()
+{
+    WaitIO();
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if (_library != nullptr || !_fileData.empty())
+            return;
+    }
+
+    _ioThread = std::thread(&XeSSPipelineCache::ReadFile);
+}
+
+ID3D12PipelineLibrary* XeSSPipelineCache::Get(ID3D12Device* InDevice)
+{
+    if (InDevice == nullptr)
+        return nullptr;
+
+    // Read file if Preload wasn't called
+    if (!_ioThread.joinable() && _library == nullptr && _fileData.empty())
+        ReadFile();
+
+    WaitIO();
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_library != nullptr && _device == InDevice)
+    {
+        _library->AddRef();
+        return _library;
+    }
+
+    if (_library != nullptr)
+    {
+        LOG_DEBUG("Device changed, recreating pipeline library");
+        ReleaseLibrary();
+    }
+
+    _savedSize = 0;
+    _device = InDevice;
+
+    ID3D12Device1* device1 = nullptr;
+    if (InDevice->QueryInterface(IID_PPV_ARGS(&device1)) != S_OK || device1 == nullptr)
+    {
+        LOG_ERROR("QueryInterface device1 failed!");
+        return nullptr;
+    }
+
+    bool validHeader = FillHeader(InDevice, &_header);
+
+    if (validHeader && _fileData.size() > sizeof(Header))
+    {
+        Header fileHeader{};
+        memcpy(&fileHeader, _fileData.data(), sizeof(Header));
+
+        if (fileHeader.Magic == _header.Magic && fileHeader.FormatVersion == _header.FormatVersion &&
+            fileHeader.VendorId == _header.VendorId && fileHeader.DeviceId == _header.DeviceId &&
+            fileHeader.SubSysId == _header.SubSysId && fileHeader.Revision == _header.Revision &&
+            fileHeader.DriverVersion == _header.DriverVersion && fileHeader.XeSSVersion == _header.XeSSVersion &&
+            fileHeader.BlobSize == _fileData.size() - sizeof(Header))
+        {
+            _blob.assign(_fileData.begin() + sizeof(Header), _fileData.end());
+
+            auto hr = device1->CreatePipelineLibrary(_blob.data(), _blob.size(), IID_PPV_ARGS(&_library));
+
+            if (hr == S_OK && _library != nullptr)
+            {
+                LOG_INFO("Loaded pipeline library from cache ({0} bytes)", _blob.size());
+                _savedSize = _blob.size();
+            }
+            else
+            {
+                // Driver also validates the blob, D3D12_ERROR_DRIVER_VERSION_MISMATCH etc.
+                LOG_WARN("Cached pipeline library rejected: {0:X}", (UINT)hr);
+                _library = nullptr;
+                _blob.clear();
+            }
+        }
+        else
+        {
+            LOG_INFO("Pipeline cache is invalidated (adapter, driver or libxess changed)");
+        }
+    }
+
+    _fileData.clear();
+    _fileData.shrink_to_fit();
+
+    if (_library == nullptr)
+    {
+        auto hr = device1->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(&_library));
+
+        if (hr != S_OK || _library == nullptr)
+        {
+            LOG_ERROR("CreatePipelineLibrary failed {0:x}!", (UINT)hr);
+            _library = nullptr;
+        }
+    }
+
+    device1->Release();
+
+    // Without adapter info cache can't be validated later, use library only for this session
+    if (!validHeader)
+        _header.Magic = 0;
+
+    if (_library != nullptr)
+        _library->AddRef();
+
+    return _library;
+}
+
+void XeSSPipelineCache::Save()
+{
+    WaitIO();
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_library == nullptr || _header.Magic != CacheMagic)
+        return;
+
+    auto size = _library->GetSerializedSize();
+
+    if (size <= _savedSize)
+        return;
+
+    _savedSize = size;
+
+    auto library = _library;
+    library->AddRef();
+
+    auto header = _header;
+
+    // Serialize & write on a worker, pipeline library methods are free threaded
+    _ioThread = std::thread([library, header]()
+                            {
+                                std::vector<uint8_t> data;
+                                bool serialized = Serialize(library, header, &data);
+                                library->Release();
+
+                                if (!serialized)
+                                {
+                                    LOG_ERROR("Can't serialize pipeline library");
+
+                                    // Let next Save try again
+                                    std::lock_guard<std::mutex> lock(_mutex);
+
+                                    if (_library == library)
+                                        _savedSize = 0;
+
+                                    return;
+                                }
+
+                                WriteFile(std::move(data));
+                            });
+}
+
+void XeSSPipelineCache::Release()
+{
+    WaitIO();
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // Pipelines which finished building after last Save, file IO is not safe during process exit
+    if (!State::Instance().isShuttingDown && _library != nullptr && _header.Magic == CacheMagic &&
+        _library->GetSerializedSize() > _savedSize)
+    {
+        std::vector<uint8_t> data;
+
+        if (Serialize(_library, _header, &data))
+            WriteFile(std::move(data));
+        else
+            LOG_ERROR("Can't serialize pipeline library");
+    }
+
+    ReleaseLibrary();
+
+    _fileData.clear();
+    _savedSize = 0;
+    _device = nullptr;
+}
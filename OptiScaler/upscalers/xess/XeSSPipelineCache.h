@@ -0,0 +1,64 @@
+#pragma once
+#include <pch.h>
+
+#include <d3d12.h>
+#include <filesystem>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <atomic>
+
+// Process wide XeSS pipeline library, serialized next to the ini and reloaded on next launch
+// Cache file is only used when adapter, driver and libxess versions match
+class XeSSPipelineCache
+{
+private:
+	struct Header
+	{
+		uint32_t Magic;
+		uint32_t FormatVersion;
+		uint32_t VendorId;
+		uint32_t DeviceId;
+		uint32_t SubSysId;
+		uint32_t Revision;
+		int64_t DriverVersion;
+		uint32_t XeSSVersion;
+		uint32_t Padding;
+		uint64_t BlobSize;
+	};
+
+	inline static std::mutex _mutex;
+	inline static std::thread _ioThread;
+
+	inline static ID3D12Device* _device = nullptr;
+	inline static ID3D12PipelineLibrary* _library = nullptr;
+	inline static Header _header{};
+
+	// Pipeline library keeps pointing to this blob, it must stay alive with the library
+	inline static std::vector<uint8_t> _blob;
+	inline static std::vector<std::vector<uint8_t>> _retiredBlobs;
+	inline static std::vector<uint8_t> _fileData;
+	inline static size_t _savedSize = 0;
+
+	static std::filesystem::path CachePath();
+	static bool FillHeader(ID3D12Device* InDevice, Header* OutHeader);
+	static void ReadFile();
+	static void WriteFile(std::vector<uint8_t> InData);
+	static bool Serialize(ID3D12PipelineLibrary* InLibrary, Header InHeader, std::vector<uint8_t>* OutData);
+	static void WaitIO();
+	static void ReleaseLibrary();
+
+public:
+	// Reads cache file on a worker thread
+	static void Preload();
+
+	// Returns an AddRef'ed library for InDevice, primed from cache file when it's valid
+	static ID3D12PipelineLibrary* Get(ID3D12Device* InDevice);
+
+	// Serializes the library on a worker thread if new pipelines are added
+	// Should be called after xessGetPipelineBuildStatus reports pipelines are built
+	static void Save();
+
+	// Saves the library if it has unsaved pipelines, then releases it
+	static void Release();
+};
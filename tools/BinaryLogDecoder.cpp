@@ -0,0 +1,553 @@
+// Converts binary logs (OptiScaler.blog, Log.LogBinary=true) to text
+//
+// Only needs a C++17 compiler:
+//   g++ -std=c++17 -O2 -o BinaryLogDecoder tools/BinaryLogDecoder.cpp
+//   cl /std:c++17 /O2 /EHsc tools\BinaryLogDecoder.cpp
+//
+// Usage: BinaryLogDecoder OptiScaler.blog [output.log]
+// Events of all threads are sorted by time, output uses the same line format with text logs
+
+#include "../OptiScaler/misc/BinaryLogFormat.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace BinaryLogFormat;
+
+struct Arg
+{
+    ArgType Type;
+    int64_t Int = 0;
+    uint64_t UInt = 0;
+    double Double = 0.0;
+    std::string String;
+};
+
+struct Event
+{
+    int64_t Counter;
+    uint32_t ThreadId;
+    uint32_t Id;
+    size_t Sequence;
+    std::vector<Arg> Args;
+};
+
+struct Format
+{
+    uint8_t Level = 2;
+    std::string Text;
+};
+
+struct Spec
+{
+    char Fill = ' ';
+    char Align = 0;
+    char Sign = 0;
+    bool Alternate = false;
+    bool Zero = false;
+    int Width = 0;
+    int Precision = -1;
+    char Type = 0;
+};
+
+static const char LevelLetters[] = { 'T', 'D', 'I', 'W', 'E', 'C', 'O' };
+
+static bool ParseArgs(const uint8_t* InData, size_t InSize, std::vector<Arg>* OutArgs)
+{
+    size_t offset = 0;
+
+    while (offset < InSize)
+    {
+        Arg arg{};
+        arg.Type = (ArgType)InData[offset++];
+
+        size_t size = 0;
+
+        switch (arg.Type)
+        {
+            case ArgType::Int:
+            case ArgType::UInt:
+            case ArgType::Double:
+            case ArgType::Pointer:
+                size = 8;
+                break;
+
+            case ArgType::Bool:
+            case ArgType::Char:
+                size = 1;
+                break;
+
+            case ArgType::String:
+            {
+                uint16_t length = 0;
+
+                if (offset + 2 > InSize)
+                    return false;
+
+                memcpy(&length, InData + offset, 2);
+                offset += 2;
+
+                if (offset + length > InSize)
+                    return false;
+
+                arg.String.assign((const char*)InData + offset, length);
+                offset += length;
+                OutArgs->push_back(arg);
+                continue;
+            }
+
+            default:
+                return false;
+        }
+
+        if (offset + size > InSize)
+            return false;
+
+        if (arg.Type == ArgType::Int)
+            memcpy(&arg.Int, InData + offset, 8);
+        else if (arg.Type == ArgType::Double)
+            memcpy(&arg.Double, InData + offset, 8);
+        else if (size == 8)
+            memcpy(&arg.UInt, InData + offset, 8);
+        else
+            arg.UInt = InData[offset];
+
+        offset += size;
+        OutArgs->push_back(arg);
+    }
+
+    return true;
+}
+
+static Spec ParseSpec(const std::string& InSpec)
+{
+    Spec spec{};
+    size_t i = 0;
+
+    auto isAlign = [](char c) { return c == '<' || c == '>' || c == '^'; };
+
+    if (InSpec.size() >= 2 && isAlign(InSpec[1]))
+    {
+        spec.Fill = InSpec[0];
+        spec.Align = InSpec[1];
+        i = 2;
+    }
+    else if (!InSpec.empty() && isAlign(InSpec[0]))
+    {
+        spec.Align = InSpec[0];
+        i = 1;
+    }
+
+    if (i < InSpec.size() && (InSpec[i] == '+' || InSpec[i] == '-' || InSpec[i] == ' '))
+        spec.Sign = InSpec[i++];
+
+    if (i < InSpec.size() && InSpec[i] == '#')
+    {
+        spec.Alternate = true;
+        i++;
+    }
+
+    if (i < InSpec.size() && InSpec[i] == '0')
+    {
+        spec.Zero = true;
+        i++;
+    }
+
+    while (i < InSpec.size() && isdigit((unsigned char)InSpec[i]))
+        spec.Width = spec.Width * 10 + (InSpec[i++] - '0');
+
+    if (i < InSpec.size() && InSpec[i] == '.')
+    {
+        spec.Precision = 0;
+        i++;
+
+        while (i < InSpec.size() && isdigit((unsigned char)InSpec[i]))
+            spec.Precision = spec.Precision * 10 + (InSpec[i++] - '0');
+    }
+
+    if (i < InSpec.size())
+        spec.Type = InSpec[i];
+
+    return spec;
+}
+
+static std::string FormatUnsigned(uint64_t InValue, char InType, bool InAlternate)
+{
+    char buffer[80];
+
+    switch (InType)
+    {
+        case 'x':
+            snprintf(buffer, sizeof(buffer), InAlternate ? "0x%llx" : "%llx", (unsigned long long)InValue);
+            return buffer;
+
+        case 'X':
+            snprintf(buffer, sizeof(buffer), InAlternate ? "0X%llX" : "%llX", (unsigned long long)InValue);
+            return buffer;
+
+        case 'o':
+            snprintf(buffer, sizeof(buffer), InAlternate ? "0%llo" : "%llo", (unsigned long long)InValue);
+            return buffer;
+
+        case 'b':
+        case 'B':
+        {
+            std::string result;
+
+            do
+            {
+                result.insert(result.begin(), (char)('0' + (InValue & 1)));
+                InValue >>= 1;
+            } while (InValue != 0);
+
+            return InAlternate ? "0b" + result : result;
+        }
+
+        default:
+            snprintf(buffer, sizeof(buffer), "%llu", (unsigned long long)InValue);
+            return buffer;
+    }
+}
+
+static std::string FormatDouble(double InValue, const Spec& InSpec)
+{
+    char buffer[128];
+    char type = InSpec.Type;
+
+    if (type == 'f' || type == 'F' || type == 'e' || type == 'E' || type == 'g' || type == 'G')
+    {
+        char format[8] = { '%', '.', '*', type, 0 };
+        snprintf(buffer, sizeof(buffer), format, InSpec.Precision < 0 ? 6 : InSpec.Precision, InValue);
+        return buffer;
+    }
+
+    if (InSpec.Precision >= 0)
+    {
+        snprintf(buffer, sizeof(buffer), "%.*g", InSpec.Precision, InValue);
+        return buffer;
+    }
+
+    // Shortest representation which reads back same value, like std::format
+    for (int precision = 1; precision <= 17; precision++)
+    {
+        snprintf(buffer, sizeof(buffer), "%.*g", precision, InValue);
+
+        if (strtod(buffer, nullptr) == InValue)
+            break;
+    }
+
+    return buffer;
+}
+
+static std::string FormatArg(const Arg& InArg, const Spec& InSpec)
+{
+    std::string body;
+    std::string sign;
+    bool numeric = true;
+
+    switch (InArg.Type)
+    {
+        case ArgType::Int:
+        {
+            if (InSpec.Type == 'c')
+            {
+                body = std::string(1, (char)InArg.Int);
+                numeric = false;
+                break;
+            }
+
+            uint64_t magnitude = InArg.Int < 0 ? (uint64_t)0 - (uint64_t)InArg.Int : (uint64_t)InArg.Int;
+            body = FormatUnsigned(magnitude, InSpec.Type, InSpec.Alternate);
+
+            if (InArg.Int < 0)
+                sign = "-";
+
+            break;
+        }
+
+        case ArgType::UInt:
+            if (InSpec.Type == 'c')
+            {
+                body = std::string(1, (char)InArg.UInt);
+                numeric = false;
+            }
+            else
+            {
+                body = FormatUnsigned(InArg.UInt, InSpec.Type, InSpec.Alternate);
+            }
+
+            break;
+
+        case ArgType::Double:
+            body = FormatDouble(InArg.Double, InSpec);
+
+            if (!body.empty() && body[0] == '-')
+            {
+                sign = "-";
+                body.erase(0, 1);
+            }
+
+            break;
+
+        case ArgType::Bool:
+            if (InSpec.Type == 0 || InSpec.Type == 's')
+            {
+                body = InArg.UInt != 0 ? "true" : "false";
+                numeric = false;
+            }
+            else
+            {
+                body = FormatUnsigned(InArg.UInt, InSpec.Type, InSpec.Alternate);
+            }
+
+            break;
+
+        case ArgType::Char:
+            if (InSpec.Type == 0 || InSpec.Type == 'c')
+            {
+                body = std::string(1, (char)InArg.UInt);
+                numeric = false;
+            }
+            else
+            {
+                body = FormatUnsigned(InArg.UInt, InSpec.Type, InSpec.Alternate);
+            }
+
+            break;
+
+        case ArgType::Pointer:
+            body = "0x" + FormatUnsigned(InArg.UInt, 'x', false);
+            break;
+
+        case ArgType::String:
+            body = InArg.String;
+
+            if (InSpec.Precision >= 0 && (size_t)InSpec.Precision < body.size())
+                body.resize(InSpec.Precision);
+
+            numeric = false;
+            break;
+    }
+
+    if (numeric && sign.empty() && (InSpec.Sign == '+' || InSpec.Sign == ' '))
+        sign = std::string(1, InSpec.Sign);
+
+    auto length = sign.size() + body.size();
+
+    if ((int)length >= InSpec.Width)
+        return sign + body;
+
+    auto padding = InSpec.Width - length;
+
+    // Zero padding goes after sign & base prefix
+    if (numeric && InSpec.Zero && InSpec.Align == 0)
+    {
+        size_t prefix = 0;
+
+        if (body.size() > 1 && body[0] == '0' && (body[1] == 'x' || body[1] == 'X' || body[1] == 'b' || body[1] == 'B'))
+            prefix = 2;
+
+        return sign + body.substr(0, prefix) + std::string(padding, '0') + body.substr(prefix);
+    }
+
+    auto align = InSpec.Align != 0 ? InSpec.Align : (numeric ? '>' : '<');
+    auto text = sign + body;
+
+    if (align == '<')
+        return text + std::string(padding, InSpec.Fill);
+
+    if (align == '>')
+        return std::string(padding, InSpec.Fill) + text;
+
+    return std::string(padding / 2, InSpec.Fill) + text + std::string(padding - padding / 2, InSpec.Fill);
+}
+
+static std::string Render(const std::string& InFormat, const std::vector<Arg>& InArgs)
+{
+    std::string result;
+    size_t nextArg = 0;
+
+    for (size_t i = 0; i < InFormat.size(); i++)
+    {
+        auto c = InFormat[i];
+
+        if (c == '}' && i + 1 < InFormat.size() && InFormat[i + 1] == '}')
+        {
+            result += '}';
+            i++;
+            continue;
+        }
+
+        if (c != '{')
+        {
+            result += c;
+            continue;
+        }
+
+        if (i + 1 < InFormat.size() && InFormat[i + 1] == '{')
+        {
+            result += '{';
+            i++;
+            continue;
+        }
+
+        auto end = InFormat.find('}', i);
+
+        if (end == std::string::npos)
+        {
+            result += InFormat.substr(i);
+            break;
+        }
+
+        auto field = InFormat.substr(i + 1, end - i - 1);
+        auto colon = field.find(':');
+        auto index = field.substr(0, colon);
+        auto spec = colon == std::string::npos ? std::string() : field.substr(colon + 1);
+
+        size_t argIndex = index.empty() ? nextArg++ : (size_t)atoi(index.c_str());
+
+        if (argIndex < InArgs.size())
+            result += FormatArg(InArgs[argIndex], ParseSpec(spec));
+        else
+            result += "{?}";
+
+        i = end;
+    }
+
+    return result;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <input.blog> [output.log]" << std::endl;
+        return 1;
+    }
+
+    std::ifstream input(argv[1], std::ios::binary);
+
+    if (!input.is_open())
+    {
+        std::cerr << "Can't open " << argv[1] << std::endl;
+        return 1;
+    }
+
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+
+    FileHeader header{};
+
+    if (data.size() < sizeof(header))
+    {
+        std::cerr << "File is too small" << std::endl;
+        return 1;
+    }
+
+    memcpy(&header, data.data(), sizeof(header));
+
+    if (header.Magic != Magic || header.Version != Version || header.Frequency <= 0)
+    {
+        std::cerr << "Not a binary log or unsupported version" << std::endl;
+        return 1;
+    }
+
+    std::unordered_map<uint32_t, Format> formats;
+    std::vector<Event> events;
+    uint64_t dropped = 0;
+    size_t offset = sizeof(header);
+
+    while (offset + sizeof(RecordHeader) <= data.size())
+    {
+        RecordHeader record{};
+        memcpy(&record, data.data() + offset, sizeof(record));
+        offset += sizeof(record);
+
+        if (offset + record.Size > data.size())
+        {
+            std::cerr << "Truncated record at " << offset << std::endl;
+            break;
+        }
+
+        auto payload = data.data() + offset;
+        offset += record.Size;
+
+        switch ((RecordType)record.Type)
+        {
+            case RecordType::Format:
+                formats[record.Id] = { record.Level, std::string((const char*)payload, record.Size) };
+                break;
+
+            case RecordType::Event:
+            {
+                Event event{ record.Counter, record.ThreadId, record.Id, events.size(), {} };
+
+                if (!ParseArgs(payload, record.Size, &event.Args))
+                    std::cerr << "Invalid arguments at " << offset << std::endl;
+
+                events.push_back(std::move(event));
+                break;
+            }
+
+            case RecordType::Dropped:
+                dropped += record.Id;
+                std::cerr << record.Id << " events of thread " << record.ThreadId << " were dropped" << std::endl;
+                break;
+
+            default:
+                std::cerr << "Unknown record type " << (int)record.Type << " at " << offset << std::endl;
+                offset = data.size();
+                break;
+        }
+    }
+
+    std::stable_sort(events.begin(), events.end(), [](const Event& a, const Event& b) { return a.Counter < b.Counter; });
+
+    std::ofstream outputFile;
+    std::ostream* output = &std::cout;
+
+    if (argc > 2)
+    {
+        outputFile.open(argv[2]);
+
+        if (!outputFile.is_open())
+        {
+            std::cerr << "Can't open " << argv[2] << std::endl;
+            return 1;
+        }
+
+        output = &outputFile;
+    }
+
+    const int64_t dayUs = 24ll * 60 * 60 * 1000000;
+
+    for (auto& event : events)
+    {
+        auto elapsedUs = (int64_t)((double)(event.Counter - header.StartCounter) * 1000000.0 / (double)header.Frequency);
+        auto timeUs = ((header.StartTimeOfDayUs + elapsedUs) % dayUs + dayUs) % dayUs;
+
+        char time[32];
+        snprintf(time, sizeof(time), "%02lld:%02lld:%02lld.%06lld", (long long)(timeUs / 3600000000ll), (long long)(timeUs / 60000000ll % 60),
+                 (long long)(timeUs / 1000000ll % 60), (long long)(timeUs % 1000000ll));
+
+        auto format = formats.find(event.Id);
+
+        if (format == formats.end())
+        {
+            *output << "[" << time << "] [?] [" << event.ThreadId << "] Unknown format id " << event.Id << "\n";
+            continue;
+        }
+
+        auto level = format->second.Level < sizeof(LevelLetters) ? LevelLetters[format->second.Level] : '?';
+        *output << "[" << time << "] [" << level << "] [" << event.ThreadId << "] " << Render(format->second.Text, event.Args) << "\n";
+    }
+
+    std::cerr << events.size() << " events, " << formats.size() << " formats, " << dropped << " dropped" << std::endl;
+
+    return 0;
+}
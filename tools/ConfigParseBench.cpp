@@ -0,0 +1,206 @@
+// Compares reading every bool & number key of an ini with Config's schema parser (IniDiff::ParseValue, OptiScaler/misc/IniDiff.h)
+// and with the previous per key reads (string copies, lower casing & istringstream), checks both read the same values
+//
+// Only needs a C++20 compiler and SimpleIni (same version OptiScaler uses):
+//   g++ -std=c++20 -O2 -I<simpleini folder> -o ConfigParseBench tools/ConfigParseBench.cpp
+//   cl /std:c++20 /O2 /EHsc /I<simpleini folder> tools\ConfigParseBench.cpp
+//
+// Usage: ConfigParseBench OptiScaler.ini [replay count]
+// Returns 1 if ini can't be read or both ways don't read every key the same
+
+#include "../OptiScaler/misc/IniDiff.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+enum class KeyType
+{
+    Bool,
+    Int,
+    Float
+};
+
+struct Key
+{
+    std::string Section;
+    std::string Name;
+    KeyType Type;
+};
+
+// Previous Config::readString, readBool, readInt & readFloat
+static std::optional<std::string> OldReadString(CSimpleIniA& InIni, std::string section, std::string key, bool lowercase = false)
+{
+    std::string value = InIni.GetValue(section.c_str(), key.c_str(), "auto");
+
+    std::string lower = value;
+    std::ranges::transform(lower, lower.begin(), [](unsigned char c) { return std::tolower(c); });
+
+    if (lower == "auto")
+        return std::nullopt;
+
+    return lowercase ? lower : value;
+}
+
+template <typename T>
+static bool OldIsNumber(const std::string& str, T& value)
+{
+    std::istringstream iss(str);
+    return (iss >> value) && iss.eof();
+}
+
+static std::optional<bool> OldReadBool(CSimpleIniA& InIni, const std::string& InSection, const std::string& InKey)
+{
+    auto value = OldReadString(InIni, InSection, InKey, true);
+
+    if (value == "true")
+        return true;
+    else if (value == "false")
+        return false;
+
+    return std::nullopt;
+}
+
+template <typename T>
+static std::optional<T> OldReadNumber(CSimpleIniA& InIni, const std::string& InSection, const std::string& InKey)
+{
+    auto value = OldReadString(InIni, InSection, InKey);
+    T result;
+
+    if (value.has_value() && OldIsNumber(value.value(), result))
+        return result;
+
+    return std::nullopt;
+}
+
+static double OldRead(CSimpleIniA& InIni, const Key& InKey)
+{
+    switch (InKey.Type)
+    {
+        case KeyType::Bool: return OldReadBool(InIni, InKey.Section, InKey.Name).value_or(false) ? 1.0 : 0.0;
+        case KeyType::Int: return OldReadNumber<int>(InIni, InKey.Section, InKey.Name).value_or(-1);
+        default: return OldReadNumber<float>(InIni, InKey.Section, InKey.Name).value_or(-1.0f);
+    }
+}
+
+static double NewRead(CSimpleIniA& InIni, const Key& InKey)
+{
+    auto value = InIni.GetValue(InKey.Section.c_str(), InKey.Name.c_str(), "auto");
+
+    switch (InKey.Type)
+    {
+        case KeyType::Bool: return IniDiff::ParseValue<bool>(value).value_or(false) ? 1.0 : 0.0;
+        case KeyType::Int: return IniDiff::ParseValue<int>(value).value_or(-1);
+        default: return IniDiff::ParseValue<float>(value).value_or(-1.0f);
+    }
+}
+
+// Type of a key is guessed from its value, "auto" keys are read as bool (both ways stop at "auto" for any type)
+// String keys are skipped, they are read the same way as before
+static std::vector<Key> CollectKeys(CSimpleIniA& InIni)
+{
+    std::vector<Key> result;
+
+    CSimpleIniA::TNamesDepend sections;
+    InIni.GetAllSections(sections);
+
+    for (auto& section : sections)
+    {
+        CSimpleIniA::TNamesDepend keys;
+        InIni.GetAllKeys(section.pItem, keys);
+
+        for (auto& key : keys)
+        {
+            auto value = InIni.GetValue(section.pItem, key.pItem, "auto");
+            std::string lower = value;
+            std::ranges::transform(lower, lower.begin(), [](unsigned char c) { return std::tolower(c); });
+
+            if (lower == "auto" || IniDiff::ParseValue<bool>(value).has_value())
+                result.push_back({ section.pItem, key.pItem, KeyType::Bool });
+            else if (IniDiff::ParseValue<int>(value).has_value())
+                result.push_back({ section.pItem, key.pItem, KeyType::Int });
+            else if (IniDiff::ParseValue<float>(value).has_value())
+                result.push_back({ section.pItem, key.pItem, KeyType::Float });
+        }
+    }
+
+    return result;
+}
+
+template <typename Fn>
+static double Measure(int InReplays, const std::vector<Key>& InKeys, Fn InRead)
+{
+    volatile double sink = 0.0;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int r = 0; r < InReplays; r++)
+    {
+        for (auto& key : InKeys)
+            sink = sink + InRead(key);
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        printf("Usage: ConfigParseBench OptiScaler.ini [replay count]\n");
+        return 1;
+    }
+
+    std::ifstream file(argv[1], std::ios::binary);
+
+    if (!file)
+    {
+        printf("Can't open %s\n", argv[1]);
+        return 1;
+    }
+
+    std::stringstream text;
+    text << file.rdbuf();
+
+    CSimpleIniA ini;
+
+    if (ini.LoadData(text.str()) < 0)
+    {
+        printf("Can't parse %s\n", argv[1]);
+        return 1;
+    }
+
+    int replays = argc > 2 ? atoi(argv[2]) : 2000;
+
+    if (replays < 1)
+        replays = 1;
+
+    auto keys = CollectKeys(ini);
+    int mismatches = 0;
+
+    for (auto& key : keys)
+    {
+        auto oldValue = OldRead(ini, key);
+        auto newValue = NewRead(ini, key);
+
+        if (oldValue != newValue)
+        {
+            printf("MISMATCH: [%s] %s old: %g new: %g\n", key.Section.c_str(), key.Name.c_str(), oldValue, newValue);
+            mismatches++;
+        }
+    }
+
+    auto oldUs = Measure(replays, keys, [&ini](const Key& InKey) { return OldRead(ini, InKey); });
+    auto newUs = Measure(replays, keys, [&ini](const Key& InKey) { return NewRead(ini, InKey); });
+
+    printf("%zu bool & number keys, %d replays\n", keys.size(), replays);
+    printf("Per key reads: %8.2f us/ini\n", oldUs / replays);
+    printf("Schema parser: %8.2f us/ini\n", newUs / replays);
+    printf("Speedup: %.1fx\n", oldUs / newUs);
+
+    return mismatches > 0 ? 1 : 0;
+}
@@ -0,0 +1,154 @@
+// Checks render scale controller of DRS governor (OptiScaler/misc/DrsController.h) on simulated frame traces
+//
+// Only needs a C++20 compiler:
+//   g++ -std=c++20 -O2 -o DrsGovernorTest tools/DrsGovernorTest.cpp
+//   cl /std:c++20 /O2 /EHsc tools\DrsGovernorTest.cpp
+//
+// Usage: DrsGovernorTest
+// Prints failed checks and returns 1 if any check failed
+
+#include "../OptiScaler/misc/DrsController.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+static int failures = 0;
+
+static void Check(bool InCondition, const char* InWhat)
+{
+    if (InCondition)
+        return;
+
+    printf("FAILED: %s\n", InWhat);
+    failures++;
+}
+
+enum class PacingMode
+{
+    Uncapped,
+    VSync,
+    Limiter
+};
+
+struct Trace
+{
+    PacingMode Pacing = PacingMode::Uncapped;
+    double IntervalMs = 1000.0 / 60.0;
+    double CpuMs = 2.0;
+    // GPU time of frame at native resolution, scales with pixel count
+    double GpuNativeMs = 5.0;
+    double TargetMs = 12.0;
+    // Feed controller with time between upscaler ends of consecutive frames, like before
+    bool UseUpscaleInterval = false;
+};
+
+// Simulates a single queue: frame's GPU work starts when it's submitted and GPU is free
+// Frame start timestamp is submitted after present returned and before limiter sleeps, like StartFrame
+static float Run(const Trace& InTrace, int InFrames = 600)
+{
+    DrsController controller;
+    float scale = 1.0f;
+
+    double cpuTime = 0.0;
+    double gpuFree = 0.0;
+    double frameStart = 0.0;
+    double lastUpscaleEnd = 0.0;
+    double lastSleep = 0.0;
+
+    for (int i = 0; i < InFrames; i++)
+    {
+        auto submit = cpuTime + InTrace.CpuMs;
+        auto gpuStart = std::max(submit, gpuFree);
+        auto upscaleEnd = gpuStart + InTrace.GpuNativeMs * scale * scale;
+        gpuFree = upscaleEnd;
+
+        if (i > 0)
+        {
+            auto sample = InTrace.UseUpscaleInterval ? upscaleEnd - lastUpscaleEnd : upscaleEnd - frameStart;
+
+            if (controller.AddSample(sample, lastSleep))
+                scale = controller.Step(scale, InTrace.TargetMs, 0.5f, 1.0f);
+        }
+
+        lastUpscaleEnd = upscaleEnd;
+
+        // Present blocks until GPU finished & next vblank with vsync
+        auto presentReturn = submit;
+
+        if (InTrace.Pacing == PacingMode::VSync)
+            presentReturn = std::ceil(upscaleEnd / InTrace.IntervalMs) * InTrace.IntervalMs;
+
+        frameStart = std::max(presentReturn, gpuFree);
+        gpuFree = frameStart;
+
+        lastSleep = 0.0;
+
+        if (InTrace.Pacing == PacingMode::Limiter)
+            lastSleep = std::max(cpuTime + InTrace.IntervalMs - presentReturn, 0.0);
+
+        cpuTime = presentReturn + lastSleep;
+    }
+
+    return scale;
+}
+
+int main()
+{
+    // Capped to vsync with plenty of headroom, GPU idles most of the frame
+    Trace vsync;
+    vsync.Pacing = PacingMode::VSync;
+
+    auto scale = Run(vsync);
+    printf("VSync capped, busy time: %.3f\n", scale);
+    Check(scale > 0.99f, "VSync capped trace with headroom keeps max scale");
+
+    vsync.UseUpscaleInterval = true;
+    scale = Run(vsync);
+    printf("VSync capped, upscale interval: %.3f\n", scale);
+    Check(scale < 0.51f, "Upscale interval collapses scale on vsync capped trace");
+
+    // Capped by frame limiter
+    Trace limiter;
+    limiter.Pacing = PacingMode::Limiter;
+
+    scale = Run(limiter);
+    printf("Limiter capped, busy time: %.3f\n", scale);
+    Check(scale > 0.99f, "Limiter capped trace with headroom keeps max scale");
+
+    // CPU bound, GPU finishes early and waits for next submit
+    Trace cpuBound;
+    cpuBound.CpuMs = 10.0;
+    cpuBound.GpuNativeMs = 1.0;
+    cpuBound.TargetMs = 16.0;
+
+    scale = Run(cpuBound);
+    printf("CPU bound, busy time: %.3f\n", scale);
+    Check(scale > 0.99f, "CPU bound trace below target keeps max scale");
+
+    // GPU bound, pixel count should settle near target / native time
+    Trace gpuBound;
+    gpuBound.CpuMs = 1.0;
+    gpuBound.GpuNativeMs = 20.0;
+    gpuBound.TargetMs = 12.0;
+
+    scale = Run(gpuBound);
+    auto expected = (float)std::sqrt(12.0 / 20.0);
+    printf("GPU bound, busy time: %.3f (expected ~%.3f)\n", scale, expected);
+    Check(std::abs(scale - expected) < 0.05f, "GPU bound trace settles near target");
+
+    // Capped but over budget, scale still goes down
+    Trace heavy;
+    heavy.Pacing = PacingMode::VSync;
+    heavy.GpuNativeMs = 15.0;
+    heavy.TargetMs = 8.0;
+
+    scale = Run(heavy);
+    printf("VSync capped over budget, busy time: %.3f\n", scale);
+    Check(scale < 0.85f, "Capped trace over budget lowers scale");
+
+    if (failures == 0)
+        printf("All checks passed\n");
+
+    return failures == 0 ? 0 : 1;
+}
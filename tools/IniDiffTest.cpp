@@ -0,0 +1,143 @@
+// Checks ini parsing & diffing of hot reload (OptiScaler/misc/IniDiff.h)
+//
+// Only needs a C++20 compiler and SimpleIni (same version OptiScaler uses):
+//   g++ -std=c++20 -O2 -I<simpleini folder> -o IniDiffTest tools/IniDiffTest.cpp
+//   cl /std:c++20 /O2 /EHsc /I<simpleini folder> tools\IniDiffTest.cpp
+//
+// Usage: IniDiffTest
+// Prints failed checks and returns 1 if any check failed
+
+#include "../OptiScaler/misc/IniDiff.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+static int failures = 0;
+
+static void Check(bool InCondition, const char* InWhat)
+{
+    if (InCondition)
+        return;
+
+    printf("FAILED: %s\n", InWhat);
+    failures++;
+}
+
+static IniValues Parse(const std::string& InText)
+{
+    IniValues values;
+    Check(IniDiff::Parse(InText, &values), "Parse returns true");
+    return values;
+}
+
+static const IniChange* Find(const std::vector<IniChange>& InChanges, const std::string& InKey)
+{
+    for (auto& change : InChanges)
+    {
+        if (change.Key == InKey)
+            return &change;
+    }
+
+    return nullptr;
+}
+
+static IniChangeKind Classify(const std::string& InSection, const std::string& InKey)
+{
+    if (InSection == "Sharpness")
+        return IniChangeKind::Immediate;
+
+    if (InKey == "Dx12Upscaler")
+        return IniChangeKind::RecreateFeature;
+
+    return IniChangeKind::Restart;
+}
+
+static void TestParse()
+{
+    auto values = Parse("[Sharpness]\nEnabled=true\nAmount=auto\n\n[Upscalers]\nDx12Upscaler=xess\n");
+
+    Check(values.size() == 3, "Parse reads every key");
+    Check(values.contains(IniDiff::Id("sharpness", "ENABLED")), "Ids are case insensitive");
+    Check(values[IniDiff::Id("Sharpness", "Enabled")].Value == "true", "Parse keeps value");
+    Check(values[IniDiff::Id("Sharpness", "Enabled")].Section == "Sharpness", "Parse keeps section name");
+    Check(values[IniDiff::Id("Sharpness", "Amount")].Value.empty(), "auto is stored as empty");
+
+    IniValues empty;
+    Check(IniDiff::Parse("", &empty) && empty.empty(), "Empty text has no values");
+    Check(!IniDiff::Parse("[A]\nB=1\n", nullptr), "Null output fails");
+}
+
+static void TestDiff()
+{
+    auto oldValues = Parse("[Sharpness]\nEnabled=true\nAmount=0.3\n[Upscalers]\nDx12Upscaler=xess\n[Log]\nLogLevel=2\n");
+    auto newValues = Parse("[Sharpness]\nEnabled=TRUE\nAmount=0.5\n[Upscalers]\nDx12Upscaler=fsr22\n[Menu]\nScale=1.2\n");
+
+    auto changes = IniDiff::Diff(oldValues, newValues, Classify);
+
+    Check(changes.size() == 5, "Diff finds changed, added & removed keys");
+
+    auto enabled = Find(changes, "Enabled");
+    Check(enabled != nullptr && enabled->OldValue == "true" && enabled->NewValue == "TRUE", "Values are compared case sensitive");
+
+    auto amount = Find(changes, "Amount");
+    Check(amount != nullptr && amount->OldValue == "0.3" && amount->NewValue == "0.5", "Changed value has old & new value");
+    Check(amount != nullptr && amount->Kind == IniChangeKind::Immediate, "Classifier tags change");
+
+    auto upscaler = Find(changes, "Dx12Upscaler");
+    Check(upscaler != nullptr && upscaler->Kind == IniChangeKind::RecreateFeature, "Classifier tags recreate");
+
+    auto scale = Find(changes, "Scale");
+    Check(scale != nullptr && scale->OldValue.empty() && scale->NewValue == "1.2", "Added key has empty old value");
+
+    auto logLevel = Find(changes, "LogLevel");
+    Check(logLevel != nullptr && logLevel->OldValue == "2" && logLevel->NewValue.empty(), "Removed key has empty new value");
+    Check(logLevel != nullptr && logLevel->Kind == IniChangeKind::Restart, "Unknown keys need restart");
+
+    Check(IniDiff::Diff(oldValues, oldValues).empty(), "Same values have no changes");
+
+    // auto & missing keys mean the same for Config
+    auto withAuto = Parse("[Sharpness]\nAmount=auto\n");
+    auto withoutKey = Parse("[Sharpness]\n");
+    Check(IniDiff::Diff(withAuto, withoutKey).empty(), "Removing an auto key is not a change");
+    Check(IniDiff::Diff(withoutKey, withAuto).empty(), "Adding an auto key is not a change");
+
+    auto noClassifier = IniDiff::Diff(withoutKey, Parse("[Sharpness]\nAmount=1\n"));
+    Check(noClassifier.size() == 1 && noClassifier[0].Kind == IniChangeKind::Restart, "Changes are restart without classifier");
+}
+
+static void TestOverlay()
+{
+    auto values = Parse("[Sharpness]\nEnabled=false\nAmount=0.3\n");
+    auto profile = Parse("[Sharpness]\nENABLED=true\n[Menu]\nScale=1.5\n");
+
+    IniDiff::Overlay(profile, &values);
+
+    Check(values.size() == 3, "Overlay adds profile keys");
+    Check(values[IniDiff::Id("Sharpness", "Enabled")].Value == "true", "Profile value replaces ini value");
+    Check(values[IniDiff::Id("Sharpness", "Amount")].Value == "0.3", "Ini values without profile value are kept");
+
+    // Profile edit is seen as a change of merged values
+    auto editedProfile = Parse("[Sharpness]\nEnabled=true\n[Menu]\nScale=2.0\n");
+    auto merged = Parse("[Sharpness]\nEnabled=false\nAmount=0.3\n");
+    IniDiff::Overlay(editedProfile, &merged);
+
+    auto changes = IniDiff::Diff(values, merged);
+    Check(changes.size() == 1 && changes[0].Key == "Scale" && changes[0].NewValue == "2.0", "Profile change is diffed over ini");
+}
+
+int main()
+{
+    TestParse();
+    TestDiff();
+    TestOverlay();
+
+    if (failures > 0)
+    {
+        printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+
+    printf("All checks passed\n");
+    return 0;
+}
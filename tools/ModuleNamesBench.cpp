@@ -0,0 +1,164 @@
+// Replays a game's LoadLibrary sequence through module name classification (OptiScaler/misc/ModuleNames.h)
+// and through the previous lower case copy + suffix matching of name lists, then compares timings & results
+//
+// Only needs a C++20 compiler:
+//   g++ -std=c++20 -O2 -o ModuleNamesBench tools/ModuleNamesBench.cpp
+//   cl /std:c++20 /O2 /EHsc tools\ModuleNamesBench.cpp
+//
+// Usage: ModuleNamesBench [replay count]
+// Returns 1 if both ways don't classify every name of sequence the same
+
+#include "../OptiScaler/misc/ModuleNames.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cwctype>
+#include <string>
+#include <vector>
+
+// Dlls loaded by a Dx12 game with Streamline, DLSS & FSR3.1 from start to first frame, repeated loads included
+static const wchar_t* LoadSequence[] =
+{
+    L"KERNEL32.DLL", L"C:\\Windows\\System32\\USER32.dll", L"ADVAPI32.dll", L"SHELL32.dll", L"ole32.dll", L"OLEAUT32.dll",
+    L"C:\\Windows\\SYSTEM32\\dbghelp.dll", L"VERSION.dll", L"WINMM.dll", L"WS2_32.dll", L"CRYPT32.dll", L"bcrypt.dll",
+    L"C:\\Windows\\SYSTEM32\\dxgi.dll", L"d3d11.dll", L"C:\\Windows\\SYSTEM32\\d3d12.dll", L"D3D12Core.dll", L"d3d12SDKLayers.dll",
+    L"nvapi64.dll", L"C:\\Windows\\System32\\DriverStore\\FileRepository\\nv_dispi.inf_amd64\\nvwgf2umx.dll", L"nvldumdx.dll",
+    L"C:\\Games\\Game\\Binaries\\Win64\\sl.interposer.dll", L"sl.common.dll", L"sl.dlss.dll", L"sl.dlss_g.dll", L"sl.reflex.dll",
+    L"C:\\Games\\Game\\Binaries\\Win64\\nvngx_dlss.dll", L"C:\\ProgramData\\NVIDIA\\NGX\\models\\dlss\\versions\\20317440\\files\\160_E658700.bin",
+    L"_nvngx.dll", L"nvngx.dll", L"C:\\Games\\Game\\Binaries\\Win64\\amd_fidelityfx_dx12.dll", L"ffx_backend_dx12_x64.dll",
+    L"ffx_fsr3upscaler_x64.dll", L"libxess.dll", L"XINPUT1_4.dll", L"dinput8.dll", L"HID.DLL", L"SETUPAPI.dll", L"MMDevAPI.dll",
+    L"AUDIOSES.DLL", L"xaudio2_9.dll", L"dwmapi.dll", L"uxtheme.dll", L"dcomp.dll", L"CoreMessaging.dll", L"WINHTTP.dll",
+    L"WININET.dll", L"gameoverlayrenderer64.dll", L"C:\\Program Files (x86)\\Steam\\steamclient64.dll", L"steam_api64.dll",
+    L"EOSSDK-Win64-Shipping.dll", L"EOSOVH-Win64-Shipping.dll", L"vulkan-1.dll", L"nvoglv64.dll", L"amd_ags_x64.dll",
+    L"C:\\Games\\Game\\Binaries\\Win64\\Plugins\\fsr.optidll", L"dxgi", L"d3d12", L"nvngx", L"sl.interposer", L"nvapi64",
+    L"kernelbase.dll", L"ntdll.dll", L"msvcp140.dll", L"VCRUNTIME140.dll", L"VCRUNTIME140_1.dll", L"ucrtbase.dll",
+    L"C:\\Games\\Game\\Binaries\\Win64\\GFSDK_Aftermath_Lib.x64.dll", L"PhysX3_x64.dll", L"oo2core_9_win64.dll", L"bink2w64.dll",
+};
+
+// Same order as LoadLibraryCheckW checked its name lists, only names which were classified by suffix
+struct NameList
+{
+    std::vector<std::wstring> Names;
+    ModuleKind Kind;
+};
+
+static std::vector<NameList> BuildOldLists()
+{
+    auto names = [](const wchar_t* InName, ModuleKind InKind) { return NameList{ { std::wstring(InName) + L".dll", InName }, InKind }; };
+
+    return
+    {
+        names(L"nvngx", ModuleKind::Nvngx),
+        names(L"nvapi64", ModuleKind::NvApi),
+        names(L"sl.interposer", ModuleKind::Streamline),
+        names(L"nvngx_dlss", ModuleKind::NvngxDlss),
+        { { L"eosovh-win32-shipping.dll", L"eosovh-win32-shipping", L"eosovh-win64-shipping.dll", L"eosovh-win64-shipping",
+            L"gameoverlayrenderer64", L"gameoverlayrenderer64.dll", L"gameoverlayrenderer", L"gameoverlayrenderer.dll" }, ModuleKind::Overlay },
+        names(L"d3d11", ModuleKind::Dx11),
+        names(L"d3d12", ModuleKind::Dx12),
+        names(L"vulkan-1", ModuleKind::Vulkan),
+        names(L"dxgi", ModuleKind::Dxgi),
+        names(L"ffx_fsr2_api_x64", ModuleKind::Fsr2),
+        names(L"ffx_fsr2_api_dx12_x64", ModuleKind::Fsr2Dx12),
+        names(L"ffx_fsr3upscaler_x64", ModuleKind::Fsr3),
+        names(L"ffx_backend_dx12_x64", ModuleKind::Fsr3Dx12),
+        names(L"libxess", ModuleKind::XeSS),
+        names(L"amd_fidelityfx_dx12", ModuleKind::FfxDx12),
+        names(L"amd_fidelityfx_vk", ModuleKind::FfxVk),
+    };
+}
+
+static bool CheckDllNameW(std::wstring* dllName, std::vector<std::wstring>* namesList)
+{
+    for (size_t i = 0; i < namesList->size(); i++)
+    {
+        auto name = namesList->at(i);
+        auto pos = dllName->rfind(name);
+
+        if (pos != std::string::npos && pos == (dllName->size() - name.size()))
+            return true;
+    }
+
+    return false;
+}
+
+// What hkLoadLibraryW & LoadLibraryCheckW did before ModuleNames
+static ModuleKind OldClassify(const wchar_t* InName, std::vector<NameList>& InLists)
+{
+    std::wstring libName(InName);
+    std::wstring lcaseLibName(libName);
+
+    for (size_t i = 0; i < lcaseLibName.size(); i++)
+        lcaseLibName[i] = std::towlower(lcaseLibName[i]);
+
+    if (lcaseLibName.ends_with(L".optidll"))
+        return ModuleKind::OptiDll;
+
+    if (lcaseLibName.ends_with(L".bin"))
+        return ModuleKind::NgxBin;
+
+    for (auto& list : InLists)
+    {
+        if (CheckDllNameW(&lcaseLibName, &list.Names))
+            return list.Kind;
+    }
+
+    return ModuleKind::Unknown;
+}
+
+template <typename Fn>
+static double Measure(int InReplays, Fn InClassify)
+{
+    volatile uint32_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int r = 0; r < InReplays; r++)
+    {
+        for (auto name : LoadSequence)
+            sink = sink + (uint32_t)InClassify(name);
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+int main(int argc, char* argv[])
+{
+    int replays = argc > 1 ? atoi(argv[1]) : 20000;
+
+    if (replays < 1)
+        replays = 1;
+
+    auto lists = BuildOldLists();
+    int mismatches = 0;
+
+    for (auto name : LoadSequence)
+    {
+        auto oldKind = OldClassify(name, lists);
+        auto newKind = ModuleNames::Classify(name);
+
+        // Old lists only had the name OptiScaler is loaded as (none here), hooks ignore these kinds unless IsSelf
+        if (newKind >= ModuleKind::Version && newKind <= ModuleKind::OptiScaler && !ModuleNames::IsSelf(newKind))
+            newKind = ModuleKind::Unknown;
+
+        if (oldKind != newKind)
+        {
+            printf("MISMATCH: %ls old: %u new: %u\n", name, (uint32_t)oldKind, (uint32_t)newKind);
+            mismatches++;
+        }
+    }
+
+    const auto names = sizeof(LoadSequence) / sizeof(LoadSequence[0]);
+    const double calls = (double)replays * names;
+
+    auto oldNs = Measure(replays, [&lists](const wchar_t* InName) { return OldClassify(InName, lists); });
+    auto newNs = Measure(replays, [](const wchar_t* InName) { return ModuleNames::Classify(InName); });
+
+    printf("%zu names, %d replays\n", names, replays);
+    printf("Copy & suffix match: %8.1f ns/call, %8.2f us/sequence\n", oldNs / calls, oldNs / replays / 1000.0);
+    printf("ModuleNames:         %8.1f ns/call, %8.2f us/sequence\n", newNs / calls, newNs / replays / 1000.0);
+    printf("Speedup: %.1fx\n", oldNs / newNs);
+
+    return mismatches > 0 ? 1 : 0;
+}
@@ -0,0 +1,127 @@
+// Checks running sums of frame & pass time windows (OptiScaler/misc/TimeWindow.h)
+//
+// Only needs a C++20 compiler:
+//   g++ -std=c++20 -O2 -o TimeWindowTest tools/TimeWindowTest.cpp
+//   cl /std:c++20 /O2 /EHsc tools\TimeWindowTest.cpp
+//
+// Usage: TimeWindowTest
+// Prints failed checks and returns 1 if any check failed
+
+#include "../OptiScaler/misc/TimeWindow.h"
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+static int failures = 0;
+
+static void Check(bool InCondition, const char* InWhat)
+{
+    if (InCondition)
+        return;
+
+    printf("FAILED: %s\n", InWhat);
+    failures++;
+}
+
+// Sums computed from scratch, like menu did before running sums
+static double ExactAverage(const TimeWindow& InWindow)
+{
+    double sum = 0.0;
+
+    for (auto value : InWindow.Values)
+        sum += value;
+
+    return sum / InWindow.Values.size();
+}
+
+static double ExactRecentAverage(const TimeWindow& InWindow)
+{
+    double sum = 0.0;
+    uint32_t count = 0;
+
+    for (auto it = InWindow.Values.end() - (ptrdiff_t)InWindow.RecentSize; it != InWindow.Values.end(); ++it)
+    {
+        if (*it > 0.0)
+        {
+            sum += *it;
+            count++;
+        }
+    }
+
+    return count > 0 ? sum / count : 0.0;
+}
+
+int main()
+{
+    // Startup state, filled with zeros
+    TimeWindow window(100);
+    window.Reset(300);
+
+    Check(window.Average() == 0.0, "Zero filled window averages to 0");
+    Check(window.RecentAverage() == 0.0, "Zero filled window has no recent average");
+
+    // Zeros are skipped by recent average but not by average
+    for (int i = 0; i < 50; i++)
+        window.Add(10.0);
+
+    Check(window.RecentCount == 50, "Recent count skips zeros");
+    Check(std::abs(window.RecentAverage() - 10.0) < 1e-12, "Recent average of partially filled window");
+    Check(std::abs(window.Average() - 500.0 / 300.0) < 1e-12, "Average includes zeros");
+    Check(window.Last() == 10.0, "Last value");
+
+    // Random frame times with hitches & loading screens, running sums must match exact ones after every add
+    std::mt19937 random(1234);
+    std::uniform_real_distribution<double> frameTime(4.0, 40.0);
+    std::uniform_int_distribution<int> event(0, 999);
+
+    double maxError = 0.0;
+    double maxRecentError = 0.0;
+
+    for (int i = 0; i < 200000; i++)
+    {
+        auto value = frameTime(random);
+        auto kind = event(random);
+
+        if (kind == 0)
+            value = 1.0e7;    // Long loading screen
+        else if (kind < 5)
+            value = 0.0;      // First frame after menu toggles
+
+        window.Add(value);
+
+        maxError = std::max(maxError, std::abs(window.Average() - ExactAverage(window)));
+        maxRecentError = std::max(maxRecentError, std::abs(window.RecentAverage() - ExactRecentAverage(window)));
+    }
+
+    printf("Max average error: %g, max recent average error: %g\n", maxError, maxRecentError);
+    Check(maxError < 1e-6, "Running average matches exact average");
+    Check(maxRecentError < 1e-6, "Running recent average matches exact recent average");
+
+    // Once spikes leave the window, sums are exact again after a recompute
+    for (uint32_t i = 0; i < TimeWindow::RecomputeInterval; i++)
+        window.Add(16.0);
+
+    Check(window.Sum == 16.0 * 300, "Sum is exact after spikes left & recompute");
+    Check(window.RecentSum == 16.0 * 100 && window.RecentCount == 100, "Recent sum is exact after recompute");
+
+    // Window without recent tracking
+    TimeWindow passes;
+    passes.Reset(4);
+    passes.Add(1.0);
+    passes.Add(2.0);
+
+    Check(passes.RecentCount == 0, "Recent values are not tracked when recent size is 0");
+    Check(std::abs(passes.Average() - 0.75) < 1e-12, "Average of window without recent tracking");
+
+    // Not reset yet, adds are ignored
+    TimeWindow empty;
+    empty.Add(1.0);
+
+    Check(empty.Values.empty() && empty.Average() == 0.0, "Adds to an empty window are ignored");
+
+    if (failures == 0)
+        printf("All checks passed\n");
+
+    return failures == 0 ? 0 : 1;
+}